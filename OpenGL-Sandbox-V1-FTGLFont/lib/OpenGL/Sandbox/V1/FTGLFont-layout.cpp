@@ -0,0 +1,280 @@
+/* Glyph metrics table and paragraph layout for FTFontWrapper.
+ *
+ * This is kept out of FTGLFont.cpp so that Inline::CPP doesn't try to bind any of it.
+ * None of it calls FTGL directly; the wrapper supplies a callback that measures a UTF-8
+ * string, which is used once per glyph (and once per kerning pair) to fill the table.
+ */
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+typedef float (*glyph_advance_fn)(void *ctx, const char *utf8, int n_chars);
+
+#define METRICS_ASCII 128
+
+/* Minimal open-addressing map of uint64 to float.  Keys are stored +1 so 0 means empty. */
+class MetricsMap {
+	uint64_t *keys;
+	float *vals;
+	size_t cap, count;
+public:
+	MetricsMap(): keys(NULL), vals(NULL), cap(0), count(0) {}
+	~MetricsMap() { clear(); }
+	void clear() {
+		if (keys) Safefree(keys);
+		if (vals) Safefree(vals);
+		keys= NULL; vals= NULL; cap= count= 0;
+	}
+	static size_t hash(uint64_t k) {
+		k ^= k >> 33; k *= 0xff51afd7ed558ccdULL; k ^= k >> 33;
+		return (size_t) k;
+	}
+	float *find(uint64_t key) {
+		size_t i;
+		if (!cap) return NULL;
+		for (i= hash(key) & (cap-1); keys[i]; i= (i+1) & (cap-1))
+			if (keys[i] == key+1) return vals + i;
+		return NULL;
+	}
+	void insert(uint64_t key, float val) {
+		size_t i;
+		if ((count+1) * 2 > cap) {
+			uint64_t *old_keys= keys;
+			float *old_vals= vals;
+			size_t old_cap= cap, j;
+			cap= cap? cap * 2 : 64;
+			Newxz(keys, cap, uint64_t);
+			Newx(vals, cap, float);
+			for (j= 0; j < old_cap; j++) {
+				if (!old_keys[j]) continue;
+				for (i= hash(old_keys[j]-1) & (cap-1); keys[i]; i= (i+1) & (cap-1));
+				keys[i]= old_keys[j];
+				vals[i]= old_vals[j];
+			}
+			if (old_keys) { Safefree(old_keys); Safefree(old_vals); }
+		}
+		for (i= hash(key) & (cap-1); keys[i] && keys[i] != key+1; i= (i+1) & (cap-1));
+		if (!keys[i]) count++;
+		keys[i]= key+1;
+		vals[i]= val;
+	}
+};
+
+static int encode_utf8(uint32_t cp, char *buf) {
+	if (cp < 0x80) { buf[0]= cp; return 1; }
+	if (cp < 0x800) { buf[0]= 0xC0|(cp>>6); buf[1]= 0x80|(cp&0x3F); return 2; }
+	if (cp < 0x10000) { buf[0]= 0xE0|(cp>>12); buf[1]= 0x80|((cp>>6)&0x3F); buf[2]= 0x80|(cp&0x3F); return 3; }
+	buf[0]= 0xF0|(cp>>18); buf[1]= 0x80|((cp>>12)&0x3F); buf[2]= 0x80|((cp>>6)&0x3F); buf[3]= 0x80|(cp&0x3F);
+	return 4;
+}
+
+/* Decode UTF-8 'str' into codepoints, and the byte offset of each one.  Both output arrays must
+ * have room for 'len' elements.  Runs of ASCII are handled 8 bytes at a time.  Invalid bytes
+ * decode as U+FFFD.  Returns the number of codepoints.
+ */
+static size_t decode_utf8(const unsigned char *str, size_t len, uint32_t *cps, uint32_t *ofs) {
+	size_t i= 0, n= 0, k, need;
+	uint64_t word;
+	uint32_t cp;
+	while (i < len) {
+		if (i + 8 <= len) {
+			memcpy(&word, str + i, 8);
+			if (!(word & 0x8080808080808080ULL)) {
+				for (k= 0; k < 8; k++) { cps[n+k]= str[i+k]; ofs[n+k]= i+k; }
+				n += 8; i += 8;
+				continue;
+			}
+		}
+		ofs[n]= i;
+		cp= str[i];
+		need= cp < 0x80? 0 : cp < 0xC2? (size_t)-1 : cp < 0xE0? 1 : cp < 0xF0? 2 : cp < 0xF5? 3 : (size_t)-1;
+		if (!need || need == (size_t)-1 || i + need >= len) {
+			cps[n++]= need? 0xFFFD : cp;
+			i++;
+			continue;
+		}
+		cp &= 0x3F >> need;
+		for (k= 1; k <= need; k++) {
+			if ((str[i+k] & 0xC0) != 0x80) break;
+			cp= (cp << 6) | (str[i+k] & 0x3F);
+		}
+		if (k <= need) { cps[n++]= 0xFFFD; i++; }
+		else { cps[n++]= cp; i += need + 1; }
+	}
+	return n;
+}
+
+/* Advance and kerning for one font at one size.  ASCII advances and ASCII pairs are dense
+ * arrays; everything else goes into hash tables.  Kerning is derived from the advance of the
+ * pair, so it includes whatever FTGL would have done between those two glyphs.
+ */
+class GlyphMetrics {
+	glyph_advance_fn advance_fn;
+	void *ctx;
+	float ascii_adv[METRICS_ASCII];
+	float *ascii_kern;          /* METRICS_ASCII^2, lazily allocated, NaN = unknown */
+	bool ascii_ready;
+	MetricsMap adv_map, kern_map;
+public:
+	GlyphMetrics(glyph_advance_fn fn, void *c): advance_fn(fn), ctx(c), ascii_kern(NULL), ascii_ready(false) {}
+	~GlyphMetrics() { reset(); }
+
+	/* Call whenever the face size changes */
+	void reset() {
+		ascii_ready= false;
+		if (ascii_kern) Safefree(ascii_kern);
+		ascii_kern= NULL;
+		adv_map.clear();
+		kern_map.clear();
+	}
+
+	float advance(uint32_t cp) {
+		char buf[5];
+		float *v;
+		if (cp < METRICS_ASCII) {
+			if (!ascii_ready) {
+				for (int i= 0; i < METRICS_ASCII; i++) {
+					buf[0]= i;
+					buf[1]= 0;
+					ascii_adv[i]= i >= 32? advance_fn(ctx, buf, 1) : 0;
+				}
+				ascii_ready= true;
+			}
+			return ascii_adv[cp];
+		}
+		if ((v= adv_map.find(cp))) return *v;
+		buf[encode_utf8(cp, buf)]= 0;
+		float a= advance_fn(ctx, buf, 1);
+		adv_map.insert(cp, a);
+		return a;
+	}
+
+	float kern(uint32_t a, uint32_t b) {
+		char buf[9];
+		float *v, k;
+		int n;
+		if (a < METRICS_ASCII && b < METRICS_ASCII) {
+			if (!ascii_kern) {
+				Newx(ascii_kern, METRICS_ASCII*METRICS_ASCII, float);
+				for (int i= 0; i < METRICS_ASCII*METRICS_ASCII; i++) ascii_kern[i]= NAN;
+			}
+			v= ascii_kern + a*METRICS_ASCII + b;
+			if (*v == *v) return *v;
+		}
+		else if ((v= kern_map.find(((uint64_t)a << 32) | b)))
+			return *v;
+		else v= NULL;
+		if (a < 32 || b < 32) k= 0;
+		else {
+			n= encode_utf8(a, buf);
+			n += encode_utf8(b, buf+n);
+			buf[n]= 0;
+			k= advance_fn(ctx, buf, 2) - advance(a) - advance(b);
+			/* ignore float noise */
+			if (k < 0.001 && k > -0.001) k= 0;
+		}
+		if (v) *v= k;
+		else kern_map.insert(((uint64_t)a << 32) | b, k);
+		return k;
+	}
+};
+
+/* One line of a paragraph layout, in terms of the decoded codepoint array */
+struct LayoutLine {
+	size_t start, end;  /* codepoint index range [start,end) */
+	float width;        /* not including ellipsis */
+	bool ellipsis;
+};
+
+static bool is_break_space(uint32_t cp) { return cp == ' ' || cp == '\t'; }
+
+/* Measure codepoints [start,end) */
+static float measure_run(GlyphMetrics &m, const uint32_t *cps, size_t start, size_t end) {
+	float pen= 0;
+	for (size_t i= start; i < end; i++)
+		pen += m.advance(cps[i]) + (i > start? m.kern(cps[i-1], cps[i]) : 0);
+	return pen;
+}
+
+/* Shorten the line so that it plus the ellipsis fits within 'width', trimming trailing space */
+static void ellipsize_line(GlyphMetrics &m, const uint32_t *cps, LayoutLine *line, float width, float ellipsis_w) {
+	float pen= 0, next;
+	size_t i;
+	line->ellipsis= true;
+	if (width > 0) {
+		for (i= line->start; i < line->end; i++) {
+			next= pen + m.advance(cps[i]) + (i > line->start? m.kern(cps[i-1], cps[i]) : 0);
+			if (next + ellipsis_w > width) break;
+			pen= next;
+		}
+		line->end= i;
+	}
+	while (line->end > line->start && is_break_space(cps[line->end-1])) line->end--;
+	line->width= measure_run(m, cps, line->start, line->end);
+}
+
+/* Break codepoints into lines at newlines, and if 'wrap' is set, at spaces (or mid-word if a
+ * word doesn't fit) to keep each line within 'width'.  If 'wrap' is not set, lines wider than
+ * 'width' are shortened and get an ellipsis.  If 'max_lines' is positive, text beyond that
+ * many lines is dropped and the last line gets an ellipsis.  Each codepoint is visited a
+ * constant number of times.  Returns the number of lines written to 'out', which needs room
+ * for n+1 lines.
+ */
+static size_t layout_lines(GlyphMetrics &m, const uint32_t *cps, size_t n, float width, bool wrap,
+	int max_lines, float ellipsis_w, LayoutLine *out
+) {
+	size_t n_lines= 0, i= 0, brk;
+	float pen, brk_pen, adv;
+	LayoutLine *line;
+	while (i <= n) {
+		if (max_lines > 0 && n_lines == (size_t) max_lines) {
+			/* if more text remains, mark the previous line */
+			if (i < n) ellipsize_line(m, cps, out + n_lines - 1, width, ellipsis_w);
+			break;
+		}
+		line= out + n_lines++;
+		line->start= i;
+		line->ellipsis= false;
+		pen= brk_pen= 0;
+		brk= 0;
+		for (; i < n && cps[i] != '\n'; i++) {
+			adv= m.advance(cps[i]) + (i > line->start? m.kern(cps[i-1], cps[i]) : 0);
+			if (width > 0 && pen + adv > width && i > line->start && !is_break_space(cps[i])) {
+				if (!wrap) {
+					/* skip the rest of this line */
+					line->end= i;
+					line->width= pen;
+					ellipsize_line(m, cps, line, width, ellipsis_w);
+					while (i < n && cps[i] != '\n') i++;
+					goto next_line;
+				}
+				if (brk) { /* wrap at the last space */
+					line->end= brk;
+					line->width= brk_pen;
+					for (i= brk; i < n && is_break_space(cps[i]); i++);
+				}
+				else { /* single word wider than the line */
+					line->end= i;
+					line->width= pen;
+				}
+				goto wrapped;
+			}
+			if (is_break_space(cps[i]) && i > line->start && !is_break_space(cps[i-1])) {
+				brk= i;
+				brk_pen= pen;
+			}
+			pen += adv;
+		}
+		line->end= i;
+		line->width= pen;
+		next_line:
+		/* trailing spaces don't count toward the width */
+		while (line->end > line->start && is_break_space(cps[line->end-1])) line->end--;
+		if (line->end < i) line->width= measure_run(m, cps, line->start, line->end);
+		i++; /* skip the newline, or move past the end */
+		continue;
+		wrapped:
+		if (i >= n) break;
+	}
+	return n_lines;
+}
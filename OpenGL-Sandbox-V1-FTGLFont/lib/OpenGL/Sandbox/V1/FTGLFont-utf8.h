@@ -0,0 +1,20 @@
+/* Stepping through and counting the characters of a UTF-8 string, for monospace rendering.
+ *
+ * This is kept out of FTGLFont.cpp so that bench/cpu-bench.c of OpenGL-Sandbox can time the
+ * same code.  The string is assumed to be valid UTF-8.
+ */
+
+static const char * next_utf8(const char *str) {
+	if (!*str) return str;
+	++str;
+	while ((*str & 0xC0) == 0x80) str++;
+	return str;
+}
+
+static int count_utf8(const char *str) {
+	int n= 0;
+	while (*str) {
+		if ((*str++ & 0xC0) != 0x80) n++;
+	}
+	return n;
+}
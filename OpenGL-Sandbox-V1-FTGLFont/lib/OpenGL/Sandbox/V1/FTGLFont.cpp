@@ -2,19 +2,29 @@
 #include <GL/gl.h>
 #define SCALAR_REF_DATA(obj) (SvROK(obj) && SvPOK(SvRV(obj))? (void*)SvPVX(SvRV(obj)) : (void*)0)
 #define SCALAR_REF_LEN(obj)  (SvROK(obj) && SvPOK(SvRV(obj))? SvCUR(SvRV(obj)) : 0)
-
-static const char * next_utf8(const char *str);
-static int count_utf8(const char *str);
+#include "FTGLFont-layout.cpp"
+#include "FTGLFont-utf8.h"
 
 class FTFontWrapper {
 	SV *mmap_obj;
 	FTFont *font;
+	GlyphMetrics *metrics;
+	static float _ftgl_advance(void *font, const char *utf8, int n_chars) {
+		return ((FTFont*) font)->Advance(utf8, n_chars);
+	}
+	static const char *_utf8_bytes(SV *sv, STRLEN *len) {
+		/* upgrade a copy, rather than changing the caller's (possibly read-only) scalar */
+		if (!SvUTF8(sv)) sv= sv_2mortal(newSVsv(sv));
+		return SvPVutf8(sv, *len);
+	}
+	size_t _layout_text(SV *text, double width, bool wrap, int max_lines, SV *ellipsis,
+		const char **str, uint32_t **ofs, LayoutLine **lines, const char **ell_str);
 public:
 	/* Constructor takes one parameter of type OpenGL::Sandbox::MMap,
 	 * and retains a reference to it until destroyed.
 	 */
 	FTFontWrapper(SV *mmap, const char *font_class):
-		mmap_obj(mmap), font(NULL)
+		mmap_obj(mmap), font(NULL), metrics(NULL)
 	{
 		void *data= SCALAR_REF_DATA(mmap);
 		int len= SCALAR_REF_LEN(mmap);
@@ -38,9 +48,14 @@ public:
 			font= new FTBitmapFont((const unsigned char*) data, len);
 		else
 			croak("Un-handled font class %s", font_class);
+		metrics= new GlyphMetrics(_ftgl_advance, font);
 		SvREFCNT_inc_void_NN(mmap_obj);
 	}
 	~FTFontWrapper() {
+		if (metrics) {
+			delete metrics;
+			metrics= NULL;
+		}
 		if (font) {
 			delete font;
 			font= NULL;
@@ -69,6 +84,7 @@ public:
 				res= SvIV(Inline_Stack_Item(1));
 			if (res <= 0) res= 72; /* Sanity, because otherwise FTFont goes haywire */
 			if (!font->FaceSize(pt, res)) croak("invalid size");
+			metrics->reset();
 		}
 		return font->FaceSize();
 	}
@@ -92,8 +108,123 @@ public:
 
 	double advance(const char *text) { return font->Advance(text, -1); }
 	void render(const char *text, ...);
+
+	/* Layout functions, using the cached glyph metrics instead of asking FTGL each time */
+	double measure(SV *text);
+	void _layout(SV *text, double width, int wrap, int max_lines, SV *ellipsis);
+	void render_paragraph(SV *text, ...);
 };
 
+/* Decode the text and break it into lines.  The returned arrays are freed by perl at the end
+ * of the current statement.
+ */
+size_t FTFontWrapper::_layout_text(SV *text, double width, bool wrap, int max_lines, SV *ellipsis,
+	const char **str, uint32_t **ofs, LayoutLine **lines, const char **ell_str
+) {
+	STRLEN len;
+	uint32_t *cps;
+	size_t n, n_ell;
+	float ellipsis_w= 0;
+	*str= _utf8_bytes(text, &len);
+	Newx(cps, len*2 + 2, uint32_t);
+	SAVEFREEPV(cps);
+	*ofs= cps + len + 1;
+	n= decode_utf8((const unsigned char*) *str, len, cps, *ofs);
+	(*ofs)[n]= len;
+	*ell_str= "";
+	if (ellipsis && SvOK(ellipsis)) {
+		STRLEN ell_len;
+		uint32_t *ell_cps;
+		*ell_str= _utf8_bytes(ellipsis, &ell_len);
+		Newx(ell_cps, ell_len*2 + 2, uint32_t);
+		SAVEFREEPV(ell_cps);
+		n_ell= decode_utf8((const unsigned char*) *ell_str, ell_len, ell_cps, ell_cps + ell_len + 1);
+		ellipsis_w= measure_run(*metrics, ell_cps, 0, n_ell);
+	}
+	Newx(*lines, n + 1, LayoutLine);
+	SAVEFREEPV(*lines);
+	return layout_lines(*metrics, cps, n, width, wrap, max_lines, ellipsis_w, *lines);
+}
+
+double FTFontWrapper::measure(SV *text) {
+	const char *str, *ell;
+	uint32_t *ofs;
+	LayoutLine *lines;
+	size_t i, n= _layout_text(text, 0, false, 0, NULL, &str, &ofs, &lines, &ell);
+	double widest= 0;
+	for (i= 0; i < n; i++)
+		if (lines[i].width > widest) widest= lines[i].width;
+	return widest;
+}
+
+/* Returns the list of lines, as strings, including any ellipsis */
+void FTFontWrapper::_layout(SV *text, double width, int wrap, int max_lines, SV *ellipsis) {
+	const char *str, *ell;
+	uint32_t *ofs;
+	LayoutLine *lines;
+	size_t i, n= _layout_text(text, width, wrap, max_lines, ellipsis, &str, &ofs, &lines, &ell);
+	SV *line;
+	Inline_Stack_Vars;
+	Inline_Stack_Reset;
+	for (i= 0; i < n; i++) {
+		line= newSVpvn(str + ofs[lines[i].start], ofs[lines[i].end] - ofs[lines[i].start]);
+		if (lines[i].ellipsis) sv_catpv(line, ell);
+		SvUTF8_on(line);
+		Inline_Stack_Push(sv_2mortal(line));
+	}
+	Inline_Stack_Done;
+}
+
+void FTFontWrapper::render_paragraph(SV *text, ...) {
+	float x= 0, y= 0, z= 0, xalign= 0, yalign= 0, width= 0, line_height= font->LineHeight(),
+		px, py, height;
+	int i, wrap= 1, max_lines= 0;
+	SV *ellipsis= NULL, *value;
+	const char *key, *str, *ell;
+	uint32_t *ofs;
+	LayoutLine *lines;
+	size_t n;
+	
+	Inline_Stack_Vars;
+	if (Inline_Stack_Items & 1)
+		croak("Odd number of parameters passed to ->render_paragraph");
+	for (i= 2; i < Inline_Stack_Items-1; i+= 2) {
+		key= SvPV_nolen(Inline_Stack_Item(i));
+		value= Inline_Stack_Item(i+1);
+		if (!SvOK(value)) continue;
+		if      (strcmp(key, "x") == 0) x= SvNV(value);
+		else if (strcmp(key, "y") == 0) y= SvNV(value);
+		else if (strcmp(key, "z") == 0) z= SvNV(value);
+		else if (strcmp(key, "xalign") == 0) xalign= SvNV(value);
+		else if (strcmp(key, "yalign") == 0) yalign= SvNV(value);
+		else if (strcmp(key, "w") == 0 || strcmp(key, "width") == 0) width= SvNV(value);
+		else if (strcmp(key, "wrap") == 0) wrap= SvTRUE(value);
+		else if (strcmp(key, "max_lines") == 0) max_lines= SvIV(value);
+		else if (strcmp(key, "ellipsis") == 0) ellipsis= value;
+		else if (strcmp(key, "line_height") == 0) line_height= SvNV(value);
+		else croak("Invalid key '%s' in call to render_paragraph()", key);
+	}
+	if (!ellipsis) ellipsis= sv_2mortal(newSVpvs("..."));
+	n= _layout_text(text, width, wrap, max_lines, ellipsis, &str, &ofs, &lines, &ell);
+	
+	/* yalign refers to the whole block: 1 = top of first line, -1 = bottom of last line */
+	height= n? (n-1) * line_height : 0;
+	py= yalign > 0? y - font->Ascender() * yalign
+		: y - (height - font->Descender()) * yalign;
+	for (i= 0; i < (int) n; i++, py -= line_height) {
+		/* with a width, lines align within the box [x, x+width]; else around x */
+		px= width > 0? x + (width - lines[i].width) * xalign : x - lines[i].width * xalign;
+		if (lines[i].end > lines[i].start)
+			font->Render(str + ofs[lines[i].start], lines[i].end - lines[i].start, FTPoint(px, py, z));
+		if (lines[i].ellipsis)
+			font->Render(ell, -1, FTPoint(px + lines[i].width, py, z));
+	}
+	
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(newSViv(n)));
+	Inline_Stack_Done;
+}
+
 void FTFontWrapper::render(const char *text, ...) {
 	FTPoint pos(0,0);
 	float x= 0, y= 0, z= 0, xalign= 0, yalign= 0, scale= 1, xscale= 1, yscale= 1,
@@ -191,18 +322,3 @@ void FTFontWrapper::render(const char *text, ...) {
 	
 	Inline_Stack_Void;
 }
-
-static const char * next_utf8(const char *str) {
-	if (!*str) return str;
-	++str;
-	while ((*str & 0xC0) == 0x80) str++;
-	return str;
-}
-
-static int count_utf8(const char *str) {
-	int n= 0;
-	while (*str) {
-		if ((*str++ & 0xC0) != 0x80) n++;
-	}
-	return n;
-}
@@ -2,7 +2,9 @@ package OpenGL::Sandbox::V1::FTGLFont;
 use Moo;
 use Cwd;
 use OpenGL::Sandbox::V1 0.04;
+use OpenGL::Sandbox::V1::DisplayList;
 use OpenGL::Sandbox::MMap;
+use OpenGL::Sandbox qw( glGetIntegerv_p GL_LIST_INDEX );
 
 # ABSTRACT: Wrapper object for FTGL Fonts
 BEGIN {
@@ -48,7 +50,7 @@ The name this data was loaded from, for informational purposes only.
 
 When using textured fonts, this is roughly the pixel/texel size of the glyphs that will be
 rendered into the texture.  When using geometric fonts (i.e. polygon-based) this will be the
-OpenGL coordinate space scale of the font.
+OpenGL coordinate space scale of the font.  Changing it empties the L</render_cached> cache.
 
 =head2 ascender
 
@@ -63,17 +65,23 @@ as face_size.
 
 Line spacing for the font, in same units as face_size.
 
+=head2 layout_cache_size
+
+Maximum number of compiled strings kept by L</render_cached>.  Default is 256.
+
 =cut
 
 has filename => ( is => 'ro' );
 has type => ( is => 'ro', required => 1, default => sub { 'FTTextureFont' } );
 has data => ( is => 'ro', required => 1 );
+has layout_cache_size => ( is => 'rw', default => sub { 256 } );
+has _layout_cache => ( is => 'rw', default => sub { +{} } );
 has _ftgl_wrapper => ( is => 'lazy', handles => [qw(
-	face_size
 	ascender
 	descender
 	line_height
 	advance
+	measure
 )]);
 
 =head1 METHODS
@@ -84,14 +92,69 @@ has _ftgl_wrapper => ( is => 'lazy', handles => [qw(
 
 Calculate the width of a sting of text, in same units as face_size.
 
+=head2 measure
+
+  my $length= $font->measure("Line 1\nLine 2");
+
+Same as C<advance>, but returns the width of the widest line, and uses a table of glyph
+advances and kerning pairs cached in C instead of asking FTGL.  Each glyph or pair is only
+measured by FTGL the first time it is seen at the current L</face_size>, which makes this
+much faster for long or repeated text.  The table is also used by L</wrap>, L</ellipsize>
+and L</render_paragraph>.
+
+=head2 wrap
+
+  my @lines= $font->wrap($text, $width, %opts);
+
+Break text into lines no wider than C<$width> (in same units as face_size).  Lines break at
+newlines and spaces, or within a word if the word alone is too wide.  Options:
+
+=over
+
+=item C<max_lines>
+
+Drop any text beyond this many lines, and end the last line with the C<ellipsis>.
+
+=item C<ellipsis>
+
+The string appended to truncated lines.  Default is C<'...'>.
+
+=back
+
+=head2 ellipsize
+
+  my $short= $font->ellipsize($text, $width);
+  my $short= $font->ellipsize($text, $width, "\x{2026}");
+
+Shorten each line of the text to fit within C<$width>, ending any shortened line with the
+ellipsis string (default C<'...'>).  In list context, returns the lines.  In scalar context
+they are joined with newlines.
+
 =cut
 
+sub wrap {
+	my ($self, $text, $width, %opts)= @_;
+	$self->_ftgl_wrapper->_layout($text, $width, 1, $opts{max_lines} // 0, $opts{ellipsis} // '...');
+}
+
+sub ellipsize {
+	my ($self, $text, $width, $ellipsis)= @_;
+	my @lines= $self->_ftgl_wrapper->_layout($text, $width, 0, 0, $ellipsis // '...');
+	wantarray? @lines : join "\n", @lines;
+}
+
 sub BUILD {
 	my ($self, $args)= @_;
 	# Apply face size if given, else default
 	$self->face_size($args->{face_size} || 24);
 }
 
+sub face_size {
+	my $self= shift;
+	$self->clear_layout_cache if @_;
+	$self->_ftgl_wrapper->face_size(@_);
+}
+
 sub _build__ftgl_wrapper {
 	my $self= shift;
 	my $class= __PACKAGE__.'::FTFontWrapper';
@@ -168,6 +231,126 @@ sub render {
 	goto $_[0]->can('render');
 }
 
+=head2 render_paragraph
+
+  $font->render_paragraph($text, %opts);
+
+Render multiple lines of text, using the layout of L</wrap> or L</ellipsize>.  Options:
+
+=over
+
+=item C<x>, C<y>, C<z>
+
+Reference coordinate.  By default, the baseline of the first line starts here.
+
+=item C<width>, C<w>
+
+Width of the paragraph.  Lines are wrapped to this width.  This does not scale the text, unlike
+the C<width> option of L</render>.
+
+=item C<wrap>
+
+Defaults to true.  Set to false to instead shorten long lines with an ellipsis.
+
+=item C<max_lines>, C<ellipsis>
+
+Same as for L</wrap>.
+
+=item C<xalign>
+
+Each line is aligned within C<x> .. C<x+width> where C<0> is left-aligned and C<1> is
+right-aligned.  If no width is given, lines are aligned around C<x> like L</render>.
+
+=item C<yalign>
+
+Like L</render>, but for the whole block of text: C<1> puts the ascender-line of the first
+line at C<y>, C<0> puts the first baseline at C<y>, and C<-1> puts the descender-line of the
+last line at C<y>.
+
+=item C<line_height>
+
+Distance between baselines.  Defaults to L</line_height>.
+
+=back
+
+Returns the number of lines rendered.
+
+=cut
+
+sub render_paragraph {
+	my $self= shift;
+	if (@_ == 2 && ref $_[1] eq 'HASH') {
+		my $opts= pop;
+		push @_, %$opts;
+	}
+	unshift @_, $self->_ftgl_wrapper;
+	goto $_[0]->can('render_paragraph');
+}
+
+=head2 layout
+
+  my $glyph_run= $font->layout($text, %opts);
+  ...
+  $glyph_run->call;
+
+Compile the same drawing commands as L</render> into a L<OpenGL::Sandbox::V1::DisplayList>,
+which can then be replayed with one C<glCallList> and no measuring of the text.  The options
+are the same as for C<render>.  The list captures the font's current L</face_size>, and like
+C<render>, it does not set a color, so you can still change the color for each call.
+
+=head2 render_cached
+
+  $font->render_cached($text, %opts);
+
+Same as L</render>, but keeps the compiled L</layout> of each distinct combination of text and
+options, so that repeated labels are drawn by just calling the display list.  The least
+recently used layouts are discarded when there are more than L</layout_cache_size>.
+
+If a display list is being compiled when a new layout is needed, this just renders the text.
+
+=head2 clear_layout_cache
+
+Discard all layouts kept by L</render_cached>.  This happens automatically when
+L</face_size> changes.
+
+=cut
+
+sub layout {
+	my ($self, $text, @opts)= @_;
+	# FTGL creates glyphs (and uploads their textures) on first use.  Make that happen now,
+	# so that those one-time commands don't become part of the list.
+	$self->_ftgl_wrapper->advance($text);
+	OpenGL::Sandbox::V1::DisplayList->new->compile(sub { $self->render($text, @opts) });
+}
+
+sub render_cached {
+	my $self= shift;
+	my $text= shift;
+	my %opts= @_ == 1 && ref $_[0] eq 'HASH'? %{ $_[0] } : @_;
+	my $key= join "\0", $text, map +($_, $opts{$_} // ''), sort keys %opts;
+	my $cache= $self->_layout_cache;
+	if (my $entry= $cache->{$key}) {
+		$entry->[1]= ++$self->{_layout_clock};
+		return $entry->[0]->call;
+	}
+	# Can't compile a new list while the caller is compiling one
+	return $self->render($text, %opts)
+		if glGetIntegerv_p(GL_LIST_INDEX, 1);
+	if (keys %$cache >= $self->layout_cache_size) {
+		# Evict the least recently used quarter, to amortize the sort
+		my @lru= sort { $cache->{$a}[1] <=> $cache->{$b}[1] } keys %$cache;
+		delete @{$cache}{ @lru[0 .. int($#lru/4)] };
+	}
+	my $list= $self->layout($text, %opts);
+	$cache->{$key}= [ $list, ++$self->{_layout_clock} ];
+	$list->call;
+}
+
+sub clear_layout_cache {
+	%{ $_[0]->_layout_cache }= ();
+	$_[0];
+}
+
 use OpenGL::Sandbox::V1::FTGLFont::Inline
 	CPP => do { my $x= __FILE__; $x =~ s/\.pm$/\.cpp/; $x },
 	INC => '-I/usr/include/FTGL -I/usr/include/freetype2 -I'
@@ -19,4 +19,19 @@ is( $font->descender,            -8, 'descender' );
 is( int($font->line_height),     42, 'line_height' );
 is( int($font->advance("Test")), 61, 'advance("Test")' );
 
+subtest layout => sub {
+	is( int($font->measure("Test")), 61, 'measure("Test")' );
+	is( $font->measure("Test\nTest Test"), $font->advance("Test Test"), 'measure widest line' );
+	is_deeply( [ $font->wrap("Test Test  Test", 70) ], [ 'Test', 'Test', 'Test' ], 'wrap at spaces' );
+	my @lines= $font->wrap("Test Test Test", 70, max_lines => 2);
+	is( scalar @lines, 2, 'wrap max_lines' );
+	like( $lines[1], qr/^Te.*\.\.\.$/, 'last line ellipsized' );
+	my $short= $font->ellipsize("Test Test Test", 100);
+	like( $short, qr/^Test.*\.\.\.$/, 'ellipsize' );
+	ok( $font->measure($short) <= 100, 'ellipsized text fits' );
+	is( $font->ellipsize("Test", 100), "Test", 'short text unchanged' );
+	$font->face_size(20);
+	ok( $font->measure("Test") < 61, 'metrics follow face_size' );
+};
+
 done_testing;
\ No newline at end of file
@@ -116,6 +116,17 @@ show {
 	$font->render("monospaced Left", xalign => 0, monospace => 15);
 };
 
+for (1..3) {
+	show {
+		draw_boundbox( -50, $font->descender, 50, $font->ascender );
+		$font->render_cached('Cached', xalign => .5, scale => 2);
+		$font->render_cached('Cached Small', xalign => .5, y => -50);
+	};
+}
+is( scalar keys %{ $font->_layout_cache }, 2, 'two cached layouts' );
+$font->face_size($font->face_size);
+is( scalar keys %{ $font->_layout_cache }, 0, 'face_size clears layout cache' );
+
 undef $c;
 
 done_testing;
@@ -0,0 +1,49 @@
+/* Parsing of the color arguments accepted by setcolor, color_parts, color_mult and friends.
+ *
+ * This is kept out of V1.cpp so that bench/cpu-bench.c of OpenGL-Sandbox can time the same
+ * code.  It doesn't call GL, and compiles as C or C++ after the perl headers.
+ */
+
+/* OpenGL::Sandbox::V1::Color objects are scalar refs holding 4 packed floats, so that
+ * frequently-used colors skip parsing.  Returns NULL if 'c' is not one of these.
+ */
+static HV *color_stash= NULL;
+static const GLfloat* _color_obj_floats(SV *c) {
+	SV *inner;
+	if (!SvROK(c) || !SvOBJECT(inner= SvRV(c))) return NULL;
+	if (!color_stash) color_stash= gv_stashpv("OpenGL::Sandbox::V1::Color", GV_ADD);
+	if (SvSTASH(inner) != color_stash || !SvPOK(inner) || SvCUR(inner) != 4 * sizeof(GLfloat))
+		return NULL;
+	return (const GLfloat*) SvPVX(inner);
+}
+
+/* Parse a color given as a Color object, an arrayref of components, or a "#RRGGBB[AA]"
+ * string into 4 doubles.  undef is opaque black.
+ */
+static void _parse_color(SV *c, double *rgba) {
+	SV **field_p;
+	int i, n;
+	unsigned hex_rgba[4];
+	const GLfloat *obj_f;
+	if ((obj_f= _color_obj_floats(c))) {
+		for (i=0; i < 4; i++)
+			rgba[i]= obj_f[i];
+	}
+	else if (!SvOK(c)) {
+		rgba[0]= rgba[1]= rgba[2]= 0;
+		rgba[3]= 1;
+	}
+	else if (SvROK(c) && SvTYPE(SvRV(c)) == SVt_PVAV) {
+		for (i=0; i < 4; i++) {
+			field_p= av_fetch((AV*) SvRV(c), i, 0);
+			rgba[i]= (field_p && *field_p && SvOK(*field_p))? SvNV(*field_p) : 0;
+		}
+	}
+	else {
+		n= sscanf(SvPV_nolen(c), "#%2x%2x%2x%2x", hex_rgba+0, hex_rgba+1, hex_rgba+2, hex_rgba+3);
+		if (n < 3) croak("Not a valid color: %s", SvPV_nolen(c));
+		if (n < 4) hex_rgba[3]= 0xFF;
+		for (i=0; i < 4; i++)
+			rgba[i]= hex_rgba[i] / 255.0;
+	}
+}
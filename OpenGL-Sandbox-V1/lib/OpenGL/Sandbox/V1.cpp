@@ -1,5 +1,7 @@
+#define GL_GLEXT_PROTOTYPES
 #include <GL/gl.h>
 #include <GL/glu.h>
+#include "V1-color.h"
 
 /* Reading from perl hashes is annoying.  This simplified function only returns
  * non-NULL if the key existed and the value was defined.
@@ -9,13 +11,116 @@ static SV *_fetch_if_defined(HV *self, const char *field, int len) {
 	return (field_p && *field_p && SvOK(*field_p)) ? *field_p : NULL;
 }
 
+/* Each cached quadric mesh is identified by the shape, its parameters, and the state of the
+ * quadric at the time it was plotted.  These are packed into an array of doubles so that a
+ * lookup is just a memcmp.
+ */
+#define QUADRIC_KEY_SHAPE     0
+#define QUADRIC_KEY_STYLE     1
+#define QUADRIC_KEY_NORMALS   2
+#define QUADRIC_KEY_ORIENT    3
+#define QUADRIC_KEY_TEXTURE   4
+#define QUADRIC_KEY_PARAMS    5
+#define QUADRIC_KEY_LEN      11
+#define QUADRIC_DEFAULT_CACHE_LIMIT 64
+
+enum { QUADRIC_CYLINDER= 1, QUADRIC_SPHERE, QUADRIC_DISK, QUADRIC_PARTIAL_DISK };
+
 class Quadric {
 	GLUquadric *q;
+	/* GLU has no getters, so track the state needed for the cache key */
+	int cur_style, cur_normals, cur_orient, cur_texture;
+	/* cache of display lists, with least-recently-used eviction */
+	int max_cached, cache_count;
+	unsigned long cache_clock;
+	GLuint *cache_list;
+	unsigned long *cache_used;
+	double *cache_key;
+
+	void _plot(const double *key) {
+		const double *p= key + QUADRIC_KEY_PARAMS;
+		switch ((int) key[QUADRIC_KEY_SHAPE]) {
+		case QUADRIC_CYLINDER:     gluCylinder(q, p[0], p[1], p[2], (int) p[3], (int) p[4]); break;
+		case QUADRIC_SPHERE:       gluSphere(q, p[0], (int) p[1], (int) p[2]); break;
+		case QUADRIC_DISK:         gluDisk(q, p[0], p[1], (int) p[2], (int) p[3]); break;
+		case QUADRIC_PARTIAL_DISK: gluPartialDisk(q, p[0], p[1], (int) p[2], (int) p[3], p[4], p[5]); break;
+		}
+	}
+	void _free_cache() {
+		int i;
+		for (i= 0; i < cache_count; i++)
+			glDeleteLists(cache_list[i], 1);
+		cache_count= 0;
+		delete[] cache_list; cache_list= NULL;
+		delete[] cache_used; cache_used= NULL;
+		delete[] cache_key;  cache_key= NULL;
+	}
+	/* Return the cache slot for a key, evicting the least-recently-used mesh if full */
+	int _cache_slot() {
+		int i, oldest= 0;
+		if (!cache_list) {
+			cache_list= new GLuint[max_cached];
+			cache_used= new unsigned long[max_cached];
+			cache_key=  new double[max_cached * QUADRIC_KEY_LEN];
+		}
+		if (cache_count < max_cached)
+			return cache_count++;
+		for (i= 1; i < cache_count; i++)
+			if (cache_used[i] < cache_used[oldest])
+				oldest= i;
+		glDeleteLists(cache_list[oldest], 1);
+		return oldest;
+	}
+	void _draw(int shape, double p0, double p1, double p2, double p3, double p4, double p5) {
+		double key[QUADRIC_KEY_LEN];
+		GLint compiling= 0;
+		GLuint list_id;
+		int i;
+		key[QUADRIC_KEY_SHAPE]=   shape;
+		key[QUADRIC_KEY_STYLE]=   cur_style;
+		key[QUADRIC_KEY_NORMALS]= cur_normals;
+		key[QUADRIC_KEY_ORIENT]=  cur_orient;
+		key[QUADRIC_KEY_TEXTURE]= cur_texture;
+		key[QUADRIC_KEY_PARAMS+0]= p0; key[QUADRIC_KEY_PARAMS+1]= p1;
+		key[QUADRIC_KEY_PARAMS+2]= p2; key[QUADRIC_KEY_PARAMS+3]= p3;
+		key[QUADRIC_KEY_PARAMS+4]= p4; key[QUADRIC_KEY_PARAMS+5]= p5;
+		/* Display lists can't be created while another is being compiled, so in that case
+		 * just plot the geometry into the user's list. */
+		if (max_cached > 0)
+			glGetIntegerv(GL_LIST_INDEX, &compiling);
+		if (max_cached <= 0 || compiling) {
+			_plot(key);
+			return;
+		}
+		for (i= 0; i < cache_count; i++) {
+			if (memcmp(cache_key + i * QUADRIC_KEY_LEN, key, sizeof(key)) == 0) {
+				cache_used[i]= ++cache_clock;
+				glCallList(cache_list[i]);
+				return;
+			}
+		}
+		if (!(list_id= glGenLists(1))) {
+			_plot(key);
+			return;
+		}
+		i= _cache_slot();
+		cache_list[i]= list_id;
+		cache_used[i]= ++cache_clock;
+		memcpy(cache_key + i * QUADRIC_KEY_LEN, key, sizeof(key));
+		glNewList(list_id, GL_COMPILE_AND_EXECUTE);
+		_plot(key);
+		glEndList();
+	}
 public:
-	Quadric(): q(NULL) {
+	Quadric(): q(NULL),
+		cur_style(GLU_FILL), cur_normals(GLU_SMOOTH), cur_orient(GLU_OUTSIDE), cur_texture(0),
+		max_cached(QUADRIC_DEFAULT_CACHE_LIMIT), cache_count(0), cache_clock(0),
+		cache_list(NULL), cache_used(NULL), cache_key(NULL)
+	{
 		q= gluNewQuadric();
 	}
 	~Quadric() {
+		_free_cache();
 		if (q) gluDeleteQuadric(q), q= NULL;
 	}
 	
@@ -24,6 +129,7 @@ public:
 		Inline_Stack_Vars;
 		(void)items; // silence warning
 		gluQuadricDrawStyle(q, style);
+		cur_style= style;
 		Inline_Stack_Reset;
 		Inline_Stack_Push(Inline_Stack_Item(0));
 		Inline_Stack_Done;
@@ -37,6 +143,7 @@ public:
 		Inline_Stack_Vars;
 		(void)items; // silence warning
 		gluQuadricNormals(q, normals == 0? GLU_NONE : normals);
+		cur_normals= normals == 0? GLU_NONE : normals;
 		Inline_Stack_Reset;
 		Inline_Stack_Push(Inline_Stack_Item(0));
 		Inline_Stack_Done;
@@ -49,6 +156,7 @@ public:
 		Inline_Stack_Vars;
 		(void)items; // silence warning
 		gluQuadricOrientation(q, orient);
+		cur_orient= orient;
 		Inline_Stack_Reset;
 		Inline_Stack_Push(Inline_Stack_Item(0));
 		Inline_Stack_Done;
@@ -60,33 +168,181 @@ public:
 		Inline_Stack_Vars;
 		(void)items; // silence warning
 		gluQuadricTexture(q, enabled? GLU_TRUE : GLU_FALSE);
+		cur_texture= enabled? 1 : 0;
+		Inline_Stack_Reset;
+		Inline_Stack_Push(Inline_Stack_Item(0));
+		Inline_Stack_Done;
+	}
+	
+	void cache_limit(int limit) {
+		Inline_Stack_Vars;
+		(void)items; // silence warning
+		_free_cache(); /* slots are allocated to the size of the limit */
+		max_cached= limit > 0? limit : 0;
+		Inline_Stack_Reset;
+		Inline_Stack_Push(Inline_Stack_Item(0));
+		Inline_Stack_Done;
+	}
+	int cached_mesh_count() { return cache_count; }
+	void clear_cache() {
+		Inline_Stack_Vars;
+		(void)items; // silence warning
+		_free_cache();
 		Inline_Stack_Reset;
 		Inline_Stack_Push(Inline_Stack_Item(0));
 		Inline_Stack_Done;
 	}
 	
 	void cylinder(double base, double top, double height, int slices, int stacks) {
-		gluCylinder(q, base, top, height, slices, stacks);
+		_draw(QUADRIC_CYLINDER, base, top, height, slices, stacks, 0);
 	}
 	void sphere(double radius, int slices, int stacks) {
-		gluSphere(q, radius, slices, stacks);
+		_draw(QUADRIC_SPHERE, radius, slices, stacks, 0, 0, 0);
 	}
 	void disk(double inner, double outer, int slices, int stacks) {
-		gluDisk(q, inner, outer, slices, stacks);
+		_draw(QUADRIC_DISK, inner, outer, slices, stacks, 0, 0);
 	}
 	void partial_disk(double inner, double outer, int slices, int loops, double start, double sweep) {
-		gluPartialDisk(q, inner, outer, slices, loops, start, sweep);
+		_draw(QUADRIC_PARTIAL_DISK, inner, outer, slices, loops, start, sweep);
+	}
+};
+
+/* Tracked state scopes: rather than saving everything up front, the V1 functions which
+ * change state (setcolor, set_light_*) save the previous value the first time they change it
+ * within the innermost tracked scope, and the scope restores only those values on exit.
+ * Records are (target, pname, value[4]) where target is 0 for the current color.
+ */
+static int tracked_depth= 0, tracked_depth_alloc= 0;
+static int *tracked_scope_start= NULL;
+static int tracked_count= 0, tracked_alloc= 0;
+static GLenum *tracked_target= NULL, *tracked_pname= NULL;
+static GLfloat *tracked_value= NULL;
+
+static void _read_state(GLenum target, GLenum pname, GLfloat *dest) {
+	if (target)
+		glGetLightfv(target, pname, dest);
+	else
+		glGetFloatv(pname, dest);
+}
+
+static void _track_state(GLenum target, GLenum pname) {
+	int i;
+	if (!tracked_depth) return;
+	for (i= tracked_scope_start[tracked_depth-1]; i < tracked_count; i++)
+		if (tracked_target[i] == target && tracked_pname[i] == pname)
+			return; /* already saved in this scope */
+	if (tracked_count >= tracked_alloc) {
+		tracked_alloc= tracked_alloc? tracked_alloc * 2 : 16;
+		Renew(tracked_target, tracked_alloc, GLenum);
+		Renew(tracked_pname, tracked_alloc, GLenum);
+		Renew(tracked_value, tracked_alloc * 4, GLfloat);
+	}
+	tracked_target[tracked_count]= target;
+	tracked_pname[tracked_count]= pname;
+	_read_state(target, pname, tracked_value + tracked_count * 4);
+	tracked_count++;
+}
+
+/* The current value of a state that a tracked scope can restore, as 4 floats (for tests) */
+void _tracked_state_value(int target, int pname) {
+	GLfloat v[4];
+	int i;
+	Inline_Stack_Vars;
+	(void)items; // silence warning
+	_read_state(target, pname, v);
+	Inline_Stack_Reset;
+	for (i= 0; i < 4; i++)
+		Inline_Stack_Push(sv_2mortal(newSVnv(v[i])));
+	Inline_Stack_Done;
+}
+
+/* State can't be queried between glBegin and glEnd, so save the color before beginning */
+#define _track_before_begin() if (tracked_depth) _track_state(0, GL_CURRENT_COLOR)
+
+static void _tracked_scope_begin() {
+	if (tracked_depth >= tracked_depth_alloc) {
+		tracked_depth_alloc= tracked_depth_alloc? tracked_depth_alloc * 2 : 8;
+		Renew(tracked_scope_start, tracked_depth_alloc, int);
+	}
+	tracked_scope_start[tracked_depth++]= tracked_count;
+}
+
+static void _tracked_scope_end() {
+	GLint matrix_mode;
+	int start= tracked_scope_start[--tracked_depth];
+	GLfloat *v;
+	while (tracked_count > start) {
+		--tracked_count;
+		v= tracked_value + tracked_count * 4;
+		if (!tracked_target[tracked_count])
+			glColor4fv(v);
+		else if (tracked_pname[tracked_count] == GL_POSITION) {
+			/* light positions are read back in eye coordinates */
+			glGetIntegerv(GL_MATRIX_MODE, &matrix_mode);
+			glMatrixMode(GL_MODELVIEW);
+			glPushMatrix();
+			glLoadIdentity();
+			glLightfv(tracked_target[tracked_count], GL_POSITION, v);
+			glPopMatrix();
+			glMatrixMode(matrix_mode);
+		}
+		else
+			glLightfv(tracked_target[tracked_count], tracked_pname[tracked_count], v);
 	}
+}
+
+static const char *local_gl_category_names[]= {
+	"accum", "color_buffer", "current", "depth_buffer", "enable", "eval", "fog", "hint",
+	"lighting", "line", "list", "multisample", "pixel_mode", "point", "polygon",
+	"polygon_stipple", "scissor", "stencil_buffer", "texture", "transform", "viewport", "all",
+	NULL
+};
+static const GLbitfield local_gl_category_bits[]= {
+	GL_ACCUM_BUFFER_BIT, GL_COLOR_BUFFER_BIT, GL_CURRENT_BIT, GL_DEPTH_BUFFER_BIT, GL_ENABLE_BIT,
+	GL_EVAL_BIT, GL_FOG_BIT, GL_HINT_BIT, GL_LIGHTING_BIT, GL_LINE_BIT, GL_LIST_BIT,
+	GL_MULTISAMPLE_BIT, GL_PIXEL_MODE_BIT, GL_POINT_BIT, GL_POLYGON_BIT, GL_POLYGON_STIPPLE_BIT,
+	GL_SCISSOR_BIT, GL_STENCIL_BUFFER_BIT, GL_TEXTURE_BIT, GL_TRANSFORM_BIT, GL_VIEWPORT_BIT,
+	GL_ALL_ATTRIB_BITS
 };
 
-void _local_gl(SV *code) {
+void _local_gl(SV *code, ...) {
+	Inline_Stack_Vars;
 	GLint orig_depth, depth;
+	GLbitfield mask= 0;
+	int i, j, tracked= 0;
+	const char *name;
+	SV *arg;
+	/* No categories means save everything, like it always did */
+	if (Inline_Stack_Items == 1)
+		mask= GL_ALL_ATTRIB_BITS;
+	for (i= 1; i < Inline_Stack_Items; i++) {
+		arg= Inline_Stack_Item(i);
+		if (SvIOK(arg)) {
+			mask |= SvUV(arg);
+			continue;
+		}
+		name= SvPV_nolen(arg);
+		if (strcmp(name, "tracked") == 0) {
+			tracked= 1;
+			continue;
+		}
+		for (j= 0; local_gl_category_names[j]; j++)
+			if (strcmp(name, local_gl_category_names[j]) == 0)
+				break;
+		if (!local_gl_category_names[j])
+			croak("Unknown state category '%s' in call to local_gl", name);
+		mask |= local_gl_category_bits[j];
+	}
 	glGetIntegerv(GL_MODELVIEW_STACK_DEPTH, &orig_depth);
-	glPushAttrib(GL_ALL_ATTRIB_BITS);
+	if (mask) glPushAttrib(mask);
+	if (tracked) _tracked_scope_begin();
 	glPushMatrix();
+	PUSHMARK(SP);
+	PUTBACK;
 	call_sv(code, G_NOARGS|G_DISCARD|G_ARRAY|G_EVAL);
 	glPopMatrix();
-	glPopAttrib();
+	if (tracked) _tracked_scope_end();
+	if (mask) glPopAttrib();
 	glGetIntegerv(GL_MODELVIEW_STACK_DEPTH, &depth);
 	if (depth > orig_depth) {
 		warn("cleaning up matrix stack: depth=%d, orig=%d", depth, orig_depth);
@@ -94,6 +350,7 @@ void _local_gl(SV *code) {
 			glPopMatrix();
 	}
 	if (SvTRUE(ERRSV)) croak(NULL);
+	Inline_Stack_Void;
 }
 
 void _local_matrix(SV *code) {
@@ -181,6 +438,7 @@ void mirror(const char* axis) {
 }
 
 void _quads(SV *code) {
+	_track_before_begin();
 	glBegin(GL_QUADS);
 	call_sv(code, G_NOARGS|G_DISCARD|G_ARRAY|G_EVAL);
 	glEnd();
@@ -188,6 +446,7 @@ void _quads(SV *code) {
 }
 
 void _quad_strip(SV *code) {
+	_track_before_begin();
 	glBegin(GL_QUAD_STRIP);
 	call_sv(code, G_NOARGS|G_DISCARD|G_ARRAY|G_EVAL);
 	glEnd();
@@ -195,6 +454,7 @@ void _quad_strip(SV *code) {
 }
 
 void _triangles(SV* code) {
+	_track_before_begin();
 	glBegin(GL_TRIANGLES);
 	call_sv(code, G_NOARGS|G_DISCARD|G_ARRAY|G_EVAL);
 	glEnd();
@@ -202,6 +462,7 @@ void _triangles(SV* code) {
 }
 
 void _triangle_fan(SV *code) {
+	_track_before_begin();
 	glBegin(GL_TRIANGLE_FAN);
 	call_sv(code, G_NOARGS|G_DISCARD|G_ARRAY|G_EVAL);
 	glEnd();
@@ -209,6 +470,7 @@ void _triangle_fan(SV *code) {
 }
 
 void _triangle_strip(SV *code) {
+	_track_before_begin();
 	glBegin(GL_TRIANGLE_STRIP);
 	call_sv(code, G_NOARGS|G_DISCARD|G_ARRAY|G_EVAL);
 	glEnd();
@@ -348,6 +610,7 @@ void plot_rect3(double x0, double y0, double z0, double x1, double y1, double z1
 void _setcolor(SV *thing, ...) {
 	Inline_Stack_Vars;
 	unsigned c;
+	_track_state(0, GL_CURRENT_COLOR);
 	if (Inline_Stack_Items == 4) {
 		glColor4d(SvNV(thing), SvNV(Inline_Stack_Item(1)), SvNV(Inline_Stack_Item(2)), SvNV(Inline_Stack_Item(3)));
 	}
@@ -415,7 +678,16 @@ void _displaylist_call(SV *self, ...) {
 	Inline_Stack_Done;
 }
 
-static void _parse_color(SV *c, double *rgba);
+/* Store a packed result into 'dest' (a scalar, or a ref to a scalar) re-using its buffer,
+ * or return a new scalar if dest is NULL.
+ */
+static SV* _packed_result(SV *dest, const void *data, size_t len) {
+	if (!dest)
+		return newSVpvn((const char*) data, len);
+	sv_setpvn(SvROK(dest)? SvRV(dest) : dest, (const char*) data, len);
+	return SvREFCNT_inc(dest);
+}
+
 /* would prefer this to be a function, but the Inline_Stack_* macros seem to get messed up
    if you run them from a called function */
 #define _color_from_stack(dest) \
@@ -439,11 +711,18 @@ void setcolor(SV *c0, ...) {
 	double components[4];
 	GLfloat components_f[4];
 	int i;
+	const GLfloat *obj_f;
 	(void)items; /* silence warning */
 	
+	if (Inline_Stack_Items == 1 && (obj_f= _color_obj_floats(c0))) {
+		_track_state(0, GL_CURRENT_COLOR);
+		glColor4fv(obj_f);
+		Inline_Stack_Void;
+	}
 	_color_from_stack(components);
 	for (i= 0; i < 4; i++)
 		components_f[i]= components[i];
+	_track_state(0, GL_CURRENT_COLOR);
 	glColor4fv(components_f);
 	Inline_Stack_Void;
 }
@@ -461,6 +740,37 @@ void color_parts(SV *c, ...) {
 	Inline_Stack_Done;
 }
 
+void color_parts_packed(SV *c0, ...) {
+	Inline_Stack_Vars;
+	double components[4];
+	GLfloat components_f[4];
+	int i;
+	(void)items; /* silence warning */
+	
+	_color_from_stack(components);
+	for (i= 0; i < 4; i++)
+		components_f[i]= components[i];
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(_packed_result(NULL, components_f, sizeof(components_f))));
+	Inline_Stack_Done;
+}
+
+void color_mult_packed(SV *c0, SV *c1, ...) {
+	Inline_Stack_Vars;
+	double components[8];
+	GLfloat components_f[4];
+	SV *dest= Inline_Stack_Items > 2? Inline_Stack_Item(2) : NULL;
+	int i;
+	
+	_parse_color(c0, components);
+	_parse_color(c1, components+4);
+	for (i= 0; i < 4; i++)
+		components_f[i]= components[i] * components[i+4];
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(_packed_result(dest, components_f, sizeof(components_f))));
+	Inline_Stack_Done;
+}
+
 void color_mult(SV *c0, SV *c1) {
 	Inline_Stack_Vars;
 	double components[8];
@@ -475,46 +785,254 @@ void color_mult(SV *c0, SV *c1) {
 	Inline_Stack_Done;
 }
 
-static void _parse_color(SV *c, double *rgba) {
-	SV **field_p;
-	int i, n;
-	unsigned hex_rgba[4];
-	if (!SvOK(c)) {
-		rgba[0]= rgba[1]= rgba[2]= 0;
-		rgba[3]= 1;
-	}
-	else if (SvROK(c) && SvTYPE(SvRV(c)) == SVt_PVAV) {
-		for (i=0; i < 4; i++) {
-			field_p= av_fetch((AV*) SvRV(c), i, 0);
-			rgba[i]= (field_p && *field_p && SvOK(*field_p))? SvNV(*field_p) : 0;
-		}
-	}
-	else {
-		n= sscanf(SvPV_nolen(c), "#%2x%2x%2x%2x", hex_rgba+0, hex_rgba+1, hex_rgba+2, hex_rgba+3);
-		if (n < 3) croak("Not a valid color: %s", SvPV_nolen(c));
-		if (n < 4) hex_rgba[3]= 0xFF;
-		for (i=0; i < 4; i++)
-			rgba[i]= hex_rgba[i] / 255.0;
-	}
-}
-
 void set_light_ambient(int light_i, float r, float g, float b, float a) {
 	GLfloat v[4]= { r, g, b, a };
+	_track_state(light_i, GL_AMBIENT);
 	glLightfv(light_i, GL_AMBIENT, v);
 }
 void set_light_diffuse(int light_i, float r, float g, float b, float a) {
 	GLfloat v[4]= { r, g, b, a };
+	_track_state(light_i, GL_DIFFUSE);
 	glLightfv(light_i, GL_DIFFUSE, v);
 }
 void set_light_specular(int light_i, float r, float g, float b, float a) {
 	GLfloat v[4]= { r, g, b, a };
+	_track_state(light_i, GL_SPECULAR);
 	glLightfv(light_i, GL_SPECULAR, v);
 }
 void set_light_position(int light_i, float x, float y, float z, float w) {
 	GLfloat v[4]= { x, y, z, w };
+	_track_state(light_i, GL_POSITION);
 	glLightfv(light_i, GL_POSITION, v);
 }
 
+/* Sprite batching: while a batch is active, _texture_render appends two triangles to a
+ * buffer instead of drawing, and the buffer is drawn with one glDrawArrays per texture
+ * when the batch ends.  Vertices are (x, y, z, w, s, t, r, g, b, a) floats.
+ *
+ * For the fixed-function path, the modelview matrix and color can change between sprites,
+ * so each vertex is transformed to eye coordinates and given the current color as it is
+ * appended, and the batch is drawn with an identity modelview and a color array.
+ */
+#define SPRITE_FLOATS_PER_VERTEX 10
+#define SPRITE_FLOATS (6 * SPRITE_FLOATS_PER_VERTEX)
+#define SPRITE_TEX_OFS 4
+#define SPRITE_COLOR_OFS 6
+
+static int sprite_batch_depth= 0;
+static int sprite_count= 0, sprite_alloc= 0;
+static float *sprite_verts= NULL, *sprite_sorted= NULL;
+static GLuint *sprite_tex= NULL;
+static int *sprite_order= NULL;
+static GLuint sprite_vbo= 0;
+static int sprite_pos_attr= -1, sprite_tex_attr= -1;
+
+static void _sprite_batch_append(GLuint tx_id, double x, double y, double z, double w, double h,
+	double s, double t, double s_rep, double t_rep
+) {
+	static const GLfloat identity[16]= { 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 };
+	GLfloat modelview[16], color[4]= { 1, 1, 1, 1 };
+	const GLfloat *m= identity;
+	float *v;
+	if (sprite_count >= sprite_alloc) {
+		sprite_alloc= sprite_alloc? sprite_alloc * 2 : 256;
+		Renew(sprite_verts, sprite_alloc * SPRITE_FLOATS, float);
+		Renew(sprite_tex, sprite_alloc, GLuint);
+	}
+	/* A shader gets the coordinates as given, and applies its own uniforms */
+	if (sprite_pos_attr < 0) {
+		glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+		glGetFloatv(GL_CURRENT_COLOR, color);
+		m= modelview;
+	}
+	sprite_tex[sprite_count]= tx_id;
+	v= sprite_verts + sprite_count * SPRITE_FLOATS;
+	/* m is column-major */
+	#define SPRITE_VERTEX(vx, vy, vs, vt) \
+		*v++= m[0]*(vx) + m[4]*(vy) + m[8]*z  + m[12]; \
+		*v++= m[1]*(vx) + m[5]*(vy) + m[9]*z  + m[13]; \
+		*v++= m[2]*(vx) + m[6]*(vy) + m[10]*z + m[14]; \
+		*v++= m[3]*(vx) + m[7]*(vy) + m[11]*z + m[15]; \
+		*v++= vs; *v++= vt; \
+		*v++= color[0]; *v++= color[1]; *v++= color[2]; *v++= color[3];
+	SPRITE_VERTEX(x,   y,   s,       t      )
+	SPRITE_VERTEX(x+w, y,   s+s_rep, t      )
+	SPRITE_VERTEX(x+w, y+h, s+s_rep, t+t_rep)
+	SPRITE_VERTEX(x,   y,   s,       t      )
+	SPRITE_VERTEX(x+w, y+h, s+s_rep, t+t_rep)
+	SPRITE_VERTEX(x,   y+h, s,       t+t_rep)
+	#undef SPRITE_VERTEX
+	sprite_count++;
+}
+
+/* The shader path repoints generic attributes of whatever vertex array is bound, so the
+ * caller's setup of those attribute slots is saved first and put back after drawing.
+ */
+struct sprite_attr_state {
+	GLint enabled, size, type, normalized, stride, buffer, integer;
+	GLvoid *pointer;
+};
+
+static void _sprite_attr_save(GLuint attr, struct sprite_attr_state *st, int gl_major) {
+	glGetVertexAttribiv(attr, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &st->enabled);
+	glGetVertexAttribiv(attr, GL_VERTEX_ATTRIB_ARRAY_SIZE, &st->size);
+	glGetVertexAttribiv(attr, GL_VERTEX_ATTRIB_ARRAY_TYPE, &st->type);
+	glGetVertexAttribiv(attr, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &st->normalized);
+	glGetVertexAttribiv(attr, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &st->stride);
+	glGetVertexAttribiv(attr, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &st->buffer);
+	glGetVertexAttribPointerv(attr, GL_VERTEX_ATTRIB_ARRAY_POINTER, &st->pointer);
+	st->integer= 0;
+#ifdef GL_VERTEX_ATTRIB_ARRAY_INTEGER
+	if (gl_major >= 3)
+		glGetVertexAttribiv(attr, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &st->integer);
+#endif
+}
+
+static void _sprite_attr_restore(GLuint attr, const struct sprite_attr_state *st) {
+	glBindBuffer(GL_ARRAY_BUFFER, st->buffer);
+#ifdef GL_VERTEX_ATTRIB_ARRAY_INTEGER
+	if (st->integer)
+		glVertexAttribIPointer(attr, st->size, st->type, st->stride, st->pointer);
+	else
+#endif
+		glVertexAttribPointer(attr, st->size, st->type, st->normalized, st->stride, st->pointer);
+	if (st->enabled) glEnableVertexAttribArray(attr);
+	else glDisableVertexAttribArray(attr);
+}
+
+/* ( enabled, size, type, normalized, stride, buffer, pointer ) of a generic attribute (for tests) */
+void _vertex_attrib_state(int attr) {
+	struct sprite_attr_state st;
+	Inline_Stack_Vars;
+	(void)items; // silence warning
+	_sprite_attr_save(attr, &st, 0);
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(newSViv(st.enabled)));
+	Inline_Stack_Push(sv_2mortal(newSViv(st.size)));
+	Inline_Stack_Push(sv_2mortal(newSViv(st.type)));
+	Inline_Stack_Push(sv_2mortal(newSViv(st.normalized)));
+	Inline_Stack_Push(sv_2mortal(newSViv(st.stride)));
+	Inline_Stack_Push(sv_2mortal(newSViv(st.buffer)));
+	Inline_Stack_Push(sv_2mortal(newSViv(PTR2IV(st.pointer))));
+	Inline_Stack_Done;
+}
+
+static int _sprite_cmp(const void *a, const void *b) {
+	int ia= *(const int*)a, ib= *(const int*)b;
+	/* compare texture, then original position, to make the sort stable */
+	return sprite_tex[ia] < sprite_tex[ib]? -1 : sprite_tex[ia] > sprite_tex[ib]? 1
+		: ia - ib;
+}
+
+void sprite_batch_flush() {
+	GLint prev_vbo= 0;
+	GLfloat modelview[16];
+	struct sprite_attr_state pos_state, tex_state;
+	const char *ver;
+	int i, start, gl_major= 0;
+	size_t stride= SPRITE_FLOATS_PER_VERTEX * sizeof(float);
+	if (!sprite_count) return;
+	/* Group sprites by texture, preserving submission order within each texture */
+	Renew(sprite_order, sprite_alloc, int);
+	Renew(sprite_sorted, sprite_alloc * SPRITE_FLOATS, float);
+	for (i= 0; i < sprite_count; i++)
+		sprite_order[i]= i;
+	qsort(sprite_order, sprite_count, sizeof(int), _sprite_cmp);
+	for (i= 0; i < sprite_count; i++)
+		memcpy(sprite_sorted + i * SPRITE_FLOATS, sprite_verts + sprite_order[i] * SPRITE_FLOATS,
+			SPRITE_FLOATS * sizeof(float));
+
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &prev_vbo);
+	if (sprite_pos_attr >= 0) {
+		/* integer attributes (and the query for them) are new in GL 3 */
+		ver= (const char*) glGetString(GL_VERSION);
+		if (ver) sscanf(ver, "%d", &gl_major);
+		_sprite_attr_save(sprite_pos_attr, &pos_state, gl_major);
+		if (sprite_tex_attr >= 0)
+			_sprite_attr_save(sprite_tex_attr, &tex_state, gl_major);
+	}
+	if (!sprite_vbo) glGenBuffers(1, &sprite_vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, sprite_vbo);
+	glBufferData(GL_ARRAY_BUFFER, sprite_count * SPRITE_FLOATS * sizeof(float), sprite_sorted, GL_STREAM_DRAW);
+	if (sprite_pos_attr >= 0) {
+		glVertexAttribPointer(sprite_pos_attr, 3, GL_FLOAT, GL_FALSE, stride, (void*) 0);
+		glEnableVertexAttribArray(sprite_pos_attr);
+		if (sprite_tex_attr >= 0) {
+			glVertexAttribPointer(sprite_tex_attr, 2, GL_FLOAT, GL_FALSE, stride, (void*) (SPRITE_TEX_OFS * sizeof(float)));
+			glEnableVertexAttribArray(sprite_tex_attr);
+		}
+	}
+	else {
+		/* The vertices are already in eye coordinates.  The matrix is saved in a local rather
+		 * than pushed, in case the caller's stack is full.  Drawing with a color array leaves
+		 * the current color undefined, so GL_CURRENT_BIT puts it back. */
+		glPushAttrib(GL_CURRENT_BIT | GL_TRANSFORM_BIT);
+		glMatrixMode(GL_MODELVIEW);
+		glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+		glLoadIdentity();
+		glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+		glVertexPointer(4, GL_FLOAT, stride, (void*) 0);
+		glTexCoordPointer(2, GL_FLOAT, stride, (void*) (SPRITE_TEX_OFS * sizeof(float)));
+		glColorPointer(4, GL_FLOAT, stride, (void*) (SPRITE_COLOR_OFS * sizeof(float)));
+	}
+	for (start= 0, i= 1; i <= sprite_count; i++) {
+		if (i == sprite_count || sprite_tex[sprite_order[i]] != sprite_tex[sprite_order[start]]) {
+			glBindTexture(GL_TEXTURE_2D, sprite_tex[sprite_order[start]]);
+			glDrawArrays(GL_TRIANGLES, start * 6, (i - start) * 6);
+			start= i;
+		}
+	}
+	if (sprite_pos_attr >= 0) {
+		/* in reverse, in case both are the same slot */
+		if (sprite_tex_attr >= 0)
+			_sprite_attr_restore(sprite_tex_attr, &tex_state);
+		_sprite_attr_restore(sprite_pos_attr, &pos_state);
+	}
+	else {
+		glPopClientAttrib();
+		glLoadMatrixf(modelview);
+		glPopAttrib();
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, prev_vbo);
+	sprite_count= 0;
+}
+
+int _sprite_batch_active() {
+	return sprite_batch_depth > 0;
+}
+
+/* The first vertex of each pending sprite, as (x, y, z, w, s, t, r, g, b, a) (for tests) */
+void _sprite_batch_pending() {
+	int i, j;
+	Inline_Stack_Vars;
+	(void)items; // silence warning
+	Inline_Stack_Reset;
+	for (i= 0; i < sprite_count; i++)
+		for (j= 0; j < SPRITE_FLOATS_PER_VERTEX; j++)
+			Inline_Stack_Push(sv_2mortal(newSVnv(sprite_verts[i * SPRITE_FLOATS + j])));
+	Inline_Stack_Done;
+}
+
+void _sprite_batch(SV *code, int pos_attr, int tex_attr) {
+	int prev_pos_attr= sprite_pos_attr, prev_tex_attr= sprite_tex_attr;
+	/* Nested batches accumulate into the outer batch, unless they change the attributes */
+	if (sprite_batch_depth && (pos_attr != sprite_pos_attr || tex_attr != sprite_tex_attr))
+		sprite_batch_flush();
+	sprite_pos_attr= pos_attr;
+	sprite_tex_attr= tex_attr;
+	sprite_batch_depth++;
+	call_sv(code, G_NOARGS|G_DISCARD|G_ARRAY|G_EVAL);
+	sprite_batch_depth--;
+	if (!sprite_batch_depth || pos_attr != prev_pos_attr || tex_attr != prev_tex_attr)
+		sprite_batch_flush();
+	sprite_pos_attr= prev_pos_attr;
+	sprite_tex_attr= prev_tex_attr;
+	if (SvTRUE(ERRSV)) croak(NULL);
+}
+
 void _texture_render(HV *self, ...) {
 	Inline_Stack_Vars;
 	SV *value, *w_sv= NULL, *h_sv= NULL, *def_w, *def_h;
@@ -594,6 +1112,12 @@ void _texture_render(HV *self, ...) {
 	//	x, y, w, h, s, t, s_rep, t_rep);
 	
 	/* TODO: If texture is NonPowerOfTwo, then multiply the s_rep and t_rep values. */
+	if (sprite_batch_depth) {
+		value= _fetch_if_defined(self, "tx_id", 5);
+		if (!value) croak("Texture has no tx_id");
+		_sprite_batch_append(SvUV(value), x, y, z, w, h, s, t, s_rep, t_rep);
+		Inline_Stack_Void;
+	}
 	glBegin(GL_QUADS);
 	glTexCoord2d(s, t);
 	glVertex3d(x, y, z);
@@ -630,3 +1154,25 @@ void get_matrix(int matrix_id) {
 		Inline_Stack_Push(sv_2mortal(newSVnv(model[i])));
 	Inline_Stack_Done;
 }
+
+void get_viewport_rect_packed(...) {
+	Inline_Stack_Vars;
+	SV *dest= Inline_Stack_Items > 0? Inline_Stack_Item(0) : NULL;
+	GLint rect[4];
+	memset(rect, 0, sizeof(rect));
+	glGetIntegerv(GL_VIEWPORT, rect);
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(_packed_result(dest, rect, sizeof(rect))));
+	Inline_Stack_Done;
+}
+
+void get_matrix_packed(int matrix_id, ...) {
+	Inline_Stack_Vars;
+	SV *dest= Inline_Stack_Items > 1? Inline_Stack_Item(1) : NULL;
+	GLfloat model[16];
+	memset(model, 0, sizeof(model));
+	glGetFloatv(matrix_id, model);
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(_packed_result(dest, model, sizeof(model))));
+	Inline_Stack_Done;
+}
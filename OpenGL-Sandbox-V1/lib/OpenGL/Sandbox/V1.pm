@@ -21,10 +21,12 @@ export qw/
 	vertex plot_xy plot_xyz plot_st_xy plot_st_xyz plot_norm_st_xyz plot_rect plot_rect3
 	cylinder sphere disk partial_disk
 	compile_list call_list 
-	setcolor color_parts color_mult set_light_ambient set_light_diffuse set_light_specular
+	sprite_batch sprite_batch_flush
+	setcolor color_parts color_mult color_parts_packed color_mult_packed compile_color
+	set_light_ambient set_light_diffuse set_light_specular
 	set_light_position setup_sunlight
 	draw_axes_xy draw_axes_xyz draw_boundbox
-	get_viewport_rect get_matrix
+	get_viewport_rect get_matrix get_viewport_rect_packed get_matrix_packed
 /;
 BEGIN {
 # VERSION
@@ -32,10 +34,12 @@ BEGIN {
 
 use OpenGL::Sandbox::V1::Inline
 	CPP => do { my $x= __FILE__; $x =~ s|\.pm|\.cpp|; Cwd::abs_path($x) },
+	INC => '-I'.do{ my $x= __FILE__; $x =~ s|/[^/]+$||; Cwd::abs_path($x) },
 	LIBS => '-lGL -lGLU',
 	CCFLAGSEX => '-Wall -g3 -Os';
 
 use OpenGL::Sandbox::V1::DisplayList;
+use OpenGL::Sandbox::V1::Color;
 # No ned to include Quadric.pm because it doesn't have any code in it, currently.
 # use OpenGL::Sandbox::V1::Quadric;
 
@@ -258,13 +262,28 @@ Use glScale to invert one more more axes.
 =head3 local_gl
 
   local_gl { ... };
+  local_gl { ... } qw( current enable lighting );
+  local_gl { ... } 'tracked';
 
-Like local_matrix, but also calls glPushAttrib/glPopAttrib.
-This is expensive, and should probably only be used for debugging.
+Like local_matrix, but also calls glPushAttrib/glPopAttrib.  With no arguments, this saves
+all attribute state (C<GL_ALL_ATTRIB_BITS>) which is expensive, and should probably only be
+used for debugging.
+
+Otherwise, only the named categories are saved.  The names are the C<GL_*_BIT> constants
+in lowercase without the "GL_" or "_BIT", such as C<current>, C<enable>, C<lighting>,
+C<texture>, C<color_buffer>, C<depth_buffer>, C<polygon>, or C<all>.  You may also pass
+numeric C<GL_*_BIT> values directly.
+
+The special category C<tracked> doesn't push any attributes.  Instead, the first time
+L</setcolor> or one of the C<set_light_*> functions changes a value within the block, the
+previous value is saved, and only those values are restored at the end of the block.  Changes
+made by calling OpenGL functions directly are not tracked.  Note that L</setcolor> can't
+save the color when called within a glBegin/glEnd pair not started by one of the
+L</GEOMETRY PLOTTING> functions.
 
 =cut
 
-sub local_gl(&) { goto &_local_gl }
+sub local_gl(&@) { goto &_local_gl }
 
 =head2 GEOMETRY PLOTTING
 
@@ -449,6 +468,56 @@ it every iteration after that.
 
 sub compile_list(&) { OpenGL::Sandbox::V1::DisplayList->new->compile(shift); }
 
+=head2 SPRITE BATCHING
+
+=head3 sprite_batch
+
+  sprite_batch {
+    $_->render(x => ..., y => ...) for @sprites;
+  };
+  
+  # or, for a shader with position in attribute 0 and texture coordinates in attribute 1
+  sprite_batch { ... } position_attr => 0, texcoord_attr => 1;
+
+Within this block, L<OpenGL::Sandbox::Texture/render> no longer draws anything or binds
+the texture.  Instead, the rectangle is appended to a vertex buffer along with its texture id,
+and when the block ends the buffer is sorted by texture and drawn with one C<glDrawArrays>
+per texture.  This makes C<render> nearly free per sprite.
+
+Because the sprites are grouped by texture, sprites of different textures are not drawn in
+the order they were rendered, though sprites of the same texture are.  Use depth testing
+(C<z>) or separate batches if the overlap between different textures matters.
+
+With no options, the buffer is drawn using the fixed-function vertex, texture-coordinate and
+color arrays.  Each sprite is transformed by the modelview matrix and takes the current color
+at the time C<render> is called, so changing the matrix or color between sprites works the
+same as it does outside a batch.  The modelview matrix and color are put back after drawing.
+
+If C<position_attr> is given, the positions (vec3) and texture coordinates (vec2,
+if C<texcoord_attr> is given) are supplied as generic vertex attributes for the current
+shader program instead.  On a core profile, you must have a vertex array object bound.
+The positions are the untransformed coordinates passed to C<render>, and no color is supplied,
+because the shader decides how to transform and color them.  Uniforms are read when the batch
+is drawn, so a matrix or color set through a uniform applies to the whole batch; flush with
+L</sprite_batch_flush> before changing one.
+The setup of those attribute slots (enabled, buffer, and pointer) is put back after drawing,
+so the bound vertex array is unchanged.
+
+Nested batches add to the outer batch, unless they specify different attributes.
+The texture binding after the block is the last texture drawn.
+
+=head3 sprite_batch_flush
+
+Draw everything accumulated so far in the current batch.  Use this if you need to draw
+something else on top of the sprites before the end of the batch.
+
+=cut
+
+sub sprite_batch(&@) {
+	my ($code, %opts)= @_;
+	_sprite_batch($code, $opts{position_attr} // -1, $opts{texcoord_attr} // -1);
+}
+
 BEGIN { *call_list= *_displaylist_call; }
 
 =head2 COLORS
@@ -461,9 +530,12 @@ BEGIN { *call_list= *_displaylist_call; }
   setcolor(\@rgba);
   setcolor('#RRGGBB');
   setcolor('#RRGGBBAA');
+  setcolor($color_obj);
 
 Various ways to specify a color for glSetColor4f.  If Alpha component is missing, it defaults to 1.0
 
+For colors used repeatedly, L</compile_color> avoids parsing the color on every call.
+
 =head3 color_parts
 
   my ($r, $g, $b, $a)= color_parts('#RRGGBBAA');
@@ -477,6 +549,28 @@ formats as setcolor.
 
 Multiply each component of color1 by that component of color2.
 
+=head3 color_parts_packed
+
+  my $rgba_floats= color_parts_packed('#RRGGBBAA');
+
+Like L</color_parts>, but returns the 4 components as a single string of packed floats.
+
+=head3 color_mult_packed
+
+  my $rgba_floats= color_mult_packed( \@color1, \@color2 );
+  color_mult_packed( \@color1, \@color2, \$buffer );
+
+Like L</color_mult>, but returns the 4 components as a single string of packed floats.
+If the third argument is given (a scalar, or reference to one), the result is written into it.
+
+=head3 compile_color
+
+  my $color= compile_color('#RRGGBBAA');
+
+Return a L<OpenGL::Sandbox::V1::Color>, which caches the parsed components.  Any of the
+color functions accept this object, and L</setcolor> passes its packed floats directly to
+OpenGL.
+
 =head3 setup_sunlight
 
 This function enables a generic overhead light source similar to sunlight.  Light0 is set to
@@ -485,6 +579,8 @@ ambient factor.  This is mostly useful for quick one-liner scripts to inspect sh
 
 =cut
 
+sub compile_color { OpenGL::Sandbox::V1::Color->new(@_) }
+
 sub setup_sunlight {
 	glEnable(GL_LIGHTING);
 	glEnable(GL_LIGHT0);
@@ -685,6 +781,20 @@ However, they can be valuable for debugging.  These are perl-ified versions of g
 
   my @matrix4x4= get_matrix(GL_MODELVIEW_MATRIX);
 
+=head3 get_viewport_rect_packed
+
+  my $packed= get_viewport_rect_packed;    # pack('l4', $x, $y, $w, $h)
+  get_viewport_rect_packed(\$buffer);
+
+=head3 get_matrix_packed
+
+  my $packed= get_matrix_packed(GL_MODELVIEW_MATRIX);   # 16 packed floats
+  get_matrix_packed(GL_MODELVIEW_MATRIX, $mat4);
+
+These return a single packed scalar instead of a list of values.  If a destination is given
+(a scalar, or a reference to one such as an L<OpenGL::Sandbox::Mat4>), the data is written
+into it, re-using its buffer.  Either way, the destination (or new scalar) is returned.
+
 =cut
 
 1;
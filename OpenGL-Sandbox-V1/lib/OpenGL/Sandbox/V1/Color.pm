@@ -0,0 +1,47 @@
+package OpenGL::Sandbox::V1::Color;
+use strict;
+use warnings;
+require OpenGL::Sandbox::V1;
+
+# ABSTRACT: Pre-parsed color, for fast repeated calls to setcolor
+# VERSION
+
+=head1 SYNOPSIS
+
+  my $red= OpenGL::Sandbox::V1::Color->new('#FF0000');
+  # or
+  my $red= compile_color('#FF0000');
+  
+  setcolor($red);
+
+=head1 DESCRIPTION
+
+The color functions of L<OpenGL::Sandbox::V1> accept colors in a variety of formats, which
+need to be parsed on every call.  This object holds the color already parsed into 4 packed
+floats, so L<OpenGL::Sandbox::V1/setcolor> can pass it directly to glColor4fv without
+parsing or allocating anything.  The object is a blessed scalar-ref, so it can also be passed
+anywhere that accepts a packed buffer, such as C<set_uniform> of a C<vec4>.
+
+=head1 METHODS
+
+=head2 new
+
+  my $color= OpenGL::Sandbox::V1::Color->new( $r, $g, $b, $a );
+
+Accepts any of the same arguments as L<OpenGL::Sandbox::V1/setcolor>.
+
+=head2 rgba
+
+  my ($r, $g, $b, $a)= $color->rgba;
+
+=cut
+
+sub new {
+	my $class= shift;
+	my $packed= OpenGL::Sandbox::V1::color_parts_packed(@_);
+	bless \$packed, ref $class || $class;
+}
+
+sub rgba { unpack 'f4', ${$_[0]} }
+
+1;
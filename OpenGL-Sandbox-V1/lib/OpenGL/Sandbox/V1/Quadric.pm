@@ -71,6 +71,36 @@ You can also use aliases of
 
   $q->texture($bool)    # GL_TRUE, GL_FALSE
 
+=head1 MESH CACHE
+
+GLU re-tessellates a shape and issues every vertex in immediate mode each time it is plotted,
+which gets expensive for scenes with hundreds of spheres.  To avoid this, each Quadric compiles
+the geometry of each shape into a display list the first time it is plotted, and later calls
+with the same shape, parameters, L</draw_style>, L</normals>, L</orientation> and L</texture>
+just call the list.  The least recently used list is deleted when the cache is full.
+
+If a display list is already being compiled (such as within L<OpenGL::Sandbox::V1/compile_list>)
+the cache is bypassed and the geometry is plotted into that list directly.
+
+=head2 cache_limit
+
+  $q->cache_limit($n);  # default is 64, 0 disables the cache
+
+Set the maximum number of cached meshes.  This clears the existing cache.
+Returns the object for chaining.
+
+=head2 cached_mesh_count
+
+  my $n= $q->cached_mesh_count;
+
+Number of meshes currently in the cache.
+
+=head2 clear_cache
+
+  $q->clear_cache;
+
+Delete all cached display lists.  Returns the object for chaining.
+
 =head1 GEOMETRY PLOTTING
 
 =head2 sphere
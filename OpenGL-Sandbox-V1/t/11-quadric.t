@@ -43,6 +43,24 @@ assert_noerror sub {
 	is( $q->$_, $q, $_ ) for qw/ inside outside /;
 	is( $q->texture($_), $q, "texture($_)" ) for 1, 0;
 }, 'quadric options';
+
+$q->clear_cache->draw_fill->smooth_normals->outside->texture(0);
+assert_noerror sub {
+	$q->sphere(1,8,8) for 1..3;
+	is( $q->cached_mesh_count, 1, 'repeated sphere uses one cached mesh' );
+	$q->sphere(2,8,8);
+	$q->draw_line->sphere(1,8,8);
+	is( $q->cached_mesh_count, 3, 'new parameters or state add cache entries' );
+	$q->cache_limit(2);
+	is( $q->cached_mesh_count, 0, 'cache_limit clears cache' );
+	$q->draw_fill->sphere($_,8,8) for 1..3;
+	is( $q->cached_mesh_count, 2, 'cache limited to 2' );
+	compile_list(sub { $q->disk(0,1,8,1) });
+	is( $q->cached_mesh_count, 2, 'cache bypassed while compiling a list' );
+	is( $q->clear_cache->cached_mesh_count, 0, 'clear_cache' );
+	$q->cache_limit(0)->sphere(1,8,8);
+	is( $q->cached_mesh_count, 0, 'cache disabled' );
+}, 'mesh cache';
 undef $q;
 
 done_testing;
@@ -9,7 +9,8 @@ use Try::Tiny;
 use Log::Any::Adapter 'TAP';
 BEGIN { $OpenGL::Sandbox::V1::VERSION= $ENV{ASSUME_V1_VERSION} } # for testing before release
 use OpenGL::Sandbox qw/ next_frame make_context get_gl_errors glFlush GL_TRIANGLES GL_MODELVIEW_MATRIX
- -V1 local_matrix load_identity rotate scale trans trans_scale get_matrix /;
+ -V1 local_matrix load_identity rotate scale trans trans_scale get_matrix get_matrix_packed
+ get_viewport_rect get_viewport_rect_packed /;
 
 my $c= try { make_context; }
 	or plan skip_all => "Can't test without context";
@@ -233,4 +234,16 @@ sub test_next_frame_loads_identity {
 	], 'next_frame calls glLoadIdentity');
 }
 
+subtest packed_gets => \&test_packed_gets;
+sub test_packed_gets {
+	load_identity;
+	trans_scale 1, 2, 3, 4;
+	is( get_matrix_packed(GL_MODELVIEW_MATRIX), pack('f16', get_matrix(GL_MODELVIEW_MATRIX)), 'get_matrix_packed' );
+	my $buf= '';
+	get_matrix_packed(GL_MODELVIEW_MATRIX, \$buf);
+	is( $buf, pack('f16', 4,0,0,0, 0,4,0,0, 0,0,4,0, 1,2,3,1), 'get_matrix_packed into buffer' );
+	is( get_viewport_rect_packed(), pack('l4', get_viewport_rect()), 'get_viewport_rect_packed' );
+	load_identity;
+}
+
 done_testing;
@@ -8,7 +8,10 @@ use Test::More;
 use Try::Tiny;
 use Log::Any::Adapter 'TAP';
 BEGIN { $OpenGL::Sandbox::V1::VERSION= $ENV{ASSUME_V1_VERSION} } # for testing before release
-use OpenGL::Sandbox qw/ make_context get_gl_errors /;
+use OpenGL::Sandbox qw/ make_context get_gl_errors -V1 sprite_batch sprite_batch_flush
+ local_matrix load_identity trans scale setcolor get_matrix GL_MODELVIEW_MATRIX GL_CURRENT_COLOR
+ glGetString glBindBuffer glVertexAttribPointer_c glEnableVertexAttribArray
+ glDisableVertexAttribArray GL_VERSION GL_ARRAY_BUFFER GL_FLOAT GL_FALSE /;
 use OpenGL::Sandbox::Texture;
 
 my $c= try { make_context; }
@@ -41,4 +44,72 @@ sub test_render {
 	}
 };
 
+subtest sprite_batch => \&test_sprite_batch;
+sub test_sprite_batch {
+	my $tx1= OpenGL::Sandbox::Texture->new(filename => catdir($FindBin::Bin, 'data', 'tex', '8x8.png'))->load;
+	my $tx2= OpenGL::Sandbox::Texture->new(filename => catdir($FindBin::Bin, 'data', 'tex', '14x7-rgba.png'))->load;
+	ok( !OpenGL::Sandbox::V1::_sprite_batch_active(), 'not batching' );
+	is( (try{
+		sprite_batch {
+			ok( OpenGL::Sandbox::V1::_sprite_batch_active(), 'batching' );
+			for (1..50) {
+				$tx1->render(x => $_, scale => .1);
+				$tx2->render(y => $_, center => 1);
+			}
+			sprite_batch { $tx2->render(x => 1) };
+			sprite_batch_flush();
+			$tx1->render(w => 1, h => 1);
+		};
+		''
+	} catch {$_}), '', 'render in batch' );
+	is_deeply( [get_gl_errors], [], 'no GL errors' );
+	ok( !OpenGL::Sandbox::V1::_sprite_batch_active(), 'batch ended' );
+	# Sprites keep the matrix and color they were rendered with
+	my $matrix= sub { [ map sprintf('%.4f', $_), get_matrix(GL_MODELVIEW_MATRIX) ] };
+	my $color= sub { [ map sprintf('%.4f', $_), OpenGL::Sandbox::V1::_tracked_state_value(0, GL_CURRENT_COLOR) ] };
+	load_identity;
+	setcolor(.25, .5, .75, 1);
+	my ($matrix_before, $color_before)= ($matrix->(), $color->());
+	sprite_batch {
+		local_matrix {
+			trans(1, 2);
+			setcolor(1, 0, 0, 1);
+			$tx1->render(x => 1);
+			scale(2);
+			setcolor(0, 1, 0, .5);
+			$tx2->render(x => 1);
+			is_deeply( [ map sprintf('%.4f', $_), OpenGL::Sandbox::V1::_sprite_batch_pending() ],
+				[ map sprintf('%.4f', $_), 2,2,0,1, 0,0, 1,0,0,1,  3,2,0,1, 0,0, 0,1,0,.5 ],
+				'sprites recorded in eye coordinates with their color' );
+		};
+	};
+	is_deeply( $matrix->(), $matrix_before, 'modelview restored after batch' );
+	is_deeply( $color->(), $color_before, 'color restored after batch' );
+	is_deeply( [get_gl_errors], [], 'no GL errors' );
+	like( (try{ sprite_batch { die "fail\n" }; '' } catch {$_}), qr/fail/, 'exception propagates' );
+	ok( !OpenGL::Sandbox::V1::_sprite_batch_active(), 'batch ended after exception' );
+};
+
+subtest sprite_batch_attributes => \&test_sprite_batch_attributes;
+sub test_sprite_batch_attributes {
+	my ($maj)= split /[. ]/, glGetString(GL_VERSION);
+	$maj >= 2 or plan skip_all => "Requires OpenGL 2";
+	require OpenGL::Sandbox::Buffer;
+	my $tx1= OpenGL::Sandbox::Texture->new(filename => catdir($FindBin::Bin, 'data', 'tex', '8x8.png'))->load;
+	# The caller's setup of the attribute slots the batch draws with
+	my $buf= OpenGL::Sandbox::Buffer->new(target => GL_ARRAY_BUFFER);
+	$buf->load(pack 'f*', (0) x 64);
+	glVertexAttribPointer_c(1, 4, GL_FLOAT, GL_FALSE, 16, 8);
+	glEnableVertexAttribArray(1);
+	glDisableVertexAttribArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	my @before= map [ OpenGL::Sandbox::V1::_vertex_attrib_state($_) ], 0, 1;
+	is_deeply( $before[1], [ 1, 4, GL_FLOAT, 0, 16, $buf->id, 8 ], 'read back attribute 1' );
+	sprite_batch { $tx1->render(x => 1) } position_attr => 0, texcoord_attr => 1;
+	is_deeply( [ map [ OpenGL::Sandbox::V1::_vertex_attrib_state($_) ], 0, 1 ], \@before,
+		'attribute slots restored' );
+	glDisableVertexAttribArray(1);
+	is_deeply( [get_gl_errors], [], 'no GL errors' );
+};
+
 done_testing;
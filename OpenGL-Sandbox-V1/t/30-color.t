@@ -8,11 +8,73 @@ use Test::More;
 use Try::Tiny;
 use Log::Any::Adapter 'TAP';
 BEGIN { $OpenGL::Sandbox::V1::VERSION= $ENV{ASSUME_V1_VERSION} } # for testing before release
-use OpenGL::Sandbox qw/ make_context get_gl_errors -V1 color_parts /;
+use OpenGL::Sandbox qw/ make_context get_gl_errors -V1 color_parts setcolor set_light_diffuse
+ local_gl quads GL_LIGHT0 GL_DIFFUSE GL_CURRENT_COLOR color_parts_packed color_mult_packed
+ compile_color /;
 
 is_deeply( [ color_parts([ .25, .5, .75, 1 ]) ], [ .25, .5, .75, 1 ], 'read array' );
 is_deeply( [ color_parts(.75, .5, .25, .5) ], [ .75, .5, .25, .5 ], 'read list' );
 is_deeply( [ color_parts('#00FF00') ], [ 0, 1, 0, 1 ], 'parse HTML' );
 is_deeply( [ color_parts('#00FF0011') ], [ 0, 1, 0, 0x11/255.0 ], 'parse HTML with alpha' );
 
+is( color_parts_packed(.25, .5, .75), pack('f4', .25, .5, .75, 1), 'color_parts_packed' );
+is( color_mult_packed([.5, .5, .5, 1], '#FFFFFF80'), pack('f4', .5, .5, .5, 0x80/255.0), 'color_mult_packed' );
+my $buf= '';
+color_mult_packed([1,1,1,1], [.5,.5,.5,.5], \$buf);
+is( $buf, pack('f4', (.5)x4), 'color_mult_packed into buffer' );
+
+my $color= compile_color('#FF000080');
+isa_ok( $color, 'OpenGL::Sandbox::V1::Color' );
+is_deeply( [ $color->rgba ], [ unpack 'f4', pack 'f4', 1, 0, 0, 0x80/255.0 ], 'color object rgba' );
+is_deeply( [ color_parts($color) ], [ $color->rgba ], 'color_parts accepts color object' );
+is_deeply( [ color_mult($color, [1,1,1,1]) ], [ $color->rgba ], 'color_mult accepts color object' );
+
+subtest local_gl => sub {
+	my $c= try { make_context; }
+		or plan skip_all => "Can't test without context";
+	# Round to the precision of GL's float storage
+	my $cur_color= sub { [ map sprintf('%.4f', $_), OpenGL::Sandbox::V1::_tracked_state_value(0, GL_CURRENT_COLOR) ] };
+	my $diffuse= sub { [ map sprintf('%.4f', $_), OpenGL::Sandbox::V1::_tracked_state_value(GL_LIGHT0, GL_DIFFUSE) ] };
+	get_gl_errors;
+	setcolor(.25, .5, .75, 1);
+	set_light_diffuse(GL_LIGHT0, .1, .2, .3, 1);
+	my ($color0, $diffuse0)= ($cur_color->(), $diffuse->());
+	is_deeply( $color0, [qw( 0.2500 0.5000 0.7500 1.0000 )], 'read back color' );
+	is_deeply( $diffuse0, [qw( 0.1000 0.2000 0.3000 1.0000 )], 'read back diffuse' );
+
+	local_gl { setcolor('#FF0000'); set_light_diffuse(GL_LIGHT0, 1, 1, 1, 1); };
+	is_deeply( $cur_color->(), $color0, 'all: color restored' );
+	is_deeply( $diffuse->(), $diffuse0, 'all: diffuse restored' );
+
+	local_gl { setcolor($color); quads { setcolor($color) } } 'tracked';
+	is_deeply( $cur_color->(), $color0, 'tracked: color restored' );
+
+	local_gl { setcolor('#FF0000'); set_light_diffuse(GL_LIGHT0, 1, 1, 1, 1); } qw( current lighting );
+	is_deeply( $cur_color->(), $color0, 'current lighting: color restored' );
+	is_deeply( $diffuse->(), $diffuse0, 'current lighting: diffuse restored' );
+
+	my ($after_inner, $after_failed);
+	local_gl {
+		setcolor('#00FF00');
+		set_light_diffuse(GL_LIGHT0, 1, 1, 1, 1);
+		local_gl { setcolor('#0000FF'); quads { setcolor(1,1,1) } } 'tracked';
+		$after_inner= $cur_color->();
+		try { local_gl { setcolor('#0000FF'); die "fail\n" } 'tracked'; };
+		$after_failed= $cur_color->();
+		quads { setcolor(0,0,0) };
+	} 'tracked';
+	is_deeply( $after_inner, [qw( 0.0000 1.0000 0.0000 1.0000 )], 'nested: inner scope restores outer color' );
+	is_deeply( $after_failed, [qw( 0.0000 1.0000 0.0000 1.0000 )], 'nested: inner scope restores on die' );
+	is_deeply( $cur_color->(), $color0, 'nested: color restored' );
+	is_deeply( $diffuse->(), $diffuse0, 'nested: diffuse restored' );
+	is_deeply( [get_gl_errors], [], 'no GL errors' );
+
+	like( (try { local_gl { 1 } 'bogus'; '' } catch {$_}), qr/Unknown state category/, 'invalid category' );
+	like( (try { local_gl { setcolor('#FF0000'); set_light_diffuse(GL_LIGHT0, 1, 1, 1, 1); die "fail\n" } 'tracked'; '' } catch {$_}),
+		qr/fail/, 'exception propagates' );
+	is_deeply( $cur_color->(), $color0, 'die: color restored' );
+	is_deeply( $diffuse->(), $diffuse0, 'die: diffuse restored' );
+	is_deeply( [get_gl_errors], [], 'no GL errors' );
+};
+
 done_testing;
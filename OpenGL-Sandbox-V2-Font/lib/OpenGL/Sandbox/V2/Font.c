@@ -0,0 +1,361 @@
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <math.h>
+#include <string.h>
+
+/* One record per glyph in the atlas, sorted by codepoint so that layout can bsearch it.
+ * All distances are in pixels at the rasterized face size, with the y axis pointing up.
+ * The quad includes the SDF spread border around the bitmap.
+ */
+struct sdf_glyph {
+	uint32_t codepoint, glyph_index;
+	float advance;
+	float x0, y1, w, h;     /* quad position relative to pen, y1 is the top edge */
+	float s0, t0, s1, t1;   /* texture coordinates; t0 is the top row of the glyph */
+};
+
+/* "infinite" squared distance; must stay finite to keep the EDT arithmetic free of NaN */
+#define SDF_INF 1e20
+
+static FT_Library ft_lib= NULL;
+
+static FT_Face _face_from_iv(IV face) {
+	if (!face) croak("Font face is not open");
+	return (FT_Face) face;
+}
+
+static const struct sdf_glyph * _glyph_table(SV *table, size_t *count) {
+	STRLEN len;
+	char *p;
+	if (SvROK(table)) table= SvRV(table);
+	p= SvPV(table, len);
+	if (len % sizeof(struct sdf_glyph))
+		croak("Glyph table length %ld is not a multiple of %ld", (long) len, (long) sizeof(struct sdf_glyph));
+	*count= len / sizeof(struct sdf_glyph);
+	return (const struct sdf_glyph *) p;
+}
+
+static const struct sdf_glyph * _find_glyph(const struct sdf_glyph *table, size_t count, uint32_t cp) {
+	size_t lo= 0, hi= count, mid;
+	while (lo < hi) {
+		mid= (lo + hi) >> 1;
+		if (table[mid].codepoint < cp) lo= mid+1;
+		else if (table[mid].codepoint > cp) hi= mid;
+		else return table + mid;
+	}
+	return NULL;
+}
+
+/* Return the next codepoint of a perl string, whether utf8 or latin-1 */
+static uint32_t _next_char(const U8 **pos, const U8 *lim, int is_utf8) {
+	STRLEN len;
+	UV cp;
+	if (!is_utf8 || **pos < 0x80)
+		return *(*pos)++;
+	cp= utf8n_to_uvchr(*pos, lim - *pos, &len, UTF8_ALLOW_ANY);
+	*pos += len? len : 1;
+	return (uint32_t) cp;
+}
+
+IV _ft_open_face(SV *data, int face_index) {
+	FT_Face face;
+	FT_Error err;
+	STRLEN len;
+	char *bytes;
+	if (!ft_lib && (err= FT_Init_FreeType(&ft_lib)))
+		croak("FT_Init_FreeType failed (%d)", err);
+	if (!SvROK(data))
+		croak("Font data must be a scalar-ref or MMap object");
+	/* The font object holds a reference to 'data' for the lifetime of the face */
+	bytes= SvPV(SvRV(data), len);
+	if ((err= FT_New_Memory_Face(ft_lib, (const FT_Byte*) bytes, len, face_index, &face)))
+		croak("Can't load font face (FreeType error %d)", err);
+	return (IV) face;
+}
+
+void _ft_close_face(IV face) {
+	if (face) FT_Done_Face((FT_Face) face);
+}
+
+void _ft_set_pixel_size(IV face, int px) {
+	FT_Error err;
+	if ((err= FT_Set_Pixel_Sizes(_face_from_iv(face), 0, px)))
+		croak("Can't set pixel size %d (FreeType error %d)", px, err);
+}
+
+/* Returns ( ascender, descender, line_height ) in pixels at the current size */
+void _ft_metrics(IV face_iv) {
+	FT_Face face= _face_from_iv(face_iv);
+	Inline_Stack_Vars;
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(newSVnv(face->size->metrics.ascender / 64.0)));
+	Inline_Stack_Push(sv_2mortal(newSVnv(face->size->metrics.descender / 64.0)));
+	Inline_Stack_Push(sv_2mortal(newSVnv(face->size->metrics.height / 64.0)));
+	Inline_Stack_Done;
+}
+
+/* Felzenszwalb & Huttenlocher 1D squared distance transform, in place on f[0..n*stride) */
+static void _edt_1d(double *f, int n, int stride, double *d, int *v, double *z) {
+	int q, k= 0;
+	double s;
+	v[0]= 0;
+	z[0]= -HUGE_VAL;
+	z[1]= HUGE_VAL;
+	for (q= 1; q < n; q++) {
+		do {
+			s= ((f[q*stride] + q*q) - (f[v[k]*stride] + v[k]*v[k])) / (2.0*q - 2.0*v[k]);
+		} while (s <= z[k] && --k >= 0);
+		k++;
+		v[k]= q;
+		z[k]= s;
+		z[k+1]= HUGE_VAL;
+	}
+	for (q= 0, k= 0; q < n; q++) {
+		while (z[k+1] < q) k++;
+		d[q]= (q - v[k]) * (q - v[k]) + f[v[k]*stride];
+	}
+	for (q= 0; q < n; q++) f[q*stride]= d[q];
+}
+
+static void _edt_2d(double *grid, int w, int h, double *d, int *v, double *z) {
+	int x, y;
+	for (x= 0; x < w; x++) _edt_1d(grid + x, h, w, d, v, z);
+	for (y= 0; y < h; y++) _edt_1d(grid + y*w, w, 1, d, v, z);
+}
+
+/* Convert a coverage bitmap to a signed distance field of the same size (plus border).
+ * The coverage of anti-aliased edge pixels gives sub-pixel edge positions.
+ * 0.5 (byte 128) is the glyph edge, and 'spread' pixels away maps to 0 or 1.
+ */
+static void _bitmap_to_sdf(const FT_Bitmap *bm, int spread, unsigned char *out,
+	double *outer, double *inner, double *d, int *v, double *z
+) {
+	int w= bm->width + spread*2, h= bm->rows + spread*2, x, y, i;
+	double a, dist;
+	for (i= 0; i < w*h; i++) { outer[i]= SDF_INF; inner[i]= 0; }
+	for (y= 0; y < (int) bm->rows; y++) {
+		for (x= 0; x < (int) bm->width; x++) {
+			a= bm->buffer[y * bm->pitch + x] / 255.0;
+			i= (y + spread) * w + x + spread;
+			if (a >= 1) { outer[i]= 0; inner[i]= SDF_INF; }
+			else if (a > 0) {
+				outer[i]= a < .5? (.5 - a) * (.5 - a) : 0;
+				inner[i]= a > .5? (a - .5) * (a - .5) : 0;
+			}
+		}
+	}
+	_edt_2d(outer, w, h, d, v, z);
+	_edt_2d(inner, w, h, d, v, z);
+	for (i= 0; i < w*h; i++) {
+		dist= sqrt(outer[i]) - sqrt(inner[i]);
+		a= 0.5 - dist / (2.0 * spread);
+		out[i]= a <= 0? 0 : a >= 1? 255 : (unsigned char)(a * 255 + .5);
+	}
+}
+
+static int _cmp_glyph_cp(const void *a, const void *b) {
+	uint32_t x= ((const struct sdf_glyph*)a)->codepoint, y= ((const struct sdf_glyph*)b)->codepoint;
+	return x < y? -1 : x > y? 1 : 0;
+}
+
+static int _cmp_height_desc(const void *a, const void *b) {
+	const struct sdf_glyph *x= *(const struct sdf_glyph**)a, *y= *(const struct sdf_glyph**)b;
+	return x->h < y->h? 1 : x->h > y->h? -1
+		: x->codepoint < y->codepoint? -1 : x->codepoint > y->codepoint? 1 : 0;
+}
+
+/* Rasterize each codepoint (packed native uint32) at the current pixel size, convert it to a
+ * signed distance field, and shelf-pack the result into a single-channel atlas 'atlas_w'
+ * pixels wide.  Returns ( $atlas_bytes, $atlas_height, $glyph_table ).
+ * Codepoints with no glyph in the face are omitted from the table.  The scratch buffers are
+ * on perl's save stack, so a croak part way through doesn't leak them.
+ */
+void _sdf_build_atlas(IV face_iv, SV *codepoints, int spread, int atlas_w) {
+	FT_Face face= _face_from_iv(face_iv);
+	STRLEN len;
+	const uint32_t *cps= (const uint32_t*) SvPV(codepoints, len);
+	size_t n_cp= len / sizeof(uint32_t), n= 0, i, j;
+	struct sdf_glyph *glyphs, **order;
+	unsigned char **sdf, *atlas;
+	double *outer, *inner, *d;
+	int *v, shelf_x, shelf_y, shelf_h, atlas_h, w, h, m, row;
+	double *z;
+	SV *atlas_sv, *table_sv;
+	Inline_Stack_Vars;
+
+	if (spread < 1) croak("spread must be at least 1");
+	ENTER;
+	Newxz(glyphs, n_cp? n_cp : 1, struct sdf_glyph);
+	SAVEFREEPV(glyphs);
+	Newxz(sdf, n_cp? n_cp : 1, unsigned char*);
+	SAVEFREEPV(sdf);
+	for (i= 0; i < n_cp; i++) {
+		FT_UInt gi= FT_Get_Char_Index(face, cps[i]);
+		FT_GlyphSlot slot;
+		/* skip unknown, and duplicates */
+		if (!gi && cps[i]) continue;
+		for (j= 0; j < n && glyphs[j].codepoint != cps[i]; j++);
+		if (j < n) continue;
+		if (FT_Load_Glyph(face, gi, FT_LOAD_RENDER))
+			continue;
+		slot= face->glyph;
+		glyphs[n].codepoint= cps[i];
+		glyphs[n].glyph_index= gi;
+		glyphs[n].advance= slot->advance.x / 64.0;
+		if (slot->bitmap.width && slot->bitmap.rows) {
+			w= slot->bitmap.width + spread*2;
+			h= slot->bitmap.rows + spread*2;
+			if (w > atlas_w)
+				croak("Glyph %u is wider than the atlas (%d > %d)", cps[i], w, atlas_w);
+			glyphs[n].x0= slot->bitmap_left - spread;
+			glyphs[n].y1= slot->bitmap_top + spread;
+			glyphs[n].w= w;
+			glyphs[n].h= h;
+			/* scratch for outer, inner, and d/z/v of the longest row or column */
+			m= w > h? w : h;
+			Newx(outer, w*h*2 + m*2 + 1, double);
+			inner= outer + w*h;
+			d= inner + w*h;
+			z= d + m;
+			Newx(v, m, int);
+			Newx(sdf[n], w*h, unsigned char);
+			SAVEFREEPV(sdf[n]);
+			_bitmap_to_sdf(&slot->bitmap, spread, sdf[n], outer, inner, d, v, z);
+			Safefree(v);
+			Safefree(outer);
+		}
+		n++;
+	}
+
+	/* Shelf-pack tallest-first, with one pixel of padding to prevent bleeding */
+	Newx(order, n? n : 1, struct sdf_glyph*);
+	SAVEFREEPV(order);
+	for (i= 0; i < n; i++) order[i]= glyphs + i;
+	qsort(order, n, sizeof(*order), _cmp_height_desc);
+	shelf_x= shelf_y= shelf_h= 0;
+	for (i= 0; i < n && order[i]->h > 0; i++) {
+		if (shelf_x + order[i]->w > atlas_w) {
+			shelf_y += shelf_h + 1;
+			shelf_x= shelf_h= 0;
+		}
+		if (!shelf_h) shelf_h= order[i]->h;
+		order[i]->s0= shelf_x;
+		order[i]->t0= shelf_y;
+		shelf_x += order[i]->w + 1;
+	}
+	atlas_h= (shelf_y + shelf_h + 3) & ~3;
+	if (!atlas_h) atlas_h= 4;
+
+	atlas_sv= newSV(atlas_w * atlas_h);
+	SvPOK_on(atlas_sv);
+	SvCUR_set(atlas_sv, atlas_w * atlas_h);
+	atlas= (unsigned char*) SvPVX(atlas_sv);
+	memset(atlas, 0, atlas_w * atlas_h);
+	for (i= 0; i < n; i++) {
+		if (!glyphs[i].h) continue;
+		w= glyphs[i].w;
+		h= glyphs[i].h;
+		for (row= 0; row < h; row++)
+			memcpy(atlas + ((int)glyphs[i].t0 + row) * atlas_w + (int)glyphs[i].s0, sdf[i] + row*w, w);
+		glyphs[i].s1= (glyphs[i].s0 + w) / atlas_w;
+		glyphs[i].t1= (glyphs[i].t0 + h) / atlas_h;
+		glyphs[i].s0 /= atlas_w;
+		glyphs[i].t0 /= atlas_h;
+	}
+	qsort(glyphs, n, sizeof(*glyphs), _cmp_glyph_cp);
+	table_sv= newSVpvn((const char*) glyphs, n * sizeof(*glyphs));
+	LEAVE;
+
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(atlas_sv));
+	Inline_Stack_Push(sv_2mortal(newSViv(atlas_h)));
+	Inline_Stack_Push(sv_2mortal(table_sv));
+	Inline_Stack_Done;
+}
+
+/* Return a string of the distinct characters of 'text' which are not in the glyph table */
+SV* _sdf_missing_glyphs(SV *table, SV *text) {
+	size_t count;
+	const struct sdf_glyph *glyphs= _glyph_table(table, &count);
+	STRLEN len;
+	const U8 *pos= (const U8*) SvPV(text, len), *lim= pos + len;
+	int is_utf8= SvUTF8(text);
+	uint32_t cp;
+	U8 buf[UTF8_MAXBYTES+1], *end;
+	SV *ret= newSVpvn("", 0);
+	SvUTF8_on(ret);
+	while (pos < lim) {
+		cp= _next_char(&pos, lim, is_utf8);
+		if (cp == '\n' || _find_glyph(glyphs, count, cp)) continue;
+		end= uvchr_to_utf8(buf, cp);
+		*end= 0;
+		if (!strstr(SvPVX(ret), (char*) buf))
+			sv_catpvn(ret, (char*) buf, end - buf);
+	}
+	return ret;
+}
+
+/* Append two triangles (6 vertices of x,y,s,t floats) per visible glyph of 'text' to the
+ * buffer referenced by 'out', starting the baseline at (x,y) and scaling pixel distances by
+ * sx,sy.  Newlines move down by 'line_height' (in pixels).  If 'monospace' is positive, each
+ * glyph is centered in a cell of that many pixels, and kerning is ignored.  If 'out' is undef,
+ * this only measures.  Returns the widest line's advance, scaled by sx.
+ */
+double _sdf_layout(SV *table, IV face_iv, SV *text, double x, double y, double sx, double sy,
+	double line_height, double monospace, SV *out
+) {
+	size_t count;
+	const struct sdf_glyph *glyphs= _glyph_table(table, &count), *g, *prev= NULL;
+	FT_Face face= (FT_Face) face_iv;
+	int kerning= face && FT_HAS_KERNING(face) && !(monospace > 0);
+	STRLEN len;
+	const U8 *pos= (const U8*) SvPV(text, len), *lim= pos + len;
+	int is_utf8= SvUTF8(text);
+	double pen= 0, widest= 0, cell_ofs, x0, x1, y0, y1;
+	float *vtx;
+	SV *buf= NULL;
+	FT_Vector kern;
+
+	if (out && SvOK(out)) {
+		if (!SvROK(out)) croak("Output buffer must be a scalar-ref");
+		buf= SvRV(out);
+		if (!SvOK(buf)) sv_setpvn(buf, "", 0);
+		SvPV_force_nolen(buf);
+		/* upper bound: one quad per byte */
+		SvGROW(buf, SvCUR(buf) + len * 24 * sizeof(float) + 1);
+	}
+	while (pos < lim) {
+		uint32_t cp= _next_char(&pos, lim, is_utf8);
+		if (cp == '\n') {
+			if (pen > widest) widest= pen;
+			pen= 0;
+			y -= line_height * sy;
+			prev= NULL;
+			continue;
+		}
+		if (!(g= _find_glyph(glyphs, count, cp)))
+			continue;
+		if (kerning && prev && !FT_Get_Kerning(face, prev->glyph_index, g->glyph_index, FT_KERNING_DEFAULT, &kern))
+			pen += kern.x / 64.0;
+		cell_ofs= monospace > 0? (monospace - g->advance) * .5 : 0;
+		if (buf && g->h > 0) {
+			x0= x + (pen + cell_ofs + g->x0) * sx;
+			x1= x0 + g->w * sx;
+			y1= y + g->y1 * sy;
+			y0= y1 - g->h * sy;
+			vtx= (float*)(SvPVX(buf) + SvCUR(buf));
+			vtx[ 0]= x0; vtx[ 1]= y0; vtx[ 2]= g->s0; vtx[ 3]= g->t1;
+			vtx[ 4]= x1; vtx[ 5]= y0; vtx[ 6]= g->s1; vtx[ 7]= g->t1;
+			vtx[ 8]= x1; vtx[ 9]= y1; vtx[10]= g->s1; vtx[11]= g->t0;
+			vtx[12]= x0; vtx[13]= y0; vtx[14]= g->s0; vtx[15]= g->t1;
+			vtx[16]= x1; vtx[17]= y1; vtx[18]= g->s1; vtx[19]= g->t0;
+			vtx[20]= x0; vtx[21]= y1; vtx[22]= g->s0; vtx[23]= g->t0;
+			SvCUR_set(buf, SvCUR(buf) + 24 * sizeof(float));
+		}
+		pen += monospace > 0? monospace : g->advance;
+		prev= g;
+	}
+	if (buf) *SvEND(buf)= '\0';
+	if (pen > widest) widest= pen;
+	return widest * sx;
+}
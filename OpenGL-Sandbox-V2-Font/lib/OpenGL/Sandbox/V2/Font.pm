@@ -0,0 +1,507 @@
+package OpenGL::Sandbox::V2::Font;
+use Moo;
+use Carp;
+use Cwd;
+use Try::Tiny;
+use File::Path 'make_path';
+use Digest::SHA 'sha1_hex';
+use Log::Any '$log';
+use OpenGL::Sandbox 0.100 qw( glDrawArrays glActiveTexture GL_TRIANGLES GL_TEXTURE0 GL_FLOAT
+	GL_RED GL_UNSIGNED_BYTE GL_LINEAR GL_CLAMP_TO_EDGE GL_ARRAY_BUFFER GL_STREAM_DRAW
+	GL_VERTEX_SHADER GL_FRAGMENT_SHADER );
+use OpenGL::Sandbox::MMap;
+use OpenGL::Sandbox::Texture;
+use OpenGL::Sandbox::Shader;
+use OpenGL::Sandbox::Program;
+use OpenGL::Sandbox::Buffer;
+use OpenGL::Sandbox::VertexArray;
+
+# ABSTRACT: Signed-distance-field glyph atlas fonts for OpenGL 3+ core profile
+BEGIN {
+# VERSION
+}
+
+=head1 SYNOPSIS
+
+  my $font= OpenGL::Sandbox::V2::Font->new(data => OpenGL::Sandbox::MMap->new('myfont.ttf'));
+  my $proj= OpenGL::Sandbox::Mat4->ortho(0, $width, 0, $height, -1, 1);
+
+  # queue up any number of strings...
+  $font->add_text("Score: $score", x => 10, y => $height - 10, yalign => 1);
+  $font->add_text("Paused", x => $width/2, y => $height/2, xalign => .5, height => 64);
+  # ...then draw them all with one glDrawArrays
+  $font->draw(mvp => $proj, color => [1,1,0,1]);
+
+=head1 DESCRIPTION
+
+This font renderer works with the shader pipeline of OpenGL 3+ (including core-profile
+contexts) rather than the fixed-function API used by L<OpenGL::Sandbox::V1::FTGLFont>.
+
+The font data is read with FreeType directly from the memory-mapped font file.  Each glyph is
+rasterized once at L</face_size> and converted to a
+L<signed distance field|https://steamcdn-a.akamaihd.net/apps/valve/2007/SIGGRAPH2007_AlphaTestedMagnification.pdf>,
+and all glyphs are packed into a single one-channel texture (the "atlas").  A distance field
+can be magnified or minified smoothly by the fragment shader, so one atlas serves every size
+of text.
+
+Text is laid out in C into a packed array of C<(x, y, s, t)> vertices, two triangles per
+glyph.  Calls to L</add_text> append to this array, and L</draw> uploads it to a single
+vertex buffer and renders all of it with one draw call.
+
+Glyphs that are not in the atlas are added on demand, which rebuilds the atlas texture.
+If you know the character set in advance, pass it as L</glyphs> to avoid that.
+
+Rasterizing and converting the glyphs takes a noticeable amount of time, so the finished
+atlas can be saved to a L</cache_dir> and memory-mapped on later runs, skipping FreeType and
+the distance transform entirely.
+
+This module is based on L<Inline::C>, so it requires a C compiler and the FreeType headers
+in order to be installed.
+
+=head1 ATTRIBUTES
+
+=head2 data
+
+A scalar-ref to the bytes of a TrueType or OpenType font, preferably via a
+L<OpenGL::Sandbox::MMap> object, or a L<slice|OpenGL::Sandbox::MMap/slice> of one for a font
+stored inside a larger file.  It must remain unchanged for the life of this object.
+
+=head2 filename
+
+The name this data was loaded from, for informational purposes only.
+
+=head2 face_size
+
+The pixel size at which glyphs are rasterized into the atlas, and also the unit of all
+coordinates and metrics of this font (the same as FTGL's texture fonts).  The default is 32,
+which gives good quality over a wide range of scales.  Read-only, since changing it would
+require a new atlas.
+
+=head2 spread
+
+The maximum distance in pixels (at L</face_size>) represented by the distance field.
+Larger values leave room for effects like outlines, at the cost of atlas space.
+Default is 4.
+
+=head2 glyphs
+
+A string of the characters to place in the initial atlas.  Defaults to printable ASCII.
+
+=head2 atlas_width
+
+Width of the atlas texture, in pixels.  The height is determined by the glyphs.
+Default is 512.
+
+=head2 cache_dir
+
+A directory in which to save finished atlases, and from which to load them.  Each file is
+named by a hash of the font data, L</face_size>, L</spread>, L</atlas_width> and the set of
+glyphs, so any change to those results in a new file rather than a stale atlas.  The files
+are in native byte order and not meant to be shared between machines.  The directory is
+created if needed, and any problem writing to it is logged as a warning rather than being
+fatal.  Stale files are never removed; delete the directory whenever you like.
+
+Defaults to C<$ENV{OPENGL_SANDBOX_FONT_CACHE}>.  If undefined, no cache is used.
+With L<OpenGL::Sandbox::ResMan>, you can enable it for every font with a C<font_config>
+entry like C<< '*' => { cache_dir => $dir } >>.
+
+=head2 atlas
+
+The L<OpenGL::Sandbox::Texture> holding the distance field.  Built on demand.
+
+=head2 program
+
+The L<OpenGL::Sandbox::Program> used to render the text.  The default is a small GLSL 3.30
+program, built the first time it is needed.  You may supply your own; it must accept a C<vec4>
+vertex attribute named C<a_vertex> (position in C<xy>, texture coordinate in C<zw>) and should
+declare uniforms C<u_mvp> (mat4), C<u_color> (vec4) and C<u_atlas> (sampler2D).
+
+=head2 ascender
+
+The distance from baseline to top of typical glyph, in same units as face_size.
+
+=head2 descender
+
+The distance below the baseline that "hanging" portions of glyphs might reach, in same units
+as face_size.
+
+=head2 line_height
+
+Line spacing for the font, in same units as face_size.
+
+=cut
+
+has filename    => ( is => 'ro' );
+has data        => ( is => 'ro', required => 1 );
+has face_size   => ( is => 'ro', default => sub { 32 } );
+has spread      => ( is => 'ro', default => sub { 4 } );
+has glyphs      => ( is => 'ro', default => sub { join '', map chr, 32..126 } );
+has atlas_width => ( is => 'ro', default => sub { 512 } );
+has cache_dir   => ( is => 'ro', default => sub { $ENV{OPENGL_SANDBOX_FONT_CACHE} } );
+has program     => ( is => 'lazy' );
+has ascender    => ( is => 'lazy' );
+has descender   => ( is => 'lazy' );
+has line_height => ( is => 'lazy' );
+
+has _face         => ( is => 'lazy', predicate => 1 );
+has _metrics      => ( is => 'lazy' );
+has _glyph_set    => ( is => 'rw', lazy => 1, default => sub { $_[0]->glyphs } );
+has _glyph_table  => ( is => 'lazy', clearer => 1 );
+has atlas         => ( is => 'lazy', init_arg => undef );
+has _buffer       => ( is => 'lazy' );
+has _vertex_array => ( is => 'lazy' );
+has _pending      => ( is => 'rw', default => sub { [] } );
+has _vertices     => ( is => 'rw', default => sub { '' } );
+has _absent       => ( is => 'rw', default => sub { +{} } );
+has _data_digest  => ( is => 'lazy' );
+
+sub _build__face {
+	my $self= shift;
+	my $face= _ft_open_face($self->data, 0);
+	_ft_set_pixel_size($face, $self->face_size);
+	$face;
+}
+
+sub DEMOLISH {
+	my $self= shift;
+	_ft_close_face(delete $self->{_face}) if $self->_has_face;
+}
+
+sub _build__metrics { [ _ft_metrics($_[0]->_face) ] }
+sub _build_ascender    { $_[0]->_metrics->[0] }
+sub _build_descender   { $_[0]->_metrics->[1] }
+sub _build_line_height { $_[0]->_metrics->[2] }
+
+sub _build__glyph_table {
+	my $self= shift;
+	my ($pixels, $height, $table)= $self->_read_atlas_cache;
+	if (!defined $table) {
+		(my $buf, $height, $table)= _sdf_build_atlas($self->_face,
+			pack('L*', map ord, split //, $self->_glyph_set), $self->spread, $self->atlas_width);
+		$pixels= \$buf;
+		$self->_write_atlas_cache($pixels, $height, $table);
+	}
+	$self->{_atlas_pixels}= $pixels;
+	$self->{_atlas_height}= $height;
+	# Remember the ones the font doesn't have, so they don't trigger a rebuild every time
+	$self->_absent->{$_}= 1 for split //, _sdf_missing_glyphs($table, $self->_glyph_set);
+	# if the texture was already built, it needs the new pixels
+	$self->_load_atlas($self->{atlas}) if $self->{atlas};
+	$table;
+}
+
+# The cache file holds the atlas pixels first, so that the mapped file can be handed straight to
+# glTexImage2D, followed by the glyph table and a trailer of (magic, height, table length).
+our $cache_magic= 'SDFATL01';
+my $cache_trailer_len= length pack 'a8 L L', '', 0, 0;
+
+sub _build__data_digest { sha1_hex(${ $_[0]->data }) }
+
+sub _atlas_cache_path {
+	my $self= shift;
+	my $dir= $self->cache_dir;
+	return undef unless defined $dir && length $dir;
+	my $glyphs= $self->_glyph_set;
+	utf8::encode($glyphs);
+	my $key= sha1_hex(join "\0", $cache_magic, $self->_data_digest, $self->face_size,
+		$self->spread, $self->atlas_width, $glyphs);
+	return "$dir/$key.sdf";
+}
+
+sub _read_atlas_cache {
+	my $self= shift;
+	my $path= $self->_atlas_cache_path;
+	return unless defined $path && -s $path;
+	my $mmap= try { OpenGL::Sandbox::MMap->new($path) }
+		catch { $log->warn("Can't map font cache $path: $_"); undef; }
+		or return;
+	my $size= length $$mmap;
+	my ($magic, $height, $table_len)= $size < $cache_trailer_len? ('')
+		: unpack 'a8 L L', substr($$mmap, -$cache_trailer_len);
+	my $pixels_len= $self->atlas_width * ($height // 0);
+	unless ($magic eq $cache_magic && $size == $pixels_len + $table_len + $cache_trailer_len) {
+		$log->warn("Ignoring corrupt font cache $path");
+		return;
+	}
+	$log->debug("loaded font atlas from $path");
+	return ($mmap, $height, substr($$mmap, $pixels_len, $table_len));
+}
+
+sub _write_atlas_cache {
+	my ($self, $pixels, $height, $table)= @_;
+	my $path= $self->_atlas_cache_path;
+	return unless defined $path;
+	my $tmp= "$path.$$.tmp";
+	try {
+		make_path($self->cache_dir);
+		open my $fh, '>:raw', $tmp or die "open: $!\n";
+		$fh->print($$pixels, $table, pack('a8 L L', $cache_magic, $height, length $table))
+			&& $fh->close
+			or die "write: $!\n";
+		rename($tmp, $path) or die "rename: $!\n";
+	}
+	catch {
+		chomp(my $err= $_);
+		$log->warn("Can't write font cache $path: $err");
+		unlink $tmp;
+	};
+}
+
+sub _build_atlas {
+	my $self= shift;
+	$self->_glyph_table; # generates the pixels
+	$self->_load_atlas(OpenGL::Sandbox::Texture->new(
+		name       => 'SDF font atlas'.(defined $self->filename? ' '.$self->filename : ''),
+		min_filter => GL_LINEAR,
+		mag_filter => GL_LINEAR,
+		wrap_s     => GL_CLAMP_TO_EDGE,
+		wrap_t     => GL_CLAMP_TO_EDGE,
+	));
+}
+
+sub _load_atlas {
+	my ($self, $tex)= @_;
+	$tex->load({
+		format => GL_RED, type => GL_UNSIGNED_BYTE, internal_format => GL_RED,
+		width  => $self->atlas_width, height => $self->{_atlas_height},
+		pitch  => $self->atlas_width, data => delete $self->{_atlas_pixels},
+	});
+}
+
+our $vertex_shader= <<'END';
+#version 330 core
+layout(location = 0) in vec4 a_vertex; // xy = position, zw = atlas coordinate
+uniform mat4 u_mvp;
+out vec2 v_texcoord;
+void main() {
+	gl_Position= u_mvp * vec4(a_vertex.xy, 0.0, 1.0);
+	v_texcoord= a_vertex.zw;
+}
+END
+
+our $fragment_shader= <<'END';
+#version 330 core
+in vec2 v_texcoord;
+uniform sampler2D u_atlas;
+uniform vec4 u_color;
+out vec4 frag_color;
+void main() {
+	float dist= texture(u_atlas, v_texcoord).r;
+	// The width of the edge ramp follows the screen-space rate of change of the
+	// distance, so edges stay about one pixel wide at any scale.
+	float w= fwidth(dist) * 0.7;
+	frag_color= vec4(u_color.rgb, u_color.a * smoothstep(0.5 - w, 0.5 + w, dist));
+}
+END
+
+sub _build_program {
+	OpenGL::Sandbox::Program->new(
+		name => 'SDF font',
+		shaders => {
+			vert => OpenGL::Sandbox::Shader->new(type => GL_VERTEX_SHADER,   source => $vertex_shader),
+			frag => OpenGL::Sandbox::Shader->new(type => GL_FRAGMENT_SHADER, source => $fragment_shader),
+		},
+	);
+}
+
+sub _build__buffer {
+	OpenGL::Sandbox::Buffer->new(target => GL_ARRAY_BUFFER, usage => GL_STREAM_DRAW);
+}
+
+sub _build__vertex_array {
+	OpenGL::Sandbox::VertexArray->new(
+		attributes => { a_vertex => { size => 4, type => GL_FLOAT } },
+	);
+}
+
+=head1 METHODS
+
+=head2 advance
+
+  my $length= $font->advance("String of glyphs");
+
+Calculate the width of a string of text, in same units as face_size.  For multi-line text,
+this is the width of the longest line.
+
+=cut
+
+sub advance {
+	my ($self, $text, $monospace)= @_;
+	$self->_require_glyphs($text);
+	_sdf_layout($self->_glyph_table, $self->_face, $text, 0, 0, 1, 1, $self->line_height, $monospace // 0, undef);
+}
+
+# Make sure every character of $text is in the atlas, rebuilding it if needed.
+sub _require_glyphs {
+	my ($self, $text)= @_;
+	my $missing= _sdf_missing_glyphs($self->_glyph_table, $text);
+	return unless length $missing;
+	my $absent= $self->_absent;
+	my @add= grep !$absent->{$_}, split //, $missing;
+	return unless @add;
+	$self->_glyph_set($self->_glyph_set . join '', @add);
+	$self->_clear_glyph_table;
+	my $table= $self->_glyph_table;
+	# Texture coordinates of queued text are stale after a rebuild
+	if (@{ $self->_pending }) {
+		my $vertices= '';
+		_sdf_layout($table, $self->_face, @$_, \$vertices) for @{ $self->_pending };
+		$self->_vertices($vertices);
+	}
+}
+
+=head2 add_text
+
+  $font->add_text($text, %opts);
+
+Lay out some text and append it to the list of geometry that will be rendered by the next call
+to L</draw>.  By default, the baseline starts at the origin of the coordinate space.
+Returns the font, for chaining.  The following options are supported:
+
+=over
+
+=item C<x>, C<y>
+
+Use this reference coordinate instead of the origin.
+
+=item C<xalign>
+
+A number between C<0> (left align) and C<1> (right align).  i.e. to center the text use C<0.5>.
+
+=item C<yalign>
+
+C<0> puts the baseline at the y coordinate.  C<1> puts the ascender-line at the y coordinate.
+C<-1> puts the descender-line at the y coordinate.  Numbers inbetween yield some fraction
+of those distances.
+
+=item C<monospace>
+
+Ignore the spacing of the font face and always use this value to advance between glyphs.
+This number is in the same units as face_size.  This value is affected by C<scale> (below).
+
+=item C<scale>
+
+Scale the x and y axis by this number.  This overrides a setting of C<height>.
+
+=item C<h>, C<height>
+
+Scale the y axis so that the L</ascender> equals this value.  Also scale the x axis to match
+unless C<width> was specified, in which case this can change the aspect ratio of the text.
+
+=item C<w>, C<width>
+
+Scale x axis so that the length of the text is C<width>.  Also scale the y axis to match unless
+C<height> was specified, in which case this can change the aspect ratio of the text.
+
+=back
+
+These are the same as the options of L<OpenGL::Sandbox::V1::FTGLFont/render>.
+Text containing newlines is rendered as multiple lines L</line_height> apart.
+
+=cut
+
+sub add_text {
+	my $self= shift;
+	my $text= shift;
+	my %opts= @_ == 1 && ref $_[0] eq 'HASH'? %{ $_[0] } : @_;
+	$self->_require_glyphs($text);
+	my $monospace= $opts{monospace} // 0;
+	my ($sx, $sy)= ($opts{scale}, $opts{scale});
+	if (!defined $sx) {
+		my $height= $opts{h} // $opts{height};
+		my $width= $opts{w} // $opts{width};
+		$sy= $height / $self->ascender if $height;
+		$sx= $width / ($self->advance($text, $monospace) || 1) if $width;
+		$sx //= $sy // 1;
+		$sy //= $sx;
+	}
+	my ($x, $y)= ($opts{x} // 0, $opts{y} // 0);
+	$x -= $self->advance($text, $monospace) * $sx * $opts{xalign} if $opts{xalign};
+	$y -= ($opts{yalign} > 0? $self->ascender : -$self->descender) * $opts{yalign} * $sy
+		if $opts{yalign};
+	my @args= ($text, $x, $y, $sx, $sy, $self->line_height, $monospace);
+	push @{ $self->_pending }, \@args;
+	_sdf_layout($self->_glyph_table, $self->_face, @args, \$self->{_vertices});
+	$self;
+}
+
+=head2 draw
+
+  $font->draw(%opts);
+
+Render all text queued by L</add_text> with a single draw call, then clear the queue.
+Options:
+
+=over
+
+=item C<mvp>
+
+The model-view-projection matrix, as anything accepted by
+L<OpenGL::Sandbox::Program/set_uniform> for a C<mat4>, such as an
+L<OpenGL::Sandbox::Mat4>.  Defaults to the identity matrix, in which case the text coordinates
+are normalized device coordinates.
+
+=item C<color>
+
+Arrayref of C<[ $r, $g, $b, $a ]>.  Defaults to opaque white.
+
+=back
+
+This binds L</program>, the vertex array and buffer of the font, and the L</atlas> texture on
+texture unit 0, and leaves them bound.  The text is drawn with alpha, so you will normally
+want C<GL_BLEND> enabled with C<glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA)>.
+
+Returns the font, for chaining.
+
+=head2 render
+
+  $font->render($text, %opts);
+
+Shortcut for C<< $font->add_text($text, %opts)->draw(%opts) >>.
+
+=head2 clear
+
+Discard any text queued by L</add_text>.
+
+=cut
+
+my $identity= [ 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1 ];
+my $white= [ 1,1,1,1 ];
+
+sub draw {
+	my ($self, %opts)= @_;
+	my $n= length($self->_vertices) / 16;
+	return $self unless $n;
+	my $program= $self->program->bind;
+	$program->set_uniform(u_mvp => $opts{mvp} // $identity);
+	$program->set_uniform(u_color => $opts{color} // $white);
+	$program->set_uniform(u_atlas => 0);
+	glActiveTexture(GL_TEXTURE0);
+	$self->atlas->bind;
+	$self->_buffer->load(\$self->{_vertices});
+	$self->_vertex_array->bind($program, $self->_buffer);
+	glDrawArrays(GL_TRIANGLES, 0, $n);
+	$self->clear;
+}
+
+sub render {
+	my $self= shift;
+	my $text= shift;
+	my %opts= @_ == 1 && ref $_[0] eq 'HASH'? %{ $_[0] } : @_;
+	$self->add_text($text, %opts)->draw(%opts);
+}
+
+sub clear {
+	my $self= shift;
+	$self->_vertices('');
+	@{ $self->_pending }= ();
+	$self;
+}
+
+use OpenGL::Sandbox::V2::Font::Inline
+	C => do { my $x= __FILE__; $x =~ s/\.pm$/\.c/; $x },
+	INC => '-I/usr/include/freetype2 -I'
+	       .do{ my $x= __FILE__; $x =~ s|/[^/]+$||; Cwd::abs_path($x) },
+	LIBS => '-lfreetype';
+
+1;
@@ -0,0 +1,15 @@
+# DO NOT EDIT. GENERATED BY: Inline::Module
+#
+# This module is for author-side development only. When this module is shipped
+# to CPAN, it will be automagically replaced with content that does not
+# require any Inline framework modules (or any other non-core modules).
+#
+# To regenerate this stub module, run this command:
+#
+#   perl -MInline::Module=makestub,OpenGL::Sandbox::V2::Font::Inline
+
+use strict; use warnings;
+package OpenGL::Sandbox::V2::Font::Inline;
+
+use Inline::Module stub => 'v2';
+1;
@@ -0,0 +1,103 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use FindBin;
+use Try::Tiny;
+use File::Temp 'tempdir';
+use Test::More;
+use Log::Any::Adapter 'TAP';
+
+use_ok( 'OpenGL::Sandbox::V2::Font' ) or BAIL_OUT;
+
+my $mmap= OpenGL::Sandbox::MMap->new("$FindBin::Bin/data/font/SquadaOne-Regular.ttf");
+
+subtest metrics => sub {
+	my $font= new_ok( 'OpenGL::Sandbox::V2::Font', [ data => $mmap ], '$font' );
+	is( $font->face_size,            32, 'default face_size' );
+	is( $font->ascender,             28, 'ascender' );
+	is( $font->descender,            -7, 'descender' );
+	is( int($font->line_height),     34, 'line_height' );
+	is( int($font->advance("Test")), 49, 'advance("Test")' );
+	is( int($font->advance("Te\nTest")), 49, 'advance of longest line' );
+	is( $font->advance("ab", 20),    40, 'monospace advance' );
+
+	$font= new_ok( 'OpenGL::Sandbox::V2::Font', [ data => $mmap, face_size => 40 ], '$font' );
+	is( $font->ascender,             35, 'ascender' );
+	is( $font->descender,            -8, 'descender' );
+	is( int($font->line_height),     42, 'line_height' );
+	is( int($font->advance("Test")), 61, 'advance("Test")' );
+};
+
+subtest layout => sub {
+	my $font= OpenGL::Sandbox::V2::Font->new(data => $mmap);
+	$font->add_text("Hi there");
+	is( length($font->_vertices), 7*6*16, 'six vertices per visible glyph' );
+	$font->add_text("Test", width => 200, xalign => .5);
+	my @v= unpack 'f*', substr($font->_vertices, 7*6*16);
+	my @x= map $v[$_*4], 0..$#v/4;
+	my ($min, $max)= (sort { $a <=> $b } @x)[0,-1];
+	# quads extend past the advance by the 'spread' border and glyph bearings
+	ok( $min > -125 && $min < -100, 'centered left edge' ) or diag $min;
+	ok( $max > 100 && $max < 125, 'centered right edge' ) or diag $max;
+	$font->clear;
+	is( length($font->_vertices), 0, 'clear' );
+};
+
+subtest missing_glyphs => sub {
+	my $font= OpenGL::Sandbox::V2::Font->new(data => $mmap, glyphs => 'abc');
+	$font->add_text('ab');
+	is( length($font->_vertices), 2*6*16, 'initial glyphs' );
+	$font->add_text("xyz\x{2603}");
+	is( length($font->_vertices), 5*6*16, 'atlas extended, unsupported glyph skipped' );
+	like( $font->_glyph_set, qr/xyz/, 'glyph set grew' );
+	ok( $font->_absent->{"\x{2603}"}, 'snowman is absent from this font' );
+	my $set= $font->_glyph_set;
+	$font->add_text("\x{2603}");
+	is( $font->_glyph_set, $set, 'absent glyph does not rebuild atlas' );
+};
+
+subtest narrow_atlas => sub {
+	my $font= OpenGL::Sandbox::V2::Font->new(data => $mmap, glyphs => 'abW', atlas_width => 16);
+	ok( !eval { $font->_glyph_table; 1 }, 'glyph wider than atlas dies' );
+	like( $@, qr/wider than the atlas/, 'error message' );
+	$font= OpenGL::Sandbox::V2::Font->new(data => $mmap, glyphs => 'abW');
+	ok( eval { $font->_glyph_table; 1 }, 'next atlas builds' ) or diag $@;
+};
+
+subtest atlas_cache => sub {
+	my $dir= tempdir(CLEANUP => 1)."/cache";
+	my $font= OpenGL::Sandbox::V2::Font->new(data => $mmap, cache_dir => $dir);
+	$font->add_text("Test");
+	my @files= glob "$dir/*.sdf";
+	is( scalar @files, 1, 'atlas written to cache' );
+	my $font2= OpenGL::Sandbox::V2::Font->new(data => $mmap, cache_dir => $dir);
+	$font2->add_text("Test");
+	isa_ok( $font2->{_atlas_pixels}, 'OpenGL::Sandbox::MMap', 'pixels' );
+	is( $font2->_glyph_table, $font->_glyph_table, 'same glyph table' );
+	is( $font2->_vertices, $font->_vertices, 'same layout' );
+	my $font3= OpenGL::Sandbox::V2::Font->new(data => $mmap, cache_dir => $dir, face_size => 40);
+	$font3->_glyph_table;
+	is( scalar(() = glob "$dir/*.sdf"), 2, 'different size gets its own file' );
+	# truncated file is ignored and rebuilt
+	truncate $files[0], 100;
+	my $font4= OpenGL::Sandbox::V2::Font->new(data => $mmap, cache_dir => $dir);
+	is( $font4->_glyph_table, $font->_glyph_table, 'rebuilt after corruption' );
+	ok( -s $files[0] > 100, 'file rewritten' );
+};
+
+subtest render => sub {
+	my $cx= try { OpenGL::Sandbox::make_context() }
+		or plan skip_all => "Can't create an OpenGL context";
+	my ($maj)= split /[. ]/, OpenGL::Sandbox::glGetString(OpenGL::Sandbox::GL_VERSION());
+	$maj >= 3 or plan skip_all => "Requires OpenGL 3";
+	my $font= OpenGL::Sandbox::V2::Font->new(data => $mmap);
+	$font->add_text("Hello", x => -1, scale => 1/64);
+	$font->add_text("World", x => -1, y => -.5, scale => 1/64);
+	ok( eval { $font->draw(color => [1,1,0,1]); 1 }, 'draw' ) or diag $@;
+	is( length($font->_vertices), 0, 'queue emptied' );
+	ok( $font->atlas->loaded, 'atlas loaded' );
+	my @e= OpenGL::Sandbox::get_gl_errors();
+	ok( !@e, 'no GL errors' ) or diag "GL Errors: ".join(', ', @e);
+};
+
+done_testing;
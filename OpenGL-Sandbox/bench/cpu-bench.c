@@ -0,0 +1,456 @@
+/* Micro-benchmarks of the C helpers in lib/OpenGL that don't need a GL context.
+ *
+ * Build (from the OpenGL-Sandbox directory):
+ *   cc -O2 -o cpu-bench bench/cpu-bench.c -Ilib/OpenGL -Iinc \
+ *     `perl -MExtUtils::Embed -e ccopts -e ldopts`
+ * Usage:  cpu-bench [--samples N] [--min-time SECONDS] [PATTERN]
+ *
+ * This compiles Sandbox.c into an embedded perl interpreter with no-op GL functions, so no GL
+ * library or display is needed.  The GL functions it links to directly are defined here, and
+ * the ones in inc/glducktape.list are handed to glducktape by a loader.  The color and utf-8
+ * helpers of the V1 dists are included from their headers in the neighbouring dist directories,
+ * so this needs the whole repository checkout.
+ *
+ * Each case runs in batches sized to take at least --min-time, and the output is one
+ * tab-separated line per case with the same columns as bench/gl-bench.pl: the median and
+ * minimum ns per operation over --samples batches, the relative standard deviation, and
+ * operations and bytes per second.
+ */
+#include "EXTERN.h"
+#include "perl.h"
+#include "XSUB.h"
+
+/* The subset of Inline's INLINE.h used by Sandbox.c */
+#define Inline_Stack_Vars      dXSARGS
+#define Inline_Stack_Items     items
+#define Inline_Stack_Item(x)   ST(x)
+#define Inline_Stack_Reset     sp = mark
+#define Inline_Stack_Push(x)   XPUSHs(x)
+#define Inline_Stack_Done      PUTBACK
+#define Inline_Stack_Return(x) XSRETURN(x)
+#define Inline_Stack_Void      XSRETURN(0)
+
+#include "Sandbox.c"
+#include "../../OpenGL-Sandbox-V1/lib/OpenGL/Sandbox/V1-color.h"
+#include "../../OpenGL-Sandbox-V1-FTGLFont/lib/OpenGL/Sandbox/V1/FTGLFont-utf8.h"
+#include <time.h>
+
+/* Stub GL.  If Sandbox.c starts calling another GL function, the link fails here, or for one
+ * in inc/glducktape.list, stub_gl_lookup returns NULL and glducktape croaks.
+ */
+void APIENTRY glDisable(GLenum cap) {}
+void APIENTRY glEnable(GLenum cap) {}
+GLenum APIENTRY glGetError(void) { return GL_NO_ERROR; }
+void APIENTRY glGetIntegerv(GLenum pname, GLint *data) { *data= 0; }
+const GLubyte * APIENTRY glGetString(GLenum name) { return (const GLubyte*) "1.1 stub"; }
+void APIENTRY glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format,
+	GLenum type, void *pixels) {}
+
+static void APIENTRY stub_glBindTexture(GLenum target, GLuint texture) {}
+static void APIENTRY stub_glDeleteTextures(GLsizei n, const GLuint *textures) {}
+static void APIENTRY stub_glGenTextures(GLsizei n, GLuint *textures) { while (n--) textures[n]= n+1; }
+static void APIENTRY stub_glPixelStorei(GLenum pname, GLint param) {}
+static void APIENTRY stub_glTexImage2D(GLenum target, GLint level, GLint internalformat,
+	GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels) {}
+static void APIENTRY stub_glTexParameteri(GLenum target, GLenum pname, GLint param) {}
+static void APIENTRY stub_glTexSubImage2D(GLenum target, GLint level, GLint xoffset,
+	GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels) {}
+
+static void* stub_gl_lookup(const char *name) {
+	static const struct { const char *name; void *fn; } fns[]= {
+		{ "glBindTexture",    (void*) stub_glBindTexture },
+		{ "glDeleteTextures", (void*) stub_glDeleteTextures },
+		{ "glGenTextures",    (void*) stub_glGenTextures },
+		{ "glPixelStorei",    (void*) stub_glPixelStorei },
+		{ "glTexImage2D",     (void*) stub_glTexImage2D },
+		{ "glTexParameteri",  (void*) stub_glTexParameteri },
+		{ "glTexSubImage2D",  (void*) stub_glTexSubImage2D },
+	};
+	size_t i;
+	for (i= 0; i < sizeof(fns)/sizeof(*fns); i++)
+		if (!strcmp(fns[i].name, name)) return fns[i].fn;
+	return NULL;
+}
+
+static PerlInterpreter *my_perl;
+
+struct bench_case {
+	const char *name;
+	size_t bytes;              /* bytes processed per call, or 0 */
+	void (*run)(long n);       /* perform the operation n times */
+};
+
+/* Fixtures, created once before timing */
+static SV *rgb_ref, *rgba_ref, *pv_sv, *pv_ref, *flat_av_ref, *nested_av_ref;
+static SV *color_hex, *color_av_ref, *color_obj;
+static char utf8_text[4096];
+static char wrap_buf[4096];
+static float mat_a[16], mat_b[16];
+static struct frame_writer y4m_fw, png_fw;
+static unsigned char *frame_rgba;
+static struct view_layout view_pos, view_vel, view_half, view_nrm, view_snorm, view_oct, pool_pos, pool_vel;
+static struct work_pool pool;
+static struct mesh_shape mesh_torus;
+static struct view_stream streams[3];
+static char *mesh_buf;
+static volatile unsigned long long sink;
+
+#define PIXELS_LEN (512*512*3)
+#define VIEW_VERTS 10000
+#define POOL_VERTS 1000000
+#define FRAME_W 640
+#define FRAME_H 360
+
+static void bench_rgb_to_bgr(long n)  { while (n--) _img_rgb_to_bgr(rgb_ref, 0); }
+static void bench_rgba_to_bgra(long n) { while (n--) _img_rgb_to_bgr(rgba_ref, 1); }
+
+static void bench_pack_flat(long n) {
+	GLfloat dest[16];
+	int dest_i;
+	while (n--) { dest_i= 0; _recursive_pack(dest, &dest_i, 16, GL_FLOAT, flat_av_ref); }
+	sink += dest[5];
+}
+static void bench_pack_nested(long n) {
+	GLfloat dest[16];
+	int dest_i;
+	while (n--) { dest_i= 0; _recursive_pack(dest, &dest_i, 16, GL_FLOAT, nested_av_ref); }
+	sink += dest[5];
+}
+static void bench_pack_int(long n) {
+	GLint dest[16];
+	int dest_i;
+	while (n--) { dest_i= 0; _recursive_pack(dest, &dest_i, 16, GL_INT, flat_av_ref); }
+	sink += dest[5];
+}
+
+static void bench_buffer_pv(long n) {
+	char *data;
+	unsigned long size;
+	while (n--) { _get_buffer_from_sv(pv_sv, &data, &size); sink += size; }
+}
+static void bench_buffer_ref(long n) {
+	char *data;
+	unsigned long size;
+	while (n--) { _get_buffer_from_sv(pv_ref, &data, &size); sink += size; }
+}
+
+static void bench_dimension(long n) {
+	static const int sizes[]= { 4*4*4, 3*16*16, 4*256*256, 3*1024*1024, 4*4096*4096, 3*2*2 };
+	int has_alpha, i;
+	while (n--)
+		for (i= 0; i < 6; i++)
+			sink += _dimension_from_filesize(sizes[i], &has_alpha);
+}
+
+/* Same life cycle as the scalar of mmap_buffer / unmap_buffer */
+static void bench_wrap_unwrap(long n) {
+	SV *target;
+	while (n--) {
+		target= newSV(0);
+		buffer_scalar_wrap(target, wrap_buf, sizeof(wrap_buf), 0, NULL, NULL);
+		buffer_scalar_unwrap(target);
+		SvREFCNT_dec(target);
+	}
+}
+
+/* The color argument forms of V1 (setcolor, color_parts, color_mix) */
+static void bench_color(SV *c, long n) {
+	double rgba[4];
+	while (n--) { _parse_color(c, rgba); sink += rgba[1] != 0; }
+}
+static void bench_color_hex(long n) { bench_color(color_hex, n); }
+static void bench_color_av(long n)  { bench_color(color_av_ref, n); }
+static void bench_color_obj(long n) { bench_color(color_obj, n); }
+
+/* Mixed ascii and multi-byte text, as walked by FTGLFont render and measured in monospace */
+static void bench_utf8_next(long n) {
+	const char *c;
+	while (n--) for (c= utf8_text; *c; c= next_utf8(c)) sink++;
+}
+static void bench_utf8_count(long n) { while (n--) sink += count_utf8(utf8_text); }
+
+static void bench_mat4_mul(long n) {
+	float dst[16];
+	while (n--) { mat4_mul(dst, mat_a, mat_b); mat_a[0]= dst[1]; }
+	sink += mat_a[0] != 0;
+}
+static void bench_mat4_rotate(long n) {
+	while (n--) mat4_rotate(mat_a, .001, 0, 0, 1);
+	sink += mat_a[0] != 0;
+}
+
+/* The conversion done by the FrameWriter thread for each frame, without the file write */
+static void bench_frame_y4m(long n) { while (n--) sink += frame_encode_y4m(&y4m_fw, frame_rgba); }
+static void bench_frame_png(long n) { while (n--) sink += frame_encode_png(&png_fw, frame_rgba); }
+
+/* BufferView bulk operations over interleaved vertices of 32 bytes */
+static void bench_view_scale(long n) {
+	static const double f[3]= { 1.0001, 1, .9999 }, o[3]= { 0, .001, 0 };
+	while (n--) view_scale_add(&view_pos, f, o);
+}
+static void bench_view_axpy(long n) { while (n--) view_combine(&view_pos, 1, &view_vel, .016); }
+static void bench_view_half(long n) {
+	static const double f[2]= { .999, 1.001 }, o[2]= { 0, 0 };
+	while (n--) view_scale_add(&view_half, f, o);
+}
+
+/* Quantizing float normals into normalized shorts, and into octahedral shorts */
+static void bench_view_snorm(long n) { while (n--) view_combine(&view_snorm, 0, &view_nrm, 1); }
+static void bench_view_oct(long n) { while (n--) view_oct_encode(&view_oct, &view_nrm); }
+
+/* The same as add_view over a larger array, on one thread and on the ThreadPool */
+static const double pool_params[2]= { 1, .016 };
+static void bench_pool_serial(long n) {
+	while (n--) pool_kernel_combine(&pool_pos, &pool_vel, 0, pool_params, 2);
+}
+static void bench_pool_parallel(long n) {
+	while (n--) {
+		work_pool_start(&pool, pool_kernel_combine, &pool_pos, &pool_vel, pool_params, 2);
+		work_pool_wait(&pool);
+	}
+}
+
+/* Procedural mesh vertices (position, normal, uv as floats) */
+#define MESH_SEG 512
+#define MESH_SIDES 256
+#define MESH_VERTS ((MESH_SEG+1) * (MESH_SIDES+1))
+static void bench_mesh_serial(long n) {
+	while (n--) mesh_write_vertices(&mesh_torus, NULL, mesh_buf, 32, 0, MESH_VERTS);
+}
+static void bench_mesh_parallel(long n) {
+	struct view_layout dst= { NULL, 32, MESH_VERTS, GL_UNSIGNED_BYTE, 1, 0 };
+	double params[MESH_PARAMS];
+	dst.data= mesh_buf;
+	mesh_pack(&mesh_torus, params);
+	while (n--) {
+		work_pool_start(&pool, pool_kernel_mesh_vertices, &dst, NULL, params, MESH_PARAMS);
+		work_pool_wait(&pool);
+	}
+}
+
+/* Interleaving separate position, normal and uv arrays into vertices of 32 bytes, one
+ * attribute at a time, in one pass, and in one pass on the ThreadPool
+ */
+static void bench_interleave_each(long n) {
+	int k;
+	while (n--) for (k= 0; k < 3; k++) view_combine(&streams[k].dst, 0, &streams[k].src, 1);
+}
+static void bench_interleave_serial(long n) {
+	while (n--) view_copy_streams(streams, 3, 0, POOL_VERTS);
+}
+static void bench_interleave_parallel(long n) {
+	struct view_layout table= { (char*) streams, 0, POOL_VERTS, GL_UNSIGNED_BYTE, 1, 0 };
+	double params[1]= { 3 };
+	while (n--) {
+		work_pool_start(&pool, pool_kernel_streams, &table, NULL, params, 1);
+		work_pool_wait(&pool);
+	}
+}
+
+static struct bench_case cases[]= {
+	{ "img_rgb_to_bgr/rgb",      PIXELS_LEN,       bench_rgb_to_bgr },
+	{ "img_rgb_to_bgr/rgba",     PIXELS_LEN/3*4,   bench_rgba_to_bgra },
+	{ "recursive_pack/float16",  16*sizeof(float), bench_pack_flat },
+	{ "recursive_pack/float4x4", 16*sizeof(float), bench_pack_nested },
+	{ "recursive_pack/int16",    16*sizeof(int),   bench_pack_int },
+	{ "get_buffer_from_sv/pv",   0,                bench_buffer_pv },
+	{ "get_buffer_from_sv/ref",  0,                bench_buffer_ref },
+	{ "dimension_from_filesize", 0,                bench_dimension },
+	{ "buffer_scalar/wrap_unwrap", 0,              bench_wrap_unwrap },
+	{ "parse_color/hex",         0,                bench_color_hex },
+	{ "parse_color/array",       0,                bench_color_av },
+	{ "parse_color/object",      0,                bench_color_obj },
+	{ "utf8/next",               sizeof(utf8_text)-1, bench_utf8_next },
+	{ "utf8/count",              sizeof(utf8_text)-1, bench_utf8_count },
+	{ "mat4/mul",                0,                bench_mat4_mul },
+	{ "mat4/rotate",             0,                bench_mat4_rotate },
+	{ "buffer_view/scale_add_vec3", VIEW_VERTS*12, bench_view_scale },
+	{ "buffer_view/add_view_vec3",  VIEW_VERTS*12, bench_view_axpy },
+	{ "buffer_view/scale_half2",    VIEW_VERTS*4,  bench_view_half },
+	{ "buffer_view/snorm16_vec3",   VIEW_VERTS*12, bench_view_snorm },
+	{ "buffer_view/oct_snorm16",    VIEW_VERTS*12, bench_view_oct },
+	{ "thread_pool/add_view_serial",   POOL_VERTS*12, bench_pool_serial },
+	{ "thread_pool/add_view_parallel", POOL_VERTS*12, bench_pool_parallel },
+	{ "mesh/torus_vertices_serial",   MESH_VERTS*32, bench_mesh_serial },
+	{ "mesh/torus_vertices_parallel", MESH_VERTS*32, bench_mesh_parallel },
+	{ "interleave/per_attribute",   POOL_VERTS*32, bench_interleave_each },
+	{ "interleave/streams_serial",   POOL_VERTS*32, bench_interleave_serial },
+	{ "interleave/streams_parallel", POOL_VERTS*32, bench_interleave_parallel },
+	{ "frame_writer/y4m_encode", FRAME_W*FRAME_H*4, bench_frame_y4m },
+	{ "frame_writer/png_encode", FRAME_W*FRAME_H*4, bench_frame_png },
+	{ NULL, 0, NULL }
+};
+
+static SV* float_av(int n, int start) {
+	AV *av= newAV();
+	int i;
+	for (i= 0; i < n; i++) av_push(av, newSVnv(start + i * .5));
+	return newRV_noinc((SV*) av);
+}
+
+static void setup(void) {
+	AV *rows= newAV();
+	int i;
+	rgb_ref= newRV_noinc(newSV(PIXELS_LEN));
+	SvPOK_on(SvRV(rgb_ref));
+	SvCUR_set(SvRV(rgb_ref), PIXELS_LEN);
+	memset(SvPVX(SvRV(rgb_ref)), 0x5A, PIXELS_LEN);
+	rgba_ref= newRV_noinc(newSV(PIXELS_LEN/3*4));
+	SvPOK_on(SvRV(rgba_ref));
+	SvCUR_set(SvRV(rgba_ref), PIXELS_LEN/3*4);
+	memset(SvPVX(SvRV(rgba_ref)), 0x5A, PIXELS_LEN/3*4);
+	pv_sv= newSVpvn(wrap_buf, sizeof(wrap_buf));
+	pv_ref= newRV_inc(pv_sv);
+	flat_av_ref= float_av(16, 0);
+	for (i= 0; i < 4; i++) av_push(rows, float_av(4, i*4));
+	nested_av_ref= newRV_noinc((SV*) rows);
+	{
+		static const GLfloat orange[4]= { 1, .5, 0, 1 };
+		static const char words[]= "caf\xC3\xA9 \xE2\x82\xAC" "5 na\xC3\xAFve \xF0\x9F\x99\x82 ";
+		color_hex= newSVpvs("#FF8000");
+		color_av_ref= float_av(4, 0);
+		color_obj= sv_bless(newRV_noinc(newSVpvn((const char*) orange, sizeof(orange))),
+			gv_stashpv("OpenGL::Sandbox::V1::Color", GV_ADD));
+		for (i= 0; i + sizeof(words) - 1 < sizeof(utf8_text); i += sizeof(words) - 1)
+			memcpy(utf8_text + i, words, sizeof(words) - 1);
+		memset(utf8_text + i, 'x', sizeof(utf8_text) - 1 - i);
+	}
+	mat4_identity(mat_a);
+	mat4_identity(mat_b);
+	mat4_rotate(mat_b, .5, 1, 0, 0);
+	frame_rgba= (unsigned char*) malloc(FRAME_W*FRAME_H*4);
+	for (i= 0; i < FRAME_W*FRAME_H*4; i++) frame_rgba[i]= i * 7 + (i >> 10);
+	y4m_fw.opts.format= FRAME_Y4M;
+	png_fw.opts.format= FRAME_PNG;
+	y4m_fw.opts.width= png_fw.opts.width= FRAME_W;
+	y4m_fw.opts.height= png_fw.opts.height= FRAME_H;
+	y4m_fw.opts.flip= png_fw.opts.flip= 1;
+	y4m_fw.scratch= (unsigned char*) malloc(6 + FRAME_W*FRAME_H*3/2);
+	png_fw.scratch= (unsigned char*) malloc(8 + 25 + 12 + frame_png_zlib_size(FRAME_W, FRAME_H) + 12);
+	frame_crc_init();
+	view_pos.data= (char*) calloc(VIEW_VERTS, 32);
+	view_pos.stride= 32;
+	view_pos.count= VIEW_VERTS;
+	view_pos.type= GL_FLOAT;
+	view_pos.components= 3;
+	view_vel= view_pos;
+	view_vel.data= (char*) calloc(VIEW_VERTS, 12);
+	view_vel.stride= 12;
+	view_half= view_pos;
+	view_half.data += 24;
+	view_half.type= GL_HALF_FLOAT;
+	view_half.components= 2;
+	view_fill(&view_half, (const double[]){ 1, 1 });
+	view_nrm= view_pos;
+	view_nrm.data += 12;
+	view_fill(&view_nrm, (const double[]){ .48, -.6, .64 });
+	view_snorm= view_nrm;
+	view_snorm.data= (char*) calloc(VIEW_VERTS, 8);
+	view_snorm.stride= 8;
+	view_snorm.type= GL_SHORT;
+	view_snorm.normalized= 1;
+	view_oct= view_snorm;
+	view_oct.data= (char*) calloc(VIEW_VERTS, 4);
+	view_oct.stride= 4;
+	view_oct.components= 2;
+	pool_pos= view_pos;
+	pool_pos.data= (char*) calloc(POOL_VERTS, 32);
+	pool_pos.count= POOL_VERTS;
+	pool_vel= view_vel;
+	pool_vel.data= (char*) calloc(POOL_VERTS, 12);
+	pool_vel.count= POOL_VERTS;
+	work_pool_open(&pool, pool_cpu_count());
+	mesh_torus.shape= MESH_TORUS;
+	mesh_torus.nu= MESH_SEG;
+	mesh_torus.nv= MESH_SIDES;
+	mesh_torus.a= 1;
+	mesh_torus.b= .25;
+	mesh_torus.position= (struct mesh_attr){ 0, GL_FLOAT, 3, 0, 0 };
+	mesh_torus.normal= (struct mesh_attr){ 12, GL_FLOAT, 3, 0, 0 };
+	mesh_torus.uv= (struct mesh_attr){ 24, GL_FLOAT, 2, 0, 0 };
+	mesh_buf= (char*) malloc((size_t) MESH_VERTS * 32);
+	for (i= 0; i < 3; i++) {
+		streams[i].src= pool_vel;
+		streams[i].src.components= i < 2? 3 : 2;
+		streams[i].src.stride= streams[i].src.components * 4;
+		streams[i].src.data= (char*) calloc(POOL_VERTS, streams[i].src.stride);
+		streams[i].dst= streams[i].src;
+		streams[i].dst.data= (char*) pool_pos.data + i * 12;
+		streams[i].dst.stride= 32;
+	}
+}
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int cmp_double(const void *a, const void *b) {
+	double x= *(const double*)a, y= *(const double*)b;
+	return x < y? -1 : x > y? 1 : 0;
+}
+
+static void usage(void) {
+	fprintf(stderr, "Usage: cpu-bench [--samples N] [--min-time SECONDS] [PATTERN]\n");
+	exit(1);
+}
+
+int main(int argc, char **argv, char **env) {
+	char *perl_args[]= { "", "-MCarp", "-e0", NULL };
+	const char *pattern= NULL;
+	int samples= 15, i, s;
+	double min_time= .02, t[256], t0, med, mean, var;
+	long n;
+	struct bench_case *c;
+
+	for (i= 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--samples") && i+1 < argc) samples= atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--min-time") && i+1 < argc) min_time= atof(argv[++i]);
+		else if (argv[i][0] == '-' || pattern) usage();
+		else pattern= argv[i];
+	}
+	if (samples < 1 || samples > 256 || min_time <= 0) usage();
+
+	PERL_SYS_INIT3(&argc, &argv, &env);
+	my_perl= perl_alloc();
+	perl_construct(my_perl);
+	PL_exit_flags |= PERL_EXIT_DESTRUCT_END;
+	if (perl_parse(my_perl, NULL, 3, perl_args, NULL) || perl_run(my_perl)) {
+		fprintf(stderr, "Can't start perl interpreter\n");
+		return 2;
+	}
+	glducktape_set_loader(stub_gl_lookup);
+	setup();
+
+	printf("name\tns_per_op\tmin_ns\trel_stddev\tops_per_sec\tbytes_per_sec\n");
+	for (c= cases; c->name; c++) {
+		if (pattern && !strstr(c->name, pattern)) continue;
+		/* warm up, then double the count until a batch is long enough */
+		for (n= 1; n < (1L<<30); n *= 2) {
+			t0= now();
+			c->run(n);
+			if (now() - t0 >= min_time) break;
+		}
+		for (s= 0, mean= 0; s < samples; s++) {
+			t0= now();
+			c->run(n);
+			t[s]= (now() - t0) / n;
+			mean += t[s] / samples;
+		}
+		for (s= 0, var= 0; s < samples; s++)
+			var += (t[s] - mean) * (t[s] - mean) / samples;
+		qsort(t, samples, sizeof(double), cmp_double);
+		med= samples & 1? t[samples/2] : (t[samples/2-1] + t[samples/2]) / 2;
+		printf("%s\t%.6g\t%.6g\t%.1f%%\t%.6g\t", c->name, med * 1e9, t[0] * 1e9,
+			mean > 0? sqrt(var) / mean * 100 : 0, med > 0? 1 / med : 0);
+		if (c->bytes) printf("%.6g\n", med > 0? c->bytes / med : 0);
+		else printf("-\n");
+		fflush(stdout);
+	}
+
+	perl_destruct(my_perl);
+	perl_free(my_perl);
+	PERL_SYS_TERM();
+	return (int) (sink & 0);
+}
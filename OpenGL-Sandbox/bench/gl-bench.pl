@@ -0,0 +1,244 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use FindBin;
+use lib "$FindBin::Bin/../lib";
+use Getopt::Long;
+use Pod::Usage;
+use Time::HiRes 'time';
+use JSON::PP;
+use OpenGL::Sandbox qw( make_context get_gl_errors glGetString glFinish glDrawArrays
+	GL_VERSION GL_RENDERER GL_FLOAT GL_UNSIGNED_BYTE GL_ARRAY_BUFFER GL_STREAM_DRAW GL_TRIANGLES
+	GL_RED GL_RG GL_RGB GL_BGR GL_RGBA GL_BGRA GL_LINEAR GL_VERTEX_SHADER GL_FRAGMENT_SHADER );
+use OpenGL::Sandbox::Texture;
+use OpenGL::Sandbox::Buffer;
+use OpenGL::Sandbox::VertexArray;
+use OpenGL::Sandbox::Shader;
+use OpenGL::Sandbox::Program;
+
+=head1 USAGE
+
+  gl-bench.pl [OPTIONS] [PATTERN...]
+
+Measure the GL paths of OpenGL::Sandbox on a headless context, and print one line per case.
+Only cases whose name matches one of the PATTERNs (regexes) are run.
+
+=head1 OPTIONS
+
+=over
+
+=item --json
+
+Print a JSON document (with the renderer, GL version, and git commit) instead of a table.
+
+=item --compare FILE
+
+Compare with the JSON output of an earlier run, adding the baseline time and the change.
+
+=item --samples N
+
+Number of timed batches per case (default 7).  The median is reported.
+
+=item --min-time SECONDS
+
+Minimum time of each batch (default 0.05).  The number of iterations per batch is chosen to
+take at least this long.
+
+=item --size N
+
+Width and height of the textures (default 512).
+
+=item --provider NAME
+
+Context provider for L<OpenGL::Sandbox/make_context> (default C<EGL>).
+
+=item --hardware
+
+Allow a GPU driver.  By default Mesa's llvmpipe is requested, so results can be compared
+between machines with the same Mesa version.
+
+=item --list
+
+Print the case names and exit.
+
+=back
+
+Each batch ends with C<glFinish>, so times include the work done by the driver.
+
+=cut
+
+my %opt= ( samples => 7, 'min-time' => .05, size => 512, provider => 'EGL' );
+GetOptions(\%opt, qw( json compare=s samples=i min-time=f size=i provider=s hardware list help ))
+	or pod2usage(2);
+pod2usage(1) if $opt{help};
+my $filter= @ARGV? join('|', map "(?:$_)", @ARGV) : '';
+
+make_context(provider => $opt{provider}, visible => 0, width => 256, height => 256,
+	gl_version => '3.3', profile => 'core', software => !$opt{hardware});
+
+# Each case is [ $name, $bytes_per_op, $setup ], where $setup returns the code to time.
+my @cases;
+sub bench_case { push @cases, [ @_ ] }
+
+# Texture upload through _texture_load, for each format, with tight and padded rows
+my $dim= $opt{size};
+for ([ red => GL_RED, 1 ], [ rg => GL_RG, 2 ], [ rgb => GL_RGB, 3 ], [ bgr => GL_BGR, 3 ],
+	[ rgba => GL_RGBA, 4 ], [ bgra => GL_BGRA, 4 ]
+) {
+	my ($fname, $format, $px)= @$_;
+	for my $pad (0, 16) {
+		my $pitch= ($dim + $pad) * $px;
+		bench_case("tex_upload/$fname/".($pad? 'padded' : 'tight'), $dim*$dim*$px, sub {
+			my $pixels= "\x80" x ($pitch * $dim);
+			my $tex= OpenGL::Sandbox::Texture->new(name => 'bench', mipmap => 0, min_filter => GL_LINEAR);
+			my %args= (format => $format, type => GL_UNSIGNED_BYTE, width => $dim, height => $dim,
+				data => \$pixels, ($pad? (pitch => $pitch) : ()));
+			sub { $tex->load(\%args) };
+		});
+	}
+}
+
+# Buffer uploads
+for my $size (4096, 65536, 4<<20) {
+	my $label= $size >= 1<<20? ($size>>20).'M' : ($size>>10).'K';
+	bench_case("buffer_data/$label", $size, sub {
+		my $data= "\x01" x $size;
+		my $buf= OpenGL::Sandbox::Buffer->new(target => GL_ARRAY_BUFFER, usage => GL_STREAM_DRAW);
+		$buf->bind;
+		sub { OpenGL::Sandbox::load_buffer_data(GL_ARRAY_BUFFER, undef, $data, GL_STREAM_DRAW) };
+	});
+	bench_case("buffer_sub_data/$label", $size, sub {
+		my $data= "\x02" x $size;
+		my $buf= OpenGL::Sandbox::Buffer->new(target => GL_ARRAY_BUFFER, usage => GL_STREAM_DRAW, data => $data);
+		$buf->bind;
+		sub { OpenGL::Sandbox::load_buffer_sub_data(GL_ARRAY_BUFFER, 0, undef, $data, 0) };
+	});
+	bench_case("mmap_write/$label", $size, sub {
+		my $data= "\x03" x $size;
+		my $buf= OpenGL::Sandbox::Buffer->new(target => GL_ARRAY_BUFFER, usage => GL_STREAM_DRAW, data => $data);
+		$buf->bind;
+		sub { substr(${ $buf->mmap('w') }, 0, $size)= $data; $buf->unmap };
+	});
+	bench_case("mmap_read/$label", $size, sub {
+		my $buf= OpenGL::Sandbox::Buffer->new(target => GL_ARRAY_BUFFER, usage => GL_STREAM_DRAW, data => "\x04" x $size);
+		my $copy;
+		$buf->bind;
+		sub { $copy= ${ $buf->mmap('r') }; $buf->unmap };
+	});
+}
+
+# A program which uses one uniform of each type, and a triangle to draw with it
+my $program= OpenGL::Sandbox::Program->new(name => 'bench', shaders => {
+	vertex => OpenGL::Sandbox::Shader->new(name => 'bench.vert', type => GL_VERTEX_SHADER, source => <<'END'),
+#version 330 core
+in vec2 pos;
+uniform mat4 u_m4;
+uniform vec2 u_v2;
+void main() { gl_Position = u_m4 * vec4(pos + u_v2, 0, 1); }
+END
+	fragment => OpenGL::Sandbox::Shader->new(name => 'bench.frag', type => GL_FRAGMENT_SHADER, source => <<'END'),
+#version 330 core
+uniform float u_f;
+uniform vec3 u_v3;
+uniform vec4 u_v4;
+uniform int u_i;
+out vec4 color;
+void main() { color = u_v4 * u_f + vec4(u_v3, float(u_i)); }
+END
+});
+$program->bind;
+my @identity= (1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1);
+for ([ float => 'u_f', .5 ], [ vec2 => 'u_v2', 0, 0 ], [ vec3 => 'u_v3', 1, 2, 3 ],
+	[ vec4 => 'u_v4', 1, 2, 3, 4 ], [ int => 'u_i', 1 ], [ mat4 => 'u_m4', @identity ],
+	[ 'mat4_ref' => 'u_m4', \@identity ]
+) {
+	my ($type, $name, @value)= @$_;
+	bench_case("set_uniform/$type", 0, sub { sub { $program->set_uniform($name, @value) } });
+}
+
+my $tri_buf= OpenGL::Sandbox::Buffer->new(target => GL_ARRAY_BUFFER,
+	data => pack('f*', map { (-1,-1, 1,-1, 0,1) } 1..10000));
+my $vao= OpenGL::Sandbox::VertexArray->new(attributes => { pos => { size => 2, type => GL_FLOAT } });
+bench_case('vao_bind', 0, sub { sub { $vao->bind($program, $tri_buf) } });
+bench_case('draw/1tri', 0, sub { $vao->bind($program, $tri_buf); sub { glDrawArrays(GL_TRIANGLES, 0, 3) } });
+bench_case('draw/10000tri', 0, sub { $vao->bind($program, $tri_buf); sub { glDrawArrays(GL_TRIANGLES, 0, 30000) } });
+
+@cases= grep $_->[0] =~ /$filter/, @cases;
+if ($opt{list}) { print "$_->[0]\n" for @cases; exit 0; }
+
+# Run $code $n times and return the seconds per call
+sub run_batch {
+	my ($code, $n)= @_;
+	my $t0= time;
+	$code->() for 1..$n;
+	glFinish();
+	return (time - $t0) / $n;
+}
+
+sub median { my @s= sort { $a <=> $b } @_; @s % 2? $s[$#s/2] : ($s[@s/2-1] + $s[@s/2]) / 2 }
+
+my @results;
+for (@cases) {
+	my ($name, $bytes, $setup)= @$_;
+	my $code= $setup->();
+	# Warm up, then double the iterations until a batch is long enough
+	my $n= 1;
+	$n *= 2 while run_batch($code, $n) * $n < $opt{'min-time'} && $n < 1<<24;
+	my @t= map run_batch($code, $n), 1..$opt{samples};
+	my @errors= get_gl_errors();
+	warn "$name: GL errors: @errors\n" if @errors;
+	my $med= median(@t);
+	my $mean= 0; $mean += $_/@t for @t;
+	my $var= 0; $var += ($_-$mean)**2/@t for @t;
+	push @results, {
+		name => $name,
+		iterations => $n,
+		samples => scalar @t,
+		ns_per_op => $med * 1e9,
+		min_ns => (sort { $a <=> $b } @t)[0] * 1e9,
+		rel_stddev => $mean? sqrt($var) / $mean : 0,
+		ops_per_sec => $med? 1 / $med : 0,
+		($bytes? (bytes_per_sec => $med? $bytes / $med : 0) : ()),
+		(@errors? (gl_errors => \@errors) : ()),
+	};
+}
+
+my %baseline;
+if ($opt{compare}) {
+	open my $fh, '<', $opt{compare} or die "open($opt{compare}): $!\n";
+	my $old= decode_json(do { local $/; <$fh> });
+	$baseline{$_->{name}}= $_ for @{ $old->{results} };
+	for (@results) {
+		my $base= $baseline{$_->{name}} or next;
+		$_->{baseline_ns}= $base->{ns_per_op};
+		$_->{change}= $base->{ns_per_op}? $_->{ns_per_op} / $base->{ns_per_op} - 1 : 0;
+	}
+}
+
+if ($opt{json}) {
+	my $commit= `git -C "$FindBin::Bin" rev-parse --short HEAD 2>/dev/null` // '';
+	chomp $commit;
+	print JSON::PP->new->canonical->pretty->encode({
+		renderer => glGetString(GL_RENDERER),
+		gl_version => glGetString(GL_VERSION),
+		perl => "$^V",
+		commit => $commit,
+		time => time,
+		results => \@results,
+	});
+}
+else {
+	my @cols= qw( name ns_per_op min_ns rel_stddev ops_per_sec bytes_per_sec );
+	push @cols, qw( baseline_ns change ) if $opt{compare};
+	print "# ".glGetString(GL_RENDERER)."\n", join("\t", @cols), "\n";
+	for my $r (@results) {
+		print join("\t", map {
+			my $v= $r->{$_};
+			!defined $v? '-'
+			: $_ eq 'name'? $v
+			: $_ eq 'rel_stddev'? sprintf('%.1f%%', $v*100)
+			: $_ eq 'change'? sprintf('%+.1f%%', $v*100)
+			: sprintf('%.6g', $v)
+		} @cols), "\n";
+	}
+}
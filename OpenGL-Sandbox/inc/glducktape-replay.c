@@ -0,0 +1,199 @@
+/* Replay a GL trace written by OpenGL::Sandbox::gl_capture_start on a headless EGL context,
+ * and report the time of each frame.
+ *
+ * Build:  cc -O2 -o glducktape-replay inc/glducktape-replay.c -lEGL -lGL -ldl
+ * Usage:  glducktape-replay [--repeat N] [--summary] trace.gldt
+ *
+ * Output is tab-separated: one line per frame of "pass", "frame", "calls", "ms", followed by
+ * comment lines (starting with '#') giving the mean, median, and worst frame time.  Each frame
+ * ends with glFinish, so the times include the GPU work.
+ *
+ * Only the calls that went through the glducktape dispatch table are in the trace.  Objects
+ * created by other means (such as shaders compiled from perl) don't exist on the replay
+ * context, so calls that refer to them will raise GL errors, which are ignored.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+static void croak(const char *fmt, ...) {
+	va_list ap;
+	va_start(ap, fmt);
+	vfprintf(stderr, fmt, ap);
+	va_end(ap);
+	fputc('\n', stderr);
+	exit(2);
+}
+
+#define GLDUCKTAPE_REPLAYER
+#include "glducktape.c"
+
+static void usage(void) {
+	fprintf(stderr, "Usage: glducktape-replay [--repeat N] [--summary] trace.gldt\n");
+	exit(1);
+}
+
+static int cmp_double(const void *a, const void *b) {
+	double x= *(const double*)a, y= *(const double*)b;
+	return x < y? -1 : x > y? 1 : 0;
+}
+
+/* Create and bind a GL context with no window, preferring Mesa's surfaceless platform */
+static void make_context(void) {
+	PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display;
+	EGLDisplay dpy= EGL_NO_DISPLAY;
+	EGLConfig config= NULL;
+	EGLContext cx;
+	EGLSurface surface= EGL_NO_SURFACE;
+	EGLint major, minor, n= 0;
+	static const EGLint config_attr[]= {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_NONE
+	};
+	static const EGLint pbuffer_attr[]= { EGL_WIDTH, 16, EGL_HEIGHT, 16, EGL_NONE };
+	const char *ext= eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+	get_platform_display= (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+	if (get_platform_display && ext && strstr(ext, "EGL_MESA_platform_surfaceless"))
+		dpy= get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+#endif
+	if (dpy == EGL_NO_DISPLAY)
+		dpy= eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &major, &minor))
+		croak("Can't initialize EGL");
+	if (!eglBindAPI(EGL_OPENGL_API))
+		croak("EGL doesn't support desktop OpenGL");
+	eglChooseConfig(dpy, config_attr, &config, 1, &n);
+	if (!n) {
+		ext= eglQueryString(dpy, EGL_EXTENSIONS);
+		if (!ext || !strstr(ext, "EGL_KHR_no_config_context"))
+			croak("No EGL config with pbuffer support");
+		config= (EGLConfig) 0; /* EGL_NO_CONFIG_KHR */
+	}
+	if ((cx= eglCreateContext(dpy, config, EGL_NO_CONTEXT, NULL)) == EGL_NO_CONTEXT)
+		croak("eglCreateContext failed: 0x%X", eglGetError());
+	if (n)
+		surface= eglCreatePbufferSurface(dpy, config, pbuffer_attr);
+	if (!eglMakeCurrent(dpy, surface, surface, cx))
+		croak("eglMakeCurrent failed: 0x%X", eglGetError());
+}
+
+int main(int argc, char **argv) {
+	const char *path= NULL;
+	int repeat= 1, summary= 0, pass, i, gl_major= 0, gl_minor= 0;
+	unsigned int version, count, frame, calls, n_frames= 0, frames_alloc= 0;
+	unsigned char *data;
+	size_t size, pos, body_ofs;
+	long fsize;
+	int *local_idx;
+	double *frame_ms= NULL, total= 0;
+	unsigned long long t0, t;
+	struct glducktape_dispatch table;
+	const char *gl_version;
+	FILE *fh;
+
+	for (i= 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--repeat") && i+1 < argc) repeat= atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--summary")) summary= 1;
+		else if (argv[i][0] == '-' || path) usage();
+		else path= argv[i];
+	}
+	if (!path || repeat < 1) usage();
+
+	if (!(fh= fopen(path, "rb")))
+		croak("Can't open %s", path);
+	fseek(fh, 0, SEEK_END);
+	fsize= ftell(fh);
+	fseek(fh, 0, SEEK_SET);
+	if (fsize < 16 || !(data= (unsigned char*) malloc(fsize)) || fread(data, fsize, 1, fh) != 1)
+		croak("Can't read %s", path);
+	fclose(fh);
+	size= (size_t) fsize;
+	if (memcmp(data, "GLDTRACE", 8))
+		croak("%s is not a trace file", path);
+	memcpy(&version, data+8, 4);
+	memcpy(&count, data+12, 4);
+	if (version != 2)
+		croak("Unsupported trace version %u", version);
+
+	/* Find this build's index for each function named in the trace */
+	local_idx= (int*) malloc(sizeof(int) * (count? count : 1));
+	for (pos= 16, i= 0; (unsigned) i < count; i++) {
+		int j;
+		unsigned len;
+		if (pos >= size || pos + 1 + data[pos] > size)
+			croak("Truncated trace header");
+		len= data[pos];
+		local_idx[i]= -1;
+		for (j= 0; j < glducktape_fn_count; j++)
+			if (strlen(glducktape_names[j]) == len && !memcmp(glducktape_names[j], data+pos+1, len))
+				local_idx[i]= j;
+		if (local_idx[i] < 0)
+			fprintf(stderr, "warning: %.*s is not supported by this replayer\n", (int) len, data+pos+1);
+		pos += 1 + len;
+	}
+	body_ofs= pos;
+
+	make_context();
+	gl_version= (const char*) glGetString(GL_VERSION);
+	if (gl_version) {
+		while (*gl_version && (*gl_version < '0' || *gl_version > '9')) gl_version++;
+		sscanf(gl_version, "%d.%d", &gl_major, &gl_minor);
+	}
+	glducktape_resolve(&table, gl_major, gl_minor, NULL, NULL);
+	glducktape_use(&table);
+	printf("# %s on %s\n", path, glGetString(GL_RENDERER));
+	if (!summary) printf("pass\tframe\tcalls\tms\n");
+
+	for (pass= 0; pass < repeat; pass++) {
+		frame= calls= 0;
+		t0= glducktape_now_ns();
+		for (pos= body_ofs; pos < size; ) {
+			unsigned short idx;
+			unsigned int len;
+			if (size - pos < 6)
+				croak("Truncated record at offset %lu", (unsigned long) pos);
+			memcpy(&idx, data+pos, 2);
+			memcpy(&len, data+pos+2, 4);
+			pos += 6;
+			if (len > size - pos)
+				croak("Truncated record at offset %lu", (unsigned long) pos);
+			if (idx == 0xFFFF) {
+				glFinish();
+				t= glducktape_now_ns();
+				if (n_frames >= frames_alloc) {
+					frames_alloc= frames_alloc? frames_alloc * 2 : 256;
+					if (!(frame_ms= (double*) realloc(frame_ms, frames_alloc * sizeof(double))))
+						croak("Out of memory");
+				}
+				frame_ms[n_frames++]= (t - t0) * 1e-6;
+				if (!summary)
+					printf("%d\t%u\t%u\t%.3f\n", pass, frame, calls, (t - t0) * 1e-6);
+				frame++;
+				calls= 0;
+				t0= glducktape_now_ns();
+			}
+			else if (idx < count && local_idx[idx] >= 0) {
+				if (!glducktape_replay_call(local_idx[idx], data+pos, len))
+					croak("Malformed record for %s at offset %lu", glducktape_names[local_idx[idx]], (unsigned long) pos);
+				calls++;
+			}
+			pos += len;
+		}
+		/* drain any GL errors caused by objects that weren't captured */
+		for (i= 0; i < 100 && glGetError() != GL_NO_ERROR; i++);
+	}
+
+	if (n_frames) {
+		for (i= 0; (unsigned) i < n_frames; i++) total += frame_ms[i];
+		qsort(frame_ms, n_frames, sizeof(double), cmp_double);
+		printf("# frames\t%u\n# mean_ms\t%.3f\n# p50_ms\t%.3f\n# max_ms\t%.3f\n",
+			n_frames, total / n_frames, frame_ms[n_frames/2], frame_ms[n_frames-1]);
+	}
+	else printf("# no frame markers in trace\n");
+	return 0;
+}
@@ -1,178 +1,1027 @@
 #include <GL/gl.h>
 #include <GL/glext.h>
-extern void* glducktape_initProcAddress(const char *name, void **fnptr);
-#ifdef GL_VERSION_2_0
- extern PFNGLBINDBUFFERPROC glducktape_glBindBuffer;
- #define glBindBuffer (glducktape_glBindBuffer? glducktape_glBindBuffer : (PFNGLBINDBUFFERPROC)glducktape_initProcAddress("glBindBuffer",(void**)&glducktape_glBindBuffer))
-
- extern PFNGLBUFFERDATAPROC glducktape_glBufferData;
- #define glBufferData (glducktape_glBufferData? glducktape_glBufferData : (PFNGLBUFFERDATAPROC)glducktape_initProcAddress("glBufferData",(void**)&glducktape_glBufferData))
-
- extern PFNGLBUFFERSUBDATAPROC glducktape_glBufferSubData;
- #define glBufferSubData (glducktape_glBufferSubData? glducktape_glBufferSubData : (PFNGLBUFFERSUBDATAPROC)glducktape_initProcAddress("glBufferSubData",(void**)&glducktape_glBufferSubData))
-
- extern PFNGLDELETEBUFFERSPROC glducktape_glDeleteBuffers;
- #define glDeleteBuffers (glducktape_glDeleteBuffers? glducktape_glDeleteBuffers : (PFNGLDELETEBUFFERSPROC)glducktape_initProcAddress("glDeleteBuffers",(void**)&glducktape_glDeleteBuffers))
-
- extern PFNGLGENBUFFERSPROC glducktape_glGenBuffers;
- #define glGenBuffers (glducktape_glGenBuffers? glducktape_glGenBuffers : (PFNGLGENBUFFERSPROC)glducktape_initProcAddress("glGenBuffers",(void**)&glducktape_glGenBuffers))
-
- extern PFNGLGETACTIVEUNIFORMPROC glducktape_glGetActiveUniform;
- #define glGetActiveUniform (glducktape_glGetActiveUniform? glducktape_glGetActiveUniform : (PFNGLGETACTIVEUNIFORMPROC)glducktape_initProcAddress("glGetActiveUniform",(void**)&glducktape_glGetActiveUniform))
-
- extern PFNGLGETBUFFERPARAMETERIVPROC glducktape_glGetBufferParameteriv;
- #define glGetBufferParameteriv (glducktape_glGetBufferParameteriv? glducktape_glGetBufferParameteriv : (PFNGLGETBUFFERPARAMETERIVPROC)glducktape_initProcAddress("glGetBufferParameteriv",(void**)&glducktape_glGetBufferParameteriv))
-
- extern PFNGLGETPROGRAMIVPROC glducktape_glGetProgramiv;
- #define glGetProgramiv (glducktape_glGetProgramiv? glducktape_glGetProgramiv : (PFNGLGETPROGRAMIVPROC)glducktape_initProcAddress("glGetProgramiv",(void**)&glducktape_glGetProgramiv))
-
- extern PFNGLGETUNIFORMLOCATIONPROC glducktape_glGetUniformLocation;
- #define glGetUniformLocation (glducktape_glGetUniformLocation? glducktape_glGetUniformLocation : (PFNGLGETUNIFORMLOCATIONPROC)glducktape_initProcAddress("glGetUniformLocation",(void**)&glducktape_glGetUniformLocation))
-
- extern PFNGLMAPBUFFERPROC glducktape_glMapBuffer;
- #define glMapBuffer (glducktape_glMapBuffer? glducktape_glMapBuffer : (PFNGLMAPBUFFERPROC)glducktape_initProcAddress("glMapBuffer",(void**)&glducktape_glMapBuffer))
-
- extern PFNGLUNIFORM1FVPROC glducktape_glUniform1fv;
- #define glUniform1fv (glducktape_glUniform1fv? glducktape_glUniform1fv : (PFNGLUNIFORM1FVPROC)glducktape_initProcAddress("glUniform1fv",(void**)&glducktape_glUniform1fv))
-
- extern PFNGLUNIFORM1IVPROC glducktape_glUniform1iv;
- #define glUniform1iv (glducktape_glUniform1iv? glducktape_glUniform1iv : (PFNGLUNIFORM1IVPROC)glducktape_initProcAddress("glUniform1iv",(void**)&glducktape_glUniform1iv))
-
- extern PFNGLUNIFORM2FVPROC glducktape_glUniform2fv;
- #define glUniform2fv (glducktape_glUniform2fv? glducktape_glUniform2fv : (PFNGLUNIFORM2FVPROC)glducktape_initProcAddress("glUniform2fv",(void**)&glducktape_glUniform2fv))
-
- extern PFNGLUNIFORM2IVPROC glducktape_glUniform2iv;
- #define glUniform2iv (glducktape_glUniform2iv? glducktape_glUniform2iv : (PFNGLUNIFORM2IVPROC)glducktape_initProcAddress("glUniform2iv",(void**)&glducktape_glUniform2iv))
-
- extern PFNGLUNIFORM3FVPROC glducktape_glUniform3fv;
- #define glUniform3fv (glducktape_glUniform3fv? glducktape_glUniform3fv : (PFNGLUNIFORM3FVPROC)glducktape_initProcAddress("glUniform3fv",(void**)&glducktape_glUniform3fv))
 
- extern PFNGLUNIFORM3IVPROC glducktape_glUniform3iv;
- #define glUniform3iv (glducktape_glUniform3iv? glducktape_glUniform3iv : (PFNGLUNIFORM3IVPROC)glducktape_initProcAddress("glUniform3iv",(void**)&glducktape_glUniform3iv))
-
- extern PFNGLUNIFORM4FVPROC glducktape_glUniform4fv;
- #define glUniform4fv (glducktape_glUniform4fv? glducktape_glUniform4fv : (PFNGLUNIFORM4FVPROC)glducktape_initProcAddress("glUniform4fv",(void**)&glducktape_glUniform4fv))
-
- extern PFNGLUNIFORM4IVPROC glducktape_glUniform4iv;
- #define glUniform4iv (glducktape_glUniform4iv? glducktape_glUniform4iv : (PFNGLUNIFORM4IVPROC)glducktape_initProcAddress("glUniform4iv",(void**)&glducktape_glUniform4iv))
-
- extern PFNGLUNIFORMMATRIX2FVPROC glducktape_glUniformMatrix2fv;
- #define glUniformMatrix2fv (glducktape_glUniformMatrix2fv? glducktape_glUniformMatrix2fv : (PFNGLUNIFORMMATRIX2FVPROC)glducktape_initProcAddress("glUniformMatrix2fv",(void**)&glducktape_glUniformMatrix2fv))
-
- extern PFNGLUNIFORMMATRIX3FVPROC glducktape_glUniformMatrix3fv;
- #define glUniformMatrix3fv (glducktape_glUniformMatrix3fv? glducktape_glUniformMatrix3fv : (PFNGLUNIFORMMATRIX3FVPROC)glducktape_initProcAddress("glUniformMatrix3fv",(void**)&glducktape_glUniformMatrix3fv))
-
- extern PFNGLUNIFORMMATRIX4FVPROC glducktape_glUniformMatrix4fv;
- #define glUniformMatrix4fv (glducktape_glUniformMatrix4fv? glducktape_glUniformMatrix4fv : (PFNGLUNIFORMMATRIX4FVPROC)glducktape_initProcAddress("glUniformMatrix4fv",(void**)&glducktape_glUniformMatrix4fv))
-
- extern PFNGLUNMAPBUFFERPROC glducktape_glUnmapBuffer;
- #define glUnmapBuffer (glducktape_glUnmapBuffer? glducktape_glUnmapBuffer : (PFNGLUNMAPBUFFERPROC)glducktape_initProcAddress("glUnmapBuffer",(void**)&glducktape_glUnmapBuffer))
+typedef void (APIENTRYP glducktape_PFNGLBINDTEXTUREPROC)(GLenum target, GLuint texture);
+typedef void (APIENTRYP glducktape_PFNGLDELETETEXTURESPROC)(GLsizei n, const GLuint *textures);
+typedef void (APIENTRYP glducktape_PFNGLDRAWARRAYSPROC)(GLenum mode, GLint first, GLsizei count);
+typedef void (APIENTRYP glducktape_PFNGLDRAWELEMENTSPROC)(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices);
+typedef void (APIENTRYP glducktape_PFNGLGENTEXTURESPROC)(GLsizei n, GLuint *textures);
+typedef void (APIENTRYP glducktape_PFNGLPIXELSTOREIPROC)(GLenum pname, GLint param);
+typedef void (APIENTRYP glducktape_PFNGLTEXIMAGE2DPROC)(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels);
+typedef void (APIENTRYP glducktape_PFNGLTEXPARAMETERIPROC)(GLenum target, GLenum pname, GLint param);
+typedef void (APIENTRYP glducktape_PFNGLTEXSUBIMAGE2DPROC)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels);
 
+struct glducktape_dispatch {
+#ifdef GL_VERSION_1_1
+ glducktape_PFNGLBINDTEXTUREPROC BindTexture;
+ glducktape_PFNGLDELETETEXTURESPROC DeleteTextures;
+ glducktape_PFNGLDRAWARRAYSPROC DrawArrays;
+ glducktape_PFNGLDRAWELEMENTSPROC DrawElements;
+ glducktape_PFNGLGENTEXTURESPROC GenTextures;
+ glducktape_PFNGLPIXELSTOREIPROC PixelStorei;
+ glducktape_PFNGLTEXIMAGE2DPROC TexImage2D;
+ glducktape_PFNGLTEXPARAMETERIPROC TexParameteri;
+ glducktape_PFNGLTEXSUBIMAGE2DPROC TexSubImage2D;
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+ PFNGLDELETEQUERIESPROC DeleteQueries;
+ PFNGLGENQUERIESPROC GenQueries;
+ PFNGLGETQUERYOBJECTIVPROC GetQueryObjectiv;
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+ PFNGLATTACHSHADERPROC AttachShader;
+ PFNGLBINDBUFFERPROC BindBuffer;
+ PFNGLBUFFERDATAPROC BufferData;
+ PFNGLBUFFERSUBDATAPROC BufferSubData;
+ PFNGLCOMPILESHADERPROC CompileShader;
+ PFNGLCREATEPROGRAMPROC CreateProgram;
+ PFNGLCREATESHADERPROC CreateShader;
+ PFNGLDELETEBUFFERSPROC DeleteBuffers;
+ PFNGLDELETEPROGRAMPROC DeleteProgram;
+ PFNGLDELETESHADERPROC DeleteShader;
+ PFNGLDETACHSHADERPROC DetachShader;
+ PFNGLDISABLEVERTEXATTRIBARRAYPROC DisableVertexAttribArray;
+ PFNGLENABLEVERTEXATTRIBARRAYPROC EnableVertexAttribArray;
+ PFNGLGENBUFFERSPROC GenBuffers;
+ PFNGLGETACTIVEUNIFORMPROC GetActiveUniform;
+ PFNGLGETBUFFERPARAMETERIVPROC GetBufferParameteriv;
+ PFNGLGETPROGRAMIVPROC GetProgramiv;
+ PFNGLGETUNIFORMLOCATIONPROC GetUniformLocation;
+ PFNGLLINKPROGRAMPROC LinkProgram;
+ PFNGLMAPBUFFERPROC MapBuffer;
+ PFNGLSHADERSOURCEPROC ShaderSource;
+ PFNGLUNIFORM1FVPROC Uniform1fv;
+ PFNGLUNIFORM1IVPROC Uniform1iv;
+ PFNGLUNIFORM2FVPROC Uniform2fv;
+ PFNGLUNIFORM2IVPROC Uniform2iv;
+ PFNGLUNIFORM3FVPROC Uniform3fv;
+ PFNGLUNIFORM3IVPROC Uniform3iv;
+ PFNGLUNIFORM4FVPROC Uniform4fv;
+ PFNGLUNIFORM4IVPROC Uniform4iv;
+ PFNGLUNIFORMMATRIX2FVPROC UniformMatrix2fv;
+ PFNGLUNIFORMMATRIX3FVPROC UniformMatrix3fv;
+ PFNGLUNIFORMMATRIX4FVPROC UniformMatrix4fv;
+ PFNGLUNMAPBUFFERPROC UnmapBuffer;
+ PFNGLUSEPROGRAMPROC UseProgram;
+ PFNGLVERTEXATTRIBPOINTERPROC VertexAttribPointer;
 #endif /* GL_VERSION_2_0 */
 #ifdef GL_VERSION_2_1
- extern PFNGLUNIFORMMATRIX2X3FVPROC glducktape_glUniformMatrix2x3fv;
- #define glUniformMatrix2x3fv (glducktape_glUniformMatrix2x3fv? glducktape_glUniformMatrix2x3fv : (PFNGLUNIFORMMATRIX2X3FVPROC)glducktape_initProcAddress("glUniformMatrix2x3fv",(void**)&glducktape_glUniformMatrix2x3fv))
-
- extern PFNGLUNIFORMMATRIX2X4FVPROC glducktape_glUniformMatrix2x4fv;
- #define glUniformMatrix2x4fv (glducktape_glUniformMatrix2x4fv? glducktape_glUniformMatrix2x4fv : (PFNGLUNIFORMMATRIX2X4FVPROC)glducktape_initProcAddress("glUniformMatrix2x4fv",(void**)&glducktape_glUniformMatrix2x4fv))
-
- extern PFNGLUNIFORMMATRIX3X2FVPROC glducktape_glUniformMatrix3x2fv;
- #define glUniformMatrix3x2fv (glducktape_glUniformMatrix3x2fv? glducktape_glUniformMatrix3x2fv : (PFNGLUNIFORMMATRIX3X2FVPROC)glducktape_initProcAddress("glUniformMatrix3x2fv",(void**)&glducktape_glUniformMatrix3x2fv))
-
- extern PFNGLUNIFORMMATRIX3X4FVPROC glducktape_glUniformMatrix3x4fv;
- #define glUniformMatrix3x4fv (glducktape_glUniformMatrix3x4fv? glducktape_glUniformMatrix3x4fv : (PFNGLUNIFORMMATRIX3X4FVPROC)glducktape_initProcAddress("glUniformMatrix3x4fv",(void**)&glducktape_glUniformMatrix3x4fv))
-
- extern PFNGLUNIFORMMATRIX4X2FVPROC glducktape_glUniformMatrix4x2fv;
- #define glUniformMatrix4x2fv (glducktape_glUniformMatrix4x2fv? glducktape_glUniformMatrix4x2fv : (PFNGLUNIFORMMATRIX4X2FVPROC)glducktape_initProcAddress("glUniformMatrix4x2fv",(void**)&glducktape_glUniformMatrix4x2fv))
-
- extern PFNGLUNIFORMMATRIX4X3FVPROC glducktape_glUniformMatrix4x3fv;
- #define glUniformMatrix4x3fv (glducktape_glUniformMatrix4x3fv? glducktape_glUniformMatrix4x3fv : (PFNGLUNIFORMMATRIX4X3FVPROC)glducktape_initProcAddress("glUniformMatrix4x3fv",(void**)&glducktape_glUniformMatrix4x3fv))
-
+ PFNGLUNIFORMMATRIX2X3FVPROC UniformMatrix2x3fv;
+ PFNGLUNIFORMMATRIX2X4FVPROC UniformMatrix2x4fv;
+ PFNGLUNIFORMMATRIX3X2FVPROC UniformMatrix3x2fv;
+ PFNGLUNIFORMMATRIX3X4FVPROC UniformMatrix3x4fv;
+ PFNGLUNIFORMMATRIX4X2FVPROC UniformMatrix4x2fv;
+ PFNGLUNIFORMMATRIX4X3FVPROC UniformMatrix4x3fv;
 #endif /* GL_VERSION_2_1 */
 #ifdef GL_VERSION_3_0
- extern PFNGLDELETEVERTEXARRAYSPROC glducktape_glDeleteVertexArrays;
- #define glDeleteVertexArrays (glducktape_glDeleteVertexArrays? glducktape_glDeleteVertexArrays : (PFNGLDELETEVERTEXARRAYSPROC)glducktape_initProcAddress("glDeleteVertexArrays",(void**)&glducktape_glDeleteVertexArrays))
-
- extern PFNGLGENERATEMIPMAPPROC glducktape_glGenerateMipmap;
- #define glGenerateMipmap (glducktape_glGenerateMipmap? glducktape_glGenerateMipmap : (PFNGLGENERATEMIPMAPPROC)glducktape_initProcAddress("glGenerateMipmap",(void**)&glducktape_glGenerateMipmap))
-
- extern PFNGLGENVERTEXARRAYSPROC glducktape_glGenVertexArrays;
- #define glGenVertexArrays (glducktape_glGenVertexArrays? glducktape_glGenVertexArrays : (PFNGLGENVERTEXARRAYSPROC)glducktape_initProcAddress("glGenVertexArrays",(void**)&glducktape_glGenVertexArrays))
-
- extern PFNGLMAPBUFFERRANGEPROC glducktape_glMapBufferRange;
- #define glMapBufferRange (glducktape_glMapBufferRange? glducktape_glMapBufferRange : (PFNGLMAPBUFFERRANGEPROC)glducktape_initProcAddress("glMapBufferRange",(void**)&glducktape_glMapBufferRange))
-
- extern PFNGLUNIFORM1UIVPROC glducktape_glUniform1uiv;
- #define glUniform1uiv (glducktape_glUniform1uiv? glducktape_glUniform1uiv : (PFNGLUNIFORM1UIVPROC)glducktape_initProcAddress("glUniform1uiv",(void**)&glducktape_glUniform1uiv))
-
- extern PFNGLUNIFORM2UIVPROC glducktape_glUniform2uiv;
- #define glUniform2uiv (glducktape_glUniform2uiv? glducktape_glUniform2uiv : (PFNGLUNIFORM2UIVPROC)glducktape_initProcAddress("glUniform2uiv",(void**)&glducktape_glUniform2uiv))
-
- extern PFNGLUNIFORM3UIVPROC glducktape_glUniform3uiv;
- #define glUniform3uiv (glducktape_glUniform3uiv? glducktape_glUniform3uiv : (PFNGLUNIFORM3UIVPROC)glducktape_initProcAddress("glUniform3uiv",(void**)&glducktape_glUniform3uiv))
-
- extern PFNGLUNIFORM4UIVPROC glducktape_glUniform4uiv;
- #define glUniform4uiv (glducktape_glUniform4uiv? glducktape_glUniform4uiv : (PFNGLUNIFORM4UIVPROC)glducktape_initProcAddress("glUniform4uiv",(void**)&glducktape_glUniform4uiv))
+ PFNGLBINDVERTEXARRAYPROC BindVertexArray;
+ PFNGLDELETEVERTEXARRAYSPROC DeleteVertexArrays;
+ PFNGLGENVERTEXARRAYSPROC GenVertexArrays;
+ PFNGLGENERATEMIPMAPPROC GenerateMipmap;
+ PFNGLGETSTRINGIPROC GetStringi;
+ PFNGLMAPBUFFERRANGEPROC MapBufferRange;
+ PFNGLUNIFORM1UIVPROC Uniform1uiv;
+ PFNGLUNIFORM2UIVPROC Uniform2uiv;
+ PFNGLUNIFORM3UIVPROC Uniform3uiv;
+ PFNGLUNIFORM4UIVPROC Uniform4uiv;
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+ PFNGLCLIENTWAITSYNCPROC ClientWaitSync;
+ PFNGLDELETESYNCPROC DeleteSync;
+ PFNGLFENCESYNCPROC FenceSync;
+ PFNGLGETINTEGER64VPROC GetInteger64v;
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+ PFNGLGETQUERYOBJECTUI64VPROC GetQueryObjectui64v;
+ PFNGLQUERYCOUNTERPROC QueryCounter;
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+ PFNGLUNIFORM1DVPROC Uniform1dv;
+ PFNGLUNIFORM2DVPROC Uniform2dv;
+ PFNGLUNIFORM3DVPROC Uniform3dv;
+ PFNGLUNIFORM4DVPROC Uniform4dv;
+ PFNGLUNIFORMMATRIX2DVPROC UniformMatrix2dv;
+ PFNGLUNIFORMMATRIX2X3DVPROC UniformMatrix2x3dv;
+ PFNGLUNIFORMMATRIX2X4DVPROC UniformMatrix2x4dv;
+ PFNGLUNIFORMMATRIX3DVPROC UniformMatrix3dv;
+ PFNGLUNIFORMMATRIX3X2DVPROC UniformMatrix3x2dv;
+ PFNGLUNIFORMMATRIX3X4DVPROC UniformMatrix3x4dv;
+ PFNGLUNIFORMMATRIX4DVPROC UniformMatrix4dv;
+ PFNGLUNIFORMMATRIX4X2DVPROC UniformMatrix4x2dv;
+ PFNGLUNIFORMMATRIX4X3DVPROC UniformMatrix4x3dv;
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+ PFNGLPROGRAMUNIFORM1DVPROC ProgramUniform1dv;
+ PFNGLPROGRAMUNIFORM1FVPROC ProgramUniform1fv;
+ PFNGLPROGRAMUNIFORM1IVPROC ProgramUniform1iv;
+ PFNGLPROGRAMUNIFORM1UIVPROC ProgramUniform1uiv;
+ PFNGLPROGRAMUNIFORM2DVPROC ProgramUniform2dv;
+ PFNGLPROGRAMUNIFORM2FVPROC ProgramUniform2fv;
+ PFNGLPROGRAMUNIFORM2IVPROC ProgramUniform2iv;
+ PFNGLPROGRAMUNIFORM2UIVPROC ProgramUniform2uiv;
+ PFNGLPROGRAMUNIFORM3DVPROC ProgramUniform3dv;
+ PFNGLPROGRAMUNIFORM3FVPROC ProgramUniform3fv;
+ PFNGLPROGRAMUNIFORM3IVPROC ProgramUniform3iv;
+ PFNGLPROGRAMUNIFORM3UIVPROC ProgramUniform3uiv;
+ PFNGLPROGRAMUNIFORM4DVPROC ProgramUniform4dv;
+ PFNGLPROGRAMUNIFORM4FVPROC ProgramUniform4fv;
+ PFNGLPROGRAMUNIFORM4IVPROC ProgramUniform4iv;
+ PFNGLPROGRAMUNIFORM4UIVPROC ProgramUniform4uiv;
+ PFNGLPROGRAMUNIFORMMATRIX2DVPROC ProgramUniformMatrix2dv;
+ PFNGLPROGRAMUNIFORMMATRIX2FVPROC ProgramUniformMatrix2fv;
+ PFNGLPROGRAMUNIFORMMATRIX2X3DVPROC ProgramUniformMatrix2x3dv;
+ PFNGLPROGRAMUNIFORMMATRIX2X3FVPROC ProgramUniformMatrix2x3fv;
+ PFNGLPROGRAMUNIFORMMATRIX2X4DVPROC ProgramUniformMatrix2x4dv;
+ PFNGLPROGRAMUNIFORMMATRIX2X4FVPROC ProgramUniformMatrix2x4fv;
+ PFNGLPROGRAMUNIFORMMATRIX3DVPROC ProgramUniformMatrix3dv;
+ PFNGLPROGRAMUNIFORMMATRIX3FVPROC ProgramUniformMatrix3fv;
+ PFNGLPROGRAMUNIFORMMATRIX3X2DVPROC ProgramUniformMatrix3x2dv;
+ PFNGLPROGRAMUNIFORMMATRIX3X2FVPROC ProgramUniformMatrix3x2fv;
+ PFNGLPROGRAMUNIFORMMATRIX3X4DVPROC ProgramUniformMatrix3x4dv;
+ PFNGLPROGRAMUNIFORMMATRIX3X4FVPROC ProgramUniformMatrix3x4fv;
+ PFNGLPROGRAMUNIFORMMATRIX4DVPROC ProgramUniformMatrix4dv;
+ PFNGLPROGRAMUNIFORMMATRIX4FVPROC ProgramUniformMatrix4fv;
+ PFNGLPROGRAMUNIFORMMATRIX4X2DVPROC ProgramUniformMatrix4x2dv;
+ PFNGLPROGRAMUNIFORMMATRIX4X2FVPROC ProgramUniformMatrix4x2fv;
+ PFNGLPROGRAMUNIFORMMATRIX4X3DVPROC ProgramUniformMatrix4x3dv;
+ PFNGLPROGRAMUNIFORMMATRIX4X3FVPROC ProgramUniformMatrix4x3fv;
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+ PFNGLDEBUGMESSAGECALLBACKPROC DebugMessageCallback;
+ PFNGLDEBUGMESSAGECONTROLPROC DebugMessageControl;
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+ PFNGLGETNAMEDBUFFERPARAMETERIVPROC GetNamedBufferParameteriv;
+ PFNGLMAPNAMEDBUFFERRANGEPROC MapNamedBufferRange;
+ PFNGLUNMAPNAMEDBUFFERPROC UnmapNamedBuffer;
+#endif /* GL_VERSION_4_5 */
+ int unused; /* in case no version is defined */
+};
+extern struct glducktape_dispatch *glducktape_current;
+extern void glducktape_init(struct glducktape_dispatch *table);
+extern void glducktape_use(struct glducktape_dispatch *table);
+extern int glducktape_resolve(struct glducktape_dispatch *table, int gl_major, int gl_minor,
+	void (*on_missing)(const char *name, void *ctx), void *ctx);
+extern void* glducktape_initProcAddress(const char *name, void **fnptr);
+extern void glducktape_set_loader(void* (*loader)(const char *name));
 
+/* Profiling */
+enum glducktape_fn_index {
+#ifdef GL_VERSION_1_1
+ glducktape_idx_glBindTexture,
+ glducktape_idx_glDeleteTextures,
+ glducktape_idx_glDrawArrays,
+ glducktape_idx_glDrawElements,
+ glducktape_idx_glGenTextures,
+ glducktape_idx_glPixelStorei,
+ glducktape_idx_glTexImage2D,
+ glducktape_idx_glTexParameteri,
+ glducktape_idx_glTexSubImage2D,
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+ glducktape_idx_glDeleteQueries,
+ glducktape_idx_glGenQueries,
+ glducktape_idx_glGetQueryObjectiv,
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+ glducktape_idx_glAttachShader,
+ glducktape_idx_glBindBuffer,
+ glducktape_idx_glBufferData,
+ glducktape_idx_glBufferSubData,
+ glducktape_idx_glCompileShader,
+ glducktape_idx_glCreateProgram,
+ glducktape_idx_glCreateShader,
+ glducktape_idx_glDeleteBuffers,
+ glducktape_idx_glDeleteProgram,
+ glducktape_idx_glDeleteShader,
+ glducktape_idx_glDetachShader,
+ glducktape_idx_glDisableVertexAttribArray,
+ glducktape_idx_glEnableVertexAttribArray,
+ glducktape_idx_glGenBuffers,
+ glducktape_idx_glGetActiveUniform,
+ glducktape_idx_glGetBufferParameteriv,
+ glducktape_idx_glGetProgramiv,
+ glducktape_idx_glGetUniformLocation,
+ glducktape_idx_glLinkProgram,
+ glducktape_idx_glMapBuffer,
+ glducktape_idx_glShaderSource,
+ glducktape_idx_glUniform1fv,
+ glducktape_idx_glUniform1iv,
+ glducktape_idx_glUniform2fv,
+ glducktape_idx_glUniform2iv,
+ glducktape_idx_glUniform3fv,
+ glducktape_idx_glUniform3iv,
+ glducktape_idx_glUniform4fv,
+ glducktape_idx_glUniform4iv,
+ glducktape_idx_glUniformMatrix2fv,
+ glducktape_idx_glUniformMatrix3fv,
+ glducktape_idx_glUniformMatrix4fv,
+ glducktape_idx_glUnmapBuffer,
+ glducktape_idx_glUseProgram,
+ glducktape_idx_glVertexAttribPointer,
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+ glducktape_idx_glUniformMatrix2x3fv,
+ glducktape_idx_glUniformMatrix2x4fv,
+ glducktape_idx_glUniformMatrix3x2fv,
+ glducktape_idx_glUniformMatrix3x4fv,
+ glducktape_idx_glUniformMatrix4x2fv,
+ glducktape_idx_glUniformMatrix4x3fv,
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+ glducktape_idx_glBindVertexArray,
+ glducktape_idx_glDeleteVertexArrays,
+ glducktape_idx_glGenVertexArrays,
+ glducktape_idx_glGenerateMipmap,
+ glducktape_idx_glGetStringi,
+ glducktape_idx_glMapBufferRange,
+ glducktape_idx_glUniform1uiv,
+ glducktape_idx_glUniform2uiv,
+ glducktape_idx_glUniform3uiv,
+ glducktape_idx_glUniform4uiv,
 #endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+ glducktape_idx_glClientWaitSync,
+ glducktape_idx_glDeleteSync,
+ glducktape_idx_glFenceSync,
+ glducktape_idx_glGetInteger64v,
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+ glducktape_idx_glGetQueryObjectui64v,
+ glducktape_idx_glQueryCounter,
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+ glducktape_idx_glUniform1dv,
+ glducktape_idx_glUniform2dv,
+ glducktape_idx_glUniform3dv,
+ glducktape_idx_glUniform4dv,
+ glducktape_idx_glUniformMatrix2dv,
+ glducktape_idx_glUniformMatrix2x3dv,
+ glducktape_idx_glUniformMatrix2x4dv,
+ glducktape_idx_glUniformMatrix3dv,
+ glducktape_idx_glUniformMatrix3x2dv,
+ glducktape_idx_glUniformMatrix3x4dv,
+ glducktape_idx_glUniformMatrix4dv,
+ glducktape_idx_glUniformMatrix4x2dv,
+ glducktape_idx_glUniformMatrix4x3dv,
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+ glducktape_idx_glProgramUniform1dv,
+ glducktape_idx_glProgramUniform1fv,
+ glducktape_idx_glProgramUniform1iv,
+ glducktape_idx_glProgramUniform1uiv,
+ glducktape_idx_glProgramUniform2dv,
+ glducktape_idx_glProgramUniform2fv,
+ glducktape_idx_glProgramUniform2iv,
+ glducktape_idx_glProgramUniform2uiv,
+ glducktape_idx_glProgramUniform3dv,
+ glducktape_idx_glProgramUniform3fv,
+ glducktape_idx_glProgramUniform3iv,
+ glducktape_idx_glProgramUniform3uiv,
+ glducktape_idx_glProgramUniform4dv,
+ glducktape_idx_glProgramUniform4fv,
+ glducktape_idx_glProgramUniform4iv,
+ glducktape_idx_glProgramUniform4uiv,
+ glducktape_idx_glProgramUniformMatrix2dv,
+ glducktape_idx_glProgramUniformMatrix2fv,
+ glducktape_idx_glProgramUniformMatrix2x3dv,
+ glducktape_idx_glProgramUniformMatrix2x3fv,
+ glducktape_idx_glProgramUniformMatrix2x4dv,
+ glducktape_idx_glProgramUniformMatrix2x4fv,
+ glducktape_idx_glProgramUniformMatrix3dv,
+ glducktape_idx_glProgramUniformMatrix3fv,
+ glducktape_idx_glProgramUniformMatrix3x2dv,
+ glducktape_idx_glProgramUniformMatrix3x2fv,
+ glducktape_idx_glProgramUniformMatrix3x4dv,
+ glducktape_idx_glProgramUniformMatrix3x4fv,
+ glducktape_idx_glProgramUniformMatrix4dv,
+ glducktape_idx_glProgramUniformMatrix4fv,
+ glducktape_idx_glProgramUniformMatrix4x2dv,
+ glducktape_idx_glProgramUniformMatrix4x2fv,
+ glducktape_idx_glProgramUniformMatrix4x3dv,
+ glducktape_idx_glProgramUniformMatrix4x3fv,
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+ glducktape_idx_glDebugMessageCallback,
+ glducktape_idx_glDebugMessageControl,
+#endif /* GL_VERSION_4_3 */
 #ifdef GL_VERSION_4_5
- extern PFNGLGETNAMEDBUFFERPARAMETERIVPROC glducktape_glGetNamedBufferParameteriv;
- #define glGetNamedBufferParameteriv (glducktape_glGetNamedBufferParameteriv? glducktape_glGetNamedBufferParameteriv : (PFNGLGETNAMEDBUFFERPARAMETERIVPROC)glducktape_initProcAddress("glGetNamedBufferParameteriv",(void**)&glducktape_glGetNamedBufferParameteriv))
+ glducktape_idx_glGetNamedBufferParameteriv,
+ glducktape_idx_glMapNamedBufferRange,
+ glducktape_idx_glUnmapNamedBuffer,
+#endif /* GL_VERSION_4_5 */
+ glducktape_fn_count
+};
+struct glducktape_stat { unsigned long long calls, ns; };
+struct glducktape_scope {
+	const char *name;
+	struct glducktape_stat total, gl; /* the whole function, and the GL calls made inside it */
+	struct glducktape_scope *next, *outer;
+	int registered;
+};
+extern int glducktape_profiling;
+extern const char *glducktape_names[];
+extern struct glducktape_stat glducktape_stats[];
+extern struct glducktape_scope *glducktape_scopes;
+extern struct glducktape_scope *glducktape_cur_scope; /* innermost; save it around non-local exits */
+extern void glducktape_profile(int enable);
+extern void glducktape_profile_reset(void);
+extern unsigned long long glducktape_now_ns(void);
+extern unsigned long long glducktape_scope_enter(struct glducktape_scope *scope);
+extern void glducktape_scope_leave(struct glducktape_scope *scope, unsigned long long t0);
 
- extern PFNGLMAPNAMEDBUFFERRANGEPROC glducktape_glMapNamedBufferRange;
- #define glMapNamedBufferRange (glducktape_glMapNamedBufferRange? glducktape_glMapNamedBufferRange : (PFNGLMAPNAMEDBUFFERRANGEPROC)glducktape_initProcAddress("glMapNamedBufferRange",(void**)&glducktape_glMapNamedBufferRange))
+/* Capture and replay */
+extern int glducktape_capturing;
+extern int glducktape_capture_start(const char *path);
+extern void glducktape_capture_frame(void);
+extern int glducktape_capture_stop(void);
+#ifdef GLDUCKTAPE_REPLAYER
+extern int glducktape_replay_call(int idx, const unsigned char *body, size_t len);
+#endif
 
- extern PFNGLUNMAPNAMEDBUFFERPROC glducktape_glUnmapNamedBuffer;
- #define glUnmapNamedBuffer (glducktape_glUnmapNamedBuffer? glducktape_glUnmapNamedBuffer : (PFNGLUNMAPNAMEDBUFFERPROC)glducktape_initProcAddress("glUnmapNamedBuffer",(void**)&glducktape_glUnmapNamedBuffer))
+#ifdef GL_VERSION_1_1
+ #define glBindTexture (glducktape_current->BindTexture)
+ #define glDeleteTextures (glducktape_current->DeleteTextures)
+ #define glDrawArrays (glducktape_current->DrawArrays)
+ #define glDrawElements (glducktape_current->DrawElements)
+ #define glGenTextures (glducktape_current->GenTextures)
+ #define glPixelStorei (glducktape_current->PixelStorei)
+ #define glTexImage2D (glducktape_current->TexImage2D)
+ #define glTexParameteri (glducktape_current->TexParameteri)
+ #define glTexSubImage2D (glducktape_current->TexSubImage2D)
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+ #define glDeleteQueries (glducktape_current->DeleteQueries)
+ #define glGenQueries (glducktape_current->GenQueries)
+ #define glGetQueryObjectiv (glducktape_current->GetQueryObjectiv)
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+ #define glAttachShader (glducktape_current->AttachShader)
+ #define glBindBuffer (glducktape_current->BindBuffer)
+ #define glBufferData (glducktape_current->BufferData)
+ #define glBufferSubData (glducktape_current->BufferSubData)
+ #define glCompileShader (glducktape_current->CompileShader)
+ #define glCreateProgram (glducktape_current->CreateProgram)
+ #define glCreateShader (glducktape_current->CreateShader)
+ #define glDeleteBuffers (glducktape_current->DeleteBuffers)
+ #define glDeleteProgram (glducktape_current->DeleteProgram)
+ #define glDeleteShader (glducktape_current->DeleteShader)
+ #define glDetachShader (glducktape_current->DetachShader)
+ #define glDisableVertexAttribArray (glducktape_current->DisableVertexAttribArray)
+ #define glEnableVertexAttribArray (glducktape_current->EnableVertexAttribArray)
+ #define glGenBuffers (glducktape_current->GenBuffers)
+ #define glGetActiveUniform (glducktape_current->GetActiveUniform)
+ #define glGetBufferParameteriv (glducktape_current->GetBufferParameteriv)
+ #define glGetProgramiv (glducktape_current->GetProgramiv)
+ #define glGetUniformLocation (glducktape_current->GetUniformLocation)
+ #define glLinkProgram (glducktape_current->LinkProgram)
+ #define glMapBuffer (glducktape_current->MapBuffer)
+ #define glShaderSource (glducktape_current->ShaderSource)
+ #define glUniform1fv (glducktape_current->Uniform1fv)
+ #define glUniform1iv (glducktape_current->Uniform1iv)
+ #define glUniform2fv (glducktape_current->Uniform2fv)
+ #define glUniform2iv (glducktape_current->Uniform2iv)
+ #define glUniform3fv (glducktape_current->Uniform3fv)
+ #define glUniform3iv (glducktape_current->Uniform3iv)
+ #define glUniform4fv (glducktape_current->Uniform4fv)
+ #define glUniform4iv (glducktape_current->Uniform4iv)
+ #define glUniformMatrix2fv (glducktape_current->UniformMatrix2fv)
+ #define glUniformMatrix3fv (glducktape_current->UniformMatrix3fv)
+ #define glUniformMatrix4fv (glducktape_current->UniformMatrix4fv)
+ #define glUnmapBuffer (glducktape_current->UnmapBuffer)
+ #define glUseProgram (glducktape_current->UseProgram)
+ #define glVertexAttribPointer (glducktape_current->VertexAttribPointer)
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+ #define glUniformMatrix2x3fv (glducktape_current->UniformMatrix2x3fv)
+ #define glUniformMatrix2x4fv (glducktape_current->UniformMatrix2x4fv)
+ #define glUniformMatrix3x2fv (glducktape_current->UniformMatrix3x2fv)
+ #define glUniformMatrix3x4fv (glducktape_current->UniformMatrix3x4fv)
+ #define glUniformMatrix4x2fv (glducktape_current->UniformMatrix4x2fv)
+ #define glUniformMatrix4x3fv (glducktape_current->UniformMatrix4x3fv)
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+ #define glBindVertexArray (glducktape_current->BindVertexArray)
+ #define glDeleteVertexArrays (glducktape_current->DeleteVertexArrays)
+ #define glGenVertexArrays (glducktape_current->GenVertexArrays)
+ #define glGenerateMipmap (glducktape_current->GenerateMipmap)
+ #define glGetStringi (glducktape_current->GetStringi)
+ #define glMapBufferRange (glducktape_current->MapBufferRange)
+ #define glUniform1uiv (glducktape_current->Uniform1uiv)
+ #define glUniform2uiv (glducktape_current->Uniform2uiv)
+ #define glUniform3uiv (glducktape_current->Uniform3uiv)
+ #define glUniform4uiv (glducktape_current->Uniform4uiv)
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+ #define glClientWaitSync (glducktape_current->ClientWaitSync)
+ #define glDeleteSync (glducktape_current->DeleteSync)
+ #define glFenceSync (glducktape_current->FenceSync)
+ #define glGetInteger64v (glducktape_current->GetInteger64v)
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+ #define glGetQueryObjectui64v (glducktape_current->GetQueryObjectui64v)
+ #define glQueryCounter (glducktape_current->QueryCounter)
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+ #define glUniform1dv (glducktape_current->Uniform1dv)
+ #define glUniform2dv (glducktape_current->Uniform2dv)
+ #define glUniform3dv (glducktape_current->Uniform3dv)
+ #define glUniform4dv (glducktape_current->Uniform4dv)
+ #define glUniformMatrix2dv (glducktape_current->UniformMatrix2dv)
+ #define glUniformMatrix2x3dv (glducktape_current->UniformMatrix2x3dv)
+ #define glUniformMatrix2x4dv (glducktape_current->UniformMatrix2x4dv)
+ #define glUniformMatrix3dv (glducktape_current->UniformMatrix3dv)
+ #define glUniformMatrix3x2dv (glducktape_current->UniformMatrix3x2dv)
+ #define glUniformMatrix3x4dv (glducktape_current->UniformMatrix3x4dv)
+ #define glUniformMatrix4dv (glducktape_current->UniformMatrix4dv)
+ #define glUniformMatrix4x2dv (glducktape_current->UniformMatrix4x2dv)
+ #define glUniformMatrix4x3dv (glducktape_current->UniformMatrix4x3dv)
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+ #define glProgramUniform1dv (glducktape_current->ProgramUniform1dv)
+ #define glProgramUniform1fv (glducktape_current->ProgramUniform1fv)
+ #define glProgramUniform1iv (glducktape_current->ProgramUniform1iv)
+ #define glProgramUniform1uiv (glducktape_current->ProgramUniform1uiv)
+ #define glProgramUniform2dv (glducktape_current->ProgramUniform2dv)
+ #define glProgramUniform2fv (glducktape_current->ProgramUniform2fv)
+ #define glProgramUniform2iv (glducktape_current->ProgramUniform2iv)
+ #define glProgramUniform2uiv (glducktape_current->ProgramUniform2uiv)
+ #define glProgramUniform3dv (glducktape_current->ProgramUniform3dv)
+ #define glProgramUniform3fv (glducktape_current->ProgramUniform3fv)
+ #define glProgramUniform3iv (glducktape_current->ProgramUniform3iv)
+ #define glProgramUniform3uiv (glducktape_current->ProgramUniform3uiv)
+ #define glProgramUniform4dv (glducktape_current->ProgramUniform4dv)
+ #define glProgramUniform4fv (glducktape_current->ProgramUniform4fv)
+ #define glProgramUniform4iv (glducktape_current->ProgramUniform4iv)
+ #define glProgramUniform4uiv (glducktape_current->ProgramUniform4uiv)
+ #define glProgramUniformMatrix2dv (glducktape_current->ProgramUniformMatrix2dv)
+ #define glProgramUniformMatrix2fv (glducktape_current->ProgramUniformMatrix2fv)
+ #define glProgramUniformMatrix2x3dv (glducktape_current->ProgramUniformMatrix2x3dv)
+ #define glProgramUniformMatrix2x3fv (glducktape_current->ProgramUniformMatrix2x3fv)
+ #define glProgramUniformMatrix2x4dv (glducktape_current->ProgramUniformMatrix2x4dv)
+ #define glProgramUniformMatrix2x4fv (glducktape_current->ProgramUniformMatrix2x4fv)
+ #define glProgramUniformMatrix3dv (glducktape_current->ProgramUniformMatrix3dv)
+ #define glProgramUniformMatrix3fv (glducktape_current->ProgramUniformMatrix3fv)
+ #define glProgramUniformMatrix3x2dv (glducktape_current->ProgramUniformMatrix3x2dv)
+ #define glProgramUniformMatrix3x2fv (glducktape_current->ProgramUniformMatrix3x2fv)
+ #define glProgramUniformMatrix3x4dv (glducktape_current->ProgramUniformMatrix3x4dv)
+ #define glProgramUniformMatrix3x4fv (glducktape_current->ProgramUniformMatrix3x4fv)
+ #define glProgramUniformMatrix4dv (glducktape_current->ProgramUniformMatrix4dv)
+ #define glProgramUniformMatrix4fv (glducktape_current->ProgramUniformMatrix4fv)
+ #define glProgramUniformMatrix4x2dv (glducktape_current->ProgramUniformMatrix4x2dv)
+ #define glProgramUniformMatrix4x2fv (glducktape_current->ProgramUniformMatrix4x2fv)
+ #define glProgramUniformMatrix4x3dv (glducktape_current->ProgramUniformMatrix4x3dv)
+ #define glProgramUniformMatrix4x3fv (glducktape_current->ProgramUniformMatrix4x3fv)
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+ #define glDebugMessageCallback (glducktape_current->DebugMessageCallback)
+ #define glDebugMessageControl (glducktape_current->DebugMessageControl)
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+ #define glGetNamedBufferParameteriv (glducktape_current->GetNamedBufferParameteriv)
+ #define glMapNamedBufferRange (glducktape_current->MapNamedBufferRange)
+ #define glUnmapNamedBuffer (glducktape_current->UnmapNamedBuffer)
+#endif /* GL_VERSION_4_5 */
 
+static struct glducktape_dispatch glducktape_lazy;
+#ifdef GL_VERSION_1_1
+static void APIENTRY glducktape_stub_glBindTexture(GLenum target, GLuint texture) {
+	((glducktape_PFNGLBINDTEXTUREPROC)glducktape_initProcAddress("glBindTexture", (void**) &glducktape_lazy.BindTexture))(target, texture);
+}
+static void APIENTRY glducktape_stub_glDeleteTextures(GLsizei n, const GLuint *textures) {
+	((glducktape_PFNGLDELETETEXTURESPROC)glducktape_initProcAddress("glDeleteTextures", (void**) &glducktape_lazy.DeleteTextures))(n, textures);
+}
+static void APIENTRY glducktape_stub_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+	((glducktape_PFNGLDRAWARRAYSPROC)glducktape_initProcAddress("glDrawArrays", (void**) &glducktape_lazy.DrawArrays))(mode, first, count);
+}
+static void APIENTRY glducktape_stub_glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices) {
+	((glducktape_PFNGLDRAWELEMENTSPROC)glducktape_initProcAddress("glDrawElements", (void**) &glducktape_lazy.DrawElements))(mode, count, type, indices);
+}
+static void APIENTRY glducktape_stub_glGenTextures(GLsizei n, GLuint *textures) {
+	((glducktape_PFNGLGENTEXTURESPROC)glducktape_initProcAddress("glGenTextures", (void**) &glducktape_lazy.GenTextures))(n, textures);
+}
+static void APIENTRY glducktape_stub_glPixelStorei(GLenum pname, GLint param) {
+	((glducktape_PFNGLPIXELSTOREIPROC)glducktape_initProcAddress("glPixelStorei", (void**) &glducktape_lazy.PixelStorei))(pname, param);
+}
+static void APIENTRY glducktape_stub_glTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels) {
+	((glducktape_PFNGLTEXIMAGE2DPROC)glducktape_initProcAddress("glTexImage2D", (void**) &glducktape_lazy.TexImage2D))(target, level, internalFormat, width, height, border, format, type, pixels);
+}
+static void APIENTRY glducktape_stub_glTexParameteri(GLenum target, GLenum pname, GLint param) {
+	((glducktape_PFNGLTEXPARAMETERIPROC)glducktape_initProcAddress("glTexParameteri", (void**) &glducktape_lazy.TexParameteri))(target, pname, param);
+}
+static void APIENTRY glducktape_stub_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels) {
+	((glducktape_PFNGLTEXSUBIMAGE2DPROC)glducktape_initProcAddress("glTexSubImage2D", (void**) &glducktape_lazy.TexSubImage2D))(target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+static void APIENTRY glducktape_stub_glDeleteQueries(GLsizei n, const GLuint *ids) {
+	((PFNGLDELETEQUERIESPROC)glducktape_initProcAddress("glDeleteQueries", (void**) &glducktape_lazy.DeleteQueries))(n, ids);
+}
+static void APIENTRY glducktape_stub_glGenQueries(GLsizei n, GLuint *ids) {
+	((PFNGLGENQUERIESPROC)glducktape_initProcAddress("glGenQueries", (void**) &glducktape_lazy.GenQueries))(n, ids);
+}
+static void APIENTRY glducktape_stub_glGetQueryObjectiv(GLuint id, GLenum pname, GLint *params) {
+	((PFNGLGETQUERYOBJECTIVPROC)glducktape_initProcAddress("glGetQueryObjectiv", (void**) &glducktape_lazy.GetQueryObjectiv))(id, pname, params);
+}
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+static void APIENTRY glducktape_stub_glAttachShader(GLuint program, GLuint shader) {
+	((PFNGLATTACHSHADERPROC)glducktape_initProcAddress("glAttachShader", (void**) &glducktape_lazy.AttachShader))(program, shader);
+}
+static void APIENTRY glducktape_stub_glBindBuffer(GLenum target, GLuint buffer) {
+	((PFNGLBINDBUFFERPROC)glducktape_initProcAddress("glBindBuffer", (void**) &glducktape_lazy.BindBuffer))(target, buffer);
+}
+static void APIENTRY glducktape_stub_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+	((PFNGLBUFFERDATAPROC)glducktape_initProcAddress("glBufferData", (void**) &glducktape_lazy.BufferData))(target, size, data, usage);
+}
+static void APIENTRY glducktape_stub_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+	((PFNGLBUFFERSUBDATAPROC)glducktape_initProcAddress("glBufferSubData", (void**) &glducktape_lazy.BufferSubData))(target, offset, size, data);
+}
+static void APIENTRY glducktape_stub_glCompileShader(GLuint shader) {
+	((PFNGLCOMPILESHADERPROC)glducktape_initProcAddress("glCompileShader", (void**) &glducktape_lazy.CompileShader))(shader);
+}
+static GLuint APIENTRY glducktape_stub_glCreateProgram(void) {
+	return ((PFNGLCREATEPROGRAMPROC)glducktape_initProcAddress("glCreateProgram", (void**) &glducktape_lazy.CreateProgram))();
+}
+static GLuint APIENTRY glducktape_stub_glCreateShader(GLenum type) {
+	return ((PFNGLCREATESHADERPROC)glducktape_initProcAddress("glCreateShader", (void**) &glducktape_lazy.CreateShader))(type);
+}
+static void APIENTRY glducktape_stub_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
+	((PFNGLDELETEBUFFERSPROC)glducktape_initProcAddress("glDeleteBuffers", (void**) &glducktape_lazy.DeleteBuffers))(n, buffers);
+}
+static void APIENTRY glducktape_stub_glDeleteProgram(GLuint program) {
+	((PFNGLDELETEPROGRAMPROC)glducktape_initProcAddress("glDeleteProgram", (void**) &glducktape_lazy.DeleteProgram))(program);
+}
+static void APIENTRY glducktape_stub_glDeleteShader(GLuint shader) {
+	((PFNGLDELETESHADERPROC)glducktape_initProcAddress("glDeleteShader", (void**) &glducktape_lazy.DeleteShader))(shader);
+}
+static void APIENTRY glducktape_stub_glDetachShader(GLuint program, GLuint shader) {
+	((PFNGLDETACHSHADERPROC)glducktape_initProcAddress("glDetachShader", (void**) &glducktape_lazy.DetachShader))(program, shader);
+}
+static void APIENTRY glducktape_stub_glDisableVertexAttribArray(GLuint index) {
+	((PFNGLDISABLEVERTEXATTRIBARRAYPROC)glducktape_initProcAddress("glDisableVertexAttribArray", (void**) &glducktape_lazy.DisableVertexAttribArray))(index);
+}
+static void APIENTRY glducktape_stub_glEnableVertexAttribArray(GLuint index) {
+	((PFNGLENABLEVERTEXATTRIBARRAYPROC)glducktape_initProcAddress("glEnableVertexAttribArray", (void**) &glducktape_lazy.EnableVertexAttribArray))(index);
+}
+static void APIENTRY glducktape_stub_glGenBuffers(GLsizei n, GLuint *buffers) {
+	((PFNGLGENBUFFERSPROC)glducktape_initProcAddress("glGenBuffers", (void**) &glducktape_lazy.GenBuffers))(n, buffers);
+}
+static void APIENTRY glducktape_stub_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+	((PFNGLGETACTIVEUNIFORMPROC)glducktape_initProcAddress("glGetActiveUniform", (void**) &glducktape_lazy.GetActiveUniform))(program, index, bufSize, length, size, type, name);
+}
+static void APIENTRY glducktape_stub_glGetBufferParameteriv(GLenum target, GLenum pname, GLint *params) {
+	((PFNGLGETBUFFERPARAMETERIVPROC)glducktape_initProcAddress("glGetBufferParameteriv", (void**) &glducktape_lazy.GetBufferParameteriv))(target, pname, params);
+}
+static void APIENTRY glducktape_stub_glGetProgramiv(GLuint program, GLenum pname, GLint *params) {
+	((PFNGLGETPROGRAMIVPROC)glducktape_initProcAddress("glGetProgramiv", (void**) &glducktape_lazy.GetProgramiv))(program, pname, params);
+}
+static GLint APIENTRY glducktape_stub_glGetUniformLocation(GLuint program, const GLchar *name) {
+	return ((PFNGLGETUNIFORMLOCATIONPROC)glducktape_initProcAddress("glGetUniformLocation", (void**) &glducktape_lazy.GetUniformLocation))(program, name);
+}
+static void APIENTRY glducktape_stub_glLinkProgram(GLuint program) {
+	((PFNGLLINKPROGRAMPROC)glducktape_initProcAddress("glLinkProgram", (void**) &glducktape_lazy.LinkProgram))(program);
+}
+static void * APIENTRY glducktape_stub_glMapBuffer(GLenum target, GLenum access) {
+	return ((PFNGLMAPBUFFERPROC)glducktape_initProcAddress("glMapBuffer", (void**) &glducktape_lazy.MapBuffer))(target, access);
+}
+static void APIENTRY glducktape_stub_glShaderSource(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length) {
+	((PFNGLSHADERSOURCEPROC)glducktape_initProcAddress("glShaderSource", (void**) &glducktape_lazy.ShaderSource))(shader, count, string, length);
+}
+static void APIENTRY glducktape_stub_glUniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+	((PFNGLUNIFORM1FVPROC)glducktape_initProcAddress("glUniform1fv", (void**) &glducktape_lazy.Uniform1fv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform1iv(GLint location, GLsizei count, const GLint *value) {
+	((PFNGLUNIFORM1IVPROC)glducktape_initProcAddress("glUniform1iv", (void**) &glducktape_lazy.Uniform1iv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+	((PFNGLUNIFORM2FVPROC)glducktape_initProcAddress("glUniform2fv", (void**) &glducktape_lazy.Uniform2fv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform2iv(GLint location, GLsizei count, const GLint *value) {
+	((PFNGLUNIFORM2IVPROC)glducktape_initProcAddress("glUniform2iv", (void**) &glducktape_lazy.Uniform2iv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+	((PFNGLUNIFORM3FVPROC)glducktape_initProcAddress("glUniform3fv", (void**) &glducktape_lazy.Uniform3fv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform3iv(GLint location, GLsizei count, const GLint *value) {
+	((PFNGLUNIFORM3IVPROC)glducktape_initProcAddress("glUniform3iv", (void**) &glducktape_lazy.Uniform3iv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+	((PFNGLUNIFORM4FVPROC)glducktape_initProcAddress("glUniform4fv", (void**) &glducktape_lazy.Uniform4fv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform4iv(GLint location, GLsizei count, const GLint *value) {
+	((PFNGLUNIFORM4IVPROC)glducktape_initProcAddress("glUniform4iv", (void**) &glducktape_lazy.Uniform4iv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLUNIFORMMATRIX2FVPROC)glducktape_initProcAddress("glUniformMatrix2fv", (void**) &glducktape_lazy.UniformMatrix2fv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLUNIFORMMATRIX3FVPROC)glducktape_initProcAddress("glUniformMatrix3fv", (void**) &glducktape_lazy.UniformMatrix3fv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLUNIFORMMATRIX4FVPROC)glducktape_initProcAddress("glUniformMatrix4fv", (void**) &glducktape_lazy.UniformMatrix4fv))(location, count, transpose, value);
+}
+static GLboolean APIENTRY glducktape_stub_glUnmapBuffer(GLenum target) {
+	return ((PFNGLUNMAPBUFFERPROC)glducktape_initProcAddress("glUnmapBuffer", (void**) &glducktape_lazy.UnmapBuffer))(target);
+}
+static void APIENTRY glducktape_stub_glUseProgram(GLuint program) {
+	((PFNGLUSEPROGRAMPROC)glducktape_initProcAddress("glUseProgram", (void**) &glducktape_lazy.UseProgram))(program);
+}
+static void APIENTRY glducktape_stub_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+	((PFNGLVERTEXATTRIBPOINTERPROC)glducktape_initProcAddress("glVertexAttribPointer", (void**) &glducktape_lazy.VertexAttribPointer))(index, size, type, normalized, stride, pointer);
+}
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+static void APIENTRY glducktape_stub_glUniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLUNIFORMMATRIX2X3FVPROC)glducktape_initProcAddress("glUniformMatrix2x3fv", (void**) &glducktape_lazy.UniformMatrix2x3fv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLUNIFORMMATRIX2X4FVPROC)glducktape_initProcAddress("glUniformMatrix2x4fv", (void**) &glducktape_lazy.UniformMatrix2x4fv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLUNIFORMMATRIX3X2FVPROC)glducktape_initProcAddress("glUniformMatrix3x2fv", (void**) &glducktape_lazy.UniformMatrix3x2fv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLUNIFORMMATRIX3X4FVPROC)glducktape_initProcAddress("glUniformMatrix3x4fv", (void**) &glducktape_lazy.UniformMatrix3x4fv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLUNIFORMMATRIX4X2FVPROC)glducktape_initProcAddress("glUniformMatrix4x2fv", (void**) &glducktape_lazy.UniformMatrix4x2fv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLUNIFORMMATRIX4X3FVPROC)glducktape_initProcAddress("glUniformMatrix4x3fv", (void**) &glducktape_lazy.UniformMatrix4x3fv))(location, count, transpose, value);
+}
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+static void APIENTRY glducktape_stub_glBindVertexArray(GLuint array) {
+	((PFNGLBINDVERTEXARRAYPROC)glducktape_initProcAddress("glBindVertexArray", (void**) &glducktape_lazy.BindVertexArray))(array);
+}
+static void APIENTRY glducktape_stub_glDeleteVertexArrays(GLsizei n, const GLuint *arrays) {
+	((PFNGLDELETEVERTEXARRAYSPROC)glducktape_initProcAddress("glDeleteVertexArrays", (void**) &glducktape_lazy.DeleteVertexArrays))(n, arrays);
+}
+static void APIENTRY glducktape_stub_glGenVertexArrays(GLsizei n, GLuint *arrays) {
+	((PFNGLGENVERTEXARRAYSPROC)glducktape_initProcAddress("glGenVertexArrays", (void**) &glducktape_lazy.GenVertexArrays))(n, arrays);
+}
+static void APIENTRY glducktape_stub_glGenerateMipmap(GLenum target) {
+	((PFNGLGENERATEMIPMAPPROC)glducktape_initProcAddress("glGenerateMipmap", (void**) &glducktape_lazy.GenerateMipmap))(target);
+}
+static const GLubyte * APIENTRY glducktape_stub_glGetStringi(GLenum name, GLuint index) {
+	return ((PFNGLGETSTRINGIPROC)glducktape_initProcAddress("glGetStringi", (void**) &glducktape_lazy.GetStringi))(name, index);
+}
+static void * APIENTRY glducktape_stub_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	return ((PFNGLMAPBUFFERRANGEPROC)glducktape_initProcAddress("glMapBufferRange", (void**) &glducktape_lazy.MapBufferRange))(target, offset, length, access);
+}
+static void APIENTRY glducktape_stub_glUniform1uiv(GLint location, GLsizei count, const GLuint *value) {
+	((PFNGLUNIFORM1UIVPROC)glducktape_initProcAddress("glUniform1uiv", (void**) &glducktape_lazy.Uniform1uiv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform2uiv(GLint location, GLsizei count, const GLuint *value) {
+	((PFNGLUNIFORM2UIVPROC)glducktape_initProcAddress("glUniform2uiv", (void**) &glducktape_lazy.Uniform2uiv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform3uiv(GLint location, GLsizei count, const GLuint *value) {
+	((PFNGLUNIFORM3UIVPROC)glducktape_initProcAddress("glUniform3uiv", (void**) &glducktape_lazy.Uniform3uiv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform4uiv(GLint location, GLsizei count, const GLuint *value) {
+	((PFNGLUNIFORM4UIVPROC)glducktape_initProcAddress("glUniform4uiv", (void**) &glducktape_lazy.Uniform4uiv))(location, count, value);
+}
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+static GLenum APIENTRY glducktape_stub_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+	return ((PFNGLCLIENTWAITSYNCPROC)glducktape_initProcAddress("glClientWaitSync", (void**) &glducktape_lazy.ClientWaitSync))(sync, flags, timeout);
+}
+static void APIENTRY glducktape_stub_glDeleteSync(GLsync sync) {
+	((PFNGLDELETESYNCPROC)glducktape_initProcAddress("glDeleteSync", (void**) &glducktape_lazy.DeleteSync))(sync);
+}
+static GLsync APIENTRY glducktape_stub_glFenceSync(GLenum condition, GLbitfield flags) {
+	return ((PFNGLFENCESYNCPROC)glducktape_initProcAddress("glFenceSync", (void**) &glducktape_lazy.FenceSync))(condition, flags);
+}
+static void APIENTRY glducktape_stub_glGetInteger64v(GLenum pname, GLint64 *data) {
+	((PFNGLGETINTEGER64VPROC)glducktape_initProcAddress("glGetInteger64v", (void**) &glducktape_lazy.GetInteger64v))(pname, data);
+}
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+static void APIENTRY glducktape_stub_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params) {
+	((PFNGLGETQUERYOBJECTUI64VPROC)glducktape_initProcAddress("glGetQueryObjectui64v", (void**) &glducktape_lazy.GetQueryObjectui64v))(id, pname, params);
+}
+static void APIENTRY glducktape_stub_glQueryCounter(GLuint id, GLenum target) {
+	((PFNGLQUERYCOUNTERPROC)glducktape_initProcAddress("glQueryCounter", (void**) &glducktape_lazy.QueryCounter))(id, target);
+}
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+static void APIENTRY glducktape_stub_glUniform1dv(GLint location, GLsizei count, const GLdouble *value) {
+	((PFNGLUNIFORM1DVPROC)glducktape_initProcAddress("glUniform1dv", (void**) &glducktape_lazy.Uniform1dv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform2dv(GLint location, GLsizei count, const GLdouble *value) {
+	((PFNGLUNIFORM2DVPROC)glducktape_initProcAddress("glUniform2dv", (void**) &glducktape_lazy.Uniform2dv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform3dv(GLint location, GLsizei count, const GLdouble *value) {
+	((PFNGLUNIFORM3DVPROC)glducktape_initProcAddress("glUniform3dv", (void**) &glducktape_lazy.Uniform3dv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniform4dv(GLint location, GLsizei count, const GLdouble *value) {
+	((PFNGLUNIFORM4DVPROC)glducktape_initProcAddress("glUniform4dv", (void**) &glducktape_lazy.Uniform4dv))(location, count, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLUNIFORMMATRIX2DVPROC)glducktape_initProcAddress("glUniformMatrix2dv", (void**) &glducktape_lazy.UniformMatrix2dv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix2x3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLUNIFORMMATRIX2X3DVPROC)glducktape_initProcAddress("glUniformMatrix2x3dv", (void**) &glducktape_lazy.UniformMatrix2x3dv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix2x4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLUNIFORMMATRIX2X4DVPROC)glducktape_initProcAddress("glUniformMatrix2x4dv", (void**) &glducktape_lazy.UniformMatrix2x4dv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLUNIFORMMATRIX3DVPROC)glducktape_initProcAddress("glUniformMatrix3dv", (void**) &glducktape_lazy.UniformMatrix3dv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix3x2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLUNIFORMMATRIX3X2DVPROC)glducktape_initProcAddress("glUniformMatrix3x2dv", (void**) &glducktape_lazy.UniformMatrix3x2dv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix3x4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLUNIFORMMATRIX3X4DVPROC)glducktape_initProcAddress("glUniformMatrix3x4dv", (void**) &glducktape_lazy.UniformMatrix3x4dv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLUNIFORMMATRIX4DVPROC)glducktape_initProcAddress("glUniformMatrix4dv", (void**) &glducktape_lazy.UniformMatrix4dv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix4x2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLUNIFORMMATRIX4X2DVPROC)glducktape_initProcAddress("glUniformMatrix4x2dv", (void**) &glducktape_lazy.UniformMatrix4x2dv))(location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glUniformMatrix4x3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLUNIFORMMATRIX4X3DVPROC)glducktape_initProcAddress("glUniformMatrix4x3dv", (void**) &glducktape_lazy.UniformMatrix4x3dv))(location, count, transpose, value);
+}
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+static void APIENTRY glducktape_stub_glProgramUniform1dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORM1DVPROC)glducktape_initProcAddress("glProgramUniform1dv", (void**) &glducktape_lazy.ProgramUniform1dv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform1fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORM1FVPROC)glducktape_initProcAddress("glProgramUniform1fv", (void**) &glducktape_lazy.ProgramUniform1fv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform1iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	((PFNGLPROGRAMUNIFORM1IVPROC)glducktape_initProcAddress("glProgramUniform1iv", (void**) &glducktape_lazy.ProgramUniform1iv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform1uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	((PFNGLPROGRAMUNIFORM1UIVPROC)glducktape_initProcAddress("glProgramUniform1uiv", (void**) &glducktape_lazy.ProgramUniform1uiv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform2dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORM2DVPROC)glducktape_initProcAddress("glProgramUniform2dv", (void**) &glducktape_lazy.ProgramUniform2dv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform2fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORM2FVPROC)glducktape_initProcAddress("glProgramUniform2fv", (void**) &glducktape_lazy.ProgramUniform2fv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform2iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	((PFNGLPROGRAMUNIFORM2IVPROC)glducktape_initProcAddress("glProgramUniform2iv", (void**) &glducktape_lazy.ProgramUniform2iv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform2uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	((PFNGLPROGRAMUNIFORM2UIVPROC)glducktape_initProcAddress("glProgramUniform2uiv", (void**) &glducktape_lazy.ProgramUniform2uiv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform3dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORM3DVPROC)glducktape_initProcAddress("glProgramUniform3dv", (void**) &glducktape_lazy.ProgramUniform3dv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform3fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORM3FVPROC)glducktape_initProcAddress("glProgramUniform3fv", (void**) &glducktape_lazy.ProgramUniform3fv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform3iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	((PFNGLPROGRAMUNIFORM3IVPROC)glducktape_initProcAddress("glProgramUniform3iv", (void**) &glducktape_lazy.ProgramUniform3iv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform3uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	((PFNGLPROGRAMUNIFORM3UIVPROC)glducktape_initProcAddress("glProgramUniform3uiv", (void**) &glducktape_lazy.ProgramUniform3uiv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform4dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORM4DVPROC)glducktape_initProcAddress("glProgramUniform4dv", (void**) &glducktape_lazy.ProgramUniform4dv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform4fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORM4FVPROC)glducktape_initProcAddress("glProgramUniform4fv", (void**) &glducktape_lazy.ProgramUniform4fv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform4iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	((PFNGLPROGRAMUNIFORM4IVPROC)glducktape_initProcAddress("glProgramUniform4iv", (void**) &glducktape_lazy.ProgramUniform4iv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniform4uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	((PFNGLPROGRAMUNIFORM4UIVPROC)glducktape_initProcAddress("glProgramUniform4uiv", (void**) &glducktape_lazy.ProgramUniform4uiv))(program, location, count, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix2dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX2DVPROC)glducktape_initProcAddress("glProgramUniformMatrix2dv", (void**) &glducktape_lazy.ProgramUniformMatrix2dv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX2FVPROC)glducktape_initProcAddress("glProgramUniformMatrix2fv", (void**) &glducktape_lazy.ProgramUniformMatrix2fv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix2x3dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX2X3DVPROC)glducktape_initProcAddress("glProgramUniformMatrix2x3dv", (void**) &glducktape_lazy.ProgramUniformMatrix2x3dv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix2x3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX2X3FVPROC)glducktape_initProcAddress("glProgramUniformMatrix2x3fv", (void**) &glducktape_lazy.ProgramUniformMatrix2x3fv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix2x4dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX2X4DVPROC)glducktape_initProcAddress("glProgramUniformMatrix2x4dv", (void**) &glducktape_lazy.ProgramUniformMatrix2x4dv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix2x4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX2X4FVPROC)glducktape_initProcAddress("glProgramUniformMatrix2x4fv", (void**) &glducktape_lazy.ProgramUniformMatrix2x4fv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix3dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX3DVPROC)glducktape_initProcAddress("glProgramUniformMatrix3dv", (void**) &glducktape_lazy.ProgramUniformMatrix3dv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX3FVPROC)glducktape_initProcAddress("glProgramUniformMatrix3fv", (void**) &glducktape_lazy.ProgramUniformMatrix3fv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix3x2dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX3X2DVPROC)glducktape_initProcAddress("glProgramUniformMatrix3x2dv", (void**) &glducktape_lazy.ProgramUniformMatrix3x2dv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix3x2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX3X2FVPROC)glducktape_initProcAddress("glProgramUniformMatrix3x2fv", (void**) &glducktape_lazy.ProgramUniformMatrix3x2fv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix3x4dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX3X4DVPROC)glducktape_initProcAddress("glProgramUniformMatrix3x4dv", (void**) &glducktape_lazy.ProgramUniformMatrix3x4dv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix3x4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX3X4FVPROC)glducktape_initProcAddress("glProgramUniformMatrix3x4fv", (void**) &glducktape_lazy.ProgramUniformMatrix3x4fv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix4dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX4DVPROC)glducktape_initProcAddress("glProgramUniformMatrix4dv", (void**) &glducktape_lazy.ProgramUniformMatrix4dv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX4FVPROC)glducktape_initProcAddress("glProgramUniformMatrix4fv", (void**) &glducktape_lazy.ProgramUniformMatrix4fv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix4x2dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX4X2DVPROC)glducktape_initProcAddress("glProgramUniformMatrix4x2dv", (void**) &glducktape_lazy.ProgramUniformMatrix4x2dv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix4x2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX4X2FVPROC)glducktape_initProcAddress("glProgramUniformMatrix4x2fv", (void**) &glducktape_lazy.ProgramUniformMatrix4x2fv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix4x3dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX4X3DVPROC)glducktape_initProcAddress("glProgramUniformMatrix4x3dv", (void**) &glducktape_lazy.ProgramUniformMatrix4x3dv))(program, location, count, transpose, value);
+}
+static void APIENTRY glducktape_stub_glProgramUniformMatrix4x3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	((PFNGLPROGRAMUNIFORMMATRIX4X3FVPROC)glducktape_initProcAddress("glProgramUniformMatrix4x3fv", (void**) &glducktape_lazy.ProgramUniformMatrix4x3fv))(program, location, count, transpose, value);
+}
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+static void APIENTRY glducktape_stub_glDebugMessageCallback(GLDEBUGPROC callback, const void *userParam) {
+	((PFNGLDEBUGMESSAGECALLBACKPROC)glducktape_initProcAddress("glDebugMessageCallback", (void**) &glducktape_lazy.DebugMessageCallback))(callback, userParam);
+}
+static void APIENTRY glducktape_stub_glDebugMessageControl(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled) {
+	((PFNGLDEBUGMESSAGECONTROLPROC)glducktape_initProcAddress("glDebugMessageControl", (void**) &glducktape_lazy.DebugMessageControl))(source, type, severity, count, ids, enabled);
+}
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+static void APIENTRY glducktape_stub_glGetNamedBufferParameteriv(GLuint buffer, GLenum pname, GLint *params) {
+	((PFNGLGETNAMEDBUFFERPARAMETERIVPROC)glducktape_initProcAddress("glGetNamedBufferParameteriv", (void**) &glducktape_lazy.GetNamedBufferParameteriv))(buffer, pname, params);
+}
+static void * APIENTRY glducktape_stub_glMapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	return ((PFNGLMAPNAMEDBUFFERRANGEPROC)glducktape_initProcAddress("glMapNamedBufferRange", (void**) &glducktape_lazy.MapNamedBufferRange))(buffer, offset, length, access);
+}
+static GLboolean APIENTRY glducktape_stub_glUnmapNamedBuffer(GLuint buffer) {
+	return ((PFNGLUNMAPNAMEDBUFFERPROC)glducktape_initProcAddress("glUnmapNamedBuffer", (void**) &glducktape_lazy.UnmapNamedBuffer))(buffer);
+}
 #endif /* GL_VERSION_4_5 */
+
+static struct glducktape_dispatch glducktape_lazy= {
+#ifdef GL_VERSION_1_1
+ glducktape_stub_glBindTexture,
+ glducktape_stub_glDeleteTextures,
+ glducktape_stub_glDrawArrays,
+ glducktape_stub_glDrawElements,
+ glducktape_stub_glGenTextures,
+ glducktape_stub_glPixelStorei,
+ glducktape_stub_glTexImage2D,
+ glducktape_stub_glTexParameteri,
+ glducktape_stub_glTexSubImage2D,
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+ glducktape_stub_glDeleteQueries,
+ glducktape_stub_glGenQueries,
+ glducktape_stub_glGetQueryObjectiv,
+#endif /* GL_VERSION_1_5 */
 #ifdef GL_VERSION_2_0
-  PFNGLBINDBUFFERPROC glducktape_glBindBuffer = NULL;
-  PFNGLBUFFERDATAPROC glducktape_glBufferData = NULL;
-  PFNGLBUFFERSUBDATAPROC glducktape_glBufferSubData = NULL;
-  PFNGLDELETEBUFFERSPROC glducktape_glDeleteBuffers = NULL;
-  PFNGLGENBUFFERSPROC glducktape_glGenBuffers = NULL;
-  PFNGLGETACTIVEUNIFORMPROC glducktape_glGetActiveUniform = NULL;
-  PFNGLGETBUFFERPARAMETERIVPROC glducktape_glGetBufferParameteriv = NULL;
-  PFNGLGETPROGRAMIVPROC glducktape_glGetProgramiv = NULL;
-  PFNGLGETUNIFORMLOCATIONPROC glducktape_glGetUniformLocation = NULL;
-  PFNGLMAPBUFFERPROC glducktape_glMapBuffer = NULL;
-  PFNGLUNIFORM1FVPROC glducktape_glUniform1fv = NULL;
-  PFNGLUNIFORM1IVPROC glducktape_glUniform1iv = NULL;
-  PFNGLUNIFORM2FVPROC glducktape_glUniform2fv = NULL;
-  PFNGLUNIFORM2IVPROC glducktape_glUniform2iv = NULL;
-  PFNGLUNIFORM3FVPROC glducktape_glUniform3fv = NULL;
-  PFNGLUNIFORM3IVPROC glducktape_glUniform3iv = NULL;
-  PFNGLUNIFORM4FVPROC glducktape_glUniform4fv = NULL;
-  PFNGLUNIFORM4IVPROC glducktape_glUniform4iv = NULL;
-  PFNGLUNIFORMMATRIX2FVPROC glducktape_glUniformMatrix2fv = NULL;
-  PFNGLUNIFORMMATRIX3FVPROC glducktape_glUniformMatrix3fv = NULL;
-  PFNGLUNIFORMMATRIX4FVPROC glducktape_glUniformMatrix4fv = NULL;
-  PFNGLUNMAPBUFFERPROC glducktape_glUnmapBuffer = NULL;
+ glducktape_stub_glAttachShader,
+ glducktape_stub_glBindBuffer,
+ glducktape_stub_glBufferData,
+ glducktape_stub_glBufferSubData,
+ glducktape_stub_glCompileShader,
+ glducktape_stub_glCreateProgram,
+ glducktape_stub_glCreateShader,
+ glducktape_stub_glDeleteBuffers,
+ glducktape_stub_glDeleteProgram,
+ glducktape_stub_glDeleteShader,
+ glducktape_stub_glDetachShader,
+ glducktape_stub_glDisableVertexAttribArray,
+ glducktape_stub_glEnableVertexAttribArray,
+ glducktape_stub_glGenBuffers,
+ glducktape_stub_glGetActiveUniform,
+ glducktape_stub_glGetBufferParameteriv,
+ glducktape_stub_glGetProgramiv,
+ glducktape_stub_glGetUniformLocation,
+ glducktape_stub_glLinkProgram,
+ glducktape_stub_glMapBuffer,
+ glducktape_stub_glShaderSource,
+ glducktape_stub_glUniform1fv,
+ glducktape_stub_glUniform1iv,
+ glducktape_stub_glUniform2fv,
+ glducktape_stub_glUniform2iv,
+ glducktape_stub_glUniform3fv,
+ glducktape_stub_glUniform3iv,
+ glducktape_stub_glUniform4fv,
+ glducktape_stub_glUniform4iv,
+ glducktape_stub_glUniformMatrix2fv,
+ glducktape_stub_glUniformMatrix3fv,
+ glducktape_stub_glUniformMatrix4fv,
+ glducktape_stub_glUnmapBuffer,
+ glducktape_stub_glUseProgram,
+ glducktape_stub_glVertexAttribPointer,
 #endif /* GL_VERSION_2_0 */
 #ifdef GL_VERSION_2_1
-  PFNGLUNIFORMMATRIX2X3FVPROC glducktape_glUniformMatrix2x3fv = NULL;
-  PFNGLUNIFORMMATRIX2X4FVPROC glducktape_glUniformMatrix2x4fv = NULL;
-  PFNGLUNIFORMMATRIX3X2FVPROC glducktape_glUniformMatrix3x2fv = NULL;
-  PFNGLUNIFORMMATRIX3X4FVPROC glducktape_glUniformMatrix3x4fv = NULL;
-  PFNGLUNIFORMMATRIX4X2FVPROC glducktape_glUniformMatrix4x2fv = NULL;
-  PFNGLUNIFORMMATRIX4X3FVPROC glducktape_glUniformMatrix4x3fv = NULL;
+ glducktape_stub_glUniformMatrix2x3fv,
+ glducktape_stub_glUniformMatrix2x4fv,
+ glducktape_stub_glUniformMatrix3x2fv,
+ glducktape_stub_glUniformMatrix3x4fv,
+ glducktape_stub_glUniformMatrix4x2fv,
+ glducktape_stub_glUniformMatrix4x3fv,
 #endif /* GL_VERSION_2_1 */
 #ifdef GL_VERSION_3_0
-  PFNGLDELETEVERTEXARRAYSPROC glducktape_glDeleteVertexArrays = NULL;
-  PFNGLGENERATEMIPMAPPROC glducktape_glGenerateMipmap = NULL;
-  PFNGLGENVERTEXARRAYSPROC glducktape_glGenVertexArrays = NULL;
-  PFNGLMAPBUFFERRANGEPROC glducktape_glMapBufferRange = NULL;
-  PFNGLUNIFORM1UIVPROC glducktape_glUniform1uiv = NULL;
-  PFNGLUNIFORM2UIVPROC glducktape_glUniform2uiv = NULL;
-  PFNGLUNIFORM3UIVPROC glducktape_glUniform3uiv = NULL;
-  PFNGLUNIFORM4UIVPROC glducktape_glUniform4uiv = NULL;
+ glducktape_stub_glBindVertexArray,
+ glducktape_stub_glDeleteVertexArrays,
+ glducktape_stub_glGenVertexArrays,
+ glducktape_stub_glGenerateMipmap,
+ glducktape_stub_glGetStringi,
+ glducktape_stub_glMapBufferRange,
+ glducktape_stub_glUniform1uiv,
+ glducktape_stub_glUniform2uiv,
+ glducktape_stub_glUniform3uiv,
+ glducktape_stub_glUniform4uiv,
 #endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+ glducktape_stub_glClientWaitSync,
+ glducktape_stub_glDeleteSync,
+ glducktape_stub_glFenceSync,
+ glducktape_stub_glGetInteger64v,
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+ glducktape_stub_glGetQueryObjectui64v,
+ glducktape_stub_glQueryCounter,
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+ glducktape_stub_glUniform1dv,
+ glducktape_stub_glUniform2dv,
+ glducktape_stub_glUniform3dv,
+ glducktape_stub_glUniform4dv,
+ glducktape_stub_glUniformMatrix2dv,
+ glducktape_stub_glUniformMatrix2x3dv,
+ glducktape_stub_glUniformMatrix2x4dv,
+ glducktape_stub_glUniformMatrix3dv,
+ glducktape_stub_glUniformMatrix3x2dv,
+ glducktape_stub_glUniformMatrix3x4dv,
+ glducktape_stub_glUniformMatrix4dv,
+ glducktape_stub_glUniformMatrix4x2dv,
+ glducktape_stub_glUniformMatrix4x3dv,
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+ glducktape_stub_glProgramUniform1dv,
+ glducktape_stub_glProgramUniform1fv,
+ glducktape_stub_glProgramUniform1iv,
+ glducktape_stub_glProgramUniform1uiv,
+ glducktape_stub_glProgramUniform2dv,
+ glducktape_stub_glProgramUniform2fv,
+ glducktape_stub_glProgramUniform2iv,
+ glducktape_stub_glProgramUniform2uiv,
+ glducktape_stub_glProgramUniform3dv,
+ glducktape_stub_glProgramUniform3fv,
+ glducktape_stub_glProgramUniform3iv,
+ glducktape_stub_glProgramUniform3uiv,
+ glducktape_stub_glProgramUniform4dv,
+ glducktape_stub_glProgramUniform4fv,
+ glducktape_stub_glProgramUniform4iv,
+ glducktape_stub_glProgramUniform4uiv,
+ glducktape_stub_glProgramUniformMatrix2dv,
+ glducktape_stub_glProgramUniformMatrix2fv,
+ glducktape_stub_glProgramUniformMatrix2x3dv,
+ glducktape_stub_glProgramUniformMatrix2x3fv,
+ glducktape_stub_glProgramUniformMatrix2x4dv,
+ glducktape_stub_glProgramUniformMatrix2x4fv,
+ glducktape_stub_glProgramUniformMatrix3dv,
+ glducktape_stub_glProgramUniformMatrix3fv,
+ glducktape_stub_glProgramUniformMatrix3x2dv,
+ glducktape_stub_glProgramUniformMatrix3x2fv,
+ glducktape_stub_glProgramUniformMatrix3x4dv,
+ glducktape_stub_glProgramUniformMatrix3x4fv,
+ glducktape_stub_glProgramUniformMatrix4dv,
+ glducktape_stub_glProgramUniformMatrix4fv,
+ glducktape_stub_glProgramUniformMatrix4x2dv,
+ glducktape_stub_glProgramUniformMatrix4x2fv,
+ glducktape_stub_glProgramUniformMatrix4x3dv,
+ glducktape_stub_glProgramUniformMatrix4x3fv,
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+ glducktape_stub_glDebugMessageCallback,
+ glducktape_stub_glDebugMessageControl,
+#endif /* GL_VERSION_4_3 */
 #ifdef GL_VERSION_4_5
-  PFNGLGETNAMEDBUFFERPARAMETERIVPROC glducktape_glGetNamedBufferParameteriv = NULL;
-  PFNGLMAPNAMEDBUFFERRANGEPROC glducktape_glMapNamedBufferRange = NULL;
-  PFNGLUNMAPNAMEDBUFFERPROC glducktape_glUnmapNamedBuffer = NULL;
+ glducktape_stub_glGetNamedBufferParameteriv,
+ glducktape_stub_glMapNamedBufferRange,
+ glducktape_stub_glUnmapNamedBuffer,
 #endif /* GL_VERSION_4_5 */
+ 0
+};
+/* The table for the current context, which glducktape_current points to unless profiling
+ * or capturing */
+static struct glducktape_dispatch *glducktape_active= &glducktape_lazy;
+struct glducktape_dispatch *glducktape_current= &glducktape_lazy;
+static void glducktape_route(void);
+
 
 #if defined(_WIN32) || defined(__CYGWIN__)
 #include <windows.h>
@@ -255,8 +1104,18 @@ int open_gl(void) {
 
 #endif
 
-void* glducktape_initProcAddress(const char *name, void **fnptr) {
+/* Replacement for the GL library's lookup, for contexts created by another library (OSMesa) */
+static void* (*glducktape_loader)(const char *name)= NULL;
+
+void glducktape_set_loader(void* (*loader)(const char *name)) {
+	glducktape_loader= loader;
+}
+
+/* Look up a function in the GL library, returning NULL if it can't be found */
+static void* glducktape_getProcAddress(const char *name) {
     void* result = NULL;
+	if (glducktape_loader)
+		return glducktape_loader(name);
 	if (!glducktape_libGL) {
 		open_gl();
 		if (!glducktape_libGL)
@@ -275,8 +1134,4905 @@ void* glducktape_initProcAddress(const char *name, void **fnptr) {
         result = dlsym(glducktape_libGL, name);
 #endif
     }
+    return result;
+}
+
+void* glducktape_initProcAddress(const char *name, void **fnptr) {
+	void* result = glducktape_getProcAddress(name);
 	if (!result)
 		croak("Can't look up address of %s", name);
 	*fnptr= result;
     return result;
 }
+
+/* Set every entry of a table to the stub which resolves it lazily */
+void glducktape_init(struct glducktape_dispatch *table) {
+#ifdef GL_VERSION_1_1
+	table->BindTexture= glducktape_stub_glBindTexture;
+	table->DeleteTextures= glducktape_stub_glDeleteTextures;
+	table->DrawArrays= glducktape_stub_glDrawArrays;
+	table->DrawElements= glducktape_stub_glDrawElements;
+	table->GenTextures= glducktape_stub_glGenTextures;
+	table->PixelStorei= glducktape_stub_glPixelStorei;
+	table->TexImage2D= glducktape_stub_glTexImage2D;
+	table->TexParameteri= glducktape_stub_glTexParameteri;
+	table->TexSubImage2D= glducktape_stub_glTexSubImage2D;
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+	table->DeleteQueries= glducktape_stub_glDeleteQueries;
+	table->GenQueries= glducktape_stub_glGenQueries;
+	table->GetQueryObjectiv= glducktape_stub_glGetQueryObjectiv;
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+	table->AttachShader= glducktape_stub_glAttachShader;
+	table->BindBuffer= glducktape_stub_glBindBuffer;
+	table->BufferData= glducktape_stub_glBufferData;
+	table->BufferSubData= glducktape_stub_glBufferSubData;
+	table->CompileShader= glducktape_stub_glCompileShader;
+	table->CreateProgram= glducktape_stub_glCreateProgram;
+	table->CreateShader= glducktape_stub_glCreateShader;
+	table->DeleteBuffers= glducktape_stub_glDeleteBuffers;
+	table->DeleteProgram= glducktape_stub_glDeleteProgram;
+	table->DeleteShader= glducktape_stub_glDeleteShader;
+	table->DetachShader= glducktape_stub_glDetachShader;
+	table->DisableVertexAttribArray= glducktape_stub_glDisableVertexAttribArray;
+	table->EnableVertexAttribArray= glducktape_stub_glEnableVertexAttribArray;
+	table->GenBuffers= glducktape_stub_glGenBuffers;
+	table->GetActiveUniform= glducktape_stub_glGetActiveUniform;
+	table->GetBufferParameteriv= glducktape_stub_glGetBufferParameteriv;
+	table->GetProgramiv= glducktape_stub_glGetProgramiv;
+	table->GetUniformLocation= glducktape_stub_glGetUniformLocation;
+	table->LinkProgram= glducktape_stub_glLinkProgram;
+	table->MapBuffer= glducktape_stub_glMapBuffer;
+	table->ShaderSource= glducktape_stub_glShaderSource;
+	table->Uniform1fv= glducktape_stub_glUniform1fv;
+	table->Uniform1iv= glducktape_stub_glUniform1iv;
+	table->Uniform2fv= glducktape_stub_glUniform2fv;
+	table->Uniform2iv= glducktape_stub_glUniform2iv;
+	table->Uniform3fv= glducktape_stub_glUniform3fv;
+	table->Uniform3iv= glducktape_stub_glUniform3iv;
+	table->Uniform4fv= glducktape_stub_glUniform4fv;
+	table->Uniform4iv= glducktape_stub_glUniform4iv;
+	table->UniformMatrix2fv= glducktape_stub_glUniformMatrix2fv;
+	table->UniformMatrix3fv= glducktape_stub_glUniformMatrix3fv;
+	table->UniformMatrix4fv= glducktape_stub_glUniformMatrix4fv;
+	table->UnmapBuffer= glducktape_stub_glUnmapBuffer;
+	table->UseProgram= glducktape_stub_glUseProgram;
+	table->VertexAttribPointer= glducktape_stub_glVertexAttribPointer;
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+	table->UniformMatrix2x3fv= glducktape_stub_glUniformMatrix2x3fv;
+	table->UniformMatrix2x4fv= glducktape_stub_glUniformMatrix2x4fv;
+	table->UniformMatrix3x2fv= glducktape_stub_glUniformMatrix3x2fv;
+	table->UniformMatrix3x4fv= glducktape_stub_glUniformMatrix3x4fv;
+	table->UniformMatrix4x2fv= glducktape_stub_glUniformMatrix4x2fv;
+	table->UniformMatrix4x3fv= glducktape_stub_glUniformMatrix4x3fv;
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+	table->BindVertexArray= glducktape_stub_glBindVertexArray;
+	table->DeleteVertexArrays= glducktape_stub_glDeleteVertexArrays;
+	table->GenVertexArrays= glducktape_stub_glGenVertexArrays;
+	table->GenerateMipmap= glducktape_stub_glGenerateMipmap;
+	table->GetStringi= glducktape_stub_glGetStringi;
+	table->MapBufferRange= glducktape_stub_glMapBufferRange;
+	table->Uniform1uiv= glducktape_stub_glUniform1uiv;
+	table->Uniform2uiv= glducktape_stub_glUniform2uiv;
+	table->Uniform3uiv= glducktape_stub_glUniform3uiv;
+	table->Uniform4uiv= glducktape_stub_glUniform4uiv;
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+	table->ClientWaitSync= glducktape_stub_glClientWaitSync;
+	table->DeleteSync= glducktape_stub_glDeleteSync;
+	table->FenceSync= glducktape_stub_glFenceSync;
+	table->GetInteger64v= glducktape_stub_glGetInteger64v;
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+	table->GetQueryObjectui64v= glducktape_stub_glGetQueryObjectui64v;
+	table->QueryCounter= glducktape_stub_glQueryCounter;
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+	table->Uniform1dv= glducktape_stub_glUniform1dv;
+	table->Uniform2dv= glducktape_stub_glUniform2dv;
+	table->Uniform3dv= glducktape_stub_glUniform3dv;
+	table->Uniform4dv= glducktape_stub_glUniform4dv;
+	table->UniformMatrix2dv= glducktape_stub_glUniformMatrix2dv;
+	table->UniformMatrix2x3dv= glducktape_stub_glUniformMatrix2x3dv;
+	table->UniformMatrix2x4dv= glducktape_stub_glUniformMatrix2x4dv;
+	table->UniformMatrix3dv= glducktape_stub_glUniformMatrix3dv;
+	table->UniformMatrix3x2dv= glducktape_stub_glUniformMatrix3x2dv;
+	table->UniformMatrix3x4dv= glducktape_stub_glUniformMatrix3x4dv;
+	table->UniformMatrix4dv= glducktape_stub_glUniformMatrix4dv;
+	table->UniformMatrix4x2dv= glducktape_stub_glUniformMatrix4x2dv;
+	table->UniformMatrix4x3dv= glducktape_stub_glUniformMatrix4x3dv;
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+	table->ProgramUniform1dv= glducktape_stub_glProgramUniform1dv;
+	table->ProgramUniform1fv= glducktape_stub_glProgramUniform1fv;
+	table->ProgramUniform1iv= glducktape_stub_glProgramUniform1iv;
+	table->ProgramUniform1uiv= glducktape_stub_glProgramUniform1uiv;
+	table->ProgramUniform2dv= glducktape_stub_glProgramUniform2dv;
+	table->ProgramUniform2fv= glducktape_stub_glProgramUniform2fv;
+	table->ProgramUniform2iv= glducktape_stub_glProgramUniform2iv;
+	table->ProgramUniform2uiv= glducktape_stub_glProgramUniform2uiv;
+	table->ProgramUniform3dv= glducktape_stub_glProgramUniform3dv;
+	table->ProgramUniform3fv= glducktape_stub_glProgramUniform3fv;
+	table->ProgramUniform3iv= glducktape_stub_glProgramUniform3iv;
+	table->ProgramUniform3uiv= glducktape_stub_glProgramUniform3uiv;
+	table->ProgramUniform4dv= glducktape_stub_glProgramUniform4dv;
+	table->ProgramUniform4fv= glducktape_stub_glProgramUniform4fv;
+	table->ProgramUniform4iv= glducktape_stub_glProgramUniform4iv;
+	table->ProgramUniform4uiv= glducktape_stub_glProgramUniform4uiv;
+	table->ProgramUniformMatrix2dv= glducktape_stub_glProgramUniformMatrix2dv;
+	table->ProgramUniformMatrix2fv= glducktape_stub_glProgramUniformMatrix2fv;
+	table->ProgramUniformMatrix2x3dv= glducktape_stub_glProgramUniformMatrix2x3dv;
+	table->ProgramUniformMatrix2x3fv= glducktape_stub_glProgramUniformMatrix2x3fv;
+	table->ProgramUniformMatrix2x4dv= glducktape_stub_glProgramUniformMatrix2x4dv;
+	table->ProgramUniformMatrix2x4fv= glducktape_stub_glProgramUniformMatrix2x4fv;
+	table->ProgramUniformMatrix3dv= glducktape_stub_glProgramUniformMatrix3dv;
+	table->ProgramUniformMatrix3fv= glducktape_stub_glProgramUniformMatrix3fv;
+	table->ProgramUniformMatrix3x2dv= glducktape_stub_glProgramUniformMatrix3x2dv;
+	table->ProgramUniformMatrix3x2fv= glducktape_stub_glProgramUniformMatrix3x2fv;
+	table->ProgramUniformMatrix3x4dv= glducktape_stub_glProgramUniformMatrix3x4dv;
+	table->ProgramUniformMatrix3x4fv= glducktape_stub_glProgramUniformMatrix3x4fv;
+	table->ProgramUniformMatrix4dv= glducktape_stub_glProgramUniformMatrix4dv;
+	table->ProgramUniformMatrix4fv= glducktape_stub_glProgramUniformMatrix4fv;
+	table->ProgramUniformMatrix4x2dv= glducktape_stub_glProgramUniformMatrix4x2dv;
+	table->ProgramUniformMatrix4x2fv= glducktape_stub_glProgramUniformMatrix4x2fv;
+	table->ProgramUniformMatrix4x3dv= glducktape_stub_glProgramUniformMatrix4x3dv;
+	table->ProgramUniformMatrix4x3fv= glducktape_stub_glProgramUniformMatrix4x3fv;
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+	table->DebugMessageCallback= glducktape_stub_glDebugMessageCallback;
+	table->DebugMessageControl= glducktape_stub_glDebugMessageControl;
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+	table->GetNamedBufferParameteriv= glducktape_stub_glGetNamedBufferParameteriv;
+	table->MapNamedBufferRange= glducktape_stub_glMapNamedBufferRange;
+	table->UnmapNamedBuffer= glducktape_stub_glUnmapNamedBuffer;
+#endif /* GL_VERSION_4_5 */
+}
+
+/* Route GL calls through 'table', or through the default lazy table if NULL */
+void glducktape_use(struct glducktape_dispatch *table) {
+	glducktape_active= table? table : &glducktape_lazy;
+	glducktape_route();
+}
+
+/* Look up every function for the current context.  Functions which can't be found, or which
+ * are newer than gl_major.gl_minor, are passed to on_missing (if not NULL).  The ones that
+ * can't be found are left as lazy stubs, which croak if they still can't be found when called.
+ * Returns the number of missing functions.
+ */
+int glducktape_resolve(struct glducktape_dispatch *table, int gl_major, int gl_minor,
+	void (*on_missing)(const char *name, void *ctx), void *ctx
+) {
+	int missing= 0, version= gl_major * 10 + gl_minor;
+	void *fn;
+	glducktape_init(table);
+#ifdef GL_VERSION_1_1
+	if ((fn= glducktape_getProcAddress("glBindTexture")))
+		table->BindTexture= (glducktape_PFNGLBINDTEXTUREPROC) fn;
+	if (!fn || version < 11) {
+		missing++;
+		if (on_missing) on_missing("glBindTexture", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDeleteTextures")))
+		table->DeleteTextures= (glducktape_PFNGLDELETETEXTURESPROC) fn;
+	if (!fn || version < 11) {
+		missing++;
+		if (on_missing) on_missing("glDeleteTextures", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDrawArrays")))
+		table->DrawArrays= (glducktape_PFNGLDRAWARRAYSPROC) fn;
+	if (!fn || version < 11) {
+		missing++;
+		if (on_missing) on_missing("glDrawArrays", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDrawElements")))
+		table->DrawElements= (glducktape_PFNGLDRAWELEMENTSPROC) fn;
+	if (!fn || version < 11) {
+		missing++;
+		if (on_missing) on_missing("glDrawElements", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGenTextures")))
+		table->GenTextures= (glducktape_PFNGLGENTEXTURESPROC) fn;
+	if (!fn || version < 11) {
+		missing++;
+		if (on_missing) on_missing("glGenTextures", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glPixelStorei")))
+		table->PixelStorei= (glducktape_PFNGLPIXELSTOREIPROC) fn;
+	if (!fn || version < 11) {
+		missing++;
+		if (on_missing) on_missing("glPixelStorei", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glTexImage2D")))
+		table->TexImage2D= (glducktape_PFNGLTEXIMAGE2DPROC) fn;
+	if (!fn || version < 11) {
+		missing++;
+		if (on_missing) on_missing("glTexImage2D", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glTexParameteri")))
+		table->TexParameteri= (glducktape_PFNGLTEXPARAMETERIPROC) fn;
+	if (!fn || version < 11) {
+		missing++;
+		if (on_missing) on_missing("glTexParameteri", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glTexSubImage2D")))
+		table->TexSubImage2D= (glducktape_PFNGLTEXSUBIMAGE2DPROC) fn;
+	if (!fn || version < 11) {
+		missing++;
+		if (on_missing) on_missing("glTexSubImage2D", ctx);
+	}
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+	if ((fn= glducktape_getProcAddress("glDeleteQueries")))
+		table->DeleteQueries= (PFNGLDELETEQUERIESPROC) fn;
+	if (!fn || version < 15) {
+		missing++;
+		if (on_missing) on_missing("glDeleteQueries", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGenQueries")))
+		table->GenQueries= (PFNGLGENQUERIESPROC) fn;
+	if (!fn || version < 15) {
+		missing++;
+		if (on_missing) on_missing("glGenQueries", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGetQueryObjectiv")))
+		table->GetQueryObjectiv= (PFNGLGETQUERYOBJECTIVPROC) fn;
+	if (!fn || version < 15) {
+		missing++;
+		if (on_missing) on_missing("glGetQueryObjectiv", ctx);
+	}
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+	if ((fn= glducktape_getProcAddress("glAttachShader")))
+		table->AttachShader= (PFNGLATTACHSHADERPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glAttachShader", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glBindBuffer")))
+		table->BindBuffer= (PFNGLBINDBUFFERPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glBindBuffer", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glBufferData")))
+		table->BufferData= (PFNGLBUFFERDATAPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glBufferData", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glBufferSubData")))
+		table->BufferSubData= (PFNGLBUFFERSUBDATAPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glBufferSubData", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glCompileShader")))
+		table->CompileShader= (PFNGLCOMPILESHADERPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glCompileShader", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glCreateProgram")))
+		table->CreateProgram= (PFNGLCREATEPROGRAMPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glCreateProgram", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glCreateShader")))
+		table->CreateShader= (PFNGLCREATESHADERPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glCreateShader", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDeleteBuffers")))
+		table->DeleteBuffers= (PFNGLDELETEBUFFERSPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glDeleteBuffers", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDeleteProgram")))
+		table->DeleteProgram= (PFNGLDELETEPROGRAMPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glDeleteProgram", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDeleteShader")))
+		table->DeleteShader= (PFNGLDELETESHADERPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glDeleteShader", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDetachShader")))
+		table->DetachShader= (PFNGLDETACHSHADERPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glDetachShader", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDisableVertexAttribArray")))
+		table->DisableVertexAttribArray= (PFNGLDISABLEVERTEXATTRIBARRAYPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glDisableVertexAttribArray", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glEnableVertexAttribArray")))
+		table->EnableVertexAttribArray= (PFNGLENABLEVERTEXATTRIBARRAYPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glEnableVertexAttribArray", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGenBuffers")))
+		table->GenBuffers= (PFNGLGENBUFFERSPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glGenBuffers", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGetActiveUniform")))
+		table->GetActiveUniform= (PFNGLGETACTIVEUNIFORMPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glGetActiveUniform", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGetBufferParameteriv")))
+		table->GetBufferParameteriv= (PFNGLGETBUFFERPARAMETERIVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glGetBufferParameteriv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGetProgramiv")))
+		table->GetProgramiv= (PFNGLGETPROGRAMIVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glGetProgramiv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGetUniformLocation")))
+		table->GetUniformLocation= (PFNGLGETUNIFORMLOCATIONPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glGetUniformLocation", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glLinkProgram")))
+		table->LinkProgram= (PFNGLLINKPROGRAMPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glLinkProgram", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glMapBuffer")))
+		table->MapBuffer= (PFNGLMAPBUFFERPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glMapBuffer", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glShaderSource")))
+		table->ShaderSource= (PFNGLSHADERSOURCEPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glShaderSource", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform1fv")))
+		table->Uniform1fv= (PFNGLUNIFORM1FVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniform1fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform1iv")))
+		table->Uniform1iv= (PFNGLUNIFORM1IVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniform1iv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform2fv")))
+		table->Uniform2fv= (PFNGLUNIFORM2FVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniform2fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform2iv")))
+		table->Uniform2iv= (PFNGLUNIFORM2IVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniform2iv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform3fv")))
+		table->Uniform3fv= (PFNGLUNIFORM3FVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniform3fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform3iv")))
+		table->Uniform3iv= (PFNGLUNIFORM3IVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniform3iv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform4fv")))
+		table->Uniform4fv= (PFNGLUNIFORM4FVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniform4fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform4iv")))
+		table->Uniform4iv= (PFNGLUNIFORM4IVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniform4iv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix2fv")))
+		table->UniformMatrix2fv= (PFNGLUNIFORMMATRIX2FVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix2fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix3fv")))
+		table->UniformMatrix3fv= (PFNGLUNIFORMMATRIX3FVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix3fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix4fv")))
+		table->UniformMatrix4fv= (PFNGLUNIFORMMATRIX4FVPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix4fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUnmapBuffer")))
+		table->UnmapBuffer= (PFNGLUNMAPBUFFERPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUnmapBuffer", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUseProgram")))
+		table->UseProgram= (PFNGLUSEPROGRAMPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glUseProgram", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glVertexAttribPointer")))
+		table->VertexAttribPointer= (PFNGLVERTEXATTRIBPOINTERPROC) fn;
+	if (!fn || version < 20) {
+		missing++;
+		if (on_missing) on_missing("glVertexAttribPointer", ctx);
+	}
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+	if ((fn= glducktape_getProcAddress("glUniformMatrix2x3fv")))
+		table->UniformMatrix2x3fv= (PFNGLUNIFORMMATRIX2X3FVPROC) fn;
+	if (!fn || version < 21) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix2x3fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix2x4fv")))
+		table->UniformMatrix2x4fv= (PFNGLUNIFORMMATRIX2X4FVPROC) fn;
+	if (!fn || version < 21) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix2x4fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix3x2fv")))
+		table->UniformMatrix3x2fv= (PFNGLUNIFORMMATRIX3X2FVPROC) fn;
+	if (!fn || version < 21) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix3x2fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix3x4fv")))
+		table->UniformMatrix3x4fv= (PFNGLUNIFORMMATRIX3X4FVPROC) fn;
+	if (!fn || version < 21) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix3x4fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix4x2fv")))
+		table->UniformMatrix4x2fv= (PFNGLUNIFORMMATRIX4X2FVPROC) fn;
+	if (!fn || version < 21) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix4x2fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix4x3fv")))
+		table->UniformMatrix4x3fv= (PFNGLUNIFORMMATRIX4X3FVPROC) fn;
+	if (!fn || version < 21) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix4x3fv", ctx);
+	}
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+	if ((fn= glducktape_getProcAddress("glBindVertexArray")))
+		table->BindVertexArray= (PFNGLBINDVERTEXARRAYPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glBindVertexArray", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDeleteVertexArrays")))
+		table->DeleteVertexArrays= (PFNGLDELETEVERTEXARRAYSPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glDeleteVertexArrays", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGenVertexArrays")))
+		table->GenVertexArrays= (PFNGLGENVERTEXARRAYSPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glGenVertexArrays", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGenerateMipmap")))
+		table->GenerateMipmap= (PFNGLGENERATEMIPMAPPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glGenerateMipmap", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGetStringi")))
+		table->GetStringi= (PFNGLGETSTRINGIPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glGetStringi", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glMapBufferRange")))
+		table->MapBufferRange= (PFNGLMAPBUFFERRANGEPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glMapBufferRange", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform1uiv")))
+		table->Uniform1uiv= (PFNGLUNIFORM1UIVPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glUniform1uiv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform2uiv")))
+		table->Uniform2uiv= (PFNGLUNIFORM2UIVPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glUniform2uiv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform3uiv")))
+		table->Uniform3uiv= (PFNGLUNIFORM3UIVPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glUniform3uiv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform4uiv")))
+		table->Uniform4uiv= (PFNGLUNIFORM4UIVPROC) fn;
+	if (!fn || version < 30) {
+		missing++;
+		if (on_missing) on_missing("glUniform4uiv", ctx);
+	}
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+	if ((fn= glducktape_getProcAddress("glClientWaitSync")))
+		table->ClientWaitSync= (PFNGLCLIENTWAITSYNCPROC) fn;
+	if (!fn || version < 32) {
+		missing++;
+		if (on_missing) on_missing("glClientWaitSync", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDeleteSync")))
+		table->DeleteSync= (PFNGLDELETESYNCPROC) fn;
+	if (!fn || version < 32) {
+		missing++;
+		if (on_missing) on_missing("glDeleteSync", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glFenceSync")))
+		table->FenceSync= (PFNGLFENCESYNCPROC) fn;
+	if (!fn || version < 32) {
+		missing++;
+		if (on_missing) on_missing("glFenceSync", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glGetInteger64v")))
+		table->GetInteger64v= (PFNGLGETINTEGER64VPROC) fn;
+	if (!fn || version < 32) {
+		missing++;
+		if (on_missing) on_missing("glGetInteger64v", ctx);
+	}
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+	if ((fn= glducktape_getProcAddress("glGetQueryObjectui64v")))
+		table->GetQueryObjectui64v= (PFNGLGETQUERYOBJECTUI64VPROC) fn;
+	if (!fn || version < 33) {
+		missing++;
+		if (on_missing) on_missing("glGetQueryObjectui64v", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glQueryCounter")))
+		table->QueryCounter= (PFNGLQUERYCOUNTERPROC) fn;
+	if (!fn || version < 33) {
+		missing++;
+		if (on_missing) on_missing("glQueryCounter", ctx);
+	}
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+	if ((fn= glducktape_getProcAddress("glUniform1dv")))
+		table->Uniform1dv= (PFNGLUNIFORM1DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniform1dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform2dv")))
+		table->Uniform2dv= (PFNGLUNIFORM2DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniform2dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform3dv")))
+		table->Uniform3dv= (PFNGLUNIFORM3DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniform3dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniform4dv")))
+		table->Uniform4dv= (PFNGLUNIFORM4DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniform4dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix2dv")))
+		table->UniformMatrix2dv= (PFNGLUNIFORMMATRIX2DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix2dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix2x3dv")))
+		table->UniformMatrix2x3dv= (PFNGLUNIFORMMATRIX2X3DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix2x3dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix2x4dv")))
+		table->UniformMatrix2x4dv= (PFNGLUNIFORMMATRIX2X4DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix2x4dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix3dv")))
+		table->UniformMatrix3dv= (PFNGLUNIFORMMATRIX3DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix3dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix3x2dv")))
+		table->UniformMatrix3x2dv= (PFNGLUNIFORMMATRIX3X2DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix3x2dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix3x4dv")))
+		table->UniformMatrix3x4dv= (PFNGLUNIFORMMATRIX3X4DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix3x4dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix4dv")))
+		table->UniformMatrix4dv= (PFNGLUNIFORMMATRIX4DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix4dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix4x2dv")))
+		table->UniformMatrix4x2dv= (PFNGLUNIFORMMATRIX4X2DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix4x2dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUniformMatrix4x3dv")))
+		table->UniformMatrix4x3dv= (PFNGLUNIFORMMATRIX4X3DVPROC) fn;
+	if (!fn || version < 40) {
+		missing++;
+		if (on_missing) on_missing("glUniformMatrix4x3dv", ctx);
+	}
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+	if ((fn= glducktape_getProcAddress("glProgramUniform1dv")))
+		table->ProgramUniform1dv= (PFNGLPROGRAMUNIFORM1DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform1dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform1fv")))
+		table->ProgramUniform1fv= (PFNGLPROGRAMUNIFORM1FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform1fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform1iv")))
+		table->ProgramUniform1iv= (PFNGLPROGRAMUNIFORM1IVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform1iv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform1uiv")))
+		table->ProgramUniform1uiv= (PFNGLPROGRAMUNIFORM1UIVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform1uiv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform2dv")))
+		table->ProgramUniform2dv= (PFNGLPROGRAMUNIFORM2DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform2dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform2fv")))
+		table->ProgramUniform2fv= (PFNGLPROGRAMUNIFORM2FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform2fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform2iv")))
+		table->ProgramUniform2iv= (PFNGLPROGRAMUNIFORM2IVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform2iv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform2uiv")))
+		table->ProgramUniform2uiv= (PFNGLPROGRAMUNIFORM2UIVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform2uiv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform3dv")))
+		table->ProgramUniform3dv= (PFNGLPROGRAMUNIFORM3DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform3dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform3fv")))
+		table->ProgramUniform3fv= (PFNGLPROGRAMUNIFORM3FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform3fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform3iv")))
+		table->ProgramUniform3iv= (PFNGLPROGRAMUNIFORM3IVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform3iv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform3uiv")))
+		table->ProgramUniform3uiv= (PFNGLPROGRAMUNIFORM3UIVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform3uiv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform4dv")))
+		table->ProgramUniform4dv= (PFNGLPROGRAMUNIFORM4DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform4dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform4fv")))
+		table->ProgramUniform4fv= (PFNGLPROGRAMUNIFORM4FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform4fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform4iv")))
+		table->ProgramUniform4iv= (PFNGLPROGRAMUNIFORM4IVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform4iv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniform4uiv")))
+		table->ProgramUniform4uiv= (PFNGLPROGRAMUNIFORM4UIVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniform4uiv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix2dv")))
+		table->ProgramUniformMatrix2dv= (PFNGLPROGRAMUNIFORMMATRIX2DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix2dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix2fv")))
+		table->ProgramUniformMatrix2fv= (PFNGLPROGRAMUNIFORMMATRIX2FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix2fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix2x3dv")))
+		table->ProgramUniformMatrix2x3dv= (PFNGLPROGRAMUNIFORMMATRIX2X3DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix2x3dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix2x3fv")))
+		table->ProgramUniformMatrix2x3fv= (PFNGLPROGRAMUNIFORMMATRIX2X3FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix2x3fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix2x4dv")))
+		table->ProgramUniformMatrix2x4dv= (PFNGLPROGRAMUNIFORMMATRIX2X4DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix2x4dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix2x4fv")))
+		table->ProgramUniformMatrix2x4fv= (PFNGLPROGRAMUNIFORMMATRIX2X4FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix2x4fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix3dv")))
+		table->ProgramUniformMatrix3dv= (PFNGLPROGRAMUNIFORMMATRIX3DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix3dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix3fv")))
+		table->ProgramUniformMatrix3fv= (PFNGLPROGRAMUNIFORMMATRIX3FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix3fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix3x2dv")))
+		table->ProgramUniformMatrix3x2dv= (PFNGLPROGRAMUNIFORMMATRIX3X2DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix3x2dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix3x2fv")))
+		table->ProgramUniformMatrix3x2fv= (PFNGLPROGRAMUNIFORMMATRIX3X2FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix3x2fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix3x4dv")))
+		table->ProgramUniformMatrix3x4dv= (PFNGLPROGRAMUNIFORMMATRIX3X4DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix3x4dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix3x4fv")))
+		table->ProgramUniformMatrix3x4fv= (PFNGLPROGRAMUNIFORMMATRIX3X4FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix3x4fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix4dv")))
+		table->ProgramUniformMatrix4dv= (PFNGLPROGRAMUNIFORMMATRIX4DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix4dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix4fv")))
+		table->ProgramUniformMatrix4fv= (PFNGLPROGRAMUNIFORMMATRIX4FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix4fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix4x2dv")))
+		table->ProgramUniformMatrix4x2dv= (PFNGLPROGRAMUNIFORMMATRIX4X2DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix4x2dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix4x2fv")))
+		table->ProgramUniformMatrix4x2fv= (PFNGLPROGRAMUNIFORMMATRIX4X2FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix4x2fv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix4x3dv")))
+		table->ProgramUniformMatrix4x3dv= (PFNGLPROGRAMUNIFORMMATRIX4X3DVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix4x3dv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glProgramUniformMatrix4x3fv")))
+		table->ProgramUniformMatrix4x3fv= (PFNGLPROGRAMUNIFORMMATRIX4X3FVPROC) fn;
+	if (!fn || version < 41) {
+		missing++;
+		if (on_missing) on_missing("glProgramUniformMatrix4x3fv", ctx);
+	}
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+	if ((fn= glducktape_getProcAddress("glDebugMessageCallback")))
+		table->DebugMessageCallback= (PFNGLDEBUGMESSAGECALLBACKPROC) fn;
+	if (!fn || version < 43) {
+		missing++;
+		if (on_missing) on_missing("glDebugMessageCallback", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glDebugMessageControl")))
+		table->DebugMessageControl= (PFNGLDEBUGMESSAGECONTROLPROC) fn;
+	if (!fn || version < 43) {
+		missing++;
+		if (on_missing) on_missing("glDebugMessageControl", ctx);
+	}
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+	if ((fn= glducktape_getProcAddress("glGetNamedBufferParameteriv")))
+		table->GetNamedBufferParameteriv= (PFNGLGETNAMEDBUFFERPARAMETERIVPROC) fn;
+	if (!fn || version < 45) {
+		missing++;
+		if (on_missing) on_missing("glGetNamedBufferParameteriv", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glMapNamedBufferRange")))
+		table->MapNamedBufferRange= (PFNGLMAPNAMEDBUFFERRANGEPROC) fn;
+	if (!fn || version < 45) {
+		missing++;
+		if (on_missing) on_missing("glMapNamedBufferRange", ctx);
+	}
+	if ((fn= glducktape_getProcAddress("glUnmapNamedBuffer")))
+		table->UnmapNamedBuffer= (PFNGLUNMAPNAMEDBUFFERPROC) fn;
+	if (!fn || version < 45) {
+		missing++;
+		if (on_missing) on_missing("glUnmapNamedBuffer", ctx);
+	}
+#endif /* GL_VERSION_4_5 */
+	return missing;
+}
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+unsigned long long glducktape_now_ns(void) {
+	static LARGE_INTEGER freq;
+	LARGE_INTEGER now;
+	if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (unsigned long long)((double) now.QuadPart * 1e9 / (double) freq.QuadPart);
+}
+#else
+#include <time.h>
+unsigned long long glducktape_now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+#endif
+
+int glducktape_profiling= 0;
+struct glducktape_stat glducktape_stats[glducktape_fn_count + 1];
+struct glducktape_scope *glducktape_scopes= NULL;
+struct glducktape_scope *glducktape_cur_scope= NULL;
+
+const char *glducktape_names[]= {
+#ifdef GL_VERSION_1_1
+ "glBindTexture",
+ "glDeleteTextures",
+ "glDrawArrays",
+ "glDrawElements",
+ "glGenTextures",
+ "glPixelStorei",
+ "glTexImage2D",
+ "glTexParameteri",
+ "glTexSubImage2D",
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+ "glDeleteQueries",
+ "glGenQueries",
+ "glGetQueryObjectiv",
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+ "glAttachShader",
+ "glBindBuffer",
+ "glBufferData",
+ "glBufferSubData",
+ "glCompileShader",
+ "glCreateProgram",
+ "glCreateShader",
+ "glDeleteBuffers",
+ "glDeleteProgram",
+ "glDeleteShader",
+ "glDetachShader",
+ "glDisableVertexAttribArray",
+ "glEnableVertexAttribArray",
+ "glGenBuffers",
+ "glGetActiveUniform",
+ "glGetBufferParameteriv",
+ "glGetProgramiv",
+ "glGetUniformLocation",
+ "glLinkProgram",
+ "glMapBuffer",
+ "glShaderSource",
+ "glUniform1fv",
+ "glUniform1iv",
+ "glUniform2fv",
+ "glUniform2iv",
+ "glUniform3fv",
+ "glUniform3iv",
+ "glUniform4fv",
+ "glUniform4iv",
+ "glUniformMatrix2fv",
+ "glUniformMatrix3fv",
+ "glUniformMatrix4fv",
+ "glUnmapBuffer",
+ "glUseProgram",
+ "glVertexAttribPointer",
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+ "glUniformMatrix2x3fv",
+ "glUniformMatrix2x4fv",
+ "glUniformMatrix3x2fv",
+ "glUniformMatrix3x4fv",
+ "glUniformMatrix4x2fv",
+ "glUniformMatrix4x3fv",
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+ "glBindVertexArray",
+ "glDeleteVertexArrays",
+ "glGenVertexArrays",
+ "glGenerateMipmap",
+ "glGetStringi",
+ "glMapBufferRange",
+ "glUniform1uiv",
+ "glUniform2uiv",
+ "glUniform3uiv",
+ "glUniform4uiv",
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+ "glClientWaitSync",
+ "glDeleteSync",
+ "glFenceSync",
+ "glGetInteger64v",
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+ "glGetQueryObjectui64v",
+ "glQueryCounter",
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+ "glUniform1dv",
+ "glUniform2dv",
+ "glUniform3dv",
+ "glUniform4dv",
+ "glUniformMatrix2dv",
+ "glUniformMatrix2x3dv",
+ "glUniformMatrix2x4dv",
+ "glUniformMatrix3dv",
+ "glUniformMatrix3x2dv",
+ "glUniformMatrix3x4dv",
+ "glUniformMatrix4dv",
+ "glUniformMatrix4x2dv",
+ "glUniformMatrix4x3dv",
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+ "glProgramUniform1dv",
+ "glProgramUniform1fv",
+ "glProgramUniform1iv",
+ "glProgramUniform1uiv",
+ "glProgramUniform2dv",
+ "glProgramUniform2fv",
+ "glProgramUniform2iv",
+ "glProgramUniform2uiv",
+ "glProgramUniform3dv",
+ "glProgramUniform3fv",
+ "glProgramUniform3iv",
+ "glProgramUniform3uiv",
+ "glProgramUniform4dv",
+ "glProgramUniform4fv",
+ "glProgramUniform4iv",
+ "glProgramUniform4uiv",
+ "glProgramUniformMatrix2dv",
+ "glProgramUniformMatrix2fv",
+ "glProgramUniformMatrix2x3dv",
+ "glProgramUniformMatrix2x3fv",
+ "glProgramUniformMatrix2x4dv",
+ "glProgramUniformMatrix2x4fv",
+ "glProgramUniformMatrix3dv",
+ "glProgramUniformMatrix3fv",
+ "glProgramUniformMatrix3x2dv",
+ "glProgramUniformMatrix3x2fv",
+ "glProgramUniformMatrix3x4dv",
+ "glProgramUniformMatrix3x4fv",
+ "glProgramUniformMatrix4dv",
+ "glProgramUniformMatrix4fv",
+ "glProgramUniformMatrix4x2dv",
+ "glProgramUniformMatrix4x2fv",
+ "glProgramUniformMatrix4x3dv",
+ "glProgramUniformMatrix4x3fv",
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+ "glDebugMessageCallback",
+ "glDebugMessageControl",
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+ "glGetNamedBufferParameteriv",
+ "glMapNamedBufferRange",
+ "glUnmapNamedBuffer",
+#endif /* GL_VERSION_4_5 */
+ NULL
+};
+
+static void glducktape_record(int idx, unsigned long long t0) {
+	unsigned long long ns= glducktape_now_ns() - t0;
+	glducktape_stats[idx].calls++;
+	glducktape_stats[idx].ns += ns;
+	if (glducktape_cur_scope) {
+		glducktape_cur_scope->gl.calls++;
+		glducktape_cur_scope->gl.ns += ns;
+	}
+}
+
+#ifdef GL_VERSION_1_1
+static void APIENTRY glducktape_prof_glBindTexture(GLenum target, GLuint texture) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->BindTexture(target, texture);
+	glducktape_record(glducktape_idx_glBindTexture, t0);
+}
+static void APIENTRY glducktape_prof_glDeleteTextures(GLsizei n, const GLuint *textures) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DeleteTextures(n, textures);
+	glducktape_record(glducktape_idx_glDeleteTextures, t0);
+}
+static void APIENTRY glducktape_prof_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DrawArrays(mode, first, count);
+	glducktape_record(glducktape_idx_glDrawArrays, t0);
+}
+static void APIENTRY glducktape_prof_glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DrawElements(mode, count, type, indices);
+	glducktape_record(glducktape_idx_glDrawElements, t0);
+}
+static void APIENTRY glducktape_prof_glGenTextures(GLsizei n, GLuint *textures) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GenTextures(n, textures);
+	glducktape_record(glducktape_idx_glGenTextures, t0);
+}
+static void APIENTRY glducktape_prof_glPixelStorei(GLenum pname, GLint param) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->PixelStorei(pname, param);
+	glducktape_record(glducktape_idx_glPixelStorei, t0);
+}
+static void APIENTRY glducktape_prof_glTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->TexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+	glducktape_record(glducktape_idx_glTexImage2D, t0);
+}
+static void APIENTRY glducktape_prof_glTexParameteri(GLenum target, GLenum pname, GLint param) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->TexParameteri(target, pname, param);
+	glducktape_record(glducktape_idx_glTexParameteri, t0);
+}
+static void APIENTRY glducktape_prof_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->TexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+	glducktape_record(glducktape_idx_glTexSubImage2D, t0);
+}
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+static void APIENTRY glducktape_prof_glDeleteQueries(GLsizei n, const GLuint *ids) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DeleteQueries(n, ids);
+	glducktape_record(glducktape_idx_glDeleteQueries, t0);
+}
+static void APIENTRY glducktape_prof_glGenQueries(GLsizei n, GLuint *ids) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GenQueries(n, ids);
+	glducktape_record(glducktape_idx_glGenQueries, t0);
+}
+static void APIENTRY glducktape_prof_glGetQueryObjectiv(GLuint id, GLenum pname, GLint *params) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GetQueryObjectiv(id, pname, params);
+	glducktape_record(glducktape_idx_glGetQueryObjectiv, t0);
+}
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+static void APIENTRY glducktape_prof_glAttachShader(GLuint program, GLuint shader) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->AttachShader(program, shader);
+	glducktape_record(glducktape_idx_glAttachShader, t0);
+}
+static void APIENTRY glducktape_prof_glBindBuffer(GLenum target, GLuint buffer) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->BindBuffer(target, buffer);
+	glducktape_record(glducktape_idx_glBindBuffer, t0);
+}
+static void APIENTRY glducktape_prof_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->BufferData(target, size, data, usage);
+	glducktape_record(glducktape_idx_glBufferData, t0);
+}
+static void APIENTRY glducktape_prof_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->BufferSubData(target, offset, size, data);
+	glducktape_record(glducktape_idx_glBufferSubData, t0);
+}
+static void APIENTRY glducktape_prof_glCompileShader(GLuint shader) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->CompileShader(shader);
+	glducktape_record(glducktape_idx_glCompileShader, t0);
+}
+static GLuint APIENTRY glducktape_prof_glCreateProgram(void) {
+	unsigned long long t0= glducktape_now_ns();
+	GLuint ret= glducktape_active->CreateProgram();
+	glducktape_record(glducktape_idx_glCreateProgram, t0);
+	return ret;
+}
+static GLuint APIENTRY glducktape_prof_glCreateShader(GLenum type) {
+	unsigned long long t0= glducktape_now_ns();
+	GLuint ret= glducktape_active->CreateShader(type);
+	glducktape_record(glducktape_idx_glCreateShader, t0);
+	return ret;
+}
+static void APIENTRY glducktape_prof_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DeleteBuffers(n, buffers);
+	glducktape_record(glducktape_idx_glDeleteBuffers, t0);
+}
+static void APIENTRY glducktape_prof_glDeleteProgram(GLuint program) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DeleteProgram(program);
+	glducktape_record(glducktape_idx_glDeleteProgram, t0);
+}
+static void APIENTRY glducktape_prof_glDeleteShader(GLuint shader) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DeleteShader(shader);
+	glducktape_record(glducktape_idx_glDeleteShader, t0);
+}
+static void APIENTRY glducktape_prof_glDetachShader(GLuint program, GLuint shader) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DetachShader(program, shader);
+	glducktape_record(glducktape_idx_glDetachShader, t0);
+}
+static void APIENTRY glducktape_prof_glDisableVertexAttribArray(GLuint index) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DisableVertexAttribArray(index);
+	glducktape_record(glducktape_idx_glDisableVertexAttribArray, t0);
+}
+static void APIENTRY glducktape_prof_glEnableVertexAttribArray(GLuint index) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->EnableVertexAttribArray(index);
+	glducktape_record(glducktape_idx_glEnableVertexAttribArray, t0);
+}
+static void APIENTRY glducktape_prof_glGenBuffers(GLsizei n, GLuint *buffers) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GenBuffers(n, buffers);
+	glducktape_record(glducktape_idx_glGenBuffers, t0);
+}
+static void APIENTRY glducktape_prof_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GetActiveUniform(program, index, bufSize, length, size, type, name);
+	glducktape_record(glducktape_idx_glGetActiveUniform, t0);
+}
+static void APIENTRY glducktape_prof_glGetBufferParameteriv(GLenum target, GLenum pname, GLint *params) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GetBufferParameteriv(target, pname, params);
+	glducktape_record(glducktape_idx_glGetBufferParameteriv, t0);
+}
+static void APIENTRY glducktape_prof_glGetProgramiv(GLuint program, GLenum pname, GLint *params) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GetProgramiv(program, pname, params);
+	glducktape_record(glducktape_idx_glGetProgramiv, t0);
+}
+static GLint APIENTRY glducktape_prof_glGetUniformLocation(GLuint program, const GLchar *name) {
+	unsigned long long t0= glducktape_now_ns();
+	GLint ret= glducktape_active->GetUniformLocation(program, name);
+	glducktape_record(glducktape_idx_glGetUniformLocation, t0);
+	return ret;
+}
+static void APIENTRY glducktape_prof_glLinkProgram(GLuint program) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->LinkProgram(program);
+	glducktape_record(glducktape_idx_glLinkProgram, t0);
+}
+static void * APIENTRY glducktape_prof_glMapBuffer(GLenum target, GLenum access) {
+	unsigned long long t0= glducktape_now_ns();
+	void * ret= glducktape_active->MapBuffer(target, access);
+	glducktape_record(glducktape_idx_glMapBuffer, t0);
+	return ret;
+}
+static void APIENTRY glducktape_prof_glShaderSource(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ShaderSource(shader, count, string, length);
+	glducktape_record(glducktape_idx_glShaderSource, t0);
+}
+static void APIENTRY glducktape_prof_glUniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform1fv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform1fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform1iv(GLint location, GLsizei count, const GLint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform1iv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform1iv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform2fv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform2fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform2iv(GLint location, GLsizei count, const GLint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform2iv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform2iv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform3fv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform3fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform3iv(GLint location, GLsizei count, const GLint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform3iv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform3iv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform4fv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform4fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform4iv(GLint location, GLsizei count, const GLint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform4iv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform4iv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix2fv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix2fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix3fv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix3fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix4fv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix4fv, t0);
+}
+static GLboolean APIENTRY glducktape_prof_glUnmapBuffer(GLenum target) {
+	unsigned long long t0= glducktape_now_ns();
+	GLboolean ret= glducktape_active->UnmapBuffer(target);
+	glducktape_record(glducktape_idx_glUnmapBuffer, t0);
+	return ret;
+}
+static void APIENTRY glducktape_prof_glUseProgram(GLuint program) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UseProgram(program);
+	glducktape_record(glducktape_idx_glUseProgram, t0);
+}
+static void APIENTRY glducktape_prof_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->VertexAttribPointer(index, size, type, normalized, stride, pointer);
+	glducktape_record(glducktape_idx_glVertexAttribPointer, t0);
+}
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+static void APIENTRY glducktape_prof_glUniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix2x3fv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix2x3fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix2x4fv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix2x4fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix3x2fv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix3x2fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix3x4fv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix3x4fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix4x2fv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix4x2fv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix4x3fv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix4x3fv, t0);
+}
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+static void APIENTRY glducktape_prof_glBindVertexArray(GLuint array) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->BindVertexArray(array);
+	glducktape_record(glducktape_idx_glBindVertexArray, t0);
+}
+static void APIENTRY glducktape_prof_glDeleteVertexArrays(GLsizei n, const GLuint *arrays) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DeleteVertexArrays(n, arrays);
+	glducktape_record(glducktape_idx_glDeleteVertexArrays, t0);
+}
+static void APIENTRY glducktape_prof_glGenVertexArrays(GLsizei n, GLuint *arrays) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GenVertexArrays(n, arrays);
+	glducktape_record(glducktape_idx_glGenVertexArrays, t0);
+}
+static void APIENTRY glducktape_prof_glGenerateMipmap(GLenum target) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GenerateMipmap(target);
+	glducktape_record(glducktape_idx_glGenerateMipmap, t0);
+}
+static const GLubyte * APIENTRY glducktape_prof_glGetStringi(GLenum name, GLuint index) {
+	unsigned long long t0= glducktape_now_ns();
+	const GLubyte * ret= glducktape_active->GetStringi(name, index);
+	glducktape_record(glducktape_idx_glGetStringi, t0);
+	return ret;
+}
+static void * APIENTRY glducktape_prof_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	unsigned long long t0= glducktape_now_ns();
+	void * ret= glducktape_active->MapBufferRange(target, offset, length, access);
+	glducktape_record(glducktape_idx_glMapBufferRange, t0);
+	return ret;
+}
+static void APIENTRY glducktape_prof_glUniform1uiv(GLint location, GLsizei count, const GLuint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform1uiv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform1uiv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform2uiv(GLint location, GLsizei count, const GLuint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform2uiv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform2uiv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform3uiv(GLint location, GLsizei count, const GLuint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform3uiv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform3uiv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform4uiv(GLint location, GLsizei count, const GLuint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform4uiv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform4uiv, t0);
+}
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+static GLenum APIENTRY glducktape_prof_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+	unsigned long long t0= glducktape_now_ns();
+	GLenum ret= glducktape_active->ClientWaitSync(sync, flags, timeout);
+	glducktape_record(glducktape_idx_glClientWaitSync, t0);
+	return ret;
+}
+static void APIENTRY glducktape_prof_glDeleteSync(GLsync sync) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DeleteSync(sync);
+	glducktape_record(glducktape_idx_glDeleteSync, t0);
+}
+static GLsync APIENTRY glducktape_prof_glFenceSync(GLenum condition, GLbitfield flags) {
+	unsigned long long t0= glducktape_now_ns();
+	GLsync ret= glducktape_active->FenceSync(condition, flags);
+	glducktape_record(glducktape_idx_glFenceSync, t0);
+	return ret;
+}
+static void APIENTRY glducktape_prof_glGetInteger64v(GLenum pname, GLint64 *data) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GetInteger64v(pname, data);
+	glducktape_record(glducktape_idx_glGetInteger64v, t0);
+}
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+static void APIENTRY glducktape_prof_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GetQueryObjectui64v(id, pname, params);
+	glducktape_record(glducktape_idx_glGetQueryObjectui64v, t0);
+}
+static void APIENTRY glducktape_prof_glQueryCounter(GLuint id, GLenum target) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->QueryCounter(id, target);
+	glducktape_record(glducktape_idx_glQueryCounter, t0);
+}
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+static void APIENTRY glducktape_prof_glUniform1dv(GLint location, GLsizei count, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform1dv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform1dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform2dv(GLint location, GLsizei count, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform2dv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform2dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform3dv(GLint location, GLsizei count, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform3dv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform3dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniform4dv(GLint location, GLsizei count, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->Uniform4dv(location, count, value);
+	glducktape_record(glducktape_idx_glUniform4dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix2dv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix2dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix2x3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix2x3dv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix2x3dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix2x4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix2x4dv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix2x4dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix3dv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix3dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix3x2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix3x2dv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix3x2dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix3x4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix3x4dv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix3x4dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix4dv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix4dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix4x2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix4x2dv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix4x2dv, t0);
+}
+static void APIENTRY glducktape_prof_glUniformMatrix4x3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->UniformMatrix4x3dv(location, count, transpose, value);
+	glducktape_record(glducktape_idx_glUniformMatrix4x3dv, t0);
+}
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+static void APIENTRY glducktape_prof_glProgramUniform1dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform1dv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform1dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform1fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform1fv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform1fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform1iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform1iv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform1iv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform1uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform1uiv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform1uiv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform2dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform2dv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform2dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform2fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform2fv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform2fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform2iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform2iv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform2iv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform2uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform2uiv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform2uiv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform3dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform3dv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform3dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform3fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform3fv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform3fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform3iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform3iv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform3iv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform3uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform3uiv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform3uiv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform4dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform4dv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform4dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform4fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform4fv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform4fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform4iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform4iv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform4iv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniform4uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniform4uiv(program, location, count, value);
+	glducktape_record(glducktape_idx_glProgramUniform4uiv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix2dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix2dv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix2dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix2fv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix2fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix2x3dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix2x3dv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix2x3dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix2x3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix2x3fv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix2x3fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix2x4dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix2x4dv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix2x4dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix2x4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix2x4fv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix2x4fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix3dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix3dv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix3dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix3fv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix3fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix3x2dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix3x2dv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix3x2dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix3x2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix3x2fv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix3x2fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix3x4dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix3x4dv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix3x4dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix3x4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix3x4fv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix3x4fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix4dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix4dv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix4dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix4fv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix4fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix4x2dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix4x2dv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix4x2dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix4x2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix4x2fv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix4x2fv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix4x3dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix4x3dv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix4x3dv, t0);
+}
+static void APIENTRY glducktape_prof_glProgramUniformMatrix4x3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->ProgramUniformMatrix4x3fv(program, location, count, transpose, value);
+	glducktape_record(glducktape_idx_glProgramUniformMatrix4x3fv, t0);
+}
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+static void APIENTRY glducktape_prof_glDebugMessageCallback(GLDEBUGPROC callback, const void *userParam) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DebugMessageCallback(callback, userParam);
+	glducktape_record(glducktape_idx_glDebugMessageCallback, t0);
+}
+static void APIENTRY glducktape_prof_glDebugMessageControl(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->DebugMessageControl(source, type, severity, count, ids, enabled);
+	glducktape_record(glducktape_idx_glDebugMessageControl, t0);
+}
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+static void APIENTRY glducktape_prof_glGetNamedBufferParameteriv(GLuint buffer, GLenum pname, GLint *params) {
+	unsigned long long t0= glducktape_now_ns();
+	glducktape_active->GetNamedBufferParameteriv(buffer, pname, params);
+	glducktape_record(glducktape_idx_glGetNamedBufferParameteriv, t0);
+}
+static void * APIENTRY glducktape_prof_glMapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	unsigned long long t0= glducktape_now_ns();
+	void * ret= glducktape_active->MapNamedBufferRange(buffer, offset, length, access);
+	glducktape_record(glducktape_idx_glMapNamedBufferRange, t0);
+	return ret;
+}
+static GLboolean APIENTRY glducktape_prof_glUnmapNamedBuffer(GLuint buffer) {
+	unsigned long long t0= glducktape_now_ns();
+	GLboolean ret= glducktape_active->UnmapNamedBuffer(buffer);
+	glducktape_record(glducktape_idx_glUnmapNamedBuffer, t0);
+	return ret;
+}
+#endif /* GL_VERSION_4_5 */
+
+static struct glducktape_dispatch glducktape_prof= {
+#ifdef GL_VERSION_1_1
+ glducktape_prof_glBindTexture,
+ glducktape_prof_glDeleteTextures,
+ glducktape_prof_glDrawArrays,
+ glducktape_prof_glDrawElements,
+ glducktape_prof_glGenTextures,
+ glducktape_prof_glPixelStorei,
+ glducktape_prof_glTexImage2D,
+ glducktape_prof_glTexParameteri,
+ glducktape_prof_glTexSubImage2D,
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+ glducktape_prof_glDeleteQueries,
+ glducktape_prof_glGenQueries,
+ glducktape_prof_glGetQueryObjectiv,
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+ glducktape_prof_glAttachShader,
+ glducktape_prof_glBindBuffer,
+ glducktape_prof_glBufferData,
+ glducktape_prof_glBufferSubData,
+ glducktape_prof_glCompileShader,
+ glducktape_prof_glCreateProgram,
+ glducktape_prof_glCreateShader,
+ glducktape_prof_glDeleteBuffers,
+ glducktape_prof_glDeleteProgram,
+ glducktape_prof_glDeleteShader,
+ glducktape_prof_glDetachShader,
+ glducktape_prof_glDisableVertexAttribArray,
+ glducktape_prof_glEnableVertexAttribArray,
+ glducktape_prof_glGenBuffers,
+ glducktape_prof_glGetActiveUniform,
+ glducktape_prof_glGetBufferParameteriv,
+ glducktape_prof_glGetProgramiv,
+ glducktape_prof_glGetUniformLocation,
+ glducktape_prof_glLinkProgram,
+ glducktape_prof_glMapBuffer,
+ glducktape_prof_glShaderSource,
+ glducktape_prof_glUniform1fv,
+ glducktape_prof_glUniform1iv,
+ glducktape_prof_glUniform2fv,
+ glducktape_prof_glUniform2iv,
+ glducktape_prof_glUniform3fv,
+ glducktape_prof_glUniform3iv,
+ glducktape_prof_glUniform4fv,
+ glducktape_prof_glUniform4iv,
+ glducktape_prof_glUniformMatrix2fv,
+ glducktape_prof_glUniformMatrix3fv,
+ glducktape_prof_glUniformMatrix4fv,
+ glducktape_prof_glUnmapBuffer,
+ glducktape_prof_glUseProgram,
+ glducktape_prof_glVertexAttribPointer,
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+ glducktape_prof_glUniformMatrix2x3fv,
+ glducktape_prof_glUniformMatrix2x4fv,
+ glducktape_prof_glUniformMatrix3x2fv,
+ glducktape_prof_glUniformMatrix3x4fv,
+ glducktape_prof_glUniformMatrix4x2fv,
+ glducktape_prof_glUniformMatrix4x3fv,
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+ glducktape_prof_glBindVertexArray,
+ glducktape_prof_glDeleteVertexArrays,
+ glducktape_prof_glGenVertexArrays,
+ glducktape_prof_glGenerateMipmap,
+ glducktape_prof_glGetStringi,
+ glducktape_prof_glMapBufferRange,
+ glducktape_prof_glUniform1uiv,
+ glducktape_prof_glUniform2uiv,
+ glducktape_prof_glUniform3uiv,
+ glducktape_prof_glUniform4uiv,
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+ glducktape_prof_glClientWaitSync,
+ glducktape_prof_glDeleteSync,
+ glducktape_prof_glFenceSync,
+ glducktape_prof_glGetInteger64v,
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+ glducktape_prof_glGetQueryObjectui64v,
+ glducktape_prof_glQueryCounter,
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+ glducktape_prof_glUniform1dv,
+ glducktape_prof_glUniform2dv,
+ glducktape_prof_glUniform3dv,
+ glducktape_prof_glUniform4dv,
+ glducktape_prof_glUniformMatrix2dv,
+ glducktape_prof_glUniformMatrix2x3dv,
+ glducktape_prof_glUniformMatrix2x4dv,
+ glducktape_prof_glUniformMatrix3dv,
+ glducktape_prof_glUniformMatrix3x2dv,
+ glducktape_prof_glUniformMatrix3x4dv,
+ glducktape_prof_glUniformMatrix4dv,
+ glducktape_prof_glUniformMatrix4x2dv,
+ glducktape_prof_glUniformMatrix4x3dv,
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+ glducktape_prof_glProgramUniform1dv,
+ glducktape_prof_glProgramUniform1fv,
+ glducktape_prof_glProgramUniform1iv,
+ glducktape_prof_glProgramUniform1uiv,
+ glducktape_prof_glProgramUniform2dv,
+ glducktape_prof_glProgramUniform2fv,
+ glducktape_prof_glProgramUniform2iv,
+ glducktape_prof_glProgramUniform2uiv,
+ glducktape_prof_glProgramUniform3dv,
+ glducktape_prof_glProgramUniform3fv,
+ glducktape_prof_glProgramUniform3iv,
+ glducktape_prof_glProgramUniform3uiv,
+ glducktape_prof_glProgramUniform4dv,
+ glducktape_prof_glProgramUniform4fv,
+ glducktape_prof_glProgramUniform4iv,
+ glducktape_prof_glProgramUniform4uiv,
+ glducktape_prof_glProgramUniformMatrix2dv,
+ glducktape_prof_glProgramUniformMatrix2fv,
+ glducktape_prof_glProgramUniformMatrix2x3dv,
+ glducktape_prof_glProgramUniformMatrix2x3fv,
+ glducktape_prof_glProgramUniformMatrix2x4dv,
+ glducktape_prof_glProgramUniformMatrix2x4fv,
+ glducktape_prof_glProgramUniformMatrix3dv,
+ glducktape_prof_glProgramUniformMatrix3fv,
+ glducktape_prof_glProgramUniformMatrix3x2dv,
+ glducktape_prof_glProgramUniformMatrix3x2fv,
+ glducktape_prof_glProgramUniformMatrix3x4dv,
+ glducktape_prof_glProgramUniformMatrix3x4fv,
+ glducktape_prof_glProgramUniformMatrix4dv,
+ glducktape_prof_glProgramUniformMatrix4fv,
+ glducktape_prof_glProgramUniformMatrix4x2dv,
+ glducktape_prof_glProgramUniformMatrix4x2fv,
+ glducktape_prof_glProgramUniformMatrix4x3dv,
+ glducktape_prof_glProgramUniformMatrix4x3fv,
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+ glducktape_prof_glDebugMessageCallback,
+ glducktape_prof_glDebugMessageControl,
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+ glducktape_prof_glGetNamedBufferParameteriv,
+ glducktape_prof_glMapNamedBufferRange,
+ glducktape_prof_glUnmapNamedBuffer,
+#endif /* GL_VERSION_4_5 */
+ 0
+};
+
+/* Turn the counting wrappers on or off */
+void glducktape_profile(int enable) {
+	glducktape_profiling= enable;
+	glducktape_cur_scope= NULL;
+	glducktape_route();
+}
+
+void glducktape_profile_reset(void) {
+	struct glducktape_scope *scope;
+	memset(glducktape_stats, 0, sizeof(glducktape_stats));
+	for (scope= glducktape_scopes; scope; scope= scope->next) {
+		memset(&scope->total, 0, sizeof(scope->total));
+		memset(&scope->gl, 0, sizeof(scope->gl));
+	}
+}
+
+/* Called on entry to a function that wants its GL calls totalled separately.
+ * GL calls are credited to the innermost scope.
+ */
+unsigned long long glducktape_scope_enter(struct glducktape_scope *scope) {
+	if (!scope->registered) {
+		scope->next= glducktape_scopes;
+		glducktape_scopes= scope;
+		scope->registered= 1;
+	}
+	scope->outer= glducktape_cur_scope;
+	glducktape_cur_scope= scope;
+	return glducktape_now_ns();
+}
+
+void glducktape_scope_leave(struct glducktape_scope *scope, unsigned long long t0) {
+	scope->total.calls++;
+	scope->total.ns += glducktape_now_ns() - t0;
+	glducktape_cur_scope= scope->outer;
+}
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int glducktape_capturing= 0;
+static FILE *glducktape_cap_fh= NULL;
+static unsigned char *glducktape_cap_buf= NULL;
+static size_t glducktape_cap_len= 0, glducktape_cap_alloc= 0;
+static int glducktape_cap_failed= 0;
+/* The table that the capture wrappers pass calls on to */
+static struct glducktape_dispatch *glducktape_capture_next= &glducktape_lazy;
+
+static void glducktape_cap_bytes(const void *data, size_t n) {
+	if (glducktape_cap_len + n > glducktape_cap_alloc) {
+		size_t alloc= glducktape_cap_alloc? glducktape_cap_alloc : 4096;
+		unsigned char *buf;
+		while (alloc < glducktape_cap_len + n) alloc *= 2;
+		if (!(buf= (unsigned char*) realloc(glducktape_cap_buf, alloc))) {
+			glducktape_cap_failed= 1;
+			return;
+		}
+		glducktape_cap_buf= buf;
+		glducktape_cap_alloc= alloc;
+	}
+	memcpy(glducktape_cap_buf + glducktape_cap_len, data, n);
+	glducktape_cap_len += n;
+}
+
+static void glducktape_cap_int(long long v) { glducktape_cap_bytes(&v, 8); }
+
+static void glducktape_cap_payload(const void *data, size_t n) {
+	static const unsigned char pad[8]= { 0 };
+	unsigned long long len= data? n : ~0ULL;
+	glducktape_cap_bytes(&len, 8);
+	if (data) {
+		glducktape_cap_bytes(data, n);
+		glducktape_cap_bytes(pad, (8 - n % 8) % 8);
+	}
+}
+
+static void glducktape_cap_begin(void) { glducktape_cap_len= 0; }
+
+static void glducktape_cap_write(unsigned short idx, const void *body, unsigned int len) {
+	if (fwrite(&idx, 2, 1, glducktape_cap_fh) != 1
+		|| fwrite(&len, 4, 1, glducktape_cap_fh) != 1
+		|| (len && fwrite(body, len, 1, glducktape_cap_fh) != 1)
+	)
+		glducktape_cap_failed= 1;
+}
+
+static void glducktape_cap_end(int idx) {
+	glducktape_cap_write((unsigned short) idx, glducktape_cap_buf, (unsigned int) glducktape_cap_len);
+}
+
+/* Buffers currently mapped, by target or by buffer name */
+struct glducktape_mapping { int named; GLuint key; unsigned char *addr; size_t len; int write; };
+static struct glducktape_mapping glducktape_maps[16];
+
+static void glducktape_map_set(int named, GLuint key, void *addr, size_t len, int write) {
+	int i, slot= -1;
+	for (i= 0; i < 16; i++) {
+		if (glducktape_maps[i].addr && glducktape_maps[i].named == named && glducktape_maps[i].key == key)
+			break;
+		if (!glducktape_maps[i].addr && slot < 0) slot= i;
+	}
+	if (i < 16) slot= i;
+	if (slot < 0) return; /* too many; its writes won't be captured */
+	glducktape_maps[slot].named= named;
+	glducktape_maps[slot].key= key;
+	glducktape_maps[slot].addr= (unsigned char*) addr;
+	glducktape_maps[slot].len= len;
+	glducktape_maps[slot].write= write;
+}
+
+/* Remove and return the mapping, or NULL */
+static struct glducktape_mapping* glducktape_map_take(int named, GLuint key) {
+	static struct glducktape_mapping m;
+	int i;
+	for (i= 0; i < 16; i++) {
+		if (glducktape_maps[i].addr && glducktape_maps[i].named == named && glducktape_maps[i].key == key) {
+			m= glducktape_maps[i];
+			glducktape_maps[i].addr= NULL;
+			return &m;
+		}
+	}
+	return NULL;
+}
+
+/* Bytes of client memory that a texture upload reads, given the pixel store state, or 0 if the
+ * format or type isn't known */
+static size_t glducktape_pixels_size(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+	GLint align= 4, row_len= 0, skip_rows= 0, skip_pixels= 0;
+	size_t comps, bpp, row;
+	switch (format) {
+	case GL_RED: case GL_GREEN: case GL_BLUE: case GL_ALPHA: case GL_LUMINANCE:
+	case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: case GL_RED_INTEGER:
+		comps= 1; break;
+	case GL_RG: case GL_LUMINANCE_ALPHA: case GL_RG_INTEGER: case GL_DEPTH_STENCIL:
+		comps= 2; break;
+	case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+		comps= 3; break;
+	case GL_RGBA: case GL_BGRA: case GL_RGBA_INTEGER: case GL_BGRA_INTEGER:
+		comps= 4; break;
+	default: return 0;
+	}
+	switch (type) {
+	case GL_UNSIGNED_BYTE: case GL_BYTE:
+		bpp= comps; break;
+	case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT:
+		bpp= comps * 2; break;
+	case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT:
+		bpp= comps * 4; break;
+	case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV:
+		bpp= 1; break;
+	case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_5_6_5_REV:
+	case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+	case GL_UNSIGNED_SHORT_5_5_5_1: case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+		bpp= 2; break;
+	case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV:
+	case GL_UNSIGNED_INT_10_10_10_2: case GL_UNSIGNED_INT_2_10_10_10_REV:
+	case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV: case GL_UNSIGNED_INT_5_9_9_9_REV:
+		bpp= 4; break;
+	default: return 0;
+	}
+	if (width <= 0 || height <= 0) return 0;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &align);
+	glGetIntegerv(GL_UNPACK_ROW_LENGTH, &row_len);
+	glGetIntegerv(GL_UNPACK_SKIP_ROWS, &skip_rows);
+	glGetIntegerv(GL_UNPACK_SKIP_PIXELS, &skip_pixels);
+	if (align < 1) align= 1;
+	row= ((size_t)(row_len > 0? row_len : width) * bpp + align - 1) / align * align;
+	return (size_t)(skip_rows + height - 1) * row + (size_t)(skip_pixels + width) * bpp;
+}
+
+/* Whether the context has pixel unpack buffers, so that querying the binding isn't an error */
+static int glducktape_cap_has_pbo= 0;
+
+/* The pixels of a texture upload: whether they are an offset into the bound unpack buffer,
+ * then the offset, or the bytes they point to.
+ */
+static void glducktape_cap_pixels(const void *pixels, GLsizei width, GLsizei height, GLenum format, GLenum type) {
+	GLint pbo= 0;
+	size_t n;
+#ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
+	if (glducktape_cap_has_pbo)
+		glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &pbo);
+#endif
+	glducktape_cap_int(pbo != 0);
+	if (pbo) {
+		glducktape_cap_int((long long)(size_t) pixels);
+		return;
+	}
+	n= pixels? glducktape_pixels_size(width, height, format, type) : 0;
+	glducktape_cap_payload(n? pixels : NULL, n);
+}
+
+/* The strings of glShaderSource, joined into one payload */
+static void glducktape_cap_sources(GLsizei count, const GLchar *const *string, const GLint *length) {
+	static const unsigned char pad[8]= { 0 };
+	unsigned long long len= 0;
+	GLsizei i;
+	for (i= 0; i < count; i++)
+		len += length && length[i] >= 0? (size_t) length[i] : strlen(string[i]);
+	glducktape_cap_bytes(&len, 8);
+	for (i= 0; i < count; i++)
+		glducktape_cap_bytes(string[i], length && length[i] >= 0? (size_t) length[i] : strlen(string[i]));
+	glducktape_cap_bytes(pad, (8 - len % 8) % 8);
+}
+
+/* Write the contents of a buffer which is about to be unmapped */
+static void glducktape_cap_unmap(int named, GLuint key) {
+	struct glducktape_mapping *m= glducktape_map_take(named, key);
+	glducktape_cap_payload(m && m->write? m->addr : NULL, m? m->len : 0);
+}
+
+#ifdef GL_VERSION_1_1
+static void APIENTRY glducktape_cap_glBindTexture(GLenum target, GLuint texture) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) texture);
+	glducktape_capture_next->BindTexture(target, texture);
+	glducktape_cap_end(glducktape_idx_glBindTexture);
+}
+static void APIENTRY glducktape_cap_glDeleteTextures(GLsizei n, const GLuint *textures) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) n);
+	glducktape_cap_payload(textures, textures? (size_t)(n * sizeof(GLuint)) : 0);
+	glducktape_capture_next->DeleteTextures(n, textures);
+	glducktape_cap_end(glducktape_idx_glDeleteTextures);
+}
+static void APIENTRY glducktape_cap_glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) mode);
+	glducktape_cap_int((long long) first);
+	glducktape_cap_int((long long) count);
+	glducktape_capture_next->DrawArrays(mode, first, count);
+	glducktape_cap_end(glducktape_idx_glDrawArrays);
+}
+static void APIENTRY glducktape_cap_glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) mode);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) type);
+	glducktape_cap_int((long long)(size_t) indices);
+	glducktape_capture_next->DrawElements(mode, count, type, indices);
+	glducktape_cap_end(glducktape_idx_glDrawElements);
+}
+static void APIENTRY glducktape_cap_glGenTextures(GLsizei n, GLuint *textures) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) n);
+	glducktape_capture_next->GenTextures(n, textures);
+	glducktape_cap_payload(textures, n > 0? (size_t)(n * sizeof(GLuint)) : 0);
+	glducktape_cap_end(glducktape_idx_glGenTextures);
+}
+static void APIENTRY glducktape_cap_glPixelStorei(GLenum pname, GLint param) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) pname);
+	glducktape_cap_int((long long) param);
+	glducktape_capture_next->PixelStorei(pname, param);
+	glducktape_cap_end(glducktape_idx_glPixelStorei);
+}
+static void APIENTRY glducktape_cap_glTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid *pixels) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) level);
+	glducktape_cap_int((long long) internalFormat);
+	glducktape_cap_int((long long) width);
+	glducktape_cap_int((long long) height);
+	glducktape_cap_int((long long) border);
+	glducktape_cap_int((long long) format);
+	glducktape_cap_int((long long) type);
+	glducktape_cap_pixels(pixels, width, height, format, type);
+	glducktape_capture_next->TexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+	glducktape_cap_end(glducktape_idx_glTexImage2D);
+}
+static void APIENTRY glducktape_cap_glTexParameteri(GLenum target, GLenum pname, GLint param) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) pname);
+	glducktape_cap_int((long long) param);
+	glducktape_capture_next->TexParameteri(target, pname, param);
+	glducktape_cap_end(glducktape_idx_glTexParameteri);
+}
+static void APIENTRY glducktape_cap_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid *pixels) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) level);
+	glducktape_cap_int((long long) xoffset);
+	glducktape_cap_int((long long) yoffset);
+	glducktape_cap_int((long long) width);
+	glducktape_cap_int((long long) height);
+	glducktape_cap_int((long long) format);
+	glducktape_cap_int((long long) type);
+	glducktape_cap_pixels(pixels, width, height, format, type);
+	glducktape_capture_next->TexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+	glducktape_cap_end(glducktape_idx_glTexSubImage2D);
+}
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+static void APIENTRY glducktape_cap_glDeleteQueries(GLsizei n, const GLuint *ids) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) n);
+	glducktape_cap_payload(ids, ids? (size_t)(n * sizeof(GLuint)) : 0);
+	glducktape_capture_next->DeleteQueries(n, ids);
+	glducktape_cap_end(glducktape_idx_glDeleteQueries);
+}
+static void APIENTRY glducktape_cap_glGenQueries(GLsizei n, GLuint *ids) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) n);
+	glducktape_capture_next->GenQueries(n, ids);
+	glducktape_cap_payload(ids, n > 0? (size_t)(n * sizeof(GLuint)) : 0);
+	glducktape_cap_end(glducktape_idx_glGenQueries);
+}
+static void APIENTRY glducktape_cap_glGetQueryObjectiv(GLuint id, GLenum pname, GLint *params) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) id);
+	glducktape_cap_int((long long) pname);
+	glducktape_capture_next->GetQueryObjectiv(id, pname, params);
+	glducktape_cap_end(glducktape_idx_glGetQueryObjectiv);
+}
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+static void APIENTRY glducktape_cap_glAttachShader(GLuint program, GLuint shader) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) shader);
+	glducktape_capture_next->AttachShader(program, shader);
+	glducktape_cap_end(glducktape_idx_glAttachShader);
+}
+static void APIENTRY glducktape_cap_glBindBuffer(GLenum target, GLuint buffer) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) buffer);
+	glducktape_capture_next->BindBuffer(target, buffer);
+	glducktape_cap_end(glducktape_idx_glBindBuffer);
+}
+static void APIENTRY glducktape_cap_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) size);
+	glducktape_cap_payload(data, data? (size_t)(size) : 0);
+	glducktape_cap_int((long long) usage);
+	glducktape_capture_next->BufferData(target, size, data, usage);
+	glducktape_cap_end(glducktape_idx_glBufferData);
+}
+static void APIENTRY glducktape_cap_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) offset);
+	glducktape_cap_int((long long) size);
+	glducktape_cap_payload(data, data? (size_t)(size) : 0);
+	glducktape_capture_next->BufferSubData(target, offset, size, data);
+	glducktape_cap_end(glducktape_idx_glBufferSubData);
+}
+static void APIENTRY glducktape_cap_glCompileShader(GLuint shader) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) shader);
+	glducktape_capture_next->CompileShader(shader);
+	glducktape_cap_end(glducktape_idx_glCompileShader);
+}
+static GLuint APIENTRY glducktape_cap_glCreateProgram(void) {
+	GLuint ret;
+	glducktape_cap_begin();
+	ret= glducktape_capture_next->CreateProgram();
+	glducktape_cap_int((long long) ret);
+	glducktape_cap_end(glducktape_idx_glCreateProgram);
+	return ret;
+}
+static GLuint APIENTRY glducktape_cap_glCreateShader(GLenum type) {
+	GLuint ret;
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) type);
+	ret= glducktape_capture_next->CreateShader(type);
+	glducktape_cap_int((long long) ret);
+	glducktape_cap_end(glducktape_idx_glCreateShader);
+	return ret;
+}
+static void APIENTRY glducktape_cap_glDeleteBuffers(GLsizei n, const GLuint *buffers) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) n);
+	glducktape_cap_payload(buffers, buffers? (size_t)(n * sizeof(GLuint)) : 0);
+	glducktape_capture_next->DeleteBuffers(n, buffers);
+	glducktape_cap_end(glducktape_idx_glDeleteBuffers);
+}
+static void APIENTRY glducktape_cap_glDeleteProgram(GLuint program) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_capture_next->DeleteProgram(program);
+	glducktape_cap_end(glducktape_idx_glDeleteProgram);
+}
+static void APIENTRY glducktape_cap_glDeleteShader(GLuint shader) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) shader);
+	glducktape_capture_next->DeleteShader(shader);
+	glducktape_cap_end(glducktape_idx_glDeleteShader);
+}
+static void APIENTRY glducktape_cap_glDetachShader(GLuint program, GLuint shader) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) shader);
+	glducktape_capture_next->DetachShader(program, shader);
+	glducktape_cap_end(glducktape_idx_glDetachShader);
+}
+static void APIENTRY glducktape_cap_glDisableVertexAttribArray(GLuint index) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) index);
+	glducktape_capture_next->DisableVertexAttribArray(index);
+	glducktape_cap_end(glducktape_idx_glDisableVertexAttribArray);
+}
+static void APIENTRY glducktape_cap_glEnableVertexAttribArray(GLuint index) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) index);
+	glducktape_capture_next->EnableVertexAttribArray(index);
+	glducktape_cap_end(glducktape_idx_glEnableVertexAttribArray);
+}
+static void APIENTRY glducktape_cap_glGenBuffers(GLsizei n, GLuint *buffers) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) n);
+	glducktape_capture_next->GenBuffers(n, buffers);
+	glducktape_cap_payload(buffers, n > 0? (size_t)(n * sizeof(GLuint)) : 0);
+	glducktape_cap_end(glducktape_idx_glGenBuffers);
+}
+static void APIENTRY glducktape_cap_glGetActiveUniform(GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) index);
+	glducktape_cap_int((long long) bufSize);
+	glducktape_capture_next->GetActiveUniform(program, index, bufSize, length, size, type, name);
+	glducktape_cap_end(glducktape_idx_glGetActiveUniform);
+}
+static void APIENTRY glducktape_cap_glGetBufferParameteriv(GLenum target, GLenum pname, GLint *params) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) pname);
+	glducktape_capture_next->GetBufferParameteriv(target, pname, params);
+	glducktape_cap_end(glducktape_idx_glGetBufferParameteriv);
+}
+static void APIENTRY glducktape_cap_glGetProgramiv(GLuint program, GLenum pname, GLint *params) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) pname);
+	glducktape_capture_next->GetProgramiv(program, pname, params);
+	glducktape_cap_end(glducktape_idx_glGetProgramiv);
+}
+static GLint APIENTRY glducktape_cap_glGetUniformLocation(GLuint program, const GLchar *name) {
+	GLint ret;
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_payload(name, name? (size_t)(strlen(name) + 1) : 0);
+	ret= glducktape_capture_next->GetUniformLocation(program, name);
+	glducktape_cap_int((long long) ret);
+	glducktape_cap_end(glducktape_idx_glGetUniformLocation);
+	return ret;
+}
+static void APIENTRY glducktape_cap_glLinkProgram(GLuint program) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_capture_next->LinkProgram(program);
+	glducktape_cap_end(glducktape_idx_glLinkProgram);
+}
+static void * APIENTRY glducktape_cap_glMapBuffer(GLenum target, GLenum access) {
+	void *ret;
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) access);
+	ret= glducktape_capture_next->MapBuffer(target, access);
+	if (ret) {
+		GLint size= 0;
+		glducktape_active->GetBufferParameteriv(target, GL_BUFFER_SIZE, &size);
+		glducktape_map_set(0, target, ret, (size_t) size, (access != GL_READ_ONLY)? 1 : 0);
+	}
+	glducktape_cap_end(glducktape_idx_glMapBuffer);
+	return ret;
+}
+static void APIENTRY glducktape_cap_glShaderSource(GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) shader);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_sources(count, string, length);
+	glducktape_capture_next->ShaderSource(shader, count, string, length);
+	glducktape_cap_end(glducktape_idx_glShaderSource);
+}
+static void APIENTRY glducktape_cap_glUniform1fv(GLint location, GLsizei count, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 1 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->Uniform1fv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform1fv);
+}
+static void APIENTRY glducktape_cap_glUniform1iv(GLint location, GLsizei count, const GLint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 1 * sizeof(GLint)) : 0);
+	glducktape_capture_next->Uniform1iv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform1iv);
+}
+static void APIENTRY glducktape_cap_glUniform2fv(GLint location, GLsizei count, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 2 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->Uniform2fv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform2fv);
+}
+static void APIENTRY glducktape_cap_glUniform2iv(GLint location, GLsizei count, const GLint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 2 * sizeof(GLint)) : 0);
+	glducktape_capture_next->Uniform2iv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform2iv);
+}
+static void APIENTRY glducktape_cap_glUniform3fv(GLint location, GLsizei count, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 3 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->Uniform3fv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform3fv);
+}
+static void APIENTRY glducktape_cap_glUniform3iv(GLint location, GLsizei count, const GLint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 3 * sizeof(GLint)) : 0);
+	glducktape_capture_next->Uniform3iv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform3iv);
+}
+static void APIENTRY glducktape_cap_glUniform4fv(GLint location, GLsizei count, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->Uniform4fv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform4fv);
+}
+static void APIENTRY glducktape_cap_glUniform4iv(GLint location, GLsizei count, const GLint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLint)) : 0);
+	glducktape_capture_next->Uniform4iv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform4iv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->UniformMatrix2fv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix2fv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 9 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->UniformMatrix3fv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix3fv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 16 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->UniformMatrix4fv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix4fv);
+}
+static GLboolean APIENTRY glducktape_cap_glUnmapBuffer(GLenum target) {
+	GLboolean ret;
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_unmap(0, target);
+	ret= glducktape_capture_next->UnmapBuffer(target);
+	glducktape_cap_end(glducktape_idx_glUnmapBuffer);
+	return ret;
+}
+static void APIENTRY glducktape_cap_glUseProgram(GLuint program) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_capture_next->UseProgram(program);
+	glducktape_cap_end(glducktape_idx_glUseProgram);
+}
+static void APIENTRY glducktape_cap_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) index);
+	glducktape_cap_int((long long) size);
+	glducktape_cap_int((long long) type);
+	glducktape_cap_int((long long) normalized);
+	glducktape_cap_int((long long) stride);
+	glducktape_cap_int((long long)(size_t) pointer);
+	glducktape_capture_next->VertexAttribPointer(index, size, type, normalized, stride, pointer);
+	glducktape_cap_end(glducktape_idx_glVertexAttribPointer);
+}
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+static void APIENTRY glducktape_cap_glUniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 6 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->UniformMatrix2x3fv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix2x3fv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 8 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->UniformMatrix2x4fv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix2x4fv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 6 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->UniformMatrix3x2fv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix3x2fv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 12 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->UniformMatrix3x4fv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix3x4fv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 8 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->UniformMatrix4x2fv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix4x2fv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 12 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->UniformMatrix4x3fv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix4x3fv);
+}
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+static void APIENTRY glducktape_cap_glBindVertexArray(GLuint array) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) array);
+	glducktape_capture_next->BindVertexArray(array);
+	glducktape_cap_end(glducktape_idx_glBindVertexArray);
+}
+static void APIENTRY glducktape_cap_glDeleteVertexArrays(GLsizei n, const GLuint *arrays) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) n);
+	glducktape_cap_payload(arrays, arrays? (size_t)(n * sizeof(GLuint)) : 0);
+	glducktape_capture_next->DeleteVertexArrays(n, arrays);
+	glducktape_cap_end(glducktape_idx_glDeleteVertexArrays);
+}
+static void APIENTRY glducktape_cap_glGenVertexArrays(GLsizei n, GLuint *arrays) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) n);
+	glducktape_capture_next->GenVertexArrays(n, arrays);
+	glducktape_cap_payload(arrays, n > 0? (size_t)(n * sizeof(GLuint)) : 0);
+	glducktape_cap_end(glducktape_idx_glGenVertexArrays);
+}
+static void APIENTRY glducktape_cap_glGenerateMipmap(GLenum target) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_capture_next->GenerateMipmap(target);
+	glducktape_cap_end(glducktape_idx_glGenerateMipmap);
+}
+static const GLubyte * APIENTRY glducktape_cap_glGetStringi(GLenum name, GLuint index) {
+	const GLubyte *ret;
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) name);
+	glducktape_cap_int((long long) index);
+	ret= glducktape_capture_next->GetStringi(name, index);
+	glducktape_cap_end(glducktape_idx_glGetStringi);
+	return ret;
+}
+static void * APIENTRY glducktape_cap_glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	void *ret;
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) target);
+	glducktape_cap_int((long long) offset);
+	glducktape_cap_int((long long) length);
+	glducktape_cap_int((long long) access);
+	ret= glducktape_capture_next->MapBufferRange(target, offset, length, access);
+	if (ret) {
+		glducktape_map_set(0, target, ret, (size_t) length, (access & GL_MAP_WRITE_BIT)? 1 : 0);
+	}
+	glducktape_cap_end(glducktape_idx_glMapBufferRange);
+	return ret;
+}
+static void APIENTRY glducktape_cap_glUniform1uiv(GLint location, GLsizei count, const GLuint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 1 * sizeof(GLuint)) : 0);
+	glducktape_capture_next->Uniform1uiv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform1uiv);
+}
+static void APIENTRY glducktape_cap_glUniform2uiv(GLint location, GLsizei count, const GLuint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 2 * sizeof(GLuint)) : 0);
+	glducktape_capture_next->Uniform2uiv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform2uiv);
+}
+static void APIENTRY glducktape_cap_glUniform3uiv(GLint location, GLsizei count, const GLuint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 3 * sizeof(GLuint)) : 0);
+	glducktape_capture_next->Uniform3uiv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform3uiv);
+}
+static void APIENTRY glducktape_cap_glUniform4uiv(GLint location, GLsizei count, const GLuint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLuint)) : 0);
+	glducktape_capture_next->Uniform4uiv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform4uiv);
+}
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+static GLenum APIENTRY glducktape_cap_glClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+	return glducktape_capture_next->ClientWaitSync(sync, flags, timeout);
+}
+static void APIENTRY glducktape_cap_glDeleteSync(GLsync sync) {
+	glducktape_capture_next->DeleteSync(sync);
+}
+static GLsync APIENTRY glducktape_cap_glFenceSync(GLenum condition, GLbitfield flags) {
+	return glducktape_capture_next->FenceSync(condition, flags);
+}
+static void APIENTRY glducktape_cap_glGetInteger64v(GLenum pname, GLint64 *data) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) pname);
+	glducktape_capture_next->GetInteger64v(pname, data);
+	glducktape_cap_end(glducktape_idx_glGetInteger64v);
+}
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+static void APIENTRY glducktape_cap_glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64 *params) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) id);
+	glducktape_cap_int((long long) pname);
+	glducktape_capture_next->GetQueryObjectui64v(id, pname, params);
+	glducktape_cap_end(glducktape_idx_glGetQueryObjectui64v);
+}
+static void APIENTRY glducktape_cap_glQueryCounter(GLuint id, GLenum target) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) id);
+	glducktape_cap_int((long long) target);
+	glducktape_capture_next->QueryCounter(id, target);
+	glducktape_cap_end(glducktape_idx_glQueryCounter);
+}
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+static void APIENTRY glducktape_cap_glUniform1dv(GLint location, GLsizei count, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 1 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->Uniform1dv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform1dv);
+}
+static void APIENTRY glducktape_cap_glUniform2dv(GLint location, GLsizei count, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 2 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->Uniform2dv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform2dv);
+}
+static void APIENTRY glducktape_cap_glUniform3dv(GLint location, GLsizei count, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 3 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->Uniform3dv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform3dv);
+}
+static void APIENTRY glducktape_cap_glUniform4dv(GLint location, GLsizei count, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->Uniform4dv(location, count, value);
+	glducktape_cap_end(glducktape_idx_glUniform4dv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->UniformMatrix2dv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix2dv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix2x3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 6 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->UniformMatrix2x3dv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix2x3dv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix2x4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 8 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->UniformMatrix2x4dv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix2x4dv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 9 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->UniformMatrix3dv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix3dv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix3x2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 6 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->UniformMatrix3x2dv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix3x2dv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix3x4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 12 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->UniformMatrix3x4dv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix3x4dv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix4dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 16 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->UniformMatrix4dv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix4dv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix4x2dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 8 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->UniformMatrix4x2dv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix4x2dv);
+}
+static void APIENTRY glducktape_cap_glUniformMatrix4x3dv(GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 12 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->UniformMatrix4x3dv(location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glUniformMatrix4x3dv);
+}
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+static void APIENTRY glducktape_cap_glProgramUniform1dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 1 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniform1dv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform1dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform1fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 1 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniform1fv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform1fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform1iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 1 * sizeof(GLint)) : 0);
+	glducktape_capture_next->ProgramUniform1iv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform1iv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform1uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 1 * sizeof(GLuint)) : 0);
+	glducktape_capture_next->ProgramUniform1uiv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform1uiv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform2dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 2 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniform2dv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform2dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform2fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 2 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniform2fv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform2fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform2iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 2 * sizeof(GLint)) : 0);
+	glducktape_capture_next->ProgramUniform2iv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform2iv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform2uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 2 * sizeof(GLuint)) : 0);
+	glducktape_capture_next->ProgramUniform2uiv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform2uiv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform3dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 3 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniform3dv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform3dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform3fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 3 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniform3fv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform3fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform3iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 3 * sizeof(GLint)) : 0);
+	glducktape_capture_next->ProgramUniform3iv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform3iv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform3uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 3 * sizeof(GLuint)) : 0);
+	glducktape_capture_next->ProgramUniform3uiv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform3uiv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform4dv(GLuint program, GLint location, GLsizei count, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniform4dv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform4dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform4fv(GLuint program, GLint location, GLsizei count, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniform4fv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform4fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform4iv(GLuint program, GLint location, GLsizei count, const GLint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLint)) : 0);
+	glducktape_capture_next->ProgramUniform4iv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform4iv);
+}
+static void APIENTRY glducktape_cap_glProgramUniform4uiv(GLuint program, GLint location, GLsizei count, const GLuint *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLuint)) : 0);
+	glducktape_capture_next->ProgramUniform4uiv(program, location, count, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniform4uiv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix2dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix2dv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix2dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 4 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix2fv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix2fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix2x3dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 6 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix2x3dv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix2x3dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix2x3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 6 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix2x3fv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix2x3fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix2x4dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 8 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix2x4dv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix2x4dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix2x4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 8 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix2x4fv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix2x4fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix3dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 9 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix3dv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix3dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 9 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix3fv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix3fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix3x2dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 6 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix3x2dv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix3x2dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix3x2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 6 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix3x2fv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix3x2fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix3x4dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 12 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix3x4dv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix3x4dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix3x4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 12 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix3x4fv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix3x4fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix4dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 16 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix4dv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix4dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix4fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 16 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix4fv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix4fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix4x2dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 8 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix4x2dv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix4x2dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix4x2fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 8 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix4x2fv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix4x2fv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix4x3dv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 12 * sizeof(GLdouble)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix4x3dv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix4x3dv);
+}
+static void APIENTRY glducktape_cap_glProgramUniformMatrix4x3fv(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) program);
+	glducktape_cap_int((long long) location);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_int((long long) transpose);
+	glducktape_cap_payload(value, value? (size_t)(count * 12 * sizeof(GLfloat)) : 0);
+	glducktape_capture_next->ProgramUniformMatrix4x3fv(program, location, count, transpose, value);
+	glducktape_cap_end(glducktape_idx_glProgramUniformMatrix4x3fv);
+}
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+static void APIENTRY glducktape_cap_glDebugMessageCallback(GLDEBUGPROC callback, const void *userParam) {
+	glducktape_capture_next->DebugMessageCallback(callback, userParam);
+}
+static void APIENTRY glducktape_cap_glDebugMessageControl(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) source);
+	glducktape_cap_int((long long) type);
+	glducktape_cap_int((long long) severity);
+	glducktape_cap_int((long long) count);
+	glducktape_cap_payload(ids, ids? (size_t)(count * sizeof(GLuint)) : 0);
+	glducktape_cap_int((long long) enabled);
+	glducktape_capture_next->DebugMessageControl(source, type, severity, count, ids, enabled);
+	glducktape_cap_end(glducktape_idx_glDebugMessageControl);
+}
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+static void APIENTRY glducktape_cap_glGetNamedBufferParameteriv(GLuint buffer, GLenum pname, GLint *params) {
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) buffer);
+	glducktape_cap_int((long long) pname);
+	glducktape_capture_next->GetNamedBufferParameteriv(buffer, pname, params);
+	glducktape_cap_end(glducktape_idx_glGetNamedBufferParameteriv);
+}
+static void * APIENTRY glducktape_cap_glMapNamedBufferRange(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	void *ret;
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) buffer);
+	glducktape_cap_int((long long) offset);
+	glducktape_cap_int((long long) length);
+	glducktape_cap_int((long long) access);
+	ret= glducktape_capture_next->MapNamedBufferRange(buffer, offset, length, access);
+	if (ret) {
+		glducktape_map_set(1, buffer, ret, (size_t) length, (access & GL_MAP_WRITE_BIT)? 1 : 0);
+	}
+	glducktape_cap_end(glducktape_idx_glMapNamedBufferRange);
+	return ret;
+}
+static GLboolean APIENTRY glducktape_cap_glUnmapNamedBuffer(GLuint buffer) {
+	GLboolean ret;
+	glducktape_cap_begin();
+	glducktape_cap_int((long long) buffer);
+	glducktape_cap_unmap(1, buffer);
+	ret= glducktape_capture_next->UnmapNamedBuffer(buffer);
+	glducktape_cap_end(glducktape_idx_glUnmapNamedBuffer);
+	return ret;
+}
+#endif /* GL_VERSION_4_5 */
+
+static struct glducktape_dispatch glducktape_cap= {
+#ifdef GL_VERSION_1_1
+ glducktape_cap_glBindTexture,
+ glducktape_cap_glDeleteTextures,
+ glducktape_cap_glDrawArrays,
+ glducktape_cap_glDrawElements,
+ glducktape_cap_glGenTextures,
+ glducktape_cap_glPixelStorei,
+ glducktape_cap_glTexImage2D,
+ glducktape_cap_glTexParameteri,
+ glducktape_cap_glTexSubImage2D,
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+ glducktape_cap_glDeleteQueries,
+ glducktape_cap_glGenQueries,
+ glducktape_cap_glGetQueryObjectiv,
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+ glducktape_cap_glAttachShader,
+ glducktape_cap_glBindBuffer,
+ glducktape_cap_glBufferData,
+ glducktape_cap_glBufferSubData,
+ glducktape_cap_glCompileShader,
+ glducktape_cap_glCreateProgram,
+ glducktape_cap_glCreateShader,
+ glducktape_cap_glDeleteBuffers,
+ glducktape_cap_glDeleteProgram,
+ glducktape_cap_glDeleteShader,
+ glducktape_cap_glDetachShader,
+ glducktape_cap_glDisableVertexAttribArray,
+ glducktape_cap_glEnableVertexAttribArray,
+ glducktape_cap_glGenBuffers,
+ glducktape_cap_glGetActiveUniform,
+ glducktape_cap_glGetBufferParameteriv,
+ glducktape_cap_glGetProgramiv,
+ glducktape_cap_glGetUniformLocation,
+ glducktape_cap_glLinkProgram,
+ glducktape_cap_glMapBuffer,
+ glducktape_cap_glShaderSource,
+ glducktape_cap_glUniform1fv,
+ glducktape_cap_glUniform1iv,
+ glducktape_cap_glUniform2fv,
+ glducktape_cap_glUniform2iv,
+ glducktape_cap_glUniform3fv,
+ glducktape_cap_glUniform3iv,
+ glducktape_cap_glUniform4fv,
+ glducktape_cap_glUniform4iv,
+ glducktape_cap_glUniformMatrix2fv,
+ glducktape_cap_glUniformMatrix3fv,
+ glducktape_cap_glUniformMatrix4fv,
+ glducktape_cap_glUnmapBuffer,
+ glducktape_cap_glUseProgram,
+ glducktape_cap_glVertexAttribPointer,
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+ glducktape_cap_glUniformMatrix2x3fv,
+ glducktape_cap_glUniformMatrix2x4fv,
+ glducktape_cap_glUniformMatrix3x2fv,
+ glducktape_cap_glUniformMatrix3x4fv,
+ glducktape_cap_glUniformMatrix4x2fv,
+ glducktape_cap_glUniformMatrix4x3fv,
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+ glducktape_cap_glBindVertexArray,
+ glducktape_cap_glDeleteVertexArrays,
+ glducktape_cap_glGenVertexArrays,
+ glducktape_cap_glGenerateMipmap,
+ glducktape_cap_glGetStringi,
+ glducktape_cap_glMapBufferRange,
+ glducktape_cap_glUniform1uiv,
+ glducktape_cap_glUniform2uiv,
+ glducktape_cap_glUniform3uiv,
+ glducktape_cap_glUniform4uiv,
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+ glducktape_cap_glClientWaitSync,
+ glducktape_cap_glDeleteSync,
+ glducktape_cap_glFenceSync,
+ glducktape_cap_glGetInteger64v,
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+ glducktape_cap_glGetQueryObjectui64v,
+ glducktape_cap_glQueryCounter,
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+ glducktape_cap_glUniform1dv,
+ glducktape_cap_glUniform2dv,
+ glducktape_cap_glUniform3dv,
+ glducktape_cap_glUniform4dv,
+ glducktape_cap_glUniformMatrix2dv,
+ glducktape_cap_glUniformMatrix2x3dv,
+ glducktape_cap_glUniformMatrix2x4dv,
+ glducktape_cap_glUniformMatrix3dv,
+ glducktape_cap_glUniformMatrix3x2dv,
+ glducktape_cap_glUniformMatrix3x4dv,
+ glducktape_cap_glUniformMatrix4dv,
+ glducktape_cap_glUniformMatrix4x2dv,
+ glducktape_cap_glUniformMatrix4x3dv,
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+ glducktape_cap_glProgramUniform1dv,
+ glducktape_cap_glProgramUniform1fv,
+ glducktape_cap_glProgramUniform1iv,
+ glducktape_cap_glProgramUniform1uiv,
+ glducktape_cap_glProgramUniform2dv,
+ glducktape_cap_glProgramUniform2fv,
+ glducktape_cap_glProgramUniform2iv,
+ glducktape_cap_glProgramUniform2uiv,
+ glducktape_cap_glProgramUniform3dv,
+ glducktape_cap_glProgramUniform3fv,
+ glducktape_cap_glProgramUniform3iv,
+ glducktape_cap_glProgramUniform3uiv,
+ glducktape_cap_glProgramUniform4dv,
+ glducktape_cap_glProgramUniform4fv,
+ glducktape_cap_glProgramUniform4iv,
+ glducktape_cap_glProgramUniform4uiv,
+ glducktape_cap_glProgramUniformMatrix2dv,
+ glducktape_cap_glProgramUniformMatrix2fv,
+ glducktape_cap_glProgramUniformMatrix2x3dv,
+ glducktape_cap_glProgramUniformMatrix2x3fv,
+ glducktape_cap_glProgramUniformMatrix2x4dv,
+ glducktape_cap_glProgramUniformMatrix2x4fv,
+ glducktape_cap_glProgramUniformMatrix3dv,
+ glducktape_cap_glProgramUniformMatrix3fv,
+ glducktape_cap_glProgramUniformMatrix3x2dv,
+ glducktape_cap_glProgramUniformMatrix3x2fv,
+ glducktape_cap_glProgramUniformMatrix3x4dv,
+ glducktape_cap_glProgramUniformMatrix3x4fv,
+ glducktape_cap_glProgramUniformMatrix4dv,
+ glducktape_cap_glProgramUniformMatrix4fv,
+ glducktape_cap_glProgramUniformMatrix4x2dv,
+ glducktape_cap_glProgramUniformMatrix4x2fv,
+ glducktape_cap_glProgramUniformMatrix4x3dv,
+ glducktape_cap_glProgramUniformMatrix4x3fv,
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+ glducktape_cap_glDebugMessageCallback,
+ glducktape_cap_glDebugMessageControl,
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+ glducktape_cap_glGetNamedBufferParameteriv,
+ glducktape_cap_glMapNamedBufferRange,
+ glducktape_cap_glUnmapNamedBuffer,
+#endif /* GL_VERSION_4_5 */
+ 0
+};
+
+static void glducktape_route(void) {
+	glducktape_capture_next= glducktape_profiling? &glducktape_prof : glducktape_active;
+	glducktape_current= glducktape_capturing? &glducktape_cap : glducktape_capture_next;
+}
+
+/* Begin writing every GL call to a trace file.  Returns 0 if the file can't be written. */
+int glducktape_capture_start(const char *path) {
+	unsigned int version= 2, count= glducktape_fn_count, i;
+	unsigned char len;
+	if (glducktape_capturing) glducktape_capture_stop();
+	if (!(glducktape_cap_fh= fopen(path, "wb")))
+		return 0;
+	glducktape_cap_failed= 0;
+	memset(glducktape_maps, 0, sizeof(glducktape_maps));
+	glducktape_cap_has_pbo= 0;
+#ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
+	{
+		const char *v= (const char*) glGetString(GL_VERSION);
+		int major= 0, minor= 0;
+		while (v && *v && (*v < '0' || *v > '9')) v++;
+		if (v && sscanf(v, "%d.%d", &major, &minor) == 2)
+			glducktape_cap_has_pbo= major * 10 + minor >= 21;
+	}
+#endif
+	/* The names let a replayer built from a different list find its own index for each */
+	fwrite("GLDTRACE", 8, 1, glducktape_cap_fh);
+	fwrite(&version, 4, 1, glducktape_cap_fh);
+	fwrite(&count, 4, 1, glducktape_cap_fh);
+	for (i= 0; i < count; i++) {
+		len= (unsigned char) strlen(glducktape_names[i]);
+		fwrite(&len, 1, 1, glducktape_cap_fh);
+		fwrite(glducktape_names[i], len, 1, glducktape_cap_fh);
+	}
+	glducktape_capturing= 1;
+	glducktape_route();
+	return 1;
+}
+
+/* Mark the end of a frame, which the replayer times separately */
+void glducktape_capture_frame(void) {
+	if (glducktape_capturing)
+		glducktape_cap_write(0xFFFF, "", 0);
+}
+
+/* Stop capturing and close the file.  Returns 0 if any write failed. */
+int glducktape_capture_stop(void) {
+	int ok;
+	if (!glducktape_capturing) return 1;
+	glducktape_capturing= 0;
+	glducktape_route();
+	ok= !glducktape_cap_failed && !ferror(glducktape_cap_fh);
+	if (fclose(glducktape_cap_fh)) ok= 0;
+	glducktape_cap_fh= NULL;
+	return ok;
+}
+
+#ifdef GLDUCKTAPE_REPLAYER
+
+static struct { const unsigned char *p, *lim; int err; } glducktape_rd;
+
+static long long glducktape_rd_int(void) {
+	long long v= 0;
+	if (glducktape_rd.lim - glducktape_rd.p < 8) { glducktape_rd.err= 1; return 0; }
+	memcpy(&v, glducktape_rd.p, 8);
+	glducktape_rd.p += 8;
+	return v;
+}
+
+static const void* glducktape_rd_payload(size_t *n) {
+	unsigned long long len= (unsigned long long) glducktape_rd_int();
+	const unsigned char *data= glducktape_rd.p;
+	*n= 0;
+	if (glducktape_rd.err || len == ~0ULL) return NULL;
+	if (len > (unsigned long long)(glducktape_rd.lim - data) || ((len + 7) & ~7ULL) > (unsigned long long)(glducktape_rd.lim - data)) {
+		glducktape_rd.err= 1;
+		return NULL;
+	}
+	glducktape_rd.p += (len + 7) & ~7ULL;
+	*n= (size_t) len;
+	return data;
+}
+
+/* Temporary memory for output arguments, freed after each call */
+static void *glducktape_rp_tmp[8];
+static int glducktape_rp_ntmp= 0;
+
+static void* glducktape_rp_alloc(long long size) {
+	void *p;
+	if (size < 0 || size > (1LL << 30) || glducktape_rp_ntmp >= 8
+		|| !(p= calloc(1, size? (size_t) size : 1))
+	) {
+		glducktape_rd.err= 1;
+		return NULL;
+	}
+	return glducktape_rp_tmp[glducktape_rp_ntmp++]= p;
+}
+
+/* Map of captured object names to replayed object names, for each kind of object */
+static GLuint *glducktape_rp_ids[6];
+static size_t glducktape_rp_ids_len[6];
+
+static GLuint glducktape_rp_id(int kind, GLuint id) {
+	return id < glducktape_rp_ids_len[kind] && glducktape_rp_ids[kind][id]? glducktape_rp_ids[kind][id] : id;
+}
+
+static void glducktape_rp_set_id(int kind, GLuint id, GLuint replayed) {
+	if (id >= glducktape_rp_ids_len[kind]) {
+		size_t len= glducktape_rp_ids_len[kind]? glducktape_rp_ids_len[kind] : 64;
+		GLuint *ids;
+		while (len <= id) len *= 2;
+		if (len > (1 << 24) || !(ids= (GLuint*) realloc(glducktape_rp_ids[kind], len * sizeof(GLuint)))) {
+			glducktape_rd.err= 1;
+			return;
+		}
+		memset(ids + glducktape_rp_ids_len[kind], 0, (len - glducktape_rp_ids_len[kind]) * sizeof(GLuint));
+		glducktape_rp_ids[kind]= ids;
+		glducktape_rp_ids_len[kind]= len;
+	}
+	glducktape_rp_ids[kind][id]= replayed;
+}
+
+static const GLuint* glducktape_rp_id_list(int kind, const GLuint *ids, GLsizei n) {
+	GLuint *out= (GLuint*) glducktape_rp_alloc((long long) n * sizeof(GLuint));
+	GLsizei i;
+	if (out)
+		for (i= 0; i < n; i++) out[i]= glducktape_rp_id(kind, ids[i]);
+	return out;
+}
+
+/* Map of captured uniform locations to replayed ones, keyed by the replayed program, in an
+ * open-addressed hash table.  Program 0 marks an empty slot.
+ */
+struct glducktape_rp_loc { GLuint program; GLint from, to; };
+static struct glducktape_rp_loc *glducktape_rp_locs;
+static size_t glducktape_rp_locs_len, glducktape_rp_locs_alloc;
+/* The replayed program of the last glUseProgram, which glUniform* calls refer to */
+static GLuint glducktape_rp_program= 0;
+
+static struct glducktape_rp_loc* glducktape_rp_loc_slot(struct glducktape_rp_loc *locs, size_t alloc, GLuint program, GLint from) {
+	size_t i= ((size_t) program * 2654435761U ^ (size_t)(unsigned) from) & (alloc - 1);
+	while (locs[i].program && !(locs[i].program == program && locs[i].from == from))
+		i= (i + 1) & (alloc - 1);
+	return locs + i;
+}
+
+static GLint glducktape_rp_loc(GLuint program, GLint from) {
+	struct glducktape_rp_loc *l;
+	if (from < 0 || !glducktape_rp_locs_alloc) return from;
+	l= glducktape_rp_loc_slot(glducktape_rp_locs, glducktape_rp_locs_alloc, program, from);
+	return l->program? l->to : from;
+}
+
+static void glducktape_rp_set_loc(GLuint program, GLint from, GLint to) {
+	struct glducktape_rp_loc *l;
+	size_t i;
+	if (from < 0 || !program) return;
+	if ((glducktape_rp_locs_len + 1) * 2 > glducktape_rp_locs_alloc) {
+		size_t alloc= glducktape_rp_locs_alloc? glducktape_rp_locs_alloc * 2 : 64;
+		struct glducktape_rp_loc *locs= (struct glducktape_rp_loc*) calloc(alloc, sizeof(*locs));
+		if (!locs) {
+			glducktape_rd.err= 1;
+			return;
+		}
+		for (i= 0; i < glducktape_rp_locs_alloc; i++)
+			if (glducktape_rp_locs[i].program)
+				*glducktape_rp_loc_slot(locs, alloc, glducktape_rp_locs[i].program, glducktape_rp_locs[i].from)= glducktape_rp_locs[i];
+		free(glducktape_rp_locs);
+		glducktape_rp_locs= locs;
+		glducktape_rp_locs_alloc= alloc;
+	}
+	l= glducktape_rp_loc_slot(glducktape_rp_locs, glducktape_rp_locs_alloc, program, from);
+	if (!l->program) glducktape_rp_locs_len++;
+	l->program= program;
+	l->from= from;
+	l->to= to;
+}
+
+/* Read the pixels written by cap_pixels */
+static const void* glducktape_rp_pixels(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+	const void *data;
+	size_t n;
+	if (glducktape_rd_int())
+		return (const void*)(size_t) glducktape_rd_int();
+	data= glducktape_rd_payload(&n);
+	if (data && n < glducktape_pixels_size(width, height, format, type))
+		glducktape_rd.err= 1;
+	return data;
+}
+
+static void glducktape_rp_unmap(int named, GLuint key, const void *data, size_t n) {
+	struct glducktape_mapping *m= glducktape_map_take(named, key);
+	if (m && data)
+		memcpy(m->addr, data, n < m->len? n : m->len);
+}
+
+/* Make one captured call, given the function index (of this build) and the record body.
+ * Returns 0 if the record is malformed.
+ */
+int glducktape_replay_call(int idx, const unsigned char *body, size_t len) {
+	static unsigned char *copy= NULL;
+	static size_t copy_alloc= 0;
+	int i;
+	/* copy for alignment */
+	if (len > copy_alloc) {
+		unsigned char *p= (unsigned char*) realloc(copy, len);
+		if (!p) return 0;
+		copy= p;
+		copy_alloc= len;
+	}
+	if (len) memcpy(copy, body, len);
+	glducktape_rd.p= copy;
+	glducktape_rd.lim= copy + len;
+	glducktape_rd.err= 0;
+	glducktape_rp_ntmp= 0;
+	switch (idx) {
+#ifdef GL_VERSION_1_1
+	case glducktape_idx_glBindTexture: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLuint texture= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		texture= glducktape_rp_id(3, texture);
+		if (glducktape_rd.err) break;
+		glBindTexture(target, texture);
+		break;
+	}
+	case glducktape_idx_glDeleteTextures: {
+		GLsizei n= (GLsizei) glducktape_rd_int();
+		size_t n_textures;
+		const GLuint *textures= (const GLuint *) glducktape_rd_payload(&n_textures);
+		if (glducktape_rd.err || (textures && n_textures < (size_t)(n * sizeof(GLuint)))) return 0;
+		if (textures) textures= glducktape_rp_id_list(3, textures, n);
+		if (glducktape_rd.err) break;
+		glDeleteTextures(n, textures);
+		break;
+	}
+	case glducktape_idx_glDrawArrays: {
+		GLenum mode= (GLenum) glducktape_rd_int();
+		GLint first= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		glDrawArrays(mode, first, count);
+		break;
+	}
+	case glducktape_idx_glDrawElements: {
+		GLenum mode= (GLenum) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLenum type= (GLenum) glducktape_rd_int();
+		const GLvoid *indices= (const GLvoid *)(size_t) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		glDrawElements(mode, count, type, indices);
+		break;
+	}
+	case glducktape_idx_glGenTextures: {
+		GLsizei n= (GLsizei) glducktape_rd_int();
+		GLuint *textures= NULL;
+		if (glducktape_rd.err) return 0;
+		textures= (GLuint *) glducktape_rp_alloc(n * sizeof(GLuint));
+		if (glducktape_rd.err) break;
+		glGenTextures(n, textures);
+		{
+			size_t n_cap_ids;
+			const GLuint *cap_ids= (const GLuint*) glducktape_rd_payload(&n_cap_ids);
+			for (i= 0; cap_ids && i < n && (size_t) i < n_cap_ids / sizeof(GLuint); i++)
+				glducktape_rp_set_id(3, cap_ids[i], textures[i]);
+		}
+		break;
+	}
+	case glducktape_idx_glPixelStorei: {
+		GLenum pname= (GLenum) glducktape_rd_int();
+		GLint param= (GLint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		glPixelStorei(pname, param);
+		break;
+	}
+	case glducktape_idx_glTexImage2D: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLint level= (GLint) glducktape_rd_int();
+		GLint internalFormat= (GLint) glducktape_rd_int();
+		GLsizei width= (GLsizei) glducktape_rd_int();
+		GLsizei height= (GLsizei) glducktape_rd_int();
+		GLint border= (GLint) glducktape_rd_int();
+		GLenum format= (GLenum) glducktape_rd_int();
+		GLenum type= (GLenum) glducktape_rd_int();
+		const GLvoid *pixels= glducktape_rp_pixels(width, height, format, type);
+		if (glducktape_rd.err) return 0;
+		glTexImage2D(target, level, internalFormat, width, height, border, format, type, pixels);
+		break;
+	}
+	case glducktape_idx_glTexParameteri: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLenum pname= (GLenum) glducktape_rd_int();
+		GLint param= (GLint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		glTexParameteri(target, pname, param);
+		break;
+	}
+	case glducktape_idx_glTexSubImage2D: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLint level= (GLint) glducktape_rd_int();
+		GLint xoffset= (GLint) glducktape_rd_int();
+		GLint yoffset= (GLint) glducktape_rd_int();
+		GLsizei width= (GLsizei) glducktape_rd_int();
+		GLsizei height= (GLsizei) glducktape_rd_int();
+		GLenum format= (GLenum) glducktape_rd_int();
+		GLenum type= (GLenum) glducktape_rd_int();
+		const GLvoid *pixels= glducktape_rp_pixels(width, height, format, type);
+		if (glducktape_rd.err) return 0;
+		glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+		break;
+	}
+#endif /* GL_VERSION_1_1 */
+#ifdef GL_VERSION_1_5
+	case glducktape_idx_glDeleteQueries: {
+		GLsizei n= (GLsizei) glducktape_rd_int();
+		size_t n_ids;
+		const GLuint *ids= (const GLuint *) glducktape_rd_payload(&n_ids);
+		if (glducktape_rd.err || (ids && n_ids < (size_t)(n * sizeof(GLuint)))) return 0;
+		if (ids) ids= glducktape_rp_id_list(2, ids, n);
+		if (glducktape_rd.err) break;
+		glDeleteQueries(n, ids);
+		break;
+	}
+	case glducktape_idx_glGenQueries: {
+		GLsizei n= (GLsizei) glducktape_rd_int();
+		GLuint *ids= NULL;
+		if (glducktape_rd.err) return 0;
+		ids= (GLuint *) glducktape_rp_alloc(n * sizeof(GLuint));
+		if (glducktape_rd.err) break;
+		glGenQueries(n, ids);
+		{
+			size_t n_cap_ids;
+			const GLuint *cap_ids= (const GLuint*) glducktape_rd_payload(&n_cap_ids);
+			for (i= 0; cap_ids && i < n && (size_t) i < n_cap_ids / sizeof(GLuint); i++)
+				glducktape_rp_set_id(2, cap_ids[i], ids[i]);
+		}
+		break;
+	}
+	case glducktape_idx_glGetQueryObjectiv: {
+		GLuint id= (GLuint) glducktape_rd_int();
+		GLenum pname= (GLenum) glducktape_rd_int();
+		GLint *params= NULL;
+		if (glducktape_rd.err) return 0;
+		id= glducktape_rp_id(2, id);
+		params= (GLint *) glducktape_rp_alloc(16 * sizeof(GLint));
+		if (glducktape_rd.err) break;
+		glGetQueryObjectiv(id, pname, params);
+		break;
+	}
+#endif /* GL_VERSION_1_5 */
+#ifdef GL_VERSION_2_0
+	case glducktape_idx_glAttachShader: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLuint shader= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		program= glducktape_rp_id(5, program);
+		shader= glducktape_rp_id(4, shader);
+		if (glducktape_rd.err) break;
+		glAttachShader(program, shader);
+		break;
+	}
+	case glducktape_idx_glBindBuffer: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLuint buffer= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		buffer= glducktape_rp_id(0, buffer);
+		if (glducktape_rd.err) break;
+		glBindBuffer(target, buffer);
+		break;
+	}
+	case glducktape_idx_glBufferData: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLsizeiptr size= (GLsizeiptr) glducktape_rd_int();
+		size_t n_data;
+		const void *data= (const void *) glducktape_rd_payload(&n_data);
+		GLenum usage= (GLenum) glducktape_rd_int();
+		if (glducktape_rd.err || (data && n_data < (size_t)(size))) return 0;
+		glBufferData(target, size, data, usage);
+		break;
+	}
+	case glducktape_idx_glBufferSubData: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLintptr offset= (GLintptr) glducktape_rd_int();
+		GLsizeiptr size= (GLsizeiptr) glducktape_rd_int();
+		size_t n_data;
+		const void *data= (const void *) glducktape_rd_payload(&n_data);
+		if (glducktape_rd.err || (data && n_data < (size_t)(size))) return 0;
+		glBufferSubData(target, offset, size, data);
+		break;
+	}
+	case glducktape_idx_glCompileShader: {
+		GLuint shader= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		shader= glducktape_rp_id(4, shader);
+		if (glducktape_rd.err) break;
+		glCompileShader(shader);
+		break;
+	}
+	case glducktape_idx_glCreateProgram: {
+		GLuint ret;
+		if (glducktape_rd.err) return 0;
+		ret= glCreateProgram();
+		glducktape_rp_set_id(5, (GLuint) glducktape_rd_int(), ret);
+		break;
+	}
+	case glducktape_idx_glCreateShader: {
+		GLenum type= (GLenum) glducktape_rd_int();
+		GLuint ret;
+		if (glducktape_rd.err) return 0;
+		ret= glCreateShader(type);
+		glducktape_rp_set_id(4, (GLuint) glducktape_rd_int(), ret);
+		break;
+	}
+	case glducktape_idx_glDeleteBuffers: {
+		GLsizei n= (GLsizei) glducktape_rd_int();
+		size_t n_buffers;
+		const GLuint *buffers= (const GLuint *) glducktape_rd_payload(&n_buffers);
+		if (glducktape_rd.err || (buffers && n_buffers < (size_t)(n * sizeof(GLuint)))) return 0;
+		if (buffers) buffers= glducktape_rp_id_list(0, buffers, n);
+		if (glducktape_rd.err) break;
+		glDeleteBuffers(n, buffers);
+		break;
+	}
+	case glducktape_idx_glDeleteProgram: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		program= glducktape_rp_id(5, program);
+		if (glducktape_rd.err) break;
+		glDeleteProgram(program);
+		break;
+	}
+	case glducktape_idx_glDeleteShader: {
+		GLuint shader= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		shader= glducktape_rp_id(4, shader);
+		if (glducktape_rd.err) break;
+		glDeleteShader(shader);
+		break;
+	}
+	case glducktape_idx_glDetachShader: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLuint shader= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		program= glducktape_rp_id(5, program);
+		shader= glducktape_rp_id(4, shader);
+		if (glducktape_rd.err) break;
+		glDetachShader(program, shader);
+		break;
+	}
+	case glducktape_idx_glDisableVertexAttribArray: {
+		GLuint index= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		glDisableVertexAttribArray(index);
+		break;
+	}
+	case glducktape_idx_glEnableVertexAttribArray: {
+		GLuint index= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		glEnableVertexAttribArray(index);
+		break;
+	}
+	case glducktape_idx_glGenBuffers: {
+		GLsizei n= (GLsizei) glducktape_rd_int();
+		GLuint *buffers= NULL;
+		if (glducktape_rd.err) return 0;
+		buffers= (GLuint *) glducktape_rp_alloc(n * sizeof(GLuint));
+		if (glducktape_rd.err) break;
+		glGenBuffers(n, buffers);
+		{
+			size_t n_cap_ids;
+			const GLuint *cap_ids= (const GLuint*) glducktape_rd_payload(&n_cap_ids);
+			for (i= 0; cap_ids && i < n && (size_t) i < n_cap_ids / sizeof(GLuint); i++)
+				glducktape_rp_set_id(0, cap_ids[i], buffers[i]);
+		}
+		break;
+	}
+	case glducktape_idx_glGetActiveUniform: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLuint index= (GLuint) glducktape_rd_int();
+		GLsizei bufSize= (GLsizei) glducktape_rd_int();
+		GLsizei *length= NULL;
+		GLint *size= NULL;
+		GLenum *type= NULL;
+		GLchar *name= NULL;
+		if (glducktape_rd.err) return 0;
+		program= glducktape_rp_id(5, program);
+		length= (GLsizei *) glducktape_rp_alloc(16 * sizeof(GLsizei));
+		size= (GLint *) glducktape_rp_alloc(16 * sizeof(GLint));
+		type= (GLenum *) glducktape_rp_alloc(16 * sizeof(GLenum));
+		name= (GLchar *) glducktape_rp_alloc(bufSize);
+		if (glducktape_rd.err) break;
+		glGetActiveUniform(program, index, bufSize, length, size, type, name);
+		break;
+	}
+	case glducktape_idx_glGetBufferParameteriv: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLenum pname= (GLenum) glducktape_rd_int();
+		GLint *params= NULL;
+		if (glducktape_rd.err) return 0;
+		params= (GLint *) glducktape_rp_alloc(16 * sizeof(GLint));
+		if (glducktape_rd.err) break;
+		glGetBufferParameteriv(target, pname, params);
+		break;
+	}
+	case glducktape_idx_glGetProgramiv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLenum pname= (GLenum) glducktape_rd_int();
+		GLint *params= NULL;
+		if (glducktape_rd.err) return 0;
+		program= glducktape_rp_id(5, program);
+		params= (GLint *) glducktape_rp_alloc(16 * sizeof(GLint));
+		if (glducktape_rd.err) break;
+		glGetProgramiv(program, pname, params);
+		break;
+	}
+	case glducktape_idx_glGetUniformLocation: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		size_t n_name;
+		const GLchar *name= (const GLchar *) glducktape_rd_payload(&n_name);
+		GLint ret;
+		if (glducktape_rd.err || (name && !memchr(name, 0, n_name))) return 0;
+		program= glducktape_rp_id(5, program);
+		if (glducktape_rd.err) break;
+		ret= glGetUniformLocation(program, name);
+		glducktape_rp_set_loc(program, (GLint) glducktape_rd_int(), ret);
+		break;
+	}
+	case glducktape_idx_glLinkProgram: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		program= glducktape_rp_id(5, program);
+		if (glducktape_rd.err) break;
+		glLinkProgram(program);
+		break;
+	}
+	case glducktape_idx_glMapBuffer: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLenum access= (GLenum) glducktape_rd_int();
+		void *ret;
+		if (glducktape_rd.err) return 0;
+		ret= glMapBuffer(target, access);
+		if (ret) {
+			GLint size= 0;
+			glducktape_current->GetBufferParameteriv(target, GL_BUFFER_SIZE, &size);
+			glducktape_map_set(0, target, ret, (size_t) size, (access != GL_READ_ONLY)? 1 : 0);
+		}
+		break;
+	}
+	case glducktape_idx_glShaderSource: {
+		GLuint shader= (GLuint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_source;
+		const GLchar *source= (const GLchar*) glducktape_rd_payload(&n_source);
+		GLint source_len= (GLint) n_source;
+		const GLchar *const*string= &source;
+		const GLint *length= &source_len;
+		if (glducktape_rd.err || !source) return 0;
+		shader= glducktape_rp_id(4, shader);
+		count= 1;
+		if (glducktape_rd.err) break;
+		glShaderSource(shader, count, string, length);
+		break;
+	}
+	case glducktape_idx_glUniform1fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 1 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform1fv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform1iv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLint *value= (const GLint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 1 * sizeof(GLint)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform1iv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform2fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 2 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform2fv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform2iv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLint *value= (const GLint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 2 * sizeof(GLint)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform2iv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform3fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 3 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform3fv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform3iv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLint *value= (const GLint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 3 * sizeof(GLint)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform3iv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform4fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform4fv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform4iv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLint *value= (const GLint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLint)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform4iv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix2fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix2fv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix3fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 9 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix3fv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix4fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 16 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix4fv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUnmapBuffer: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		size_t n_mapped;
+		const void *mapped= glducktape_rd_payload(&n_mapped);
+		if (glducktape_rd.err) return 0;
+		glducktape_rp_unmap(0, target, mapped, n_mapped);
+		glUnmapBuffer(target);
+		break;
+	}
+	case glducktape_idx_glUseProgram: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		program= glducktape_rp_id(5, program);
+		if (glducktape_rd.err) break;
+		glUseProgram(program);
+		glducktape_rp_program= program;
+		break;
+	}
+	case glducktape_idx_glVertexAttribPointer: {
+		GLuint index= (GLuint) glducktape_rd_int();
+		GLint size= (GLint) glducktape_rd_int();
+		GLenum type= (GLenum) glducktape_rd_int();
+		GLboolean normalized= (GLboolean) glducktape_rd_int();
+		GLsizei stride= (GLsizei) glducktape_rd_int();
+		const void *pointer= (const void *)(size_t) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+		break;
+	}
+#endif /* GL_VERSION_2_0 */
+#ifdef GL_VERSION_2_1
+	case glducktape_idx_glUniformMatrix2x3fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 6 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix2x3fv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix2x4fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 8 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix2x4fv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix3x2fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 6 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix3x2fv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix3x4fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 12 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix3x4fv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix4x2fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 8 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix4x2fv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix4x3fv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 12 * sizeof(GLfloat)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix4x3fv(location, count, transpose, value);
+		break;
+	}
+#endif /* GL_VERSION_2_1 */
+#ifdef GL_VERSION_3_0
+	case glducktape_idx_glBindVertexArray: {
+		GLuint array= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		array= glducktape_rp_id(1, array);
+		if (glducktape_rd.err) break;
+		glBindVertexArray(array);
+		break;
+	}
+	case glducktape_idx_glDeleteVertexArrays: {
+		GLsizei n= (GLsizei) glducktape_rd_int();
+		size_t n_arrays;
+		const GLuint *arrays= (const GLuint *) glducktape_rd_payload(&n_arrays);
+		if (glducktape_rd.err || (arrays && n_arrays < (size_t)(n * sizeof(GLuint)))) return 0;
+		if (arrays) arrays= glducktape_rp_id_list(1, arrays, n);
+		if (glducktape_rd.err) break;
+		glDeleteVertexArrays(n, arrays);
+		break;
+	}
+	case glducktape_idx_glGenVertexArrays: {
+		GLsizei n= (GLsizei) glducktape_rd_int();
+		GLuint *arrays= NULL;
+		if (glducktape_rd.err) return 0;
+		arrays= (GLuint *) glducktape_rp_alloc(n * sizeof(GLuint));
+		if (glducktape_rd.err) break;
+		glGenVertexArrays(n, arrays);
+		{
+			size_t n_cap_ids;
+			const GLuint *cap_ids= (const GLuint*) glducktape_rd_payload(&n_cap_ids);
+			for (i= 0; cap_ids && i < n && (size_t) i < n_cap_ids / sizeof(GLuint); i++)
+				glducktape_rp_set_id(1, cap_ids[i], arrays[i]);
+		}
+		break;
+	}
+	case glducktape_idx_glGenerateMipmap: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		glGenerateMipmap(target);
+		break;
+	}
+	case glducktape_idx_glGetStringi: {
+		GLenum name= (GLenum) glducktape_rd_int();
+		GLuint index= (GLuint) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		glGetStringi(name, index);
+		break;
+	}
+	case glducktape_idx_glMapBufferRange: {
+		GLenum target= (GLenum) glducktape_rd_int();
+		GLintptr offset= (GLintptr) glducktape_rd_int();
+		GLsizeiptr length= (GLsizeiptr) glducktape_rd_int();
+		GLbitfield access= (GLbitfield) glducktape_rd_int();
+		void *ret;
+		if (glducktape_rd.err) return 0;
+		ret= glMapBufferRange(target, offset, length, access);
+		if (ret) {
+			glducktape_map_set(0, target, ret, (size_t) length, (access & GL_MAP_WRITE_BIT)? 1 : 0);
+		}
+		break;
+	}
+	case glducktape_idx_glUniform1uiv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLuint *value= (const GLuint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 1 * sizeof(GLuint)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform1uiv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform2uiv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLuint *value= (const GLuint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 2 * sizeof(GLuint)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform2uiv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform3uiv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLuint *value= (const GLuint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 3 * sizeof(GLuint)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform3uiv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform4uiv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLuint *value= (const GLuint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLuint)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform4uiv(location, count, value);
+		break;
+	}
+#endif /* GL_VERSION_3_0 */
+#ifdef GL_VERSION_3_2
+	case glducktape_idx_glGetInteger64v: {
+		GLenum pname= (GLenum) glducktape_rd_int();
+		GLint64 *data= NULL;
+		if (glducktape_rd.err) return 0;
+		data= (GLint64 *) glducktape_rp_alloc(16 * sizeof(GLint64));
+		if (glducktape_rd.err) break;
+		glGetInteger64v(pname, data);
+		break;
+	}
+#endif /* GL_VERSION_3_2 */
+#ifdef GL_VERSION_3_3
+	case glducktape_idx_glGetQueryObjectui64v: {
+		GLuint id= (GLuint) glducktape_rd_int();
+		GLenum pname= (GLenum) glducktape_rd_int();
+		GLuint64 *params= NULL;
+		if (glducktape_rd.err) return 0;
+		id= glducktape_rp_id(2, id);
+		params= (GLuint64 *) glducktape_rp_alloc(16 * sizeof(GLuint64));
+		if (glducktape_rd.err) break;
+		glGetQueryObjectui64v(id, pname, params);
+		break;
+	}
+	case glducktape_idx_glQueryCounter: {
+		GLuint id= (GLuint) glducktape_rd_int();
+		GLenum target= (GLenum) glducktape_rd_int();
+		if (glducktape_rd.err) return 0;
+		id= glducktape_rp_id(2, id);
+		if (glducktape_rd.err) break;
+		glQueryCounter(id, target);
+		break;
+	}
+#endif /* GL_VERSION_3_3 */
+#ifdef GL_VERSION_4_0
+	case glducktape_idx_glUniform1dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 1 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform1dv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform2dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 2 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform2dv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform3dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 3 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform3dv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniform4dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniform4dv(location, count, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix2dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix2dv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix2x3dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 6 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix2x3dv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix2x4dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 8 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix2x4dv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix3dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 9 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix3dv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix3x2dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 6 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix3x2dv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix3x4dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 12 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix3x4dv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix4dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 16 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix4dv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix4x2dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 8 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix4x2dv(location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glUniformMatrix4x3dv: {
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 12 * sizeof(GLdouble)))) return 0;
+		location= glducktape_rp_loc(glducktape_rp_program, location);
+		if (glducktape_rd.err) break;
+		glUniformMatrix4x3dv(location, count, transpose, value);
+		break;
+	}
+#endif /* GL_VERSION_4_0 */
+#ifdef GL_VERSION_4_1
+	case glducktape_idx_glProgramUniform1dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 1 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform1dv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform1fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 1 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform1fv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform1iv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLint *value= (const GLint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 1 * sizeof(GLint)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform1iv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform1uiv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLuint *value= (const GLuint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 1 * sizeof(GLuint)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform1uiv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform2dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 2 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform2dv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform2fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 2 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform2fv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform2iv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLint *value= (const GLint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 2 * sizeof(GLint)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform2iv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform2uiv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLuint *value= (const GLuint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 2 * sizeof(GLuint)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform2uiv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform3dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 3 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform3dv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform3fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 3 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform3fv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform3iv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLint *value= (const GLint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 3 * sizeof(GLint)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform3iv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform3uiv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLuint *value= (const GLuint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 3 * sizeof(GLuint)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform3uiv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform4dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform4dv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform4fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform4fv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform4iv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLint *value= (const GLint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLint)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform4iv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniform4uiv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_value;
+		const GLuint *value= (const GLuint *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLuint)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniform4uiv(program, location, count, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix2dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix2dv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix2fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 4 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix2fv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix2x3dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 6 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix2x3dv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix2x3fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 6 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix2x3fv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix2x4dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 8 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix2x4dv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix2x4fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 8 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix2x4fv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix3dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 9 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix3dv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix3fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 9 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix3fv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix3x2dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 6 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix3x2dv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix3x2fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 6 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix3x2fv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix3x4dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 12 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix3x4dv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix3x4fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 12 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix3x4fv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix4dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 16 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix4dv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix4fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 16 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix4fv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix4x2dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 8 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix4x2dv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix4x2fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 8 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix4x2fv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix4x3dv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLdouble *value= (const GLdouble *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 12 * sizeof(GLdouble)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix4x3dv(program, location, count, transpose, value);
+		break;
+	}
+	case glducktape_idx_glProgramUniformMatrix4x3fv: {
+		GLuint program= (GLuint) glducktape_rd_int();
+		GLint location= (GLint) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		GLboolean transpose= (GLboolean) glducktape_rd_int();
+		size_t n_value;
+		const GLfloat *value= (const GLfloat *) glducktape_rd_payload(&n_value);
+		if (glducktape_rd.err || (value && n_value < (size_t)(count * 12 * sizeof(GLfloat)))) return 0;
+		program= glducktape_rp_id(5, program);
+		location= glducktape_rp_loc(program, location);
+		if (glducktape_rd.err) break;
+		glProgramUniformMatrix4x3fv(program, location, count, transpose, value);
+		break;
+	}
+#endif /* GL_VERSION_4_1 */
+#ifdef GL_VERSION_4_3
+	case glducktape_idx_glDebugMessageControl: {
+		GLenum source= (GLenum) glducktape_rd_int();
+		GLenum type= (GLenum) glducktape_rd_int();
+		GLenum severity= (GLenum) glducktape_rd_int();
+		GLsizei count= (GLsizei) glducktape_rd_int();
+		size_t n_ids;
+		const GLuint *ids= (const GLuint *) glducktape_rd_payload(&n_ids);
+		GLboolean enabled= (GLboolean) glducktape_rd_int();
+		if (glducktape_rd.err || (ids && n_ids < (size_t)(count * sizeof(GLuint)))) return 0;
+		glDebugMessageControl(source, type, severity, count, ids, enabled);
+		break;
+	}
+#endif /* GL_VERSION_4_3 */
+#ifdef GL_VERSION_4_5
+	case glducktape_idx_glGetNamedBufferParameteriv: {
+		GLuint buffer= (GLuint) glducktape_rd_int();
+		GLenum pname= (GLenum) glducktape_rd_int();
+		GLint *params= NULL;
+		if (glducktape_rd.err) return 0;
+		buffer= glducktape_rp_id(0, buffer);
+		params= (GLint *) glducktape_rp_alloc(16 * sizeof(GLint));
+		if (glducktape_rd.err) break;
+		glGetNamedBufferParameteriv(buffer, pname, params);
+		break;
+	}
+	case glducktape_idx_glMapNamedBufferRange: {
+		GLuint buffer= (GLuint) glducktape_rd_int();
+		GLintptr offset= (GLintptr) glducktape_rd_int();
+		GLsizeiptr length= (GLsizeiptr) glducktape_rd_int();
+		GLbitfield access= (GLbitfield) glducktape_rd_int();
+		void *ret;
+		if (glducktape_rd.err) return 0;
+		buffer= glducktape_rp_id(0, buffer);
+		if (glducktape_rd.err) break;
+		ret= glMapNamedBufferRange(buffer, offset, length, access);
+		if (ret) {
+			glducktape_map_set(1, buffer, ret, (size_t) length, (access & GL_MAP_WRITE_BIT)? 1 : 0);
+		}
+		break;
+	}
+	case glducktape_idx_glUnmapNamedBuffer: {
+		GLuint buffer= (GLuint) glducktape_rd_int();
+		size_t n_mapped;
+		const void *mapped= glducktape_rd_payload(&n_mapped);
+		if (glducktape_rd.err) return 0;
+		buffer= glducktape_rp_id(0, buffer);
+		if (glducktape_rd.err) break;
+		glducktape_rp_unmap(1, buffer, mapped, n_mapped);
+		glUnmapNamedBuffer(buffer);
+		break;
+	}
+#endif /* GL_VERSION_4_5 */
+	default:
+		glducktape_rd.err= 1;
+	}
+	while (glducktape_rp_ntmp > 0)
+		free(glducktape_rp_tmp[--glducktape_rp_ntmp]);
+	return !glducktape_rd.err;
+}
+
+#endif /* GLDUCKTAPE_REPLAYER */
@@ -1,35 +1,160 @@
 #! /usr/bin/env perl
 
+# Usage: perl inc/glducktape.pl [path/to/glext.h] < inc/glducktape.list > inc/glducktape.c
+#
+# GL 1.0 and 1.1 functions have no PFN typedef in glext.h, so their prototypes are read from
+# the gl.h beside it.
+#
+# Generates a dispatch table (struct glducktape_dispatch) holding one function pointer per
+# entry of the list, and a macro for each GL function that calls through the current table.
+# The default table holds stubs which resolve the function on first use.  Calling
+# glducktape_resolve fills a table for the current context in one pass, and reports any
+# function which the context's GL version doesn't provide or which can't be found.
+#
+# It also generates an optional profiling layer: a second table of wrappers which count the
+# calls and time of each function before passing them on to the real table.  glducktape_profile
+# switches between them at runtime, so there is no cost when it is off.  The C functions that
+# call GL can mark themselves with a glducktape_scope, and the GL calls made inside that scope
+# are also totalled under its name.
+#
+# A third table of wrappers captures every call to a binary trace file, with the data that
+# pointer arguments refer to, so that inc/glducktape-replay.c can play it back on another
+# context.  The replay half is only compiled when GLDUCKTAPE_REPLAYER is defined.
+
 my $prefix= 'glducktape_';
-my $c;
+my $glext= shift // (grep -f, '/usr/include/GL/glext.h', '/usr/local/include/GL/glext.h')[0]
+	// die "Can't find GL/glext.h; give its path as the first argument\n";
+
+# Parse the PFN typedefs of glext.h to learn the return type and parameters of each function,
+# and the prototypes of gl.h for the ones that have no typedef.
+my %proto;
+sub add_proto {
+	my ($ret, $name, $params, %opts)= @_;
+	s/\s+/ /g for $ret, $params;
+	$params =~ s/^ | $//g;
+	my @params= $params eq 'void'? () : map {
+		my ($type, $pname)= /^\s*(.*?)\s*(\w+)\s*(?:\[\w*\])?\s*$/ or die "Can't parse '$_' of $name";
+		+{ type => $type, name => $pname, ptr => scalar($type =~ /\*/), const => scalar($type =~ /^const\b/) }
+	} split /,/, $params;
+	$proto{$name} //= { ret => $ret, params => $params, param_list => \@params,
+		args => join(', ', map $_->{name}, @params), %opts };
+}
+{
+	open my $fh, '<', $glext or die "open($glext): $!";
+	local $/= ';';
+	while (<$fh>) {
+		next unless /typedef\s+(.+?)\s*\(\s*APIENTRYP\s+PFN(\w+)PROC\s*\)\s*\((.*?)\)\s*;/s;
+		add_proto($1, $2, $3);
+	}
+	(my $gl_h= $glext) =~ s/glext\.h$/gl.h/;
+	open $fh, '<', $gl_h or die "open($gl_h): $!";
+	while (<$fh>) {
+		next unless /GLAPI\s+(.+?)\s*GLAPIENTRY\s+gl(\w+)\s*\((.*?)\)\s*;/s;
+		add_proto($1, 'GL'.uc($2), $3, own_typedef => 1);
+	}
+}
+
+my (@fns, $ver);
+while (<STDIN>) {
+	my ($maj, $min, $fn)= ($_ =~ /^(\d)\.(\d) (\w+)$/)
+		or die "Invalid function spec $_";
+	my $proto= $proto{uc $fn} or die "No PFN typedef for $fn in $glext\n";
+	(my $field= $fn) =~ s/^gl//;
+	push @fns, { %$proto, name => $fn, field => $field, maj => $maj, min => $min,
+		typedef => ($proto->{own_typedef}? $prefix : '').'PFN'.uc($fn).'PROC', ver => "GL_VERSION_${maj}_${min}" };
+}
+
+# Emit one block of text per function, wrapped in #ifdef for its GL version
+sub per_fn {
+	my $code= shift;
+	my ($out, $ver)= ('', '');
+	for (@fns) {
+		if ($_->{ver} ne $ver) {
+			$out .= "#endif /* $ver */\n" if $ver;
+			$ver= $_->{ver};
+			$out .= "#ifdef $ver\n";
+		}
+		$out .= $code->($_);
+	}
+	$out .= "#endif /* $ver */\n" if $ver;
+	$out;
+}
+
 my $h= <<"END";
 #include <GL/gl.h>
 #include <GL/glext.h>
+
+END
+$h .= "typedef $_->{ret} (APIENTRYP $_->{typedef})($_->{params});\n" for grep $_->{own_typedef}, @fns;
+$h .= "\nstruct ${prefix}dispatch {\n";
+$h .= per_fn(sub { " $_->{typedef} $_->{field};\n" });
+$h .= <<"END";
+ int unused; /* in case no version is defined */
+};
+extern struct ${prefix}dispatch *${prefix}current;
+extern void ${prefix}init(struct ${prefix}dispatch *table);
+extern void ${prefix}use(struct ${prefix}dispatch *table);
+extern int ${prefix}resolve(struct ${prefix}dispatch *table, int gl_major, int gl_minor,
+	void (*on_missing)(const char *name, void *ctx), void *ctx);
 extern void* ${prefix}initProcAddress(const char *name, void **fnptr);
+extern void ${prefix}set_loader(void* (*loader)(const char *name));
+
+/* Profiling */
+enum ${prefix}fn_index {
 END
+$h .= per_fn(sub { " ${prefix}idx_$_->{name},\n" });
+$h .= <<"END";
+ ${prefix}fn_count
+};
+struct ${prefix}stat { unsigned long long calls, ns; };
+struct ${prefix}scope {
+	const char *name;
+	struct ${prefix}stat total, gl; /* the whole function, and the GL calls made inside it */
+	struct ${prefix}scope *next, *outer;
+	int registered;
+};
+extern int ${prefix}profiling;
+extern const char *${prefix}names[];
+extern struct ${prefix}stat ${prefix}stats[];
+extern struct ${prefix}scope *${prefix}scopes;
+extern struct ${prefix}scope *${prefix}cur_scope; /* innermost; save it around non-local exits */
+extern void ${prefix}profile(int enable);
+extern void ${prefix}profile_reset(void);
+extern unsigned long long ${prefix}now_ns(void);
+extern unsigned long long ${prefix}scope_enter(struct ${prefix}scope *scope);
+extern void ${prefix}scope_leave(struct ${prefix}scope *scope, unsigned long long t0);
 
-my $ver= '';
-while (<STDIN>) {
-	my ($maj, $min, $fn)= ($_ =~ /^(\d)\.(\d) (\w+)$/)
-		or die "Invalid function spec $_";
-	if ("GL_VERSION_${maj}_${min}" ne $ver) {
-		if ($ver) { $h .= "#endif /* $ver */\n"; $c .= "#endif /* $ver */\n"; }
-		$ver= "GL_VERSION_${maj}_${min}";
-		$h .= "#ifdef $ver\n";
-		$c .= "#ifdef $ver\n";
-	}
-	my $typedef= 'PFN'.uc($fn).'PROC';
-	$h .= <<"END";
- extern $typedef $prefix$fn;
- #define $fn ($prefix$fn? $prefix$fn : ($typedef)${prefix}initProcAddress("$fn",(void**)&$prefix$fn))
+/* Capture and replay */
+extern int ${prefix}capturing;
+extern int ${prefix}capture_start(const char *path);
+extern void ${prefix}capture_frame(void);
+extern int ${prefix}capture_stop(void);
+#ifdef GLDUCKTAPE_REPLAYER
+extern int ${prefix}replay_call(int idx, const unsigned char *body, size_t len);
+#endif
 
 END
-	$c .= <<"END";
-  $typedef $prefix$fn = NULL;
+$h .= per_fn(sub { " #define $_->{name} (${prefix}current->$_->{field})\n" });
+
+my $c= "\nstatic struct ${prefix}dispatch ${prefix}lazy;\n";
+$c .= per_fn(sub {
+	my $call= "((${\$_->{typedef}})${prefix}initProcAddress(\"$_->{name}\", (void**) &${prefix}lazy.$_->{field}))($_->{args})";
+	"static $_->{ret} APIENTRY ${prefix}stub_$_->{name}($_->{params}) {\n"
+	.($_->{ret} eq 'void'? "\t$call;\n" : "\treturn $call;\n")
+	."}\n"
+});
+$c .= "\nstatic struct ${prefix}dispatch ${prefix}lazy= {\n";
+$c .= per_fn(sub { " ${prefix}stub_$_->{name},\n" });
+$c .= <<"END";
+ 0
+};
+/* The table for the current context, which glducktape_current points to unless profiling
+ * or capturing */
+static struct ${prefix}dispatch *${prefix}active= &${prefix}lazy;
+struct ${prefix}dispatch *${prefix}current= &${prefix}lazy;
+static void ${prefix}route(void);
+
 END
-}
-$h .= "#endif /* $ver */\n";
-$c .= "#endif /* $ver */\n";
 
 $c.= <<"END";
 
@@ -114,8 +239,18 @@ int open_gl(void) {
 
 #endif
 
-void* ${prefix}initProcAddress(const char *name, void **fnptr) {
+/* Replacement for the GL library's lookup, for contexts created by another library (OSMesa) */
+static void* (*${prefix}loader)(const char *name)= NULL;
+
+void ${prefix}set_loader(void* (*loader)(const char *name)) {
+	${prefix}loader= loader;
+}
+
+/* Look up a function in the GL library, returning NULL if it can't be found */
+static void* ${prefix}getProcAddress(const char *name) {
     void* result = NULL;
+	if (${prefix}loader)
+		return ${prefix}loader(name);
 	if (!${prefix}libGL) {
 		open_gl();
 		if (!${prefix}libGL)
@@ -134,11 +269,752 @@ void* ${prefix}initProcAddress(const char *name, void **fnptr) {
         result = dlsym(${prefix}libGL, name);
 #endif
     }
+    return result;
+}
+
+void* ${prefix}initProcAddress(const char *name, void **fnptr) {
+	void* result = ${prefix}getProcAddress(name);
 	if (!result)
 		croak("Can't look up address of %s", name);
 	*fnptr= result;
     return result;
 }
+
+/* Set every entry of a table to the stub which resolves it lazily */
+void ${prefix}init(struct ${prefix}dispatch *table) {
+END
+$c .= per_fn(sub { "\ttable->$_->{field}= ${prefix}stub_$_->{name};\n" });
+$c .= <<"END";
+}
+
+/* Route GL calls through 'table', or through the default lazy table if NULL */
+void ${prefix}use(struct ${prefix}dispatch *table) {
+	${prefix}active= table? table : &${prefix}lazy;
+	${prefix}route();
+}
+
+/* Look up every function for the current context.  Functions which can't be found, or which
+ * are newer than gl_major.gl_minor, are passed to on_missing (if not NULL).  The ones that
+ * can't be found are left as lazy stubs, which croak if they still can't be found when called.
+ * Returns the number of missing functions.
+ */
+int ${prefix}resolve(struct ${prefix}dispatch *table, int gl_major, int gl_minor,
+	void (*on_missing)(const char *name, void *ctx), void *ctx
+) {
+	int missing= 0, version= gl_major * 10 + gl_minor;
+	void *fn;
+	${prefix}init(table);
+END
+$c .= per_fn(sub {
+	"\tif ((fn= ${prefix}getProcAddress(\"$_->{name}\")))\n"
+	."\t\ttable->$_->{field}= ($_->{typedef}) fn;\n"
+	."\tif (!fn || version < $_->{maj}$_->{min}) {\n"
+	."\t\tmissing++;\n"
+	."\t\tif (on_missing) on_missing(\"$_->{name}\", ctx);\n"
+	."\t}\n"
+});
+$c .= <<"END";
+	return missing;
+}
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+unsigned long long ${prefix}now_ns(void) {
+	static LARGE_INTEGER freq;
+	LARGE_INTEGER now;
+	if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (unsigned long long)((double) now.QuadPart * 1e9 / (double) freq.QuadPart);
+}
+#else
+#include <time.h>
+unsigned long long ${prefix}now_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+#endif
+
+int ${prefix}profiling= 0;
+struct ${prefix}stat ${prefix}stats[${prefix}fn_count + 1];
+struct ${prefix}scope *${prefix}scopes= NULL;
+struct ${prefix}scope *${prefix}cur_scope= NULL;
+
+const char *${prefix}names[]= {
+END
+$c .= per_fn(sub { " \"$_->{name}\",\n" });
+$c .= <<"END";
+ NULL
+};
+
+static void ${prefix}record(int idx, unsigned long long t0) {
+	unsigned long long ns= ${prefix}now_ns() - t0;
+	${prefix}stats[idx].calls++;
+	${prefix}stats[idx].ns += ns;
+	if (${prefix}cur_scope) {
+		${prefix}cur_scope->gl.calls++;
+		${prefix}cur_scope->gl.ns += ns;
+	}
+}
+
+END
+$c .= per_fn(sub {
+	my $call= "${prefix}active->$_->{field}($_->{args})";
+	"static $_->{ret} APIENTRY ${prefix}prof_$_->{name}($_->{params}) {\n"
+	."\tunsigned long long t0= ${prefix}now_ns();\n"
+	.($_->{ret} eq 'void'
+		? "\t$call;\n\t${prefix}record(${prefix}idx_$_->{name}, t0);\n"
+		: "\t$_->{ret} ret= $call;\n\t${prefix}record(${prefix}idx_$_->{name}, t0);\n\treturn ret;\n"
+	)
+	."}\n"
+});
+$c .= "\nstatic struct ${prefix}dispatch ${prefix}prof= {\n";
+$c .= per_fn(sub { " ${prefix}prof_$_->{name},\n" });
+$c .= <<"END";
+ 0
+};
+
+/* Turn the counting wrappers on or off */
+void ${prefix}profile(int enable) {
+	${prefix}profiling= enable;
+	${prefix}cur_scope= NULL;
+	${prefix}route();
+}
+
+void ${prefix}profile_reset(void) {
+	struct ${prefix}scope *scope;
+	memset(${prefix}stats, 0, sizeof(${prefix}stats));
+	for (scope= ${prefix}scopes; scope; scope= scope->next) {
+		memset(&scope->total, 0, sizeof(scope->total));
+		memset(&scope->gl, 0, sizeof(scope->gl));
+	}
+}
+
+/* Called on entry to a function that wants its GL calls totalled separately.
+ * GL calls are credited to the innermost scope.
+ */
+unsigned long long ${prefix}scope_enter(struct ${prefix}scope *scope) {
+	if (!scope->registered) {
+		scope->next= ${prefix}scopes;
+		${prefix}scopes= scope;
+		scope->registered= 1;
+	}
+	scope->outer= ${prefix}cur_scope;
+	${prefix}cur_scope= scope;
+	return ${prefix}now_ns();
+}
+
+void ${prefix}scope_leave(struct ${prefix}scope *scope, unsigned long long t0) {
+	scope->total.calls++;
+	scope->total.ns += ${prefix}now_ns() - t0;
+	${prefix}cur_scope= scope->outer;
+}
+END
+
+# Capture and replay.  Each call is written as a u16 function index, a u32 length, and a body
+# of 8-byte fields: integers as int64, floats as double, and the data of pointer arguments as a
+# u64 length (all ones for NULL) followed by the bytes, padded to 8.  The size of that data is
+# known from the other arguments, as listed here.  Pointers that aren't const are outputs.
+my %payload= (
+	'glBufferData/data'           => 'size',
+	'glBufferSubData/data'        => 'size',
+	'glDeleteBuffers/buffers'     => 'n * sizeof(GLuint)',
+	'glDeleteVertexArrays/arrays' => 'n * sizeof(GLuint)',
+	'glDeleteQueries/ids'         => 'n * sizeof(GLuint)',
+	'glDeleteTextures/textures'   => 'n * sizeof(GLuint)',
+	'glDebugMessageControl/ids'   => 'count * sizeof(GLuint)',
+	'glGetUniformLocation/name'   => 'strlen(name) + 1',
+);
+my %output= (
+	'glGenBuffers/buffers'        => 'n * sizeof(GLuint)',
+	'glGenVertexArrays/arrays'    => 'n * sizeof(GLuint)',
+	'glGenQueries/ids'            => 'n * sizeof(GLuint)',
+	'glGenTextures/textures'      => 'n * sizeof(GLuint)',
+	'glGetActiveUniform/name'     => 'bufSize',
+);
+# Object names differ between the capture and the replay, so the replayer keeps a map for each
+# kind, filled by the ids which the Gen and Create functions returned.
+my %obj_kind= ( buffer => 0, vao => 1, query => 2, texture => 3, shader => 4, program => 5 );
+my %gen_ids= ( 'glGenBuffers/buffers' => 'buffer', 'glGenVertexArrays/arrays' => 'vao',
+	'glGenQueries/ids' => 'query', 'glGenTextures/textures' => 'texture' );
+my %del_ids= ( 'glDeleteBuffers/buffers' => 'buffer', 'glDeleteVertexArrays/arrays' => 'vao',
+	'glDeleteQueries/ids' => 'query', 'glDeleteTextures/textures' => 'texture' );
+my %ret_id= ( glCreateShader => 'shader', glCreateProgram => 'program' );
+# Scalar arguments holding an object name, other than the GLuint ones named after their kind
+my %id_param= ( 'glQueryCounter/id' => 'query', 'glGetQueryObjectiv/id' => 'query',
+	'glGetQueryObjectui64v/id' => 'query', 'glBindVertexArray/array' => 'vao' );
+my $n_kinds= keys %obj_kind;
+# Uniform locations differ too.  They are mapped per program from what glGetUniformLocation
+# returned, and the glUniform functions use the program of the last glUseProgram.
+my $loc_fn= 'glGetUniformLocation';
+# Pointers which are offsets into a bound buffer, rather than client memory
+my %offset_param= map +($_ => 1), qw( glDrawElements/indices glVertexAttribPointer/pointer );
+# Pixels are an offset into the unpack buffer if one is bound, else client memory whose size
+# depends on the pixel store state.  Shader sources are an array of strings, which are joined.
+my %pixels_param= map +($_ => 1), qw( glTexImage2D/pixels glTexSubImage2D/pixels );
+my %source_fn= ( glShaderSource => 1 );
+# Writes to a mapped buffer are captured when it is unmapped
+my %map_fn= (
+	glMapBuffer           => { key => '0, target', len => 'size', write => 'access != GL_READ_ONLY' },
+	glMapBufferRange      => { key => '0, target', len => 'length', write => 'access & GL_MAP_WRITE_BIT' },
+	glMapNamedBufferRange => { key => '1, buffer', len => 'length', write => 'access & GL_MAP_WRITE_BIT' },
+);
+my %unmap_fn= ( glUnmapBuffer => '0, target', glUnmapNamedBuffer => '1, buffer' );
+# Functions which are passed straight through and left out of the trace.  Sync objects are
+# pointers, which can't be mapped to the replay like object names, and only matter to readback.
+my %no_capture= map +($_ => 1), qw( glDebugMessageCallback glFenceSync glClientWaitSync glDeleteSync );
+
+my $have_float= 0;
+my %gl_type= ( f => 'GLfloat', d => 'GLdouble', i => 'GLint', ui => 'GLuint' );
+for my $fn (@fns) {
+	if ($fn->{name} =~ /Uniform([1-4])(f|d|i|ui)v$/) {
+		$payload{"$fn->{name}/value"}= "count * $1 * sizeof($gl_type{$2})";
+	} elsif ($fn->{name} =~ /UniformMatrix([2-4])(?:x([2-4]))?(f|d)v$/) {
+		$payload{"$fn->{name}/value"}= "count * ".($1 * ($2 // $1))." * sizeof($gl_type{$3})";
+	}
+	next if $no_capture{$fn->{name}};
+	for (@{ $fn->{param_list} }) {
+		$_->{key}= "$fn->{name}/$_->{name}";
+		$_->{float}= $_->{type} =~ /^GL(float|double|clampf|clampd)$/;
+		$have_float ||= $_->{float};
+		die "No payload size for $_->{key}\n" if $_->{const} && !defined $payload{$_->{key}}
+			&& !$offset_param{$_->{key}} && !$pixels_param{$_->{key}} && !$source_fn{$fn->{name}};
+	}
+}
+
+# Only needed if some function takes a float
+my ($cap_num, $rd_num)= !$have_float? ('', '') : (
+	"static void ${prefix}cap_num(double v) { ${prefix}cap_bytes(&v, 8); }\n",
+	<<"END");
+static double ${prefix}rd_num(void) {
+	double v= 0;
+	if (${prefix}rd.lim - ${prefix}rd.p < 8) { ${prefix}rd.err= 1; return 0; }
+	memcpy(&v, ${prefix}rd.p, 8);
+	${prefix}rd.p += 8;
+	return v;
+}
+
+END
+
+# Code to record the mapping, given a variable 'ret' holding the address
+sub map_hook {
+	my ($fn, $gl, $indent)= @_;
+	my $m= $map_fn{$fn->{name}};
+	($m->{len} eq 'size'? "${indent}GLint size= 0;\n${indent}${gl}GetBufferParameteriv(target, GL_BUFFER_SIZE, &size);\n" : '')
+	."${indent}${prefix}map_set($m->{key}, ret, (size_t) $m->{len}, ($m->{write})? 1 : 0);\n";
+}
+
+# Declaration of a parameter as a local variable
+sub decl { my ($type, $name)= @_; $type =~ /\*$/? "$type$name" : "$type $name" }
+
+$c .= <<"END";
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int ${prefix}capturing= 0;
+static FILE *${prefix}cap_fh= NULL;
+static unsigned char *${prefix}cap_buf= NULL;
+static size_t ${prefix}cap_len= 0, ${prefix}cap_alloc= 0;
+static int ${prefix}cap_failed= 0;
+/* The table that the capture wrappers pass calls on to */
+static struct ${prefix}dispatch *${prefix}capture_next= &${prefix}lazy;
+
+static void ${prefix}cap_bytes(const void *data, size_t n) {
+	if (${prefix}cap_len + n > ${prefix}cap_alloc) {
+		size_t alloc= ${prefix}cap_alloc? ${prefix}cap_alloc : 4096;
+		unsigned char *buf;
+		while (alloc < ${prefix}cap_len + n) alloc *= 2;
+		if (!(buf= (unsigned char*) realloc(${prefix}cap_buf, alloc))) {
+			${prefix}cap_failed= 1;
+			return;
+		}
+		${prefix}cap_buf= buf;
+		${prefix}cap_alloc= alloc;
+	}
+	memcpy(${prefix}cap_buf + ${prefix}cap_len, data, n);
+	${prefix}cap_len += n;
+}
+
+static void ${prefix}cap_int(long long v) { ${prefix}cap_bytes(&v, 8); }
+${cap_num}
+static void ${prefix}cap_payload(const void *data, size_t n) {
+	static const unsigned char pad[8]= { 0 };
+	unsigned long long len= data? n : ~0ULL;
+	${prefix}cap_bytes(&len, 8);
+	if (data) {
+		${prefix}cap_bytes(data, n);
+		${prefix}cap_bytes(pad, (8 - n % 8) % 8);
+	}
+}
+
+static void ${prefix}cap_begin(void) { ${prefix}cap_len= 0; }
+
+static void ${prefix}cap_write(unsigned short idx, const void *body, unsigned int len) {
+	if (fwrite(&idx, 2, 1, ${prefix}cap_fh) != 1
+		|| fwrite(&len, 4, 1, ${prefix}cap_fh) != 1
+		|| (len && fwrite(body, len, 1, ${prefix}cap_fh) != 1)
+	)
+		${prefix}cap_failed= 1;
+}
+
+static void ${prefix}cap_end(int idx) {
+	${prefix}cap_write((unsigned short) idx, ${prefix}cap_buf, (unsigned int) ${prefix}cap_len);
+}
+
+/* Buffers currently mapped, by target or by buffer name */
+struct ${prefix}mapping { int named; GLuint key; unsigned char *addr; size_t len; int write; };
+static struct ${prefix}mapping ${prefix}maps[16];
+
+static void ${prefix}map_set(int named, GLuint key, void *addr, size_t len, int write) {
+	int i, slot= -1;
+	for (i= 0; i < 16; i++) {
+		if (${prefix}maps[i].addr && ${prefix}maps[i].named == named && ${prefix}maps[i].key == key)
+			break;
+		if (!${prefix}maps[i].addr && slot < 0) slot= i;
+	}
+	if (i < 16) slot= i;
+	if (slot < 0) return; /* too many; its writes won't be captured */
+	${prefix}maps[slot].named= named;
+	${prefix}maps[slot].key= key;
+	${prefix}maps[slot].addr= (unsigned char*) addr;
+	${prefix}maps[slot].len= len;
+	${prefix}maps[slot].write= write;
+}
+
+/* Remove and return the mapping, or NULL */
+static struct ${prefix}mapping* ${prefix}map_take(int named, GLuint key) {
+	static struct ${prefix}mapping m;
+	int i;
+	for (i= 0; i < 16; i++) {
+		if (${prefix}maps[i].addr && ${prefix}maps[i].named == named && ${prefix}maps[i].key == key) {
+			m= ${prefix}maps[i];
+			${prefix}maps[i].addr= NULL;
+			return &m;
+		}
+	}
+	return NULL;
+}
+
+/* Bytes of client memory that a texture upload reads, given the pixel store state, or 0 if the
+ * format or type isn't known */
+static size_t ${prefix}pixels_size(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+	GLint align= 4, row_len= 0, skip_rows= 0, skip_pixels= 0;
+	size_t comps, bpp, row;
+	switch (format) {
+	case GL_RED: case GL_GREEN: case GL_BLUE: case GL_ALPHA: case GL_LUMINANCE:
+	case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX: case GL_RED_INTEGER:
+		comps= 1; break;
+	case GL_RG: case GL_LUMINANCE_ALPHA: case GL_RG_INTEGER: case GL_DEPTH_STENCIL:
+		comps= 2; break;
+	case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+		comps= 3; break;
+	case GL_RGBA: case GL_BGRA: case GL_RGBA_INTEGER: case GL_BGRA_INTEGER:
+		comps= 4; break;
+	default: return 0;
+	}
+	switch (type) {
+	case GL_UNSIGNED_BYTE: case GL_BYTE:
+		bpp= comps; break;
+	case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT:
+		bpp= comps * 2; break;
+	case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT:
+		bpp= comps * 4; break;
+	case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV:
+		bpp= 1; break;
+	case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_5_6_5_REV:
+	case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+	case GL_UNSIGNED_SHORT_5_5_5_1: case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+		bpp= 2; break;
+	case GL_UNSIGNED_INT_8_8_8_8: case GL_UNSIGNED_INT_8_8_8_8_REV:
+	case GL_UNSIGNED_INT_10_10_10_2: case GL_UNSIGNED_INT_2_10_10_10_REV:
+	case GL_UNSIGNED_INT_24_8: case GL_UNSIGNED_INT_10F_11F_11F_REV: case GL_UNSIGNED_INT_5_9_9_9_REV:
+		bpp= 4; break;
+	default: return 0;
+	}
+	if (width <= 0 || height <= 0) return 0;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &align);
+	glGetIntegerv(GL_UNPACK_ROW_LENGTH, &row_len);
+	glGetIntegerv(GL_UNPACK_SKIP_ROWS, &skip_rows);
+	glGetIntegerv(GL_UNPACK_SKIP_PIXELS, &skip_pixels);
+	if (align < 1) align= 1;
+	row= ((size_t)(row_len > 0? row_len : width) * bpp + align - 1) / align * align;
+	return (size_t)(skip_rows + height - 1) * row + (size_t)(skip_pixels + width) * bpp;
+}
+
+/* Whether the context has pixel unpack buffers, so that querying the binding isn't an error */
+static int ${prefix}cap_has_pbo= 0;
+
+/* The pixels of a texture upload: whether they are an offset into the bound unpack buffer,
+ * then the offset, or the bytes they point to.
+ */
+static void ${prefix}cap_pixels(const void *pixels, GLsizei width, GLsizei height, GLenum format, GLenum type) {
+	GLint pbo= 0;
+	size_t n;
+#ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
+	if (${prefix}cap_has_pbo)
+		glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &pbo);
+#endif
+	${prefix}cap_int(pbo != 0);
+	if (pbo) {
+		${prefix}cap_int((long long)(size_t) pixels);
+		return;
+	}
+	n= pixels? ${prefix}pixels_size(width, height, format, type) : 0;
+	${prefix}cap_payload(n? pixels : NULL, n);
+}
+
+/* The strings of glShaderSource, joined into one payload */
+static void ${prefix}cap_sources(GLsizei count, const GLchar *const *string, const GLint *length) {
+	static const unsigned char pad[8]= { 0 };
+	unsigned long long len= 0;
+	GLsizei i;
+	for (i= 0; i < count; i++)
+		len += length && length[i] >= 0? (size_t) length[i] : strlen(string[i]);
+	${prefix}cap_bytes(&len, 8);
+	for (i= 0; i < count; i++)
+		${prefix}cap_bytes(string[i], length && length[i] >= 0? (size_t) length[i] : strlen(string[i]));
+	${prefix}cap_bytes(pad, (8 - len % 8) % 8);
+}
+
+/* Write the contents of a buffer which is about to be unmapped */
+static void ${prefix}cap_unmap(int named, GLuint key) {
+	struct ${prefix}mapping *m= ${prefix}map_take(named, key);
+	${prefix}cap_payload(m && m->write? m->addr : NULL, m? m->len : 0);
+}
+
+END
+$c .= per_fn(sub {
+	my $fn= $_;
+	my $out= "static $fn->{ret} APIENTRY ${prefix}cap_$fn->{name}($fn->{params}) {\n";
+	return $out."\t".($fn->{ret} eq 'void'? '' : 'return ')."${prefix}capture_next->$fn->{field}($fn->{args});\n}\n"
+		if $no_capture{$fn->{name}};
+	$out .= "\t".decl($fn->{ret}, 'ret').";\n" unless $fn->{ret} eq 'void';
+	$out .= "\t${prefix}cap_begin();\n";
+	for (@{ $fn->{param_list} }) {
+		if ($source_fn{$fn->{name}} && $_->{ptr}) {
+			$out .= "\t${prefix}cap_sources(count, string, length);\n" if $_->{name} eq 'string';
+		} elsif ($offset_param{$_->{key}}) {
+			$out .= "\t${prefix}cap_int((long long)(size_t) $_->{name});\n";
+		} elsif ($pixels_param{$_->{key}}) {
+			$out .= "\t${prefix}cap_pixels($_->{name}, width, height, format, type);\n";
+		} elsif ($_->{const}) {
+			$out .= "\t${prefix}cap_payload($_->{name}, $_->{name}? (size_t)($payload{$_->{key}}) : 0);\n";
+		} elsif (!$_->{ptr}) {
+			$out .= $_->{float}? "\t${prefix}cap_num((double) $_->{name});\n"
+				: "\t${prefix}cap_int((long long) $_->{name});\n";
+		}
+	}
+	$out .= "\t${prefix}cap_unmap($unmap_fn{$fn->{name}});\n" if $unmap_fn{$fn->{name}};
+	$out .= "\t".($fn->{ret} eq 'void'? '' : 'ret= ')."${prefix}capture_next->$fn->{field}($fn->{args});\n";
+	for (grep $gen_ids{$_->{key}}, @{ $fn->{param_list} }) {
+		$out .= "\t${prefix}cap_payload($_->{name}, n > 0? (size_t)($output{$_->{key}}) : 0);\n";
+	}
+	$out .= "\t${prefix}cap_int((long long) ret);\n" if $ret_id{$fn->{name}} || $fn->{name} eq $loc_fn;
+	$out .= "\tif (ret) {\n".map_hook($fn, "${prefix}active->", "\t\t")."\t}\n" if $map_fn{$fn->{name}};
+	$out .= "\t${prefix}cap_end(${prefix}idx_$fn->{name});\n";
+	$out .= "\treturn ret;\n" unless $fn->{ret} eq 'void';
+	$out . "}\n";
+});
+$c .= "\nstatic struct ${prefix}dispatch ${prefix}cap= {\n";
+$c .= per_fn(sub { " ${prefix}cap_$_->{name},\n" });
+$c .= <<"END";
+ 0
+};
+
+static void ${prefix}route(void) {
+	${prefix}capture_next= ${prefix}profiling? &${prefix}prof : ${prefix}active;
+	${prefix}current= ${prefix}capturing? &${prefix}cap : ${prefix}capture_next;
+}
+
+/* Begin writing every GL call to a trace file.  Returns 0 if the file can't be written. */
+int ${prefix}capture_start(const char *path) {
+	unsigned int version= 2, count= ${prefix}fn_count, i;
+	unsigned char len;
+	if (${prefix}capturing) ${prefix}capture_stop();
+	if (!(${prefix}cap_fh= fopen(path, "wb")))
+		return 0;
+	${prefix}cap_failed= 0;
+	memset(${prefix}maps, 0, sizeof(${prefix}maps));
+	${prefix}cap_has_pbo= 0;
+#ifdef GL_PIXEL_UNPACK_BUFFER_BINDING
+	{
+		const char *v= (const char*) glGetString(GL_VERSION);
+		int major= 0, minor= 0;
+		while (v && *v && (*v < '0' || *v > '9')) v++;
+		if (v && sscanf(v, "%d.%d", &major, &minor) == 2)
+			${prefix}cap_has_pbo= major * 10 + minor >= 21;
+	}
+#endif
+	/* The names let a replayer built from a different list find its own index for each */
+	fwrite("GLDTRACE", 8, 1, ${prefix}cap_fh);
+	fwrite(&version, 4, 1, ${prefix}cap_fh);
+	fwrite(&count, 4, 1, ${prefix}cap_fh);
+	for (i= 0; i < count; i++) {
+		len= (unsigned char) strlen(${prefix}names[i]);
+		fwrite(&len, 1, 1, ${prefix}cap_fh);
+		fwrite(${prefix}names[i], len, 1, ${prefix}cap_fh);
+	}
+	${prefix}capturing= 1;
+	${prefix}route();
+	return 1;
+}
+
+/* Mark the end of a frame, which the replayer times separately */
+void ${prefix}capture_frame(void) {
+	if (${prefix}capturing)
+		${prefix}cap_write(0xFFFF, "", 0);
+}
+
+/* Stop capturing and close the file.  Returns 0 if any write failed. */
+int ${prefix}capture_stop(void) {
+	int ok;
+	if (!${prefix}capturing) return 1;
+	${prefix}capturing= 0;
+	${prefix}route();
+	ok= !${prefix}cap_failed && !ferror(${prefix}cap_fh);
+	if (fclose(${prefix}cap_fh)) ok= 0;
+	${prefix}cap_fh= NULL;
+	return ok;
+}
+
+#ifdef GLDUCKTAPE_REPLAYER
+
+static struct { const unsigned char *p, *lim; int err; } ${prefix}rd;
+
+static long long ${prefix}rd_int(void) {
+	long long v= 0;
+	if (${prefix}rd.lim - ${prefix}rd.p < 8) { ${prefix}rd.err= 1; return 0; }
+	memcpy(&v, ${prefix}rd.p, 8);
+	${prefix}rd.p += 8;
+	return v;
+}
+
+${rd_num}static const void* ${prefix}rd_payload(size_t *n) {
+	unsigned long long len= (unsigned long long) ${prefix}rd_int();
+	const unsigned char *data= ${prefix}rd.p;
+	*n= 0;
+	if (${prefix}rd.err || len == ~0ULL) return NULL;
+	if (len > (unsigned long long)(${prefix}rd.lim - data) || ((len + 7) & ~7ULL) > (unsigned long long)(${prefix}rd.lim - data)) {
+		${prefix}rd.err= 1;
+		return NULL;
+	}
+	${prefix}rd.p += (len + 7) & ~7ULL;
+	*n= (size_t) len;
+	return data;
+}
+
+/* Temporary memory for output arguments, freed after each call */
+static void *${prefix}rp_tmp[8];
+static int ${prefix}rp_ntmp= 0;
+
+static void* ${prefix}rp_alloc(long long size) {
+	void *p;
+	if (size < 0 || size > (1LL << 30) || ${prefix}rp_ntmp >= 8
+		|| !(p= calloc(1, size? (size_t) size : 1))
+	) {
+		${prefix}rd.err= 1;
+		return NULL;
+	}
+	return ${prefix}rp_tmp[${prefix}rp_ntmp++]= p;
+}
+
+/* Map of captured object names to replayed object names, for each kind of object */
+static GLuint *${prefix}rp_ids[$n_kinds];
+static size_t ${prefix}rp_ids_len[$n_kinds];
+
+static GLuint ${prefix}rp_id(int kind, GLuint id) {
+	return id < ${prefix}rp_ids_len[kind] && ${prefix}rp_ids[kind][id]? ${prefix}rp_ids[kind][id] : id;
+}
+
+static void ${prefix}rp_set_id(int kind, GLuint id, GLuint replayed) {
+	if (id >= ${prefix}rp_ids_len[kind]) {
+		size_t len= ${prefix}rp_ids_len[kind]? ${prefix}rp_ids_len[kind] : 64;
+		GLuint *ids;
+		while (len <= id) len *= 2;
+		if (len > (1 << 24) || !(ids= (GLuint*) realloc(${prefix}rp_ids[kind], len * sizeof(GLuint)))) {
+			${prefix}rd.err= 1;
+			return;
+		}
+		memset(ids + ${prefix}rp_ids_len[kind], 0, (len - ${prefix}rp_ids_len[kind]) * sizeof(GLuint));
+		${prefix}rp_ids[kind]= ids;
+		${prefix}rp_ids_len[kind]= len;
+	}
+	${prefix}rp_ids[kind][id]= replayed;
+}
+
+static const GLuint* ${prefix}rp_id_list(int kind, const GLuint *ids, GLsizei n) {
+	GLuint *out= (GLuint*) ${prefix}rp_alloc((long long) n * sizeof(GLuint));
+	GLsizei i;
+	if (out)
+		for (i= 0; i < n; i++) out[i]= ${prefix}rp_id(kind, ids[i]);
+	return out;
+}
+
+/* Map of captured uniform locations to replayed ones, keyed by the replayed program, in an
+ * open-addressed hash table.  Program 0 marks an empty slot.
+ */
+struct ${prefix}rp_loc { GLuint program; GLint from, to; };
+static struct ${prefix}rp_loc *${prefix}rp_locs;
+static size_t ${prefix}rp_locs_len, ${prefix}rp_locs_alloc;
+/* The replayed program of the last glUseProgram, which glUniform* calls refer to */
+static GLuint ${prefix}rp_program= 0;
+
+static struct ${prefix}rp_loc* ${prefix}rp_loc_slot(struct ${prefix}rp_loc *locs, size_t alloc, GLuint program, GLint from) {
+	size_t i= ((size_t) program * 2654435761U ^ (size_t)(unsigned) from) & (alloc - 1);
+	while (locs[i].program && !(locs[i].program == program && locs[i].from == from))
+		i= (i + 1) & (alloc - 1);
+	return locs + i;
+}
+
+static GLint ${prefix}rp_loc(GLuint program, GLint from) {
+	struct ${prefix}rp_loc *l;
+	if (from < 0 || !${prefix}rp_locs_alloc) return from;
+	l= ${prefix}rp_loc_slot(${prefix}rp_locs, ${prefix}rp_locs_alloc, program, from);
+	return l->program? l->to : from;
+}
+
+static void ${prefix}rp_set_loc(GLuint program, GLint from, GLint to) {
+	struct ${prefix}rp_loc *l;
+	size_t i;
+	if (from < 0 || !program) return;
+	if ((${prefix}rp_locs_len + 1) * 2 > ${prefix}rp_locs_alloc) {
+		size_t alloc= ${prefix}rp_locs_alloc? ${prefix}rp_locs_alloc * 2 : 64;
+		struct ${prefix}rp_loc *locs= (struct ${prefix}rp_loc*) calloc(alloc, sizeof(*locs));
+		if (!locs) {
+			${prefix}rd.err= 1;
+			return;
+		}
+		for (i= 0; i < ${prefix}rp_locs_alloc; i++)
+			if (${prefix}rp_locs[i].program)
+				*${prefix}rp_loc_slot(locs, alloc, ${prefix}rp_locs[i].program, ${prefix}rp_locs[i].from)= ${prefix}rp_locs[i];
+		free(${prefix}rp_locs);
+		${prefix}rp_locs= locs;
+		${prefix}rp_locs_alloc= alloc;
+	}
+	l= ${prefix}rp_loc_slot(${prefix}rp_locs, ${prefix}rp_locs_alloc, program, from);
+	if (!l->program) ${prefix}rp_locs_len++;
+	l->program= program;
+	l->from= from;
+	l->to= to;
+}
+
+/* Read the pixels written by cap_pixels */
+static const void* ${prefix}rp_pixels(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+	const void *data;
+	size_t n;
+	if (${prefix}rd_int())
+		return (const void*)(size_t) ${prefix}rd_int();
+	data= ${prefix}rd_payload(&n);
+	if (data && n < ${prefix}pixels_size(width, height, format, type))
+		${prefix}rd.err= 1;
+	return data;
+}
+
+static void ${prefix}rp_unmap(int named, GLuint key, const void *data, size_t n) {
+	struct ${prefix}mapping *m= ${prefix}map_take(named, key);
+	if (m && data)
+		memcpy(m->addr, data, n < m->len? n : m->len);
+}
+
+/* Make one captured call, given the function index (of this build) and the record body.
+ * Returns 0 if the record is malformed.
+ */
+int ${prefix}replay_call(int idx, const unsigned char *body, size_t len) {
+	static unsigned char *copy= NULL;
+	static size_t copy_alloc= 0;
+	int i;
+	/* copy for alignment */
+	if (len > copy_alloc) {
+		unsigned char *p= (unsigned char*) realloc(copy, len);
+		if (!p) return 0;
+		copy= p;
+		copy_alloc= len;
+	}
+	if (len) memcpy(copy, body, len);
+	${prefix}rd.p= copy;
+	${prefix}rd.lim= copy + len;
+	${prefix}rd.err= 0;
+	${prefix}rp_ntmp= 0;
+	switch (idx) {
+END
+$c .= per_fn(sub {
+	my $fn= $_;
+	return '' if $no_capture{$fn->{name}};
+	my $out= "\tcase ${prefix}idx_$fn->{name}: {\n";
+	my (@check, @fix);
+	for (@{ $fn->{param_list} }) {
+		my ($type, $name)= @{$_}{'type','name'};
+		if ($source_fn{$fn->{name}} && $_->{ptr}) {
+			# one string, of the joined length
+			if ($name eq 'string') {
+				$out .= "\t\tsize_t n_source;\n"
+					."\t\tconst GLchar *source= (const GLchar*) ${prefix}rd_payload(&n_source);\n"
+					."\t\tGLint source_len= (GLint) n_source;\n";
+				push @check, '!source';
+				push @fix, "\t\tcount= 1;\n";
+			}
+			$out .= "\t\t".decl($type, $name)."= ".($name eq 'string'? '&source' : '&source_len').";\n";
+		} elsif ($offset_param{$_->{key}}) {
+			$out .= "\t\t".decl($type, $name)."= ($type)(size_t) ${prefix}rd_int();\n";
+		} elsif ($pixels_param{$_->{key}}) {
+			$out .= "\t\t".decl($type, $name)."= ${prefix}rp_pixels(width, height, format, type);\n";
+		} elsif ($_->{const}) {
+			$out .= "\t\tsize_t n_$name;\n\t\t".decl($type, $name)."= ($type) ${prefix}rd_payload(&n_$name);\n";
+			push @check, $payload{$_->{key}} =~ /^strlen/
+				? "($name && !memchr($name, 0, n_$name))"
+				: "($name && n_$name < (size_t)($payload{$_->{key}}))";
+			push @fix, "\t\tif ($name) $name= ${prefix}rp_id_list($obj_kind{$del_ids{$_->{key}}}, $name, n);\n"
+				if $del_ids{$_->{key}};
+		} elsif ($_->{ptr}) {
+			(my $base= $type) =~ s/\s*\*\s*$//;
+			$out .= "\t\t".decl($type, $name)."= NULL;\n";
+			push @fix, "\t\t$name= ($type) ${prefix}rp_alloc(".($output{$_->{key}} // "16 * sizeof($base)").");\n";
+		} else {
+			$out .= "\t\t".decl($type, $name)."= ($type) ".($_->{float}? "${prefix}rd_num()" : "${prefix}rd_int()").";\n";
+			my $kind= $id_param{$_->{key}} // (defined $obj_kind{$name} && $type eq 'GLuint'? $name : undef);
+			push @fix, "\t\t$name= ${prefix}rp_id($obj_kind{$kind}, $name);\n"
+				if $kind;
+			# after the program, for glProgramUniform*
+			push @fix, "\t\t$name= ${prefix}rp_loc(".($fn->{args} =~ /^program\b/? 'program' : "${prefix}rp_program").", $name);\n"
+				if $name eq 'location' && $fn->{name} =~ /Uniform/;
+		}
+	}
+	if ($unmap_fn{$fn->{name}}) {
+		$out .= "\t\tsize_t n_mapped;\n\t\tconst void *mapped= ${prefix}rd_payload(&n_mapped);\n";
+	}
+	my $want_ret= $map_fn{$fn->{name}} || $ret_id{$fn->{name}} || $fn->{name} eq $loc_fn;
+	$out .= "\t\t".decl($fn->{ret}, 'ret').";\n" if $want_ret;
+	$out .= "\t\tif (${prefix}rd.err".join('', map " || $_", @check).") return 0;\n";
+	$out .= join '', @fix;
+	$out .= "\t\tif (${prefix}rd.err) break;\n" if @fix;
+	$out .= "\t\t${prefix}rp_unmap($unmap_fn{$fn->{name}}, mapped, n_mapped);\n" if $unmap_fn{$fn->{name}};
+	$out .= "\t\t".($want_ret? 'ret= ' : '')."$fn->{name}($fn->{args});\n";
+	$out .= "\t\tif (ret) {\n".map_hook($fn, "${prefix}current->", "\t\t\t")."\t\t}\n" if $map_fn{$fn->{name}};
+	$out .= "\t\t${prefix}rp_set_id($obj_kind{$ret_id{$fn->{name}}}, (GLuint) ${prefix}rd_int(), ret);\n" if $ret_id{$fn->{name}};
+	$out .= "\t\t${prefix}rp_set_loc(program, (GLint) ${prefix}rd_int(), ret);\n" if $fn->{name} eq $loc_fn;
+	$out .= "\t\t${prefix}rp_program= program;\n" if $fn->{name} eq 'glUseProgram';
+	for (grep $gen_ids{$_->{key}}, @{ $fn->{param_list} }) {
+		my $kind= $obj_kind{$gen_ids{$_->{key}}};
+		$out .= "\t\t{\n"
+			."\t\t\tsize_t n_cap_ids;\n"
+			."\t\t\tconst GLuint *cap_ids= (const GLuint*) ${prefix}rd_payload(&n_cap_ids);\n"
+			."\t\t\tfor (i= 0; cap_ids && i < n && (size_t) i < n_cap_ids / sizeof(GLuint); i++)\n"
+			."\t\t\t\t${prefix}rp_set_id($kind, cap_ids[i], $_->{name}\[i]);\n"
+			."\t\t}\n";
+	}
+	$out . "\t\tbreak;\n\t}\n";
+});
+$c .= <<"END";
+	default:
+		${prefix}rd.err= 1;
+	}
+	while (${prefix}rp_ntmp > 0)
+		free(${prefix}rp_tmp[--${prefix}rp_ntmp]);
+	return !${prefix}rd.err;
+}
+
+#endif /* GLDUCKTAPE_REPLAYER */
 END
 
 print $h.$c;
@@ -0,0 +1,622 @@
+/* Writing captured frames to disk on a worker thread, for OpenGL::Sandbox::FrameWriter.
+ * frame_writer_push copies an RGBA frame into a bounded queue and returns; the worker converts
+ * and writes it as raw RGBA, as YUV 4:2:0 in a Y4M stream, or as a numbered PNG file.  When the
+ * queue is full, the frame is either dropped or the caller waits for space, per opts.block.
+ * Perl may redefine the C library's stdio and malloc to functions that need the interpreter,
+ * so all memory is allocated on the caller's thread by frame_writer_open, and the worker only
+ * uses the OS file and thread APIs.
+ * Functions return 0 on failure and write a message into frame_writer_error.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) && !defined(FRAME_NO_SIMD)
+#include <emmintrin.h>
+#define FRAME_SSE2 1
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define FRAME_RAW 1
+#define FRAME_Y4M 2
+#define FRAME_PNG 3
+#define FRAME_MAX_DIM   16384
+#define FRAME_MAX_QUEUE 64
+
+struct frame_writer_opts {
+	int format, width, height;
+	int fps_num, fps_den;
+	int queue_len; /* frames that can wait to be written */
+	int block;     /* when the queue is full, wait for space instead of dropping the frame */
+	int flip;      /* rows are bottom-up, as from glReadPixels */
+};
+
+struct frame_writer {
+	struct frame_writer_opts opts;
+	size_t frame_size, scratch_size;
+	unsigned char *queue[FRAME_MAX_QUEUE];
+	unsigned char *scratch; /* the converted frame */
+	int head, count, stop, failed, running;
+	unsigned long long written, dropped, seq;
+	/* for PNG, the file name is prefix, frame number padded to 'digits', suffix */
+	char prefix[1024], suffix[64], path[1024 + 24 + 64];
+	int digits;
+	/* set by the worker when a write fails; the message is made on the caller's thread */
+	const char *err_what;
+	int err_code;
+#ifdef _WIN32
+	HANDLE fh, thread;
+	CRITICAL_SECTION lock;
+	CONDITION_VARIABLE more, space;
+#else
+	int fd;
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t more, space;
+#endif
+};
+
+static char frame_writer_error[1200];
+
+/* Files and threads */
+
+#ifdef _WIN32
+#define FW_LOCK(fw)           EnterCriticalSection(&(fw)->lock)
+#define FW_UNLOCK(fw)         LeaveCriticalSection(&(fw)->lock)
+#define FW_WAIT(fw, cond)     SleepConditionVariableCS(&(fw)->cond, &(fw)->lock, INFINITE)
+#define FW_SIGNAL(fw, cond)   WakeConditionVariable(&(fw)->cond)
+#define FW_ERRNO              ((int) GetLastError())
+
+static int frame_file_open(struct frame_writer *fw, const char *path) {
+	fw->fh= CreateFileA(path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	return fw->fh != INVALID_HANDLE_VALUE;
+}
+
+static int frame_file_write(struct frame_writer *fw, const void *data, size_t len) {
+	DWORD n;
+	while (len) {
+		if (!WriteFile(fw->fh, data, len > 0x40000000? 0x40000000 : (DWORD) len, &n, NULL) || !n)
+			return 0;
+		data= (const char*) data + n;
+		len -= n;
+	}
+	return 1;
+}
+
+static int frame_file_close(struct frame_writer *fw) {
+	int ok= CloseHandle(fw->fh) != 0;
+	fw->fh= INVALID_HANDLE_VALUE;
+	return ok;
+}
+#else
+#define FW_LOCK(fw)           pthread_mutex_lock(&(fw)->lock)
+#define FW_UNLOCK(fw)         pthread_mutex_unlock(&(fw)->lock)
+#define FW_WAIT(fw, cond)     pthread_cond_wait(&(fw)->cond, &(fw)->lock)
+#define FW_SIGNAL(fw, cond)   pthread_cond_signal(&(fw)->cond)
+#define FW_ERRNO              errno
+
+static int frame_file_open(struct frame_writer *fw, const char *path) {
+	return (fw->fd= open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666)) >= 0;
+}
+
+static int frame_file_write(struct frame_writer *fw, const void *data, size_t len) {
+	ssize_t n;
+	while (len) {
+		if ((n= write(fw->fd, data, len)) < 0) {
+			if (errno == EINTR) continue;
+			return 0;
+		}
+		data= (const char*) data + n;
+		len -= n;
+	}
+	return 1;
+}
+
+static int frame_file_close(struct frame_writer *fw) {
+	int ok= close(fw->fd) == 0;
+	fw->fd= -1;
+	return ok;
+}
+#endif
+
+/* Full-range BT.601 (as used by JPEG, and Y4M's C420jpeg) in fixed point:
+ *   Y = ( 77 R + 150 G +  29 B) / 256
+ *   U = (-43 R -  85 G + 128 B) / 256 + 128
+ *   V = (128 R - 107 G -  21 B) / 256 + 128
+ * U and V are computed from the sum of a 2x2 block of pixels, so they are divided by 1024.
+ * The SIMD and scalar versions give identical results.
+ */
+#define FRAME_Y(r,g,b)  ((77*(r) + 150*(g) + 29*(b) + 128) >> 8)
+#define FRAME_UV_BIAS   (128*1024 + 512)
+
+static unsigned char frame_clamp_uv(int v) {
+	v >>= 10;
+	return v > 255? 255 : (unsigned char) v;
+}
+
+#if FRAME_SSE2
+/* Given two registers each holding two pixels as 16-bit RGBA, return the 32-bit dot
+ * product of each of the four pixels with the coefficients in 'coef' (repeated twice).
+ */
+static __m128i frame_sse2_dot4(__m128i lo, __m128i hi, __m128i coef) {
+	__m128i a= _mm_madd_epi16(lo, coef), b= _mm_madd_epi16(hi, coef);
+	a= _mm_add_epi32(a, _mm_srli_epi64(a, 32));
+	b= _mm_add_epi32(b, _mm_srli_epi64(b, 32));
+	return _mm_unpacklo_epi64(_mm_shuffle_epi32(a, _MM_SHUFFLE(3,1,2,0)), _mm_shuffle_epi32(b, _MM_SHUFFLE(3,1,2,0)));
+}
+
+/* Sum each horizontal pair of pixels of two rows of 16-bit RGBA (two pixels per register) */
+static __m128i frame_sse2_pair_sum(__m128i a, __m128i b) {
+	__m128i s= _mm_add_epi16(a, b);
+	return _mm_add_epi16(s, _mm_srli_si128(s, 8));
+}
+#endif
+
+static void frame_rgba_to_y(const unsigned char *src, unsigned char *dst, int width) {
+	int x= 0;
+#if FRAME_SSE2
+	const __m128i zero= _mm_setzero_si128(), round= _mm_set1_epi32(128);
+	const __m128i coef= _mm_setr_epi16(77, 150, 29, 0, 77, 150, 29, 0);
+	__m128i p0, p1, y0, y1;
+	for (; x + 8 <= width; x += 8) {
+		p0= _mm_loadu_si128((const __m128i*) (src + x*4));
+		p1= _mm_loadu_si128((const __m128i*) (src + x*4 + 16));
+		y0= frame_sse2_dot4(_mm_unpacklo_epi8(p0, zero), _mm_unpackhi_epi8(p0, zero), coef);
+		y1= frame_sse2_dot4(_mm_unpacklo_epi8(p1, zero), _mm_unpackhi_epi8(p1, zero), coef);
+		y0= _mm_srai_epi32(_mm_add_epi32(y0, round), 8);
+		y1= _mm_srai_epi32(_mm_add_epi32(y1, round), 8);
+		y0= _mm_packs_epi32(y0, y1);
+		_mm_storel_epi64((__m128i*) (dst + x), _mm_packus_epi16(y0, y0));
+	}
+#endif
+	for (; x < width; x++)
+		dst[x]= (unsigned char) FRAME_Y(src[x*4], src[x*4+1], src[x*4+2]);
+}
+
+/* One row of U and V from two rows of pixels.  An odd last column is paired with itself. */
+static void frame_rgba_to_uv(const unsigned char *row0, const unsigned char *row1,
+	unsigned char *u, unsigned char *v, int width
+) {
+	int cx= 0, x0, x1, r, g, b, cw= (width + 1) / 2;
+#if FRAME_SSE2
+	const __m128i zero= _mm_setzero_si128(), bias= _mm_set1_epi32(FRAME_UV_BIAS);
+	const __m128i coef_u= _mm_setr_epi16(-43, -85, 128, 0, -43, -85, 128, 0);
+	const __m128i coef_v= _mm_setr_epi16(128, -107, -21, 0, 128, -107, -21, 0);
+	__m128i a0, a1, b0, b1, s01, s23, ru, rv;
+	int out;
+	for (; cx*2 + 8 <= width; cx += 4) {
+		a0= _mm_loadu_si128((const __m128i*) (row0 + cx*8));
+		a1= _mm_loadu_si128((const __m128i*) (row0 + cx*8 + 16));
+		b0= _mm_loadu_si128((const __m128i*) (row1 + cx*8));
+		b1= _mm_loadu_si128((const __m128i*) (row1 + cx*8 + 16));
+		/* 16-bit RGBA sums of the 2x2 blocks, two blocks per register */
+		s01= _mm_unpacklo_epi64(
+			frame_sse2_pair_sum(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero)),
+			frame_sse2_pair_sum(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero)));
+		s23= _mm_unpacklo_epi64(
+			frame_sse2_pair_sum(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero)),
+			frame_sse2_pair_sum(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero)));
+		ru= _mm_srai_epi32(_mm_add_epi32(frame_sse2_dot4(s01, s23, coef_u), bias), 10);
+		rv= _mm_srai_epi32(_mm_add_epi32(frame_sse2_dot4(s01, s23, coef_v), bias), 10);
+		ru= _mm_packs_epi32(ru, rv);
+		ru= _mm_packus_epi16(ru, ru);
+		out= _mm_cvtsi128_si32(ru);
+		memcpy(u + cx, &out, 4);
+		out= _mm_cvtsi128_si32(_mm_srli_si128(ru, 4));
+		memcpy(v + cx, &out, 4);
+	}
+#endif
+	for (; cx < cw; cx++) {
+		x0= cx*8;
+		x1= cx*2 + 1 < width? x0 + 4 : x0;
+		r= row0[x0]   + row0[x1]   + row1[x0]   + row1[x1];
+		g= row0[x0+1] + row0[x1+1] + row1[x0+1] + row1[x1+1];
+		b= row0[x0+2] + row0[x1+2] + row1[x0+2] + row1[x1+2];
+		u[cx]= frame_clamp_uv(-43*r -  85*g + 128*b + FRAME_UV_BIAS);
+		v[cx]= frame_clamp_uv(128*r - 107*g -  21*b + FRAME_UV_BIAS);
+	}
+}
+
+/* PNG, stored without compression so that zlib isn't needed */
+
+/* CRC-32 four bytes at a time ("slicing-by-4"); table[k][n] is the CRC of byte n followed by k zeros */
+static unsigned int frame_crc_table[4][256];
+
+static void frame_crc_init(void) {
+	unsigned int c, n, k;
+	if (frame_crc_table[0][1]) return;
+	for (n= 0; n < 256; n++) {
+		for (c= n, k= 0; k < 8; k++)
+			c= (c & 1)? 0xEDB88320U ^ (c >> 1) : c >> 1;
+		frame_crc_table[0][n]= c;
+	}
+	for (n= 0; n < 256; n++)
+		for (k= 1; k < 4; k++)
+			frame_crc_table[k][n]= frame_crc_table[0][frame_crc_table[k-1][n] & 0xFF] ^ (frame_crc_table[k-1][n] >> 8);
+}
+
+static unsigned int frame_crc(unsigned int crc, const unsigned char *p, size_t len) {
+	crc ^= 0xFFFFFFFFU;
+	for (; len >= 4; len -= 4, p += 4) {
+		crc ^= p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int) p[3] << 24);
+		crc= frame_crc_table[3][crc & 0xFF] ^ frame_crc_table[2][(crc >> 8) & 0xFF]
+		   ^ frame_crc_table[1][(crc >> 16) & 0xFF] ^ frame_crc_table[0][crc >> 24];
+	}
+	while (len--) crc= frame_crc_table[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+	return crc ^ 0xFFFFFFFFU;
+}
+
+static unsigned char* frame_put_be32(unsigned char *p, unsigned int v) {
+	p[0]= v >> 24; p[1]= v >> 16; p[2]= v >> 8; p[3]= v;
+	return p + 4;
+}
+
+/* Size of the IDAT data for a frame: zlib header, a 5-byte header per stored block of up to
+ * 65535 bytes, the filtered rows, and the adler32.
+ */
+static size_t frame_png_zlib_size(int width, int height) {
+	size_t raw= (size_t) height * (1 + (size_t) width * 4);
+	return 2 + (raw + 65534) / 65535 * 5 + raw + 4;
+}
+
+struct frame_png_stream {
+	unsigned char *p;
+	size_t block_left, total_left;
+	unsigned int s1, s2; /* adler32 */
+};
+
+static void frame_png_put(struct frame_png_stream *z, const unsigned char *data, size_t len) {
+	size_t n, i, end;
+	unsigned int s1= z->s1, s2= z->s2;
+	while (len) {
+		if (!z->block_left) {
+			z->block_left= z->total_left < 65535? z->total_left : 65535;
+			*z->p++= z->block_left == z->total_left? 1 : 0; /* final block flag */
+			z->p[0]= z->block_left & 0xFF;
+			z->p[1]= z->block_left >> 8;
+			z->p[2]= ~z->block_left & 0xFF;
+			z->p[3]= (~z->block_left >> 8) & 0xFF;
+			z->p += 4;
+		}
+		n= len < z->block_left? len : z->block_left;
+		memcpy(z->p, data, n);
+		/* 5552 is the most bytes that can be summed before s2 could overflow 32 bits */
+		for (i= 0; i < n; ) {
+			for (end= i + 5552 < n? i + 5552 : n; i < end; i++) {
+				s1 += data[i];
+				s2 += s1;
+			}
+			s1 %= 65521;
+			s2 %= 65521;
+		}
+		z->p += n;
+		data += n;
+		len -= n;
+		z->block_left -= n;
+		z->total_left -= n;
+	}
+	z->s1= s1;
+	z->s2= s2;
+}
+
+/* Return a pointer to row y (counting from the top of the image) of a frame */
+static const unsigned char* frame_row(struct frame_writer *fw, const unsigned char *frame, int y) {
+	int w= fw->opts.width, h= fw->opts.height;
+	return frame + (size_t)(fw->opts.flip? h - 1 - y : y) * w * 4;
+}
+
+static size_t frame_encode_png(struct frame_writer *fw, const unsigned char *frame) {
+	static const unsigned char filter_none= 0;
+	static const unsigned char iend[12]= { 0,0,0,0, 'I','E','N','D', 0xAE,0x42,0x60,0x82 };
+	struct frame_png_stream z;
+	unsigned char *start= fw->scratch, *p= fw->scratch, *idat;
+	int w= fw->opts.width, h= fw->opts.height, y;
+	size_t zlen= frame_png_zlib_size(w, h);
+
+	memcpy(p, "\x89PNG\r\n\x1a\n", 8);
+	p= frame_put_be32(p + 8, 13);
+	memcpy(p, "IHDR", 4);
+	p= frame_put_be32(p + 4, w);
+	p= frame_put_be32(p, h);
+	p[0]= 8; p[1]= 6; p[2]= p[3]= p[4]= 0; /* 8-bit RGBA, no interlace */
+	p= frame_put_be32(p + 5, frame_crc(0, start + 12, 17));
+
+	p= frame_put_be32(p, (unsigned int) zlen);
+	idat= p;
+	memcpy(p, "IDAT", 4);
+	p[4]= 0x78; p[5]= 0x01;
+	z.p= p + 6;
+	z.block_left= 0;
+	z.total_left= (size_t) h * (1 + (size_t) w * 4);
+	z.s1= 1; z.s2= 0;
+	for (y= 0; y < h; y++) {
+		frame_png_put(&z, &filter_none, 1);
+		frame_png_put(&z, frame_row(fw, frame, y), (size_t) w * 4);
+	}
+	p= frame_put_be32(z.p, (z.s2 << 16) | z.s1);
+	p= frame_put_be32(p, frame_crc(0, idat, p - idat));
+	memcpy(p, iend, 12);
+	return p + 12 - start;
+}
+
+static size_t frame_encode_y4m(struct frame_writer *fw, const unsigned char *frame) {
+	int w= fw->opts.width, h= fw->opts.height, cw= (w + 1) / 2, y;
+	unsigned char *p= fw->scratch, *u, *v;
+	memcpy(p, "FRAME\n", 6);
+	p += 6;
+	u= p + (size_t) w * h;
+	v= u + (size_t) cw * ((h + 1) / 2);
+	for (y= 0; y < h; y++)
+		frame_rgba_to_y(frame_row(fw, frame, y), p + (size_t) y * w, w);
+	for (y= 0; y < h; y += 2)
+		frame_rgba_to_uv(frame_row(fw, frame, y), frame_row(fw, frame, y + 1 < h? y + 1 : y),
+			u + (size_t)(y/2) * cw, v + (size_t)(y/2) * cw, w);
+	return 6 + (size_t) w * h + 2 * (size_t) cw * ((h + 1) / 2);
+}
+
+static size_t frame_encode_raw(struct frame_writer *fw, const unsigned char *frame) {
+	size_t row= (size_t) fw->opts.width * 4;
+	int y;
+	for (y= 0; y < fw->opts.height; y++)
+		memcpy(fw->scratch + y * row, frame_row(fw, frame, y), row);
+	return fw->frame_size;
+}
+
+/* The worker thread */
+
+/* Record why a write failed, before errno changes */
+static void frame_writer_fail(struct frame_writer *fw, const char *what) {
+	fw->err_what= what;
+	fw->err_code= FW_ERRNO;
+}
+
+/* Put the file name of the next PNG into fw->path, without using stdio */
+static void frame_png_name(struct frame_writer *fw) {
+	char digits[24], *p= fw->path + strlen(fw->prefix);
+	unsigned long long n= fw->seq;
+	int len= 0;
+	do digits[len++]= '0' + (char)(n % 10); while (n /= 10);
+	while (len < fw->digits) digits[len++]= '0';
+	while (len) *p++= digits[--len];
+	strcpy(p, fw->suffix);
+}
+
+static int frame_writer_write(struct frame_writer *fw, const unsigned char *frame) {
+	switch (fw->opts.format) {
+	case FRAME_RAW:
+		if (fw->opts.flip? frame_file_write(fw, fw->scratch, frame_encode_raw(fw, frame))
+			: frame_file_write(fw, frame, fw->frame_size))
+			return 1;
+		break;
+	case FRAME_Y4M:
+		if (frame_file_write(fw, fw->scratch, frame_encode_y4m(fw, frame)))
+			return 1;
+		break;
+	case FRAME_PNG:
+		frame_png_name(fw);
+		if (!frame_file_open(fw, fw->path)) {
+			frame_writer_fail(fw, "create");
+			return 0;
+		}
+		if (!frame_file_write(fw, fw->scratch, frame_encode_png(fw, frame))) {
+			frame_writer_fail(fw, "write");
+			frame_file_close(fw);
+			return 0;
+		}
+		if (frame_file_close(fw))
+			return 1;
+		frame_writer_fail(fw, "close");
+		return 0;
+	}
+	frame_writer_fail(fw, "write");
+	return 0;
+}
+
+static void frame_writer_run(struct frame_writer *fw) {
+	int ok;
+	FW_LOCK(fw);
+	for (;;) {
+		while (!fw->count && !fw->stop)
+			FW_WAIT(fw, more);
+		if (!fw->count) break;
+		FW_UNLOCK(fw);
+		/* after a failure, frames are discarded so that the caller doesn't block */
+		ok= !fw->failed && frame_writer_write(fw, fw->queue[fw->head]);
+		FW_LOCK(fw);
+		if (ok) fw->written++;
+		else fw->failed= 1;
+		fw->seq++;
+		fw->head= (fw->head + 1) % fw->opts.queue_len;
+		fw->count--;
+		FW_SIGNAL(fw, space);
+	}
+	FW_UNLOCK(fw);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI frame_writer_thread(LPVOID fw) { frame_writer_run((struct frame_writer*) fw); return 0; }
+#else
+static void* frame_writer_thread(void *fw) { frame_writer_run((struct frame_writer*) fw); return NULL; }
+#endif
+
+/* Public functions, for the caller's thread */
+
+static void frame_writer_free_buffers(struct frame_writer *fw) {
+	int i;
+	for (i= 0; i < FRAME_MAX_QUEUE; i++) {
+		free(fw->queue[i]);
+		fw->queue[i]= NULL;
+	}
+	free(fw->scratch);
+	fw->scratch= NULL;
+}
+
+/* Split a PNG file name pattern around its one "%d" or "%0Nd" */
+static int frame_writer_parse_pattern(struct frame_writer *fw, const char *path) {
+	const char *pct= strchr(path, '%'), *p;
+	if (!pct) return 0;
+	p= pct + 1;
+	if (*p == '0') p++;
+	fw->digits= 0;
+	while (*p >= '0' && *p <= '9') fw->digits= fw->digits * 10 + (*p++ - '0');
+	if (*p != 'd' || fw->digits > 20 || strchr(p, '%')) return 0;
+	if ((size_t)(pct - path) >= sizeof(fw->prefix) || strlen(p + 1) >= sizeof(fw->suffix)) return 0;
+	memcpy(fw->prefix, path, pct - path);
+	fw->prefix[pct - path]= '\0';
+	strcpy(fw->suffix, p + 1);
+	strcpy(fw->path, fw->prefix);
+	return 1;
+}
+
+/* Start a writer.  'fw' must be zeroed.  For PNG, 'path' is a pattern like "frame-%05d.png". */
+static int frame_writer_open(struct frame_writer *fw, const char *path, const struct frame_writer_opts *opts) {
+	char header[128];
+	int i, w= opts->width, h= opts->height;
+	if (w <= 0 || h <= 0 || w > FRAME_MAX_DIM || h > FRAME_MAX_DIM) {
+		snprintf(frame_writer_error, sizeof(frame_writer_error), "Invalid frame size %dx%d", w, h);
+		return 0;
+	}
+	if (opts->queue_len < 1 || opts->queue_len > FRAME_MAX_QUEUE) {
+		snprintf(frame_writer_error, sizeof(frame_writer_error), "Queue length must be 1..%d", FRAME_MAX_QUEUE);
+		return 0;
+	}
+	fw->opts= *opts;
+	fw->frame_size= (size_t) w * h * 4;
+	switch (opts->format) {
+	case FRAME_RAW: fw->scratch_size= opts->flip? fw->frame_size : 0; break;
+	case FRAME_Y4M: fw->scratch_size= 6 + (size_t) w * h + 2 * (size_t)((w + 1) / 2) * ((h + 1) / 2); break;
+	case FRAME_PNG: fw->scratch_size= 8 + 25 + 12 + frame_png_zlib_size(w, h) + 12; break;
+	default:
+		snprintf(frame_writer_error, sizeof(frame_writer_error), "Unknown frame format %d", opts->format);
+		return 0;
+	}
+	if (opts->format == FRAME_PNG && !frame_writer_parse_pattern(fw, path)) {
+		snprintf(frame_writer_error, sizeof(frame_writer_error),
+			"PNG file name must contain one %%d (or %%0Nd) for the frame number: '%s'", path);
+		return 0;
+	}
+	for (i= 0; i < opts->queue_len; i++)
+		if (!(fw->queue[i]= (unsigned char*) malloc(fw->frame_size))) break;
+	if (i < opts->queue_len || (fw->scratch_size && !(fw->scratch= (unsigned char*) malloc(fw->scratch_size)))) {
+		frame_writer_free_buffers(fw);
+		snprintf(frame_writer_error, sizeof(frame_writer_error), "Can't allocate %d frames of %dx%d", opts->queue_len, w, h);
+		return 0;
+	}
+	frame_crc_init();
+
+	if (opts->format != FRAME_PNG) {
+		if (!frame_file_open(fw, path)) {
+			snprintf(frame_writer_error, sizeof(frame_writer_error), "Can't create '%s': %s", path, strerror(FW_ERRNO));
+			frame_writer_free_buffers(fw);
+			return 0;
+		}
+		if (opts->format == FRAME_Y4M) {
+			snprintf(header, sizeof(header), "YUV4MPEG2 W%d H%d F%d:%d Ip A1:1 C420jpeg\n",
+				w, h, opts->fps_num, opts->fps_den);
+			if (!frame_file_write(fw, header, strlen(header))) {
+				snprintf(frame_writer_error, sizeof(frame_writer_error), "Can't write '%s': %s", path, strerror(FW_ERRNO));
+				frame_file_close(fw);
+				frame_writer_free_buffers(fw);
+				return 0;
+			}
+		}
+	}
+
+#ifdef _WIN32
+	InitializeCriticalSection(&fw->lock);
+	InitializeConditionVariable(&fw->more);
+	InitializeConditionVariable(&fw->space);
+	fw->running= (fw->thread= CreateThread(NULL, 0, frame_writer_thread, fw, 0, NULL)) != NULL;
+#else
+	pthread_mutex_init(&fw->lock, NULL);
+	pthread_cond_init(&fw->more, NULL);
+	pthread_cond_init(&fw->space, NULL);
+	fw->running= pthread_create(&fw->thread, NULL, frame_writer_thread, fw) == 0;
+#endif
+	if (!fw->running) {
+		snprintf(frame_writer_error, sizeof(frame_writer_error), "Can't start writer thread");
+		if (opts->format != FRAME_PNG) frame_file_close(fw);
+		frame_writer_free_buffers(fw);
+		return 0;
+	}
+	return 1;
+}
+
+/* Queue a copy of one frame of width*height*4 bytes.  Returns 1 if it was queued, 0 if it was
+ * dropped because the queue is full, or -1 if the writer has failed.
+ */
+static int frame_writer_push(struct frame_writer *fw, const void *rgba) {
+	int slot;
+	FW_LOCK(fw);
+	while (!fw->failed && fw->count == fw->opts.queue_len) {
+		if (!fw->opts.block) {
+			fw->dropped++;
+			FW_UNLOCK(fw);
+			return 0;
+		}
+		FW_WAIT(fw, space);
+	}
+	if (fw->failed) {
+		FW_UNLOCK(fw);
+		return -1;
+	}
+	/* The worker never looks past head+count, so the slot can be filled without the lock */
+	slot= (fw->head + fw->count) % fw->opts.queue_len;
+	FW_UNLOCK(fw);
+	memcpy(fw->queue[slot], rgba, fw->frame_size);
+	FW_LOCK(fw);
+	fw->count++;
+	FW_SIGNAL(fw, more);
+	FW_UNLOCK(fw);
+	return 1;
+}
+
+/* Describe the worker's failure into frame_writer_error */
+static void frame_writer_describe_error(struct frame_writer *fw) {
+	snprintf(frame_writer_error, sizeof(frame_writer_error), "Frame writer can't %s '%s': %s",
+		fw->err_what, fw->opts.format == FRAME_PNG? fw->path : "output file",
+#ifdef _WIN32
+		"Windows error"
+#else
+		strerror(fw->err_code)
+#endif
+	);
+}
+
+/* Wait for the queue to be written, and stop the worker.  Returns 0 if any write failed. */
+static int frame_writer_close(struct frame_writer *fw) {
+	if (!fw->running) {
+		if (fw->failed) frame_writer_describe_error(fw);
+		return !fw->failed;
+	}
+	FW_LOCK(fw);
+	fw->stop= 1;
+	FW_SIGNAL(fw, more);
+	FW_UNLOCK(fw);
+#ifdef _WIN32
+	WaitForSingleObject(fw->thread, INFINITE);
+	CloseHandle(fw->thread);
+	DeleteCriticalSection(&fw->lock);
+#else
+	pthread_join(fw->thread, NULL);
+	pthread_mutex_destroy(&fw->lock);
+	pthread_cond_destroy(&fw->more);
+	pthread_cond_destroy(&fw->space);
+#endif
+	fw->running= 0;
+	if (fw->opts.format != FRAME_PNG && !frame_file_close(fw) && !fw->failed) {
+		frame_writer_fail(fw, "close");
+		fw->failed= 1;
+	}
+	frame_writer_free_buffers(fw);
+	if (fw->failed) frame_writer_describe_error(fw);
+	return !fw->failed;
+}
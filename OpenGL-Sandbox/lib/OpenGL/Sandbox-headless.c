@@ -0,0 +1,340 @@
+/* GL contexts without a display, for ContextShim::EGL and ContextShim::OSMesa.
+ * libEGL and libOSMesa are loaded with dlopen when first needed, so that neither is a build
+ * dependency, and the few EGL and OSMesa definitions used here are declared locally so that
+ * their headers aren't needed either.
+ * Functions return 0 on failure and write a message into headless_error.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEADLESS_EGL    1
+#define HEADLESS_OSMESA 2
+
+struct headless_context {
+	int api;
+	void *display, *context, *surface, *pixels;
+	int width, height;
+	char info[256];
+};
+
+struct headless_opts {
+	int width, height, major, minor;
+	int profile;  /* 0 = any, 1 = core, 2 = compatibility */
+	int debug;
+	const char *platform; /* EGL: "surfaceless", "device", "default", or NULL to try each */
+};
+
+static char headless_error[256];
+
+#ifndef _WIN32
+#include <dlfcn.h>
+
+typedef int EGLint;
+typedef unsigned int EGLBoolean, EGLenum;
+typedef void *EGLDisplay, *EGLConfig, *EGLContext, *EGLSurface, *EGLDeviceEXT;
+#define EGL_NONE                        0x3038
+#define EGL_ALPHA_SIZE                  0x3021
+#define EGL_BLUE_SIZE                   0x3022
+#define EGL_GREEN_SIZE                  0x3023
+#define EGL_RED_SIZE                    0x3024
+#define EGL_DEPTH_SIZE                  0x3025
+#define EGL_STENCIL_SIZE                0x3026
+#define EGL_SURFACE_TYPE                0x3033
+#define EGL_RENDERABLE_TYPE             0x3040
+#define EGL_PBUFFER_BIT                 0x0001
+#define EGL_OPENGL_BIT                  0x0008
+#define EGL_VENDOR                      0x3053
+#define EGL_VERSION                     0x3054
+#define EGL_EXTENSIONS                  0x3055
+#define EGL_HEIGHT                      0x3056
+#define EGL_WIDTH                       0x3057
+#define EGL_OPENGL_API                  0x30A2
+#define EGL_CONTEXT_MAJOR_VERSION       0x3098
+#define EGL_CONTEXT_MINOR_VERSION       0x30FB
+#define EGL_CONTEXT_OPENGL_PROFILE_MASK 0x30FD
+#define EGL_CONTEXT_OPENGL_DEBUG        0x31B0
+#define EGL_PLATFORM_DEVICE_EXT         0x313F
+#define EGL_PLATFORM_SURFACELESS_MESA   0x31DD
+
+static struct {
+	void *lib;
+	void*       (*GetProcAddress)(const char *name);
+	EGLint      (*GetError)(void);
+	EGLDisplay  (*GetDisplay)(void *native);
+	EGLBoolean  (*Initialize)(EGLDisplay dpy, EGLint *major, EGLint *minor);
+	EGLBoolean  (*Terminate)(EGLDisplay dpy);
+	const char* (*QueryString)(EGLDisplay dpy, EGLint name);
+	EGLBoolean  (*BindAPI)(EGLenum api);
+	EGLBoolean  (*ChooseConfig)(EGLDisplay dpy, const EGLint *attr, EGLConfig *configs, EGLint size, EGLint *n);
+	EGLContext  (*CreateContext)(EGLDisplay dpy, EGLConfig config, EGLContext share, const EGLint *attr);
+	EGLBoolean  (*DestroyContext)(EGLDisplay dpy, EGLContext cx);
+	EGLSurface  (*CreatePbufferSurface)(EGLDisplay dpy, EGLConfig config, const EGLint *attr);
+	EGLBoolean  (*DestroySurface)(EGLDisplay dpy, EGLSurface surface);
+	EGLBoolean  (*MakeCurrent)(EGLDisplay dpy, EGLSurface draw, EGLSurface read, EGLContext cx);
+	EGLDisplay  (*GetPlatformDisplayEXT)(EGLenum platform, void *native, const EGLint *attr);
+	EGLBoolean  (*QueryDevicesEXT)(EGLint max, EGLDeviceEXT *devices, EGLint *n);
+} headless_egl;
+
+static int headless_egl_load(void) {
+	static const char *names[]= { "libEGL.so.1", "libEGL.so" };
+	int i;
+	if (headless_egl.lib) return 1;
+	for (i= 0; i < 2 && !headless_egl.lib; i++)
+		headless_egl.lib= dlopen(names[i], RTLD_NOW | RTLD_GLOBAL);
+	if (!headless_egl.lib) {
+		snprintf(headless_error, sizeof(headless_error), "Can't load libEGL: %s", dlerror());
+		return 0;
+	}
+#define HEADLESS_EGL_SYM(name) \
+	if (!(*(void**)&headless_egl.name= dlsym(headless_egl.lib, "egl" #name))) { \
+		snprintf(headless_error, sizeof(headless_error), "libEGL has no egl%s", #name); \
+		dlclose(headless_egl.lib); \
+		headless_egl.lib= NULL; \
+		return 0; \
+	}
+	HEADLESS_EGL_SYM(GetProcAddress)
+	HEADLESS_EGL_SYM(GetError)
+	HEADLESS_EGL_SYM(GetDisplay)
+	HEADLESS_EGL_SYM(Initialize)
+	HEADLESS_EGL_SYM(Terminate)
+	HEADLESS_EGL_SYM(QueryString)
+	HEADLESS_EGL_SYM(BindAPI)
+	HEADLESS_EGL_SYM(ChooseConfig)
+	HEADLESS_EGL_SYM(CreateContext)
+	HEADLESS_EGL_SYM(DestroyContext)
+	HEADLESS_EGL_SYM(CreatePbufferSurface)
+	HEADLESS_EGL_SYM(DestroySurface)
+	HEADLESS_EGL_SYM(MakeCurrent)
+#undef HEADLESS_EGL_SYM
+	/* extensions; either may be NULL */
+	*(void**)&headless_egl.GetPlatformDisplayEXT= headless_egl.GetProcAddress("eglGetPlatformDisplayEXT");
+	*(void**)&headless_egl.QueryDevicesEXT= headless_egl.GetProcAddress("eglQueryDevicesEXT");
+	return 1;
+}
+
+static int headless_has_word(const char *list, const char *word) {
+	size_t len= strlen(word);
+	const char *p;
+	for (; list && (p= strstr(list, word)); list= p + len)
+		if ((p == list || p[-1] == ' ') && (p[len] == ' ' || p[len] == '\0'))
+			return 1;
+	return 0;
+}
+
+/* Open an EGL display that doesn't need a window system */
+static EGLDisplay headless_egl_display(const char *platform, const char **used) {
+	const char *ext= headless_egl.QueryString(NULL, EGL_EXTENSIONS);
+	EGLDisplay dpy= NULL;
+	EGLDeviceEXT device;
+	EGLint n= 0, major, minor;
+	if ((!platform || !strcmp(platform, "surfaceless"))
+		&& headless_egl.GetPlatformDisplayEXT && headless_has_word(ext, "EGL_MESA_platform_surfaceless")
+		&& (dpy= headless_egl.GetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA, NULL, NULL))
+	) {
+		if (headless_egl.Initialize(dpy, &major, &minor)) { *used= "surfaceless"; return dpy; }
+	}
+	if ((!platform || !strcmp(platform, "device"))
+		&& headless_egl.GetPlatformDisplayEXT && headless_egl.QueryDevicesEXT
+		&& headless_has_word(ext, "EGL_EXT_platform_device")
+		&& headless_egl.QueryDevicesEXT(1, &device, &n) && n > 0
+		&& (dpy= headless_egl.GetPlatformDisplayEXT(EGL_PLATFORM_DEVICE_EXT, device, NULL))
+	) {
+		if (headless_egl.Initialize(dpy, &major, &minor)) { *used= "device"; return dpy; }
+	}
+	if ((!platform || !strcmp(platform, "default"))
+		&& (dpy= headless_egl.GetDisplay(NULL))
+	) {
+		if (headless_egl.Initialize(dpy, &major, &minor)) { *used= "default"; return dpy; }
+	}
+	snprintf(headless_error, sizeof(headless_error), "No usable EGL display for platform '%s'",
+		platform? platform : "any");
+	return NULL;
+}
+
+static int headless_egl_create(struct headless_context *hc, struct headless_opts *opts) {
+	EGLint config_attr[]= {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+		EGL_DEPTH_SIZE, 24, EGL_STENCIL_SIZE, 8, EGL_NONE
+	};
+	EGLint surface_attr[]= { EGL_WIDTH, opts->width, EGL_HEIGHT, opts->height, EGL_NONE };
+	EGLint context_attr[16], i= 0, n= 0;
+	EGLConfig config= NULL;
+	const char *platform= NULL;
+
+	if (!headless_egl_load()) return 0;
+	if (!(hc->display= headless_egl_display(opts->platform, &platform)))
+		return 0;
+	if (!headless_egl.BindAPI(EGL_OPENGL_API)) {
+		snprintf(headless_error, sizeof(headless_error), "EGL doesn't support desktop OpenGL");
+		return 0;
+	}
+	if (!headless_egl.ChooseConfig(hc->display, config_attr, &config, 1, &n) || n < 1) {
+		snprintf(headless_error, sizeof(headless_error), "No EGL config with pbuffer support");
+		return 0;
+	}
+	if (opts->major) {
+		context_attr[i++]= EGL_CONTEXT_MAJOR_VERSION; context_attr[i++]= opts->major;
+		context_attr[i++]= EGL_CONTEXT_MINOR_VERSION; context_attr[i++]= opts->minor;
+	}
+	if (opts->profile) {
+		context_attr[i++]= EGL_CONTEXT_OPENGL_PROFILE_MASK; context_attr[i++]= opts->profile;
+	}
+	if (opts->debug) {
+		context_attr[i++]= EGL_CONTEXT_OPENGL_DEBUG; context_attr[i++]= 1;
+	}
+	context_attr[i]= EGL_NONE;
+	if (!(hc->context= headless_egl.CreateContext(hc->display, config, NULL, context_attr))) {
+		snprintf(headless_error, sizeof(headless_error), "eglCreateContext failed: 0x%X", headless_egl.GetError());
+		return 0;
+	}
+	if (!(hc->surface= headless_egl.CreatePbufferSurface(hc->display, config, surface_attr))) {
+		snprintf(headless_error, sizeof(headless_error), "eglCreatePbufferSurface failed: 0x%X", headless_egl.GetError());
+		return 0;
+	}
+	if (!headless_egl.MakeCurrent(hc->display, hc->surface, hc->surface, hc->context)) {
+		snprintf(headless_error, sizeof(headless_error), "eglMakeCurrent failed: 0x%X", headless_egl.GetError());
+		return 0;
+	}
+	snprintf(hc->info, sizeof(hc->info), "EGL %s (%s), %s platform, %dx%d pbuffer",
+		headless_egl.QueryString(hc->display, EGL_VERSION),
+		headless_egl.QueryString(hc->display, EGL_VENDOR),
+		platform, opts->width, opts->height);
+	return 1;
+}
+
+#define OSMESA_RGBA                   0x1908
+#define OSMESA_FORMAT                 0x22
+#define OSMESA_DEPTH_BITS             0x30
+#define OSMESA_STENCIL_BITS           0x31
+#define OSMESA_ACCUM_BITS             0x32
+#define OSMESA_PROFILE                0x33
+#define OSMESA_CORE_PROFILE           0x34
+#define OSMESA_COMPAT_PROFILE         0x35
+#define OSMESA_CONTEXT_MAJOR_VERSION  0x36
+#define OSMESA_CONTEXT_MINOR_VERSION  0x37
+
+static struct {
+	void *lib;
+	void* (*CreateContextAttribs)(const int *attr, void *share);
+	void  (*DestroyContext)(void *cx);
+	unsigned char (*MakeCurrent)(void *cx, void *buffer, unsigned int type, int width, int height);
+	void* (*GetProcAddress)(const char *name);
+} headless_osmesa;
+
+static void* headless_osmesa_proc(const char *name) {
+	return headless_osmesa.GetProcAddress(name);
+}
+
+static int headless_osmesa_create(struct headless_context *hc, struct headless_opts *opts) {
+	static const char *names[]= { "libOSMesa.so.8", "libOSMesa.so.6", "libOSMesa.so" };
+	int attr[16], i;
+	if (!headless_osmesa.lib) {
+		for (i= 0; i < 3 && !headless_osmesa.lib; i++)
+			headless_osmesa.lib= dlopen(names[i], RTLD_NOW | RTLD_GLOBAL);
+		if (!headless_osmesa.lib) {
+			snprintf(headless_error, sizeof(headless_error), "Can't load libOSMesa: %s", dlerror());
+			return 0;
+		}
+		*(void**)&headless_osmesa.CreateContextAttribs= dlsym(headless_osmesa.lib, "OSMesaCreateContextAttribs");
+		*(void**)&headless_osmesa.DestroyContext= dlsym(headless_osmesa.lib, "OSMesaDestroyContext");
+		*(void**)&headless_osmesa.MakeCurrent= dlsym(headless_osmesa.lib, "OSMesaMakeCurrent");
+		*(void**)&headless_osmesa.GetProcAddress= dlsym(headless_osmesa.lib, "OSMesaGetProcAddress");
+		if (!headless_osmesa.CreateContextAttribs || !headless_osmesa.DestroyContext
+			|| !headless_osmesa.MakeCurrent || !headless_osmesa.GetProcAddress
+		) {
+			snprintf(headless_error, sizeof(headless_error), "libOSMesa is missing OSMesaCreateContextAttribs");
+			dlclose(headless_osmesa.lib);
+			headless_osmesa.lib= NULL;
+			return 0;
+		}
+	}
+	i= 0;
+	attr[i++]= OSMESA_FORMAT;       attr[i++]= OSMESA_RGBA;
+	attr[i++]= OSMESA_DEPTH_BITS;   attr[i++]= 24;
+	attr[i++]= OSMESA_STENCIL_BITS; attr[i++]= 8;
+	if (opts->profile) {
+		attr[i++]= OSMESA_PROFILE;
+		attr[i++]= opts->profile == 1? OSMESA_CORE_PROFILE : OSMESA_COMPAT_PROFILE;
+	}
+	if (opts->major) {
+		attr[i++]= OSMESA_CONTEXT_MAJOR_VERSION; attr[i++]= opts->major;
+		attr[i++]= OSMESA_CONTEXT_MINOR_VERSION; attr[i++]= opts->minor;
+	}
+	attr[i]= 0;
+	if (!(hc->context= headless_osmesa.CreateContextAttribs(attr, NULL))) {
+		snprintf(headless_error, sizeof(headless_error), "OSMesaCreateContextAttribs failed");
+		return 0;
+	}
+	if (!(hc->pixels= malloc((size_t) opts->width * opts->height * 4))) {
+		snprintf(headless_error, sizeof(headless_error), "Can't allocate %dx%d framebuffer", opts->width, opts->height);
+		return 0;
+	}
+	if (!headless_osmesa.MakeCurrent(hc->context, hc->pixels, GL_UNSIGNED_BYTE, opts->width, opts->height)) {
+		snprintf(headless_error, sizeof(headless_error), "OSMesaMakeCurrent failed");
+		return 0;
+	}
+	snprintf(hc->info, sizeof(hc->info), "OSMesa, %dx%d buffer", opts->width, opts->height);
+	return 1;
+}
+#endif /* _WIN32 */
+
+/* The glducktape loader is process-wide, so it follows whichever context was made current last */
+static struct headless_context *headless_current= NULL;
+
+static void headless_set_current(struct headless_context *hc) {
+	headless_current= hc;
+#ifndef _WIN32
+	/* OSMesa functions must come from OSMesa rather than libGL, which doesn't know about the context */
+	glducktape_set_loader(hc && hc->api == HEADLESS_OSMESA? headless_osmesa_proc : NULL);
+#endif
+}
+
+static void headless_destroy(struct headless_context *hc) {
+	int current= hc == headless_current;
+#ifndef _WIN32
+	if (hc->api == HEADLESS_EGL && hc->display) {
+		if (current) headless_egl.MakeCurrent(hc->display, NULL, NULL, NULL);
+		if (hc->surface) headless_egl.DestroySurface(hc->display, hc->surface);
+		if (hc->context) headless_egl.DestroyContext(hc->display, hc->context);
+		/* The display is shared by every context on it, so it is left initialized */
+	}
+	else if (hc->api == HEADLESS_OSMESA) {
+		if (hc->context) headless_osmesa.DestroyContext(hc->context);
+	}
+#endif
+	if (current) headless_set_current(NULL);
+	free(hc->pixels);
+	memset(hc, 0, sizeof(*hc));
+}
+
+static int headless_create(struct headless_context *hc, int api, struct headless_opts *opts) {
+	int ok= 0;
+	memset(hc, 0, sizeof(*hc));
+	hc->api= api;
+	hc->width= opts->width;
+	hc->height= opts->height;
+#ifndef _WIN32
+	ok= api == HEADLESS_EGL? headless_egl_create(hc, opts)
+		: api == HEADLESS_OSMESA? headless_osmesa_create(hc, opts)
+		: 0;
+#else
+	snprintf(headless_error, sizeof(headless_error), "Headless contexts are not supported on Windows");
+#endif
+	if (ok) headless_set_current(hc);
+	else headless_destroy(hc);
+	return ok;
+}
+
+static int headless_make_current(struct headless_context *hc) {
+	int ok= 0;
+#ifndef _WIN32
+	if (hc->api == HEADLESS_EGL)
+		ok= headless_egl.MakeCurrent(hc->display, hc->surface, hc->surface, hc->context);
+	else if (hc->api == HEADLESS_OSMESA)
+		ok= headless_osmesa.MakeCurrent(hc->context, hc->pixels, GL_UNSIGNED_BYTE, hc->width, hc->height);
+#endif
+	if (ok) headless_set_current(hc);
+	return ok;
+}
@@ -0,0 +1,269 @@
+/* 4x4 matrix math for shader pipelines.
+ * Matrices are 16 floats in column-major order, the same as OpenGL, so they can be handed
+ * directly to glUniformMatrix4fv or copied into a uniform buffer.  Pointers do not need to be
+ * aligned, since they usually point into the buffer of a perl scalar.
+ * This file only uses plain C, so that it can be compiled apart from perl.
+ */
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE__) && !defined(MAT4_NO_SIMD)
+#include <xmmintrin.h>
+#define MAT4_SSE 1
+#elif defined(__ARM_NEON) && !defined(MAT4_NO_SIMD)
+#include <arm_neon.h>
+#define MAT4_NEON 1
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const float mat4_identity_data[16]= {
+	1, 0, 0, 0,
+	0, 1, 0, 0,
+	0, 0, 1, 0,
+	0, 0, 0, 1
+};
+
+static void mat4_identity(float *m) {
+	memcpy(m, mat4_identity_data, sizeof(mat4_identity_data));
+}
+
+/* dst = a * b.  dst may be the same as a or b. */
+static void mat4_mul(float *dst, const float *a, const float *b) {
+	int j;
+#if MAT4_SSE
+	__m128 a0= _mm_loadu_ps(a), a1= _mm_loadu_ps(a+4), a2= _mm_loadu_ps(a+8), a3= _mm_loadu_ps(a+12);
+	__m128 col[4];
+	for (j= 0; j < 4; j++)
+		col[j]= _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(b[j*4+0])), _mm_mul_ps(a1, _mm_set1_ps(b[j*4+1]))),
+			_mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(b[j*4+2])), _mm_mul_ps(a3, _mm_set1_ps(b[j*4+3])))
+		);
+	for (j= 0; j < 4; j++)
+		_mm_storeu_ps(dst + j*4, col[j]);
+#elif MAT4_NEON
+	float32x4_t a0= vld1q_f32(a), a1= vld1q_f32(a+4), a2= vld1q_f32(a+8), a3= vld1q_f32(a+12);
+	float32x4_t col[4];
+	for (j= 0; j < 4; j++) {
+		col[j]= vmulq_n_f32(a0, b[j*4+0]);
+		col[j]= vmlaq_n_f32(col[j], a1, b[j*4+1]);
+		col[j]= vmlaq_n_f32(col[j], a2, b[j*4+2]);
+		col[j]= vmlaq_n_f32(col[j], a3, b[j*4+3]);
+	}
+	for (j= 0; j < 4; j++)
+		vst1q_f32(dst + j*4, col[j]);
+#else
+	float tmp[16];
+	int i;
+	for (j= 0; j < 4; j++)
+		for (i= 0; i < 4; i++)
+			tmp[j*4+i]= a[i]*b[j*4] + a[4+i]*b[j*4+1] + a[8+i]*b[j*4+2] + a[12+i]*b[j*4+3];
+	memcpy(dst, tmp, sizeof(tmp));
+#endif
+}
+
+/* m = m * translation(x,y,z), like glTranslate */
+static void mat4_translate(float *m, float x, float y, float z) {
+#if MAT4_SSE
+	__m128 c3= _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(x)), _mm_mul_ps(_mm_loadu_ps(m+4), _mm_set1_ps(y))),
+		_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m+8), _mm_set1_ps(z)), _mm_loadu_ps(m+12))
+	);
+	_mm_storeu_ps(m+12, c3);
+#elif MAT4_NEON
+	float32x4_t c3= vld1q_f32(m+12);
+	c3= vmlaq_n_f32(c3, vld1q_f32(m), x);
+	c3= vmlaq_n_f32(c3, vld1q_f32(m+4), y);
+	c3= vmlaq_n_f32(c3, vld1q_f32(m+8), z);
+	vst1q_f32(m+12, c3);
+#else
+	int i;
+	for (i= 0; i < 4; i++)
+		m[12+i] += m[i]*x + m[4+i]*y + m[8+i]*z;
+#endif
+}
+
+/* m = m * scale(x,y,z), like glScale */
+static void mat4_scale(float *m, float x, float y, float z) {
+#if MAT4_SSE
+	_mm_storeu_ps(m,   _mm_mul_ps(_mm_loadu_ps(m),   _mm_set1_ps(x)));
+	_mm_storeu_ps(m+4, _mm_mul_ps(_mm_loadu_ps(m+4), _mm_set1_ps(y)));
+	_mm_storeu_ps(m+8, _mm_mul_ps(_mm_loadu_ps(m+8), _mm_set1_ps(z)));
+#elif MAT4_NEON
+	vst1q_f32(m,   vmulq_n_f32(vld1q_f32(m),   x));
+	vst1q_f32(m+4, vmulq_n_f32(vld1q_f32(m+4), y));
+	vst1q_f32(m+8, vmulq_n_f32(vld1q_f32(m+8), z));
+#else
+	int i;
+	for (i= 0; i < 4; i++) {
+		m[i] *= x;
+		m[4+i] *= y;
+		m[8+i] *= z;
+	}
+#endif
+}
+
+/* m = m * rotation(degrees around x,y,z), like glRotate */
+static void mat4_rotate(float *m, double degrees, double x, double y, double z) {
+	float r[16];
+	double len= sqrt(x*x + y*y + z*z), rad= degrees * M_PI / 180, c, s, t;
+	if (len == 0) return;
+	x /= len; y /= len; z /= len;
+	c= cos(rad); s= sin(rad); t= 1 - c;
+	r[0]= x*x*t + c;   r[4]= x*y*t - z*s; r[8]=  x*z*t + y*s; r[12]= 0;
+	r[1]= y*x*t + z*s; r[5]= y*y*t + c;   r[9]=  y*z*t - x*s; r[13]= 0;
+	r[2]= x*z*t - y*s; r[6]= y*z*t + x*s; r[10]= z*z*t + c;   r[14]= 0;
+	r[3]= 0;           r[7]= 0;           r[11]= 0;           r[15]= 1;
+	mat4_mul(m, m, r);
+}
+
+static void mat4_transpose(float *m) {
+	float tmp;
+	int i, j;
+	for (j= 0; j < 4; j++)
+		for (i= j+1; i < 4; i++) {
+			tmp= m[j*4+i];
+			m[j*4+i]= m[i*4+j];
+			m[i*4+j]= tmp;
+		}
+}
+
+/* dst = inverse(src).  Returns false (and leaves dst alone) if the matrix is singular. */
+static int mat4_invert(float *dst, const float *m) {
+	double inv[16], det;
+	int i;
+	inv[0]=   m[5]*m[10]*m[15] - m[5]*m[11]*m[14] - m[9]*m[6]*m[15] + m[9]*m[7]*m[14] + m[13]*m[6]*m[11] - m[13]*m[7]*m[10];
+	inv[4]=  -m[4]*m[10]*m[15] + m[4]*m[11]*m[14] + m[8]*m[6]*m[15] - m[8]*m[7]*m[14] - m[12]*m[6]*m[11] + m[12]*m[7]*m[10];
+	inv[8]=   m[4]*m[9]*m[15]  - m[4]*m[11]*m[13] - m[8]*m[5]*m[15] + m[8]*m[7]*m[13] + m[12]*m[5]*m[11] - m[12]*m[7]*m[9];
+	inv[12]= -m[4]*m[9]*m[14]  + m[4]*m[10]*m[13] + m[8]*m[5]*m[14] - m[8]*m[6]*m[13] - m[12]*m[5]*m[10] + m[12]*m[6]*m[9];
+	inv[1]=  -m[1]*m[10]*m[15] + m[1]*m[11]*m[14] + m[9]*m[2]*m[15] - m[9]*m[3]*m[14] - m[13]*m[2]*m[11] + m[13]*m[3]*m[10];
+	inv[5]=   m[0]*m[10]*m[15] - m[0]*m[11]*m[14] - m[8]*m[2]*m[15] + m[8]*m[3]*m[14] + m[12]*m[2]*m[11] - m[12]*m[3]*m[10];
+	inv[9]=  -m[0]*m[9]*m[15]  + m[0]*m[11]*m[13] + m[8]*m[1]*m[15] - m[8]*m[3]*m[13] - m[12]*m[1]*m[11] + m[12]*m[3]*m[9];
+	inv[13]=  m[0]*m[9]*m[14]  - m[0]*m[10]*m[13] - m[8]*m[1]*m[14] + m[8]*m[2]*m[13] + m[12]*m[1]*m[10] - m[12]*m[2]*m[9];
+	inv[2]=   m[1]*m[6]*m[15]  - m[1]*m[7]*m[14]  - m[5]*m[2]*m[15] + m[5]*m[3]*m[14] + m[13]*m[2]*m[7]  - m[13]*m[3]*m[6];
+	inv[6]=  -m[0]*m[6]*m[15]  + m[0]*m[7]*m[14]  + m[4]*m[2]*m[15] - m[4]*m[3]*m[14] - m[12]*m[2]*m[7]  + m[12]*m[3]*m[6];
+	inv[10]=  m[0]*m[5]*m[15]  - m[0]*m[7]*m[13]  - m[4]*m[1]*m[15] + m[4]*m[3]*m[13] + m[12]*m[1]*m[7]  - m[12]*m[3]*m[5];
+	inv[14]= -m[0]*m[5]*m[14]  + m[0]*m[6]*m[13]  + m[4]*m[1]*m[14] - m[4]*m[2]*m[13] - m[12]*m[1]*m[6]  + m[12]*m[2]*m[5];
+	inv[3]=  -m[1]*m[6]*m[11]  + m[1]*m[7]*m[10]  + m[5]*m[2]*m[11] - m[5]*m[3]*m[10] - m[9]*m[2]*m[7]   + m[9]*m[3]*m[6];
+	inv[7]=   m[0]*m[6]*m[11]  - m[0]*m[7]*m[10]  - m[4]*m[2]*m[11] + m[4]*m[3]*m[10] + m[8]*m[2]*m[7]   - m[8]*m[3]*m[6];
+	inv[11]= -m[0]*m[5]*m[11]  + m[0]*m[7]*m[9]   + m[4]*m[1]*m[11] - m[4]*m[3]*m[9]  - m[8]*m[1]*m[7]   + m[8]*m[3]*m[5];
+	inv[15]=  m[0]*m[5]*m[10]  - m[0]*m[6]*m[9]   - m[4]*m[1]*m[10] + m[4]*m[2]*m[9]  + m[8]*m[1]*m[6]   - m[8]*m[2]*m[5];
+	det= m[0]*inv[0] + m[1]*inv[4] + m[2]*inv[8] + m[3]*inv[12];
+	if (det == 0) return 0;
+	det= 1.0 / det;
+	for (i= 0; i < 16; i++)
+		dst[i]= inv[i] * det;
+	return 1;
+}
+
+/* m = m * ortho(...), like glOrtho */
+static void mat4_ortho(float *m, double l, double r, double b, double t, double n, double f) {
+	float o[16];
+	memset(o, 0, sizeof(o));
+	o[0]= 2 / (r - l);
+	o[5]= 2 / (t - b);
+	o[10]= -2 / (f - n);
+	o[12]= -(r + l) / (r - l);
+	o[13]= -(t + b) / (t - b);
+	o[14]= -(f + n) / (f - n);
+	o[15]= 1;
+	mat4_mul(m, m, o);
+}
+
+/* m = m * frustum(...), like glFrustum */
+static void mat4_frustum(float *m, double l, double r, double b, double t, double n, double f) {
+	float p[16];
+	memset(p, 0, sizeof(p));
+	p[0]= 2 * n / (r - l);
+	p[5]= 2 * n / (t - b);
+	p[8]= (r + l) / (r - l);
+	p[9]= (t + b) / (t - b);
+	p[10]= -(f + n) / (f - n);
+	p[11]= -1;
+	p[14]= -2 * f * n / (f - n);
+	mat4_mul(m, m, p);
+}
+
+/* m = m * perspective(...), like gluPerspective */
+static void mat4_perspective(float *m, double fovy_degrees, double aspect, double n, double f) {
+	double top= n * tan(fovy_degrees * M_PI / 360);
+	mat4_frustum(m, -top * aspect, top * aspect, -top, top, n, f);
+}
+
+/* m = m * look_at(...), like gluLookAt */
+static void mat4_look_at(float *m, const double *eye, const double *center, const double *up) {
+	double fw[3], s[3], u[3], len;
+	float v[16];
+	int i;
+	for (i= 0; i < 3; i++) fw[i]= center[i] - eye[i];
+	len= sqrt(fw[0]*fw[0] + fw[1]*fw[1] + fw[2]*fw[2]);
+	if (len == 0) return;
+	for (i= 0; i < 3; i++) fw[i] /= len;
+	s[0]= fw[1]*up[2] - fw[2]*up[1];
+	s[1]= fw[2]*up[0] - fw[0]*up[2];
+	s[2]= fw[0]*up[1] - fw[1]*up[0];
+	len= sqrt(s[0]*s[0] + s[1]*s[1] + s[2]*s[2]);
+	if (len == 0) return;
+	for (i= 0; i < 3; i++) s[i] /= len;
+	u[0]= s[1]*fw[2] - s[2]*fw[1];
+	u[1]= s[2]*fw[0] - s[0]*fw[2];
+	u[2]= s[0]*fw[1] - s[1]*fw[0];
+	for (i= 0; i < 3; i++) {
+		v[i*4+0]= s[i];
+		v[i*4+1]= u[i];
+		v[i*4+2]= -fw[i];
+		v[i*4+3]= 0;
+	}
+	v[12]= -(s[0]*eye[0] + s[1]*eye[1] + s[2]*eye[2]);
+	v[13]= -(u[0]*eye[0] + u[1]*eye[1] + u[2]*eye[2]);
+	v[14]=  (fw[0]*eye[0] + fw[1]*eye[1] + fw[2]*eye[2]);
+	v[15]= 1;
+	mat4_mul(m, m, v);
+}
+
+/* Multiply 'count' points by the matrix.  Input points have in_n components (2..4), with
+ * z defaulting to 0 and w to 1.  Output points have out_n components (1..4), taken from
+ * the start of the result vector.  No perspective divide is performed.
+ * src and dst may be the same buffer if out_n <= in_n.
+ */
+static void mat4_transform_points(const float *m, const float *src, int in_n, float *dst, int out_n, size_t count) {
+	size_t i;
+	float res[4];
+#if MAT4_SSE
+	__m128 c0= _mm_loadu_ps(m), c1= _mm_loadu_ps(m+4), c2= _mm_loadu_ps(m+8), c3= _mm_loadu_ps(m+12), v;
+	for (i= 0; i < count; i++, src += in_n, dst += out_n) {
+		v= _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(src[0])), _mm_mul_ps(c1, _mm_set1_ps(src[1])));
+		if (in_n > 2) v= _mm_add_ps(v, _mm_mul_ps(c2, _mm_set1_ps(src[2])));
+		v= _mm_add_ps(v, in_n > 3? _mm_mul_ps(c3, _mm_set1_ps(src[3])) : c3);
+		if (out_n == 4) _mm_storeu_ps(dst, v);
+		else {
+			_mm_storeu_ps(res, v);
+			memcpy(dst, res, out_n * sizeof(float));
+		}
+	}
+#elif MAT4_NEON
+	float32x4_t c0= vld1q_f32(m), c1= vld1q_f32(m+4), c2= vld1q_f32(m+8), c3= vld1q_f32(m+12), v;
+	for (i= 0; i < count; i++, src += in_n, dst += out_n) {
+		v= vmlaq_n_f32(vmulq_n_f32(c0, src[0]), c1, src[1]);
+		if (in_n > 2) v= vmlaq_n_f32(v, c2, src[2]);
+		v= in_n > 3? vmlaq_n_f32(v, c3, src[3]) : vaddq_f32(v, c3);
+		if (out_n == 4) vst1q_f32(dst, v);
+		else {
+			vst1q_f32(res, v);
+			memcpy(dst, res, out_n * sizeof(float));
+		}
+	}
+#else
+	int k;
+	float z, w;
+	for (i= 0; i < count; i++, src += in_n, dst += out_n) {
+		z= in_n > 2? src[2] : 0;
+		w= in_n > 3? src[3] : 1;
+		for (k= 0; k < 4; k++)
+			res[k]= m[k]*src[0] + m[4+k]*src[1] + m[8+k]*z + m[12+k]*w;
+		memcpy(dst, res, out_n * sizeof(float));
+	}
+#endif
+}
@@ -0,0 +1,284 @@
+/* Procedural meshes, for OpenGL::Sandbox::Mesh.  Every shape is a grid of (nu+1) x (nv+1)
+ * vertices, or for the icosphere 20 triangular grids of n+1 rows, so each vertex and each index
+ * can be computed from its number alone.  That lets any range of a large mesh be written on
+ * its own, by the ThreadPool kernels at the end of this file.
+ * Vertices are written as interleaved attributes of any type view_store supports.
+ * This file only uses plain C, so that it can be compiled apart from perl.
+ */
+#include <math.h>
+#include <string.h>
+
+#define MESH_PLANE       1
+#define MESH_SPHERE      2
+#define MESH_ICOSPHERE   3
+#define MESH_CYLINDER    4
+#define MESH_TORUS       5
+#define MESH_HEIGHTFIELD 6
+
+#define MESH_PI 3.14159265358979323846
+
+/* Where one attribute goes within a vertex.  components == 0 means it isn't written.
+ * 'normalized' stores -1..1 as the range of an integer type, and 'oct' stores a normal as
+ * 2 components of octahedral encoding.
+ */
+struct mesh_attr {
+	int offset, type, components, normalized, oct;
+};
+
+struct mesh_shape {
+	int shape, nu, nv;    /* for the icosphere, nu is the number of segments per edge */
+	double a, b, c;       /* dimensions, per shape; see mesh_vertex */
+	struct mesh_attr position, normal, uv;
+};
+
+/* A mesh_shape travels to the pool kernels as this many doubles */
+#define MESH_PARAMS 21
+
+static void mesh_pack(const struct mesh_shape *s, double *p) {
+	const struct mesh_attr *attr[3]= { &s->position, &s->normal, &s->uv };
+	int i;
+	p[0]= s->shape; p[1]= s->nu; p[2]= s->nv;
+	p[3]= s->a; p[4]= s->b; p[5]= s->c;
+	for (i= 0; i < 3; i++) {
+		p[6+i*5]= attr[i]->offset;
+		p[7+i*5]= attr[i]->type;
+		p[8+i*5]= attr[i]->components;
+		p[9+i*5]= attr[i]->normalized;
+		p[10+i*5]= attr[i]->oct;
+	}
+}
+
+static void mesh_unpack(struct mesh_shape *s, const double *p) {
+	struct mesh_attr *attr[3]= { &s->position, &s->normal, &s->uv };
+	int i;
+	s->shape= (int) p[0]; s->nu= (int) p[1]; s->nv= (int) p[2];
+	s->a= p[3]; s->b= p[4]; s->c= p[5];
+	for (i= 0; i < 3; i++) {
+		attr[i]->offset= (int) p[6+i*5];
+		attr[i]->type= (int) p[7+i*5];
+		attr[i]->components= (int) p[8+i*5];
+		attr[i]->normalized= (int) p[9+i*5];
+		attr[i]->oct= (int) p[10+i*5];
+	}
+}
+
+static size_t mesh_vertex_count(const struct mesh_shape *s) {
+	size_t n= s->nu;
+	return s->shape == MESH_ICOSPHERE? 20 * (n+1) * (n+2) / 2 : (n+1) * (size_t)(s->nv+1);
+}
+
+static size_t mesh_index_count(const struct mesh_shape *s) {
+	size_t n= s->nu;
+	return s->shape == MESH_ICOSPHERE? 20 * n * n * 3 : n * (size_t) s->nv * 6;
+}
+
+/* The icosahedron, with faces wound counter-clockwise seen from outside */
+static const double mesh_ico_vertex[12][3]= {
+	{ -1, 1.618033988749895, 0 }, { 1, 1.618033988749895, 0 }, { -1, -1.618033988749895, 0 }, { 1, -1.618033988749895, 0 },
+	{ 0, -1, 1.618033988749895 }, { 0, 1, 1.618033988749895 }, { 0, -1, -1.618033988749895 }, { 0, 1, -1.618033988749895 },
+	{ 1.618033988749895, 0, -1 }, { 1.618033988749895, 0, 1 }, { -1.618033988749895, 0, -1 }, { -1.618033988749895, 0, 1 }
+};
+static const unsigned char mesh_ico_face[20][3]= {
+	{0,11,5}, {0,5,1}, {0,1,7}, {0,7,10}, {0,10,11}, {1,5,9}, {5,11,4}, {11,10,2}, {10,7,6}, {7,1,8},
+	{3,9,4}, {3,4,2}, {3,2,6}, {3,6,8}, {3,8,9}, {4,9,5}, {2,4,11}, {6,2,10}, {8,6,7}, {9,8,1}
+};
+
+/* Longitude of a direction as 0..1, with the same orientation as the UV sphere */
+static double mesh_sphere_u(const double *d) {
+	double u= atan2(-d[2], d[0]) / (2 * MESH_PI);
+	return u < 0? u + 1 : u;
+}
+
+/* Row 'j' of a triangular grid with n+1 vertices in row 0 starts at vertex j*(n+1) - j*(j-1)/2 */
+static size_t mesh_tri_row(size_t k, size_t n) {
+	size_t j= (size_t) ((2*n + 3 - sqrt((double)(2*n+3)*(2*n+3) - 8.0*k)) / 2);
+	while (j > 0 && j*(n+1) - j*(j-1)/2 > k) j--;
+	while ((j+1)*(n+1) - (j+1)*j/2 <= k) j++;
+	return j;
+}
+
+static void mesh_normalize(double *v) {
+	double len= sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+	if (len > 0) { v[0] /= len; v[1] /= len; v[2] /= len; }
+}
+
+/* Height sample (col, row) of a heightfield, clamped to the edges */
+static double mesh_height(const struct mesh_shape *s, const struct view_layout *h, int col, int row) {
+	if (col < 0) col= 0; else if (col > s->nu) col= s->nu;
+	if (row < 0) row= 0; else if (row > s->nv) row= s->nv;
+	return view_load(h->type, h->data + ((size_t) row * (s->nu+1) + col) * h->stride);
+}
+
+/* Compute vertex i.  The dimensions are:
+ *   plane:       a= width (x), b= height (y), in the XY plane facing +Z
+ *   sphere:      a= radius, with nu segments around Y and nv rings from the -Y pole
+ *   icosphere:   a= radius
+ *   cylinder:    a= bottom radius, b= top radius, c= height, around Y, without end caps
+ *   torus:       a= radius of the ring around Y, b= radius of the tube
+ *   heightfield: a= width (x), b= depth (y), c= scale of the heights (z)
+ */
+static void mesh_vertex(const struct mesh_shape *s, const struct view_layout *heights, size_t i,
+	double *pos, double *nrm, double *uv
+) {
+	double u, v, th, ph, r, dx, dy;
+	int col, row;
+	if (s->shape == MESH_ICOSPHERE) {
+		size_t n= s->nu, per_face= (n+1)*(n+2)/2, face= i / per_face, k= i % per_face, j, q, c;
+		const double *A= mesh_ico_vertex[mesh_ico_face[face][0]], *B= mesh_ico_vertex[mesh_ico_face[face][1]],
+			*C= mesh_ico_vertex[mesh_ico_face[face][2]];
+		double center[3];
+		j= mesh_tri_row(k, n);
+		q= k - (j*(n+1) - j*(j-1)/2);
+		for (c= 0; c < 3; c++) {
+			nrm[c]= A[c] + (B[c] - A[c]) * q / n + (C[c] - A[c]) * j / n;
+			center[c]= A[c] + B[c] + C[c];
+		}
+		mesh_normalize(nrm);
+		for (c= 0; c < 3; c++) pos[c]= nrm[c] * s->a;
+		/* keep each face's texture coordinates on one side of the seam, and give the poles
+		 * the longitude of their face */
+		th= mesh_sphere_u(center);
+		u= fabs(nrm[1]) > .999999? th : mesh_sphere_u(nrm);
+		if (u - th > .5) u -= 1;
+		else if (th - u > .5) u += 1;
+		uv[0]= u;
+		uv[1]= acos(nrm[1] < -1? 1 : nrm[1] > 1? -1 : -nrm[1]) / MESH_PI;
+		return;
+	}
+	col= (int) (i % (s->nu+1));
+	row= (int) (i / (s->nu+1));
+	u= (double) col / s->nu;
+	v= (double) row / s->nv;
+	uv[0]= u; uv[1]= v;
+	switch (s->shape) {
+	case MESH_SPHERE:
+		th= u * 2 * MESH_PI, ph= v * MESH_PI;
+		nrm[0]= sin(ph) * cos(th); nrm[1]= -cos(ph); nrm[2]= -sin(ph) * sin(th);
+		pos[0]= nrm[0] * s->a; pos[1]= nrm[1] * s->a; pos[2]= nrm[2] * s->a;
+		break;
+	case MESH_CYLINDER:
+		th= u * 2 * MESH_PI;
+		r= s->a + (s->b - s->a) * v;
+		pos[0]= r * cos(th); pos[1]= (v - .5) * s->c; pos[2]= -r * sin(th);
+		nrm[0]= s->c * cos(th); nrm[1]= s->a - s->b; nrm[2]= -s->c * sin(th);
+		mesh_normalize(nrm);
+		break;
+	case MESH_TORUS:
+		th= u * 2 * MESH_PI, ph= v * 2 * MESH_PI;
+		r= s->a + s->b * cos(ph);
+		pos[0]= r * cos(th); pos[1]= s->b * sin(ph); pos[2]= -r * sin(th);
+		nrm[0]= cos(ph) * cos(th); nrm[1]= sin(ph); nrm[2]= -cos(ph) * sin(th);
+		break;
+	case MESH_HEIGHTFIELD:
+		pos[0]= (u - .5) * s->a; pos[1]= (v - .5) * s->b;
+		pos[2]= mesh_height(s, heights, col, row) * s->c;
+		/* central differences, one-sided at the edges */
+		dx= (mesh_height(s, heights, col+1, row) - mesh_height(s, heights, col-1, row)) * s->c
+			/ ((col > 0 && col < s->nu? 2.0 : 1.0) * s->a / s->nu);
+		dy= (mesh_height(s, heights, col, row+1) - mesh_height(s, heights, col, row-1)) * s->c
+			/ ((row > 0 && row < s->nv? 2.0 : 1.0) * s->b / s->nv);
+		nrm[0]= -dx; nrm[1]= -dy; nrm[2]= 1;
+		mesh_normalize(nrm);
+		break;
+	default: /* MESH_PLANE */
+		pos[0]= (u - .5) * s->a; pos[1]= (v - .5) * s->b; pos[2]= 0;
+		nrm[0]= 0; nrm[1]= 0; nrm[2]= 1;
+	}
+}
+
+/* Write 'v' (with 'n' values) into an attribute.  Missing components are 0, except w is 1
+ * for a position.
+ */
+static void mesh_store(char *vertex, const struct mesh_attr *a, const double *v, int n, double w) {
+	struct view_layout out= { vertex + a->offset, 0, 1, a->type, a->components, a->normalized };
+	double tmp[VIEW_MAX_COMPONENTS];
+	int c;
+	if (a->oct)
+		view_oct_encode_vec(v, tmp);
+	else
+		for (c= 0; c < a->components; c++)
+			tmp[c]= c < n? v[c] : c == 3? w : 0;
+	view_write(&out, 0, tmp);
+}
+
+/* Write 'count' vertices, from vertex 'first', at 'dst' with 'stride' bytes between them */
+static void mesh_write_vertices(const struct mesh_shape *s, const struct view_layout *heights,
+	char *dst, size_t stride, size_t first, size_t count
+) {
+	double pos[3], nrm[3], uv[2];
+	size_t i;
+	for (i= 0; i < count; i++, dst += stride) {
+		mesh_vertex(s, heights, first + i, pos, nrm, uv);
+		if (s->position.components) mesh_store(dst, &s->position, pos, 3, 1);
+		if (s->normal.components)   mesh_store(dst, &s->normal, nrm, 3, 0);
+		if (s->uv.components)       mesh_store(dst, &s->uv, uv, 2, 0);
+	}
+}
+
+/* The vertex number of index i, for counter-clockwise triangles */
+static size_t mesh_index(const struct mesh_shape *s, size_t i) {
+	size_t t= i / 3, corner= i % 3;
+	if (s->shape == MESH_ICOSPHERE) {
+		size_t n= s->nu, face= t / (n*n), ft= t % (n*n), j, q, row0, row1;
+		/* row j of triangles starts at triangle j*(2n-j), and has n-j up and n-j-1 down */
+		j= (size_t) (n - sqrt((double) n*n - ft));
+		while (j > 0 && j*(2*n-j) > ft) j--;
+		while ((j+1)*(2*n-j-1) <= ft) j++;
+		q= ft - j*(2*n-j);
+		row0= face * ((n+1)*(n+2)/2) + j*(n+1) - j*(j-1)/2;
+		row1= row0 + (n+1-j);
+		if (q < n-j) /* up: (q,j) (q+1,j) (q,j+1) */
+			return corner == 0? row0 + q : corner == 1? row0 + q + 1 : row1 + q;
+		q -= n-j;    /* down: (q+1,j) (q+1,j+1) (q,j+1) */
+		return corner == 0? row0 + q + 1 : corner == 1? row1 + q + 1 : row1 + q;
+	}
+	else {
+		size_t quad= t / 2, a= (quad / s->nu) * (s->nu+1) + quad % s->nu, w= s->nu + 1;
+		static const unsigned char off[2][3]= { { 0, 1, 3 }, { 0, 3, 2 } }; /* a b d, a d c */
+		int k= off[t & 1][corner];
+		return a + (k & 1) + (k >> 1) * w;
+	}
+}
+
+/* Write 'count' indices, from index 'first', of type GL_UNSIGNED_SHORT or GL_UNSIGNED_INT,
+ * adding 'base' to each
+ */
+static void mesh_write_indices(const struct mesh_shape *s, int type, char *dst, size_t first, size_t count, size_t base) {
+	size_t i;
+	unsigned short us;
+	unsigned int ui;
+	for (i= 0; i < count; i++) {
+		if (type == GL_UNSIGNED_SHORT) {
+			us= (unsigned short) (mesh_index(s, first + i) + base);
+			memcpy(dst + i * 2, &us, 2);
+		} else {
+			ui= (unsigned int) (mesh_index(s, first + i) + base);
+			memcpy(dst + i * 4, &ui, 4);
+		}
+	}
+}
+
+/* ThreadPool kernels.  params are mesh_pack's, followed by the base vertex for indices.
+ * For a heightfield, src is the heights, cut to the same range as dst; the kernel needs all of
+ * them for the normals, so it steps back to the start of the view.
+ */
+static void pool_kernel_mesh_vertices(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params
+) {
+	struct mesh_shape s;
+	struct view_layout heights;
+	mesh_unpack(&s, params);
+	if (src) {
+		heights= *src;
+		heights.data -= first * heights.stride;
+	}
+	mesh_write_vertices(&s, src? &heights : NULL, dst->data, dst->stride, first, dst->count);
+}
+
+static void pool_kernel_mesh_indices(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params
+) {
+	struct mesh_shape s;
+	mesh_unpack(&s, params);
+	mesh_write_indices(&s, dst->type, dst->data, first, dst->count, (size_t) params[MESH_PARAMS]);
+}
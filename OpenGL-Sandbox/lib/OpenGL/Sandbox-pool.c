@@ -0,0 +1,345 @@
+/* A pool of worker threads that run a kernel over disjoint ranges of a view_layout, for
+ * OpenGL::Sandbox::ThreadPool.  One job runs at a time: the elements are cut into chunks, and
+ * each thread (including the caller, when it waits) takes the next chunk until none are left.
+ * A kernel only ever sees its own chunk, so kernels need no locking.
+ * Like the frame writer, the threads must not use anything that needs the perl interpreter,
+ * so kernels only use plain C, and all memory is allocated on the caller's thread.
+ * Every open pool is on a list, so that work_pool_wait_all can finish all jobs before a
+ * buffer is unmapped.
+ */
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define POOL_MAX_THREADS 64
+#define POOL_MAX_PARAMS  32
+#define POOL_MAX_KERNELS 64
+#define POOL_MIN_CHUNK   4096  /* elements; fewer aren't worth waking another thread */
+
+/* 'first' is the index of dst->data within the whole job.  src is NULL if the job has none. */
+typedef void (*pool_kernel_fn)(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params);
+
+struct work_pool {
+	int threads, stop;
+	/* the current job */
+	int busy;
+	pool_kernel_fn kernel;
+	struct view_layout dst, src;
+	int has_src, n_params;
+	double params[POOL_MAX_PARAMS];
+	size_t chunk, n_chunks, next_chunk, done_chunks;
+	struct work_pool *next_pool;
+#ifdef _WIN32
+	HANDLE thread[POOL_MAX_THREADS];
+	CRITICAL_SECTION lock;
+	CONDITION_VARIABLE work, done;
+#else
+	pthread_t thread[POOL_MAX_THREADS];
+	pthread_mutex_t lock;
+	pthread_cond_t work, done;
+#endif
+};
+
+static struct work_pool *work_pools= NULL;
+
+#ifdef _WIN32
+#define POOL_LOCK(p)            EnterCriticalSection(&(p)->lock)
+#define POOL_UNLOCK(p)          LeaveCriticalSection(&(p)->lock)
+#define POOL_WAIT(p, cond)      SleepConditionVariableCS(&(p)->cond, &(p)->lock, INFINITE)
+#define POOL_BROADCAST(p, cond) WakeAllConditionVariable(&(p)->cond)
+#else
+#define POOL_LOCK(p)            pthread_mutex_lock(&(p)->lock)
+#define POOL_UNLOCK(p)          pthread_mutex_unlock(&(p)->lock)
+#define POOL_WAIT(p, cond)      pthread_cond_wait(&(p)->cond, &(p)->lock)
+#define POOL_BROADCAST(p, cond) pthread_cond_broadcast(&(p)->cond)
+#endif
+
+static int pool_cpu_count() {
+#ifdef _WIN32
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	return (int) si.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	long n= sysconf(_SC_NPROCESSORS_ONLN);
+	return n > 0? (int) n : 1;
+#else
+	return 1;
+#endif
+}
+
+/* Run one chunk of the current job.  The job fields don't change while chunks are handed out. */
+static void work_pool_run_chunk(struct work_pool *p, size_t chunk) {
+	struct view_layout d= p->dst, s= p->src;
+	size_t first= chunk * p->chunk;
+	d.count= p->dst.count - first < p->chunk? p->dst.count - first : p->chunk;
+	d.data += first * d.stride;
+	if (p->has_src) {
+		s.count= d.count;
+		s.data += first * s.stride;
+	}
+	p->kernel(&d, p->has_src? &s : NULL, first, p->params, p->n_params);
+}
+
+/* Take and run chunks until none are left.  Called with the lock held. */
+static void work_pool_take_chunks(struct work_pool *p) {
+	size_t chunk;
+	while (p->next_chunk < p->n_chunks) {
+		chunk= p->next_chunk++;
+		POOL_UNLOCK(p);
+		work_pool_run_chunk(p, chunk);
+		POOL_LOCK(p);
+		if (++p->done_chunks == p->n_chunks)
+			POOL_BROADCAST(p, done);
+	}
+}
+
+static void work_pool_run(struct work_pool *p) {
+	POOL_LOCK(p);
+	for (;;) {
+		while (!p->stop && p->next_chunk >= p->n_chunks)
+			POOL_WAIT(p, work);
+		if (p->stop) break;
+		work_pool_take_chunks(p);
+	}
+	POOL_UNLOCK(p);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI work_pool_thread(LPVOID p) { work_pool_run((struct work_pool*) p); return 0; }
+#else
+static void* work_pool_thread(void *p) { work_pool_run((struct work_pool*) p); return NULL; }
+#endif
+
+/* Public functions, for the caller's thread */
+
+/* Start up to 'threads' workers.  If fewer can be started (even none), the caller does the
+ * rest of the work in work_pool_wait, so this can't fail.
+ */
+static void work_pool_open(struct work_pool *p, int threads) {
+	int i;
+	memset(p, 0, sizeof(*p));
+	if (threads > POOL_MAX_THREADS) threads= POOL_MAX_THREADS;
+#ifdef _WIN32
+	InitializeCriticalSection(&p->lock);
+	InitializeConditionVariable(&p->work);
+	InitializeConditionVariable(&p->done);
+	for (i= 0; i < threads; i++)
+		if (!(p->thread[i]= CreateThread(NULL, 0, work_pool_thread, p, 0, NULL))) break;
+#else
+	pthread_mutex_init(&p->lock, NULL);
+	pthread_cond_init(&p->work, NULL);
+	pthread_cond_init(&p->done, NULL);
+	for (i= 0; i < threads; i++)
+		if (pthread_create(&p->thread[i], NULL, work_pool_thread, p) != 0) break;
+#endif
+	p->threads= i;
+	p->next_pool= work_pools;
+	work_pools= p;
+}
+
+/* Wait for the current job, if any.  The caller runs chunks too, unless they are all taken. */
+static void work_pool_wait(struct work_pool *p) {
+	if (!p->busy) return;
+	POOL_LOCK(p);
+	work_pool_take_chunks(p);
+	while (p->done_chunks < p->n_chunks)
+		POOL_WAIT(p, done);
+	p->busy= 0;
+	POOL_UNLOCK(p);
+}
+
+static void work_pool_wait_all() {
+	struct work_pool *p;
+	for (p= work_pools; p; p= p->next_pool)
+		work_pool_wait(p);
+}
+
+/* Start a job, after finishing the previous one.  If src is given, the job covers as many
+ * elements as the shorter of dst and src.
+ */
+static void work_pool_start(struct work_pool *p, pool_kernel_fn kernel,
+	const struct view_layout *dst, const struct view_layout *src,
+	const double *params, int n_params
+) {
+	size_t count= dst->count, per_thread;
+	work_pool_wait(p);
+	if (src && src->count < count) count= src->count;
+	if (n_params > POOL_MAX_PARAMS) n_params= POOL_MAX_PARAMS;
+	POOL_LOCK(p);
+	p->kernel= kernel;
+	p->dst= *dst;
+	p->dst.count= count;
+	p->has_src= src != NULL;
+	if (src) p->src= *src;
+	memcpy(p->params, params, n_params * sizeof(double));
+	p->n_params= n_params;
+	/* a few chunks per thread, so that a slow thread doesn't hold up the rest */
+	per_thread= count / ((size_t) p->threads * 4 + 1);
+	p->chunk= per_thread < POOL_MIN_CHUNK? POOL_MIN_CHUNK : per_thread;
+	p->n_chunks= p->chunk? (count + p->chunk - 1) / p->chunk : 0;
+	p->next_chunk= p->done_chunks= 0;
+	p->busy= 1;
+	if (p->n_chunks > 1 && p->threads)
+		POOL_BROADCAST(p, work);
+	POOL_UNLOCK(p);
+}
+
+/* Finish the current job, stop the workers, and remove the pool from the list */
+static void work_pool_close(struct work_pool *p) {
+	struct work_pool **pp;
+	int i;
+	work_pool_wait(p);
+	POOL_LOCK(p);
+	p->stop= 1;
+	POOL_BROADCAST(p, work);
+	POOL_UNLOCK(p);
+	for (i= 0; i < p->threads; i++) {
+#ifdef _WIN32
+		WaitForSingleObject(p->thread[i], INFINITE);
+		CloseHandle(p->thread[i]);
+#else
+		pthread_join(p->thread[i], NULL);
+#endif
+	}
+#ifdef _WIN32
+	DeleteCriticalSection(&p->lock);
+#else
+	pthread_mutex_destroy(&p->lock);
+	pthread_cond_destroy(&p->work);
+	pthread_cond_destroy(&p->done);
+#endif
+	p->threads= 0;
+	for (pp= &work_pools; *pp; pp= &(*pp)->next_pool)
+		if (*pp == p) { *pp= p->next_pool; break; }
+}
+
+/* Built-in kernels.  They must not fail, so they use at most the parameters they were given,
+ * and take missing ones as 0.  Parameter counts are checked before the job starts.
+ */
+
+static void pool_expand_params(const double *params, int n_params, int offset, int components, double *out) {
+	int c;
+	for (c= 0; c < components; c++) {
+		int i= offset + (n_params - offset == 1? 0 : c);
+		out[c]= i < n_params? params[i] : 0;
+	}
+}
+
+/* params: one value, or one per component */
+static void pool_kernel_fill(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params
+) {
+	double v[VIEW_MAX_COMPONENTS];
+	pool_expand_params(params, n_params, 0, dst->components, v);
+	view_fill(dst, v);
+}
+
+/* params: factor and offset, each either one value or one per component */
+static void pool_kernel_scale_add(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params
+) {
+	double f[VIEW_MAX_COMPONENTS], o[VIEW_MAX_COMPONENTS];
+	int half= n_params / 2;
+	pool_expand_params(params, half, 0, dst->components, f);
+	pool_expand_params(params, n_params, half, dst->components, o);
+	view_scale_add(dst, f, o);
+}
+
+/* dst = dst * params[0] + src * params[1] */
+static void pool_kernel_combine(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params
+) {
+	/* _thread_pool_start copies a source which overlaps, so this never needs to allocate */
+	if (src) view_combine(dst, n_params > 0? params[0] : 0, src, n_params > 1? params[1] : 0);
+}
+
+/* Multiply float vectors in place by a column-major 4x4 matrix of 16 params.
+ * _thread_pool_start checks that dst is vec2, vec3 or vec4. */
+static void pool_kernel_transform(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params
+) {
+	float m[16], v[4];
+	size_t i, n= dst->components * sizeof(float);
+	int k;
+	for (k= 0; k < 16; k++) m[k]= k < n_params? (float) params[k] : 0;
+	if (dst->stride == n && ((size_t) dst->data % sizeof(float)) == 0) {
+		mat4_transform_points(m, (float*) dst->data, dst->components, (float*) dst->data, dst->components, dst->count);
+		return;
+	}
+	for (i= 0; i < dst->count; i++) {
+		memcpy(v, dst->data + i * dst->stride, n);
+		mat4_transform_points(m, v, dst->components, v, dst->components, 1);
+		memcpy(dst->data + i * dst->stride, v, n);
+	}
+}
+
+/* Octahedral encoding of the unit vectors in src into 2 components of dst, and back */
+static void pool_kernel_oct_encode(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params
+) {
+	if (src) view_oct_encode(dst, src);
+}
+
+static void pool_kernel_oct_decode(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params
+) {
+	if (src) view_oct_decode(dst, src);
+}
+
+/* Copy between several pairs of views at once (see view_copy_streams).  It isn't run by
+ * name: dst->data is the table of streams, with a stride of 0 so that every range gets the
+ * whole table, and params[0] is the number of streams.
+ */
+static void pool_kernel_streams(const struct view_layout *dst, const struct view_layout *src,
+	size_t first, const double *params, int n_params
+) {
+	view_copy_streams((const struct view_stream*) dst->data, n_params > 0? (int) params[0] : 0, first, dst->count);
+}
+
+/* The kernels that can be run by name.  n_params is the exact number of parameters, or
+ * -N for N groups of either 1 or 'components' values, or POOL_ANY_PARAMS.  needs_src is
+ * POOL_SRC_CONVERT for kernels whose source has different components than dst; their
+ * views may only overlap as the same elements.
+ */
+#define POOL_ANY_PARAMS (-100)
+#define POOL_SRC_CONVERT 2
+struct pool_kernel_def {
+	const char *name;
+	pool_kernel_fn fn;
+	int needs_src, n_params;
+};
+
+static struct pool_kernel_def pool_kernels[POOL_MAX_KERNELS]= {
+	{ "fill",      pool_kernel_fill,      0, -1 },
+	{ "scale_add", pool_kernel_scale_add, 0, -2 },
+	{ "combine",   pool_kernel_combine,   1,  2 },
+	{ "transform", pool_kernel_transform, 0, 16 },
+	{ "oct_encode", pool_kernel_oct_encode, POOL_SRC_CONVERT, 0 },
+	{ "oct_decode", pool_kernel_oct_decode, POOL_SRC_CONVERT, 0 },
+};
+#define POOL_BUILTIN_KERNELS 6
+static int pool_n_kernels= POOL_BUILTIN_KERNELS;
+
+static struct pool_kernel_def* pool_find_kernel(const char *name) {
+	int i;
+	for (i= 0; i < pool_n_kernels; i++)
+		if (strcmp(pool_kernels[i].name, name) == 0)
+			return &pool_kernels[i];
+	return NULL;
+}
+
+/* Check the number of parameters for a kernel, for a view of 'components'.  Returns 0 if wrong. */
+static int pool_check_params(const struct pool_kernel_def *k, int components, int n_params) {
+	int groups;
+	if (n_params > POOL_MAX_PARAMS) return 0;
+	if (k->n_params == POOL_ANY_PARAMS) return 1;
+	if (k->n_params >= 0) return n_params == k->n_params;
+	groups= -k->n_params;
+	return n_params == groups || n_params == groups * components;
+}
@@ -12,10 +12,392 @@ static void carp_croak_sv(SV* value) {
 
 #include "glducktape.c"
 
+/* OpenGL::Sandbox::GLDispatch objects are a ref to the address of a struct glducktape_dispatch */
+/* State that belongs to one GL context, kept in the context's OpenGL::Sandbox::GLDispatch.
+ * gl_current_state follows _gl_dispatch_use, and is the default when no table is in use.
+ */
+struct gl_context_state {
+	struct glducktape_dispatch table;
+	int debug_on;   /* KHR_debug callback installed, so glGetError isn't used */
+};
+static struct gl_context_state gl_default_state, *gl_current_state= &gl_default_state;
+
+static struct gl_context_state *_get_gl_context_state(SV *obj) {
+	if (!sv_isa(obj, "OpenGL::Sandbox::GLDispatch"))
+		carp_croak("Expected OpenGL::Sandbox::GLDispatch");
+	return INT2PTR(struct gl_context_state*, SvIV(SvRV(obj)));
+}
+
+static struct glducktape_dispatch *_get_gl_dispatch(SV *obj) {
+	return &_get_gl_context_state(obj)->table;
+}
+
+static void _gl_dispatch_push_missing(const char *name, void *missing) {
+	av_push((AV*) missing, newSVpv(name, 0));
+}
+
+/* Mark a function for profiling of its total time and the GL calls made within it.
+ * GL_PROFILE_BEGIN goes at the end of the declarations, and GL_PROFILE_END before each return.
+ * A croak skips the END, so that call isn't counted, but the enclosing scope is restored from
+ * perl's save stack as the croak unwinds.
+ */
+#define GL_PROFILE_BEGIN(scope_name) \
+	static struct glducktape_scope gl_profile_scope= { .name= scope_name }; \
+	unsigned long long gl_profile_t0= glducktape_profiling? _gl_profile_enter(&gl_profile_scope) : 0
+#define GL_PROFILE_END() \
+	if (gl_profile_t0) _gl_profile_leave(&gl_profile_scope, gl_profile_t0)
+
+static unsigned long long _gl_profile_enter(struct glducktape_scope *scope) {
+	ENTER;
+	SAVEVPTR(glducktape_cur_scope);
+	return glducktape_scope_enter(scope);
+}
+
+static void _gl_profile_leave(struct glducktape_scope *scope, unsigned long long t0) {
+	glducktape_scope_leave(scope, t0);
+	LEAVE;
+}
+
+static SV* _gl_profile_stat(struct glducktape_stat *stat) {
+	HV *hv= newHV();
+	if (!hv_stores(hv, "calls", newSVuv(stat->calls))
+	 || !hv_stores(hv, "seconds", newSVnv(stat->ns * 1e-9)))
+		croak("hv_store failed");
+	return newRV_noinc((SV*) hv);
+}
+
+/* GL's 64-bit counters, as an integer if perl has 64-bit integers */
+static SV* _newSVu64(unsigned long long v) {
+#if UVSIZE >= 8
+	return newSVuv((UV) v);
+#else
+	return newSVnv((NV) v);
+#endif
+}
+
+/* Parse the version of the current context.  Returns false if there is no current context. */
+static int _gl_context_version(int *major, int *minor) {
+	const char *version= (const char*) glGetString(GL_VERSION);
+	*major= *minor= 0;
+	if (!version) return 0;
+	/* OpenGL ES has a prefix before the version number */
+	while (*version && !isDIGIT(*version)) version++;
+	sscanf(version, "%d.%d", major, minor);
+	return 1;
+}
+
+/* Messages from KHR_debug are collected here by the callback, and removed by gl_debug_drain.
+ * The driver may call the callback from its own threads, so the ring has a spinlock, held only
+ * long enough to copy one message.  Messages that arrive while the ring is full are counted
+ * and discarded.  Whether the callback is installed is tracked per context, in debug_on of
+ * struct gl_context_state.
+ */
+#ifdef GL_VERSION_4_3
+#define GL_DEBUG_RING_SIZE 256
+#define GL_DEBUG_TEXT_MAX  512
+struct gl_debug_msg {
+	GLenum source, type, severity;
+	GLuint id;
+	char text[GL_DEBUG_TEXT_MAX];
+};
+static struct gl_debug_msg gl_debug_ring[GL_DEBUG_RING_SIZE];
+static unsigned gl_debug_head= 0, gl_debug_tail= 0, gl_debug_dropped= 0;
+static volatile long gl_debug_lock= 0;
+#ifdef _MSC_VER
+#define GL_DEBUG_LOCK()   while (InterlockedExchange(&gl_debug_lock, 1)) {}
+#define GL_DEBUG_UNLOCK() InterlockedExchange(&gl_debug_lock, 0)
+#else
+#define GL_DEBUG_LOCK()   while (__sync_lock_test_and_set(&gl_debug_lock, 1)) {}
+#define GL_DEBUG_UNLOCK() __sync_lock_release(&gl_debug_lock)
+#endif
+
+static void APIENTRY _gl_debug_callback(GLenum source, GLenum type, GLuint id, GLenum severity,
+	GLsizei length, const GLchar *message, const void *user
+) {
+	struct gl_debug_msg *m;
+	(void) user;
+	if (length < 0) length= strlen(message);
+	if (length >= GL_DEBUG_TEXT_MAX) length= GL_DEBUG_TEXT_MAX-1;
+	GL_DEBUG_LOCK();
+	if (gl_debug_head - gl_debug_tail >= GL_DEBUG_RING_SIZE)
+		gl_debug_dropped++;
+	else {
+		m= gl_debug_ring + (gl_debug_head % GL_DEBUG_RING_SIZE);
+		m->source= source;
+		m->type= type;
+		m->severity= severity;
+		m->id= id;
+		memcpy(m->text, message, length);
+		m->text[length]= '\0';
+		gl_debug_head++;
+	}
+	GL_DEBUG_UNLOCK();
+}
+
+static const char* _gl_debug_source_name(GLenum source) {
+	switch (source) {
+	case GL_DEBUG_SOURCE_API:             return "api";
+	case GL_DEBUG_SOURCE_WINDOW_SYSTEM:   return "window_system";
+	case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader_compiler";
+	case GL_DEBUG_SOURCE_THIRD_PARTY:     return "third_party";
+	case GL_DEBUG_SOURCE_APPLICATION:     return "application";
+	default:                              return "other";
+	}
+}
+
+static const char* _gl_debug_type_name(GLenum type) {
+	switch (type) {
+	case GL_DEBUG_TYPE_ERROR:               return "error";
+	case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated";
+	case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:  return "undefined_behavior";
+	case GL_DEBUG_TYPE_PORTABILITY:         return "portability";
+	case GL_DEBUG_TYPE_PERFORMANCE:         return "performance";
+	case GL_DEBUG_TYPE_MARKER:              return "marker";
+	case GL_DEBUG_TYPE_PUSH_GROUP:          return "push_group";
+	case GL_DEBUG_TYPE_POP_GROUP:           return "pop_group";
+	default:                                return "other";
+	}
+}
+
+static const char* _gl_debug_severity_name(GLenum severity) {
+	switch (severity) {
+	case GL_DEBUG_SEVERITY_HIGH:   return "high";
+	case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+	case GL_DEBUG_SEVERITY_LOW:    return "low";
+	default:                       return "notification";
+	}
+}
+
+/* Check the extension list of the current context */
+static int _gl_has_extension(const char *name) {
+	int major, minor, n= 0, i;
+	const char *ext, *p;
+	size_t len= strlen(name);
+	_gl_context_version(&major, &minor);
+	if (major >= 3) {
+		glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+		for (i= 0; i < n; i++)
+			if ((ext= (const char*) glGetStringi(GL_EXTENSIONS, i)) && !strcmp(ext, name))
+				return 1;
+		return 0;
+	}
+	/* legacy contexts give one space-separated string */
+	for (ext= (const char*) glGetString(GL_EXTENSIONS); ext && (p= strstr(ext, name)); ext= p + len)
+		if ((p == ext || p[-1] == ' ') && (p[len] == ' ' || p[len] == '\0'))
+			return 1;
+	return 0;
+}
+#endif
+
 /* These macros are used to access the OpenGL::Sandbox::MMap object data */
 #define SCALAR_REF_DATA(obj) (SvROK(obj) && SvPOK(SvRV(obj))? (void*)SvPVX(SvRV(obj)) : (void*)0)
 #define SCALAR_REF_LEN(obj)  (SvROK(obj) && SvPOK(SvRV(obj))? SvCUR(SvRV(obj)) : 0)
 
+#include "Sandbox-mat4.c"
+#include "Sandbox-headless.c"
+#include "Sandbox-capture.c"
+#include "Sandbox-view.c"
+#include "Sandbox-pool.c"
+#include "Sandbox-mesh.c"
+
+/* OpenGL::Sandbox::HeadlessContext objects are a ref to the address of a struct headless_context */
+static struct headless_context *_get_headless_context(SV *obj) {
+	if (!sv_isa(obj, "OpenGL::Sandbox::HeadlessContext"))
+		carp_croak("Expected OpenGL::Sandbox::HeadlessContext");
+	return INT2PTR(struct headless_context*, SvIV(SvRV(obj)));
+}
+
+/* OpenGL::Sandbox::FrameWriter::C objects are a ref to the address of a struct frame_writer */
+static struct frame_writer *_get_frame_writer(SV *obj) {
+	if (!sv_isa(obj, "OpenGL::Sandbox::FrameWriter::C"))
+		carp_croak("Expected OpenGL::Sandbox::FrameWriter::C");
+	return INT2PTR(struct frame_writer*, SvIV(SvRV(obj)));
+}
+
+/* OpenGL::Sandbox::BufferView objects are a ref to the address of a struct buffer_view.
+ * The view holds a reference to the scalar whose bytes it describes, and looks up the address
+ * of those bytes on every call, so it notices when a mapped buffer has been unmapped (and the
+ * scalar emptied) or a perl string has been reallocated.
+ */
+struct buffer_view {
+	SV *source;
+	size_t offset, stride, count;
+	int type, components, normalized;
+};
+
+static struct buffer_view *_get_buffer_view(SV *obj) {
+	if (!sv_isa(obj, "OpenGL::Sandbox::BufferView"))
+		carp_croak("Expected OpenGL::Sandbox::BufferView");
+	return INT2PTR(struct buffer_view*, SvIV(SvRV(obj)));
+}
+
+/* Find the current address and length of the bytes of a mapped or plain scalar.  The address
+ * is NULL if a mapping is gone.
+ */
+static char *_buffer_source_bytes(SV *src, int writable, size_t *len) {
+	struct buffer_scalar_info *info= get_sv_magic(src);
+	if (info) {
+		if (writable && (info->flags & BUFFER_SCALAR_READONLY))
+			carp_croak("Buffer is mapped read-only");
+		*len= info->length;
+		return info->address;
+	}
+	if (writable) {
+		if (SvREADONLY(src)) carp_croak("Buffer is read-only");
+		if (SvIsCOW(src)) sv_force_normal_flags(src, 0);
+	}
+	*len= SvPOK(src)? SvCUR(src) : 0;
+	return SvPOK(src)? SvPVX(src) : NULL;
+}
+
+/* Find the current address of the view's bytes, and check that they are all there */
+static void _buffer_view_layout(struct buffer_view *view, struct view_layout *out, int writable) {
+	size_t len;
+	char *data= _buffer_source_bytes(view->source, writable, &len);
+	if (!data && view->count)
+		carp_croak("Buffer is no longer mapped");
+	out->data= data? data + view->offset : NULL;
+	out->stride= view->stride;
+	out->count= view->count;
+	out->type= view->type;
+	out->components= view->components;
+	out->normalized= view->normalized;
+	if (view->offset + view_span(out) > len)
+		carp_croak("View of %lu bytes at offset %lu exceeds buffer length %lu",
+			(unsigned long) view_span(out), (unsigned long) view->offset, (unsigned long) len);
+}
+
+/* Check the views for octahedral encoding, which converts each element in place, so they may
+ * only overlap as the same elements.
+ */
+static void _buffer_view_check_oct(const struct view_layout *dst, const struct view_layout *src, int decode) {
+	const struct view_layout *enc= decode? src : dst, *vec= decode? dst : src;
+	struct view_layout s= *src;
+	if (enc->components != 2)
+		carp_croak("Octahedral view needs 2 components, not %d", enc->components);
+	if (vec->components < 3)
+		carp_croak("Vector view needs 3 or 4 components, not %d", vec->components);
+	s.count= src->count < dst->count? src->count : dst->count;
+	if (view_overlaps(dst, &s) && !(src->data == dst->data && src->stride == dst->stride))
+		carp_croak("Views overlap");
+}
+
+/* The transform kernel multiplies float vectors in place, so it needs vec2, vec3 or vec4 */
+static void _buffer_view_check_transform(const struct view_layout *dst) {
+	if (dst->type != GL_FLOAT)
+		carp_croak("Transform view needs float components, not type %d", dst->type);
+	if (dst->components < 2 || dst->components > 4)
+		carp_croak("Transform view needs 2, 3 or 4 components, not %d", dst->components);
+}
+
+/* Read 1 or 'components' numbers from the perl stack, repeating a single value */
+static void _buffer_view_args(SV **args, int n, int components, double *out) {
+	int c;
+	if (n != 1 && n != components)
+		carp_croak("Expected 1 or %d values, got %d", components, n);
+	for (c= 0; c < components; c++)
+		out[c]= SvNV(args[n == 1? 0 : c]);
+}
+
+/* OpenGL::Sandbox::ThreadPool objects are a ref to the address of a struct thread_pool.
+ * While a job runs, the pool holds references to its views, so that the bytes they point to
+ * stay alive until the job has been waited for.  If the source overlapped the destination,
+ * the job reads a copy of it in 'src_copy'.
+ */
+struct thread_pool {
+	struct work_pool pool;
+	SV *dst, *src;
+	char *src_copy;
+};
+
+static struct thread_pool *_get_thread_pool(SV *obj) {
+	if (!sv_isa(obj, "OpenGL::Sandbox::ThreadPool"))
+		carp_croak("Expected OpenGL::Sandbox::ThreadPool");
+	return INT2PTR(struct thread_pool*, SvIV(SvRV(obj)));
+}
+
+/* Wait for the current job, and release its views */
+static void _thread_pool_finish(struct thread_pool *tp) {
+	work_pool_wait(&tp->pool);
+	SvREFCNT_dec(tp->dst);
+	SvREFCNT_dec(tp->src);
+	tp->dst= tp->src= NULL;
+	Safefree(tp->src_copy);
+	tp->src_copy= NULL;
+}
+
+/* OpenGL::Sandbox::Mesh::C objects are a ref to the address of a struct mesh_shape */
+static struct mesh_shape *_get_mesh(SV *obj) {
+	if (!sv_isa(obj, "OpenGL::Sandbox::Mesh::C"))
+		carp_croak("Expected OpenGL::Sandbox::Mesh::C");
+	return INT2PTR(struct mesh_shape*, SvIV(SvRV(obj)));
+}
+
+/* Address of 'len' bytes at 'offset' in a scalar ref or OpenGL::Sandbox::MMap, for writing */
+static char *_buffer_target(SV *ref, size_t offset, size_t len) {
+	size_t avail;
+	char *data;
+	if (!SvROK(ref) || SvTYPE(SvRV(ref)) > SVt_PVMG)
+		carp_croak("Expected a scalar ref or OpenGL::Sandbox::MMap");
+	data= _buffer_source_bytes(SvRV(ref), 1, &avail);
+	if (!data && len)
+		carp_croak("Buffer is no longer mapped");
+	if (offset + len > avail)
+		carp_croak("%lu bytes at offset %lu exceeds buffer length %lu",
+			(unsigned long) len, (unsigned long) offset, (unsigned long) avail);
+	return data? data + offset : NULL;
+}
+
+/* OpenGL::Sandbox::PixelReadRing objects are a ref to the address of a struct pixel_ring.
+ * Each slot is a GL_PIXEL_PACK_BUFFER that glReadPixels copies into without waiting, and a
+ * fence that signals when the copy is done.  A frame is mapped once it is the oldest of a full
+ * ring, and stays mapped (and wrapped by 'view') until the next call reuses its slot.
+ */
+#ifdef GL_VERSION_3_2
+#define PIXEL_RING_MAX 8
+struct pixel_ring_slot {
+	GLuint pbo;
+	GLsync fence;
+	size_t size, alloc;
+	int width, height;
+};
+struct pixel_ring {
+	int depth, head, pending, mapped; /* mapped is the index of the mapped slot, or -1 */
+	SV *view;
+	struct pixel_ring_slot slot[PIXEL_RING_MAX];
+};
+
+static struct pixel_ring *_get_pixel_ring(SV *obj) {
+	if (!sv_isa(obj, "OpenGL::Sandbox::PixelReadRing"))
+		carp_croak("Expected OpenGL::Sandbox::PixelReadRing");
+	return INT2PTR(struct pixel_ring*, SvIV(SvRV(obj)));
+}
+
+/* Detach the perl scalar from the mapped slot and unmap it */
+static void _pixel_ring_unmap(struct pixel_ring *ring) {
+	if (ring->mapped < 0) return;
+	if (ring->view) {
+		buffer_scalar_unwrap(ring->view);
+		SvREFCNT_dec(ring->view);
+		ring->view= NULL;
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, ring->slot[ring->mapped].pbo);
+	glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	ring->mapped= -1;
+}
+#endif
+
+/* OpenGL::Sandbox::Mat4 objects are scalar refs holding 16 packed floats.
+ * Return a writable pointer to the floats, or croak.
+ */
+static float *_get_mat4_from_sv(SV *obj) {
+	if (!SvROK(obj) || !SvPOK(SvRV(obj)) || SvCUR(SvRV(obj)) != 16 * sizeof(float))
+		carp_croak("Expected OpenGL::Sandbox::Mat4 (scalar-ref of 16 packed floats)");
+	/* un-share copy-on-write buffers before modifying them */
+	return (float*) SvPV_force_nolen(SvRV(obj));
+}
+
 int sv_contains_integer(SV *sv) {
 	const char *p;
 	if (SvIOK(sv)) return 1;
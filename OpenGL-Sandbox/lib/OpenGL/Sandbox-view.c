@@ -0,0 +1,409 @@
+/* Typed access to vertex data in a byte buffer, for OpenGL::Sandbox::BufferView.
+ * A layout describes 'count' elements of 1..4 components of a GL type, 'stride' bytes apart.
+ * Values pass through double, except that float buffers are handled as float so that the
+ * common case of animating vertex positions is a simple loop.  Integer types are rounded and
+ * clamped to their range, and half floats are rounded to nearest-even.  A 'normalized' layout
+ * maps integers to -1..1 or 0..1 the way GL does when it reads them as vertex attributes.
+ * The packed 2_10_10_10_REV types hold all 4 components in one 32-bit word.
+ * Pointers do not need to be aligned, since they usually point into a mapped buffer at an
+ * arbitrary offset.
+ * This file only uses plain C, so that it can be compiled apart from perl.
+ */
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT 0x140B
+#endif
+#ifndef GL_INT_2_10_10_10_REV
+#define GL_INT_2_10_10_10_REV 0x8D9F
+#endif
+#ifndef GL_UNSIGNED_INT_2_10_10_10_REV
+#define GL_UNSIGNED_INT_2_10_10_10_REV 0x8368
+#endif
+
+#define VIEW_MAX_COMPONENTS 4
+
+struct view_layout {
+	char *data;      /* address of the first element */
+	size_t stride;   /* bytes from one element to the next */
+	size_t count;
+	int type, components;
+	int normalized;  /* integers are fractions of their range */
+};
+
+/* Size of one component (or for packed types, of the element), or 0 if the type isn't supported */
+static int view_type_size(int type) {
+	switch (type) {
+	case GL_INT_2_10_10_10_REV:
+	case GL_UNSIGNED_INT_2_10_10_10_REV:   return 4;
+	case GL_BYTE: case GL_UNSIGNED_BYTE:   return 1;
+	case GL_SHORT: case GL_UNSIGNED_SHORT: return 2;
+	case GL_HALF_FLOAT:                    return 2;
+	case GL_INT: case GL_UNSIGNED_INT:     return 4;
+	case GL_FLOAT:                         return 4;
+	case GL_DOUBLE:                        return 8;
+	default:                               return 0;
+	}
+}
+
+#define VIEW_IS_PACKED(type) ((type) == GL_INT_2_10_10_10_REV || (type) == GL_UNSIGNED_INT_2_10_10_10_REV)
+
+/* Bytes of one element */
+static size_t view_elem_size(int type, int components) {
+	return VIEW_IS_PACKED(type)? 4 : (size_t) components * view_type_size(type);
+}
+
+/* The integer that a normalized component 'c' maps to 1.0, or 0 for float types */
+static double view_norm_max(int type, int c) {
+	switch (type) {
+	case GL_BYTE:           return 127;
+	case GL_UNSIGNED_BYTE:  return 255;
+	case GL_SHORT:          return 32767;
+	case GL_UNSIGNED_SHORT: return 65535;
+	case GL_INT:            return 2147483647.0;
+	case GL_UNSIGNED_INT:   return 4294967295.0;
+	case GL_INT_2_10_10_10_REV:          return c < 3? 511 : 1;
+	case GL_UNSIGNED_INT_2_10_10_10_REV: return c < 3? 1023 : 3;
+	default:                return 0;
+	}
+}
+
+static double view_half_to_double(unsigned short h) {
+	unsigned int e= (h >> 10) & 0x1F, m= h & 0x3FF, x;
+	float f;
+	if (e == 0) {
+		f= m * (1.0f / 16777216);               /* subnormal, m * 2^-24 */
+		return (h & 0x8000)? -f : f;
+	}
+	/* rebias the exponent from 15 to 127, or keep inf/NaN */
+	x= ((unsigned int)(h & 0x8000) << 16) | ((e == 31? 255 : e + 112) << 23) | (m << 13);
+	memcpy(&f, &x, 4);
+	return f;
+}
+
+static unsigned short view_double_to_half(double d) {
+	float f= (float) d;
+	unsigned int x, sign, h, rem, half, m;
+	int shift;
+	memcpy(&x, &f, 4);
+	sign= (x >> 16) & 0x8000;
+	x &= 0x7FFFFFFF;
+	if (x >= 0x7F800000) return sign | 0x7C00 | (x > 0x7F800000? 0x200 : 0); /* inf, NaN */
+	if (x >= 0x477FF000) return sign | 0x7C00;  /* rounds up past 65504 */
+	if (x < 0x33000000) return sign;            /* rounds down to zero */
+	if (x < 0x38800000) {                       /* half subnormal */
+		m= (x & 0x7FFFFF) | 0x800000;
+		shift= 126 - (x >> 23);
+		h= m >> shift;
+		rem= m & ((1U << shift) - 1);
+		half= 1U << (shift - 1);
+	}
+	else {
+		h= (x - 0x38000000) >> 13;              /* rebias the exponent from 127 to 15 */
+		rem= x & 0x1FFF;
+		half= 0x1000;
+	}
+	if (rem > half || (rem == half && (h & 1))) h++;
+	return sign | h;
+}
+
+static double view_clamp_round(double v, double lo, double hi) {
+	if (!(v >= lo)) return lo; /* also catches NaN */
+	if (v >= hi) return hi;
+	return floor(v + .5);
+}
+
+static double view_load(int type, const char *p) {
+	union { signed char b; unsigned char ub; short s; unsigned short us; int i; unsigned int ui; float f; double d; } u;
+	memcpy(&u, p, view_type_size(type));
+	switch (type) {
+	case GL_BYTE:           return u.b;
+	case GL_UNSIGNED_BYTE:  return u.ub;
+	case GL_SHORT:          return u.s;
+	case GL_UNSIGNED_SHORT: return u.us;
+	case GL_HALF_FLOAT:     return view_half_to_double(u.us);
+	case GL_INT:            return u.i;
+	case GL_UNSIGNED_INT:   return u.ui;
+	case GL_FLOAT:          return u.f;
+	default:                return u.d;
+	}
+}
+
+static void view_store(int type, char *p, double v) {
+	union { signed char b; unsigned char ub; short s; unsigned short us; int i; unsigned int ui; float f; double d; } u;
+	switch (type) {
+	case GL_BYTE:           u.b=  (signed char) view_clamp_round(v, -128, 127); break;
+	case GL_UNSIGNED_BYTE:  u.ub= (unsigned char) view_clamp_round(v, 0, 255); break;
+	case GL_SHORT:          u.s=  (short) view_clamp_round(v, -32768, 32767); break;
+	case GL_UNSIGNED_SHORT: u.us= (unsigned short) view_clamp_round(v, 0, 65535); break;
+	case GL_HALF_FLOAT:     u.us= view_double_to_half(v); break;
+	case GL_INT:            u.i=  (int) view_clamp_round(v, -2147483648.0, 2147483647.0); break;
+	case GL_UNSIGNED_INT:   u.ui= (unsigned int) view_clamp_round(v, 0, 4294967295.0); break;
+	case GL_FLOAT:          u.f=  (float) v; break;
+	default:                u.d=  v; break;
+	}
+	memcpy(p, &u, view_type_size(type));
+}
+
+/* Number of bytes from the first byte of the first element to the end of the last */
+static size_t view_span(const struct view_layout *v) {
+	return v->count? (v->count - 1) * v->stride + view_elem_size(v->type, v->components) : 0;
+}
+
+/* x, y, z in bits 0..29 and w in bits 30..31, as signed or unsigned fields */
+static void view_unpack_2_10_10_10(int type, const char *p, double *out) {
+	unsigned int x;
+	int c, bits, f;
+	memcpy(&x, p, 4);
+	for (c= 0; c < 4; c++) {
+		bits= c < 3? 10 : 2;
+		f= (int) ((x >> (c * 10)) & ((1U << bits) - 1));
+		if (type == GL_INT_2_10_10_10_REV && f >= (1 << (bits-1))) f -= 1 << bits;
+		out[c]= f;
+	}
+}
+
+static void view_pack_2_10_10_10(int type, char *p, const double *in) {
+	unsigned int x= 0, bits, f;
+	double lo, hi;
+	int c;
+	for (c= 0; c < 4; c++) {
+		bits= c < 3? 10 : 2;
+		lo= type == GL_INT_2_10_10_10_REV? -(double)(1 << (bits-1)) : 0;
+		hi= type == GL_INT_2_10_10_10_REV? (1 << (bits-1)) - 1 : (1 << bits) - 1;
+		f= (unsigned int) (int) view_clamp_round(in[c], lo, hi);
+		x |= (f & ((1U << bits) - 1)) << (c * 10);
+	}
+	memcpy(p, &x, 4);
+}
+
+static void view_read(const struct view_layout *v, size_t i, double *out) {
+	const char *p= v->data + i * v->stride;
+	int c, size= view_type_size(v->type);
+	double max;
+	if (VIEW_IS_PACKED(v->type)) view_unpack_2_10_10_10(v->type, p, out);
+	else for (c= 0; c < v->components; c++)
+		out[c]= view_load(v->type, p + c * size);
+	if (v->normalized) {
+		for (c= 0; c < v->components; c++) {
+			if (!(max= view_norm_max(v->type, c))) break;
+			out[c] /= max;
+			if (out[c] < -1) out[c]= -1;
+		}
+	}
+}
+
+static void view_write(const struct view_layout *v, size_t i, const double *in) {
+	char *p= v->data + i * v->stride;
+	int c, size= view_type_size(v->type);
+	double tmp[VIEW_MAX_COMPONENTS], max;
+	if (v->normalized && view_norm_max(v->type, 0)) {
+		for (c= 0; c < v->components; c++) {
+			max= view_norm_max(v->type, c);
+			tmp[c]= (!(in[c] > -1)? -1 : in[c] > 1? 1 : in[c]) * max; /* clamp, and NaN becomes -1 */
+		}
+		in= tmp;
+	}
+	if (VIEW_IS_PACKED(v->type)) view_pack_2_10_10_10(v->type, p, in);
+	else for (c= 0; c < v->components; c++)
+		view_store(v->type, p + c * size, in[c]);
+}
+
+/* Set every element to the same value */
+static void view_fill(const struct view_layout *v, const double *value) {
+	char elem[VIEW_MAX_COMPONENTS * 8];
+	struct view_layout e= *v;
+	size_t i, size= view_elem_size(v->type, v->components);
+	/* Convert once, then copy the bytes */
+	e.data= elem;
+	view_write(&e, 0, value);
+	for (i= 0; i < v->count; i++)
+		memcpy(v->data + i * v->stride, elem, size);
+}
+
+/* v = v * factor + offset, per component */
+static void view_scale_add(const struct view_layout *v, const double *factor, const double *offset) {
+	double tmp[VIEW_MAX_COMPONENTS];
+	float f[VIEW_MAX_COMPONENTS], o[VIEW_MAX_COMPONENTS], x;
+	size_t i;
+	int c, n= v->components;
+	if (v->type == GL_FLOAT) {
+		for (c= 0; c < n; c++) f[c]= (float) factor[c], o[c]= (float) offset[c];
+		for (i= 0; i < v->count; i++) {
+			char *p= v->data + i * v->stride;
+			for (c= 0; c < n; c++) {
+				memcpy(&x, p + c*4, 4);
+				x= x * f[c] + o[c];
+				memcpy(p + c*4, &x, 4);
+			}
+		}
+		return;
+	}
+	for (i= 0; i < v->count; i++) {
+		view_read(v, i, tmp);
+		for (c= 0; c < n; c++) tmp[c]= tmp[c] * factor[c] + offset[c];
+		view_write(v, i, tmp);
+	}
+}
+
+/* True if the bytes of any element of one layout overlap an element of the other.  Layouts
+ * with the same stride, like two attributes of interleaved vertices, only overlap if their
+ * elements do within one stride.  For different strides this only compares the spans.
+ */
+static int view_overlaps(const struct view_layout *a, const struct view_layout *b) {
+	size_t a_len= view_span(a), b_len= view_span(b), d, a_size, b_size;
+	const struct view_layout *t;
+	if (!(a_len && b_len && a->data < b->data + b_len && b->data < a->data + a_len))
+		return 0;
+	if (a->stride != b->stride || !a->stride)
+		return 1;
+	if (b->data < a->data) t= a, a= b, b= t;
+	d= (size_t) (b->data - a->data) % a->stride;
+	a_size= view_elem_size(a->type, a->components);
+	b_size= view_elem_size(b->type, b->components);
+	/* b's elements start 'd' bytes into a's, and may run into a's next element */
+	return d < a_size || d + b_size > a->stride;
+}
+
+/* dst = dst * dst_factor + src * src_factor, for the first min(dst->count, src->count)
+ * elements.  The layouts must have the same number of components.  If they overlap, src is
+ * copied first, so the result is as if src had been read completely before writing; but
+ * layouts of the same elements need no copy, since each element only reads itself.
+ * Returns the number of elements processed, or -1 if a temporary buffer couldn't be allocated.
+ */
+static long view_combine(const struct view_layout *dst, double dst_factor, const struct view_layout *src, double src_factor) {
+	struct view_layout s= *src, d= *dst;
+	double a[VIEW_MAX_COMPONENTS], b[VIEW_MAX_COMPONENTS];
+	float fa, fb, fd= (float) dst_factor, fs= (float) src_factor;
+	char *copy= NULL;
+	size_t i, n= dst->count < src->count? dst->count : src->count;
+	int c;
+	s.count= d.count= n;
+	if (!(s.data == d.data && s.stride == d.stride) && view_overlaps(&d, &s)) {
+		if (!(copy= (char*) malloc(view_span(&s)))) return -1;
+		memcpy(copy, s.data, view_span(&s));
+		s.data= copy;
+	}
+	if (dst->type == GL_FLOAT && s.type == GL_FLOAT) {
+		for (i= 0; i < n; i++) {
+			char *dp= dst->data + i * dst->stride, *sp= s.data + i * s.stride;
+			for (c= 0; c < dst->components; c++) {
+				memcpy(&fa, dp + c*4, 4);
+				memcpy(&fb, sp + c*4, 4);
+				fa= dst_factor? fa * fd + fb * fs : fb * fs;
+				memcpy(dp + c*4, &fa, 4);
+			}
+		}
+	}
+	else {
+		for (i= 0; i < n; i++) {
+			view_read(&s, i, b);
+			if (dst_factor) {
+				view_read(dst, i, a);
+				for (c= 0; c < dst->components; c++) a[c]= a[c] * dst_factor + b[c] * src_factor;
+			}
+			else
+				for (c= 0; c < dst->components; c++) a[c]= b[c] * src_factor;
+			view_write(dst, i, a);
+		}
+	}
+	free(copy);
+	return (long) n;
+}
+
+/* Octahedral encoding of unit vectors into 2 components in -1..1, which keeps their precision
+ * even when stored in small normalized integers.  The vector is projected onto the octahedron
+ * |x|+|y|+|z| = 1, and the lower half is folded out over the corners of the upper half.
+ */
+static void view_oct_encode_vec(const double *n, double *e) {
+	double len= fabs(n[0]) + fabs(n[1]) + fabs(n[2]),
+		x= len > 0? n[0] / len : 0,
+		y= len > 0? n[1] / len : 0;
+	if (n[2] < 0) {
+		e[0]= (1 - fabs(y)) * (x >= 0? 1 : -1);
+		e[1]= (1 - fabs(x)) * (y >= 0? 1 : -1);
+	}
+	else e[0]= x, e[1]= y;
+}
+
+/* Decode into a unit vector of 3 components, and w= 0 */
+static void view_oct_decode_vec(const double *e, double *n) {
+	double t, len;
+	n[0]= e[0];
+	n[1]= e[1];
+	n[2]= 1 - fabs(e[0]) - fabs(e[1]);
+	t= n[2] < 0? -n[2] : 0;
+	n[0] += n[0] >= 0? -t : t;
+	n[1] += n[1] >= 0? -t : t;
+	len= sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+	if (len > 0) n[0] /= len, n[1] /= len, n[2] /= len;
+	n[3]= 0;
+}
+
+/* Encode the first min(dst->count, src->count) vectors of src into dst, or decode them.
+ * Each element is read before it is written, so the views may be the same elements.
+ */
+static void view_oct_encode(const struct view_layout *dst, const struct view_layout *src) {
+	double n[VIEW_MAX_COMPONENTS], e[2];
+	size_t i, count= dst->count < src->count? dst->count : src->count;
+	for (i= 0; i < count; i++) {
+		view_read(src, i, n);
+		view_oct_encode_vec(n, e);
+		view_write(dst, i, e);
+	}
+}
+
+static void view_oct_decode(const struct view_layout *dst, const struct view_layout *src) {
+	double e[VIEW_MAX_COMPONENTS], n[4];
+	size_t i, count= dst->count < src->count? dst->count : src->count;
+	for (i= 0; i < count; i++) {
+		view_read(src, i, e);
+		view_oct_decode_vec(e, n);
+		view_write(dst, i, n);
+	}
+}
+
+/* Copying several attributes at once, between separate arrays and interleaved vertices.
+ * Element i of each src is copied to element i of its dst, vertex by vertex, so that the
+ * interleaved side is written (or read) in order.  A pair with the same format is copied
+ * as bytes; otherwise it is converted through view_read and view_write.
+ */
+#define VIEW_MAX_STREAMS 16
+
+struct view_stream {
+	struct view_layout dst, src;
+};
+
+/* True if elements of 'src' can be copied into 'dst' as bytes */
+static int view_same_format(const struct view_layout *dst, const struct view_layout *src) {
+	return dst->type == src->type && dst->components == src->components
+		&& (dst->normalized == src->normalized || !view_norm_max(dst->type, 0));
+}
+
+/* Copy elements first..first+count-1 of each of the 'n' streams */
+static void view_copy_streams(const struct view_stream *streams, int n, size_t first, size_t count) {
+	size_t i, size[VIEW_MAX_STREAMS];
+	double v[VIEW_MAX_COMPONENTS];
+	const struct view_stream *s;
+	int k;
+	for (k= 0; k < n; k++)
+		size[k]= view_same_format(&streams[k].dst, &streams[k].src)
+			? view_elem_size(streams[k].dst.type, streams[k].dst.components) : 0;
+	for (i= first; i < first + count; i++) {
+		for (k= 0, s= streams; k < n; k++, s++) {
+			char *d= s->dst.data + i * s->dst.stride;
+			const char *p= s->src.data + i * s->src.stride;
+			/* constant sizes let the compiler inline the common cases */
+			switch (size[k]) {
+			case 0:  view_read(&s->src, i, v); view_write(&s->dst, i, v); break;
+			case 4:  memcpy(d, p, 4); break;
+			case 8:  memcpy(d, p, 8); break;
+			case 12: memcpy(d, p, 12); break;
+			case 16: memcpy(d, p, 16); break;
+			default: memcpy(d, p, size[k]);
+			}
+		}
+	}
+}
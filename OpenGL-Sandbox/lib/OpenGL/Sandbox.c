@@ -14,6 +14,7 @@ int _gl_get_integer(int id) {
 void gen_textures(int count) {
 	Inline_Stack_Vars;
 	GLuint static_buf[16], *buf, i;
+	GL_PROFILE_BEGIN("gen_textures");
 	(void)items; /* squelch warning */
 
 	if (count < sizeof(static_buf)/sizeof(GLuint))
@@ -28,6 +29,7 @@ void gen_textures(int count) {
 	for (i= 0; i < count; i++)
 		Inline_Stack_Push(newSViv(buf[i]));
 	Inline_Stack_Done;
+	GL_PROFILE_END();
 	Inline_Stack_Return(count);
 }
 
@@ -35,6 +37,7 @@ void delete_textures(SV *first, ...) {
 	Inline_Stack_Vars;
 	GLuint static_buf[16], *buf;
 	int dest_i, i, n= sizeof(static_buf)/sizeof(GLuint);
+	GL_PROFILE_BEGIN("delete_textures");
 	buf= static_buf;
 	
 	/* first pass, try static buffer */
@@ -50,6 +53,7 @@ void delete_textures(SV *first, ...) {
 	}
 
 	glDeleteTextures(n, buf);
+	GL_PROFILE_END();
 	Inline_Stack_Void;
 }
 
@@ -58,6 +62,7 @@ void delete_textures(SV *first, ...) {
 void gen_buffers(int count) {
 	Inline_Stack_Vars;
 	GLuint static_buf[16], *buf, i;
+	GL_PROFILE_BEGIN("gen_buffers");
 	(void)items; /* suppress warning */
 
 	if (count < sizeof(static_buf)/sizeof(GLuint))
@@ -72,6 +77,7 @@ void gen_buffers(int count) {
 	for (i= 0; i < count; i++)
 		Inline_Stack_Push(newSViv(buf[i]));
 	Inline_Stack_Done;
+	GL_PROFILE_END();
 	Inline_Stack_Return(count);
 }
 
@@ -79,6 +85,7 @@ void delete_buffers(unsigned buf_id) {
 	Inline_Stack_Vars;
 	GLuint static_buf[16], *buf;
 	int dest_i, i, n= sizeof(static_buf)/sizeof(GLuint);
+	GL_PROFILE_BEGIN("delete_buffers");
 	buf= static_buf;
 	/* first pass, try static buffer */
 	for (i= 0, dest_i= 0; i < Inline_Stack_Items; i++)
@@ -93,6 +100,7 @@ void delete_buffers(unsigned buf_id) {
 	}
 
 	glDeleteBuffers(n, buf);
+	GL_PROFILE_END();
 	Inline_Stack_Void;
 }
 
@@ -102,6 +110,7 @@ void delete_buffers(unsigned buf_id) {
 void gen_vertex_arrays(int count) {
 	Inline_Stack_Vars;
 	GLuint static_buf[16], *buf, i;
+	GL_PROFILE_BEGIN("gen_vertex_arrays");
 	(void)items; /* suppress warning */
 
 	if (count < sizeof(static_buf)/sizeof(GLuint))
@@ -116,6 +125,7 @@ void gen_vertex_arrays(int count) {
 	for (i= 0; i < count; i++)
 		Inline_Stack_Push(newSViv(buf[i]));
 	Inline_Stack_Done;
+	GL_PROFILE_END();
 	Inline_Stack_Return(count);
 }
 
@@ -123,6 +133,7 @@ void delete_vertex_arrays(unsigned buf_id) {
 	Inline_Stack_Vars;
 	GLuint static_buf[16], *buf;
 	int dest_i, i, n= sizeof(static_buf)/sizeof(GLuint);
+	GL_PROFILE_BEGIN("delete_vertex_arrays");
 	buf= static_buf;
 	/* first pass, try static buffer */
 	for (i= 0, dest_i= 0; i < Inline_Stack_Items; i++)
@@ -137,9 +148,96 @@ void delete_vertex_arrays(unsigned buf_id) {
 	}
 
 	glDeleteVertexArrays(n, buf);
+	GL_PROFILE_END();
 	Inline_Stack_Void;
 }
 #endif
+#ifdef GL_VERSION_1_5
+
+void gen_queries(int count) {
+	Inline_Stack_Vars;
+	GLuint static_buf[16], *buf, i;
+	GL_PROFILE_BEGIN("gen_queries");
+	(void)items; /* suppress warning */
+
+	if (count < sizeof(static_buf)/sizeof(GLuint))
+		buf= static_buf;
+	else {
+		Newx(buf, count, GLuint);
+		SAVEFREEPV(buf); /* perl frees it for us */
+	}
+	glGenQueries(count, buf);
+	EXTEND(SP, count);
+	Inline_Stack_Reset;
+	for (i= 0; i < count; i++)
+		Inline_Stack_Push(newSViv(buf[i]));
+	Inline_Stack_Done;
+	GL_PROFILE_END();
+	Inline_Stack_Return(count);
+}
+
+void delete_queries(unsigned query_id) {
+	Inline_Stack_Vars;
+	GLuint static_buf[16], *buf;
+	int dest_i, i, n= sizeof(static_buf)/sizeof(GLuint);
+	GL_PROFILE_BEGIN("delete_queries");
+	buf= static_buf;
+	/* first pass, try static buffer */
+	for (i= 0, dest_i= 0; i < Inline_Stack_Items; i++)
+		_recursive_pack(buf, &dest_i, n, GL_UNSIGNED_INT, Inline_Stack_Item(i));
+	n= dest_i;
+	/* If too many, second pass with dynamic buffer */
+	if (n > sizeof(static_buf)/sizeof(GLuint)) {
+		Newx(buf, n, GLuint);
+		SAVEFREEPV(buf); /* perl frees it for us */
+		for (i= 0, dest_i= 0; i < Inline_Stack_Items; i++)
+			_recursive_pack(buf, &dest_i, n, GL_UNSIGNED_INT, Inline_Stack_Item(i));
+	}
+
+	glDeleteQueries(n, buf);
+	GL_PROFILE_END();
+	Inline_Stack_Void;
+}
+#endif
+#ifdef GL_VERSION_3_3
+
+/* Record the GPU time at which all previous commands have completed, into a query object */
+void query_timestamp(unsigned query_id) {
+	glQueryCounter(query_id, GL_TIMESTAMP);
+}
+
+/* Return the nanosecond results of a list of queries, or an empty list if the last one isn't
+ * available yet.  Queries complete in order, so that means all of them are.  This never waits
+ * for the GPU.
+ */
+void get_query_results(unsigned query_id) {
+	Inline_Stack_Vars;
+	GLint avail= 0;
+	GLuint64 result;
+	int i, n= Inline_Stack_Items;
+	GL_PROFILE_BEGIN("get_query_results");
+	if (n)
+		glGetQueryObjectiv(SvUV(Inline_Stack_Item(n-1)), GL_QUERY_RESULT_AVAILABLE, &avail);
+	if (!avail) {
+		GL_PROFILE_END();
+		Inline_Stack_Void;
+	}
+	/* replace each argument on the stack with its result */
+	for (i= 0; i < n; i++) {
+		glGetQueryObjectui64v(SvUV(Inline_Stack_Item(i)), GL_QUERY_RESULT, &result);
+		Inline_Stack_Item(i)= sv_2mortal(_newSVu64(result));
+	}
+	GL_PROFILE_END();
+	Inline_Stack_Return(n);
+}
+
+/* The GPU's current time, in nanoseconds, for relating query results to the CPU clock */
+SV* gl_timestamp() {
+	GLint64 now= 0;
+	glGetInteger64v(GL_TIMESTAMP, &now);
+	return _newSVu64((unsigned long long) now);
+}
+#endif
 
 /* This assumes it is being called as a method on a Texture object.
  * Anything specific to the current option is passed as a parameter; anything about the
@@ -161,6 +259,7 @@ void _texture_load(HV *self, int level, int xoffset, int yoffset, int width, int
 	SV *mag_filter_p= _fetch_if_defined(self, "mag_filter", 10);
 	SV *internal_p= _fetch_if_defined(self, "internal_format", 15);
 	SV *target_p= _fetch_if_defined(self, "target", 6);
+	GL_PROFILE_BEGIN("_texture_load");
 	
 	/* Mipmap strategy depends on version of GL.
 	   Supposedly this GetString is more compatible than GetInteger(GL_VERSION_MAJOR)
@@ -244,6 +343,7 @@ void _texture_load(HV *self, int level, int xoffset, int yoffset, int width, int
 			glPixelStorei(GL_UNPACK_ROW_LENGTH, orig_row_len);
 			glPixelStorei(GL_UNPACK_ALIGNMENT, orig_pix_align);
 		}
+		GL_PROFILE_END();
 		return;
 	}
 	/* Else we are defining the storage for the texture and more things need considered.
@@ -314,6 +414,7 @@ void _texture_load(HV *self, int level, int xoffset, int yoffset, int width, int
 		if (sv) sv_2mortal(sv);
 		croak("Can't store results in supplied hash");
 	}
+	GL_PROFILE_END();
 	return;
 }
 
@@ -367,22 +468,398 @@ const char * gl_error_name(int code) {
 	}
 }
 
+/* Tables of GL function pointers, one per context (see inc/glducktape.pl) */
+
+SV* _gl_dispatch_new() {
+	struct gl_context_state *state;
+	Newxz(state, 1, struct gl_context_state);
+	glducktape_init(&state->table);
+	return sv_setref_pv(newSV(0), "OpenGL::Sandbox::GLDispatch", state);
+}
+
+/* Look up all functions for the current context, returning the names of any that are missing */
+void _gl_dispatch_resolve(SV *self) {
+	Inline_Stack_Vars;
+	struct glducktape_dispatch *table= _get_gl_dispatch(self);
+	int major, minor, i, n;
+	AV *missing;
+	(void)items; /* squelch warning */
+
+	if (!_gl_context_version(&major, &minor)) carp_croak("No current GL context");
+	missing= (AV*) sv_2mortal((SV*) newAV());
+	n= glducktape_resolve(table, major, minor, _gl_dispatch_push_missing, missing);
+	Inline_Stack_Reset;
+	for (i= 0; i < n; i++)
+		Inline_Stack_Push(*av_fetch(missing, i, 0));
+	Inline_Stack_Done;
+}
+
+/* Route GL calls through this table, or through the default lazy-loading table if undef */
+void _gl_dispatch_use(SV *self) {
+	gl_current_state= SvOK(self)? _get_gl_context_state(self) : &gl_default_state;
+	glducktape_use(SvOK(self)? &gl_current_state->table : NULL);
+}
+
+void _gl_dispatch_free(SV *self) {
+	struct gl_context_state *state= _get_gl_context_state(self);
+	if (gl_current_state == state) {
+		gl_current_state= &gl_default_state;
+		glducktape_use(NULL);
+	}
+	Safefree(state);
+}
+
+/* Profiling of GL calls (see inc/glducktape.pl) */
+
+void gl_profile_enable() {
+	glducktape_profile(1);
+}
+
+void gl_profile_disable() {
+	glducktape_profile(0);
+}
+
+void gl_profile_reset() {
+	glducktape_profile_reset();
+}
+
+SV* gl_profile_snapshot() {
+	HV *result= (HV*) sv_2mortal((SV*) newHV()), *functions= newHV(), *wrappers= newHV(), *wrapper;
+	struct glducktape_scope *scope;
+	int i;
+	if (!hv_stores(result, "enabled", newSViv(glducktape_profiling))
+	 || !hv_stores(result, "functions", newRV_noinc((SV*) functions))
+	 || !hv_stores(result, "wrappers", newRV_noinc((SV*) wrappers)))
+		croak("hv_store failed");
+	for (i= 0; i < glducktape_fn_count; i++)
+		if (glducktape_stats[i].calls)
+			if (!hv_store(functions, glducktape_names[i], strlen(glducktape_names[i]), _gl_profile_stat(glducktape_stats + i), 0))
+				croak("hv_store failed");
+	for (scope= glducktape_scopes; scope; scope= scope->next) {
+		if (!scope->total.calls) continue;
+		wrapper= newHV();
+		if (!hv_store(wrappers, scope->name, strlen(scope->name), newRV_noinc((SV*) wrapper), 0)
+		 || !hv_stores(wrapper, "calls", newSVuv(scope->total.calls))
+		 || !hv_stores(wrapper, "seconds", newSVnv(scope->total.ns * 1e-9))
+		 || !hv_stores(wrapper, "gl_calls", newSVuv(scope->gl.calls))
+		 || !hv_stores(wrapper, "gl_seconds", newSVnv(scope->gl.ns * 1e-9)))
+			croak("hv_store failed");
+	}
+	return newRV_inc((SV*) result);
+}
+
+/* Capture of GL calls to a trace file, for inc/glducktape-replay.c */
+
+void gl_capture_start(const char *path) {
+	if (!glducktape_capture_start(path))
+		carp_croak("Can't write %s: %s", path, strerror(errno));
+}
+
+void gl_capture_frame() {
+	glducktape_capture_frame();
+}
+
+void gl_capture_stop() {
+	if (!glducktape_capture_stop())
+		carp_croak("Error while writing GL capture file");
+}
+
+int gl_capturing() {
+	return glducktape_capturing;
+}
+
+/* Asynchronous error reporting with KHR_debug (see Sandbox-util.c) */
+
+#ifdef GL_VERSION_4_3
+/* Returns false if the context doesn't support KHR_debug.  Messages below min_severity
+ * (0=notification, 1=low, 2=medium, 3=high) or from sources not in source_mask (bits in the
+ * order api, window_system, shader_compiler, third_party, application, other) are disabled
+ * in the driver, so they never reach the callback.
+ */
+int _gl_debug_enable(int min_severity, int source_mask, int synchronous) {
+	static const GLenum severities[]= { GL_DEBUG_SEVERITY_NOTIFICATION, GL_DEBUG_SEVERITY_LOW,
+		GL_DEBUG_SEVERITY_MEDIUM, GL_DEBUG_SEVERITY_HIGH };
+	static const GLenum sources[]= { GL_DEBUG_SOURCE_API, GL_DEBUG_SOURCE_WINDOW_SYSTEM,
+		GL_DEBUG_SOURCE_SHADER_COMPILER, GL_DEBUG_SOURCE_THIRD_PARTY, GL_DEBUG_SOURCE_APPLICATION,
+		GL_DEBUG_SOURCE_OTHER };
+	int major, minor, i;
+	if (!_gl_context_version(&major, &minor)) carp_croak("No current GL context");
+	if (major * 10 + minor < 43 && !_gl_has_extension("GL_KHR_debug"))
+		return 0;
+	glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_TRUE);
+	for (i= 0; i < min_severity && i < 4; i++)
+		glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, severities[i], 0, NULL, GL_FALSE);
+	for (i= 0; i < 6; i++)
+		if (!(source_mask & (1 << i)))
+			glDebugMessageControl(sources[i], GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_FALSE);
+	glDebugMessageCallback(_gl_debug_callback, NULL);
+	if (synchronous) glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	else glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+	glEnable(GL_DEBUG_OUTPUT);
+	gl_current_state->debug_on= 1;
+	return 1;
+}
+
+void _gl_debug_disable() {
+	int i;
+	if (!gl_current_state->debug_on) return;
+	glDisable(GL_DEBUG_OUTPUT);
+	glDebugMessageCallback(NULL, NULL);
+	gl_current_state->debug_on= 0;
+	/* glGetError wasn't being called, so clear out whatever piled up */
+	for (i= 0; i < 100 && glGetError() != GL_NO_ERROR; i++);
+}
+
+/* Remove all collected messages, returning them as hashrefs followed by the number of
+ * messages that were dropped because the ring was full.
+ */
+void _gl_debug_drain() {
+	Inline_Stack_Vars;
+	struct gl_debug_msg m;
+	unsigned dropped;
+	HV *hv;
+	(void)items; /* squelch warning */
+
+	Inline_Stack_Reset;
+	for (;;) {
+		GL_DEBUG_LOCK();
+		if (gl_debug_tail == gl_debug_head) {
+			dropped= gl_debug_dropped;
+			gl_debug_dropped= 0;
+			GL_DEBUG_UNLOCK();
+			break;
+		}
+		m= gl_debug_ring[gl_debug_tail++ % GL_DEBUG_RING_SIZE];
+		GL_DEBUG_UNLOCK();
+		hv= newHV();
+		Inline_Stack_Push(sv_2mortal(newRV_noinc((SV*) hv)));
+		if (!hv_stores(hv, "source", newSVpv(_gl_debug_source_name(m.source), 0))
+		 || !hv_stores(hv, "type", newSVpv(_gl_debug_type_name(m.type), 0))
+		 || !hv_stores(hv, "severity", newSVpv(_gl_debug_severity_name(m.severity), 0))
+		 || !hv_stores(hv, "id", newSVuv(m.id))
+		 || !hv_stores(hv, "message", newSVpv(m.text, 0)))
+			croak("hv_store failed");
+	}
+	Inline_Stack_Push(sv_2mortal(newSVuv(dropped)));
+	Inline_Stack_Done;
+}
+#endif
+
+int gl_debug_active() {
+	return gl_current_state->debug_on;
+}
+
+/* Contexts without a display, for ContextShim::EGL and ContextShim::OSMesa (see Sandbox-headless.c) */
+
+SV* _headless_context_new(const char *api, int width, int height, SV *gl_version, const char *profile, int debug, SV *platform) {
+	struct headless_opts opts;
+	struct headless_context *hc;
+	int api_id= !strcmp(api, "EGL")? HEADLESS_EGL : !strcmp(api, "OSMesa")? HEADLESS_OSMESA : 0;
+	if (!api_id) carp_croak("Unknown headless API '%s'", api);
+	opts.width= width;
+	opts.height= height;
+	opts.major= opts.minor= 0;
+	if (SvOK(gl_version) && sscanf(SvPV_nolen(gl_version), "%d.%d", &opts.major, &opts.minor) < 1)
+		carp_croak("Invalid gl_version '%s'", SvPV_nolen(gl_version));
+	opts.profile= !*profile? 0 : !strcmp(profile, "core")? 1 : !strcmp(profile, "compat")? 2 : -1;
+	if (opts.profile < 0) carp_croak("Unknown GL profile '%s'", profile);
+	opts.debug= debug;
+	opts.platform= SvOK(platform)? SvPV_nolen(platform) : NULL;
+	if (width <= 0 || height <= 0) carp_croak("Invalid size %dx%d", width, height);
+	Newxz(hc, 1, struct headless_context);
+	if (!headless_create(hc, api_id, &opts)) {
+		Safefree(hc);
+		carp_croak("%s", headless_error);
+	}
+	return sv_setref_pv(newSV(0), "OpenGL::Sandbox::HeadlessContext", hc);
+}
+
+void _headless_context_make_current(SV *self) {
+	if (!headless_make_current(_get_headless_context(self)))
+		carp_croak("Can't make headless context current");
+}
+
+SV* _headless_context_info(SV *self) {
+	return newSVpv(_get_headless_context(self)->info, 0);
+}
+
+void _headless_context_free(SV *self) {
+	struct headless_context *hc= _get_headless_context(self);
+	headless_destroy(hc);
+	Safefree(hc);
+}
+
+/* Writing frames to disk on a worker thread, for OpenGL::Sandbox::FrameWriter (see Sandbox-capture.c) */
+
+SV* _frame_writer_new(const char *path, const char *format, int width, int height, double fps, int queue_len, int block, int flip) {
+	struct frame_writer_opts opts;
+	struct frame_writer *fw;
+	opts.format= !strcmp(format, "raw")? FRAME_RAW : !strcmp(format, "y4m")? FRAME_Y4M
+		: !strcmp(format, "png")? FRAME_PNG : 0;
+	if (!opts.format) carp_croak("Unknown frame format '%s'", format);
+	if (!(fps > 0 && fps < 1000000)) carp_croak("Invalid fps %g", fps);
+	/* Y4M wants a ratio; 29.97 becomes 30000:1001 */
+	opts.fps_den= fps == (int) fps? 1 : 1001;
+	opts.fps_num= (int) (fps * opts.fps_den + .5);
+	opts.width= width;
+	opts.height= height;
+	opts.queue_len= queue_len;
+	opts.block= block;
+	opts.flip= flip;
+	Newxz(fw, 1, struct frame_writer);
+	if (!frame_writer_open(fw, path, &opts)) {
+		Safefree(fw);
+		carp_croak("%s", frame_writer_error);
+	}
+	return sv_setref_pv(newSV(0), "OpenGL::Sandbox::FrameWriter::C", fw);
+}
+
+/* Queue a frame.  Returns false if it was dropped because the queue was full. */
+int _frame_writer_push(SV *self, SV *pixels) {
+	struct frame_writer *fw= _get_frame_writer(self);
+	char *data;
+	unsigned long size;
+	int ret;
+	if (!fw->running) {
+		/* report the original failure again, if there was one */
+		if (!frame_writer_close(fw)) carp_croak("%s", frame_writer_error);
+		carp_croak("Frame writer is closed");
+	}
+	_get_buffer_from_sv(pixels, &data, &size);
+	if (size != fw->frame_size)
+		carp_croak("Frame is %lu bytes, but %dx%d RGBA is %lu", size, fw->opts.width, fw->opts.height, (unsigned long) fw->frame_size);
+	if ((ret= frame_writer_push(fw, data)) < 0) {
+		frame_writer_close(fw);
+		carp_croak("%s", frame_writer_error);
+	}
+	return ret;
+}
+
+/* Returns (frames_written, frames_dropped, frames_queued) */
+void _frame_writer_stats(SV *self) {
+	Inline_Stack_Vars;
+	struct frame_writer *fw= _get_frame_writer(self);
+	unsigned long long written, dropped;
+	int queued;
+	(void)items; /* squelch warning */
+	if (fw->running) FW_LOCK(fw);
+	written= fw->written, dropped= fw->dropped, queued= fw->count;
+	if (fw->running) FW_UNLOCK(fw);
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(_newSVu64(written)));
+	Inline_Stack_Push(sv_2mortal(_newSVu64(dropped)));
+	Inline_Stack_Push(sv_2mortal(newSViv(queued)));
+	Inline_Stack_Done;
+	Inline_Stack_Return(3);
+}
+
+void _frame_writer_close(SV *self) {
+	struct frame_writer *fw= _get_frame_writer(self);
+	if (!frame_writer_close(fw))
+		carp_croak("%s", frame_writer_error);
+}
+
+void _frame_writer_free(SV *self) {
+	struct frame_writer *fw= _get_frame_writer(self);
+	frame_writer_close(fw);
+	Safefree(fw);
+}
+
+/* Matrix math for OpenGL::Sandbox::Mat4.  These all operate on the object in place. */
+
+void _mat4_identity(SV *m) {
+	mat4_identity(_get_mat4_from_sv(m));
+}
+
+void _mat4_translate(SV *m, double x, double y, double z) {
+	mat4_translate(_get_mat4_from_sv(m), x, y, z);
+}
+
+void _mat4_scale(SV *m, double x, double y, double z) {
+	mat4_scale(_get_mat4_from_sv(m), x, y, z);
+}
+
+void _mat4_rotate(SV *m, double degrees, double x, double y, double z) {
+	mat4_rotate(_get_mat4_from_sv(m), degrees, x, y, z);
+}
+
+void _mat4_mul(SV *dest, SV *a, SV *b) {
+	float *a_p= _get_mat4_from_sv(a), *b_p= _get_mat4_from_sv(b);
+	mat4_mul(_get_mat4_from_sv(dest), a_p, b_p);
+}
+
+void _mat4_transpose(SV *m) {
+	mat4_transpose(_get_mat4_from_sv(m));
+}
+
+int _mat4_invert(SV *m) {
+	float *m_p= _get_mat4_from_sv(m);
+	return mat4_invert(m_p, m_p);
+}
+
+void _mat4_ortho(SV *m, double l, double r, double b, double t, double n, double f) {
+	mat4_ortho(_get_mat4_from_sv(m), l, r, b, t, n, f);
+}
+
+void _mat4_frustum(SV *m, double l, double r, double b, double t, double n, double f) {
+	mat4_frustum(_get_mat4_from_sv(m), l, r, b, t, n, f);
+}
+
+void _mat4_perspective(SV *m, double fovy, double aspect, double n, double f) {
+	mat4_perspective(_get_mat4_from_sv(m), fovy, aspect, n, f);
+}
+
+void _mat4_look_at(SV *m, double eye_x, double eye_y, double eye_z, double ctr_x, double ctr_y, double ctr_z, double up_x, double up_y, double up_z) {
+	double eye[3]= { eye_x, eye_y, eye_z }, ctr[3]= { ctr_x, ctr_y, ctr_z }, up[3]= { up_x, up_y, up_z };
+	mat4_look_at(_get_mat4_from_sv(m), eye, ctr, up);
+}
+
+SV* _mat4_transform_points(SV *m, SV *points, int in_n, int out_n) {
+	float *m_p= _get_mat4_from_sv(m);
+	char *src;
+	unsigned long src_size, count;
+	SV *ret;
+	if (in_n < 2 || in_n > 4 || out_n < 1 || out_n > 4)
+		carp_croak("Point components must be 2..4 (input) and 1..4 (output)");
+	_get_buffer_from_sv(points, &src, &src_size);
+	count= src_size / (in_n * sizeof(float));
+	if (count * in_n * sizeof(float) != src_size)
+		carp_croak("Buffer length %ld is not a multiple of %d floats", src_size, in_n);
+	ret= newSV(count * out_n * sizeof(float) + 1);
+	SvPOK_on(ret);
+	SvCUR_set(ret, count * out_n * sizeof(float));
+	mat4_transform_points(m_p, (float*) src, in_n, (float*) SvPVX(ret), out_n, count);
+	SvPVX(ret)[SvCUR(ret)]= '\0';
+	return ret;
+}
+
 /* Wrappers for various shader-related functions, requiring at least GL 2.0 */
 #ifdef GL_VERSION_2_0
 
+void bind_buffer(int target, unsigned buffer_id) {
+	glBindBuffer(target, buffer_id);
+}
+
 void load_buffer_data(int target, SV *size_sv, SV *data_sv, SV *usage_sv) {
 	int usage= usage_sv && SvOK(usage_sv)? SvIV(usage_sv) : GL_STATIC_DRAW;
 	unsigned long size, data_size= 0;
 	char *data= NULL;
-	_get_buffer_from_sv(data_sv, &data, &data_size);
+	GL_PROFILE_BEGIN("load_buffer_data");
+	/* undef data with a size allocates the buffer without initializing it */
+	if (data_sv && !SvOK(data_sv) && size_sv && SvOK(size_sv))
+		data_size= SvUV(size_sv);
+	else
+		_get_buffer_from_sv(data_sv, &data, &data_size);
 	size= (size_sv && SvOK(size_sv))? SvUV(size_sv) : data_size;
 	if (data_size < size) carp_croak("Data not long enough (%d bytes, you requested %d)", (int) data_size, (int) size);
 	glBufferData(target, size, data, usage);
+	GL_PROFILE_END();
 }
 
 void load_buffer_sub_data(int target, long offset, SV *size_sv, SV *data_sv, SV *data_offset_sv) {
 	unsigned long size, data_size= 0, data_offset;
 	char *data= NULL;
+	GL_PROFILE_BEGIN("load_buffer_sub_data");
 	_get_buffer_from_sv(data_sv, &data, &data_size);
 	if (data_offset_sv && SvOK(data_offset_sv)) {
 		data_offset= SvUV(data_offset_sv);
@@ -393,6 +870,7 @@ void load_buffer_sub_data(int target, long offset, SV *size_sv, SV *data_sv, SV
 	size= (size_sv && SvOK(size_sv))? SvUV(size_sv) : data_size;
 	if (data_size < size) carp_croak("Data not long enough (%d bytes, you requested %d)", (int) data_size, (int) size);
 	glBufferSubData(target, offset, size, data);
+	GL_PROFILE_END();
 }
 
 SV *mmap_buffer(int buffer_id, SV *target_sv, SV *access_sv, SV *offset_sv, SV *length_sv) {
@@ -404,6 +882,7 @@ SV *mmap_buffer(int buffer_id, SV *target_sv, SV *access_sv, SV *offset_sv, SV *
 	const char* access_pv;
 	void *addr;
 	SV *sv;
+	GL_PROFILE_BEGIN("mmap_buffer");
 
 	/* OpenGL 2.0 only has MapBuffer, 3.0 has MapBufferRange (needed for access flags)
 	 * and OpenGL 4.5 has MapNamedBufferRange needed to avoid binding the buffer first
@@ -503,11 +982,15 @@ SV *mmap_buffer(int buffer_id, SV *target_sv, SV *access_sv, SV *offset_sv, SV *
 	sv= sv_2mortal(newRV_noinc((SV*)newSV(0)));
 	sv_bless(sv, gv_stashpv("OpenGL::Sandbox::MMap", GV_ADD));
 	buffer_scalar_wrap(SvRV(sv), addr, length, access_w? 0 : BUFFER_SCALAR_READONLY, NULL, NULL);
+	GL_PROFILE_END();
 	return SvREFCNT_inc(sv);
 }
 
 int unmap_buffer(int buffer_id, SV *target_sv, SV *memmap) {
 	int gl_maj= 0, gl_min= 0, target;
+	GL_PROFILE_BEGIN("unmap_buffer");
+	/* no ThreadPool job may still be writing to the mapping */
+	work_pool_wait_all();
 	if (sv_isa(memmap, "OpenGL::Sandbox::MMap")) {
 		buffer_scalar_unwrap(SvRV(memmap));
 		sv_setsv(memmap, &PL_sv_undef);
@@ -519,6 +1002,7 @@ int unmap_buffer(int buffer_id, SV *target_sv, SV *memmap) {
 		glGetIntegerv(GL_MINOR_VERSION, &gl_min);
 		if (gl_min >= 5) {
 			glUnmapNamedBuffer(buffer_id);
+			GL_PROFILE_END();
 			return 1;
 		}
 	}
@@ -529,9 +1013,692 @@ int unmap_buffer(int buffer_id, SV *target_sv, SV *memmap) {
 		carp_croak("Must specify buffer target for OpenGL < 4.5");
 	glBindBuffer(target, buffer_id);
 	glUnmapBuffer(target);
+	GL_PROFILE_END();
 	return 1;
 }
 
+/* Return an OpenGL::Sandbox::MMap of a sub-range of another, without copying.  Offset and
+ * length work like substr, except that the range must be inside the buffer.
+ */
+SV* _mmap_slice(SV *mmap, IV offset, SV *length_sv) {
+	struct buffer_scalar_info *info;
+	SV *parent, *sv;
+	IV len, length;
+	if (!SvROK(mmap) || SvTYPE(SvRV(mmap)) > SVt_PVMG)
+		carp_croak("Expected OpenGL::Sandbox::MMap or scalar ref");
+	parent= SvRV(mmap);
+	info= get_sv_magic(parent);
+	len= info? info->length : SvPOK(parent)? SvCUR(parent) : 0;
+	if (offset < 0) offset += len;
+	length= SvOK(length_sv)? SvIV(length_sv) : len - offset;
+	if (length < 0) length += len - offset;
+	if (offset < 0 || length < 0 || offset + length > len)
+		carp_croak("Slice (%ld, %ld) is outside the buffer of %ld bytes", (long) offset, (long) length, (long) len);
+	sv= sv_2mortal(newRV_noinc(newSV(0)));
+	sv_bless(sv, gv_stashpv("OpenGL::Sandbox::MMap", GV_ADD));
+	buffer_scalar_wrap_slice(SvRV(sv), parent, offset, length);
+	return SvREFCNT_inc(sv);
+}
+
+/* Typed views of the bytes in a scalar, for OpenGL::Sandbox::BufferView (see Sandbox-view.c) */
+
+/* Create a view of the scalar referenced by 'source'.  A negative count means as many
+ * elements as fit in the current length of the scalar.  If 'normalized', integer types read
+ * and write as fractions of their range.
+ */
+SV* _view_new(SV *source, int type, int components, IV offset, IV stride, IV count, int normalized) {
+	struct buffer_view tmp, *view;
+	struct view_layout layout;
+	struct buffer_scalar_info *info;
+	int size= view_type_size(type);
+	size_t len;
+	if (!SvROK(source) || SvTYPE(SvRV(source)) > SVt_PVMG)
+		carp_croak("Expected a scalar ref or OpenGL::Sandbox::MMap");
+	if (!size) carp_croak("Unsupported view type %d", type);
+	if (components < 1 || components > VIEW_MAX_COMPONENTS)
+		carp_croak("Components must be 1..%d", VIEW_MAX_COMPONENTS);
+	if (VIEW_IS_PACKED(type) && components != 4)
+		carp_croak("Packed type %d needs 4 components", type);
+	if (offset < 0) carp_croak("Negative offset");
+	size= view_elem_size(type, components);
+	if (!stride) stride= size;
+	if (stride < size) carp_croak("Stride %ld is less than element size %d", (long) stride, size);
+	tmp.source= SvRV(source);
+	tmp.type= type;
+	tmp.components= components;
+	tmp.normalized= normalized? 1 : 0;
+	tmp.offset= offset;
+	tmp.stride= stride;
+	if (count < 0) {
+		info= get_sv_magic(tmp.source);
+		len= info? info->length : SvPOK(tmp.source)? SvCUR(tmp.source) : 0;
+		count= len >= offset + size? (len - offset - size) / stride + 1 : 0;
+	}
+	tmp.count= count;
+	_buffer_view_layout(&tmp, &layout, 0); /* croak if it doesn't fit */
+	Newx(view, 1, struct buffer_view);
+	*view= tmp;
+	SvREFCNT_inc(view->source);
+	return sv_setref_pv(newSV(0), "OpenGL::Sandbox::BufferView", view);
+}
+
+/* Return a view of 'count' elements starting at element 'start' of this one */
+SV* _view_slice(SV *self, IV start, IV count) {
+	struct buffer_view *view= _get_buffer_view(self);
+	SV *ref;
+	if (start < 0) start += view->count;
+	if (start < 0 || start > view->count) carp_croak("Slice start %ld out of range", (long) start);
+	if (count < 0) count= view->count - start;
+	if (start + count > view->count) carp_croak("Slice of %ld elements from %ld exceeds view count %lu", (long) count, (long) start, (unsigned long) view->count);
+	ref= sv_2mortal(newRV_inc(view->source));
+	return _view_new(ref, view->type, view->components, view->offset + start * view->stride, view->stride, count, view->normalized);
+}
+
+/* Returns (type, components, offset, stride, count, normalized) */
+void _view_info(SV *self) {
+	Inline_Stack_Vars;
+	struct buffer_view *view= _get_buffer_view(self);
+	(void)items; /* squelch warning */
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(newSViv(view->type)));
+	Inline_Stack_Push(sv_2mortal(newSViv(view->components)));
+	Inline_Stack_Push(sv_2mortal(newSVuv(view->offset)));
+	Inline_Stack_Push(sv_2mortal(newSVuv(view->stride)));
+	Inline_Stack_Push(sv_2mortal(newSVuv(view->count)));
+	Inline_Stack_Push(sv_2mortal(newSViv(view->normalized)));
+	Inline_Stack_Done;
+	Inline_Stack_Return(6);
+}
+
+IV _view_count(SV *self) {
+	return _get_buffer_view(self)->count;
+}
+
+void _view_get(SV *self, IV index) {
+	Inline_Stack_Vars;
+	struct buffer_view *view= _get_buffer_view(self);
+	struct view_layout layout;
+	double v[VIEW_MAX_COMPONENTS];
+	int c;
+	(void)items; /* squelch warning */
+	_buffer_view_layout(view, &layout, 0);
+	if (index < 0) index += layout.count;
+	if (index < 0 || index >= layout.count) carp_croak("Index %ld out of range", (long) index);
+	view_read(&layout, index, v);
+	Inline_Stack_Reset;
+	for (c= 0; c < layout.components; c++)
+		Inline_Stack_Push(sv_2mortal(newSVnv(v[c])));
+	Inline_Stack_Done;
+	Inline_Stack_Return(layout.components);
+}
+
+void _view_set(SV *self, IV index, ...) {
+	Inline_Stack_Vars;
+	struct buffer_view *view= _get_buffer_view(self);
+	struct view_layout layout;
+	double v[VIEW_MAX_COMPONENTS];
+	_buffer_view_layout(view, &layout, 1);
+	if (index < 0) index += layout.count;
+	if (index < 0 || index >= layout.count) carp_croak("Index %ld out of range", (long) index);
+	if (Inline_Stack_Items - 2 != layout.components)
+		carp_croak("Expected %d values, got %d", layout.components, (int) Inline_Stack_Items - 2);
+	_buffer_view_args(&Inline_Stack_Item(2), layout.components, layout.components, v);
+	view_write(&layout, index, v);
+	Inline_Stack_Void;
+}
+
+/* Return all elements as a flat list */
+void _view_get_all(SV *self) {
+	Inline_Stack_Vars;
+	struct buffer_view *view= _get_buffer_view(self);
+	struct view_layout layout;
+	double v[VIEW_MAX_COMPONENTS];
+	size_t i;
+	int c;
+	(void)items; /* squelch warning */
+	_buffer_view_layout(view, &layout, 0);
+	Inline_Stack_Reset;
+	EXTEND(SP, layout.count * layout.components);
+	for (i= 0; i < layout.count; i++) {
+		view_read(&layout, i, v);
+		for (c= 0; c < layout.components; c++)
+			PUSHs(sv_2mortal(newSVnv(v[c])));
+	}
+	Inline_Stack_Done;
+	Inline_Stack_Return(layout.count * layout.components);
+}
+
+void _view_fill(SV *self, ...) {
+	Inline_Stack_Vars;
+	struct buffer_view *view= _get_buffer_view(self);
+	struct view_layout layout;
+	double v[VIEW_MAX_COMPONENTS];
+	_buffer_view_layout(view, &layout, 1);
+	_buffer_view_args(&Inline_Stack_Item(1), Inline_Stack_Items - 1, layout.components, v);
+	view_fill(&layout, v);
+	Inline_Stack_Void;
+}
+
+/* Multiply each component by 'factors' (one value, or one per component) */
+void _view_scale(SV *self, ...) {
+	Inline_Stack_Vars;
+	struct buffer_view *view= _get_buffer_view(self);
+	struct view_layout layout;
+	double f[VIEW_MAX_COMPONENTS], zero[VIEW_MAX_COMPONENTS]= { 0 };
+	_buffer_view_layout(view, &layout, 1);
+	_buffer_view_args(&Inline_Stack_Item(1), Inline_Stack_Items - 1, layout.components, f);
+	view_scale_add(&layout, f, zero);
+	Inline_Stack_Void;
+}
+
+/* Add 'offsets' (one value, or one per component) to each element */
+void _view_add(SV *self, ...) {
+	Inline_Stack_Vars;
+	struct buffer_view *view= _get_buffer_view(self);
+	struct view_layout layout;
+	double one[VIEW_MAX_COMPONENTS]= { 1, 1, 1, 1 }, o[VIEW_MAX_COMPONENTS];
+	_buffer_view_layout(view, &layout, 1);
+	_buffer_view_args(&Inline_Stack_Item(1), Inline_Stack_Items - 1, layout.components, o);
+	view_scale_add(&layout, one, o);
+	Inline_Stack_Void;
+}
+
+/* self= self * self_factor + other * other_factor, element by element.  A self_factor of 0
+ * is a copy.  Returns the number of elements written, which is the smaller of the two counts.
+ */
+IV _view_combine(SV *self, double self_factor, SV *other, double other_factor) {
+	struct view_layout dst, src;
+	long n;
+	_buffer_view_layout(_get_buffer_view(other), &src, 0);
+	_buffer_view_layout(_get_buffer_view(self), &dst, 1);
+	if (dst.components != src.components)
+		carp_croak("Views have %d and %d components", dst.components, src.components);
+	if ((n= view_combine(&dst, self_factor, &src, other_factor)) < 0)
+		carp_croak("Can't allocate temporary buffer of %lu bytes", (unsigned long) view_span(&src));
+	return n;
+}
+
+/* Copy numbers from an array (flat, or of arrayrefs) into the view, starting at element 0.
+ * Returns the number of elements written.
+ */
+IV _view_copy_from_array(SV *self, SV *array) {
+	struct view_layout layout;
+	double v[VIEW_MAX_COMPONENTS];
+	AV *av, *elem= NULL;
+	SV **item;
+	size_t i, n;
+	int c;
+	if (!SvROK(array) || SvTYPE(SvRV(array)) != SVt_PVAV) carp_croak("Expected an array ref");
+	av= (AV*) SvRV(array);
+	_buffer_view_layout(_get_buffer_view(self), &layout, 1);
+	item= av_fetch(av, 0, 0);
+	if (item && SvROK(*item)) {
+		/* [ [x,y,z], [x,y,z], ... ] */
+		n= av_len(av) + 1;
+		if (n > layout.count) n= layout.count;
+		for (i= 0; i < n; i++) {
+			item= av_fetch(av, i, 0);
+			if (!item || !SvROK(*item) || SvTYPE(SvRV(*item)) != SVt_PVAV || av_len(elem= (AV*) SvRV(*item)) + 1 != layout.components)
+				carp_croak("Element %lu is not an array of %d values", (unsigned long) i, layout.components);
+			for (c= 0; c < layout.components; c++)
+				v[c]= (item= av_fetch(elem, c, 0))? SvNV(*item) : 0;
+			view_write(&layout, i, v);
+		}
+	}
+	else {
+		/* [ x,y,z, x,y,z, ... ] */
+		n= (av_len(av) + 1) / layout.components;
+		if (n > layout.count) n= layout.count;
+		for (i= 0; i < n; i++) {
+			for (c= 0; c < layout.components; c++)
+				v[c]= (item= av_fetch(av, i * layout.components + c, 0))? SvNV(*item) : 0;
+			view_write(&layout, i, v);
+		}
+	}
+	return n;
+}
+
+/* Octahedral encoding of the unit vectors of 'other' into 2 components of self, or decoding
+ * them back to 3 or 4.  Returns the number of elements written.
+ */
+IV _view_oct_encode(SV *self, SV *other) {
+	struct view_layout dst, src;
+	_buffer_view_layout(_get_buffer_view(other), &src, 0);
+	_buffer_view_layout(_get_buffer_view(self), &dst, 1);
+	_buffer_view_check_oct(&dst, &src, 0);
+	view_oct_encode(&dst, &src);
+	return dst.count < src.count? dst.count : src.count;
+}
+
+IV _view_oct_decode(SV *self, SV *other) {
+	struct view_layout dst, src;
+	_buffer_view_layout(_get_buffer_view(other), &src, 0);
+	_buffer_view_layout(_get_buffer_view(self), &dst, 1);
+	_buffer_view_check_oct(&dst, &src, 1);
+	view_oct_decode(&dst, &src);
+	return dst.count < src.count? dst.count : src.count;
+}
+
+/* Copy each of the (dst, src) pairs of views in the arguments, element by element, on the
+ * ThreadPool 'pool' if defined.  This interleaves separate arrays into one buffer, or the
+ * reverse.  Returns the number of elements copied, which is the smallest count of any view.
+ */
+void _view_copy_streams(SV *pool, ...) {
+	Inline_Stack_Vars;
+	struct view_stream streams[VIEW_MAX_STREAMS];
+	struct view_layout table;
+	double params[1];
+	size_t count= 0;
+	int i, j, n= (Inline_Stack_Items - 1) / 2;
+	if (Inline_Stack_Items < 3 || !(Inline_Stack_Items & 1))
+		carp_croak("Expected pairs of destination and source views");
+	if (n > VIEW_MAX_STREAMS) carp_croak("At most %d streams", VIEW_MAX_STREAMS);
+	/* Writable first, since that can give a shared (copy-on-write) scalar its own bytes */
+	for (i= 0; i < n; i++)
+		_buffer_view_layout(_get_buffer_view(Inline_Stack_Item(1 + i*2)), &streams[i].dst, 1);
+	for (i= 0; i < n; i++) {
+		_buffer_view_layout(_get_buffer_view(Inline_Stack_Item(2 + i*2)), &streams[i].src, 0);
+		if (streams[i].dst.components != streams[i].src.components)
+			carp_croak("Stream %d views have %d and %d components", i, streams[i].dst.components, streams[i].src.components);
+		if (!i || streams[i].src.count < count) count= streams[i].src.count;
+		if (streams[i].dst.count < count) count= streams[i].dst.count;
+	}
+	for (i= 0; i < n; i++) {
+		streams[i].src.count= streams[i].dst.count= count;
+		/* elements are copied in a different order than one view at a time */
+		for (j= 0; j < n; j++)
+			if (view_overlaps(&streams[i].dst, &streams[j].src))
+				carp_croak("Destination of stream %d overlaps source of stream %d", i, j);
+	}
+	if (SvOK(pool) && count) {
+		struct thread_pool *tp= _get_thread_pool(pool);
+		table.data= (char*) streams;
+		table.stride= 0;
+		table.count= count;
+		table.type= GL_UNSIGNED_BYTE;
+		table.components= 1;
+		table.normalized= 0;
+		params[0]= n;
+		_thread_pool_finish(tp);
+		work_pool_start(&tp->pool, pool_kernel_streams, &table, NULL, params, 1);
+		work_pool_wait(&tp->pool);
+	}
+	else
+		view_copy_streams(streams, n, 0, count);
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(newSVuv(count)));
+	Inline_Stack_Done;
+	Inline_Stack_Return(1);
+}
+
+void _view_free(SV *self) {
+	struct buffer_view *view= _get_buffer_view(self);
+	SvREFCNT_dec(view->source);
+	Safefree(view);
+}
+
+/* Worker threads running kernels over BufferViews, for OpenGL::Sandbox::ThreadPool */
+
+SV* _thread_pool_new(int threads) {
+	struct thread_pool *tp;
+	if (threads < 0) threads= pool_cpu_count();
+	Newxz(tp, 1, struct thread_pool);
+	work_pool_open(&tp->pool, threads);
+	return sv_setref_pv(newSV(0), "OpenGL::Sandbox::ThreadPool", (void*) tp);
+}
+
+/* Start kernel 'name' on the view 'dst' (and 'src', if defined), with the rest of the
+ * arguments as parameters.  Waits for the previous job first.
+ */
+void _thread_pool_start(SV *self, const char *name, SV *dst_sv, SV *src_sv, ...) {
+	Inline_Stack_Vars;
+	struct thread_pool *tp= _get_thread_pool(self);
+	struct pool_kernel_def *k= pool_find_kernel(name);
+	struct view_layout dst, src, dst_part;
+	double params[POOL_MAX_PARAMS];
+	int i, n_params= Inline_Stack_Items - 4, has_src= SvOK(src_sv), copy_src= 0;
+	if (!k) carp_croak("No kernel named '%s'", name);
+	if (k->needs_src && !has_src) carp_croak("Kernel '%s' needs a source view", name);
+	_buffer_view_layout(_get_buffer_view(dst_sv), &dst, 1);
+	if (!pool_check_params(k, dst.components, n_params)) {
+		if (k->n_params >= 0)
+			carp_croak("Kernel '%s' takes %d parameters, got %d", name, k->n_params, n_params);
+		if (k->n_params == POOL_ANY_PARAMS)
+			carp_croak("Kernel '%s' takes at most %d parameters, got %d", name, POOL_MAX_PARAMS, n_params);
+		carp_croak("Kernel '%s' takes %d or %d parameters, got %d", name, -k->n_params, -k->n_params * dst.components, n_params);
+	}
+	if (k->fn == pool_kernel_transform)
+		_buffer_view_check_transform(&dst);
+	if (has_src) {
+		_buffer_view_layout(_get_buffer_view(src_sv), &src, 0);
+		if (k->needs_src == POOL_SRC_CONVERT)
+			_buffer_view_check_oct(&dst, &src, k->fn == pool_kernel_oct_decode);
+		else if (src.components != dst.components)
+			carp_croak("Views have %d and %d components", dst.components, src.components);
+		/* Chunks of overlapping views would read each other's output, unless each element
+		 * only reads itself.  Different attributes of the same interleaved vertices don't
+		 * overlap. */
+		src.count= src.count < dst.count? src.count : dst.count;
+		dst_part= dst;
+		dst_part.count= src.count;
+		copy_src= !(src.data == dst.data && src.stride == dst.stride) && view_overlaps(&dst_part, &src);
+	}
+	for (i= 0; i < n_params; i++)
+		params[i]= SvNV(Inline_Stack_Item(4 + i));
+	_thread_pool_finish(tp);
+	/* Kernels run on the workers mustn't allocate, so an overlapping source is copied here */
+	if (copy_src) {
+		Newx(tp->src_copy, view_span(&src), char);
+		memcpy(tp->src_copy, src.data, view_span(&src));
+		src.data= tp->src_copy;
+	}
+	tp->dst= SvREFCNT_inc(dst_sv);
+	tp->src= has_src? SvREFCNT_inc(src_sv) : NULL;
+	work_pool_start(&tp->pool, k->fn, &dst, has_src? &src : NULL, params, n_params);
+	Inline_Stack_Void;
+}
+
+void _thread_pool_wait(SV *self) {
+	_thread_pool_finish(_get_thread_pool(self));
+}
+
+/* True if a job has been started, and not all of it has run yet */
+int _thread_pool_busy(SV *self) {
+	struct work_pool *p= &_get_thread_pool(self)->pool;
+	int busy;
+	if (!p->busy) return 0;
+	POOL_LOCK(p);
+	busy= p->done_chunks < p->n_chunks;
+	POOL_UNLOCK(p);
+	return busy;
+}
+
+int _thread_pool_threads(SV *self) {
+	return _get_thread_pool(self)->pool.threads;
+}
+
+/* Add a kernel written in C.  'address' is a pool_kernel_fn, as an integer. */
+void _thread_pool_register_kernel(const char *name, IV address, int needs_src) {
+	struct pool_kernel_def *k= pool_find_kernel(name);
+	if (!address) carp_croak("Kernel address is NULL");
+	if (k && k - pool_kernels < POOL_BUILTIN_KERNELS) carp_croak("Can't replace built-in kernel '%s'", name);
+	if (!k) {
+		if (pool_n_kernels >= POOL_MAX_KERNELS)
+			carp_croak("Too many kernels (max %d)", POOL_MAX_KERNELS);
+		k= &pool_kernels[pool_n_kernels++];
+		k->name= savepv(name);
+		k->n_params= POOL_ANY_PARAMS;
+	}
+	k->fn= INT2PTR(pool_kernel_fn, address);
+	k->needs_src= needs_src;
+}
+
+void _thread_pool_kernels() {
+	Inline_Stack_Vars;
+	int i;
+	(void)items; /* squelch warning */
+	Inline_Stack_Reset;
+	for (i= 0; i < pool_n_kernels; i++)
+		Inline_Stack_Push(sv_2mortal(newSVpv(pool_kernels[i].name, 0)));
+	Inline_Stack_Done;
+	Inline_Stack_Return(pool_n_kernels);
+}
+
+void _thread_pool_free(SV *self) {
+	struct thread_pool *tp= _get_thread_pool(self);
+	_thread_pool_finish(tp);
+	work_pool_close(&tp->pool);
+	Safefree(tp);
+}
+
+/* Procedural meshes, for OpenGL::Sandbox::Mesh */
+
+SV* _mesh_new(const char *shape, int nu, int nv, double a, double b, double c) {
+	static const char *names[]= { "plane", "sphere", "icosphere", "cylinder", "torus", "heightfield" };
+	struct mesh_shape *m, tmp;
+	int i;
+	Zero(&tmp, 1, struct mesh_shape);
+	for (i= 0; i < 6; i++)
+		if (strcmp(shape, names[i]) == 0) tmp.shape= MESH_PLANE + i;
+	if (!tmp.shape) carp_croak("Unknown mesh shape '%s'", shape);
+	if (tmp.shape == MESH_ICOSPHERE) nv= 1;
+	if (nu < 1 || nv < 1) carp_croak("Mesh needs at least 1 segment in each direction");
+	tmp.nu= nu;
+	tmp.nv= nv;
+	tmp.a= a; tmp.b= b; tmp.c= c;
+	if (mesh_vertex_count(&tmp) > 0x7FFFFFFF || mesh_index_count(&tmp) > 0x7FFFFFFF)
+		carp_croak("Mesh of %d x %d segments is too large", nu, nv);
+	Newx(m, 1, struct mesh_shape);
+	*m= tmp;
+	return sv_setref_pv(newSV(0), "OpenGL::Sandbox::Mesh::C", (void*) m);
+}
+
+/* Set where attribute 'which' (position, normal, uv) is written within each vertex.
+ * If 'oct', the normal is written as 2 components of octahedral encoding.
+ */
+void _mesh_set_attr(SV *self, const char *which, int offset, int type, int components, int normalized, int oct) {
+	struct mesh_shape *m= _get_mesh(self);
+	struct mesh_attr *attr= strcmp(which, "position") == 0? &m->position
+		: strcmp(which, "normal") == 0? &m->normal
+		: strcmp(which, "uv") == 0? &m->uv
+		: NULL;
+	if (!attr) carp_croak("Unknown mesh attribute '%s'", which);
+	if (!view_type_size(type)) carp_croak("Unsupported attribute type %d", type);
+	if (components < 0 || components > VIEW_MAX_COMPONENTS)
+		carp_croak("Components must be 0..%d", VIEW_MAX_COMPONENTS);
+	if (components && VIEW_IS_PACKED(type) && components != 4)
+		carp_croak("Packed type %d needs 4 components", type);
+	if (oct && (attr != &m->normal || components != 2))
+		carp_croak("Octahedral encoding is only for a normal of 2 components");
+	if (offset < 0) carp_croak("Negative offset");
+	attr->offset= offset;
+	attr->type= type;
+	attr->components= components;
+	attr->normalized= normalized? 1 : 0;
+	attr->oct= oct? 1 : 0;
+}
+
+/* Returns (vertex_count, index_count) */
+void _mesh_counts(SV *self) {
+	Inline_Stack_Vars;
+	struct mesh_shape *m= _get_mesh(self);
+	(void)items; /* squelch warning */
+	Inline_Stack_Reset;
+	Inline_Stack_Push(sv_2mortal(newSVuv(mesh_vertex_count(m))));
+	Inline_Stack_Push(sv_2mortal(newSVuv(mesh_index_count(m))));
+	Inline_Stack_Done;
+	Inline_Stack_Return(2);
+}
+
+/* Write all vertices into 'target' at 'offset', 'stride' bytes apart, using the ThreadPool
+ * 'pool' if defined.  A heightfield reads its heights from the BufferView 'heights'.
+ * Returns the number of bytes from the first byte written to the last.
+ */
+IV _mesh_write_vertices(SV *self, SV *target, IV offset, IV stride, SV *pool, SV *heights_sv) {
+	struct mesh_shape *m= _get_mesh(self);
+	const struct mesh_attr *attr[3]= { &m->position, &m->normal, &m->uv };
+	struct view_layout dst, heights;
+	double params[MESH_PARAMS];
+	size_t count= mesh_vertex_count(m), vertex_size= 0, end, len;
+	int i;
+	for (i= 0; i < 3; i++) {
+		end= attr[i]->offset + view_elem_size(attr[i]->type, attr[i]->components);
+		if (attr[i]->components && end > vertex_size) vertex_size= end;
+	}
+	if (offset < 0) carp_croak("Negative offset");
+	if (stride < (IV) vertex_size) carp_croak("Stride %ld is less than vertex size %lu", (long) stride, (unsigned long) vertex_size);
+	if (m->shape == MESH_HEIGHTFIELD) {
+		if (!SvOK(heights_sv)) carp_croak("Heightfield needs a view of heights");
+		_buffer_view_layout(_get_buffer_view(heights_sv), &heights, 0);
+		if (heights.components != 1 || heights.count < count)
+			carp_croak("Heightfield needs %lu heights of 1 component", (unsigned long) count);
+		heights.count= count;
+	}
+	len= (count - 1) * stride + vertex_size;
+	dst.data= _buffer_target(target, offset, len);
+	dst.stride= stride;
+	dst.count= count;
+	dst.type= GL_UNSIGNED_BYTE;
+	dst.components= 1;
+	dst.normalized= 0;
+	if (SvOK(pool)) {
+		struct thread_pool *tp= _get_thread_pool(pool);
+		mesh_pack(m, params);
+		_thread_pool_finish(tp);
+		work_pool_start(&tp->pool, pool_kernel_mesh_vertices, &dst,
+			m->shape == MESH_HEIGHTFIELD? &heights : NULL, params, MESH_PARAMS);
+		work_pool_wait(&tp->pool);
+	}
+	else
+		mesh_write_vertices(m, m->shape == MESH_HEIGHTFIELD? &heights : NULL, dst.data, stride, 0, count);
+	return len;
+}
+
+/* Write all indices as GL_UNSIGNED_SHORT or GL_UNSIGNED_INT into 'target' at 'offset',
+ * adding 'base' to each.  Returns the number of bytes written.
+ */
+IV _mesh_write_indices(SV *self, SV *target, IV offset, int type, IV base, SV *pool) {
+	struct mesh_shape *m= _get_mesh(self);
+	struct view_layout dst;
+	double params[MESH_PARAMS + 1];
+	size_t count= mesh_index_count(m), size= type == GL_UNSIGNED_SHORT? 2 : 4;
+	if (type != GL_UNSIGNED_SHORT && type != GL_UNSIGNED_INT)
+		carp_croak("Index type must be GL_UNSIGNED_SHORT or GL_UNSIGNED_INT");
+	if (offset < 0 || base < 0) carp_croak("Negative offset");
+	if (base + mesh_vertex_count(m) > (type == GL_UNSIGNED_SHORT? 0x10000 : 0x100000000ULL))
+		carp_croak("Vertex numbers up to %lu don't fit the index type", (unsigned long) (base + mesh_vertex_count(m) - 1));
+	dst.data= _buffer_target(target, offset, count * size);
+	dst.stride= size;
+	dst.count= count;
+	dst.type= type;
+	dst.components= 1;
+	dst.normalized= 0;
+	if (SvOK(pool)) {
+		struct thread_pool *tp= _get_thread_pool(pool);
+		mesh_pack(m, params);
+		params[MESH_PARAMS]= base;
+		_thread_pool_finish(tp);
+		work_pool_start(&tp->pool, pool_kernel_mesh_indices, &dst, NULL, params, MESH_PARAMS + 1);
+		work_pool_wait(&tp->pool);
+	}
+	else
+		mesh_write_indices(m, type, dst.data, 0, count, base);
+	return count * size;
+}
+
+void _mesh_free(SV *self) {
+	Safefree(_get_mesh(self));
+}
+
+#ifdef GL_VERSION_3_2
+
+/* Asynchronous glReadPixels through a ring of pixel-pack buffers (see struct pixel_ring) */
+
+SV* _pixel_ring_new(int depth) {
+	struct pixel_ring *ring;
+	if (depth < 2 || depth > PIXEL_RING_MAX)
+		carp_croak("Ring depth must be 2..%d", PIXEL_RING_MAX);
+	Newxz(ring, 1, struct pixel_ring);
+	ring->depth= depth;
+	ring->mapped= -1;
+	return sv_setref_pv(newSV(0), "OpenGL::Sandbox::PixelReadRing", ring);
+}
+
+/* Start reading a rectangle of the current read framebuffer into the next slot, unless 'flush'
+ * is true.  A size of 0x0 means the viewport, and a format or type of 0 means RGBA bytes.
+ * Then if the ring is full (or flushing), wait for the oldest read and return a read-only
+ * MMap of its pixels, with its width and height.  Otherwise return an empty list.
+ */
+void _pixel_ring_read(SV *self, int x, int y, int width, int height, int format, int type, int flush) {
+	Inline_Stack_Vars;
+	struct pixel_ring *ring= _get_pixel_ring(self);
+	struct pixel_ring_slot *s;
+	int pixel_size, i;
+	GLint pack_alignment, viewport[4]= {0};
+	GLenum status;
+	void *addr;
+	SV *ref;
+	GL_PROFILE_BEGIN("read_pixels_async");
+	(void)items; /* squelch warning */
+
+	_pixel_ring_unmap(ring);
+	if (!flush) {
+		if (!width && !height) {
+			glGetIntegerv(GL_VIEWPORT, viewport);
+			x= viewport[0], y= viewport[1], width= viewport[2], height= viewport[3];
+		}
+		if (width <= 0 || height <= 0) carp_croak("Invalid size %dx%d", width, height);
+		if (!format) format= GL_RGBA;
+		if (!type) type= GL_UNSIGNED_BYTE;
+		if (!(pixel_size= _get_pixel_size(format, type)))
+			carp_croak("Can't determine pixel size of format 0x%X, type 0x%X", format, type);
+		s= &ring->slot[ring->head];
+		s->width= width;
+		s->height= height;
+		s->size= (size_t) width * height * pixel_size;
+		if (!s->pbo) glGenBuffers(1, &s->pbo);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, s->pbo);
+		if (s->size > s->alloc) {
+			glBufferData(GL_PIXEL_PACK_BUFFER, s->size, NULL, GL_STREAM_READ);
+			s->alloc= s->size;
+		}
+		/* rows are packed with no padding, so the result is exactly width*pixel_size per row */
+		glGetIntegerv(GL_PACK_ALIGNMENT, &pack_alignment);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(x, y, width, height, format, type, 0);
+		glPixelStorei(GL_PACK_ALIGNMENT, pack_alignment);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		s->fence= glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		ring->head= (ring->head + 1) % ring->depth;
+		ring->pending++;
+	}
+	if (!ring->pending || (!flush && ring->pending < ring->depth)) {
+		GL_PROFILE_END();
+		Inline_Stack_Void;
+	}
+
+	/* Map the oldest slot, normally done long enough ago that this doesn't block */
+	i= (ring->head - ring->pending + ring->depth) % ring->depth;
+	s= &ring->slot[i];
+	status= glClientWaitSync(s->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 10000000000ULL);
+	glDeleteSync(s->fence);
+	s->fence= NULL;
+	ring->pending--;
+	if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+		carp_croak(status == GL_TIMEOUT_EXPIRED? "Timed out waiting for glReadPixels" : "glClientWaitSync failed");
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, s->pbo);
+	addr= glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, s->size, GL_MAP_READ_BIT);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	if (!addr) carp_croak("glMapBufferRange failed");
+	ring->mapped= i;
+	ring->view= newSV(0);
+	ref= sv_2mortal(newRV_inc(ring->view));
+	sv_bless(ref, gv_stashpv("OpenGL::Sandbox::MMap", GV_ADD));
+	buffer_scalar_wrap(ring->view, addr, s->size, BUFFER_SCALAR_READONLY, NULL, NULL);
+	SvREADONLY_on(ring->view);
+
+	Inline_Stack_Reset;
+	Inline_Stack_Push(ref);
+	Inline_Stack_Push(sv_2mortal(newSViv(s->width)));
+	Inline_Stack_Push(sv_2mortal(newSViv(s->height)));
+	Inline_Stack_Done;
+	GL_PROFILE_END();
+	Inline_Stack_Return(3);
+}
+
+void _pixel_ring_free(SV *self) {
+	struct pixel_ring *ring= _get_pixel_ring(self);
+	int i;
+	_pixel_ring_unmap(ring);
+	for (i= 0; i < ring->depth; i++) {
+		if (ring->slot[i].fence) glDeleteSync(ring->slot[i].fence);
+		if (ring->slot[i].pbo) glDeleteBuffers(1, &ring->slot[i].pbo);
+	}
+	Safefree(ring);
+}
+
+#endif
+
 const char* get_glsl_type_name(int type) {
 	switch (type) {
 	case GL_BOOL:              return "bool";
@@ -587,6 +1754,7 @@ SV * get_program_uniforms(unsigned program) {
 	GLenum type;
 	char namebuf[32];
 	HV *result; AV *item;
+	GL_PROFILE_BEGIN("get_program_uniforms");
 	result= (HV*) sv_2mortal((SV*) newHV());
 	glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &active_uniforms);
 	for (i= 0; i < active_uniforms; i++) {
@@ -604,6 +1772,7 @@ SV * get_program_uniforms(unsigned program) {
 			if (!hv_store(result, namebuf, namelen, newRV_inc((SV*)item), 0)) croak("hv_store failed");
 		}
     }
+	GL_PROFILE_END();
 	return newRV_inc((SV*) result);
 }
 
@@ -614,6 +1783,7 @@ void set_uniform(unsigned program, SV* uniform_cache, const char *name, ...) {
 	unsigned long buf_size, buf_req= 0;
 	char static_buf[ 8 * 16 ], *buf= NULL;
 	AV *info= NULL;
+	GL_PROFILE_BEGIN("set_uniform");
 	
 	/* Can't call glUniform for a program that isn't the active one, unless GL > 4.1 */
 	glGetIntegerv(GL_CURRENT_PROGRAM, &cur_prog);
@@ -821,6 +1991,7 @@ void set_uniform(unsigned program, SV* uniform_cache, const char *name, ...) {
 		}
 	}
 	#endif
+	GL_PROFILE_END();
 	Inline_Stack_Void;
 }
 
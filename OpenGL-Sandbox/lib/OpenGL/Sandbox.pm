@@ -7,7 +7,8 @@ use Cwd 'abs_path';
 use Carp;
 use Log::Any '$log';
 use Module::Runtime 'require_module';
-use Scalar::Util 'weaken';
+use Scalar::Util qw( weaken refaddr );
+use Hash::Util::FieldHash 'fieldhash';
 
 # ABSTRACT: Rapid-prototyping utilities for OpenGL
 BEGIN {
@@ -38,15 +39,19 @@ require constant;
 
 export qw( =$res -resources(1) tex new_texture buffer new_buffer shader new_shader
 	program new_program font vao new_vao
-	make_context current_context next_frame
+	make_context current_context next_frame profile_zone gl_missing_functions
+	gl_profile_enable gl_profile_disable gl_profile_reset gl_profile_snapshot gl_profile_report
+	gl_capture_start gl_capture_frame gl_capture_stop gl_capturing read_pixels_async
 	gl_error_name get_gl_errors log_gl_errors warn_gl_errors
+	gl_debug_enable gl_debug_disable gl_debug_active gl_debug_messages log_gl_debug_messages
 	gen_textures delete_textures _round_up_pow2
 	),
 	-V1 => sub { Module::Runtime::use_module('OpenGL::Sandbox::V1','0.04'); },
 	# Conditionally export the stuff that gets conditionally compiled
 	map { __PACKAGE__->can($_)? ($_) : () } qw(
 	get_program_uniforms set_uniform get_glsl_type_name
-	gen_buffers delete_buffers load_buffer_data load_buffer_sub_data
+	gen_buffers delete_buffers bind_buffer load_buffer_data load_buffer_sub_data
+	gen_queries delete_queries query_timestamp get_query_results gl_timestamp
 	);
 
 =head1 SYNOPSIS
@@ -248,9 +253,13 @@ sub font        { OpenGL::Sandbox::ResMan->default_instance->font(@_) }
   my $context= make_context( %opts );
 
 Pick the lightest smallest module that can get a window set up for rendering.
-This tries: L<X11::GLX>, L<OpenGL::GLFW>, L<SDLx::App>, and C<GLUT> (via OpenGL module)
-in that order.
-You can override the detection with environment variable C<OPENGL_SANDBOX_CONTEXT_PROVIDER>.
+This tries: L<OpenGL::GLFW>, L<SDLx::App>, L<X11::GLX>, and C<GLUT> (via OpenGL module)
+in that order, and then a headless EGL context (L<OpenGL::Sandbox::ContextShim::EGL>).
+If there is no display (no C<DISPLAY> or C<WAYLAND_DISPLAY> on a Unix system) the headless
+context is tried first.
+You can override the detection with the C<provider> option or environment variable
+C<OPENGL_SANDBOX_CONTEXT_PROVIDER>, giving one of C<GLFW>, C<SDL>, C<GLX>, C<GLUT>, C<EGL>,
+or C<OSMesa>.
 It assumes you don't have any desire to receive user input and just want to render some stuff.
 If you do actually have a preference, you should just invoke that package yourself.
 
@@ -287,6 +296,25 @@ Attempts to create a window without window border decorations.
 
 Window title
 
+=item provider
+
+Name of the context provider to use, as above.
+
+=item gl_version, profile
+
+Request a GL version (like C<"3.3">) and profile (C<"core"> or C<"compat">).  Implemented
+for GLFW, EGL, and OSMesa.
+
+=item platform, software
+
+Options for L<EGL|OpenGL::Sandbox::ContextShim::EGL>, to choose the EGL platform and to
+force Mesa's software renderer.
+
+=item debug
+
+Request a debug context, and call L</gl_debug_enable> after it is created.  The value may be
+a hashref of options for C<gl_debug_enable>.  Warns if the context doesn't support KHR_debug.
+
 =back
 
 Note that if you're using Classic OpenGL (V1) you also need to set up the projection matrix
@@ -306,6 +334,8 @@ BEGIN {
 		'SDL'            => 'OpenGL::Sandbox::ContextShim::SDL',
 		'SDLx::App'      => 'OpenGL::Sandbox::ContextShim::SDL',
 		'GLUT'           => 'OpenGL::Sandbox::ContextShim::GLUT',
+		'EGL'            => 'OpenGL::Sandbox::ContextShim::EGL',
+		'OSMesa'         => 'OpenGL::Sandbox::ContextShim::OSMesa',
 	);
 }
 
@@ -333,13 +363,14 @@ sub make_context {
 
 	# Load user's requested provider, or auto-detect first available
 	my $provider;
-	if ($ENV{OPENGL_SANDBOX_CONTEXT_PROVIDER}) {
-		$provider= $context_provider_aliases{$ENV{OPENGL_SANDBOX_CONTEXT_PROVIDER}}
-			or croak "Unhandled context provider $ENV{OPENGL_SANDBOX_CONTEXT_PROVIDER}";
+	if (my $name= $opts{provider} // $ENV{OPENGL_SANDBOX_CONTEXT_PROVIDER}) {
+		$provider= $context_provider_aliases{$name}
+			or croak "Unhandled context provider $name";
 		require_module($provider);
 	}
 	else {
-		for my $mod (qw/ GLFW SDL GLX GLUT /) {
+		my $headless= $^O ne 'MSWin32' && $^O ne 'darwin' && !$ENV{DISPLAY} && !$ENV{WAYLAND_DISPLAY};
+		for my $mod ($headless? qw/ EGL GLFW SDL GLX GLUT / : qw/ GLFW SDL GLX GLUT EGL /) {
 			next unless eval "require OpenGL::Sandbox::ContextShim::$mod; 1";
 			$provider= "OpenGL::Sandbox::ContextShim::$mod";
 			last;
@@ -349,12 +380,20 @@ sub make_context {
 	undef $current_context;
 	my $cx= $current_context= $provider->new(%opts);
 	$log->infof("Loaded %s", $cx->context_info);
+	_use_gl_dispatch($cx);
+	if ($opts{debug}) {
+		gl_debug_enable(ref $opts{debug} eq 'HASH'? %{ $opts{debug} } : ())
+			or carp "GL context doesn't support KHR_debug";
+	}
 	weaken($current_context) if defined wantarray;
 	return $cx;
 }
 
 =head2 current_context
 
+  my $cx= current_context;
+  current_context($cx);
+
 Returns the most recently created result of L</make_context>, assuming it hasn't been
 garbage-collected.  If you stored the return value of L</make_context>, then garbage
 collection happens according to that reference.  If you called L</make_context> in void
@@ -362,22 +401,78 @@ context, then the GL context will live indefinitely.
 
 If you have a simple program with only one context, this global simplifies life for you.
 
+The C code of this module calls GL 2.0+ functions through a table of function pointers
+looked up for each context, because function addresses are not guaranteed to be the same
+between contexts.  L</make_context> builds this table for the new context.  If you make
+a different context current yourself (by whatever API created it), pass that context object
+to C<current_context> afterward so that the matching table is used.  An object not seen
+before gets a new table built for the GL context that is current at that moment.
+Passing C<undef> reverts to the default table, which looks up each function on its first call.
+
+=head2 gl_missing_functions
+
+  my @names= gl_missing_functions();
+
+Returns the names of GL functions used by this module that the current context does not
+provide, either because its GL version is too old or because the driver has no address for
+them.  These are also logged (at info level) when the context is set up, so that you hear
+about them at startup rather than in the middle of rendering.  The wrappers that need them
+will fail when called, or for functions newer than the context version, may call into the
+driver anyway and produce a GL error.
+
 =cut
 
-sub current_context { $current_context }
+sub current_context {
+	if (@_) {
+		my $cx= shift;
+		# don't weaken the reference held since make_context was called in void context
+		unless (defined $cx && defined $current_context && refaddr $cx == refaddr $current_context) {
+			$current_context= $cx;
+			weaken($current_context);
+		}
+		_use_gl_dispatch($cx);
+	}
+	$current_context;
+}
+
+# Each context object gets [ $dispatch_table, \@missing_function_names ]
+fieldhash my %gl_dispatch;
+
+sub _use_gl_dispatch {
+	my $cx= shift;
+	return _gl_dispatch_use(undef) unless defined $cx;
+	my $entry= $gl_dispatch{$cx} //= do {
+		my $table= _gl_dispatch_new();
+		my @missing= _gl_dispatch_resolve($table);
+		$log->infof("GL functions not available in this context: %s", join(' ', @missing))
+			if @missing;
+		[ $table, \@missing ];
+	};
+	_gl_dispatch_use($entry->[0]);
+}
+
+sub gl_missing_functions {
+	my $entry= defined $current_context && $gl_dispatch{$current_context};
+	$entry? @{ $entry->[1] } : ();
+}
+
+sub OpenGL::Sandbox::GLDispatch::DESTROY { _gl_dispatch_free(shift) }
+sub OpenGL::Sandbox::HeadlessContext::DESTROY { _headless_context_free(shift) }
 
 =head2 next_frame
 
 This calls a sequence of:
 
   current_context->swap_buffers;
-  warn_gl_errors;
+  warn_gl_errors;              # or log_gl_debug_messages, if gl_debug_active
   glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
 
 If you have loaded "-V1" it also calls
 
   glLoadIdentity();
 
+If an L<OpenGL::Sandbox::Profiler> is active, the frame ends there, after the swap.
+
 Note that C<< current_context->swap_buffers() >> will only work after L</make_context>.
 
 This is intended to help out with quick prototyping and one-liners:
@@ -389,11 +484,29 @@ This is intended to help out with quick prototyping and one-liners:
 sub next_frame() {
 	my $gl= OpenGL::Sandbox::current_context();
 	$gl->swap_buffers if $gl;
-	warn_gl_errors();
+	$OpenGL::Sandbox::Profiler::active->end_frame if $OpenGL::Sandbox::Profiler::active;
+	gl_capture_frame();
+	gl_debug_active()? log_gl_debug_messages() : warn_gl_errors();
 	glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
 	__PACKAGE__->maybe::next::method();
 }
 
+=head2 profile_zone
+
+  profile_zone shadows => sub { ... };
+
+Run the code and record its CPU and GPU time under that name in the active
+L<OpenGL::Sandbox::Profiler>.  If no profiler is active, this just runs the code.  Returns
+whatever the code returns.
+
+=cut
+
+sub profile_zone {
+	my ($name, $code)= @_;
+	return $OpenGL::Sandbox::Profiler::active->zone($name, $code) if $OpenGL::Sandbox::Profiler::active;
+	$code->();
+}
+
 =head2 gl_error_name
 
   my $name= gl_error_name( $code );
@@ -406,6 +519,12 @@ Returns the symbolic name of a GL error code.
 
 Returns the symbolic names of any pending OpenGL errors, as a list.
 
+While L</gl_debug_active>, this doesn't call C<glGetError> (which waits for the GPU driver to
+catch up) and instead returns the message of each debug message of type C<error> collected
+so far.  All other debug messages are passed to L</log_gl_debug_messages>.  Errors are
+reported whenever the driver gets to them, so they may belong to earlier calls than the ones
+just made.
+
 =head2 log_gl_errors
 
 Write all GL errors to Log::Any as C<< ->error >>.  Returns true if any errors were reported.
@@ -420,6 +539,11 @@ Emit any GL errors using 'warn'.  Returns true if any errors were reported.
 
 sub get_gl_errors {
 	my $self= shift;
+	if (gl_debug_active()) {
+		my ($errors, $others)= _partition_debug_messages(gl_debug_messages());
+		_log_debug_messages(@$others);
+		return map $_->{message}, @$errors;
+	}
 	my (@names, $e);
 	push @names, gl_error_name($e) || "(unrecognized) ".$e
 		while (($e= glGetError()));
@@ -438,12 +562,322 @@ sub warn_gl_errors {
 	return 1;
 }
 
+=head2 Asynchronous Error Reporting
+
+  make_context(debug => { min_severity => 'medium' });
+  # or
+  gl_debug_enable(min_severity => 'medium', sources => [ 'api', 'shader_compiler' ]);
+
+Calling C<glGetError> after every step forces the application to wait on the driver, and
+only reports a single bit per kind of error.  If the context supports C<KHR_debug> (GL 4.3 or
+the extension), the driver can instead hand a detailed message for each problem to a callback
+whenever it notices it.  The callback copies each message into a fixed-size ring buffer in C
+(dropping and counting any that don't fit) without making any GL calls, and the messages are
+passed along to Log::Any at the end of each frame by L</next_frame>.
+
+While this is active, L</get_gl_errors> and friends no longer call C<glGetError>.  For
+complete messages, the context should be created as a debug context (the C<debug> option of
+L</make_context>); other contexts may report only some messages or none at all.
+
+=over
+
+=item gl_debug_enable
+
+  gl_debug_enable(%opts) or warn "No KHR_debug";
+
+Install the callback on the current context.  Returns false if the context doesn't support
+KHR_debug.  Options:
+
+=over
+
+=item min_severity
+
+One of C<notification>, C<low>, C<medium>, C<high>.  Messages below this are filtered out by
+the driver.  Defaults to C<low>.
+
+=item sources
+
+Arrayref of the sources to accept: C<api>, C<window_system>, C<shader_compiler>,
+C<third_party>, C<application>, C<other>.  Defaults to all.
+
+=item synchronous
+
+If true, the driver reports each message during the GL call that caused it, so it can be
+attributed to the right line of code, at the cost of performance.
+
+=back
+
+=item gl_debug_disable
+
+Remove the callback and return to C<glGetError>.
+
+=item gl_debug_active
+
+True while the callback is installed on the current context.  This is tracked for each
+context, so after switching with L</current_context> it reflects the context switched to.
+
+=item gl_debug_messages
+
+  my @messages= gl_debug_messages();
+  # ( { source => 'api', type => 'error', severity => 'high', id => 1, message => '...' }, ... )
+
+Remove and return all collected messages.  If any were dropped because the ring buffer was
+full, a final message of type C<other> says how many.
+
+=item log_gl_debug_messages
+
+Remove all collected messages and write them to Log::Any, as C<error> for errors and
+severity C<high>, C<warn> for C<medium>, C<info> for C<low>, and C<debug> for
+notifications.  Returns true if any were errors.
+
+=back
+
+=cut
+
+my %debug_severity_rank= ( notification => 0, low => 1, medium => 2, high => 3 );
+my %debug_source_bit= ( api => 1, window_system => 2, shader_compiler => 4, third_party => 8,
+	application => 16, other => 32 );
+my %debug_log_level= ( notification => 'debug', low => 'info', medium => 'warn', high => 'error' );
+
+sub gl_debug_enable {
+	my %opts= @_;
+	my $min= $debug_severity_rank{$opts{min_severity} // 'low'}
+		// croak "Unknown severity '$opts{min_severity}'";
+	my $mask= 0;
+	$mask |= $debug_source_bit{$_} // croak "Unknown debug message source '$_'"
+		for @{ $opts{sources} // [ keys %debug_source_bit ] };
+	return 0 unless __PACKAGE__->can('_gl_debug_enable');
+	return _gl_debug_enable($min, $mask, $opts{synchronous}? 1 : 0);
+}
+
+sub gl_debug_disable {
+	_gl_debug_disable() if gl_debug_active();
+}
+
+sub gl_debug_messages {
+	return unless gl_debug_active();
+	my @messages= _gl_debug_drain();
+	my $dropped= pop @messages;
+	push @messages, { source => 'other', type => 'other', severity => 'high', id => 0,
+		message => "$dropped GL debug messages were dropped" }
+		if $dropped;
+	return @messages;
+}
+
+sub _partition_debug_messages {
+	my (@errors, @others);
+	push @{ $_->{type} eq 'error'? \@errors : \@others }, $_ for @_;
+	return (\@errors, \@others);
+}
+
+sub _log_debug_messages {
+	for (@_) {
+		my $level= $_->{type} eq 'error'? 'error' : $debug_log_level{$_->{severity}};
+		$log->$level("GL $_->{source} $_->{type}: $_->{message}");
+	}
+}
+
+sub log_gl_debug_messages {
+	my ($errors, $others)= _partition_debug_messages(gl_debug_messages());
+	_log_debug_messages(@$errors, @$others);
+	return scalar @$errors;
+}
+
+=head2 Profiling GL Calls
+
+  gl_profile_enable();
+  ... # render some frames
+  print gl_profile_report();
+  my $stats= gl_profile_snapshot();
+  gl_profile_reset();
+
+The C functions of this module (L</set_uniform>, L</load_buffer_data>, C<mmap_buffer>,
+L<OpenGL::Sandbox::Texture/load>, and so on) can count their calls and measure the time
+spent in them, along with every GL function they call that is listed in
+C<inc/glducktape.list>.  This is turned on and off at runtime by swapping the table of GL
+function pointers, so it costs nothing while disabled.  Times are wall-clock time of the CPU
+side of each call; the GPU may finish the work later.  For GPU time, see
+L<OpenGL::Sandbox::Profiler>.
+
+GL functions missing from the list (like C<glGetIntegerv>) are linked directly and are not
+counted individually, but are included in the time of the wrapper that called them.  Nor are
+GL calls made from Perl through L<OpenGL::Modern> or L<OpenGL>.
+
+=over
+
+=item gl_profile_enable
+
+=item gl_profile_disable
+
+=item gl_profile_reset
+
+Set all counters to zero.
+
+=item gl_profile_snapshot
+
+Returns a hashref of the form
+
+  {
+    enabled   => $bool,
+    functions => { glBufferData => { calls => $n, seconds => $s }, ... },
+    wrappers  => { set_uniform  => { calls => $n, seconds => $s,
+                                     gl_calls => $n, gl_seconds => $s }, ... },
+  }
+
+Only entries that have been called are included.  For C<wrappers>, C<seconds> is the total
+time spent in the function and C<gl_seconds> the portion of that spent in counted GL calls.
+
+=item gl_profile_report
+
+Returns the snapshot formatted as a text table, sorted by time.
+
+=back
+
+=cut
+
+sub gl_profile_report {
+	my $snap= gl_profile_snapshot();
+	my $text= sprintf "%-30s %10s %12s %10s\n", 'GL function', 'calls', 'seconds', 'us/call';
+	my $f= $snap->{functions};
+	$text .= sprintf "%-30s %10d %12.6f %10.3f\n", $_, $f->{$_}{calls}, $f->{$_}{seconds},
+		$f->{$_}{seconds} / $f->{$_}{calls} * 1e6
+		for sort { $f->{$b}{seconds} <=> $f->{$a}{seconds} } keys %$f;
+	$text .= sprintf "\n%-30s %10s %12s %10s %12s\n", 'Wrapper', 'calls', 'seconds', 'GL calls', 'GL seconds';
+	my $w= $snap->{wrappers};
+	$text .= sprintf "%-30s %10d %12.6f %10d %12.6f\n", $_, @{$w->{$_}}{qw( calls seconds gl_calls gl_seconds )}
+		for sort { $w->{$b}{seconds} <=> $w->{$a}{seconds} } keys %$w;
+	$text;
+}
+
+=head2 Capturing GL Calls
+
+  gl_capture_start('/tmp/scene.gldt');
+  ... # render some frames
+  gl_capture_stop();
+
+  $ cc -O2 -o glducktape-replay inc/glducktape-replay.c -lEGL -lGL -ldl
+  $ ./glducktape-replay --repeat 10 /tmp/scene.gldt
+
+The same GL functions that can be profiled can also be written to a trace file, along with
+the data passed to them by pointer, such as buffer contents and uniform values.  Writes made
+through L<OpenGL::Sandbox::Buffer/mmap> are saved when the buffer is unmapped.
+L</next_frame> marks the end of each frame.
+
+The replayer in C<inc/glducktape-replay.c> is a standalone program which plays the trace on
+a headless EGL context (such as Mesa's surfaceless platform) and prints the time of each frame
+in tab-separated columns, followed by the mean, median, and worst frame.  Names of buffers,
+vertex arrays, queries, textures, shaders and programs are mapped to the ones created during
+replay, as are uniform locations.  Texture uploads save their pixels, or their offset if a
+pixel unpack buffer is bound.  Objects created outside of the trace don't exist there, and
+shaders and programs made through L<OpenGL::Sandbox::Shader> and L<OpenGL::Sandbox::Program>
+are among those, since their GL calls come from L<OpenGL::Modern>.  So for now this is mostly
+useful for measuring the cost of buffer and texture uploads and uniform changes between
+versions of your code or your driver.
+
+The file is in native byte order, and is not meant to be moved between architectures.
+
+=over
+
+=item gl_capture_start
+
+  gl_capture_start($filename);
+
+Begin writing GL calls to the file.  Dies if it can't be opened.  If a capture is already in
+progress, that file is closed first.
+
+=item gl_capture_frame
+
+Mark the end of a frame.  Called by L</next_frame>.  Does nothing unless capturing.
+
+=item gl_capture_stop
+
+Stop capturing and close the file.  Dies if any write failed.
+
+=item gl_capturing
+
+True while a capture is in progress.
+
+=back
+
+=head2 read_pixels_async
+
+  while (...) {
+    ... # render
+    if (my ($pixels, $w, $h)= read_pixels_async()) {
+      print $out $$pixels;  # the frame from two calls ago
+    }
+    next_frame;
+  }
+  while (my ($pixels, $w, $h)= read_pixels_async(flush => 1)) {
+    print $out $$pixels;
+  }
+
+Like C<glReadPixels>, but without waiting for the GPU to finish rendering.  Each call starts
+copying the current frame into one of a ring of pixel-pack buffers, and returns the oldest
+frame in the ring, whose copy has normally finished by then.  The first C<depth - 1> calls
+return an empty list.
+
+The pixels are returned as an L<OpenGL::Sandbox::MMap>-style read-only scalar ref pointing
+directly at the mapped buffer, along with its width and height.  Rows are bottom-up as GL
+stores them, with no padding between rows.  The scalar is only valid until the next call,
+at which point it becomes an empty string; copy C<$$pixels> if you need to keep it.
+To save the frames to disk without stalling the render loop, pass them to
+L<OpenGL::Sandbox::FrameWriter>.
+
+Requires OpenGL 3.2.  There is one ring per context.  Options:
+
+=over
+
+=item x, y, width, height
+
+The rectangle to read.  Defaults to the viewport.
+
+=item format, type
+
+Defaults to C<GL_RGBA>, C<GL_UNSIGNED_BYTE>.
+
+=item depth
+
+Size of the ring (2..8, default 3), so the frame returned is C<depth - 1> calls old.
+Changing it discards the frames in the ring.
+
+=item flush
+
+Don't read a new frame; just return the oldest remaining one, or an empty list when the ring
+is empty.
+
+=back
+
+=cut
+
+fieldhash my %pixel_read_ring;
+my $pixel_read_ring_no_context;
+
+sub read_pixels_async {
+	my %opts= (@_ == 1 && ref $_[0] eq 'HASH')? %{ $_[0] } : @_;
+	croak "read_pixels_async requires OpenGL 3.2" unless __PACKAGE__->can('_pixel_ring_new');
+	my $depth= $opts{depth} // 3;
+	# Each context gets [ $ring, $depth ]
+	my $entry= defined $current_context? \$pixel_read_ring{$current_context} : \$pixel_read_ring_no_context;
+	if (!$$entry || $$entry->[1] != $depth) {
+		return if $opts{flush};
+		$$entry= [ _pixel_ring_new($depth), $depth ];
+	}
+	my @frame= _pixel_ring_read($$entry->[0], $opts{x} // 0, $opts{y} // 0,
+		$opts{width} // 0, $opts{height} // 0, $opts{format} // 0, $opts{type} // 0, $opts{flush}? 1 : 0);
+	return wantarray? @frame : $frame[0];
+}
+
+sub OpenGL::Sandbox::PixelReadRing::DESTROY { _pixel_ring_free(shift) }
+sub OpenGL::Sandbox::FrameWriter::C::DESTROY { _frame_writer_free(shift) }
+sub OpenGL::Sandbox::Mesh::C::DESTROY { _mesh_free(shift) }
+
 # Pull in the C file and make sure it has all the C libs available
 use Devel::CheckOS 'os_is';
 use OpenGL::Sandbox::Inline do {
 	my $src_dir= abs_path(catpath( (splitpath(__FILE__))[0,1] ));
 	my $src= catdir($src_dir, 'Sandbox.c');
-	my $libs= os_is('MSWin32')? '-lopengl32 -lgdi32 -lmsimg32' : '-lGL';
+	my $libs= os_is('MSWin32')? '-lopengl32 -lgdi32 -lmsimg32' : '-lGL -lpthread';
 	# Inline::C can take a file path, but it mistakes Win32 absolute paths for C code,
 	# so just slurp the file directly.
 	$src= do { local $/= undef; open my $fh, '<', $src; <$fh> } if os_is('MSWin32');
@@ -476,14 +910,44 @@ I wrote some of my own.  They follow the pattern
 
 =item delete_vertex_arrays
 
+=item gen_queries
+
+=item delete_queries
+
 =back
 
+=head2 query_timestamp
+
+  query_timestamp( $query_id );
+
+Same as C<glQueryCounter($query_id, GL_TIMESTAMP)>.  Requires OpenGL 3.3.
+
+=head2 get_query_results
+
+  my @nanoseconds= get_query_results( @query_ids );
+
+Returns the 64-bit result of each query, or an empty list if the last one is not available
+yet.  This never waits for the GPU.
+
+=head2 gl_timestamp
+
+Returns the GPU's current time, in nanoseconds, from C<glGetInteger64v(GL_TIMESTAMP)>.
+
+=head2 bind_buffer
+
+  bind_buffer( $buffer_target, $buffer_id );
+
+Same as glBindBuffer, but made from C through the GL function table, so that it can be
+profiled and captured (see L</Capturing GL Calls>).
+
 =head2 load_buffer_data
 
   load_buffer_data( $buffer_target, $size, $data, $usage );
 
 Wrapper around glBufferData.  C<$size> may be undef, in which case it will use the length of
-C<$data>.  C<$usage> may also be undef, in which case it will default to C<GL_STATIC_DRAW>.
+C<$data>.  C<$data> may be undef if C<$size> is given, to allocate the buffer without
+initializing it.  C<$usage> may also be undef, in which case it will default to
+C<GL_STATIC_DRAW>.
 
 =head2 load_buffer_sub_data
 
@@ -491,7 +955,8 @@ C<$data>.  C<$usage> may also be undef, in which case it will default to C<GL_ST
 
 Wrapper around glBufferSubData.  C<$size> may be undef, in which case it uses the length of
 C<$data>.  C<$data_offset> is an optional offset from the start of C<$data> to avoid the
-need for substring operations on the perl side.
+need for substring operations on the perl side.  For other functions that take data, use
+L<OpenGL::Sandbox::MMap/slice> to pass part of a buffer without copying it.
 
 =head2 get_glsl_type_name
 
@@ -521,6 +986,7 @@ Set a named uniform of a program.  For OpenGL < 4.1 the program must be the acti
 C<$cache> is the value returned by L</get_program_uniforms>.  C<$value> can be a wide variety
 of things, but in general, must have a number of components that matches the size of the
 uniform being assigned; the values will be automatically packed into a buffer.
+A scalar-ref of already-packed data, such as an L<OpenGL::Sandbox::Mat4>, is used as-is.
 
 =cut
 
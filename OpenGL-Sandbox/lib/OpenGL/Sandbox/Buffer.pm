@@ -5,8 +5,8 @@ use Try::Tiny;
 use Log::Any '$log';
 use OpenGL::Sandbox::MMap;
 use OpenGL::Sandbox qw(
-	warn_gl_errors gen_buffers delete_buffers load_buffer_data load_buffer_sub_data
-	glBindBuffer GL_STATIC_DRAW
+	warn_gl_errors gen_buffers delete_buffers bind_buffer load_buffer_data load_buffer_sub_data
+	GL_STATIC_DRAW
 );
 
 # ABSTRACT: Wrapper object for OpenGL Buffer Object
@@ -117,7 +117,7 @@ sub bind {
 		$self->autoload(undef);
 	} else {
 		$log->debug('glBindBuffer '.$self->id) if $log->is_debug;
-		glBindBuffer($target, $self->id);
+		bind_buffer($target, $self->id);
 	}
 	$self;
 }
@@ -151,7 +151,7 @@ sub load {
 	$self->usage($usage);
 	my $target= $self->target // croak "No target specified for binding buffer";
 	$log->debug('glBindBuffer '.$self->id.', load_buffer_data') if $log->is_debug;
-	glBindBuffer($target, $self->id);
+	bind_buffer($target, $self->id);
 	load_buffer_data($target, undef, $data, $usage);
 	$self;
 }
@@ -159,7 +159,7 @@ sub load {
 sub load_at {
 	my ($self, $offset, $data, $src_offset, $src_length)= @_;
 	my $target= $self->target // croak "No target specified for binding buffer";
-	glBindBuffer($target, $self->id);
+	bind_buffer($target, $self->id);
 	load_buffer_sub_data($target, $offset, $src_length, $data, $src_offset);
 	$self;
 }
@@ -186,8 +186,27 @@ get mapped first.  This happens automatically on object destruction.  If automat
 destroyed on OpenGL < 4.5, it genertes a warning, since messing with global state during
 object destruction is a bad thing.
 
+Before unmapping, this waits for any L<OpenGL::Sandbox::ThreadPool> job that is still running,
+since it might be writing to the mapped memory.
+
 =cut
 
+=head2 view
+
+  my $positions= $buffer->view(type => 'vec3', stride => 32);
+
+Return an L<OpenGL::Sandbox::BufferView> of the current memory-map of this buffer, for typed
+access to its elements.  Dies if the buffer isn't mapped.  The view stops working when the
+buffer is unmapped.
+
+=cut
+
+sub view {
+	my $self= shift;
+	require OpenGL::Sandbox::BufferView;
+	OpenGL::Sandbox::BufferView->new($self, @_);
+}
+
 sub mmap {
 	my ($self, $mode, $offset, $length)= @_;
 	my $current= $self->_mmap;
@@ -0,0 +1,429 @@
+package OpenGL::Sandbox::BufferView;
+use strict;
+use warnings;
+use Carp;
+use Scalar::Util 'blessed';
+use OpenGL::Sandbox qw(
+	GL_BYTE GL_UNSIGNED_BYTE GL_SHORT GL_UNSIGNED_SHORT GL_INT GL_UNSIGNED_INT
+	GL_HALF_FLOAT GL_FLOAT GL_DOUBLE GL_ARRAY_BUFFER
+);
+
+# ABSTRACT: Typed element access to a mapped buffer or packed scalar
+# VERSION
+
+=head1 SYNOPSIS
+
+  my $mmap= $buffer->mmap('r+');
+  # interleaved position(vec3), normal(vec3), uv(vec2)
+  my $pos= OpenGL::Sandbox::BufferView->new($mmap, type => 'vec3', stride => 32);
+  my $uv=  OpenGL::Sandbox::BufferView->new($mmap, type => 'vec2', stride => 32, offset => 24);
+
+  my ($x, $y, $z)= $pos->get(7);
+  $pos->set(7, $x, $y + 1, $z);
+  $pos->slice(100, 50)->add(0, .1, 0);   # move 50 vertices up
+  $pos->add($velocity, $dt);              # pos += velocity * dt, element by element
+  $uv->scale(.5);
+  $buffer->unmap;
+
+  # normals as 2 normalized shorts, read and written as -1..1
+  my $packed= OpenGL::Sandbox::BufferView->new(\$bytes, type => 'int16', components => 2, normalized => 1);
+  $packed->encode_octahedral($normals);
+
+  # separate arrays into one vertex buffer, and the attributes to draw it
+  my $attrs= OpenGL::Sandbox::BufferView->interleave($vbo,
+    [ position => $pos_view, normal => { view => $nrm_view, type => 'int16', normalized => 1 }, uv => $uv_view ]);
+  my $vao= OpenGL::Sandbox::VertexArray->new(buffer => $vbo, attributes => $attrs);
+
+=head1 DESCRIPTION
+
+A BufferView describes an array of elements inside a block of bytes, such as a mapped GL
+buffer (L<OpenGL::Sandbox::Buffer/mmap>), an L<OpenGL::Sandbox::MMap>, or a plain perl
+string of packed data.  Each element has 1 to 4 components of one numeric type, and elements
+are L</stride> bytes apart, so a view can pick one attribute out of interleaved vertex data.
+
+Reading and writing through a view converts the numbers in C, directly in the buffer, without
+the C<substr> and C<pack> round-trips (and the warnings from writing to a mapped scalar) that
+would otherwise be needed.  The bulk operations L</fill>, L</scale>, L</add> and L</copy_from>
+process the whole view in one call.  L</slice> makes a view of a sub-range without copying
+anything.  L<OpenGL::Sandbox::ThreadPool> runs the same operations on several threads.
+
+The view holds a reference to the scalar, and checks on each call that its bytes are still
+there.  Once a GL buffer is unmapped, any use of its views dies, rather than touching memory
+that no longer belongs to the process.
+
+Integer types are rounded and clamped to their range when written, and half floats are
+rounded to the nearest value.  Integers are not normalized unless the view is L</normalized>;
+a C<uint8> of 255 reads as 255, or as 1.0 in a normalized view.  These are the same
+conversions GL makes for vertex attributes of those types, so a view can write quantized
+attributes (half floats, normalized bytes and shorts, or packed C<2_10_10_10> words) from
+float values, and read them back as such.
+
+=head1 CONSTRUCTOR
+
+=head2 new
+
+  my $view= OpenGL::Sandbox::BufferView->new($source, %options);
+
+C<$source> is an L<OpenGL::Sandbox::Buffer> (which must currently be mapped), an
+L<OpenGL::Sandbox::MMap>, or a reference to a scalar.  Options:
+
+=over
+
+=item type
+
+One of C<float> (C<float32>), C<double> (C<float64>), C<half> (C<float16>), C<int8>, C<uint8>,
+C<int16>, C<uint16>, C<int32>, C<uint32>, C<int2_10_10_10_rev>, C<uint2_10_10_10_rev>, or a
+GL type constant like C<GL_FLOAT>.  The names C<vec2>, C<vec3>, C<vec4>, C<ivec2> .. C<ivec4>
+and C<uvec2> .. C<uvec4> also set L</components>.  Default is C<float>.
+
+The C<2_10_10_10_rev> types pack x, y and z into 10 bits each and w into 2 bits of one 32-bit
+word, so they always have 4 components.
+
+=item components
+
+Number of values per element, 1..4.  Default is 1, or implied by the type.
+
+=item offset
+
+Byte offset of the first element.  Default is 0.
+
+=item stride
+
+Bytes from the start of one element to the start of the next.  Default is the size of one
+element, for tightly packed data.
+
+=item count
+
+Number of elements.  Default is as many as fit in the source.
+
+=item normalized
+
+If true, integer components are read and written as fractions of their range, like
+C<glVertexAttribPointer> with C<normalized>: -1..1 for signed types (the lowest integer also
+reads as -1) and 0..1 for unsigned types.  Values written outside that range are clamped.
+Float types are not affected.
+
+=back
+
+=cut
+
+# Not exported by every GL module
+use constant { GL_INT_2_10_10_10_REV => 0x8D9F, GL_UNSIGNED_INT_2_10_10_10_REV => 0x8368 };
+
+my %types= (
+	int2_10_10_10_rev => [ GL_INT_2_10_10_10_REV, 4 ], uint2_10_10_10_rev => [ GL_UNSIGNED_INT_2_10_10_10_REV, 4 ],
+	float => GL_FLOAT, float32 => GL_FLOAT, double => GL_DOUBLE, float64 => GL_DOUBLE,
+	half => GL_HALF_FLOAT, float16 => GL_HALF_FLOAT,
+	int8 => GL_BYTE, uint8 => GL_UNSIGNED_BYTE, int16 => GL_SHORT, uint16 => GL_UNSIGNED_SHORT,
+	int32 => GL_INT, uint32 => GL_UNSIGNED_INT,
+	(map +( "vec$_" => [ GL_FLOAT, $_ ], "ivec$_" => [ GL_INT, $_ ], "uvec$_" => [ GL_UNSIGNED_INT, $_ ] ), 2..4),
+);
+my %type_names= reverse map +($_ => ref $types{$_}? $types{$_}[0] : $types{$_}),
+	qw( float double half int8 uint8 int16 uint16 int32 uint32 int2_10_10_10_rev uint2_10_10_10_rev );
+my %type_size= ( GL_BYTE, 1, GL_UNSIGNED_BYTE, 1, GL_SHORT, 2, GL_UNSIGNED_SHORT, 2, GL_HALF_FLOAT, 2,
+	GL_INT, 4, GL_UNSIGNED_INT, 4, GL_FLOAT, 4, GL_DOUBLE, 8 );
+
+sub new {
+	my ($class, $source, %opts)= @_;
+	if (blessed($source) && $source->isa('OpenGL::Sandbox::Buffer')) {
+		$source->_mmap or croak "Buffer is not mapped";
+		$source= $source->mmap;
+	}
+	my ($type, $components)= _parse_type($opts{type} // 'float', $opts{components});
+	OpenGL::Sandbox::_view_new($source, $type, $components,
+		$opts{offset} // 0, $opts{stride} // 0, $opts{count} // -1, $opts{normalized}? 1 : 0);
+}
+
+# Resolve a type name (or GL constant) and optional component count to (type, components)
+sub _parse_type {
+	my ($type, $components)= @_;
+	unless ($type =~ /^[0-9]+\z/) {
+		my $t= $types{$type} // croak "Unknown type '$type'";
+		if (ref $t) { ($type, $components)= ($t->[0], $components // $t->[1]) }
+		else { $type= $t }
+	}
+	return ($type, $components // 1);
+}
+
+# Bytes of one element of a type constant
+sub _elem_size {
+	my ($type, $components)= @_;
+	return 4 if $type == GL_INT_2_10_10_10_REV || $type == GL_UNSIGNED_INT_2_10_10_10_REV;
+	($type_size{$type} // croak "Unknown type $type") * $components;
+}
+
+=head1 ATTRIBUTES
+
+=head2 type
+
+The GL type constant of the components.
+
+=head2 type_name
+
+The name of the type, like C<'float'> or C<'uint16'>.
+
+=head2 components
+
+=head2 offset
+
+=head2 stride
+
+=head2 count
+
+=head2 normalized
+
+These are read-only.
+
+=cut
+
+sub type       { (OpenGL::Sandbox::_view_info($_[0]))[0] }
+sub type_name  { $type_names{ $_[0]->type } }
+sub components { (OpenGL::Sandbox::_view_info($_[0]))[1] }
+sub offset     { (OpenGL::Sandbox::_view_info($_[0]))[2] }
+sub stride     { (OpenGL::Sandbox::_view_info($_[0]))[3] }
+sub normalized { (OpenGL::Sandbox::_view_info($_[0]))[5] }
+*count= \&OpenGL::Sandbox::_view_count;
+
+=head1 METHODS
+
+=head2 get
+
+  my @values= $view->get($index);
+
+Return the components of one element.  Negative indexes count from the end.
+
+=head2 set
+
+  $view->set($index, @values);
+
+Write the components of one element.
+
+=head2 get_all
+
+  my @values= $view->get_all;
+
+Return the components of every element, as one flat list.
+
+=cut
+
+*get= \&OpenGL::Sandbox::_view_get;
+*set= \&OpenGL::Sandbox::_view_set;
+*get_all= \&OpenGL::Sandbox::_view_get_all;
+
+=head2 fill
+
+  $view->fill($value);
+  $view->fill(@values);   # one per component
+
+Set every element to the same value.
+
+=head2 scale
+
+  $view->scale($factor);
+  $view->scale(@factors);   # one per component
+
+Multiply every element.
+
+=head2 add
+
+  $view->add($offset);
+  $view->add(@offsets);       # one per component
+  $view->add($other_view);
+  $view->add($other_view, $factor);
+
+Add a constant to every element, or add the elements of another view with the same number of
+components (multiplied by C<$factor>, default 1), element by element.  When adding a view, only
+as many elements as the shorter view has are changed.
+
+=head2 copy_from
+
+  $view->copy_from($other_view);
+  $view->copy_from([ $x0, $y0, $z0, $x1, $y1, $z1, ... ]);
+  $view->copy_from([ [ $x0, $y0, $z0 ], [ $x1, $y1, $z1 ], ... ]);
+
+Overwrite elements starting from the first, converting from the other view's type if needed.
+Copies as many elements as the shorter of the two has, even if the views overlap.  Returns the
+number of elements copied.
+
+=head2 slice
+
+  my $sub= $view->slice($start);
+  my $sub= $view->slice($start, $count);
+
+Return a view of C<$count> elements (default, the rest) starting from element C<$start>,
+sharing the same bytes.
+
+=cut
+
+sub fill  { &OpenGL::Sandbox::_view_fill; $_[0] }
+sub scale { &OpenGL::Sandbox::_view_scale; $_[0] }
+
+sub add {
+	my $self= shift;
+	if (blessed($_[0]) && $_[0]->isa(__PACKAGE__)) {
+		OpenGL::Sandbox::_view_combine($self, 1, $_[0], $_[1] // 1);
+	} else {
+		OpenGL::Sandbox::_view_add($self, @_);
+	}
+	$self;
+}
+
+sub copy_from {
+	my ($self, $src)= @_;
+	return OpenGL::Sandbox::_view_combine($self, 0, $src, 1)
+		if blessed($src) && $src->isa(__PACKAGE__);
+	OpenGL::Sandbox::_view_copy_from_array($self, $src);
+}
+
+sub slice { OpenGL::Sandbox::_view_slice($_[0], $_[1], $_[2] // -1) }
+
+=head2 encode_octahedral
+
+  $oct_view->encode_octahedral($normal_view);
+
+Write the unit vectors of a view of 3 or 4 components as 2 components of octahedral encoding,
+which spreads the precision of the stored numbers evenly over the sphere.  In a normalized
+C<int16> view this is a normal in 4 bytes within a few thousandths of a degree, or in C<int8>
+one of 2 bytes with under a degree.  This view must have 2 components.  Returns the number of
+elements written, which is the smaller of the two counts.  The views must not overlap, unless
+they start at the same byte with the same stride, in which case each element is converted in
+place.  (The shader decodes with C<< n= vec3(e, 1-abs(e.x)-abs(e.y)); t= max(-n.z, 0);
+n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0))); normalize(n) >>.)
+
+=head2 decode_octahedral
+
+  $normal_view->decode_octahedral($oct_view);
+
+The reverse of L</encode_octahedral>, into a view of 3 components, or 4 with w of 0.
+
+=cut
+
+sub encode_octahedral { OpenGL::Sandbox::_view_oct_encode($_[0], $_[1]) }
+sub decode_octahedral { OpenGL::Sandbox::_view_oct_decode($_[0], $_[1]) }
+
+=head1 CLASS METHODS
+
+=head2 interleave
+
+  my $attrs= OpenGL::Sandbox::BufferView->interleave($target, \@streams, %options);
+
+Copy several views, such as separate arrays of positions, normals and texture coordinates,
+into one buffer of interleaved vertices, and return the L<OpenGL::Sandbox::VertexArray/attributes>
+that describe it.  C<@streams> is a list of attribute names and views, in the order they are
+stored in each vertex.  Instead of a view, an attribute can be a hashref of C<view> and any of
+C<type>, C<components> and C<normalized> to store it in a different format, converting as
+L</copy_from> does; by default each attribute has the format of its view.  Attributes with
+the same format as their view are copied as bytes.  The vertex count is the smallest count of
+the views.
+
+C<$target> is a mapped L<OpenGL::Sandbox::Buffer>, an L<OpenGL::Sandbox::MMap>, or a scalar
+ref, which is extended if it's too short.  An L<OpenGL::Sandbox::Buffer> that isn't mapped is
+allocated to the size of the vertices (with C<usage>, and C<target> defaulting to
+C<GL_ARRAY_BUFFER>), mapped, written, and unmapped.  Options:
+
+=over
+
+=item offset
+
+Byte offset of the first vertex.  Default is 0.
+
+=item stride
+
+Bytes from one vertex to the next.  Default is the size of the attributes, each starting at
+a multiple of 4 bytes.
+
+=item pool
+
+An L<OpenGL::Sandbox::ThreadPool> to divide the vertices among.
+
+=item buffer
+
+A value for the C<buffer> of each returned attribute.
+
+=item usage
+
+The usage when allocating an unmapped buffer.
+
+=back
+
+=head2 deinterleave
+
+  my $n= OpenGL::Sandbox::BufferView->deinterleave($source, $attrs, \%targets, %options);
+
+The reverse of L</interleave>: copy attributes out of interleaved vertices in C<$source> (a
+mapped L<OpenGL::Sandbox::Buffer>, an L<OpenGL::Sandbox::MMap>, or a scalar ref) into the
+views of C<%targets>, whose keys are attribute names of C<$attrs>.  C<$attrs> is a hashref of
+L<OpenGL::Sandbox::VertexArray/attributes>, like the one from L</interleave>, or a
+VertexArray.  The target views can have another type than the attribute, and are converted.
+Options are C<offset> (added to each attribute's C<pointer>) and C<pool>.  Returns the number
+of vertices copied, which is limited by the shortest view.
+
+=cut
+
+sub interleave {
+	my ($class, $target, $streams, %opts)= @_;
+	my @spec= @$streams;
+	my ($ofs, @layout)= (0);
+	while (my ($name, $spec)= splice @spec, 0, 2) {
+		$spec= { view => $spec } if blessed $spec;
+		my $src= $spec->{view};
+		croak "Attribute '$name' needs a view" unless blessed($src) && $src->isa(__PACKAGE__);
+		my ($type, $components)= defined $spec->{type}
+			? _parse_type($spec->{type}, $spec->{components} // $src->components)
+			: ($src->type, $spec->{components} // $src->components);
+		push @layout, { name => $name, src => $src, type => $type, size => $components,
+			normalized => $spec->{normalized} // $src->normalized, offset => $ofs };
+		$ofs += (_elem_size($type, $components) + 3) & ~3;
+	}
+	croak "No attributes to interleave" unless @layout;
+	my $stride= $opts{stride} // $ofs;
+	my $count= $layout[0]{src}->count;
+	for (@layout) { $count= $_->{src}->count if $_->{src}->count < $count }
+	my $offset= $opts{offset} // 0;
+	my $size= $offset + $count * $stride;
+	my $unmap;
+	if (blessed($target) && $target->isa('OpenGL::Sandbox::Buffer') && !$target->_mmap) {
+		$target->target(GL_ARRAY_BUFFER) unless $target->target;
+		$target->usage($opts{usage}) if defined $opts{usage};
+		$target->bind;
+		OpenGL::Sandbox::load_buffer_data($target->target, $size, undef, $target->usage);
+		$target->mmap('w');
+		$unmap= 1;
+	}
+	elsif (ref $target eq 'SCALAR' && length($$target // '') < $size) {
+		$$target .= "\0" x ($size - length($$target // ''));
+	}
+	OpenGL::Sandbox::_view_copy_streams($opts{pool}, map +(
+		$class->new($target, type => $_->{type}, components => $_->{size}, normalized => $_->{normalized},
+			offset => $offset + $_->{offset}, stride => $stride, count => $count),
+		$_->{src}
+	), @layout);
+	$target->unmap if $unmap;
+	return { map +($_->{name} => {
+		size => $_->{size},
+		type => $_->{type},
+		normalized => $_->{normalized}? 1 : 0,
+		stride => $stride,
+		pointer => $offset + $_->{offset},
+		(defined $opts{buffer}? ( buffer => $opts{buffer} ) : ()),
+	}), @layout };
+}
+
+sub deinterleave {
+	my ($class, $source, $attrs, $targets, %opts)= @_;
+	$attrs= $attrs->attributes if blessed($attrs) && $attrs->can('attributes');
+	my @pairs;
+	for my $name (sort keys %$targets) {
+		my $attr= $attrs->{$name} or croak "No attribute '$name'";
+		my ($type, $components)= _parse_type($attr->{type} // GL_FLOAT, $attr->{size});
+		push @pairs, $targets->{$name}, $class->new($source, type => $type, components => $components,
+			normalized => $attr->{normalized}, stride => $attr->{stride} // 0,
+			offset => ($opts{offset} // 0) + ($attr->{pointer} // 0));
+	}
+	croak "No attributes to deinterleave" unless @pairs;
+	OpenGL::Sandbox::_view_copy_streams($opts{pool}, @pairs);
+}
+
+sub DESTROY { OpenGL::Sandbox::_view_free(shift) }
+
+1;
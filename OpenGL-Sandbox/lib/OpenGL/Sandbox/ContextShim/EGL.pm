@@ -0,0 +1,114 @@
+package OpenGL::Sandbox::ContextShim::EGL;
+use strict;
+use warnings;
+use Carp;
+use Scalar::Util qw/ refaddr weaken /;
+use OpenGL::Sandbox qw/ glGetString glFlush GL_VERSION /;
+
+# ABSTRACT: Create a headless OpenGL context with EGL
+# VERSION
+
+our %instances;
+sub new {
+	my $class= shift;
+	my %opts= ref $_[0] eq 'HASH'? %{$_[0]} : @_;
+	# Mesa reads this when the display is initialized
+	$ENV{LIBGL_ALWAYS_SOFTWARE}= 1 if $opts{software};
+	my $cx= OpenGL::Sandbox::_headless_context_new('EGL',
+		$opts{width} // 640, $opts{height} // 480, $opts{gl_version},
+		$opts{profile} // '', $opts{debug}? 1 : 0, $opts{platform});
+	my $self= bless { context => $cx }, $class;
+	weaken($instances{refaddr $self}= $self);
+	return $self;
+}
+
+sub DESTROY {
+	delete $instances{refaddr $_[0]};
+}
+
+END {
+	delete $_->{context} for values %instances;
+}
+
+sub context { shift->{context} }
+
+sub make_current {
+	my $self= shift;
+	OpenGL::Sandbox::_headless_context_make_current($self->context);
+	OpenGL::Sandbox::current_context($self);
+}
+
+sub context_info {
+	my $self= shift;
+	sprintf("%s, OpenGL version %s\n",
+		OpenGL::Sandbox::_headless_context_info($self->context), glGetString(GL_VERSION));
+}
+
+# There is nothing to display, but flush so that frames are timed the same as with a window
+sub swap_buffers {
+	glFlush();
+}
+
+1;
+
+=head1 DESCRIPTION
+
+This class is loaded automatically if needed by L<OpenGL::Sandbox/make_context>, or when
+requested with C<< provider => 'EGL' >>.  It creates an OpenGL context rendering into an
+off-screen pbuffer, with no window system, so that it works on servers with no display.
+C<libEGL> is loaded at runtime, so it is not needed to build this module.
+
+The display is chosen from the first of these that works, or from the one named by the
+C<platform> option:
+
+=over
+
+=item surfaceless
+
+Mesa's C<EGL_MESA_platform_surfaceless>, which uses the first GPU render node, or llvmpipe
+if there is none.
+
+=item device
+
+The first device from C<EGL_EXT_device_enumeration>, as provided by the NVIDIA driver.
+
+=item default
+
+C<eglGetDisplay(EGL_DEFAULT_DISPLAY)>
+
+=back
+
+For repeatable results from a CPU renderer, pass C<< software => 1 >>, which sets
+C<LIBGL_ALWAYS_SOFTWARE> so that Mesa uses llvmpipe even when a GPU is present.  This only
+has an effect on the first context created by the process.
+
+=head1 ATTRIBUTES
+
+=head2 context
+
+The C<OpenGL::Sandbox::HeadlessContext> which holds the EGL handles.
+
+=head1 METHODS
+
+=head2 Standard ContextShim API:
+
+=over 14
+
+=item new
+
+Accepting the options C<width>, C<height> (of the pbuffer, default 640x480), C<gl_version>,
+C<profile>, C<debug>, and the EGL-specific C<platform> and C<software>.
+
+=item context_info
+
+=item swap_buffers
+
+Calls glFlush.
+
+=back
+
+=head2 make_current
+
+Make this the current context, for programs which create more than one.
+
+=cut
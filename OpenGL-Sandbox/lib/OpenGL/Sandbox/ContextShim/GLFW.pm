@@ -7,6 +7,8 @@ use OpenGL::GLFW qw/ glfwInit glfwGetVersionString glfwTerminate NULL GLFW_TRUE
 	glfwGetPrimaryMonitor glfwCreateWindow glfwMakeContextCurrent glfwDestroyWindow
 	glfwSwapInterval glfwSwapBuffers glfwPollEvents
 	glfwWindowHint GLFW_VISIBLE GLFW_DECORATED GLFW_MAXIMIZED GLFW_DOUBLEBUFFER
+	GLFW_OPENGL_DEBUG_CONTEXT GLFW_CONTEXT_VERSION_MAJOR GLFW_CONTEXT_VERSION_MINOR
+	GLFW_OPENGL_PROFILE GLFW_OPENGL_CORE_PROFILE GLFW_OPENGL_COMPAT_PROFILE GLFW_OPENGL_ANY_PROFILE
 	/;
 use OpenGL::Sandbox qw/ glGetString GL_VERSION /;
 
@@ -26,6 +28,14 @@ sub new {
 	
 	glfwWindowHint(GLFW_VISIBLE, ($opts{visible} // 1)? GLFW_TRUE : GLFW_FALSE);
 	glfwWindowHint(GLFW_DECORATED, $opts{noframe}? GLFW_FALSE : GLFW_TRUE);
+	glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, $opts{debug}? GLFW_TRUE : GLFW_FALSE);
+	my ($major, $minor)= split /\./, $opts{gl_version} // '1.0';
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, $major);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, $minor // 0);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, !$opts{profile}? GLFW_OPENGL_ANY_PROFILE
+		: $opts{profile} eq 'core'? GLFW_OPENGL_CORE_PROFILE
+		: $opts{profile} eq 'compat'? GLFW_OPENGL_COMPAT_PROFILE
+		: croak "Unknown GL profile '$opts{profile}'");
 	#glfwWindowHint(GLFW_MAXIMIZED, $opts{fullscreen}? GLFW_TRUE : GLFW_FALSE);
 	
 	my $w= glfwCreateWindow(
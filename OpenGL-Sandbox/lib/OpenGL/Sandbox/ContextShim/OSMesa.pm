@@ -0,0 +1,95 @@
+package OpenGL::Sandbox::ContextShim::OSMesa;
+use strict;
+use warnings;
+use Carp;
+use Scalar::Util qw/ refaddr weaken /;
+use OpenGL::Sandbox qw/ glGetString glFlush GL_VERSION /;
+
+# ABSTRACT: Create a headless OpenGL context with OSMesa
+# VERSION
+
+our %instances;
+sub new {
+	my $class= shift;
+	my %opts= ref $_[0] eq 'HASH'? %{$_[0]} : @_;
+	my $cx= OpenGL::Sandbox::_headless_context_new('OSMesa',
+		$opts{width} // 640, $opts{height} // 480, $opts{gl_version},
+		$opts{profile} // '', $opts{debug}? 1 : 0, undef);
+	my $self= bless { context => $cx }, $class;
+	weaken($instances{refaddr $self}= $self);
+	return $self;
+}
+
+sub DESTROY {
+	delete $instances{refaddr $_[0]};
+}
+
+END {
+	delete $_->{context} for values %instances;
+}
+
+sub context { shift->{context} }
+
+sub make_current {
+	my $self= shift;
+	OpenGL::Sandbox::_headless_context_make_current($self->context);
+	OpenGL::Sandbox::current_context($self);
+}
+
+sub context_info {
+	my $self= shift;
+	sprintf("%s, OpenGL version %s\n",
+		OpenGL::Sandbox::_headless_context_info($self->context), glGetString(GL_VERSION));
+}
+
+# There is nothing to display, but flush so that frames are timed the same as with a window
+sub swap_buffers {
+	glFlush();
+}
+
+1;
+
+=head1 DESCRIPTION
+
+This class is loaded when requested with C<< provider => 'OSMesa' >>.  It creates an
+OpenGL context with Mesa's off-screen renderer, which draws into a buffer in main memory
+using only the CPU, so the output is the same on every machine with the same Mesa version.
+C<libOSMesa> is loaded at runtime, so it is not needed to build this module.
+
+While an OSMesa context exists, the GL functions used by this module's C code are looked up
+with C<OSMesaGetProcAddress> instead of through C<libGL>.  However, GL 1.1 functions (and
+those called through L<OpenGL::Modern>) are still linked to C<libGL>, and only reach OSMesa
+if C<libGL> is Mesa's own library built with a shared glapi, rather than the GLVND
+dispatcher found on most current distributions.  Prefer L<OpenGL::Sandbox::ContextShim::EGL>
+(with C<< software => 1 >>) where EGL is available.
+
+=head1 ATTRIBUTES
+
+=head2 context
+
+The C<OpenGL::Sandbox::HeadlessContext> which holds the OSMesa context and its buffer.
+
+=head1 METHODS
+
+=head2 Standard ContextShim API:
+
+=over 14
+
+=item new
+
+Accepting the options C<width>, C<height> (of the buffer, default 640x480), C<gl_version>,
+and C<profile>.
+
+=item context_info
+
+=item swap_buffers
+
+Calls glFlush.
+
+=back
+
+=head2 make_current
+
+Make this the current context, for programs which create more than one.
+
+=cut
@@ -0,0 +1,179 @@
+package OpenGL::Sandbox::FrameWriter;
+use Moo;
+use Carp;
+use OpenGL::Sandbox ();
+
+# ABSTRACT: Write captured frames to disk on a background thread
+# VERSION
+
+=head1 SYNOPSIS
+
+  use OpenGL::Sandbox qw( :all );
+  use OpenGL::Sandbox::FrameWriter;
+  my $writer= OpenGL::Sandbox::FrameWriter->new(
+    path => 'out.y4m', width => 1280, height => 720, fps => 60
+  );
+  while (...) {
+    ... # render
+    if (my ($pixels)= read_pixels_async()) {
+      $writer->write($pixels);
+    }
+    next_frame;
+  }
+  while (my ($pixels)= read_pixels_async(flush => 1)) {
+    $writer->write($pixels);
+  }
+  $writer->close;
+  printf "%d frames, %d dropped\n", $writer->frames_written, $writer->frames_dropped;
+
+=head1 DESCRIPTION
+
+This saves a sequence of RGBA frames, such as the ones returned by
+L<OpenGL::Sandbox/read_pixels_async>, as a raw video stream, a YUV4MPEG2 (Y4M) file, or a
+series of numbered PNG images.  L</write> copies the frame into a queue and returns
+immediately; a C thread converts and writes the frames in the order they arrived, so the
+render loop never waits on the disk.  When the disk can't keep up, L</on_full> decides
+whether frames are dropped or L</write> waits for room in the queue.
+
+Frames are expected bottom-up, as GL returns them, and are flipped to top-down while being
+written unless L</flip> is false.
+
+=head1 ATTRIBUTES
+
+=head2 path
+
+File name to write.  For C<png>, this must contain a C<%d> (or C<%05d> or similar), which
+is replaced by the frame number, starting from 0.
+
+=head2 format
+
+One of:
+
+=over
+
+=item raw
+
+Frames as-is, one after another.  Play or encode them with
+
+  ffmpeg -f rawvideo -pixel_format rgba -video_size 1280x720 -framerate 60 -i out.raw out.mp4
+
+=item y4m
+
+YUV 4:2:0 (full-range BT.601) in a YUV4MPEG2 stream, which ffmpeg, mpv and x264 read
+directly.  The width and height must be even.
+
+=item png
+
+One RGBA PNG per frame.  These are stored uncompressed, to keep the writer fast and free of
+a zlib dependency, so they are larger than usual.
+
+=back
+
+Defaults to the extension of L</path>.
+
+=head2 width
+
+=head2 height
+
+Size of each frame, in pixels.  Required.
+
+=head2 fps
+
+Frame rate recorded in the Y4M header.  Default is 60.  Non-integer rates are written as a
+ratio over 1001, so 29.97 becomes 30000:1001.
+
+=head2 queue_size
+
+Number of frames that may be waiting to be written.  Default is 8, maximum 64.  Each holds
+C<width * height * 4> bytes.
+
+=head2 on_full
+
+What L</write> does when the queue is full: C<'drop'> (the default) discards the new frame,
+and C<'block'> waits until the writer thread has made room.
+
+=head2 flip
+
+Whether to flip frames vertically.  Default is true.
+
+=cut
+
+has path       => ( is => 'ro', required => 1 );
+has format     => ( is => 'lazy' );
+has width      => ( is => 'ro', required => 1 );
+has height     => ( is => 'ro', required => 1 );
+has fps        => ( is => 'ro', default => 60 );
+has queue_size => ( is => 'ro', default => 8 );
+has on_full    => ( is => 'ro', default => 'drop' );
+has flip       => ( is => 'ro', default => 1 );
+has _writer    => ( is => 'lazy' );
+has _stats     => ( is => 'rw' );
+
+sub _build_format {
+	my $self= shift;
+	my ($ext)= ($self->path =~ /\.(\w+)\z/) or croak "Can't guess format of ".$self->path;
+	$ext= lc $ext;
+	$ext =~ /^(raw|rgba|y4m|png)\z/ or croak "Unknown frame format '$ext'";
+	return $ext eq 'rgba'? 'raw' : $ext;
+}
+
+sub _build__writer {
+	my $self= shift;
+	$self->on_full =~ /^(drop|block)\z/ or croak "on_full must be 'drop' or 'block'";
+	OpenGL::Sandbox::_frame_writer_new($self->path, $self->format, $self->width, $self->height,
+		$self->fps, $self->queue_size, $self->on_full eq 'block'? 1 : 0, $self->flip? 1 : 0);
+}
+
+sub BUILD {
+	# Open the file now, so that errors are reported by the constructor
+	shift->_writer;
+}
+
+=head1 METHODS
+
+=head2 write
+
+  $writer->write($pixels) or warn "dropped a frame";
+
+Queue one frame.  C<$pixels> is a scalar or scalar-ref of exactly C<width * height * 4>
+bytes, which is copied before this returns.  Returns true if the frame was queued, or false
+if it was dropped because the queue was full.  Dies if an earlier write to disk failed.
+
+=head2 close
+
+Wait for the queued frames to be written, and close the file.  Dies if any write failed.
+This happens automatically when the object is destroyed, but then errors are lost.
+
+=head2 frames_written
+
+=head2 frames_dropped
+
+=head2 frames_queued
+
+Counts of frames written to disk so far, discarded by L</on_full>, and waiting in the queue.
+
+=cut
+
+sub write {
+	my ($self, $pixels)= @_;
+	croak "FrameWriter is closed" if $self->_stats;
+	OpenGL::Sandbox::_frame_writer_push($self->_writer, $pixels);
+}
+
+sub close {
+	my $self= shift;
+	return $self if $self->_stats;
+	my $w= $self->_writer;
+	my $ok= eval { OpenGL::Sandbox::_frame_writer_close($w); 1 };
+	my $err= $@;
+	$self->_stats([ OpenGL::Sandbox::_frame_writer_stats($w) ]);
+	die $err unless $ok;
+	$self;
+}
+
+sub _stat { $_[0]->_stats? $_[0]->_stats->[$_[1]] : (OpenGL::Sandbox::_frame_writer_stats($_[0]->_writer))[$_[1]] }
+sub frames_written { $_[0]->_stat(0) }
+sub frames_dropped { $_[0]->_stat(1) }
+sub frames_queued  { $_[0]->_stat(2) }
+
+1;
@@ -9,6 +9,7 @@ use File::Map 'map_file';
 =head1 SYNOPSIS
 
   my $mmap= OpenGL::Sandbox::MMap->new("Filename.ttf");
+  my $mesh= OpenGL::Sandbox::MMap->new("level.dat")->slice($offset, $length);
 
 =head1 DESCRIPTION
 
@@ -16,6 +17,9 @@ This is a simple wrapper around File::Map to make it more convenient to open
 read-only memory-mapped files, and to make sure they are distinctly held as
 references and not accidentally copied into perl scalars.
 
+The same class is used for mapped GL buffers (L<OpenGL::Sandbox::Buffer/mmap>) and for
+L</slice>s of either kind.
+
 =head1 ATTRIBUTES
 
 =head2 size
@@ -31,10 +35,30 @@ Number of bytes mapped from file.  Same as C<length($$mmap)>
 Return a blessed reference to a scalar which points to memory-mapped data.
 C<$filename> is always opened read-only.
 
+=head2 slice
+
+  my $part= $mmap->slice($offset);
+  my $part= $mmap->slice($offset, $length);
+
+Return a new MMap object for a range of this one's bytes, without copying them.  C<$offset>
+and C<$length> work like C<substr>, but the range must lie inside the buffer.  The slice can
+be passed anywhere an MMap is accepted, such as L<OpenGL::Sandbox/load_buffer_data>,
+L<OpenGL::Sandbox::Texture/load>, or a font's C<data>.
+
+The slice holds a reference to this object, so the file stays mapped until both are gone.
+A slice of a mapped GL buffer becomes empty when the buffer is unmapped.  A slice of a
+read-only mapping is read-only.  Slicing an ordinary perl string is only allowed if it is
+read-only, since its buffer could otherwise be reallocated.
+
 =cut
 
 sub size { length(${(shift)}) }
 
+sub slice {
+	require OpenGL::Sandbox;
+	OpenGL::Sandbox::_mmap_slice($_[0], $_[1] // 0, $_[2]);
+}
+
 sub new {
 	my ($class, $fname)= @_;
 	my $map;
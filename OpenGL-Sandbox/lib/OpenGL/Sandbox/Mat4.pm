@@ -0,0 +1,220 @@
+package OpenGL::Sandbox::Mat4;
+use strict;
+use warnings;
+use Carp;
+use OpenGL::Sandbox ();
+
+# ABSTRACT: 4x4 float matrix for shader pipelines
+# VERSION
+
+=head1 SYNOPSIS
+
+  my $proj= OpenGL::Sandbox::Mat4->perspective(60, $w/$h, .1, 100);
+  my $mv= OpenGL::Sandbox::Mat4->new->trans(0, 0, -5)->rotate(y => $angle)->scale(2);
+  $program->set_uniform(u_mvp => $proj->clone->mul($mv));
+
+  # transform an array of packed xyz points into packed xyzw points
+  my $packed_xyzw= $mv->transform_points(pack('f*', @xyz), 3, 4);
+
+=head1 DESCRIPTION
+
+This object is a blessed reference to a scalar holding 16 packed floats, in the column-major
+order used by OpenGL.  Because it is a scalar-ref of packed data, it can be passed directly
+to L<OpenGL::Sandbox::Program/set_uniform> or
+L<OpenGL::Sandbox/load_buffer_sub_data> without unpacking.  The math is performed in C
+with SSE or NEON instructions where available.
+
+The transformation methods use the same vocabulary as L<OpenGL::Sandbox::V1>, and like the
+fixed-function API they modify the matrix in place by multiplying on the right.  They all
+return the object, for chaining.  When called as a class method, they start from a new
+identity matrix.
+
+See L<OpenGL::Sandbox::MatrixStack> for a push/pop stack of these.
+
+=head1 CONSTRUCTOR
+
+=head2 new
+
+  my $m= OpenGL::Sandbox::Mat4->new;             # identity
+  my $m= OpenGL::Sandbox::Mat4->new(@floats16);  # column-major
+  my $m= OpenGL::Sandbox::Mat4->new($packed);    # 64 bytes of packed floats
+
+=head2 clone
+
+Return a new matrix with a copy of the data.
+
+=cut
+
+my $identity= pack('f16', 1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1);
+
+sub new {
+	my $class= shift;
+	my $data= !@_? $identity
+		: @_ == 16? pack('f16', @_)
+		: @_ == 1 && length($_[0]) == 64? $_[0]
+		: croak "Expected 16 values or a packed string of 16 floats";
+	bless \$data, ref $class || $class;
+}
+
+sub clone { my $data= ${$_[0]}; bless \$data, ref $_[0]; }
+
+=head1 METHODS
+
+=head2 get
+
+  my @floats= $m->get;
+
+Return the 16 values, in column-major order.
+
+=head2 identity
+
+Reset to the identity matrix.
+
+=head2 trans
+
+  $m->trans($x, $y);
+  $m->trans($x, $y, $z);
+
+Translate by x,y or x,y,z.  Alias C<translate>.
+
+=head2 scale
+
+  $m->scale($xyz);
+  $m->scale($x, $y);     # z=1
+  $m->scale($x, $y, $z);
+
+=head2 trans_scale
+
+  $m->trans_scale($x, $y, $z, $s);
+  $m->trans_scale($x, $y, $z, $sx, $sy, $sz);
+
+=head2 rotate
+
+  $m->rotate($degrees, $x, $y, $z);
+  $m->rotate(x => $degrees);
+
+Rotate around an arbitrary axis or the named axis.
+
+=head2 mirror
+
+  $m->mirror('xz');
+
+Invert one or more axes.
+
+=head2 mul
+
+  $m->mul($other);   # $m = $m * $other
+
+=head2 transpose
+
+=head2 invert
+
+Invert the matrix.  Dies if the matrix is singular.
+
+=cut
+
+sub get { unpack 'f16', ${$_[0]} }
+
+sub _self { ref $_[0]? $_[0] : $_[0]->new }
+
+sub identity { my $self= _self(shift); OpenGL::Sandbox::_mat4_identity($self); $self }
+
+sub trans {
+	my $self= _self(shift);
+	OpenGL::Sandbox::_mat4_translate($self, $_[0], $_[1], $_[2] // 0);
+	$self;
+}
+sub translate { goto &trans }
+
+sub scale {
+	my $self= _self(shift);
+	OpenGL::Sandbox::_mat4_scale($self, @_ == 1? ($_[0], $_[0], $_[0]) : ($_[0], $_[1], $_[2] // 1));
+	$self;
+}
+
+sub trans_scale {
+	my $self= _self(shift);
+	OpenGL::Sandbox::_mat4_translate($self, @_[0..2]);
+	OpenGL::Sandbox::_mat4_scale($self, @_ == 4? ($_[3], $_[3], $_[3]) : ($_[3], $_[4], $_[5] // 1));
+	$self;
+}
+
+my %axis= ( x => [1,0,0], y => [0,1,0], z => [0,0,1] );
+sub rotate {
+	my $self= _self(shift);
+	if (@_ == 2) {
+		my $axis= $axis{$_[0]} or croak "wrong arguments to rotate";
+		OpenGL::Sandbox::_mat4_rotate($self, $_[1], @$axis);
+	}
+	elsif (@_ == 4) {
+		OpenGL::Sandbox::_mat4_rotate($self, @_);
+	}
+	else { croak "wrong arguments to rotate" }
+	$self;
+}
+
+sub mirror {
+	my ($self, $axes)= @_;
+	$self= _self($self);
+	OpenGL::Sandbox::_mat4_scale($self, map { index($axes, $_) >= 0? -1 : 1 } qw( x y z ));
+	$self;
+}
+
+sub mul { OpenGL::Sandbox::_mat4_mul($_[0], $_[0], $_[1]); $_[0] }
+
+sub transpose { OpenGL::Sandbox::_mat4_transpose($_[0]); $_[0] }
+
+sub invert {
+	OpenGL::Sandbox::_mat4_invert($_[0]) or croak "Matrix is not invertible";
+	$_[0];
+}
+
+=head2 ortho
+
+  $m->ortho($left, $right, $bottom, $top, $near, $far);
+
+=head2 frustum
+
+  $m->frustum($left, $right, $bottom, $top, $near, $far);
+
+=head2 perspective
+
+  $m->perspective($fovy_degrees, $aspect, $near, $far);
+
+=head2 look_at
+
+  $m->look_at([ $eye_x, $eye_y, $eye_z ], [ $center_x, ... ], [ $up_x, ... ]);
+
+These multiply the matrix by a projection or view matrix, like the GL/GLU functions of the
+same name.
+
+=cut
+
+sub ortho       { my $self= _self(shift); OpenGL::Sandbox::_mat4_ortho($self, @_); $self }
+sub frustum     { my $self= _self(shift); OpenGL::Sandbox::_mat4_frustum($self, @_); $self }
+sub perspective { my $self= _self(shift); OpenGL::Sandbox::_mat4_perspective($self, @_); $self }
+sub look_at {
+	my ($self, $eye, $center, $up)= @_;
+	$self= _self($self);
+	OpenGL::Sandbox::_mat4_look_at($self, @$eye[0..2], @$center[0..2], @{ $up // [0,1,0] }[0..2]);
+	$self;
+}
+
+=head2 transform_points
+
+  my $packed_out= $m->transform_points($packed_in, $in_components, $out_components);
+
+Multiply an array of points by this matrix.  C<$packed_in> is a string (or scalar-ref, or
+L<OpenGL::Sandbox::MMap>) of packed floats with C<$in_components> (2..4, default 3) per
+point.  Missing z is 0 and missing w is 1.  The result has C<$out_components> (1..4, default
+same as input) per point, and no perspective divide is performed.
+
+=cut
+
+sub transform_points {
+	my ($self, $points, $in_n, $out_n)= @_;
+	$in_n //= 3;
+	OpenGL::Sandbox::_mat4_transform_points($self, $points, $in_n, $out_n // $in_n);
+}
+
+1;
@@ -0,0 +1,106 @@
+package OpenGL::Sandbox::MatrixStack;
+use strict;
+use warnings;
+use Carp;
+use OpenGL::Sandbox::Mat4;
+
+# ABSTRACT: Push/pop stack of Mat4, like the fixed-function matrix stack
+# VERSION
+
+=head1 SYNOPSIS
+
+  my $mv= OpenGL::Sandbox::MatrixStack->new;
+  $mv->trans(0, 0, -10);
+  for my $obj (@objects) {
+    $mv->local(sub {
+      $mv->trans(@{ $obj->{pos} })->rotate(z => $obj->{angle});
+      $program->set_uniform(u_modelview => $mv->top);
+      $obj->draw;
+    });
+  }
+
+=head1 DESCRIPTION
+
+This provides the familiar push/translate/rotate/scale/pop workflow of the OpenGL 1.x matrix
+stack, for use with shaders.  The L</top> matrix is always the same
+L<OpenGL::Sandbox::Mat4> object, so it can be fetched once and passed to C<set_uniform>
+each time it changes.  Pushing and popping just copies the 64 bytes of matrix data.
+
+=head1 ATTRIBUTES
+
+=head2 top
+
+The current L<OpenGL::Sandbox::Mat4>.
+
+=head2 depth
+
+Number of matrices saved by L</push>.
+
+=head1 METHODS
+
+=head2 new
+
+  my $stack= OpenGL::Sandbox::MatrixStack->new;        # identity
+  my $stack= OpenGL::Sandbox::MatrixStack->new($mat4);  # copy of $mat4
+
+=cut
+
+sub new {
+	my ($class, $initial)= @_;
+	bless { top => ($initial? $initial->clone : OpenGL::Sandbox::Mat4->new), saved => [] }, $class;
+}
+
+sub top   { $_[0]{top} }
+sub depth { scalar @{ $_[0]{saved} } }
+
+=head2 push
+
+Save a copy of the top matrix.
+
+=head2 pop
+
+Restore the most recently saved matrix.  Dies if the stack is empty.
+
+=head2 local
+
+  $stack->local(sub { ... });
+
+Push, run the code, then pop, even if the code dies.  Returns whatever the code returned.
+
+=cut
+
+sub push { CORE::push @{ $_[0]{saved} }, ${ $_[0]{top} }; $_[0] }
+
+sub pop {
+	my $self= shift;
+	croak "Matrix stack underflow" unless @{ $self->{saved} };
+	${ $self->{top} }= CORE::pop @{ $self->{saved} };
+	$self;
+}
+
+sub local {
+	my ($self, $code)= @_;
+	my $depth= $self->push->depth;
+	my @ret;
+	my $ok= eval { @ret= wantarray? $code->() : scalar $code->(); 1 };
+	my $err= $@;
+	# restore to the original depth, in case the code forgot a pop
+	$self->pop while $self->depth >= $depth;
+	die $err unless $ok;
+	wantarray? @ret : $ret[0];
+}
+
+=head2 identity, trans, translate, scale, trans_scale, rotate, mirror, mul, ortho, frustum, perspective, look_at
+
+These call the method of the same name on L</top>, and return the stack, for chaining.
+
+=cut
+
+for my $method (qw( identity trans translate scale trans_scale rotate mirror mul
+	ortho frustum perspective look_at
+)) {
+	no strict 'refs';
+	*$method= sub { my $self= shift; $self->{top}->$method(@_); $self };
+}
+
+1;
@@ -0,0 +1,359 @@
+package OpenGL::Sandbox::Mesh;
+use Moo 2;
+use Carp;
+use Scalar::Util 'blessed';
+use OpenGL::Sandbox qw( GL_UNSIGNED_SHORT GL_UNSIGNED_INT GL_ARRAY_BUFFER GL_ELEMENT_ARRAY_BUFFER );
+use OpenGL::Sandbox::BufferView;
+
+# ABSTRACT: Generate vertices and indices of common shapes, directly into buffers
+# VERSION
+
+=head1 SYNOPSIS
+
+  my $sphere= OpenGL::Sandbox::Mesh->sphere(radius => 2, segments => 64, rings => 32);
+  my $vbo= OpenGL::Sandbox::Buffer->new(target => GL_ARRAY_BUFFER);
+  my $ibo= OpenGL::Sandbox::Buffer->new(target => GL_ELEMENT_ARRAY_BUFFER);
+  $sphere->load($vbo, $ibo);
+  my $vao= OpenGL::Sandbox::VertexArray->new(
+    buffer => $vbo,
+    attributes => $sphere->vertex_array_attributes,
+  );
+  ...
+  $vao->bind;
+  $ibo->bind;
+  glDrawElements(GL_TRIANGLES, $sphere->index_count, $sphere->index_type, 0);
+
+  # Custom vertex layout, written into part of a mapped buffer by 8 threads
+  my $grid= OpenGL::Sandbox::Mesh->heightfield(
+    heights => \$floats, columns => 1023, rows => 1023, width => 100, depth => 100,
+    attributes => [ position => 'vec3', normal => { type => 'int16', components => 4, normalized => 1 } ],
+  );
+  my $mmap= $buffer->mmap('w');
+  $grid->write_vertices($mmap, offset => 4096, pool => OpenGL::Sandbox::ThreadPool->new(threads => 8));
+
+=head1 DESCRIPTION
+
+This generates triangle meshes of planes, spheres, cylinders, tori and heightfields in C.
+The vertices are written as interleaved attributes, in whatever L</attributes> layout
+the shader wants, straight into a mapped L<OpenGL::Sandbox::Buffer>, an
+L<OpenGL::Sandbox::MMap> (or a slice of one), or a perl string.  Indices are written as a
+separate array of triangles, counter-clockwise when seen from outside.
+
+Every vertex and index is computed from its number alone, so a large mesh can be written by
+an L<OpenGL::Sandbox::ThreadPool>, passed as the C<pool> option.
+
+=head1 CONSTRUCTORS
+
+Each constructor also accepts L</attributes> and L</stride>.
+
+=head2 plane
+
+  OpenGL::Sandbox::Mesh->plane(width => 1, height => 1, columns => 1, rows => 1);
+
+A grid in the XY plane, centered on the origin, facing +Z.  The texture coordinates run from
+(0,0) at (-width/2, -height/2) to (1,1).
+
+=head2 sphere
+
+  OpenGL::Sandbox::Mesh->sphere(radius => 1, segments => 32, rings => 16);
+
+A UV sphere around the Y axis, with C<segments> columns of longitude and C<rings> rows of
+latitude from the -Y pole to the +Y pole.  The vertices along the seam at +X and at the poles
+are repeated, with different texture coordinates.
+
+=head2 icosphere
+
+  OpenGL::Sandbox::Mesh->icosphere(radius => 1, subdivisions => 8);
+
+An icosahedron whose faces are each divided into C<subdivisions>**2 triangles, projected onto
+the sphere, for triangles of nearly equal size.  Each face has its own vertices, so the
+texture coordinates can be kept continuous across the seam.
+
+=head2 cylinder
+
+  OpenGL::Sandbox::Mesh->cylinder(radius => 1, top_radius => $radius, height => 1, segments => 32, rows => 1);
+
+A tube around the Y axis from -height/2 to height/2, without end caps.  A different
+C<top_radius> makes a cone or frustum.
+
+=head2 torus
+
+  OpenGL::Sandbox::Mesh->torus(radius => 1, tube_radius => .25, segments => 32, sides => 16);
+
+A ring of C<radius> around the Y axis, of a tube of C<tube_radius>.
+
+=head2 heightfield
+
+  OpenGL::Sandbox::Mesh->heightfield(heights => $view, columns => $w, rows => $h,
+    width => 1, depth => 1, scale => 1);
+
+A plane like L</plane>, of C<width> by C<depth>, with each vertex moved along +Z by its height
+times C<scale>.  C<heights> is an L<OpenGL::Sandbox::BufferView> of (columns+1)*(rows+1)
+numbers of any type, row by row, or a scalar ref of packed floats.  The normals are computed
+from the neighboring heights.
+
+=cut
+
+has shape      => ( is => 'ro', required => 1 );
+has attributes => ( is => 'ro', default => sub { [ position => 'vec3', normal => 'vec3', uv => 'vec2' ] } );
+has stride     => ( is => 'lazy' );
+has heights    => ( is => 'ro', coerce => sub {
+	blessed($_[0])? $_[0] : OpenGL::Sandbox::BufferView->new($_[0], type => 'float')
+});
+has _c         => ( is => 'ro', required => 1 );
+has _layout    => ( is => 'lazy' );
+
+sub _mesh {
+	my ($class, $shape, $nu, $nv, $a, $b, $c, %opts)= @_;
+	$class->new(%opts, shape => $shape, _c => OpenGL::Sandbox::_mesh_new($shape, $nu, $nv, $a, $b, $c));
+}
+
+sub plane {
+	my ($class, %o)= @_;
+	$class->_mesh(plane => delete $o{columns} // 1, delete $o{rows} // 1,
+		delete $o{width} // 1, delete $o{height} // 1, 0, %o);
+}
+
+sub sphere {
+	my ($class, %o)= @_;
+	$class->_mesh(sphere => delete $o{segments} // 32, delete $o{rings} // 16,
+		delete $o{radius} // 1, 0, 0, %o);
+}
+
+sub icosphere {
+	my ($class, %o)= @_;
+	$class->_mesh(icosphere => delete $o{subdivisions} // 8, 1, delete $o{radius} // 1, 0, 0, %o);
+}
+
+sub cylinder {
+	my ($class, %o)= @_;
+	my $r= delete $o{radius} // 1;
+	$class->_mesh(cylinder => delete $o{segments} // 32, delete $o{rows} // 1,
+		$r, delete $o{top_radius} // $r, delete $o{height} // 1, %o);
+}
+
+sub torus {
+	my ($class, %o)= @_;
+	$class->_mesh(torus => delete $o{segments} // 32, delete $o{sides} // 16,
+		delete $o{radius} // 1, delete $o{tube_radius} // .25, 0, %o);
+}
+
+sub heightfield {
+	my ($class, %o)= @_;
+	defined $o{heights} or croak "heightfield requires 'heights'";
+	$class->_mesh(heightfield => delete $o{columns}, delete $o{rows},
+		delete $o{width} // 1, delete $o{depth} // 1, delete $o{scale} // 1, %o);
+}
+
+=head1 ATTRIBUTES
+
+=head2 shape
+
+The name of the constructor.
+
+=head2 attributes
+
+  attributes => [ position => 'vec3', normal => 'vec3', uv => 'vec2' ],     # default
+  attributes => [ pos => { from => 'position', type => 'half', components => 4 },
+                  normal => { type => 'int8', components => 3, normalized => 1 } ],
+  attributes => [ position => 'vec3', normal => { type => 'int16', normalized => 1, octahedral => 1 } ],
+
+The layout of each vertex, as a list of name and type pairs in the order they are stored.
+The generated values are C<position>, C<normal> and C<uv>; if an attribute has another name,
+C<from> says which one it is.  Types are those of L<OpenGL::Sandbox::BufferView/type>.
+With C<< normalized => 1 >> an integer type gets values scaled to its range, like GL does
+when reading it (see L<OpenGL::Sandbox::BufferView/normalized>); the packed types
+C<int2_10_10_10_rev> and C<uint2_10_10_10_rev> hold 4 components in 4 bytes.
+C<< octahedral => 1 >> stores the normal as 2 components, as
+L<OpenGL::Sandbox::BufferView/encode_octahedral> does.  A fourth position component is 1,
+and other extra components are 0.  Each attribute starts at a multiple of 4 bytes.
+
+=head2 stride
+
+Bytes from one vertex to the next.  Default is the size of the L</attributes>.
+
+=head2 heights
+
+The view of heights, for a L</heightfield>.
+
+=head2 vertex_count
+
+=head2 index_count
+
+=head2 index_type
+
+C<GL_UNSIGNED_SHORT> if the vertex numbers fit in 16 bits, else C<GL_UNSIGNED_INT>.
+
+=head2 vertex_data_size
+
+=head2 index_data_size
+
+Bytes needed for the vertices or indices.
+
+=cut
+
+sub BUILD {
+	my $self= shift;
+	croak "heightfield requires 'heights'" if $self->shape eq 'heightfield' && !$self->heights;
+	for my $attr (@{ $self->_layout }) {
+		OpenGL::Sandbox::_mesh_set_attr($self->_c, $attr->{from}, $attr->{offset},
+			$attr->{type}, $attr->{size}, $attr->{normalized}? 1 : 0, $attr->{octahedral}? 1 : 0);
+	}
+	croak "Stride ".$self->stride." is too small" if $self->stride < $self->_vertex_size;
+}
+
+# Resolve the attribute list to [ { name, from, type, size, normalized, octahedral, offset }, ... ]
+sub _build__layout {
+	my $self= shift;
+	my @spec= @{ $self->attributes };
+	my ($ofs, %seen, @layout)= (0);
+	while (my ($name, $spec)= splice @spec, 0, 2) {
+		$spec= { type => $spec } unless ref $spec;
+		my $from= $spec->{from} // $name;
+		$from =~ /^(position|normal|uv)\z/ or croak "Unknown mesh attribute '$from' (for '$name')";
+		croak "Mesh attribute '$from' is listed twice" if $seen{$from}++;
+		croak "Only the normal can be octahedral (not '$from')" if $spec->{octahedral} && $from ne 'normal';
+		my ($type, $size)= OpenGL::Sandbox::BufferView::_parse_type($spec->{type} // 'float',
+			$spec->{components} // ($spec->{octahedral}? 2 : undef));
+		push @layout, { name => $name, from => $from, type => $type, size => $size,
+			normalized => $spec->{normalized}, octahedral => $spec->{octahedral}, offset => $ofs };
+		$ofs += (OpenGL::Sandbox::BufferView::_elem_size($type, $size) + 3) & ~3;
+	}
+	\@layout;
+}
+
+sub _vertex_size {
+	my $self= shift;
+	my $end= 0;
+	for (@{ $self->_layout }) {
+		my $e= $_->{offset} + OpenGL::Sandbox::BufferView::_elem_size($_->{type}, $_->{size});
+		$end= $e if $e > $end;
+	}
+	$end;
+}
+
+sub _build_stride { ($_[0]->_vertex_size + 3) & ~3 }
+
+sub vertex_count     { (OpenGL::Sandbox::_mesh_counts($_[0]->_c))[0] }
+sub index_count      { (OpenGL::Sandbox::_mesh_counts($_[0]->_c))[1] }
+sub index_type       { $_[0]->vertex_count <= 0x10000? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT }
+sub vertex_data_size { $_[0]->vertex_count * $_[0]->stride }
+sub index_data_size  { $_[0]->index_count * ($_[0]->index_type == GL_UNSIGNED_SHORT? 2 : 4) }
+
+=head1 METHODS
+
+=head2 write_vertices
+
+  $mesh->write_vertices($target, offset => $byte_offset, pool => $thread_pool);
+
+Write all vertices into C<$target>, which is a mapped L<OpenGL::Sandbox::Buffer>, an
+L<OpenGL::Sandbox::MMap>, or a scalar ref.  The bytes must already be there and writable; a
+perl string is not extended.  C<offset> defaults to 0.  If C<pool> is given, the vertices are
+divided among its threads.  Returns the number of bytes written.
+
+=head2 write_indices
+
+  $mesh->write_indices($target, offset => $byte_offset, base => $first_vertex,
+    type => $gl_type, pool => $thread_pool);
+
+Write all indices, as L</index_type> or the given C<type>, adding C<base> (default 0) to each,
+for when the vertices don't start at the beginning of the vertex buffer.  Returns the number
+of bytes written.
+
+=head2 vertex_data
+
+=head2 index_data
+
+Return the vertices or indices as a new string.
+
+=cut
+
+sub _target {
+	my $target= shift;
+	if (blessed($target) && $target->isa('OpenGL::Sandbox::Buffer')) {
+		$target->_mmap or croak "Buffer is not mapped";
+		return $target->mmap;
+	}
+	$target;
+}
+
+sub write_vertices {
+	my ($self, $target, %opts)= @_;
+	OpenGL::Sandbox::_mesh_write_vertices($self->_c, _target($target), $opts{offset} // 0,
+		$self->stride, $opts{pool}, $self->heights);
+}
+
+sub write_indices {
+	my ($self, $target, %opts)= @_;
+	OpenGL::Sandbox::_mesh_write_indices($self->_c, _target($target), $opts{offset} // 0,
+		$opts{type} // $self->index_type, $opts{base} // 0, $opts{pool});
+}
+
+sub vertex_data {
+	my ($self, %opts)= @_;
+	my $data= "\0" x $self->vertex_data_size;
+	$self->write_vertices(\$data, %opts);
+	$data;
+}
+
+sub index_data {
+	my ($self, %opts)= @_;
+	my $type= $opts{type} // $self->index_type;
+	my $data= "\0" x ($self->index_count * ($type == GL_UNSIGNED_SHORT? 2 : 4));
+	$self->write_indices(\$data, %opts, type => $type);
+	$data;
+}
+
+=head2 load
+
+  $mesh->load($vertex_buffer, $index_buffer, usage => GL_STATIC_DRAW, pool => $thread_pool);
+
+Allocate each L<OpenGL::Sandbox::Buffer> to the size of the mesh, map it, write the vertices
+or indices, and unmap it.  Buffers without a C<target> get C<GL_ARRAY_BUFFER> and
+C<GL_ELEMENT_ARRAY_BUFFER>.  C<$index_buffer> may be undef.  Returns C<$self>.
+
+=cut
+
+sub load {
+	my ($self, $vbuf, $ibuf, %opts)= @_;
+	for ([ $vbuf, GL_ARRAY_BUFFER, $self->vertex_data_size, 'write_vertices' ],
+	     [ $ibuf, GL_ELEMENT_ARRAY_BUFFER, $self->index_data_size, 'write_indices' ]
+	) {
+		my ($buf, $target, $size, $method)= @$_;
+		next unless $buf;
+		$buf->target($target) unless $buf->target;
+		$buf->usage($opts{usage}) if defined $opts{usage};
+		$buf->bind;
+		OpenGL::Sandbox::load_buffer_data($buf->target, $size, undef, $buf->usage);
+		$self->$method($buf->mmap('w'), pool => $opts{pool});
+		$buf->unmap;
+	}
+	$self;
+}
+
+=head2 vertex_array_attributes
+
+  my $attrs= $mesh->vertex_array_attributes(offset => $byte_offset, buffer => $buffer);
+
+Return the L<OpenGL::Sandbox::VertexArray/attributes> for vertices written at C<offset>
+(default 0) of C<buffer> (default, the VertexArray's buffer).
+
+=cut
+
+sub vertex_array_attributes {
+	my ($self, %opts)= @_;
+	my %attrs;
+	for my $attr (@{ $self->_layout }) {
+		$attrs{$attr->{name}}= {
+			size => $attr->{size},
+			type => $attr->{type},
+			normalized => $attr->{normalized}? 1 : 0,
+			stride => $self->stride,
+			pointer => ($opts{offset} // 0) + $attr->{offset},
+			(defined $opts{buffer}? ( buffer => $opts{buffer} ) : ()),
+		};
+	}
+	\%attrs;
+}
+
+1;
@@ -0,0 +1,389 @@
+package OpenGL::Sandbox::Profiler;
+use Moo;
+use Carp;
+use Time::HiRes ();
+use JSON::PP ();
+use Log::Any '$log';
+use OpenGL::Sandbox qw( glGetString glFinish GL_VERSION );
+
+# ABSTRACT: Per-frame CPU and GPU timing of named zones
+# VERSION
+
+=head1 SYNOPSIS
+
+  use OpenGL::Sandbox qw( :all );
+  use OpenGL::Sandbox::Profiler;
+  my $prof= OpenGL::Sandbox::Profiler->new->start;
+  while (...) {
+    profile_zone shadows => sub { ... };
+    profile_zone scene   => sub { ... };
+    next_frame;
+  }
+  print $prof->report;
+  $prof->write_chrome_trace('frames.json');
+
+=head1 DESCRIPTION
+
+This measures how long the CPU and the GPU spend in named sections ("zones") of each frame.
+The CPU time is the wall-clock time spent inside the zone.  The GPU time comes from a
+C<GL_TIMESTAMP> query issued at the start and end of the zone, which means it is the time
+between the GPU finishing the commands before the zone and finishing the commands in it.
+Zones may be nested, and the whole frame is also recorded as a zone named C<'frame'>.
+
+The GPU reports query results some time after the commands are issued, and asking for them
+early would stall the pipeline.  Instead, each frame's queries are kept in a queue and read
+back L</latency> frames later, when they are usually complete.  Query objects are reused
+once their results are read, so after the first few frames no new ones are created.
+
+Only one profiler is active at a time.  L<OpenGL::Sandbox/profile_zone> and
+L<OpenGL::Sandbox/next_frame> report to it, and do nothing extra when none is active.
+
+GPU timing requires OpenGL 3.3 (or C<ARB_timer_query>).  Without it, only CPU times are
+recorded.  For counts and times of individual GL calls, see
+L<OpenGL::Sandbox/Profiling GL Calls>.
+
+=head1 ATTRIBUTES
+
+=head2 latency
+
+Number of frames to wait before reading GPU results.  Default is 3.  If the results still
+aren't ready after 4 times this many frames, that frame's GPU times are discarded.
+
+=head2 history
+
+Number of samples to keep for each zone when computing statistics, and number of frames to
+keep for L</chrome_trace>.  Default is 300.
+
+=head2 gpu
+
+Whether to measure GPU time.  Defaults to true if the current context supports timer
+queries.
+
+=head2 frame_count
+
+Number of frames whose results have been collected.
+
+=cut
+
+our $active;
+
+has latency     => ( is => 'ro', default => 3 );
+has history     => ( is => 'ro', default => 300 );
+has gpu         => ( is => 'lazy' );
+has frame_count => ( is => 'rwp', default => 0 );
+
+sub _build_gpu {
+	return 0 unless OpenGL::Sandbox->can('query_timestamp');
+	my ($maj, $min)= (glGetString(GL_VERSION) // '') =~ /(\d+)\.(\d+)/ or return 0;
+	return $maj * 10 + $min >= 33;
+}
+
+# _frame: { start => $cpu, zones => [ [ $name, $cpu0, $cpu1, $q0, $q1 ], ... ], queries => [...] }
+# _pending: frames waiting for GPU results
+has _frame   => ( is => 'rw' );
+has _stack   => ( is => 'rw', default => sub { [] } );
+has _pending => ( is => 'rw', default => sub { [] } );
+has _queries => ( is => 'rw', default => sub { [] } );
+has _samples => ( is => 'rw', default => sub { {} } );
+has _events  => ( is => 'rw', default => sub { [] } );
+has _epoch   => ( is => 'rw' );
+has _gpu_offset => ( is => 'rw' );
+
+=head1 METHODS
+
+=head2 start
+
+Make this the active profiler, and begin the first frame.  Returns C<$self>.
+
+=head2 stop
+
+Stop being the active profiler.  Any frames still waiting for GPU results are collected,
+waiting for the GPU if needed.  Returns C<$self>.
+
+=cut
+
+sub start {
+	my $self= shift;
+	$active->stop if $active && $active != $self;
+	$active= $self;
+	# Trace times are microseconds since the first start, to keep them precise as doubles
+	$self->_epoch(_now()) unless defined $self->_epoch;
+	if ($self->gpu && !defined $self->_gpu_offset) {
+		# Relate the GPU clock to ours, to line up the two in the trace
+		$self->_gpu_offset((_now() - $self->_epoch) * 1e6 - OpenGL::Sandbox::gl_timestamp() / 1e3);
+	}
+	$self->_begin_frame;
+	$self;
+}
+
+sub stop {
+	my $self= shift;
+	$active= undef if $active && $active == $self;
+	my $frame= $self->_frame;
+	push @{ $self->_queries }, @{ $frame->{queries} } if $frame;
+	$self->_frame(undef);
+	@{ $self->_stack }= ();
+	$self->_collect(1);
+	$self;
+}
+
+sub _now { Time::HiRes::time() }
+
+sub _query {
+	my $self= shift;
+	my $pool= $self->_queries;
+	push @$pool, OpenGL::Sandbox::gen_queries(16) unless @$pool;
+	my $q= pop @$pool;
+	OpenGL::Sandbox::query_timestamp($q);
+	push @{ $self->_frame->{queries} }, $q;
+	$q;
+}
+
+sub _begin_frame {
+	my $self= shift;
+	$self->_frame({ zones => [], queries => [] });
+	$self->_frame->{start}= _now();
+	$self->_frame->{start_q}= $self->_query if $self->gpu;
+}
+
+=head2 zone
+
+  my @ret= $prof->zone($name, sub { ... });
+
+Run the code, and record its time as a zone named C<$name>.  Returns the result of the code.
+The zone is ended even if the code dies.
+
+=head2 begin_zone
+
+=head2 end_zone
+
+  $prof->begin_zone($name);
+  ...
+  $prof->end_zone;
+
+The same, for code that isn't conveniently a single sub.  These must be paired within a
+frame.
+
+=cut
+
+sub begin_zone {
+	my ($self, $name)= @_;
+	my $frame= $self->_frame or croak "Profiler is not started";
+	my $zone= [ $name, undef, undef, undef, undef ];
+	$zone->[3]= $self->_query if $self->gpu;
+	$zone->[1]= _now();
+	push @{ $self->_stack }, $zone;
+	push @{ $frame->{zones} }, $zone;
+	$self;
+}
+
+sub end_zone {
+	my $self= shift;
+	my $zone= pop @{ $self->_stack } or croak "end_zone without begin_zone";
+	$zone->[2]= _now();
+	$zone->[4]= $self->_query if $self->gpu;
+	$self;
+}
+
+sub zone {
+	my ($self, $name, $code)= @_;
+	$self->begin_zone($name);
+	my $depth= @{ $self->_stack };
+	my $wantarray= wantarray;
+	my @ret;
+	my $ok= eval { @ret= $wantarray? $code->() : scalar $code->(); 1 };
+	my $err= $@;
+	$self->end_zone while @{ $self->_stack } >= $depth;
+	die $err unless $ok;
+	$wantarray? @ret : $ret[0];
+}
+
+=head2 end_frame
+
+Finish the current frame, begin the next, and collect the results of older frames whose
+GPU queries have completed.  This is called by L<OpenGL::Sandbox/next_frame> after swapping
+buffers, so you only need it if you swap buffers some other way.
+
+=cut
+
+sub end_frame {
+	my $self= shift;
+	my $frame= $self->_frame or croak "Profiler is not started";
+	if (@{ $self->_stack }) {
+		$log->warn("Profiler zone '$_->[0]' was not ended before end of frame") for @{ $self->_stack };
+		$self->end_zone while @{ $self->_stack };
+	}
+	unshift @{ $frame->{zones} }, [ 'frame', $frame->{start}, _now(), $frame->{start_q},
+		($self->gpu? $self->_query : undef) ];
+	push @{ $self->_pending }, $frame;
+	$self->_begin_frame;
+	$self->_collect(0);
+	$self;
+}
+
+# Read back the results of pending frames.  Stop at the first one that isn't ready, unless it
+# is too old, or unless $wait is true.  Without GPU timing, frames are recorded immediately.
+sub _collect {
+	my ($self, $wait)= @_;
+	my $pending= $self->_pending;
+	while (@$pending) {
+		last if !$wait && $self->gpu && @$pending <= $self->latency;
+		my $frame= $pending->[0];
+		my %result;
+		if ($self->gpu && @{ $frame->{queries} }) {
+			my @r= OpenGL::Sandbox::get_query_results(@{ $frame->{queries} });
+			if (!@r) {
+				last unless $wait || @$pending > $self->latency * 4;
+				if ($wait) {
+					glFinish();
+					@r= OpenGL::Sandbox::get_query_results(@{ $frame->{queries} });
+				}
+			}
+			@result{ @{ $frame->{queries} } }= @r if @r;
+		}
+		shift @$pending;
+		push @{ $self->_queries }, @{ $frame->{queries} };
+		$self->_record_frame($frame, \%result);
+	}
+}
+
+sub _us { 0 + sprintf "%.3f", $_[0] }
+
+sub _record_frame {
+	my ($self, $frame, $result)= @_;
+	my $samples= $self->_samples;
+	my $history= $self->history;
+	my $epoch= $self->_epoch;
+	my @events;
+	for my $zone (@{ $frame->{zones} }) {
+		my ($name, $c0, $c1, $q0, $q1)= @$zone;
+		my $gpu_ns= defined $q0 && defined $result->{$q0}? $result->{$q1} - $result->{$q0} : undef;
+		my $s= $samples->{$name} //= { cpu => [], gpu => [], count => 0 };
+		$s->{count}++;
+		push @{ $s->{cpu} }, ($c1 - $c0) * 1000;
+		shift @{ $s->{cpu} } if @{ $s->{cpu} } > $history;
+		if (defined $gpu_ns) {
+			push @{ $s->{gpu} }, $gpu_ns / 1e6;
+			shift @{ $s->{gpu} } if @{ $s->{gpu} } > $history;
+		}
+		push @events, { name => $name, ph => 'X', pid => 1, tid => 1,
+			ts => _us(($c0 - $epoch) * 1e6), dur => _us(($c1 - $c0) * 1e6) };
+		push @events, { name => $name, ph => 'X', pid => 1, tid => 2,
+			ts => _us($result->{$q0} / 1e3 + $self->_gpu_offset), dur => _us($gpu_ns / 1e3) }
+			if defined $gpu_ns;
+	}
+	my $events= $self->_events;
+	push @$events, \@events;
+	shift @$events if @$events > $history;
+	$self->_set_frame_count($self->frame_count + 1);
+}
+
+=head2 stats
+
+  my $stats= $prof->stats;
+  # {
+  #   frame   => { count => 120, cpu => { mean => 16.6, p50 => 16.5, p99 => 18.0, max => 21.2 },
+  #                              gpu => { mean => 3.1, ... } },
+  #   shadows => { ... },
+  # }
+
+Returns the statistics of each zone over the last L</history> frames, in milliseconds.
+C<count> is the total number of times the zone was recorded.  C<gpu> is absent if there were
+no GPU results for the zone.
+
+=cut
+
+sub _summarize {
+	my $v= shift;
+	return undef unless @$v;
+	my @s= sort { $a <=> $b } @$v;
+	my $sum= 0;
+	$sum += $_ for @s;
+	my $rank= sub { $s[ int($_[0] * @s + .999999) - 1 ] // $s[0] };
+	return { mean => $sum / @s, p50 => $rank->(.5), p99 => $rank->(.99), max => $s[-1] };
+}
+
+sub stats {
+	my $self= shift;
+	my $samples= $self->_samples;
+	my %stats;
+	for (keys %$samples) {
+		my $s= $samples->{$_};
+		$stats{$_}= { count => $s->{count}, cpu => _summarize($s->{cpu}) };
+		$stats{$_}{gpu}= _summarize($s->{gpu}) if @{ $s->{gpu} };
+	}
+	\%stats;
+}
+
+=head2 report
+
+Returns L</stats> as a text table, sorted by mean CPU time.
+
+=cut
+
+sub report {
+	my $self= shift;
+	my $stats= $self->stats;
+	my $text= sprintf "%-24s %8s %9s %9s %9s %9s %9s %9s\n", 'Zone', 'count',
+		'cpu mean', 'cpu p50', 'cpu p99', 'gpu mean', 'gpu p50', 'gpu p99';
+	for my $name (sort { $stats->{$b}{cpu}{mean} <=> $stats->{$a}{cpu}{mean} } keys %$stats) {
+		my $s= $stats->{$name};
+		$text .= sprintf "%-24s %8d %9.3f %9.3f %9.3f", $name, $s->{count}, @{$s->{cpu}}{qw( mean p50 p99 )};
+		$text .= $s->{gpu}? sprintf(" %9.3f %9.3f %9.3f\n", @{$s->{gpu}}{qw( mean p50 p99 )})
+			: sprintf(" %9s %9s %9s\n", ('-') x 3);
+	}
+	$text;
+}
+
+=head2 chrome_trace
+
+  my $json= $prof->chrome_trace;
+
+Returns the zones of the last L</history> frames in the Trace Event JSON format, which can be
+loaded into C<chrome://tracing> or L<Perfetto|https://ui.perfetto.dev>.  CPU zones are on one
+thread and GPU zones on another, with GPU times shifted onto the CPU clock.
+
+=head2 write_chrome_trace
+
+  $prof->write_chrome_trace($filename);
+
+=head2 clear
+
+Discard all collected samples and trace events.
+
+=cut
+
+sub chrome_trace {
+	my $self= shift;
+	my @events= (
+		{ name => 'thread_name', ph => 'M', pid => 1, tid => 1, args => { name => 'CPU' } },
+		{ name => 'thread_name', ph => 'M', pid => 1, tid => 2, args => { name => 'GPU' } },
+		map @$_, @{ $self->_events }
+	);
+	JSON::PP->new->canonical->encode({ traceEvents => \@events, displayTimeUnit => 'ms' });
+}
+
+sub write_chrome_trace {
+	my ($self, $fname)= @_;
+	open my $fh, '>', $fname or croak "open($fname): $!";
+	print $fh $self->chrome_trace or croak "write($fname): $!";
+	close $fh or croak "close($fname): $!";
+	$self;
+}
+
+sub clear {
+	my $self= shift;
+	%{ $self->_samples }= ();
+	@{ $self->_events }= ();
+	$self->_set_frame_count(0);
+	$self;
+}
+
+sub DESTROY {
+	my $self= shift;
+	return if ${^GLOBAL_PHASE} eq 'DESTRUCT' || !$self->{gpu};
+	OpenGL::Sandbox::delete_queries(@{ $self->_queries }, map @{ $_->{queries} },
+		@{ $self->_pending }, grep defined, $self->_frame);
+}
+
+1;
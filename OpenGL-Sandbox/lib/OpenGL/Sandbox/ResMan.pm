@@ -8,6 +8,7 @@ use OpenGL::Sandbox::MMap;
 use OpenGL::Sandbox::Texture;
 use File::Find ();
 use Scalar::Util 'weaken';
+use Module::Runtime 'require_module';
 sub mmap { OpenGL::Sandbox::MMap->new(shift) }
 our @CARP_NOT= ( 'OpenGL::Sandbox' );
 
@@ -30,8 +31,9 @@ from a directory of your choice.  Where possible, files get memory-mapped
 directly into the library that uses them, which should keep the overhead of
 this library as low as possible.
 
-Note that you need to install L<OpenGL::Sandbox::V1::FTGLFont> in order to get font support,
-currently.  Other font providers might be added later.
+Note that font support comes from separately distributed modules: either
+L<OpenGL::Sandbox::V1::FTGLFont> for OpenGL 1.x, or L<OpenGL::Sandbox::V2::Font> for shader
+pipelines (including core-profile contexts).  See L</font_class>.
 
 =head1 METHODS
 
@@ -288,13 +290,15 @@ C<"a"> composed of those shaders.
 
 =item font_config
 
-Configures L<OpenGL::Sandbox::V1::FTGLFont>.  (distributed separately)
+Configures the font objects, which are L</font_class> unless a font's config specifies
+C<class>.  (distributed separately)
 
   {
     '*'     => { face_size => 48 }, # default settings get applied to all configs
     3d      => { face_size => 64, type => 'FTExtrudeFont' },
     default => { face_size => 32, filename => 'myfont1' }, # font named 'default'
     myfont2 => 'myfont1',  # alias
+    sdf     => { class => 'OpenGL::Sandbox::V2::Font', filename => 'myfont1' },
   }
 
 Fonts are also implied by the presence of a file in the L</font_path> directory,
@@ -327,6 +331,7 @@ has vertex_array_config => ( is => 'rw', default => sub { +{} } );
 has shader_config     => ( is => 'rw', default => sub { +{} } );
 has program_config    => ( is => 'rw', default => sub { +{} } );
 has font_config       => ( is => 'rw', default => sub { +{} } );
+has font_class        => ( is => 'rw', lazy => 1, builder => 1 );
 
 sub _build_tex_fmt_priority {
 	my $self= shift;
@@ -369,10 +374,13 @@ sub _build__buffer_cache  { require OpenGL::Sandbox::Buffer; return {}; }
 sub _build__vao_cache     { require OpenGL::Sandbox::VertexArray; return {}; }
 sub _build__shader_cache  { require OpenGL::Sandbox::Shader; return {}; }
 sub _build__program_cache { require OpenGL::Sandbox::Program; return {}; }
-sub _build__font_cache {
-	eval { require OpenGL::Sandbox::V1::FTGLFont; 1 }
-		or croak "Font support requires module L<OpenGL::Sandbox::V1::FTGLFont>, and OpenGL 1.x\n$@";
-	return {};
+sub _build__font_cache { return {}; }
+sub _build_font_class {
+	for (qw( OpenGL::Sandbox::V1::FTGLFont OpenGL::Sandbox::V2::Font )) {
+		return $_ if eval { require_module($_); 1 };
+	}
+	croak "Font support requires module L<OpenGL::Sandbox::V1::FTGLFont> (OpenGL 1.x)"
+		." or L<OpenGL::Sandbox::V2::Font> (OpenGL 3+)";
 }
 
 sub _interpret_path {
@@ -717,11 +725,18 @@ sub new_program {
   $font= $res->load_font( $name, %config );
 
 Font support comes from a separate distribution, and these methods with attempt to load it on
-demand.  Currently, the only font provider is L<OpenGL::Sandbox::V1::FTGLFont> which is tied to
-OpenGL 1.x.
+demand.  There are two font providers: L<OpenGL::Sandbox::V1::FTGLFont> which is tied to
+OpenGL 1.x, and L<OpenGL::Sandbox::V2::Font> which renders signed-distance-field glyphs with
+a shader program.
 
 =over
 
+=item font_class
+
+The class used for fonts whose config doesn't specify C<class>.  The default is
+L<OpenGL::Sandbox::V1::FTGLFont> if it is installed, else L<OpenGL::Sandbox::V2::Font>.
+If you are using a core-profile context, set this to C<'OpenGL::Sandbox::V2::Font'>.
+
 =item font
 
 Retrieve a named font, either confgured in L<font_config>, previously created, or implied by
@@ -760,13 +775,6 @@ sub font {
 
 *load_font= *new_font;
 sub new_font {
-	eval 'require OpenGL::Sandbox::V1::FTGLFont'
-		or croak "Font support requires module L<OpenGL::Sandbox::V1::FTGLFont>, and OpenGL 1.x";
-	no warnings 'redefine';
-	*load_font= *_load_font;
-	goto $_[0]->can('load_font');
-}
-sub _load_font {
 	my ($self, $name, %options)= @_;
 	$self->_font_cache->{$name} //= do {
 		$log->debug("loading font $name");
@@ -776,7 +784,9 @@ sub _load_font {
 			my $file_info= $self->_font_dir_cache->{$filename}
 				or croak "No such font source '$filename'";
 			$ctor_args->{data}= $self->_get_cached_mmap($file_info);
-			OpenGL::Sandbox::V1::FTGLFont->new($ctor_args);
+			my $class= delete $ctor_args->{class} // $self->font_class;
+			require_module($class);
+			$class->new($ctor_args);
 		};
 	};
 }
@@ -215,7 +215,8 @@ Must be specified, unless C<data> is C<undef>.
 
 =item data
 
-A scalar-ref containing the bytes to be loaded.  May be undef to request that OpenGL allocate
+A scalar-ref containing the bytes to be loaded, such as an L<OpenGL::Sandbox::MMap> or a
+L<slice|OpenGL::Sandbox::MMap/slice> of one (e.g. one mip level of a larger file).  May be undef to request that OpenGL allocate
 space for the texture without loading any data into it.  However, if there is a Pixel Buffer 
 Object currently bound to C<GL_PIXEL_UNPACK_BUFFER> then this I<may not> be a ref, and must
 be either undef (0) or a numeric value, since it gets interpreted as an offset.
@@ -379,6 +380,9 @@ might want to load into a texture.  Integrating libktx is on my list.
 Render the texture as a plain rectangle with optional coordinate/size modifications.
 Implies a call to C</bind> which might also trigger L</load>.
 
+Inside of L<OpenGL::Sandbox::V1/sprite_batch>, a loaded texture is not bound, and the
+rectangle is queued to be drawn at the end of the batch.
+
 Assumes you have already enabled GL_TEXTURE_2D, and that you are not using shaders.
 (future versions might include a shader-compatible implementation)
 
@@ -427,8 +431,9 @@ sub render {
 	# Now install methods for fast future calls
 	no warnings 'redefine';
 	*render_bound= *OpenGL::Sandbox::V1::_texture_render;
+	my $batching= OpenGL::Sandbox::V1->can('_sprite_batch_active') || sub { 0 };
 	*render= sub {
-		$_[0]->bind;
+		$_[0]->bind unless $_[0]->loaded && $batching->();
 		shift->render_bound(@_ == 1 && ref $_[0] eq 'HASH'? %{$_[0]} : @_);
 	};
 	goto $_[0]->can('render');
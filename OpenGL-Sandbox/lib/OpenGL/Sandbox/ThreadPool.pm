@@ -0,0 +1,218 @@
+package OpenGL::Sandbox::ThreadPool;
+use strict;
+use warnings;
+use Carp;
+use Scalar::Util 'blessed';
+use OpenGL::Sandbox ();
+
+# ABSTRACT: Fill buffer views in parallel on a pool of C threads
+# VERSION
+
+=head1 SYNOPSIS
+
+  my $pool= OpenGL::Sandbox::ThreadPool->new;
+  my $mmap= $buffer->mmap('r+');
+  my $pos= OpenGL::Sandbox::BufferView->new($mmap, type => 'vec3', stride => 24);
+  my $vel= OpenGL::Sandbox::BufferView->new($mmap, type => 'vec3', stride => 24, offset => 12);
+
+  $pool->run(combine => $pos, $vel, 1, $dt);   # pos= pos + vel * dt, on all cores
+  $pool->run(transform => $pos, $matrix);      # multiply every position by a Mat4
+
+  $pool->start(fill => $colors, 1, 1, 1, 1);   # returns right away
+  ...                                          # do other work
+  $pool->wait;
+  $buffer->unmap;
+
+=head1 DESCRIPTION
+
+A ThreadPool is a set of C threads that run a I<kernel> over the elements of an
+L<OpenGL::Sandbox::BufferView>.  The view is cut into disjoint ranges of elements, and each
+thread processes one range at a time until the view is done, so a large mapped buffer can be
+filled by every core at once.  The perl thread that called L</run> or L</wait> works on ranges
+too.
+
+Perl threads (ithreads) can't do this job: a mapped buffer's scalar can't be copied into
+another interpreter, and the GL context belongs to one thread anyway.  The kernels here run
+without the perl interpreter, directly on the bytes of the view, and L<OpenGL::Sandbox::Buffer/unmap>
+waits for all pools to finish before the memory goes away.
+
+One job runs at a time per pool, and starting a job waits for the previous one.  While a job
+runs, the pool keeps a reference to its views, but perl code must not write to their buffers
+until L</wait>.  L<OpenGL::Sandbox::Buffer/unmap> waits by itself.  Small jobs (fewer than a
+few thousand elements per thread) use fewer threads, since waking a thread would cost more
+than it saves.
+
+=head1 CONSTRUCTOR
+
+=head2 new
+
+  my $pool= OpenGL::Sandbox::ThreadPool->new(threads => $n);
+
+Start C<$n> worker threads.  The default is the number of CPUs.  A pool with 0 threads runs
+every job on the calling thread, in L</wait>.
+
+=cut
+
+sub new {
+	my ($class, %opts)= @_;
+	OpenGL::Sandbox::_thread_pool_new($opts{threads} // -1);
+}
+
+=head1 ATTRIBUTES
+
+=head2 threads
+
+Number of worker threads.
+
+=head2 busy
+
+True if a job has been started and not all of its elements have been processed.
+
+=cut
+
+*threads= \&OpenGL::Sandbox::_thread_pool_threads;
+*busy= \&OpenGL::Sandbox::_thread_pool_busy;
+
+=head1 METHODS
+
+=head2 run
+
+  $pool->run($kernel_name, $view, @params);
+  $pool->run($kernel_name, $view, $source_view, @params);
+
+Run a kernel over every element of C<$view>, and return when it is done.  If the kernel reads
+a second view, it processes as many elements as the shorter view has, and both views must
+have the same number of components.  If the views overlap other than by being the same
+elements, the source is copied first, so the result is as if it had been read completely
+before writing.  Different attributes of the same interleaved vertices don't overlap.
+The built-in kernels are:
+
+=over
+
+=item fill
+
+  $pool->run(fill => $view, $value);
+  $pool->run(fill => $view, @values);   # one per component
+
+=item scale_add
+
+  $pool->run(scale_add => $view, $factor, $offset);
+  $pool->run(scale_add => $view, @factors, @offsets);   # one each per component
+
+C<< view= view * factor + offset >>
+
+=item combine
+
+  $pool->run(combine => $view, $source, $view_factor, $source_factor);
+
+C<< view= view * view_factor + source * source_factor >>, element by element.  A
+C<$view_factor> of 0 makes it a copy.  (This is L<OpenGL::Sandbox::BufferView/add>.)
+
+=item transform
+
+  $pool->run(transform => $view, $mat4);
+  $pool->run(transform => $view, @sixteen_floats);
+
+Multiply each element of a C<vec2>, C<vec3> or C<vec4> view by a 4x4 matrix, in place, as
+L<OpenGL::Sandbox::Mat4/transform_points> does.  z defaults to 0 and w to 1.
+
+=item oct_encode
+
+=item oct_decode
+
+  $pool->run(oct_encode => $oct_view, $normal_view);
+  $pool->run(oct_decode => $normal_view, $oct_view);
+
+L<OpenGL::Sandbox::BufferView/encode_octahedral> and
+L<OpenGL::Sandbox::BufferView/decode_octahedral>.  The views have 2 and 3 or 4 components,
+and must not overlap unless they start at the same byte with the same stride.
+
+=back
+
+=head2 start
+
+  $pool->start($kernel_name, $view, ...);
+
+Same as L</run>, but returns without waiting for the job.  Returns C<$pool>.
+
+=head2 wait
+
+Wait until the current job (if any) is done.  The calling thread processes ranges as well.
+
+=cut
+
+sub start {
+	my ($self, $kernel, $view, @params)= @_;
+	my $src= blessed($params[0]) && $params[0]->isa('OpenGL::Sandbox::BufferView')? shift @params : undef;
+	@params= map +(blessed($_) && $_->isa('OpenGL::Sandbox::Mat4')? $_->get : $_), @params;
+	OpenGL::Sandbox::_thread_pool_start($self, $kernel, $view, $src, @params);
+	$self;
+}
+
+sub run { &start; OpenGL::Sandbox::_thread_pool_wait($_[0]); $_[0] }
+
+sub wait { OpenGL::Sandbox::_thread_pool_wait($_[0]); $_[0] }
+
+=head2 kernels
+
+  my @names= OpenGL::Sandbox::ThreadPool->kernels;
+
+Names of the built-in and registered kernels.
+
+=head2 register_kernel
+
+  OpenGL::Sandbox::ThreadPool->register_kernel($name, $address, needs_source => $bool);
+
+Add a kernel written in C, such as in your own L<Inline::C> code, and return C<$name>.
+C<$address> is the address of the function as an integer.  The function is called once per
+range, on any thread, so it must not use the perl API or perl's C<malloc>:
+
+  typedef void (*pool_kernel_fn)(
+    const struct view_layout *dst,   /* the range of the view to process */
+    const struct view_layout *src,   /* the same range of the source view, or NULL */
+    size_t first,                    /* index of dst->data[0] within the whole view */
+    const double *params, int n_params
+  );
+
+  struct view_layout {
+    char *data;      /* address of the first element, not necessarily aligned */
+    size_t stride;   /* bytes from one element to the next */
+    size_t count;    /* number of elements in this range */
+    int type, components;
+    int normalized;  /* integer components are fractions of their range */
+  };
+
+For example,
+
+  use Inline C => <<'C';
+  #include <string.h>
+  struct view_layout { char *data; size_t stride, count; int type, components, normalized; };
+  static void ramp(const struct view_layout *v, const struct view_layout *s,
+                   size_t first, const double *p, int n) {
+    size_t i; float x;
+    for (i= 0; i < v->count; i++) {
+      x= (float)((first + i) * p[0]);
+      memcpy(v->data + i * v->stride, &x, 4);
+    }
+  }
+  IV ramp_address() { return PTR2IV(ramp); }
+  C
+  OpenGL::Sandbox::ThreadPool->register_kernel(ramp => ramp_address());
+  $pool->run(ramp => $view, .5);
+
+Custom kernels accept up to 32 parameters and are trusted to check their own view's type.
+Registering a name again replaces the previous function; built-in kernels can't be replaced.
+
+=cut
+
+sub kernels { OpenGL::Sandbox::_thread_pool_kernels() }
+
+sub register_kernel {
+	my ($class, $name, $address, %opts)= @_;
+	OpenGL::Sandbox::_thread_pool_register_kernel($name, $address, $opts{needs_source}? 1 : 0);
+	$name;
+}
+
+sub DESTROY { OpenGL::Sandbox::_thread_pool_free(shift) }
+
+1;
@@ -12,6 +12,7 @@ BEGIN {
 	try { OpenGL::Sandbox->import(qw( glVertexAttribFormat glVertexAttribBinding )) };
 }
 use OpenGL::Sandbox::Buffer;
+use OpenGL::Sandbox::BufferView;
 
 # ABSTRACT: Object that describes an array of vertex data
 # VERSION
@@ -62,12 +63,26 @@ Each attribute is a hashref of:
     buffer     => $buffer, # buffer this attribute comes from. Leave undef to use current buffer.
                            # This can also be a buffer ID integer.
     size       => $n,      # number of components per vertex attribute
-    type       => $type,   # GL_FLOAT, GL_INT, etc.
+    type       => $type,   # GL_FLOAT, GL_INT, etc, or a name like 'half' or 'vec3'
     normalized => $bool,   # perl boolean, whether to remap ints to float [0..1)
     stride     => $ofs,    # number of bytes between stored attributes, or 0 for "tightly packed"
     pointer    => $ofs,    # byte offset into $buffer of first element, defaults to 0
   }
-    
+
+L<OpenGL::Sandbox::BufferView/interleave> copies separate arrays into one buffer and returns
+the attributes for it.
+
+C<type> can be any type name of L<OpenGL::Sandbox::BufferView/type>, such as C<'int16'> or
+C<'int2_10_10_10_rev'>, which is replaced by the GL constant.  Names like C<'vec3'> also
+supply a default C<size>.  For compact vertex data, declare the attribute with a smaller type
+and C<normalized>, and write it with L</attribute_view>:
+
+  attributes => {
+    position => { type => 'half', size => 4, stride => 16 },
+    normal   => { type => 'int2_10_10_10_rev', normalized => 1, stride => 16, pointer => 8 },
+    color    => { type => 'uint8', size => 4, normalized => 1, stride => 16, pointer => 12 },
+  }
+
 =head2 buffer
 
 You can specify a buffer on each attribute, or specify it in the call to C<bind>, or you can
@@ -104,11 +119,25 @@ Whether the L</prepare> step has happened.
 =cut
 
 has name        => ( is => 'rw' );
-has attributes  => ( is => 'rw', default => sub { +{} } );
+has attributes  => ( is => 'rw', default => sub { +{} }, coerce => \&_coerce_attributes );
 has id          => ( is => 'lazy', predicate => 1 );
 has prepared    => ( is => 'rw' );
 has buffer      => ( is => 'rw', coerce => sub { ref $_[0] eq 'HASH'? OpenGL::Sandbox::Buffer->new($_[0]) : $_[0] } );
 
+# Resolve type names, without changing the caller's hashes
+sub _coerce_attributes {
+	my $attrs= shift;
+	return $attrs unless ref $attrs eq 'HASH' && grep defined $_->{type} && $_->{type} !~ /^[0-9]+\z/, values %$attrs;
+	my %ret;
+	for (keys %$attrs) {
+		my %a= %{ $attrs->{$_} };
+		@a{'type','size'}= OpenGL::Sandbox::BufferView::_parse_type($a{type}, $a{size})
+			if defined $a{type};
+		$ret{$_}= \%a;
+	}
+	\%ret;
+}
+
 sub _build_id {
 	my $id= try { OpenGL::Sandbox::gen_vertex_arrays(1) };
 	return $id; # if it's undef, then we don't need it.
@@ -151,6 +180,28 @@ this is a no-op.
 
 =cut
 
+=head2 attribute_view
+
+  my $view= $vertex_array->attribute_view($name, $source, count => $n);
+
+Return an L<OpenGL::Sandbox::BufferView> of one attribute within C<$source> (a mapped
+L<Buffer|OpenGL::Sandbox::Buffer>, an L<OpenGL::Sandbox::MMap> or a scalar ref), with the
+attribute's C<type>, C<size>, C<normalized>, C<stride> and C<pointer>.  Values written
+through the view are converted the way GL will read them back, so floats can be stored as
+half floats, normalized integers or packed C<2_10_10_10> words.  Extra options are passed to
+L<OpenGL::Sandbox::BufferView/new>.
+
+=cut
+
+sub attribute_view {
+	my ($self, $name, $source, %opts)= @_;
+	my $attr= $self->attributes->{$name} or croak "No attribute '$name'";
+	OpenGL::Sandbox::BufferView->new($source,
+		type => $attr->{type}, components => $attr->{size},
+		normalized => $attr->{normalized}, stride => $attr->{stride} // 0,
+		offset => $attr->{pointer} // 0, %opts);
+}
+
 sub bind {
 	$_[0]->_choose_implementation;
 	shift->bind(@_);
@@ -24,20 +24,25 @@ struct buffer_scalar_info {
 	int flags;
 	buffer_scalar_callback_data_t callback_data;
 	buffer_scalar_free_fn destructor;
+	SV *var;
+	/* A slice holds a reference to the scalar it was cut from, and is on that scalar's list of
+	 * children, so that it can be detached when the parent's buffer goes away. */
+	SV *parent;
+	struct buffer_scalar_info *parent_info, *children, *next_sibling;
 };
 
-static int buffer_scalar_mg_write(SV *sv, MAGIC* mg);
-static int buffer_scalar_mg_clear(SV *sv, MAGIC *mg);
-static int buffer_scalar_mg_free(SV *sv, MAGIC *mg);
+static int buffer_scalar_mg_write(pTHX_ SV *sv, MAGIC* mg);
+static int buffer_scalar_mg_clear(pTHX_ SV *sv, MAGIC *mg);
+static int buffer_scalar_mg_free(pTHX_ SV *sv, MAGIC *mg);
 
 #ifdef MGf_LOCAL
-static int buffer_scalar_mg_local(SV* var, MAGIC* mg) {
+static int buffer_scalar_mg_local(pTHX_ SV* var, MAGIC* mg) {
 	croak("Can't localize view of foreign buffer");
 	return 0;
 }
 #endif
 #ifdef USE_ITHREADS
-static int buffer_scalar_mg_dup(MAGIC* magic, CLONE_PARAMS* param) {
+static int buffer_scalar_mg_dup(pTHX_ MAGIC* magic, CLONE_PARAMS* param) {
 	croak("Can't share foreign buffer between iThreads");
 	return 0;
 }
@@ -82,7 +87,7 @@ static void buffer_scalar_fixup(SV* var, struct buffer_scalar_info* info, const
 	reset_var(var, info);
 }
 
-static int buffer_scalar_mg_write(SV* var, MAGIC* magic) {
+static int buffer_scalar_mg_write(pTHX_ SV* var, MAGIC* magic) {
 	struct buffer_scalar_info* info = (struct buffer_scalar_info*) magic->mg_ptr;
 	if (!SvOK(var))
 		buffer_scalar_fixup(var, info, NULL, 0);
@@ -103,19 +108,44 @@ static int buffer_scalar_mg_write(SV* var, MAGIC* magic) {
 	return 0;
 }
  
-static int buffer_scalar_mg_clear(SV* var, MAGIC* magic) {
+static int buffer_scalar_mg_clear(pTHX_ SV* var, MAGIC* magic) {
 	croak("Can't clear a foreign buffer");
 	return 0;
 }
  
-static int buffer_scalar_mg_free(SV* var, MAGIC* magic) {
+static int buffer_scalar_mg_free(pTHX_ SV* var, MAGIC* magic) {
 	struct buffer_scalar_info* info = (struct buffer_scalar_info*) magic->mg_ptr;
+	struct buffer_scalar_info *child, **prev;
+	U32 detached= 0;
+	/* Slices point into this buffer, so they have to let go of it too */
+	while ((child= info->children)) {
+		info->children= child->next_sibling;
+		child->parent_info= NULL;
+		child->parent= NULL;
+		detached++;
+		sv_unmagic(child->var, PERL_MAGIC_uvar);
+	}
+	/* Drop the references the slices held, unless this is the scalar being freed */
+	if (detached && SvREFCNT(var) > detached)
+		SvREFCNT(var) -= detached;
+	if (info->parent_info) {
+		for (prev= &info->parent_info->children; *prev; prev= &(*prev)->next_sibling)
+			if (*prev == info) { *prev= info->next_sibling; break; }
+	}
+	if (info->parent)
+		SvREFCNT_dec(info->parent);
 	if (info->destructor)
 		info->destructor(var, info->address, info->length, info->callback_data);
 	PerlMemShared_free(info);
 	SvREADONLY_off(var);
 	SvPVX(var) = NULL;
 	SvCUR(var) = 0;
+	SvLEN(var) = 0;
+	SvOK_off(var);
+	/* A scalar that outlives its buffer (unwrapped, or a slice of one) becomes an ordinary
+	 * empty string, rather than a string flagged as valid with no buffer behind it. */
+	if (SvREFCNT(var))
+		sv_setpvn(var, "", 0);
 	return 0;
 }
 
@@ -141,6 +171,8 @@ static struct buffer_scalar_info* add_sv_magic(SV *var) {
 	MAGIC* magic;
 	check_new_variable(var);
 	info= PerlMemShared_malloc(sizeof *info);
+	Zero(info, 1, struct buffer_scalar_info);
+	info->var= var;
 	magic= sv_magicext(var, NULL, PERL_MAGIC_uvar, &buffer_scalar_vtable, (const char*) info, 0);
 #ifdef MGf_LOCAL
 	magic->mg_flags |= MGf_LOCAL;
@@ -191,3 +223,42 @@ extern int buffer_scalar_iswrapped(SV *target) {
 	return get_sv_magic(target) != NULL;
 }
 
+/* Wrap 'target' around 'length' bytes at 'offset' of the buffer of 'parent', which must be
+ * a wrapped buffer, or a scalar whose buffer can't move (one with foreign-memory magic like
+ * File::Map, or read-only).  The target holds a reference to the parent, and if the parent
+ * is a wrapped buffer that gets unwrapped, the target is unwrapped too.
+ */
+extern void buffer_scalar_wrap_slice(SV *target, SV *parent, size_t offset, size_t length) {
+	struct buffer_scalar_info *pinfo= get_sv_magic(parent), *info;
+	char *address;
+	size_t parent_len;
+	int flags= 0;
+	if (pinfo) {
+		address= pinfo->address;
+		parent_len= pinfo->length;
+		flags= pinfo->flags & BUFFER_SCALAR_READONLY;
+	}
+	else if (SvPOK(parent) && (SvREADONLY(parent) || (SvMAGICAL(parent) && mg_find(parent, PERL_MAGIC_uvar)))) {
+		address= SvPVX(parent);
+		parent_len= SvCUR(parent);
+	}
+	else
+		croak("Can only slice a mapped buffer or a read-only scalar");
+	if (!address)
+		croak("Buffer is no longer mapped");
+	if (offset > parent_len || length > parent_len - offset)
+		croak("Slice of %lu bytes at %lu exceeds buffer length %lu",
+			(unsigned long) length, (unsigned long) offset, (unsigned long) parent_len);
+	if (SvREADONLY(parent))
+		flags |= BUFFER_SCALAR_READONLY;
+	buffer_scalar_wrap(target, address + offset, length, flags, NULL, NULL);
+	info= get_sv_magic(target);
+	info->parent= SvREFCNT_inc(parent);
+	if (pinfo) {
+		info->parent_info= pinfo;
+		info->next_sibling= pinfo->children;
+		pinfo->children= info;
+	}
+	if (flags & BUFFER_SCALAR_READONLY)
+		SvREADONLY_on(target);
+}
@@ -29,5 +29,10 @@ SKIP: {
 	ok( eval { require OpenGL::Sandbox::ContextShim::GLUT; 1 }, 'Load context shim GLUT' )
 		or diag $@;
 }
+# These only need libEGL/libOSMesa when a context is created
+ok( eval { require OpenGL::Sandbox::ContextShim::EGL; 1 }, 'Load context shim EGL' )
+	or diag $@;
+ok( eval { require OpenGL::Sandbox::ContextShim::OSMesa; 1 }, 'Load context shim OSMesa' )
+	or diag $@;
 
 done_testing;
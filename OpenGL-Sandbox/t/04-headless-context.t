@@ -0,0 +1,33 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox qw( make_context current_context glGetString GL_VERSION );
+
+subtest providers => sub {
+	ok( !eval { make_context(provider => 'NoSuchThing'); 1 }, 'unknown provider' );
+	like( $@, qr/Unhandled context provider/, 'error message' );
+};
+
+subtest egl => sub {
+	my $cx= eval { make_context(provider => 'EGL', width => 32, height => 24,
+		gl_version => '3.3', profile => 'core') }
+		or plan skip_all => "Can't create an EGL context: $@";
+
+	isa_ok( $cx, 'OpenGL::Sandbox::ContextShim::EGL', 'context' );
+	like( $cx->context_info, qr/^EGL .* platform, 32x24 pbuffer/, 'context_info' );
+	my ($major, $minor)= glGetString(GL_VERSION) =~ /^(\d+)\.(\d+)/;
+	ok( $major*10 + $minor >= 33, 'requested version' ) or diag glGetString(GL_VERSION);
+	$cx->swap_buffers;
+
+	ok( !eval { make_context(provider => 'EGL', profile => 'sideways'); 1 }, 'unknown profile' );
+	like( $@, qr/Unknown GL profile/, 'error message' );
+
+	# A second context can be created and made current
+	my $cx2= make_context(provider => 'EGL', width => 16, height => 16);
+	$cx->make_current;
+	is( current_context, $cx, 'switched back' );
+};
+
+done_testing;
@@ -0,0 +1,25 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use FindBin;
+use File::Temp;
+use Test::More;
+
+# The generated code depends on the local glext.h, and the replayer needs a C compiler and the
+# EGL headers, so these only run for the author.
+plan skip_all => 'Set AUTHOR_TESTING to check the generated glducktape.c'
+	unless $ENV{AUTHOR_TESTING};
+
+my $inc= "$FindBin::Bin/../inc";
+my $generated= `$^X $inc/glducktape.pl < $inc/glducktape.list`;
+is( $?, 0, 'glducktape.pl ran' );
+my $committed= do { open my $fh, '<', "$inc/glducktape.c" or die "open: $!"; local $/; <$fh> };
+ok( $generated eq $committed, 'inc/glducktape.c is up to date with glducktape.pl' );
+
+# -Wshadow catches generated locals that hide a parameter of the GL function
+my $tmp= File::Temp->new(SUFFIX => '.o');
+my $cc= $ENV{CC} // 'cc';
+my $out= `$cc -c -Wall -Wextra -Wshadow -Werror -o $tmp $inc/glducktape-replay.c 2>&1`;
+is( $?, 0, 'replayer compiles without warnings' ) or diag $out;
+
+done_testing;
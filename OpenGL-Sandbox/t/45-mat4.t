@@ -0,0 +1,51 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use OpenGL::Sandbox::Mat4;
+use OpenGL::Sandbox::MatrixStack;
+
+sub mat_is {
+	my ($m, $expected, $name)= @_;
+	my @actual= ref $m eq 'ARRAY'? @$m : $m->get;
+	$_= (sprintf('%.04f', $_) =~ s/^-0.0000$/0.0000/r) # negative zero
+		for (@$expected, @actual);
+	is_deeply( \@actual, $expected, $name );
+}
+
+my @identity= (1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1);
+mat_is( OpenGL::Sandbox::Mat4->new, [@identity], 'new is identity' );
+is( length ${ OpenGL::Sandbox::Mat4->new }, 64, 'packed 16 floats' );
+mat_is( OpenGL::Sandbox::Mat4->trans(1,2,3), [1,0,0,0, 0,1,0,0, 0,0,1,0, 1,2,3,1], 'trans' );
+mat_is( OpenGL::Sandbox::Mat4->scale(2), [2,0,0,0, 0,2,0,0, 0,0,2,0, 0,0,0,1], 'scale uniform' );
+mat_is( OpenGL::Sandbox::Mat4->scale(2,3), [2,0,0,0, 0,3,0,0, 0,0,1,0, 0,0,0,1], 'scale xy' );
+mat_is( OpenGL::Sandbox::Mat4->trans_scale(1,2,3, 2), [2,0,0,0, 0,2,0,0, 0,0,2,0, 1,2,3,1], 'trans_scale' );
+mat_is( OpenGL::Sandbox::Mat4->rotate(z => 90), [0,1,0,0, -1,0,0,0, 0,0,1,0, 0,0,0,1], 'rotate z' );
+mat_is( OpenGL::Sandbox::Mat4->rotate(90, 0,0,1), [0,1,0,0, -1,0,0,0, 0,0,1,0, 0,0,0,1], 'rotate axis' );
+mat_is( OpenGL::Sandbox::Mat4->mirror('xz'), [-1,0,0,0, 0,1,0,0, 0,0,-1,0, 0,0,0,1], 'mirror' );
+mat_is( OpenGL::Sandbox::Mat4->ortho(0,2, 0,2, -1,1), [1,0,0,0, 0,1,0,0, 0,0,-1,0, -1,-1,0,1], 'ortho' );
+mat_is( OpenGL::Sandbox::Mat4->frustum(-1,1, -1,1, 1,3), [1,0,0,0, 0,1,0,0, 0,0,-2,-1, 0,0,-3,0], 'frustum' );
+mat_is( OpenGL::Sandbox::Mat4->perspective(90, 1, 1, 3), [1,0,0,0, 0,1,0,0, 0,0,-2,-1, 0,0,-3,0], 'perspective' );
+mat_is( OpenGL::Sandbox::Mat4->look_at([0,0,5], [0,0,0], [0,1,0]), [1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,-5,1], 'look_at' );
+
+my $m= OpenGL::Sandbox::Mat4->new->trans(1,2,3)->rotate(30, 1,1,0)->scale(2,3,4);
+mat_is( $m->clone->mul($m->clone->invert), [@identity], 'm * inverse(m) = identity' );
+mat_is( OpenGL::Sandbox::Mat4->new(1..16)->transpose, [1,5,9,13, 2,6,10,14, 3,7,11,15, 4,8,12,16], 'transpose' );
+ok( !eval { OpenGL::Sandbox::Mat4->scale(0)->invert; 1 }, 'singular matrix dies' );
+
+my $t= OpenGL::Sandbox::Mat4->trans(1,2,3)->scale(2);
+mat_is( [ unpack 'f*', $t->transform_points(pack('f*', 1,1,1, 0,0,0), 3, 4) ], [ 3,4,5,1, 1,2,3,1 ], 'transform_points' );
+mat_is( [ unpack 'f*', $t->transform_points(\pack('f*', 1,1, 2,2), 2) ], [ 3,4, 5,6 ], 'transform_points 2D' );
+
+my $stack= OpenGL::Sandbox::MatrixStack->new;
+my $top= $stack->top;
+$stack->trans(1,0,0);
+$stack->local(sub {
+	$stack->scale(2)->push->trans(1,1,1);
+	mat_is( $top, [2,0,0,0, 0,2,0,0, 0,0,2,0, 3,2,2,1], 'stack modifies top in place' );
+});
+is( $stack->depth, 0, 'local restored depth' );
+mat_is( $stack->top, [1,0,0,0, 0,1,0,0, 0,0,1,0, 1,0,0,1], 'local restored matrix' );
+ok( !eval { $stack->pop; 1 }, 'underflow dies' );
+
+done_testing;
@@ -0,0 +1,33 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Try::Tiny;
+use Test::More;
+use OpenGL::Sandbox qw( make_context current_context gl_missing_functions
+	glGetString GL_VERSION );
+
+my $cx;
+plan skip_all => "Can't create an OpenGL context: $@"
+	unless eval { $cx= make_context(); 1 };
+
+my ($maj, $min)= (glGetString(GL_VERSION) =~ /(\d+)\.(\d+)/);
+my @missing= gl_missing_functions();
+note "missing: @missing";
+if ("$maj.$min" >= 4.5) {
+	is_deeply( \@missing, [], 'nothing missing for GL 4.5' );
+} else {
+	ok( scalar(grep $_ eq 'glMapNamedBufferRange', @missing), 'glMapNamedBufferRange missing before 4.5' );
+}
+
+SKIP: {
+	skip "Requires GL 2.0", 2 unless $maj >= 2;
+	ok( eval { OpenGL::Sandbox::gen_buffers(1); 1 }, 'call through context table' ) or diag $@;
+	current_context(undef);
+	ok( eval { OpenGL::Sandbox::gen_buffers(1); 1 }, 'call through lazy table' ) or diag $@;
+	current_context($cx);
+}
+is( current_context, $cx, 'current_context restored' );
+undef $cx;
+is( current_context, undef, 'context garbage collected' );
+
+done_testing;
@@ -0,0 +1,51 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use OpenGL::Sandbox qw( make_context gl_profile_enable gl_profile_disable gl_profile_reset
+	gl_profile_snapshot gl_profile_report );
+
+my $cx;
+plan skip_all => "Can't create an OpenGL context: $@"
+	unless eval { $cx= make_context(); 1 };
+plan skip_all => "No support for buffer objects in this OpenGL context"
+	unless OpenGL::Sandbox->can('gen_buffers');
+
+my @ids= OpenGL::Sandbox::gen_buffers(1);
+is_deeply( gl_profile_snapshot()->{functions}, {}, 'nothing counted while disabled' );
+
+gl_profile_enable();
+@ids= OpenGL::Sandbox::gen_buffers(2) for 1..3;
+OpenGL::Sandbox::delete_buffers(@ids);
+gl_profile_disable();
+OpenGL::Sandbox::gen_buffers(1);
+
+my $snap= gl_profile_snapshot();
+is( $snap->{enabled}, 0, 'disabled' );
+is( $snap->{functions}{glGenBuffers}{calls}, 3, 'glGenBuffers counted' );
+is( $snap->{functions}{glDeleteBuffers}{calls}, 1, 'glDeleteBuffers counted' );
+is( $snap->{wrappers}{gen_buffers}{calls}, 3, 'gen_buffers wrapper counted' );
+is( $snap->{wrappers}{gen_buffers}{gl_calls}, 3, 'GL calls credited to wrapper' );
+ok( $snap->{wrappers}{gen_buffers}{seconds} >= $snap->{wrappers}{gen_buffers}{gl_seconds}, 'wrapper time includes GL time' );
+like( gl_profile_report(), qr/^glGenBuffers\s+3\s/m, 'report' );
+
+gl_profile_reset();
+is_deeply( gl_profile_snapshot()->{functions}, {}, 'reset' );
+
+# A croak inside a profiled wrapper must not leave its scope as the current one
+OpenGL::Sandbox->import('GL_ARRAY_BUFFER');
+my ($buf_id)= OpenGL::Sandbox::gen_buffers(1);
+gl_profile_enable();
+ok( !eval { OpenGL::Sandbox::load_buffer_data(GL_ARRAY_BUFFER(), 100, 'x'); 1 }, 'croak in load_buffer_data' );
+# bind_buffer isn't a profiled wrapper, so its glBindBuffer belongs to no scope
+OpenGL::Sandbox::bind_buffer(GL_ARRAY_BUFFER(), $buf_id);
+OpenGL::Sandbox::load_buffer_data(GL_ARRAY_BUFFER(), 1, 'x') for 1..2;
+gl_profile_disable();
+OpenGL::Sandbox::delete_buffers($buf_id);
+$snap= gl_profile_snapshot();
+is( $snap->{functions}{glBindBuffer}{calls}, 1, 'glBindBuffer counted' );
+is( $snap->{functions}{glBufferData}{calls}, 2, 'glBufferData counted' );
+is( $snap->{wrappers}{load_buffer_data}{calls}, 2, 'only completed calls counted' );
+is( $snap->{wrappers}{load_buffer_data}{gl_calls}, 2, 'later GL calls not credited to the croaked scope' );
+
+done_testing;
@@ -0,0 +1,46 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use FindBin;
+use Test::More;
+use OpenGL::Sandbox qw( make_context gl_capture_start gl_capture_frame gl_capture_stop
+	gl_capturing GL_ARRAY_BUFFER GL_RGB );
+use OpenGL::Sandbox::Texture;
+
+my $cx;
+plan skip_all => "Can't create an OpenGL context: $@"
+	unless eval { $cx= make_context(); 1 };
+plan skip_all => "No support for buffer objects in this OpenGL context"
+	unless OpenGL::Sandbox->can('gen_buffers');
+
+# Create tmp dir for this script
+mkdir "$FindBin::Bin/tmp";
+my $fname= "$FindBin::Bin/tmp/57-gl-capture.gldt";
+
+ok( !gl_capturing(), 'not capturing' );
+gl_capture_start($fname);
+ok( gl_capturing(), 'capturing' );
+my ($id)= OpenGL::Sandbox::gen_buffers(1);
+OpenGL::Sandbox::bind_buffer(GL_ARRAY_BUFFER, $id);
+for (1..3) {
+	OpenGL::Sandbox::load_buffer_data(GL_ARRAY_BUFFER, undef, "captured payload $_", undef);
+	gl_capture_frame();
+}
+OpenGL::Sandbox::delete_buffers($id);
+my $tx= OpenGL::Sandbox::Texture->new(name => 'captured');
+$tx->load({ width => 4, height => 4, format => GL_RGB, data => \("texel" x 9 . "tex") });
+gl_capture_stop();
+ok( !gl_capturing(), 'stopped' );
+
+my $trace= do { open my $fh, '<:raw', $fname or die "open: $!"; local $/; <$fh> };
+is( substr($trace, 0, 8), 'GLDTRACE', 'header' );
+like( $trace, qr/\x0cglBufferData/, 'function names' );
+is( scalar(() = $trace =~ /captured payload/g), 3, 'buffer data recorded' );
+is( scalar(() = $trace =~ /\xFF\xFF\0\0\0\0/g), 3, 'frame markers' );
+like( $trace, qr/(texel){9}tex/, 'texture pixels recorded' );
+
+ok( !eval { gl_capture_start("$FindBin::Bin/tmp/no/such/dir/x.gldt"); 1 }, 'unwritable path dies' );
+like( $@, qr/Can't write/, 'error message' );
+
+unlink $fname;
+done_testing;
@@ -0,0 +1,65 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use JSON::PP;
+use Time::HiRes 'sleep';
+use OpenGL::Sandbox qw( make_context profile_zone );
+use OpenGL::Sandbox::Profiler;
+
+subtest cpu_zones => sub {
+	my $prof= OpenGL::Sandbox::Profiler->new(gpu => 0, history => 5)->start;
+	is( $OpenGL::Sandbox::Profiler::active, $prof, 'active' );
+	for (1..8) {
+		my $ret= profile_zone outer => sub {
+			profile_zone inner => sub { sleep .002 };
+			42;
+		};
+		is( $ret, 42, 'zone returns value' ) if $_ == 1;
+		$prof->end_frame;
+	}
+	ok( !eval { profile_zone fail => sub { die "oops\n" }; 1 }, 'exception propagates' );
+	is( $@, "oops\n", 'exception text' );
+	$prof->end_frame;
+	$prof->stop;
+	ok( !$OpenGL::Sandbox::Profiler::active, 'stopped' );
+	is( profile_zone(none => sub { 7 }), 7, 'profile_zone without profiler' );
+
+	is( $prof->frame_count, 9, 'frame count' );
+	my $stats= $prof->stats;
+	is( $stats->{outer}{count}, 8, 'outer count' );
+	is( $stats->{fail}{count}, 1, 'zone ended after exception' );
+	ok( $stats->{inner}{cpu}{p50} >= 2, 'inner time' ) or diag explain $stats->{inner};
+	ok( $stats->{outer}{cpu}{mean} >= $stats->{inner}{cpu}{mean}, 'outer includes inner' );
+	ok( !$stats->{inner}{gpu}, 'no gpu stats' );
+	like( $prof->report, qr/^inner\s+8\s/m, 'report' );
+
+	my $trace= decode_json($prof->chrome_trace);
+	my @x= grep $_->{ph} eq 'X', @{ $trace->{traceEvents} };
+	is( scalar(grep $_->{name} eq 'frame', @x), 5, 'trace keeps history frames' );
+	my ($o)= grep $_->{name} eq 'outer', @x;
+	my ($i)= grep $_->{name} eq 'inner' && $_->{ts} >= $o->{ts}, @x;
+	ok( $i->{ts} + $i->{dur} <= $o->{ts} + $o->{dur}, 'inner nested within outer' );
+};
+
+subtest gpu_zones => sub {
+	my $cx= eval { make_context() }
+		or plan skip_all => "Can't create an OpenGL context: $@";
+	my $prof= OpenGL::Sandbox::Profiler->new(latency => 2);
+	$prof->gpu or plan skip_all => "No timer queries in this OpenGL context";
+	$prof->start;
+	for (1..6) {
+		profile_zone clear => sub { OpenGL::Sandbox::glClear(OpenGL::Sandbox::GL_COLOR_BUFFER_BIT()) };
+		OpenGL::Sandbox::next_frame();
+	}
+	ok( $prof->frame_count <= 4, 'results are delayed' ) or diag $prof->frame_count;
+	$prof->stop;
+	is( $prof->frame_count, 6, 'all frames collected on stop' );
+	my $stats= $prof->stats;
+	ok( defined $stats->{clear}{gpu}{mean}, 'gpu time of zone' );
+	ok( defined $stats->{frame}{gpu}{mean}, 'gpu time of frame' );
+	my $trace= decode_json($prof->chrome_trace);
+	ok( (grep $_->{tid} == 2 && $_->{ph} eq 'X', @{ $trace->{traceEvents} }), 'gpu events in trace' );
+};
+
+done_testing;
@@ -0,0 +1,51 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox qw( make_context current_context glEnable glFinish get_gl_errors
+	gl_debug_enable gl_debug_disable gl_debug_active gl_debug_messages );
+
+subtest options => sub {
+	ok( !eval { gl_debug_enable(min_severity => 'urgent'); 1 }, 'unknown severity' );
+	like( $@, qr/Unknown severity/, 'error message' );
+};
+
+subtest messages => sub {
+	my $cx;
+	plan skip_all => "Can't create an OpenGL context: $@"
+		unless eval { $cx= make_context(debug => 0); 1 };
+	plan skip_all => "Context doesn't support KHR_debug"
+		unless gl_debug_enable(synchronous => 1);
+
+	ok( gl_debug_active(), 'active' );
+	current_context(undef);
+	ok( !gl_debug_active(), 'not active without a context' );
+	current_context($cx);
+	ok( gl_debug_active(), 'active again for the context' );
+	glEnable(0x9999);
+	glFinish();
+	my @msg= gl_debug_messages();
+	ok( (grep $_->{type} eq 'error' && $_->{source} eq 'api', @msg), 'invalid enum reported' )
+		or diag explain \@msg;
+	is( scalar(gl_debug_messages()), 0, 'drained' );
+
+	glEnable(0x9999);
+	glFinish();
+	my @errors= get_gl_errors();
+	ok( scalar @errors, 'get_gl_errors returns debug errors' );
+	unlike( $errors[0] // '', qr/^GL_INVALID_ENUM$/, 'as the detailed message' );
+
+	# sources filter
+	gl_debug_enable(sources => [ 'application' ]);
+	glEnable(0x9999);
+	glFinish();
+	is( scalar(gl_debug_messages()), 0, 'api messages filtered' );
+
+	gl_debug_disable();
+	ok( !gl_debug_active(), 'inactive' );
+	glEnable(0x9999);
+	is_deeply( [ get_gl_errors() ], [ 'GL_INVALID_ENUM' ], 'back to glGetError' );
+};
+
+done_testing;
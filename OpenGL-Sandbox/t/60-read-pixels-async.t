@@ -0,0 +1,40 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox qw( make_context get_gl_errors read_pixels_async
+	glClearColor glClear GL_COLOR_BUFFER_BIT GL_RGB GL_UNSIGNED_BYTE );
+
+plan skip_all => "Can't create an OpenGL context: $@"
+	unless eval { make_context(width => 16, height => 8, visible => 0); 1 };
+plan skip_all => "read_pixels_async not available: $@"
+	unless eval { read_pixels_async(flush => 1); 1 };
+
+my @got;
+for my $frame (1..5) {
+	glClearColor($frame/10, 0, 0, 1);
+	glClear(GL_COLOR_BUFFER_BIT);
+	my ($pixels, $w, $h)= read_pixels_async(width => 4, height => 2, format => GL_RGB, type => GL_UNSIGNED_BYTE);
+	if ($frame < 3) {
+		ok( !defined $pixels, "nothing for frame $frame" );
+		next;
+	}
+	is( length $$pixels, 4*2*3, "frame $frame length" );
+	is( "$w x $h", '4 x 2', 'size' );
+	ok( !eval { substr($$pixels, 0, 1)= 'x'; 1 }, 'read-only' );
+	push @got, ord $$pixels;
+	if ($frame == 5) {
+		push @got, ord ${ read_pixels_async(flush => 1) };
+		is( length $$pixels, 0, 'previous frame released by next call' );
+		$$pixels .= 'x';
+		is( $$pixels, 'x', 'released frame is an ordinary string' );
+	}
+}
+push @got, ord ${ read_pixels_async(flush => 1) };
+ok( !read_pixels_async(flush => 1), 'ring empty' );
+ok( @got == 5 && !grep(abs($got[$_] - ($_+1) * 25.5) > 1, 0..4), 'frames returned in order, two behind' )
+	or diag explain \@got;
+is_deeply( [ get_gl_errors() ], [], 'no GL errors' );
+
+done_testing;
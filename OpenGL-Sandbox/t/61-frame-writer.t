@@ -0,0 +1,92 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use FindBin;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox::FrameWriter;
+
+# Create tmp dir for this script
+mkdir "$FindBin::Bin/tmp";
+my $tmp= "$FindBin::Bin/tmp/$FindBin::Script";
+$tmp =~ s/\.t$// or die "can't calc temp dir";
+-d $tmp || mkdir $tmp or die "Can't create dir $tmp";
+
+sub slurp { open my $fh, '<:raw', $_[0] or die "open($_[0]): $!"; local $/; <$fh> }
+
+# 4x2 frames, bottom row red and top row blue, as glReadPixels would return them
+my $frame= (pack('C4', 255,0,0,255) x 4) . (pack('C4', 0,0,255,255) x 4);
+
+subtest raw => sub {
+	my $w= OpenGL::Sandbox::FrameWriter->new(path => "$tmp/out.raw", width => 4, height => 2, on_full => 'block');
+	is( $w->format, 'raw', 'format from extension' );
+	ok( $w->write($frame), 'write scalar' );
+	ok( $w->write(\$frame), 'write scalar ref' );
+	$w->close;
+	is( $w->frames_written, 2, 'frames_written' );
+	is( slurp("$tmp/out.raw"), (substr($frame, 16) . substr($frame, 0, 16)) x 2, 'flipped' );
+	ok( !eval { $w->write($frame); 1 }, 'write after close dies' );
+
+	$w= OpenGL::Sandbox::FrameWriter->new(path => "$tmp/out.rgba", width => 4, height => 2, flip => 0);
+	$w->write($frame);
+	$w->close;
+	is( slurp("$tmp/out.rgba"), $frame, 'not flipped' );
+};
+
+subtest y4m => sub {
+	my $w= OpenGL::Sandbox::FrameWriter->new(path => "$tmp/out.y4m", width => 4, height => 2, fps => 29.97, on_full => 'block');
+	$w->write($frame) for 1..3;
+	$w->close;
+	my $data= slurp("$tmp/out.y4m");
+	like( $data, qr/^YUV4MPEG2 W4 H2 F30000:1001 Ip A1:1 C420jpeg\n/, 'header' );
+	my @frames= split /FRAME\n/, $data;
+	shift @frames;
+	is( scalar @frames, 3, '3 frames' );
+	is( length $frames[0], 8 + 2 + 2, 'Y plane and half-size U,V' );
+	my @y= unpack 'C8', $frames[0];
+	ok( abs($y[0] - 29) <= 1 && abs($y[4] - 76) <= 1, 'blue on top, red on bottom' )
+		or diag "@y";
+};
+
+subtest png => sub {
+	my $w= OpenGL::Sandbox::FrameWriter->new(path => "$tmp/f%03d.png", width => 4, height => 2, on_full => 'block');
+	$w->write($frame) for 1..2;
+	$w->close;
+	ok( -f "$tmp/f000.png" && -f "$tmp/f001.png", 'numbered files' );
+	my $png= slurp("$tmp/f001.png");
+	is( substr($png, 0, 8), "\x89PNG\r\n\x1a\n", 'signature' );
+	is_deeply( [ unpack 'x12 a4 N N C2', $png ], [ 'IHDR', 4, 2, 8, 6 ], '4x2 8-bit RGBA' );
+	SKIP: {
+		skip "Compress::Zlib not available", 1 unless eval { require Compress::Zlib };
+		my ($len)= unpack 'N', substr($png, 33, 4);
+		my $raw= Compress::Zlib::uncompress(substr($png, 41, $len));
+		is( $raw, "\0".substr($frame, 16)."\0".substr($frame, 0, 16), 'pixel data' );
+	}
+	ok( !eval { OpenGL::Sandbox::FrameWriter->new(path => "$tmp/f.png", width => 4, height => 2) },
+		'png requires %d in path' );
+};
+
+subtest policy => sub {
+	my $big= "\0" x (256*256*4);
+	my $w= OpenGL::Sandbox::FrameWriter->new(path => "$tmp/drop.raw", width => 256, height => 256, queue_size => 1);
+	my $queued= grep $w->write($big), 1..50;
+	$w->close;
+	is( $w->frames_written, $queued, 'queued frames written' );
+	is( $w->frames_written + $w->frames_dropped, 50, 'others dropped' );
+	is( -s "$tmp/drop.raw", $queued * length $big, 'file size' );
+
+	$w= OpenGL::Sandbox::FrameWriter->new(path => "$tmp/block.raw", width => 256, height => 256, queue_size => 1, on_full => 'block');
+	ok( !grep(!$w->write($big), 1..50), 'block never drops' );
+	$w->close;
+	is( $w->frames_written, 50, 'all written' );
+	is( $w->frames_dropped, 0, 'none dropped' );
+};
+
+ok( !eval { OpenGL::Sandbox::FrameWriter->new(path => "$tmp/x.raw", width => 4, height => 2)->write('x'); 1 },
+	'wrong frame size dies' );
+ok( !eval { OpenGL::Sandbox::FrameWriter->new(path => "$tmp/no/such/dir/x.raw", width => 4, height => 2) },
+	'unwritable path dies' );
+ok( !eval { OpenGL::Sandbox::FrameWriter->new(path => "$tmp/x.mov", width => 4, height => 2) },
+	'unknown format dies' );
+
+done_testing;
@@ -0,0 +1,91 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox::BufferView;
+
+sub view { OpenGL::Sandbox::BufferView->new(@_) }
+
+subtest types => sub {
+	my $data= pack('f3 S3 x2', 1.5, -2, 3, 1, 2, 65535);
+	my $f= view(\$data, type => 'vec3');
+	is( $f->count, 1, 'count from length' );
+	is_deeply( [ $f->get(0) ], [ 1.5, -2, 3 ], 'get vec3' );
+	my $s= view(\$data, type => 'uint16', offset => 12, count => 3);
+	is_deeply( [ $s->get_all ], [ 1, 2, 65535 ], 'get_all uint16' );
+	is( $s->get(-1), 65535, 'negative index' );
+	$s->set(0, 70000);
+	$s->set(1, 2.6);
+	is_deeply( [ unpack 'x12 S2', $data ], [ 65535, 3 ], 'set clamps and rounds' );
+	my $h= view(\$data, type => 'half', offset => 18, count => 1);
+	$h->set(0, 0.333333);
+	is( $h->get(0), 0.333251953125, 'half rounds to nearest' );
+	$h->set(0, 1e6);
+	is( $h->get(0), 9**9**9, 'half overflows to inf' );
+	is( $h->type_name, 'half', 'type_name' );
+	ok( !eval { view(\$data, type => 'vec3', count => 3) }, 'count past end dies' );
+	ok( !eval { view(\$data, type => 'quad') }, 'unknown type dies' );
+};
+
+subtest interleaved => sub {
+	# position(vec3), color(4 x uint8)
+	my $data= pack('(f3 C4)*', map { ($_, $_*2, $_*3, 10, 20, 30, 255) } 0..9);
+	my $pos= view(\$data, type => 'vec3', stride => 16);
+	my $col= view(\$data, type => 'uint8', components => 4, stride => 16, offset => 12);
+	is( $pos->count, 10, 'count with stride' );
+	$pos->scale(2, 1, 1)->add(0, 0, -1);
+	is_deeply( [ $pos->get(3) ], [ 6, 6, 8 ], 'scale and add per component' );
+	$col->slice(5)->fill(1, 2, 3, 4);
+	is_deeply( [ $col->get(4), $col->get(5), $col->get(9) ], [ 10,20,30,255, 1,2,3,4, 1,2,3,4 ], 'fill slice' );
+	my $vel= view(\(pack 'f*', (1, 0, 0) x 10), type => 'vec3');
+	$pos->add($vel, .5);
+	is_deeply( [ $pos->get(3) ], [ 6.5, 6, 8 ], 'add view * factor' );
+	is( $pos->copy_from([ [9, 9, 9], [8, 8, 8] ]), 2, 'copy_from nested array' );
+	is( $pos->slice(2, 1)->copy_from([ 7, 7, 7 ]), 1, 'copy_from flat array' );
+	is_deeply( [ map $pos->get($_), 0..2 ], [ 9,9,9, 8,8,8, 7,7,7 ], 'copied' );
+	is_deeply( [ $col->get(0) ], [ 10, 20, 30, 255 ], 'other attribute untouched' );
+};
+
+subtest copy => sub {
+	my $data= pack('f*', 0..9);
+	my $v= view(\$data);
+	$v->slice(1)->copy_from($v);
+	is_deeply( [ $v->get_all ], [ 0, 0..8 ], 'overlapping copy' );
+	my $ints= "\0" x 20;
+	is( view(\$ints, type => 'int16')->copy_from($v), 10, 'copy converts type' );
+	is_deeply( [ unpack 's*', $ints ], [ 0, 0..8 ], 'converted' );
+	ok( !eval { view(\$ints, type => 'vec2')->copy_from($v); 1 }, 'component mismatch dies' );
+};
+
+subtest lifetime => sub {
+	my $v= do { my $data= pack 'f4', 1..4; view(\$data) };
+	is_deeply( [ $v->get_all ], [ 1..4 ], 'view keeps its scalar alive' );
+	my $ro= "\0" x 8;
+	Internals::SvREADONLY($ro, 1);
+	ok( !eval { view(\$ro)->fill(1); 1 }, 'read-only scalar' );
+	my $str= pack 'f2', 1, 2;
+	my $copy= $str;
+	view(\$str)->fill(5);
+	is_deeply( [ unpack 'f2', $copy ], [ 1, 2 ], 'writing does not change copies of the string' );
+};
+
+SKIP: {
+	skip "Can't create an OpenGL context: $@", 1
+		unless eval { require OpenGL::Sandbox; OpenGL::Sandbox::make_context(); require OpenGL::Sandbox::Buffer; 1 };
+	skip "unmap crashes on Windows", 1 if $^O eq 'MSWin32';
+	subtest mapped => sub {
+		my $buf= OpenGL::Sandbox::Buffer->new(target => OpenGL::Sandbox::GL_ARRAY_BUFFER());
+		$buf->load(pack 'f*', 1..12);
+		$buf->mmap('r+');
+		my $v= $buf->view(type => 'vec4');
+		is( $v->count, 3, 'view of mapped buffer' );
+		$v->slice(1)->scale(10);
+		$buf->unmap;
+		ok( !eval { $v->get(0); 1 }, 'view dies after unmap' );
+		is_deeply( [ unpack 'f*', ${ $buf->mmap('r') } ], [ 1..4, map $_*10, 5..12 ], 'changes written to buffer' );
+		$buf->unmap;
+	};
+}
+
+done_testing;
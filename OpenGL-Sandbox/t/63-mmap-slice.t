@@ -0,0 +1,73 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use FindBin;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox::MMap;
+use OpenGL::Sandbox::Mat4;
+
+# Create tmp dir for this script
+mkdir "$FindBin::Bin/tmp";
+my $tmp= "$FindBin::Bin/tmp/$FindBin::Script";
+$tmp =~ s/\.t$// or die "can't calc temp dir";
+-d $tmp || mkdir $tmp or die "Can't create dir $tmp";
+
+my $bytes= pack('f*', 0..11) . 'tail';
+open my $fh, '>:raw', "$tmp/data.bin" or die "open: $!";
+print $fh $bytes;
+close $fh;
+
+my $mmap= OpenGL::Sandbox::MMap->new("$tmp/data.bin");
+my $s= $mmap->slice(8, 16);
+isa_ok( $s, 'OpenGL::Sandbox::MMap', 'slice' );
+is( $s->size, 16, 'size' );
+is( $$s, substr($bytes, 8, 16), 'contents' );
+is( ${ $mmap->slice(-4) }, 'tail', 'negative offset' );
+is( ${ $mmap->slice(0, -4) }, substr($bytes, 0, 48), 'negative length' );
+is( ${ $s->slice(4, 4) }, substr($bytes, 12, 4), 'slice of a slice' );
+ok( !eval { $mmap->slice(40, 20); 1 }, 'slice past end dies' );
+ok( !eval { substr($$s, 0, 1)= 'x'; 1 }, 'slice of read-only mapping is read-only' );
+
+my $keep= do { my $m= OpenGL::Sandbox::MMap->new("$tmp/data.bin"); $m->slice(48) };
+is( $$keep, 'tail', 'slice keeps the mapping alive' );
+
+is_deeply(
+	[ unpack 'f*', OpenGL::Sandbox::Mat4->new->scale(2)->transform_points($mmap->slice(12, 36)) ],
+	[ map $_*2, 3..11 ],
+	'slice accepted as point data'
+);
+
+# The magic callbacks receive the interpreter as their first argument on threaded perls
+ok( !eval { local $$s; 1 }, 'localizing a slice dies' );
+like( $@, qr/Can't localize view of foreign buffer/, 'error message' );
+{
+	my $m= OpenGL::Sandbox::MMap->new("$tmp/data.bin");
+	my $t= $m->slice(0, 4);
+	undef $m;
+	undef $t;
+}
+is( $$s, substr($bytes, 8, 16), 'freeing another mapping and its slice leaves this one intact' );
+
+my $str= 'abcdef';
+ok( !eval { OpenGL::Sandbox::MMap::slice(\$str, 1, 2); 1 }, 'writable plain string refused' );
+Internals::SvREADONLY($str, 1);
+is( ${ OpenGL::Sandbox::MMap::slice(\$str, 1, 2) }, 'bc', 'read-only string allowed' );
+
+SKIP: {
+	skip "Can't create an OpenGL context: $@", 4
+		unless eval { require OpenGL::Sandbox; OpenGL::Sandbox::make_context(); require OpenGL::Sandbox::Buffer; 1 };
+	skip "unmap crashes on Windows", 4 if $^O eq 'MSWin32';
+	my $buf= OpenGL::Sandbox::Buffer->new(target => OpenGL::Sandbox::GL_ARRAY_BUFFER());
+	$buf->load($bytes);
+	my $part= $buf->mmap('r+')->slice(48, 4);
+	is( $$part, 'tail', 'slice of mapped buffer' );
+	my $inner= $part->slice(1, 2);
+	$buf->unmap;
+	is( length $$part, 0, 'slice emptied by unmap' );
+	is( length $$inner, 0, 'nested slice emptied by unmap' );
+	$$part .= 'new';
+	is( $$part, 'new', 'emptied slice is an ordinary string' );
+}
+
+done_testing;
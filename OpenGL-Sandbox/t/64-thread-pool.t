@@ -0,0 +1,84 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox::BufferView;
+use OpenGL::Sandbox::ThreadPool;
+use OpenGL::Sandbox::Mat4;
+
+sub view { OpenGL::Sandbox::BufferView->new(@_) }
+
+# Enough elements that every thread gets several ranges
+my $n= 100_000;
+
+for my $threads (4, 0) {
+	subtest "threads=$threads" => sub {
+		my $pool= OpenGL::Sandbox::ThreadPool->new(threads => $threads);
+		is( $pool->threads, $threads, 'threads' );
+		# position(vec3), velocity(vec3)
+		my $data= "\0" x ($n * 24);
+		my $pos= view(\$data, type => 'vec3', stride => 24);
+		my $vel= view(\$data, type => 'vec3', stride => 24, offset => 12);
+		$pool->run(fill => $pos, 1, 2, 3);
+		$pool->run(fill => $vel, .5);
+		is_deeply( [ map $pos->get($_), 0, $n/2, $n-1 ], [ (1,2,3) x 3 ], 'fill per component' );
+		$pool->run(combine => $pos, $vel, 1, 2);
+		is_deeply( [ map $pos->get($_), 0, $n-1 ], [ (2,3,4) x 2 ], 'combine' );
+		$pool->run(scale_add => $pos, 2, 1, 2, 0, -2, 0);
+		is_deeply( [ map $pos->get($_), 7, 77777 ], [ (4,1,8) x 2 ], 'scale_add per component' );
+		$pool->start(transform => $pos, OpenGL::Sandbox::Mat4->new->scale(.5, 1, 2));
+		$pool->wait;
+		ok( !$pool->busy, 'not busy after wait' );
+		is_deeply( [ $pos->get($n-1) ], [ 2, 1, 16 ], 'transform by Mat4' );
+		is_deeply( [ $vel->get($n-1) ], [ .5, .5, .5 ], 'interleaved data untouched' );
+	};
+}
+
+subtest overlap => sub {
+	my $pool= OpenGL::Sandbox::ThreadPool->new(threads => 3);
+	my $data= pack('f*', 0 .. $n-1);
+	my $all= view(\$data);
+	$pool->run(combine => $all->slice(1), $all, 0, 1);
+	is_deeply( [ map $all->get($_), 0, 1, 2, $n-1 ], [ 0, 0, 1, $n-2 ], 'overlapping copy reads source first' );
+	$pool->run(combine => $all, $all, 1, 1);
+	is( $all->get($n-1), 2*($n-2), 'same view as source' );
+};
+
+subtest interleaved => sub {
+	my $pool= OpenGL::Sandbox::ThreadPool->new(threads => 4);
+	my $data= pack('f*', (1, 2, 3, .5, .5, .5) x $n);
+	my $pos= view(\$data, type => 'vec3', stride => 24);
+	my $vel= view(\$data, type => 'vec3', stride => 24, offset => 12);
+	# A job that must run serially only runs in 'wait', so it would stay busy
+	$pool->start(combine => $pos, $vel, 1, 1);
+	my $t= time + 10;
+	select(undef, undef, undef, .01) while $pool->busy && time < $t;
+	ok( !$pool->busy, 'pos and vel of the same vertices run on the worker threads' );
+	$pool->wait;
+	is_deeply( [ map $pos->get($_), 0, $n-1 ], [ (1.5, 2.5, 3.5) x 2 ], 'combined' );
+	is_deeply( [ $vel->get($n-1) ], [ .5, .5, .5 ], 'source untouched' );
+};
+
+subtest errors => sub {
+	my $pool= OpenGL::Sandbox::ThreadPool->new(threads => 1);
+	my $data= "\0" x 48;
+	my $v= view(\$data, type => 'vec3');
+	my $v2= view(\$data, type => 'vec2');
+	ok( !eval { $pool->run(nope => $v); 1 }, 'unknown kernel' );
+	like( $@, qr/No kernel named/, '...message' );
+	ok( !eval { $pool->run(fill => $v, 1, 2); 1 }, 'wrong number of params' );
+	ok( !eval { $pool->run(combine => $v, 1, 1); 1 }, 'missing source view' );
+	ok( !eval { $pool->run(combine => $v, $v2, 1, 1); 1 }, 'different components' );
+	my $mat= OpenGL::Sandbox::Mat4->new;
+	ok( !eval { $pool->run(transform => view(\$data, type => 'ivec3'), $mat); 1 }, 'transform of ints' );
+	like( $@, qr/needs float components/, '...message' );
+	ok( !eval { $pool->run(transform => view(\$data), $mat); 1 }, 'transform of scalars' );
+	like( $@, qr/needs 2, 3 or 4 components/, '...message' );
+	ok( !eval { OpenGL::Sandbox::ThreadPool->register_kernel(fill => 1234); 1 }, "can't replace built-in" );
+	ok( (grep $_ eq 'transform', OpenGL::Sandbox::ThreadPool->kernels), 'kernels' );
+	my $ro= view(\"\0\0\0\0");
+	ok( !eval { $pool->run(fill => $ro, 1); 1 }, 'read-only source' );
+};
+
+done_testing;
@@ -0,0 +1,112 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox qw( GL_UNSIGNED_SHORT GL_UNSIGNED_INT GL_FLOAT GL_SHORT );
+use OpenGL::Sandbox::Mesh;
+use OpenGL::Sandbox::ThreadPool;
+
+sub mesh { my $ctor= shift; OpenGL::Sandbox::Mesh->$ctor(@_) }
+
+# Return the vertices as [ [x,y,z, nx,ny,nz, u,v], ... ] and the indices
+sub unpack_mesh {
+	my $m= shift;
+	my @v= unpack 'f*', $m->vertex_data;
+	my @vert= map [ @v[$_*8 .. $_*8+7] ], 0 .. $m->vertex_count - 1;
+	my @idx= unpack($m->index_type == GL_UNSIGNED_SHORT? 'S*' : 'L*', $m->index_data);
+	return (\@vert, \@idx);
+}
+
+# Check every triangle faces the way of its vertex normals, and indices are in range
+sub check_mesh {
+	my ($name, $m)= @_;
+	my ($vert, $idx)= unpack_mesh($m);
+	is( scalar @$idx, $m->index_count, "$name index count" );
+	my ($bad_index, $bad_winding, $degenerate)= (0, 0, 0);
+	for (my $i= 0; $i < @$idx; $i += 3) {
+		my @t= map $vert->[$_], @$idx[$i..$i+2];
+		if (grep !defined, @t) { $bad_index++; next; }
+		my @e1= map $t[1][$_] - $t[0][$_], 0..2;
+		my @e2= map $t[2][$_] - $t[0][$_], 0..2;
+		my @n= ( $e1[1]*$e2[2] - $e1[2]*$e2[1], $e1[2]*$e2[0] - $e1[0]*$e2[2], $e1[0]*$e2[1] - $e1[1]*$e2[0] );
+		my $len= sqrt($n[0]**2 + $n[1]**2 + $n[2]**2);
+		if ($len < 1e-9) { $degenerate++; next; } # sphere poles
+		my @vn= map $t[0][3+$_] + $t[1][3+$_] + $t[2][3+$_], 0..2;
+		$bad_winding++ if $n[0]*$vn[0] + $n[1]*$vn[1] + $n[2]*$vn[2] <= 0;
+	}
+	is( $bad_index, 0, "$name indices in range" );
+	is( $bad_winding, 0, "$name triangles face outward" );
+	return ($vert, $idx, $degenerate);
+}
+
+subtest plane => sub {
+	my $m= mesh(plane => width => 2, height => 4, columns => 2, rows => 1);
+	is( $m->vertex_count, 6, 'vertex_count' );
+	is( $m->stride, 32, 'stride' );
+	my ($vert)= check_mesh(plane => $m);
+	is_deeply( $vert->[0], [ -1, -2, 0, 0, 0, 1, 0, 0 ], 'first vertex' );
+	is_deeply( $vert->[5], [ 1, 2, 0, 0, 0, 1, 1, 1 ], 'last vertex' );
+};
+
+subtest shapes => sub {
+	my (undef, undef, $deg)= check_mesh(sphere => mesh(sphere => radius => 2, segments => 12, rings => 6));
+	is( $deg, 24, 'only the pole triangles are degenerate' );
+	check_mesh(cylinder => mesh(cylinder => radius => 1, top_radius => .5, height => 2, segments => 10, rows => 3));
+	check_mesh(torus => mesh(torus => segments => 12, sides => 8));
+	my $ico= mesh(icosphere => radius => 3, subdivisions => 4);
+	is( $ico->vertex_count, 20*15, 'icosphere vertex_count' );
+	my ($vert, $idx)= check_mesh(icosphere => $ico);
+	my $off= grep abs(sqrt($_->[0]**2 + $_->[1]**2 + $_->[2]**2) - 3) > 1e-5, @$vert;
+	is( $off, 0, 'icosphere vertices on the sphere' );
+	my $seam= 0;
+	for (my $i= 0; $i < @$idx; $i += 3) {
+		my @u= sort { $a <=> $b } map $vert->[$_][6], @$idx[$i..$i+2];
+		$seam++ if $u[2] - $u[0] > .5;
+	}
+	is( $seam, 0, 'icosphere texture coordinates continuous' );
+};
+
+subtest heightfield => sub {
+	# a slope rising 1 unit per unit of x
+	my $heights= pack 'f*', map { my $c= $_ % 3; $c } 0..8;
+	my $m= mesh(heightfield => heights => \$heights, columns => 2, rows => 2, width => 2, depth => 2);
+	my ($vert)= check_mesh(heightfield => $m);
+	is_deeply( [ @{$vert->[5]}[0..2] ], [ 1, 0, 2 ], 'height applied' );
+	my $s= sqrt(.5);
+	ok( abs($vert->[4][3] + $s) < 1e-6 && abs($vert->[4][5] - $s) < 1e-6, 'normal of slope' )
+		or diag explain $vert->[4];
+	ok( !eval { mesh(heightfield => heights => \"\0" x 8, columns => 2, rows => 2)->vertex_data; 1 }, 'too few heights' );
+};
+
+subtest layout => sub {
+	my $m= mesh(plane => columns => 1, rows => 1, attributes => [
+		pos => { from => 'position', components => 4 },
+		n   => { from => 'normal', type => 'int16', normalized => 1, components => 3 },
+	]);
+	is( $m->stride, 24, 'stride with alignment' );
+	is_deeply( [ unpack 'f4 s3', $m->vertex_data ], [ -.5, -.5, 0, 1, 0, 0, 32767 ], 'w=1 and normalized int' );
+	my $a= $m->vertex_array_attributes(offset => 100);
+	is_deeply( $a->{n}, { size => 3, type => GL_SHORT, normalized => 1, stride => 24, pointer => 116 }, 'vertex_array_attributes' );
+	my $data= "\0" x 200;
+	is( $m->write_vertices(\$data, offset => 8), 3*24+22, 'write at offset' );
+	is( substr($data, 8, 16), pack('f4', -.5, -.5, 0, 1), '...bytes' );
+	is_deeply( [ unpack 'L*', $m->index_data(type => GL_UNSIGNED_INT, base => 10) ], [ 10, 11, 13, 10, 13, 12 ], 'index type and base' );
+	ok( !eval { mesh(plane => attributes => [ color => 'vec4' ]); 1 }, 'unknown attribute' );
+	ok( !eval { $m->write_vertices(\(my $short= "\0" x 20)); 1 }, 'target too short' );
+	ok( !eval { mesh(sphere => segments => 300, rings => 300)->index_data(type => GL_UNSIGNED_SHORT); 1 }, 'index type too small' );
+};
+
+subtest pool => sub {
+	my $pool= OpenGL::Sandbox::ThreadPool->new(threads => 4);
+	for my $m (mesh(torus => segments => 300, sides => 100), mesh(icosphere => subdivisions => 40)) {
+		my $name= $m->shape;
+		is( $m->vertex_data(pool => $pool), $m->vertex_data, "$name vertices same with pool" );
+		is( $m->index_data(pool => $pool), $m->index_data, "$name indices same with pool" );
+	}
+	my $heights= pack 'f*', map sin($_ / 50), 0 .. 201*201-1;
+	my $m= mesh(heightfield => heights => \$heights, columns => 200, rows => 200);
+	is( $m->vertex_data(pool => $pool), $m->vertex_data, 'heightfield same with pool' );
+};
+
+done_testing;
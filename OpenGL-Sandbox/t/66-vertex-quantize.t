@@ -0,0 +1,153 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox qw( GL_SHORT GL_UNSIGNED_BYTE GL_HALF_FLOAT );
+use OpenGL::Sandbox::BufferView;
+use OpenGL::Sandbox::ThreadPool;
+use OpenGL::Sandbox::Mesh;
+use OpenGL::Sandbox::VertexArray;
+
+sub view { OpenGL::Sandbox::BufferView->new(@_) }
+
+# Largest angle in degrees between corresponding unit vectors of two lists of (x,y,z)
+sub max_angle {
+	my ($a, $b)= @_;
+	my $max= 0;
+	for (my $i= 0; $i < @$a; $i += 3) {
+		my ($x, $y)= ([ @$a[$i..$i+2] ], [ @$b[$i..$i+2] ]);
+		my @c= ( $x->[1]*$y->[2] - $x->[2]*$y->[1], $x->[2]*$y->[0] - $x->[0]*$y->[2], $x->[0]*$y->[1] - $x->[1]*$y->[0] );
+		my $dot= $x->[0]*$y->[0] + $x->[1]*$y->[1] + $x->[2]*$y->[2];
+		my $deg= atan2(sqrt($c[0]**2 + $c[1]**2 + $c[2]**2), $dot) * 45 / atan2(1,1);
+		$max= $deg if $deg > $max;
+	}
+	$max;
+}
+
+# Unit vectors spread over the sphere, including the axes and the octahedron's edges
+my @normals= ( 1,0,0, -1,0,0, 0,1,0, 0,-1,0, 0,0,1, 0,0,-1, map {
+	my ($z, $t)= (1 - 2 * ($_ + .5) / 500, $_ * 2.399963);
+	my $r= sqrt(1 - $z*$z);
+	($r * cos($t), $r * sin($t), $z)
+} 0..499 );
+my $n_normals= @normals / 3;
+
+subtest normalized => sub {
+	my $data= "\0" x 16;
+	my $s= view(\$data, type => 'int16', components => 2, normalized => 1);
+	ok( $s->normalized, 'normalized attribute' );
+	$s->set(0, 1, -1);
+	$s->set(1, .5, -2);
+	is_deeply( [ unpack 's4', $data ], [ 32767, -32767, 16384, -32767 ], 'signed scaled and clamped' );
+	substr($data, 0, 2, pack 's', -32768);
+	is( ($s->get(0))[0], -1, 'lowest integer reads as -1' );
+	my $u= view(\$data, type => 'uint8', components => 4, normalized => 1);
+	$u->fill(1, .5, 0, -1);
+	is_deeply( [ unpack 'C4', $data ], [ 255, 128, 0, 0 ], 'unsigned' );
+	is( ($u->slice(1)->get(0))[0], 1, 'slice keeps normalized' );
+	my $f= view(\$data, type => 'float', normalized => 1);
+	$f->set(0, 3);
+	is( ($f->get(0))[0], 3, 'floats unaffected' );
+	my $raw= view(\$data, type => 'uint8');
+	is( ($raw->get(0))[0], 0, 'not normalized by default' );
+};
+
+subtest packed => sub {
+	my $data= "\0" x 8;
+	my $v= view(\$data, type => 'int2_10_10_10_rev', normalized => 1);
+	is( $v->components, 4, 'implies 4 components' );
+	is( $v->count, 2, 'element is 4 bytes' );
+	is( $v->type_name, 'int2_10_10_10_rev', 'type_name' );
+	$v->set(0, 1, -1, 0, 1);
+	is( unpack('V', $data), 511 | (513 << 10) | (1 << 30), 'bits' );
+	is_deeply( [ $v->get(0) ], [ 1, -1, 0, 1 ], 'read back' );
+	my $u= view(\$data, type => 'uint2_10_10_10_rev', normalized => 1);
+	$u->set(1, .5, 1, 0, 1);
+	is_deeply( [ map sprintf('%.3f', $_), $u->get(1) ], [ '0.500', '1.000', '0.000', '1.000' ], 'unsigned' );
+	my $ints= view(\$data, type => 'int2_10_10_10_rev');
+	$ints->set(0, -512, 511, 7, -2);
+	is_deeply( [ $ints->get(0) ], [ -512, 511, 7, -2 ], 'not normalized' );
+	ok( !eval { view(\$data, type => 'int2_10_10_10_rev', components => 3); 1 }, 'needs 4 components' );
+	my $floats= pack 'f*', map +($_ * .25), 0..7;
+	is( $v->copy_from(view(\$floats, type => 'vec4')), 2, 'copy_from floats' );
+	is_deeply( [ map sprintf('%.2f', $_), $v->get(1) ], [ '1.00', '1.00', '1.00', '1.00' ], 'clamped on conversion' );
+};
+
+subtest octahedral => sub {
+	my $src= pack 'f*', @normals;
+	my $nrm= view(\$src, type => 'vec3');
+	for ([ int16 => .01 ], [ int8 => 1 ], [ half => .1 ], [ float => 1e-4 ]) {
+		my ($type, $tolerance)= @$_;
+		my $oct= view(\("\0" x ($n_normals * 8)), type => $type, components => 2, normalized => 1);
+		is( $oct->encode_octahedral($nrm), $n_normals, "$type encode count" );
+		my $out= view(\("\0" x ($n_normals * 16)), type => 'vec4');
+		$out->decode_octahedral($oct);
+		my @xyzw= $out->get_all;
+		my @xyz= map @xyzw[$_*4 .. $_*4+2], 0 .. $n_normals-1;
+		my $err= max_angle(\@normals, \@xyz);
+		ok( $err < $tolerance, "$type round trip within $tolerance degrees" ) or diag "error $err";
+		is( $xyzw[3], 0, 'w of 0' );
+	}
+	# in place: vec3 of floats at stride 12 replaced by 2 normalized shorts each
+	my $copy= $src;
+	my $short= view(\$copy, type => 'int16', components => 2, normalized => 1, stride => 12);
+	$short->encode_octahedral(view(\$copy, type => 'vec3'));
+	my $back= pack 'f*', (0) x @normals;
+	view(\$back, type => 'vec3')->decode_octahedral($short);
+	ok( max_angle(\@normals, [ unpack 'f*', $back ]) < .01, 'in place' );
+	ok( !eval { view(\$copy, type => 'vec2', offset => 4)->encode_octahedral(view(\$copy, type => 'vec3')); 1 }, 'overlapping views' );
+	ok( !eval { view(\$copy, type => 'vec3')->encode_octahedral($nrm); 1 }, 'needs 2 components' );
+};
+
+subtest pool => sub {
+	my @many= (@normals) x 40;
+	my $src= pack 'f*', @many;
+	my $nrm= view(\$src, type => 'vec3');
+	my ($a, $b)= map "\0" x ($nrm->count * 4), 1..2;
+	my $pool= OpenGL::Sandbox::ThreadPool->new(threads => 3);
+	$pool->run(oct_encode => view(\$a, type => 'int16', components => 2, normalized => 1), $nrm);
+	view(\$b, type => 'int16', components => 2, normalized => 1)->encode_octahedral($nrm);
+	ok( $a eq $b, 'same as encode_octahedral' );
+	my $dec= "\0" x length $src;
+	$pool->run(oct_decode => view(\$dec, type => 'vec3'), view(\$a, type => 'int16', components => 2, normalized => 1));
+	ok( max_angle(\@many, [ unpack 'f*', $dec ]) < .01, 'oct_decode' );
+	ok( !eval { $pool->run(oct_encode => $nrm, $nrm); 1 }, 'component check' );
+};
+
+subtest mesh => sub {
+	my $m= OpenGL::Sandbox::Mesh->icosphere(subdivisions => 3, attributes => [
+		position => { type => 'half', components => 3 },
+		normal   => { type => 'int16', normalized => 1, octahedral => 1 },
+		color    => { from => 'uv', type => 'int2_10_10_10_rev', normalized => 1 },
+	]);
+	is( $m->stride, 16, 'half vec3, oct short2, packed' );
+	my $attrs= $m->vertex_array_attributes;
+	is_deeply( [ map $attrs->{$_}{size}, qw( position normal color ) ], [ 3, 2, 4 ], 'sizes' );
+	is( $attrs->{normal}{type}, GL_SHORT, 'normal type' );
+	my $data= $m->vertex_data;
+	my $pos= view(\$data, type => 'half', components => 3, stride => 16);
+	my $n= view(\("\0" x ($m->vertex_count * 12)), type => 'vec3');
+	$n->decode_octahedral(view(\$data, type => 'int16', components => 2, normalized => 1, stride => 16, offset => 8));
+	my @p= $pos->get_all;
+	my $len= sqrt($p[0]**2 + $p[1]**2 + $p[2]**2);
+	ok( max_angle([ map $_ / $len, @p ], [ $n->get_all ]) < .5, 'normals match positions' );
+	my $pool= OpenGL::Sandbox::ThreadPool->new(threads => 2);
+	is( $m->vertex_data(pool => $pool), $data, 'same with pool' );
+	ok( !eval { OpenGL::Sandbox::Mesh->plane(attributes => [ position => { octahedral => 1 } ]); 1 }, 'only normal' );
+};
+
+subtest vertex_array => sub {
+	my $attrs= { pos => { type => 'half', size => 4, stride => 16 }, color => { type => 'uint8', size => 4, normalized => 1, stride => 16, pointer => 8 } };
+	my $vao= OpenGL::Sandbox::VertexArray->new(attributes => $attrs);
+	is( $vao->attributes->{pos}{type}, GL_HALF_FLOAT, 'type name resolved' );
+	is( $attrs->{pos}{type}, 'half', "caller's hash unchanged" );
+	my $data= "\0" x 64;
+	my $color= $vao->attribute_view(color => \$data);
+	is_deeply( [ $color->type, $color->components, $color->normalized, $color->stride, $color->offset ],
+		[ GL_UNSIGNED_BYTE, 4, 1, 16, 8 ], 'attribute_view' );
+	$color->fill(1, 0, .5, 1);
+	is( substr($data, 24, 4), pack('C4', 255, 0, 128, 255), 'writes normalized' );
+};
+
+done_testing;
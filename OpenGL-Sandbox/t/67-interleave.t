@@ -0,0 +1,65 @@
+#! /usr/bin/env perl
+use strict;
+use warnings;
+use Test::More;
+use Log::Any::Adapter 'TAP';
+use OpenGL::Sandbox qw( GL_FLOAT GL_SHORT );
+use OpenGL::Sandbox::BufferView;
+use OpenGL::Sandbox::ThreadPool;
+
+sub view { OpenGL::Sandbox::BufferView->new(@_) }
+
+my $n= 20_000;
+my $pos= pack 'f*', map +($_, $_ + .25, -$_), 0 .. $n-1;
+my $nrm= pack 'f*', (0, .6, .8) x $n;
+my $uv=  pack 'f*', map +($_ / $n, 1 - $_ / $n), 0 .. $n-1;
+my @streams= ( position => view(\$pos, type => 'vec3'), normal => view(\$nrm, type => 'vec3'), uv => view(\$uv, type => 'vec2') );
+
+subtest interleave => sub {
+	my $data;
+	my $attrs= OpenGL::Sandbox::BufferView->interleave(\$data, \@streams);
+	is( length $data, $n * 32, 'scalar extended' );
+	is_deeply( $attrs->{uv}, { size => 2, type => GL_FLOAT, normalized => 0, stride => 32, pointer => 24 }, 'attributes' );
+	is( substr($data, 32*7, 32), substr($pos, 12*7, 12) . substr($nrm, 12*7, 12) . substr($uv, 8*7, 8), 'vertex bytes' );
+
+	my $pool= OpenGL::Sandbox::ThreadPool->new(threads => 3);
+	my $again;
+	OpenGL::Sandbox::BufferView->interleave(\$again, \@streams, pool => $pool);
+	ok( $again eq $data, 'same with pool' );
+
+	my %out= map +($_ => "\0" x length(${ \( $_ eq 'uv'? $uv : $pos ) })), qw( position normal uv );
+	my $copied= OpenGL::Sandbox::BufferView->deinterleave(\$data, $attrs, {
+		position => view(\$out{position}, type => 'vec3'),
+		normal   => view(\$out{normal}, type => 'vec3'),
+		uv       => view(\$out{uv}, type => 'vec2'),
+	}, pool => $pool);
+	is( $copied, $n, 'deinterleave count' );
+	ok( $out{position} eq $pos && $out{normal} eq $nrm && $out{uv} eq $uv, 'round trip' );
+};
+
+subtest convert => sub {
+	my $data= "\0" x 8;
+	my $attrs= OpenGL::Sandbox::BufferView->interleave(\$data, [
+		@streams[0,1],
+		normal => { view => $streams[3], type => 'int16', normalized => 1 },
+		uv     => { view => $streams[5], type => 'half' },
+	], offset => 8, stride => 32, buffer => 5);
+	is_deeply( $attrs->{normal}, { size => 3, type => GL_SHORT, normalized => 1, stride => 32, pointer => 20, buffer => 5 }, 'normal attribute' );
+	is( $attrs->{uv}{pointer}, 28, 'packed after the shorts' );
+	is_deeply( [ unpack 's3', substr($data, 8 + 32*3 + 12, 6) ], [ 0, 19660, 26214 ], 'normalized shorts' );
+	my $back= "\0" x ($n * 8);
+	OpenGL::Sandbox::BufferView->deinterleave(\$data, $attrs, { uv => view(\$back, type => 'vec2') });
+	my ($u, $v)= view(\$back, type => 'vec2')->get($n/2);
+	ok( abs($u - .5) < 1e-3 && abs($v - .5) < 1e-3, 'half converted back' );
+};
+
+subtest errors => sub {
+	my $data= $pos;
+	ok( !eval { OpenGL::Sandbox::BufferView->interleave(\$data, [ position => view(\$data, type => 'vec3') ]); 1 }, 'overlap' );
+	like( $@, qr/overlaps/, '...message' );
+	ok( !eval { OpenGL::Sandbox::BufferView->interleave(\$data, [ position => 'x' ]); 1 }, 'not a view' );
+	ok( !eval { OpenGL::Sandbox::BufferView->deinterleave(\$data, {}, { position => $streams[1] }); 1 }, 'unknown attribute' );
+	ok( !eval { OpenGL::Sandbox::_view_copy_streams(undef, view(\$data, type => 'vec2'), $streams[1]); 1 }, 'components differ' );
+};
+
+done_testing;